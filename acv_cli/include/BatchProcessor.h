@@ -0,0 +1,118 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a processor of image files which runs decoding, computing and encoding in parallel
+
+#ifndef BATCH_PROCESSOR_H
+#define BATCH_PROCESSOR_H
+
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <vector>
+
+class OperationChain;
+class QTextStream;
+
+// Settings of batch processing
+struct BatchSettings
+{
+    int numDecoders = 2; // Number of threads which read the images
+    int numWorkers = 1; // Number of threads which run the chain of operations
+    int numEncoders = 2; // Number of threads which write the images
+    int queueSize = 8; // Maximum number of images waiting in each queue
+    QString outputSuffix; // Format of output files (empty string means the format of input file)
+    bool skipExisting = false; // Skip the input files whose output files exist
+};
+
+// Processor of image files
+// Files are passed through three stages (decode -> compute -> encode) which are connected by bounded queues,
+// so the reading and writing of files are overlapped with computing and the number of images in memory is limited
+class BatchProcessor
+{
+
+public: // Public methods
+
+    // Constructor with the chain of operations applied to each image
+    BatchProcessor(const OperationChain& chain, const BatchSettings& settings);
+
+    // Process the files (their names are relative to input directory)
+    // Results are written to output directory with the same relative names
+    // Returns true if all files are processed successfully
+    bool Run(const QString& inputDir, const QStringList& fileNames, const QString& outputDir);
+
+    // Print the statistics of last processing
+    void PrintReport(QTextStream& out) const;
+
+private: // Private types
+
+    // Statistics of one stage of processing
+    struct StageStatistics
+    {
+        const char* name = ""; // Name of stage
+        int numThreads = 0; // Number of threads of stage
+        std::atomic<int> numProcessed{0}; // Number of successfully processed images
+        std::atomic<int> numFailed{0}; // Number of failed images
+        std::atomic<long long> numPixels{0}; // Number of processed pixels
+        std::atomic<long long> busyTime{0}; // Summary time of threads spent in processing (in microseconds)
+    };
+
+    // Used stages
+    enum Stage
+    {
+        DECODE,
+        COMPUTE,
+        ENCODE,
+        NUM_STAGES
+    };
+
+private: // Private methods
+
+    // Reset the statistics before processing
+    void ResetStatistics();
+
+    // Get the output name of file
+    QString GetOutputFileName(const QString& outputDir, const QString& fileName) const;
+
+private: // Private members
+
+    // Chain of operations
+    const OperationChain& mChain;
+
+    // Settings of processing
+    BatchSettings mSettings;
+
+    // Statistics of stages
+    StageStatistics mStatistics[NUM_STAGES];
+
+    // Number of skipped files
+    int mNumSkipped;
+
+    // Time of the whole processing (in microseconds)
+    long long mWallTime;
+
+};
+
+#endif // BATCH_PROCESSOR_H
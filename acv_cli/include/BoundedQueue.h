@@ -0,0 +1,116 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a thread-safe queue with limited capacity
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+// Thread-safe FIFO queue with limited capacity
+// Producers are blocked while the queue is full, so the memory of images in flight is bounded
+// After closing the consumers get the remaining items and then the queue reports the end of data
+template <typename T>
+class BoundedQueue
+{
+
+public: // Public methods
+
+    // Constructor of queue with specified maximum number of items
+    explicit BoundedQueue(size_t capacity)
+        : mCapacity(capacity > 0 ? capacity : 1),
+          mClosed(false)
+    {
+    }
+
+    // Disable copying of queue
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+public: // Public methods
+
+    // Add the item to the end of queue (waits for free place)
+    // Returns false if the queue is closed
+    bool Push(T&& item)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mNotFull.wait(lock, [this] { return mClosed || mItems.size() < mCapacity; });
+
+        if (mClosed)
+            return false;
+
+        mItems.push_back(std::move(item));
+        mNotEmpty.notify_one();
+
+        return true;
+    }
+
+    // Take the item from the begin of queue (waits for the item)
+    // Returns false if the queue is closed and empty
+    bool Pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mNotEmpty.wait(lock, [this] { return mClosed || !mItems.empty(); });
+
+        if (mItems.empty())
+            return false;
+
+        item = std::move(mItems.front());
+        mItems.pop_front();
+        mNotFull.notify_one();
+
+        return true;
+    }
+
+    // Close the queue: new items are not accepted and all waiting threads are woken
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mClosed = true;
+        mNotEmpty.notify_all();
+        mNotFull.notify_all();
+    }
+
+private: // Private members
+
+    // Maximum number of items
+    const size_t mCapacity;
+
+    // Items of queue
+    std::deque<T> mItems;
+
+    // Flag of closed queue
+    bool mClosed;
+
+    // Synchronization of access to items
+    std::mutex mMutex;
+    std::condition_variable mNotEmpty;
+    std::condition_variable mNotFull;
+
+};
+
+#endif // BOUNDED_QUEUE_H
@@ -0,0 +1,62 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define the reading and writing of image files
+
+#ifndef IMAGE_FILE_IO_H
+#define IMAGE_FILE_IO_H
+
+#include <QString>
+#include <QStringList>
+
+class AImage;
+
+// Class is used to read and write the images of files
+// Raw image files (*.acvraw) are processed by ARawImageFile, other formats are processed by QImage
+// Contains only static methods which can be called from several threads simultaneously
+class ImageFileIO
+{
+
+public: // Public methods
+
+    // Read the image from file
+    static bool Load(const QString& fileName, AImage& img);
+
+    // Write the image to file (format is defined by suffix of file name)
+    static bool Save(const QString& fileName, const AImage& img);
+
+    // Get the name filters of supported files ("*.bmp", "*.png" ...)
+    static QStringList GetNameFilters();
+
+    // Check that the format with specified suffix can be written
+    static bool IsWritableFormat(const QString& suffix);
+
+public: // Public constants
+
+    // Suffix of raw image files
+    static const QString RAW_SUFFIX;
+
+};
+
+#endif // IMAGE_FILE_IO_H
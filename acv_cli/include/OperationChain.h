@@ -0,0 +1,106 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a chain of library operations which is applied to each processed image
+
+#ifndef OPERATION_CHAIN_H
+#define OPERATION_CHAIN_H
+
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class AImage;
+class APipeline;
+
+// Chain of operations which is built from text descriptions of command line
+// Consecutive filter, threshold, correct, detect and morphology operations are joined in one APipeline,
+// so they are run without full intermediate images where it is possible
+// The chain is not changed during processing, so it can be run from several threads simultaneously
+class OperationChain
+{
+
+public: // Public methods
+
+    // Add operation by its text description "name:arg1:arg2..."
+    // Returns false and the reason in errorMessage if the description is incorrect
+    bool AddOperation(const QString& description, QString& errorMessage);
+
+    // Check that chain doesn't contain operations
+    bool IsEmpty() const;
+
+    // Get the number of added operations
+    int GetNumOperations() const;
+
+    // Run all operations over the image in place
+    bool Run(AImage& img) const;
+
+    // Get the text with descriptions of supported operations
+    static QString GetUsage();
+
+private: // Private types
+
+    // Operation which is not supported by pipeline
+    typedef std::function<bool(AImage& img)> Operation;
+
+    // Step of chain: either the pipeline of operations or the single other operation
+    struct Step
+    {
+        std::shared_ptr<APipeline> pipeline;
+        Operation operation;
+    };
+
+private: // Private methods
+
+    // Get the pipeline at the end of chain (new pipeline is added if the last step is not a pipeline)
+    APipeline& GetLastPipeline();
+
+    // Add the operation which is not supported by pipeline
+    void AddSingleOperation(const Operation& operation);
+
+    // Methods of parsing the operations of each kind
+    bool AddFilter(const QStringList& args, QString& errorMessage);
+    bool AddUnsharpMask(const QStringList& args, QString& errorMessage);
+    bool AddThreshold(const QStringList& args, QString& errorMessage);
+    bool AddStatisticalThreshold(const QStringList& args, QString& errorMessage);
+    bool AddCorrector(const QStringList& args, QString& errorMessage);
+    bool AddDetector(const QStringList& args, QString& errorMessage);
+    bool AddMorphology(const QStringList& args, QString& errorMessage);
+    bool AddScale(const QStringList& args, QString& errorMessage);
+    bool AddCombiner(const QStringList& args, QString& errorMessage);
+
+private: // Private members
+
+    // Steps of chain
+    std::vector<Step> mSteps;
+
+    // Number of added operations
+    int mNumOperations = 0;
+
+};
+
+#endif // OPERATION_CHAIN_H
@@ -0,0 +1,165 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "OperationChain.h"
+#include "BatchProcessor.h"
+#include "ImageFileIO.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QDirIterator>
+#include <QTextStream>
+#include <QThread>
+
+#include <algorithm>
+
+const QString CURRENT_VERSION = QObject::tr("1.1");
+
+// Get the names of image files of directory (relative to this directory)
+static QStringList FindImageFiles(const QString& dirName, bool recursive)
+{
+    const QDir dir(dirName);
+    QStringList fileNames;
+
+    QDirIterator it(dirName, ImageFileIO::GetNameFilters(), QDir::Files,
+                    recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags);
+    while (it.hasNext())
+        fileNames << dir.relativeFilePath(it.next());
+
+    fileNames.sort();
+
+    return fileNames;
+}
+
+// Parse the positive number of option
+static bool ParseNumber(const QCommandLineParser& parser, const QCommandLineOption& option, int& value)
+{
+    if (!parser.isSet(option))
+        return true;
+
+    bool ok = false;
+    value = parser.value(option).toInt(&ok);
+
+    return ok && value > 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("acv_cli");
+    QCoreApplication::setApplicationVersion(CURRENT_VERSION);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QObject::tr("Batch processing of images by the chain of operations.\n\n%1")
+                                     .arg(OperationChain::GetUsage()));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("input", QObject::tr("Directory with source images."));
+    parser.addPositionalArgument("output", QObject::tr("Directory for processed images."));
+
+    const QCommandLineOption operationOption(QStringList() << "o" << "operation",
+                                             QObject::tr("Add operation to the chain (can be repeated)."), "operation");
+    const QCommandLineOption recursiveOption(QStringList() << "r" << "recursive",
+                                             QObject::tr("Process the subdirectories of input directory."));
+    const QCommandLineOption formatOption(QStringList() << "f" << "format",
+                                          QObject::tr("Format of output files (format of input file by default)."), "suffix");
+    const QCommandLineOption workersOption(QStringList() << "j" << "jobs",
+                                           QObject::tr("Number of computing threads."), "number");
+    const QCommandLineOption decodersOption("decoders", QObject::tr("Number of reading threads."), "number");
+    const QCommandLineOption encodersOption("encoders", QObject::tr("Number of writing threads."), "number");
+    const QCommandLineOption queueOption("queue", QObject::tr("Maximum number of images waiting in each queue."), "number");
+    const QCommandLineOption skipOption("skip-existing", QObject::tr("Skip the files which are already processed."));
+
+    parser.addOption(operationOption);
+    parser.addOption(recursiveOption);
+    parser.addOption(formatOption);
+    parser.addOption(workersOption);
+    parser.addOption(decodersOption);
+    parser.addOption(encodersOption);
+    parser.addOption(queueOption);
+    parser.addOption(skipOption);
+
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 2)
+    {
+        err << QObject::tr("Input and output directories should be specified") << "\n";
+        return 1;
+    }
+
+    OperationChain chain;
+    for (const QString& description : parser.values(operationOption))
+    {
+        QString errorMessage;
+        if (!chain.AddOperation(description, errorMessage))
+        {
+            err << errorMessage << "\n";
+            return 1;
+        }
+    }
+
+    BatchSettings settings;
+    settings.numWorkers = std::max(QThread::idealThreadCount(), 1);
+    settings.outputSuffix = parser.value(formatOption);
+    settings.skipExisting = parser.isSet(skipOption);
+
+    if (!ParseNumber(parser, workersOption, settings.numWorkers) ||
+        !ParseNumber(parser, decodersOption, settings.numDecoders) ||
+        !ParseNumber(parser, encodersOption, settings.numEncoders) ||
+        !ParseNumber(parser, queueOption, settings.queueSize))
+    {
+        err << QObject::tr("Numbers of threads and size of queue should be positive") << "\n";
+        return 1;
+    }
+
+    if (!settings.outputSuffix.isEmpty() && !ImageFileIO::IsWritableFormat(settings.outputSuffix))
+    {
+        err << QObject::tr("Unsupported format of output files: %1").arg(settings.outputSuffix) << "\n";
+        return 1;
+    }
+
+    const QString inputDir = args[0];
+    const QString outputDir = args[1];
+
+    if (!QDir(inputDir).exists())
+    {
+        err << QObject::tr("Input directory doesn't exist: %1").arg(inputDir) << "\n";
+        return 1;
+    }
+
+    const QStringList fileNames = FindImageFiles(inputDir, parser.isSet(recursiveOption));
+    out << QObject::tr("Processing of %1 files by %2 operations").arg(fileNames.size()).arg(chain.GetNumOperations()) << "\n";
+    out.flush();
+
+    BatchProcessor processor(chain, settings);
+    const bool ret = processor.Run(inputDir, fileNames, outputDir);
+    processor.PrintReport(out);
+
+    return ret ? 0 : 2;
+}
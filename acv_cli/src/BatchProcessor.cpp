@@ -0,0 +1,268 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods of class BatchProcessor
+
+#include "BatchProcessor.h"
+#include "BoundedQueue.h"
+#include "OperationChain.h"
+#include "ImageFileIO.h"
+
+#include "AImage.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QObject>
+#include <QTextStream>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+// Image which is passed between the stages
+struct Frame
+{
+    QString fileName; // Name of file relative to input directory
+    AImage img{-1, -1}; // Pixels of image
+};
+
+typedef std::chrono::steady_clock Clock;
+
+// Get the time elapsed from specified moment (in microseconds)
+static long long GetElapsedTime(const Clock::time_point& begin)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - begin).count();
+}
+
+// Start the body in specified number of threads
+template <typename Body>
+static void RunThreads(int numThreads, std::vector<std::thread>& threads, const Body& body)
+{
+    for (int i = 0; i < numThreads; ++i)
+        threads.emplace_back(body);
+}
+
+BatchProcessor::BatchProcessor(const OperationChain& chain, const BatchSettings& settings)
+    : mChain(chain),
+      mSettings(settings),
+      mNumSkipped(0),
+      mWallTime(0)
+{
+    mSettings.numDecoders = std::max(mSettings.numDecoders, 1);
+    mSettings.numWorkers = std::max(mSettings.numWorkers, 1);
+    mSettings.numEncoders = std::max(mSettings.numEncoders, 1);
+
+    mStatistics[DECODE].name = "decode";
+    mStatistics[COMPUTE].name = "compute";
+    mStatistics[ENCODE].name = "encode";
+}
+
+bool BatchProcessor::Run(const QString& inputDir, const QStringList& fileNames, const QString& outputDir)
+{
+    ResetStatistics();
+
+    BoundedQueue<Frame> decodedFrames(mSettings.queueSize);
+    BoundedQueue<Frame> computedFrames(mSettings.queueSize);
+
+    std::atomic<int> nextFile(0);
+    std::atomic<int> numSkipped(0);
+    std::atomic<int> activeDecoders(mSettings.numDecoders);
+    std::atomic<int> activeWorkers(mSettings.numWorkers);
+
+    const QDir srcDir(inputDir);
+    const Clock::time_point startTime = Clock::now();
+
+    auto decoder = [&]()
+    {
+        StageStatistics& stat = mStatistics[DECODE];
+
+        for (int i = nextFile++; i < fileNames.size(); i = nextFile++)
+        {
+            Frame frame;
+            frame.fileName = fileNames[i];
+
+            if (mSettings.skipExisting && QFileInfo::exists(GetOutputFileName(outputDir, frame.fileName)))
+            {
+                ++numSkipped;
+                continue;
+            }
+
+            const Clock::time_point begin = Clock::now();
+            const bool ok = ImageFileIO::Load(srcDir.filePath(frame.fileName), frame.img);
+            stat.busyTime += GetElapsedTime(begin);
+
+            if (!ok)
+            {
+                qWarning().noquote() << QObject::tr("Can't read the file %1").arg(frame.fileName);
+                ++stat.numFailed;
+                continue;
+            }
+
+            ++stat.numProcessed;
+            stat.numPixels += static_cast<long long>(frame.img.GetHeight()) * frame.img.GetWidth();
+
+            if (!decodedFrames.Push(std::move(frame)))
+                break;
+        }
+
+        // The last finished decoder closes the queue
+        if (--activeDecoders == 0)
+            decodedFrames.Close();
+    };
+
+    auto worker = [&]()
+    {
+        StageStatistics& stat = mStatistics[COMPUTE];
+        Frame frame;
+
+        while (decodedFrames.Pop(frame))
+        {
+            const long long numPixels = static_cast<long long>(frame.img.GetHeight()) * frame.img.GetWidth();
+
+            const Clock::time_point begin = Clock::now();
+            const bool ok = mChain.Run(frame.img);
+            stat.busyTime += GetElapsedTime(begin);
+
+            if (!ok)
+            {
+                qWarning().noquote() << QObject::tr("Can't process the file %1").arg(frame.fileName);
+                ++stat.numFailed;
+                continue;
+            }
+
+            ++stat.numProcessed;
+            stat.numPixels += numPixels;
+
+            if (!computedFrames.Push(std::move(frame)))
+                break;
+        }
+
+        // The last finished worker closes the queue
+        if (--activeWorkers == 0)
+            computedFrames.Close();
+    };
+
+    auto encoder = [&]()
+    {
+        StageStatistics& stat = mStatistics[ENCODE];
+        Frame frame;
+
+        while (computedFrames.Pop(frame))
+        {
+            const QString outFileName = GetOutputFileName(outputDir, frame.fileName);
+
+            const Clock::time_point begin = Clock::now();
+            const bool ok = QDir().mkpath(QFileInfo(outFileName).absolutePath()) &&
+                            ImageFileIO::Save(outFileName, frame.img);
+            stat.busyTime += GetElapsedTime(begin);
+
+            if (!ok)
+            {
+                qWarning().noquote() << QObject::tr("Can't write the file %1").arg(outFileName);
+                ++stat.numFailed;
+                continue;
+            }
+
+            ++stat.numProcessed;
+            stat.numPixels += static_cast<long long>(frame.img.GetHeight()) * frame.img.GetWidth();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    RunThreads(mSettings.numDecoders, threads, decoder);
+    RunThreads(mSettings.numWorkers, threads, worker);
+    RunThreads(mSettings.numEncoders, threads, encoder);
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    mWallTime = GetElapsedTime(startTime);
+    mNumSkipped = numSkipped;
+
+    return mStatistics[DECODE].numFailed == 0 && mStatistics[COMPUTE].numFailed == 0 &&
+           mStatistics[ENCODE].numFailed == 0;
+}
+
+void BatchProcessor::PrintReport(QTextStream& out) const
+{
+    const double MICROSECONDS_IN_SECOND = 1e6;
+    const double PIXELS_IN_MEGAPIXEL = 1e6;
+
+    out << QString("%1 %2 %3 %4 %5 %6 %7\n")
+           .arg("stage", -8).arg("threads", 8).arg("images", 10).arg("failed", 8)
+           .arg("busy, s", 10).arg("images/s", 10).arg("MPix/s", 10);
+
+    for (const StageStatistics& stat : mStatistics)
+    {
+        // Throughput of stage is measured by the time when its threads were busy,
+        // so the stage with the smallest throughput is the bottleneck of processing
+        const double busyTime = stat.busyTime / MICROSECONDS_IN_SECOND;
+        const double stageTime = busyTime / stat.numThreads;
+        const double imagesPerSecond = (stageTime > 0.0) ? (stat.numProcessed + stat.numFailed) / stageTime : 0.0;
+        const double mpixPerSecond = (stageTime > 0.0) ? stat.numPixels / PIXELS_IN_MEGAPIXEL / stageTime : 0.0;
+
+        out << QString("%1 %2 %3 %4 %5 %6 %7\n")
+               .arg(stat.name, -8).arg(stat.numThreads, 8).arg(stat.numProcessed, 10).arg(stat.numFailed, 8)
+               .arg(busyTime, 10, 'f', 2).arg(imagesPerSecond, 10, 'f', 1).arg(mpixPerSecond, 10, 'f', 1);
+    }
+
+    const double wallTime = mWallTime / MICROSECONDS_IN_SECOND;
+    const int numWritten = mStatistics[ENCODE].numProcessed;
+
+    out << QString("Total: %1 images written, %2 skipped in %3 s (%4 images/s)\n")
+           .arg(numWritten).arg(mNumSkipped).arg(wallTime, 0, 'f', 2)
+           .arg((wallTime > 0.0) ? numWritten / wallTime : 0.0, 0, 'f', 1);
+}
+
+void BatchProcessor::ResetStatistics()
+{
+    const int numThreads[NUM_STAGES] = { mSettings.numDecoders, mSettings.numWorkers, mSettings.numEncoders };
+
+    for (int stage = 0; stage < NUM_STAGES; ++stage)
+    {
+        StageStatistics& stat = mStatistics[stage];
+        stat.numThreads = numThreads[stage];
+        stat.numProcessed = 0;
+        stat.numFailed = 0;
+        stat.numPixels = 0;
+        stat.busyTime = 0;
+    }
+
+    mNumSkipped = 0;
+    mWallTime = 0;
+}
+
+QString BatchProcessor::GetOutputFileName(const QString& outputDir, const QString& fileName) const
+{
+    QString outFileName = QDir(outputDir).filePath(fileName);
+
+    if (!mSettings.outputSuffix.isEmpty())
+    {
+        const QFileInfo info(outFileName);
+        outFileName = info.dir().filePath(info.completeBaseName() + "." + mSettings.outputSuffix);
+    }
+
+    return outFileName;
+}
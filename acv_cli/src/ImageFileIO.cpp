@@ -0,0 +1,120 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods of class ImageFileIO
+
+#include "ImageFileIO.h"
+
+#include "AImage.h"
+#include "ARawImageFile.h"
+
+#include <QFileInfo>
+#include <QImage>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QSysInfo>
+
+const QString ImageFileIO::RAW_SUFFIX = "acvraw";
+
+// Get the format of AImage buffers which matches the 32-bit QImage pixels (0xAARRGGBB)
+static APixelFormat GetARGB32PixelFormat()
+{
+    return (QSysInfo::ByteOrder == QSysInfo::LittleEndian) ? APixelFormat::BGRA8888 : APixelFormat::ARGB8888;
+}
+
+// Check that the file is raw image file
+static bool IsRawImageFile(const QString& fileName)
+{
+    return QFileInfo(fileName).suffix().compare(ImageFileIO::RAW_SUFFIX, Qt::CaseInsensitive) == 0;
+}
+
+bool ImageFileIO::Load(const QString& fileName, AImage& img)
+{
+    if (IsRawImageFile(fileName))
+        return ARawImageFile::Load(fileName.toStdString(), img);
+
+    QImageReader reader(fileName);
+    QImage qImg;
+    if (!reader.read(&qImg))
+        return false;
+
+    AImage loadedImg(qImg.height(), qImg.width());
+    if (!loadedImg.IsInitialized())
+        return false;
+
+    switch (qImg.format())
+    {
+    case QImage::Format_Grayscale8:
+        loadedImg.Import(qImg.constBits(), qImg.bytesPerLine(), APixelFormat::GRAY8);
+        break;
+    case QImage::Format_RGB888:
+        loadedImg.Import(qImg.constBits(), qImg.bytesPerLine(), APixelFormat::RGB888);
+        break;
+    case QImage::Format_RGB32:
+    case QImage::Format_ARGB32:
+        loadedImg.Import(qImg.constBits(), qImg.bytesPerLine(), GetARGB32PixelFormat());
+        break;
+    default:
+        qImg = qImg.convertToFormat(QImage::Format_ARGB32);
+        loadedImg.Import(qImg.constBits(), qImg.bytesPerLine(), GetARGB32PixelFormat());
+        break;
+    }
+
+    img = std::move(loadedImg);
+
+    return true;
+}
+
+bool ImageFileIO::Save(const QString& fileName, const AImage& img)
+{
+    if (!img.IsInitialized())
+        return false;
+
+    if (IsRawImageFile(fileName))
+        return ARawImageFile::Save(fileName.toStdString(), img);
+
+    // The processed images are gray, so 8-bit image is written (it is much faster than 32-bit one)
+    QImage qImg(img.GetWidth(), img.GetHeight(), QImage::Format_Grayscale8);
+    img.Export(qImg.bits(), qImg.bytesPerLine(), APixelFormat::GRAY8);
+
+    QImageWriter writer(fileName);
+    return writer.write(qImg);
+}
+
+QStringList ImageFileIO::GetNameFilters()
+{
+    QStringList filters;
+
+    for (const QByteArray& format : QImageReader::supportedImageFormats())
+        filters << "*." + QString::fromLatin1(format);
+    filters << "*." + RAW_SUFFIX;
+
+    return filters;
+}
+
+bool ImageFileIO::IsWritableFormat(const QString& suffix)
+{
+    return suffix.compare(RAW_SUFFIX, Qt::CaseInsensitive) == 0 ||
+           QImageWriter::supportedImageFormats().contains(suffix.toLower().toLatin1());
+}
@@ -0,0 +1,418 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods of class OperationChain
+
+#include "OperationChain.h"
+#include "ImageFileIO.h"
+
+#include "AImage.h"
+#include "APipeline.h"
+#include "AImageCombiner.h"
+#include "AImageFilter.h"
+
+#include <QObject>
+#include <QStringList>
+
+// Parse the integer argument with specified index (the default value is used if the argument is absent)
+static bool ParseIntArg(const QStringList& args, int index, int defaultValue, int& value)
+{
+    if (index >= args.size() || args[index].isEmpty())
+    {
+        value = defaultValue;
+        return defaultValue >= 0;
+    }
+
+    bool ok = false;
+    value = args[index].toInt(&ok);
+
+    return ok;
+}
+
+bool OperationChain::AddOperation(const QString& description, QString& errorMessage)
+{
+    const QStringList parts = description.split(':');
+    const QString name = parts.first().trimmed().toLower();
+    const QStringList args = parts.mid(1);
+
+    bool ret = false;
+
+    if (name == "filter")
+        ret = AddFilter(args, errorMessage);
+    else if (name == "unsharp")
+        ret = AddUnsharpMask(args, errorMessage);
+    else if (name == "threshold")
+        ret = AddThreshold(args, errorMessage);
+    else if (name == "correct")
+        ret = AddCorrector(args, errorMessage);
+    else if (name == "detect")
+        ret = AddDetector(args, errorMessage);
+    else if (name == "morphology")
+        ret = AddMorphology(args, errorMessage);
+    else if (name == "scale")
+        ret = AddScale(args, errorMessage);
+    else if (name == "combine")
+        ret = AddCombiner(args, errorMessage);
+    else
+        errorMessage = QObject::tr("unknown operation \"%1\"").arg(name);
+
+    if (ret)
+        ++mNumOperations;
+    else
+        errorMessage = QObject::tr("Operation \"%1\": %2").arg(description, errorMessage);
+
+    return ret;
+}
+
+bool OperationChain::IsEmpty() const
+{
+    return mSteps.empty();
+}
+
+int OperationChain::GetNumOperations() const
+{
+    return mNumOperations;
+}
+
+bool OperationChain::Run(AImage& img) const
+{
+    bool ret = img.IsInitialized();
+
+    for (auto it = mSteps.cbegin(); ret && it != mSteps.cend(); ++it)
+    {
+        if (it->pipeline)
+            ret = it->pipeline->Run(std::move(img), img);
+        else
+            ret = it->operation(img);
+    }
+
+    return ret;
+}
+
+QString OperationChain::GetUsage()
+{
+    return QObject::tr(
+        "Operations (applied in the specified order):\n"
+        "  filter:<median|gaussian|sepgaussian|iir|sharpen|bilateral|unsharp>[:size]\n"
+        "  unsharp:<radius>[:amount in percents][:threshold]\n"
+        "  threshold:<size>:<threshold>[:inverse]\n"
+        "  threshold:<sauvola|niblack>:<size>[:k][:inverse]\n"
+        "  correct:<ssr|autolevels|normautolevels|gamma|equalize|clahe>\n"
+        "  detect:<sobel|scharr|canny|cannybilateral>\n"
+        "  morphology:<erosion|dilation|opening|closing>:<width>[:height]\n"
+        "  scale:<up|down>:<kx>[:ky]\n"
+        "  combine:<inform|morphological|entropy|diffadd|diff>:<file of second image>\n");
+}
+
+APipeline& OperationChain::GetLastPipeline()
+{
+    if (mSteps.empty() || !mSteps.back().pipeline)
+    {
+        Step step;
+        step.pipeline = std::make_shared<APipeline>();
+        mSteps.push_back(step);
+    }
+
+    return *mSteps.back().pipeline;
+}
+
+void OperationChain::AddSingleOperation(const Operation& operation)
+{
+    Step step;
+    step.operation = operation;
+    mSteps.push_back(step);
+}
+
+bool OperationChain::AddFilter(const QStringList& args, QString& errorMessage)
+{
+    const QString typeName = args.value(0).toLower();
+    AFilterType type;
+
+    if (typeName == "median")
+        type = AFilterType::MEDIAN;
+    else if (typeName == "gaussian")
+        type = AFilterType::GAUSSIAN;
+    else if (typeName == "sepgaussian")
+        type = AFilterType::SEP_GAUSSIAN;
+    else if (typeName == "iir")
+        type = AFilterType::IIR_GAUSSIAN;
+    else if (typeName == "sharpen")
+        type = AFilterType::SHARPEN;
+    else if (typeName == "bilateral")
+        type = AFilterType::BILATERAL;
+    else if (typeName == "unsharp")
+        type = AFilterType::UNSHARP_MASK;
+    else
+    {
+        errorMessage = QObject::tr("unknown type of filter \"%1\"").arg(typeName);
+        return false;
+    }
+
+    int filterSize;
+    if (!ParseIntArg(args, 1, type == AFilterType::SHARPEN ? 3 : 5, filterSize))
+    {
+        errorMessage = QObject::tr("incorrect filter size");
+        return false;
+    }
+
+    GetLastPipeline().AddFilter(type, filterSize);
+
+    return true;
+}
+
+bool OperationChain::AddUnsharpMask(const QStringList& args, QString& errorMessage)
+{
+    int radius, amount, threshold;
+    if (!ParseIntArg(args, 0, -1, radius) || !ParseIntArg(args, 1, 100, amount) || !ParseIntArg(args, 2, 0, threshold) ||
+        radius < 1 || amount < 0)
+    {
+        errorMessage = QObject::tr("radius should be positive, amount and threshold should not be negative");
+        return false;
+    }
+
+    // Unsharp masking with explicit amount and threshold is not supported by pipeline
+    AddSingleOperation([radius, amount, threshold](AImage& img)
+    {
+        return AImageFilter::UnsharpMask(img, img, radius, amount, threshold) == AFiltrationResult::SUCCESS;
+    });
+
+    return true;
+}
+
+bool OperationChain::AddThreshold(const QStringList& args, QString& errorMessage)
+{
+    const QString methodName = args.value(0).toLower();
+    if (methodName == "sauvola" || methodName == "niblack")
+        return AddStatisticalThreshold(args, errorMessage);
+
+    int filterSize, threshold;
+    if (!ParseIntArg(args, 0, -1, filterSize) || !ParseIntArg(args, 1, -1, threshold))
+    {
+        errorMessage = QObject::tr("filter size and threshold should be specified");
+        return false;
+    }
+
+    const bool inverse = args.value(2).toLower() == "inverse";
+    GetLastPipeline().AddAdaptiveThreshold(filterSize, threshold,
+                                           inverse ? AThresholdType::MIN_MORE_THRESHOLD : AThresholdType::MAX_MORE_THRESHOLD);
+
+    return true;
+}
+
+bool OperationChain::AddStatisticalThreshold(const QStringList& args, QString& errorMessage)
+{
+    const AThresholdMethod method = (args.value(0).toLower() == "sauvola") ? AThresholdMethod::SAUVOLA : AThresholdMethod::NIBLACK;
+
+    int filterSize;
+    if (!ParseIntArg(args, 1, -1, filterSize) || filterSize % 2 == 0)
+    {
+        errorMessage = QObject::tr("window size should be odd positive number");
+        return false;
+    }
+
+    // The default factors are the usual ones for documents
+    float k = (method == AThresholdMethod::SAUVOLA) ? 0.34f : -0.2f;
+    if (!args.value(2).isEmpty() && args.value(2).toLower() != "inverse")
+    {
+        bool ok = false;
+        k = args.value(2).toFloat(&ok);
+        if (!ok)
+        {
+            errorMessage = QObject::tr("incorrect factor of deviation");
+            return false;
+        }
+    }
+
+    const bool inverse = args.mid(2).contains("inverse", Qt::CaseInsensitive);
+    GetLastPipeline().AddAdaptiveThreshold(filterSize, k, method,
+                                           inverse ? AThresholdType::MIN_MORE_THRESHOLD : AThresholdType::MAX_MORE_THRESHOLD);
+
+    return true;
+}
+
+bool OperationChain::AddCorrector(const QStringList& args, QString& errorMessage)
+{
+    const QString typeName = args.value(0).toLower();
+    ACorrectorType type;
+
+    if (typeName == "ssr")
+        type = ACorrectorType::SSRETINEX;
+    else if (typeName == "autolevels")
+        type = ACorrectorType::AUTO_LEVELS;
+    else if (typeName == "normautolevels")
+        type = ACorrectorType::NORM_AUTO_LEVELS;
+    else if (typeName == "gamma")
+        type = ACorrectorType::GAMMA;
+    else if (typeName == "equalize")
+        type = ACorrectorType::GLOBAL_EQUALIZATION;
+    else if (typeName == "clahe")
+        type = ACorrectorType::CLAHE;
+    else
+    {
+        errorMessage = QObject::tr("unknown type of corrector \"%1\"").arg(typeName);
+        return false;
+    }
+
+    GetLastPipeline().AddCorrector(type);
+
+    return true;
+}
+
+bool OperationChain::AddDetector(const QStringList& args, QString& errorMessage)
+{
+    const QString typeName = args.value(0).toLower();
+    ADetectorType type;
+
+    if (typeName == "sobel")
+        type = ADetectorType::SOBEL;
+    else if (typeName == "scharr")
+        type = ADetectorType::SCHARR;
+    else if (typeName == "canny")
+        type = ADetectorType::CANNY;
+    else if (typeName == "cannybilateral")
+        type = ADetectorType::CANNY_BILATERAL;
+    else
+    {
+        errorMessage = QObject::tr("unknown type of detector \"%1\"").arg(typeName);
+        return false;
+    }
+
+    GetLastPipeline().AddBordersDetector(type);
+
+    return true;
+}
+
+bool OperationChain::AddMorphology(const QStringList& args, QString& errorMessage)
+{
+    const QString typeName = args.value(0).toLower();
+    AMorphologyType type;
+
+    if (typeName == "erosion")
+        type = AMorphologyType::EROSION;
+    else if (typeName == "dilation")
+        type = AMorphologyType::DILATION;
+    else if (typeName == "opening")
+        type = AMorphologyType::OPENING;
+    else if (typeName == "closing")
+        type = AMorphologyType::CLOSING;
+    else
+    {
+        errorMessage = QObject::tr("unknown type of morphological operation \"%1\"").arg(typeName);
+        return false;
+    }
+
+    int seWidth, seHeight;
+    if (!ParseIntArg(args, 1, 3, seWidth) || !ParseIntArg(args, 2, seWidth, seHeight) ||
+        seWidth % 2 == 0 || seHeight % 2 == 0)
+    {
+        errorMessage = QObject::tr("sizes of structuring element should be odd");
+        return false;
+    }
+
+    GetLastPipeline().AddMorphology(type, seWidth, seHeight);
+
+    return true;
+}
+
+bool OperationChain::AddScale(const QStringList& args, QString& errorMessage)
+{
+    const QString typeName = args.value(0).toLower();
+    AScaleType type;
+
+    if (typeName == "up")
+        type = AScaleType::UPSCALE;
+    else if (typeName == "down")
+        type = AScaleType::DOWNSCALE;
+    else
+    {
+        errorMessage = QObject::tr("unknown type of scaling \"%1\"").arg(typeName);
+        return false;
+    }
+
+    int kScaleX, kScaleY;
+    if (!ParseIntArg(args, 1, 2, kScaleX) || !ParseIntArg(args, 2, kScaleX, kScaleY) || kScaleX < 1 || kScaleY < 1)
+    {
+        errorMessage = QObject::tr("scale factors should be positive");
+        return false;
+    }
+
+    AddSingleOperation([kScaleX, kScaleY, type](AImage& img)
+    {
+        img = img.Scale(static_cast<short>(kScaleX), static_cast<short>(kScaleY), type);
+        return img.IsInitialized();
+    });
+
+    return true;
+}
+
+bool OperationChain::AddCombiner(const QStringList& args, QString& errorMessage)
+{
+    const QString typeName = args.value(0).toLower();
+    ACombineType type;
+
+    if (typeName == "inform")
+        type = ACombineType::INFORM_PRIORITY;
+    else if (typeName == "morphological")
+        type = ACombineType::MORPHOLOGICAL;
+    else if (typeName == "entropy")
+        type = ACombineType::LOCAL_ENTROPY;
+    else if (typeName == "diffadd")
+        type = ACombineType::DIFFERENCES_ADDING;
+    else if (typeName == "diff")
+        type = ACombineType::CALC_DIFF;
+    else
+    {
+        errorMessage = QObject::tr("unknown type of combining \"%1\"").arg(typeName);
+        return false;
+    }
+
+    // The second image is read once and shared by all processed images
+    const QString fileName = args.mid(1).join(':');
+    auto secondImg = std::make_shared<AImage>(-1, -1);
+    if (fileName.isEmpty() || !ImageFileIO::Load(fileName, *secondImg))
+    {
+        errorMessage = QObject::tr("can't read the second image \"%1\"").arg(fileName);
+        return false;
+    }
+
+    // The order of images is important for combining of differences
+    const bool needSort = (type != ACombineType::DIFFERENCES_ADDING && type != ACombineType::CALC_DIFF);
+
+    AddSingleOperation([secondImg, type, needSort](AImage& img)
+    {
+        AImageCombiner combiner;
+        combiner.AddImage(img);
+        combiner.AddImage(*secondImg);
+
+        // Combiner keeps the pointers to source pixels, so the result is written to the separate image
+        AImage combImg(img.GetHeight(), img.GetWidth());
+        if (combiner.Combine(type, combImg, needSort) != ACombinationResult::SUCCESS)
+            return false;
+
+        img = std::move(combImg);
+        return true;
+    });
+
+    return true;
+}
@@ -33,7 +33,7 @@ include( ../app.pri )
 
 QT += core gui
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets printsupport
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets printsupport concurrent
 
 TARGET = acv_gui
 
@@ -28,15 +28,20 @@
 #include <QMainWindow>
 #include <QRubberBand>
 #include <QLabel>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
 
 #include <vector>
+#include <functional>
 
 #include "AImage.h"
 #include "AImageFilter.h"
+#include "AMorphologyFilter.h"
 #include "AImageCombiner.h"
 #include "ABordersDetector.h"
 #include "AImageCorrector.h"
 #include "AHuMomentsCalculator.h"
+#include "AProgress.h"
 
 #include "qcustomplot.h"
 
@@ -50,6 +55,7 @@ class QImage;
 class ImageViewer;
 class HistogramWidget;
 class QCustomPlot;
+class QProgressDialog;
 
 class MainWindow : public QMainWindow
 {
@@ -71,6 +77,13 @@ private: // Private types
         SELECT_BOUNDARY // Selecting the boundary of pixels (for example, during the calculation of Hu's moments)
     };
 
+    // Operation which is run in the worker thread
+    // It should not access the members of window, the source images should be captured by copies (pixels are shared)
+    typedef std::function<void(AProgress& progress)> Operation;
+
+    // Handler of finished operation which is called in UI thread with the time of operation
+    typedef std::function<void(qint64 time)> OperationHandler;
+
 private slots: // Private slots
 
     // Slot to open the image
@@ -107,12 +120,18 @@ private slots: // Private slots
     // Slot to run the sharpen filtration
     void Sharpen();
 
+    // Slot to run the unsharp masking
+    void UnsharpMask();
+
     // Slot to run separated gaussian blur
     void SeparateGaussianBlur();
 
     // Slot to run IIR-imitated gaussian blur
     void IIRGaussianBlur();
 
+    // Slot to run edge-preserving bilateral blur
+    void BilateralBlur();
+
     // Slot to run Single Scale Retinex
     void SingleScaleRetinex();
 
@@ -125,6 +144,12 @@ private slots: // Private slots
     // Slot to run the gamma-correction
     void Gamma();
 
+    // Slot to run the equalization of histogram
+    void GlobalEqualization();
+
+    // Slot to run the contrast limited adaptive histogram equalization
+    void Clahe();
+
     // Slot to convolution the image with the Sobel operator
     void Sobel();
 
@@ -134,6 +159,9 @@ private slots: // Private slots
     // Slot to detect the borders by using Canny algorithm
     void Canny();
 
+    // Slot to detect the borders by using Canny algorithm with bilateral blur
+    void CannyBilateral();
+
     // Slot to detect the borders by using Sobel algorithm
     void SobelDetector();
 
@@ -161,6 +189,15 @@ private slots: // Private slots
     // Slot to run an adaptive threshold
     void AdaptiveThreshold();
 
+    // Slot to run the adaptive threshold by local statistics (Sauvola or Niblack)
+    void StatisticalThreshold();
+
+    // Slots to run the morphological operations
+    void Erosion();
+    void Dilation();
+    void Opening();
+    void Closing();
+
     // Slot to calculation of image average brightness
     void CalcAverageBrightness();
 
@@ -190,6 +227,15 @@ private slots: // Private slots
     void Upscale();
     void Downscale();
 
+    // Slot to display the percent of done work of running operation
+    void UpdateOperationProgress(int percent);
+
+    // Slot to request the cancellation of running operation
+    void CancelOperation();
+
+    // Slot to process the result of finished operation
+    void FinishOperation();
+
 signals: // Signals
 
     // Signal about select the other image
@@ -284,6 +330,9 @@ private: // Private methods
     // Forming the name for action of filtered image
     QString FormFilterActionName(AFilterType filterType, const int filterSize);
 
+    // Forming the name for action of morphological operation
+    QString FormMorphologyActionName(AMorphologyType morphType, const int seWidth, const int seHeight);
+
     // Forming the name for action of adaptive threshold
     QString FormAdaptiveThresholdActionName(AThresholdType thresholdType, const int threshold);
 
@@ -317,6 +366,9 @@ private: // Private methods
     // Filtering with the specified type
     void Filtering(AFilterType filterType);
 
+    // Morphological operation with the specified type
+    void Morphology(AMorphologyType morphType);
+
     // Correction with the specified type
     void Correct(ACorrectorType corType);
 
@@ -355,7 +407,7 @@ private: // Private methods
     void DeleteImg(int& curImg, std::vector<AImage>& imgs, std::vector<QAction*>& actions);
 
     // Add processed image to menu, add his action. Also this image will be drawn and current image will be him
-    void AddProcessedImg(const AImage& processedImg, const QString& actionName);
+    void AddProcessedImg(AImage&& processedImg, const QString& actionName);
 
     // Recalculation from coordinates of main window to coordinates of central widget
     void RecalcToCentralWidgetCoordinates(QPoint& pnt);
@@ -363,6 +415,11 @@ private: // Private methods
     // Check if saved processed images
     bool HaveNotSavedImages() const;
 
+    // Run the operation in the worker thread and show its progress (the window is not blocked)
+    // Only one operation can be run at the same time. If the operation doesn't report progress
+    // then the busy indicator is shown. Handler is not called if the operation was cancelled
+    void RunOperation(const QString& title, bool reportsProgress, const Operation& operation, const OperationHandler& handler);
+
 protected: // Protected methods
 
     // Processing of the mouse events
@@ -395,14 +452,19 @@ private: // Private members
     QAction* mGaussianBlurAction;
     QAction* mSepGaussianBlurAction;
     QAction* mIIRGaussianBlurAction;
+    QAction* mBilateralBlurAction;
     QAction* mSharpenAction;
+    QAction* mUnsharpMaskAction;
     QAction* mSingleScaleRetinexAction;
     QAction* mAutoLevelsAction;
     QAction* mNormAutoLevelsAction;
     QAction* mGammaAction;
+    QAction* mGlobalEqualizationAction;
+    QAction* mClaheAction;
     QAction* mSobelAction;
     QAction* mScharrAction;
     QAction* mCannyAction;
+    QAction* mCannyBilateralAction;
     QAction* mSobelDetectorAction;
     QAction* mScharrDetectorAction;
     QAction* mInfPriorCombAction;
@@ -417,6 +479,11 @@ private: // Private members
     QAction* mImgCreateBrightnessHistogramAction;
     QAction* mHuMomentsAction;
     QAction* mAdaptiveThresholdAction;
+    QAction* mStatisticalThresholdAction;
+    QAction* mErosionAction;
+    QAction* mDilationAction;
+    QAction* mOpeningAction;
+    QAction* mClosingAction;
     QAction* mIntlQualIndAction;
     QAction* mUpscaleAction;
     QAction* mDownscaleAction;
@@ -437,6 +504,9 @@ private: // Private members
     // Label in status bar
     QLabel* statusBarLabel;
 
+    // Label in status bar with the result of last operation
+    QLabel* mOperationStatusLabel;
+
     // This member is used to draw the image on the screen
     HistogramWidget* mHist;
 
@@ -461,6 +531,22 @@ private: // Private members
     // Mouse working mode
     MouseMode mMouseMode;
 
+    // Watcher of operation which is run in the worker thread
+    QFutureWatcher<void> mOperationWatcher;
+
+    // Progress of running operation (it is shared with the worker thread)
+    AProgress mOperationProgress;
+
+    // Dialog with progress of running operation (nullptr if there is no running operation)
+    QProgressDialog* mProgressDialog;
+
+    // Title and handler of running operation
+    QString mOperationTitle;
+    OperationHandler mOperationHandler;
+
+    // Timer of running operation
+    QElapsedTimer mOperationTimer;
+
 };
 
 #endif // MAINWINDOW_H
@@ -26,19 +26,37 @@
 #include "AImage.h"
 
 #include <QImage>
-#include <QRgb>
+#include <QSysInfo>
+
+// Get the format of AImage buffers which matches the 32-bit QImage pixels (0xAARRGGBB)
+static APixelFormat GetARGB32PixelFormat()
+{
+    return (QSysInfo::ByteOrder == QSysInfo::LittleEndian) ? APixelFormat::BGRA8888 : APixelFormat::ARGB8888;
+}
 
 AImage ImageTransormer::QImage2AImage(const QImage& from)
 {
     AImage to(from.height(), from.width());
 
-    for (int y = 0; y < from.height(); ++y)
-        for (int x = 0; x < from.width(); ++x)
-        {
-            QRgb pix = from.pixel(x, y);
-            int brightness = qGray(pix);
-            to.SetPixel(y, x, static_cast<AByte>(brightness));
-        }
+    switch (from.format())
+    {
+    case QImage::Format_Grayscale8:
+        to.Import(from.constBits(), from.bytesPerLine(), APixelFormat::GRAY8);
+        break;
+    case QImage::Format_RGB888:
+        to.Import(from.constBits(), from.bytesPerLine(), APixelFormat::RGB888);
+        break;
+    case QImage::Format_RGB32:
+    case QImage::Format_ARGB32:
+        to.Import(from.constBits(), from.bytesPerLine(), GetARGB32PixelFormat());
+        break;
+    default:
+    {
+        const QImage converted = from.convertToFormat(QImage::Format_ARGB32);
+        to.Import(converted.constBits(), converted.bytesPerLine(), GetARGB32PixelFormat());
+        break;
+    }
+    }
 
     return to;
 }
@@ -47,13 +65,7 @@ QImage ImageTransormer::AImage2QImage(const AImage& from)
 {
     QImage to(from.GetWidth(), from.GetHeight(), QImage::Format_ARGB32);
 
-    for (int y = 0; y < to.height(); ++y)
-        for (int x = 0; x < to.width(); ++x)
-        {
-            int brig = static_cast<int>(from.GetPixel(y, x));
-            QRgb pix = qRgb(brig, brig, brig);
-            to.setPixel(x, y, pix);
-        }
+    from.Export(to.bits(), to.bytesPerLine(), GetARGB32PixelFormat());
 
     return to;
 }
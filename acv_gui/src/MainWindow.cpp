@@ -29,6 +29,7 @@
 #include "ImageTransformer.h"
 
 #include "AImageParametersCalculator.h"
+#include "ARawImageFile.h"
 
 #include "qcustomplot.h"
 
@@ -41,6 +42,8 @@
 #include <QInputDialog>
 #include <QElapsedTimer>
 #include <QMouseEvent>
+#include <QProgressDialog>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include <exception>
 
@@ -52,7 +55,8 @@ MainWindow::MainWindow(QWidget *parent) :
     mViewer(new ImageViewer),    
     mCurOpenedImg(-1),
     mCurProcessedImg(-1),
-    mMouseMode(MouseMode::SELECT_PIXEL)
+    mMouseMode(MouseMode::SELECT_PIXEL),
+    mProgressDialog(nullptr)
 {
     mUi->setupUi(this);
     setCentralWidget(mViewer);
@@ -72,12 +76,26 @@ MainWindow::MainWindow(QWidget *parent) :
     connect(this, SIGNAL(AllImgsAreClosed()), this, SLOT(UpdateImgsMenu()));
     connect(this, SIGNAL(ExecuteHuMomentsForBoundary(int,int,int,int)),
             this, SLOT(CalcHuMomentsExecute(int,int,int,int)));
+    connect(&mOperationWatcher, SIGNAL(finished()), this, SLOT(FinishOperation()));
+
+    // The progress is reported from the worker thread, so the percent is passed to UI thread by the queue of events
+    mOperationProgress.SetCallback([this](int percent)
+    {
+        QMetaObject::invokeMethod(this, "UpdateOperationProgress", Qt::QueuedConnection, Q_ARG(int, percent));
+    });
 
     move((qApp->desktop()->width() - width()) / 2, (qApp->desktop()->height() - height()) / 2);
 }
 
 MainWindow::~MainWindow()
 {
+    // The running operation is stopped because its callback refers to the window
+    if (mOperationWatcher.isRunning())
+    {
+        mOperationProgress.Cancel();
+        mOperationWatcher.waitForFinished();
+    }
+
     delete mUi;
     delete mViewer;
     delete mHist;
@@ -126,13 +144,41 @@ void MainWindow::CreateFilteringActions()
     mIIRGaussianBlurAction->setStatusTip(tr("IIR-imitated gaussian blur"));
     connect(mIIRGaussianBlurAction, SIGNAL(triggered()), this, SLOT(IIRGaussianBlur()));
 
+    mBilateralBlurAction = new QAction(tr("Bilateral filter"), this);
+    mBilateralBlurAction->setStatusTip(tr("Edge-preserving bilateral blur"));
+    connect(mBilateralBlurAction, SIGNAL(triggered()), this, SLOT(BilateralBlur()));
+
     mSharpenAction = new QAction(tr("Sharpen filter"), this);
     mSharpenAction->setStatusTip(tr("Increase the sharpness of the image"));
     connect(mSharpenAction, SIGNAL(triggered()), this, SLOT(Sharpen()));
 
+    mUnsharpMaskAction = new QAction(tr("Unsharp mask"), this);
+    mUnsharpMaskAction->setStatusTip(tr("Sharpen the image by unsharp masking with radius, amount and threshold"));
+    connect(mUnsharpMaskAction, SIGNAL(triggered()), this, SLOT(UnsharpMask()));
+
     mAdaptiveThresholdAction = new QAction(tr("Adaptive threshold"), this);
     mAdaptiveThresholdAction->setStatusTip(tr("Select the pixels by threshold"));
     connect(mAdaptiveThresholdAction, SIGNAL(triggered()), this, SLOT(AdaptiveThreshold()));
+
+    mStatisticalThresholdAction = new QAction(tr("Sauvola/Niblack threshold"), this);
+    mStatisticalThresholdAction->setStatusTip(tr("Select the pixels by threshold of local mean and deviation"));
+    connect(mStatisticalThresholdAction, SIGNAL(triggered()), this, SLOT(StatisticalThreshold()));
+
+    mErosionAction = new QAction(tr("Erosion"), this);
+    mErosionAction->setStatusTip(tr("Morphological erosion of current image"));
+    connect(mErosionAction, SIGNAL(triggered()), this, SLOT(Erosion()));
+
+    mDilationAction = new QAction(tr("Dilation"), this);
+    mDilationAction->setStatusTip(tr("Morphological dilation of current image"));
+    connect(mDilationAction, SIGNAL(triggered()), this, SLOT(Dilation()));
+
+    mOpeningAction = new QAction(tr("Opening"), this);
+    mOpeningAction->setStatusTip(tr("Morphological opening of current image (removes small bright details)"));
+    connect(mOpeningAction, SIGNAL(triggered()), this, SLOT(Opening()));
+
+    mClosingAction = new QAction(tr("Closing"), this);
+    mClosingAction->setStatusTip(tr("Morphological closing of current image (removes small dark details)"));
+    connect(mClosingAction, SIGNAL(triggered()), this, SLOT(Closing()));
 }
 
 void MainWindow::CreateCorrectorActions()
@@ -152,6 +198,14 @@ void MainWindow::CreateCorrectorActions()
     mGammaAction = new QAction(tr("Gamma-correction"), this);
     mGammaAction->setStatusTip(tr("Run the gamma-correction"));
     connect(mGammaAction, SIGNAL(triggered()), this, SLOT(Gamma()));
+
+    mGlobalEqualizationAction = new QAction(tr("Histogram equalization"), this);
+    mGlobalEqualizationAction->setStatusTip(tr("Run the equalization of histogram of the whole image"));
+    connect(mGlobalEqualizationAction, SIGNAL(triggered()), this, SLOT(GlobalEqualization()));
+
+    mClaheAction = new QAction(tr("CLAHE"), this);
+    mClaheAction->setStatusTip(tr("Run the contrast limited adaptive histogram equalization"));
+    connect(mClaheAction, SIGNAL(triggered()), this, SLOT(Clahe()));
 }
 
 void MainWindow::CreateOperatorActions()
@@ -171,6 +225,10 @@ void MainWindow::CreateBodersDetectorsActions()
     mCannyAction->setStatusTip(tr("Detect the borders by using Canny algorithm"));
     connect(mCannyAction, SIGNAL(triggered()), this, SLOT(Canny()));
 
+    mCannyBilateralAction = new QAction(tr("Canny algorithm with bilateral blur"), this);
+    mCannyBilateralAction->setStatusTip(tr("Detect the borders by using Canny algorithm with edge-preserving blur"));
+    connect(mCannyBilateralAction, SIGNAL(triggered()), this, SLOT(CannyBilateral()));
+
     mSobelDetectorAction = new QAction(tr("Sobel algorithm"), this);
     mSobelDetectorAction->setStatusTip(tr("Detect the borders by using Sobel algorithm"));
     connect(mSobelDetectorAction, SIGNAL(triggered()), this, SLOT(SobelDetector()));
@@ -282,8 +340,16 @@ void MainWindow::CreateFilteringMenu()
     mFilterMenu->addAction(mGaussianBlurAction);
     mFilterMenu->addAction(mSepGaussianBlurAction);
     mFilterMenu->addAction(mIIRGaussianBlurAction);
+    mFilterMenu->addAction(mBilateralBlurAction);
     mFilterMenu->addAction(mSharpenAction);
+    mFilterMenu->addAction(mUnsharpMaskAction);
     mFilterMenu->addAction(mAdaptiveThresholdAction);
+    mFilterMenu->addAction(mStatisticalThresholdAction);
+    mFilterMenu->addSeparator();
+    mFilterMenu->addAction(mErosionAction);
+    mFilterMenu->addAction(mDilationAction);
+    mFilterMenu->addAction(mOpeningAction);
+    mFilterMenu->addAction(mClosingAction);
 }
 
 void MainWindow::CreateCorrectorMenu()
@@ -294,6 +360,8 @@ void MainWindow::CreateCorrectorMenu()
     mCorrectorMenu->addAction(mAutoLevelsAction);
     mCorrectorMenu->addAction(mNormAutoLevelsAction);
     mCorrectorMenu->addAction(mGammaAction);
+    mCorrectorMenu->addAction(mGlobalEqualizationAction);
+    mCorrectorMenu->addAction(mClaheAction);
 }
 
 void MainWindow::CreateOperatorsMenu()
@@ -309,6 +377,7 @@ void MainWindow::CreateBordersDetectorsMenu()
     mBordersDetectorsMenu = mProcessingMenu->addMenu(tr("Detectors of borders"));
 
     mBordersDetectorsMenu->addAction(mCannyAction);
+    mBordersDetectorsMenu->addAction(mCannyBilateralAction);
     mBordersDetectorsMenu->addAction(mSobelDetectorAction);
     mBordersDetectorsMenu->addAction(mScharrDetectorAction);
 }
@@ -367,12 +436,25 @@ void MainWindow::CreateStatusBar()
 
     statusBar()->addWidget(statusBarLabel);
 
+    mOperationStatusLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(mOperationStatusLabel);
+
     connect(this, SIGNAL(UpdateCoordsAndBrigInStatusBar(int,int)),
             this, SLOT(DisplayCoordsAndBrigInStatusBar(int,int)));
 }
 
 bool MainWindow::LoadImgFromFile(const QString& fileName)
 {
+    // Raw image files are read without decoding
+    if (fileName.endsWith(".acvraw", Qt::CaseInsensitive))
+    {
+        AImage rawImg(-1, -1);
+        bool ret = ARawImageFile::Load(fileName.toStdString(), rawImg);
+        if (ret)
+            mOpenedImgs.push_back(std::move(rawImg));
+        return ret;
+    }
+
     QImage img(fileName);
     bool ret = !img.isNull();
     if (ret)
@@ -492,6 +574,67 @@ void MainWindow::Sharpen()
     Filtering(AFilterType::SHARPEN);
 }
 
+void MainWindow::UnsharpMask()
+{
+    if (ImgWasSelected())
+    {
+        const int DEFAULT_RADIUS = 2, MIN_RADIUS = 1, MAX_RADIUS = 100, RADIUS_STEP = 1;
+        const int DEFAULT_AMOUNT = 100, MIN_AMOUNT = 0, MAX_AMOUNT = 500, AMOUNT_STEP = 10;
+        const int DEFAULT_THRESHOLD = 0, MIN_THRESHOLD = 0, MAX_THRESHOLD = 255, THRESHOLD_STEP = 1;
+
+        int radius = QInputDialog::getInt(this, tr("Enter the radius of blur"), tr("Radius"),
+                                          DEFAULT_RADIUS, MIN_RADIUS, MAX_RADIUS, RADIUS_STEP);
+        int amount = QInputDialog::getInt(this, tr("Enter the amount of sharpening"), tr("Amount (percents)"),
+                                          DEFAULT_AMOUNT, MIN_AMOUNT, MAX_AMOUNT, AMOUNT_STEP);
+        int threshold = QInputDialog::getInt(this, tr("Enter the threshold of differences"), tr("Threshold"),
+                                             DEFAULT_THRESHOLD, MIN_THRESHOLD, MAX_THRESHOLD, THRESHOLD_STEP);
+
+        const AImage curImg = GetCurImg();
+        auto processedImg = std::make_shared<AImage>(curImg.GetHeight(), curImg.GetWidth());
+        auto filtRes = std::make_shared<AFiltrationResult>(AFiltrationResult::INTERNAL_ERROR);
+        QString actionName = FormProcessedImgActionName(tr("F_USM_%1_%2_%3: ").arg(radius).arg(amount).arg(threshold));
+
+        RunOperation(tr("Unsharp mask"), true, [=](AProgress& progress)
+        {
+            *filtRes = AImageFilter::UnsharpMask(curImg, *processedImg, radius, amount, threshold, &progress);
+        },
+        [=](qint64 filterTime)
+        {
+            if (*filtRes == AFiltrationResult::SUCCESS)
+            {
+                AddProcessedImg(std::move(*processedImg), actionName);
+                mOperationStatusLabel->setText(tr("Time of filtration: %1 msec").arg(filterTime));
+            }
+            else
+                QMessageBox::warning(this, tr("Unsharp mask"), FormFiltrationResultStr(*filtRes), QMessageBox::Ok);
+        });
+    }
+    else
+    {
+        QMessageBox::warning(this, tr("Unsharp mask"), tr("No image selected"), QMessageBox::Ok);
+    }
+}
+
+void MainWindow::Erosion()
+{
+    Morphology(AMorphologyType::EROSION);
+}
+
+void MainWindow::Dilation()
+{
+    Morphology(AMorphologyType::DILATION);
+}
+
+void MainWindow::Opening()
+{
+    Morphology(AMorphologyType::OPENING);
+}
+
+void MainWindow::Closing()
+{
+    Morphology(AMorphologyType::CLOSING);
+}
+
 void MainWindow::SeparateGaussianBlur()
 {
     Filtering(AFilterType::SEP_GAUSSIAN);
@@ -502,6 +645,11 @@ void MainWindow::IIRGaussianBlur()
     Filtering(AFilterType::IIR_GAUSSIAN);
 }
 
+void MainWindow::BilateralBlur()
+{
+    Filtering(AFilterType::BILATERAL);
+}
+
 void MainWindow::SingleScaleRetinex()
 {
     Correct(ACorrectorType::SSRETINEX);
@@ -522,6 +670,16 @@ void MainWindow::Gamma()
     Correct(ACorrectorType::GAMMA);
 }
 
+void MainWindow::GlobalEqualization()
+{
+    Correct(ACorrectorType::GLOBAL_EQUALIZATION);
+}
+
+void MainWindow::Clahe()
+{
+    Correct(ACorrectorType::CLAHE);
+}
+
 void MainWindow::Operator(ADetectorType operatorType)
 {
     if (ImgWasSelected())
@@ -533,25 +691,25 @@ void MainWindow::Operator(ADetectorType operatorType)
         else
             type = AOperatorType::VERTICAL;
 
-        const AImage& curImg = GetCurImg();
-        AImage processedImg(curImg.GetHeight(), curImg.GetWidth());
-
-        QElapsedTimer timer;
-        timer.start();
-
-        bool filtred = ABordersDetector::OperatorConvolution(curImg, processedImg, operatorType, type);
+        const AImage curImg = GetCurImg();
+        auto processedImg = std::make_shared<AImage>(curImg.GetHeight(), curImg.GetWidth());
+        auto filtred = std::make_shared<bool>(false);
+        QString actionName = FormOperatorActionName(operatorType, type);
 
-        qint64 filterTime = timer.elapsed();
-
-        if (filtred)
+        RunOperation(tr("Operator"), false, [=](AProgress& /*progress*/)
         {
-            QString actionName = FormOperatorActionName(operatorType, type);
-            AddProcessedImg(processedImg, actionName);
-
-            QMessageBox::information(this, tr("Operator"), tr("Time of convolution: %1 msec").arg(filterTime), QMessageBox::Ok);
-        }
-        else
-            QMessageBox::warning(this, tr("Operator"), tr("Could not convolution"), QMessageBox::Ok);
+            *filtred = ABordersDetector::OperatorConvolution(curImg, *processedImg, operatorType, type);
+        },
+        [=](qint64 filterTime)
+        {
+            if (*filtred)
+            {
+                AddProcessedImg(std::move(*processedImg), actionName);
+                mOperationStatusLabel->setText(tr("Time of convolution: %1 msec").arg(filterTime));
+            }
+            else
+                QMessageBox::warning(this, tr("Operator"), tr("Could not convolution"), QMessageBox::Ok);
+        });
     }
     else
     {
@@ -569,9 +727,9 @@ void MainWindow::Scharr()
     Operator(ADetectorType::SCHARR);
 }
 
-void MainWindow::AddProcessedImg(const AImage& processedImg, const QString& actionName)
+void MainWindow::AddProcessedImg(AImage&& processedImg, const QString& actionName)
 {
-    mProcessedImgs.push_back(processedImg);
+    mProcessedImgs.push_back(std::move(processedImg));
     mProcImgsSavingFlags.push_back(false);
 
     mCurOpenedImg = -1;
@@ -654,6 +812,11 @@ void MainWindow::Canny()
     DetectBorders(ADetectorType::CANNY);
 }
 
+void MainWindow::CannyBilateral()
+{
+    DetectBorders(ADetectorType::CANNY_BILATERAL);
+}
+
 void MainWindow::SobelDetector()
 {
     DetectBorders(ADetectorType::SOBEL);
@@ -668,25 +831,25 @@ void MainWindow::DetectBorders(ADetectorType detectorType)
 {
     if (ImgWasSelected())
     {
-        const AImage& curImg = GetCurImg();
-        AImage processedImg(curImg.GetHeight(), curImg.GetWidth());
-
-        QElapsedTimer timer;
-        timer.start();
-
-        bool detected = ABordersDetector::DetectBorders(curImg, processedImg, detectorType);
+        const AImage curImg = GetCurImg();
+        auto processedImg = std::make_shared<AImage>(curImg.GetHeight(), curImg.GetWidth());
+        auto detected = std::make_shared<bool>(false);
+        QString actionName = FormBordersDetectorActionName(detectorType);
 
-        qint64 filterTime = timer.elapsed();
-
-        if (detected)
+        RunOperation(tr("Detecting of the borders"), true, [=](AProgress& progress)
         {
-            QString actionName = FormBordersDetectorActionName(detectorType);
-            AddProcessedImg(processedImg, actionName);
-
-            QMessageBox::information(this, tr("Detecting of the borders"), tr("Time of detecting: %1 msec").arg(filterTime), QMessageBox::Ok);
-        }
-        else
-            QMessageBox::warning(this, tr("Detecting of the borders"), tr("Could not detect the borders"), QMessageBox::Ok);
+            *detected = ABordersDetector::DetectBorders(curImg, *processedImg, detectorType, &progress);
+        },
+        [=](qint64 filterTime)
+        {
+            if (*detected)
+            {
+                AddProcessedImg(std::move(*processedImg), actionName);
+                mOperationStatusLabel->setText(tr("Time of detecting: %1 msec").arg(filterTime));
+            }
+            else
+                QMessageBox::warning(this, tr("Detecting of the borders"), tr("Could not detect the borders"), QMessageBox::Ok);
+        });
     }
     else
     {
@@ -706,6 +869,8 @@ QString MainWindow::FormFiltrationResultStr(AFiltrationResult filtRes)
         return tr("Error during filtration");
     case AFiltrationResult::SMALL_FILTER_SIZE:
         return tr("Filter size should be >= 6");
+    case AFiltrationResult::CANCELLED:
+        return tr("Filtration was cancelled");
     case AFiltrationResult::SUCCESS:
         return tr("Success of filtration");
     default:
@@ -725,25 +890,25 @@ void MainWindow::Filtering(AFilterType filterType)
                                               DEFAULT_FILTER_SIZE, MIN_FILTER_SIZE, MAX_FILTER_SIZE, FILTER_SIZE_STEP);
         }
 
-        const AImage& curImg = GetCurImg();
-        AImage processedImg(curImg.GetHeight(), curImg.GetWidth());
+        const AImage curImg = GetCurImg();
+        auto processedImg = std::make_shared<AImage>(curImg.GetHeight(), curImg.GetWidth());
+        auto filtRes = std::make_shared<AFiltrationResult>(AFiltrationResult::INTERNAL_ERROR);
+        QString actionName = FormFilterActionName(filterType, filterSize);
 
-        QElapsedTimer timer;
-        timer.start();
-
-        AFiltrationResult filtRes = AImageFilter::Filter(curImg, processedImg, filterType, filterSize);
-
-        qint64 filterTime = timer.elapsed();
-
-        if (filtRes == AFiltrationResult::SUCCESS)
+        RunOperation(tr("Image filtration"), true, [=](AProgress& progress)
         {
-            QString actionName = FormFilterActionName(filterType, filterSize);
-            AddProcessedImg(processedImg, actionName);
-
-            QMessageBox::information(this, tr("Image filtration"), tr("Time of filtration: %1 msec").arg(filterTime), QMessageBox::Ok);
-        }
-        else
-            QMessageBox::warning(this, tr("Image filtration"), FormFiltrationResultStr(filtRes), QMessageBox::Ok);
+            *filtRes = AImageFilter::Filter(curImg, *processedImg, filterType, filterSize, &progress);
+        },
+        [=](qint64 filterTime)
+        {
+            if (*filtRes == AFiltrationResult::SUCCESS)
+            {
+                AddProcessedImg(std::move(*processedImg), actionName);
+                mOperationStatusLabel->setText(tr("Time of filtration: %1 msec").arg(filterTime));
+            }
+            else
+                QMessageBox::warning(this, tr("Image filtration"), FormFiltrationResultStr(*filtRes), QMessageBox::Ok);
+        });
     }
     else
     {
@@ -751,29 +916,65 @@ void MainWindow::Filtering(AFilterType filterType)
     }
 }
 
-void MainWindow::Correct(ACorrectorType corType)
+void MainWindow::Morphology(AMorphologyType morphType)
 {
     if (ImgWasSelected())
     {
-        const AImage& curImg = GetCurImg();
-        AImage processedImg(curImg.GetHeight(), curImg.GetWidth());
-
-        QElapsedTimer timer;
-        timer.start();
-
-        bool corrected = AImageCorrector::Correct(curImg, processedImg, corType);
+        const int DEFAULT_SE_SIZE = 3, MIN_SE_SIZE = 1, MAX_SE_SIZE = 101, SE_SIZE_STEP = 2;
+        int seWidth = QInputDialog::getInt(this, tr("Enter the width of structuring element (odd positive number)"), tr("Width"),
+                                           DEFAULT_SE_SIZE, MIN_SE_SIZE, MAX_SE_SIZE, SE_SIZE_STEP);
+        int seHeight = QInputDialog::getInt(this, tr("Enter the height of structuring element (odd positive number)"), tr("Height"),
+                                            seWidth, MIN_SE_SIZE, MAX_SE_SIZE, SE_SIZE_STEP);
+
+        const AImage curImg = GetCurImg();
+        auto processedImg = std::make_shared<AImage>(curImg.GetHeight(), curImg.GetWidth());
+        auto filtRes = std::make_shared<AFiltrationResult>(AFiltrationResult::INTERNAL_ERROR);
+        QString actionName = FormMorphologyActionName(morphType, seWidth, seHeight);
+
+        RunOperation(tr("Morphological operation"), true, [=](AProgress& progress)
+        {
+            *filtRes = AMorphologyFilter::Filter(curImg, *processedImg, morphType, seWidth, seHeight, &progress);
+        },
+        [=](qint64 filterTime)
+        {
+            if (*filtRes == AFiltrationResult::SUCCESS)
+            {
+                AddProcessedImg(std::move(*processedImg), actionName);
+                mOperationStatusLabel->setText(tr("Time of operation: %1 msec").arg(filterTime));
+            }
+            else
+                QMessageBox::warning(this, tr("Morphological operation"), FormFiltrationResultStr(*filtRes), QMessageBox::Ok);
+        });
+    }
+    else
+    {
+        QMessageBox::warning(this, tr("Morphological operation"), tr("No image selected"), QMessageBox::Ok);
+    }
+}
 
-        qint64 correctionTime = timer.elapsed();
+void MainWindow::Correct(ACorrectorType corType)
+{
+    if (ImgWasSelected())
+    {
+        const AImage curImg = GetCurImg();
+        auto processedImg = std::make_shared<AImage>(curImg.GetHeight(), curImg.GetWidth());
+        auto corrected = std::make_shared<bool>(false);
+        QString actionName = FormCorrectorActionName(corType);
 
-        if (corrected)
+        RunOperation(tr("Image correction"), true, [=](AProgress& progress)
         {
-            QString actionName = FormCorrectorActionName(corType);
-            AddProcessedImg(processedImg, actionName);
-
-            QMessageBox::information(this, tr("Image correction"), tr("Time of correction: %1 msec").arg(correctionTime), QMessageBox::Ok);
-        }
-        else
-            QMessageBox::warning(this, tr("Image correction"), tr("Could not correct the image"), QMessageBox::Ok);
+            *corrected = AImageCorrector::Correct(curImg, *processedImg, corType, &progress);
+        },
+        [=](qint64 correctionTime)
+        {
+            if (*corrected)
+            {
+                AddProcessedImg(std::move(*processedImg), actionName);
+                mOperationStatusLabel->setText(tr("Time of correction: %1 msec").arg(correctionTime));
+            }
+            else
+                QMessageBox::warning(this, tr("Image correction"), tr("Could not correct the image"), QMessageBox::Ok);
+        });
     }
     else
     {
@@ -838,25 +1039,78 @@ void MainWindow::AdaptiveThreshold()
         else
             type = AThresholdType::MIN_MORE_THRESHOLD;
 
-        const AImage& curImg = GetCurImg();
-        AImage processedImg(curImg.GetHeight(), curImg.GetWidth());
+        const AImage curImg = GetCurImg();
+        auto processedImg = std::make_shared<AImage>(curImg.GetHeight(), curImg.GetWidth());
+        auto res = std::make_shared<bool>(false);
+        QString actionName = FormAdaptiveThresholdActionName(type, threshold);
 
-        QElapsedTimer timer;
-        timer.start();
+        RunOperation(tr("Adaptive threshold"), false, [=](AProgress& /*progress*/)
+        {
+            *res = AImageFilter::AdaptiveThreshold(curImg, *processedImg, DEFAULT_FILTER_SIZE, threshold, type);
+        },
+        [=](qint64 time)
+        {
+            if (*res)
+            {
+                AddProcessedImg(std::move(*processedImg), actionName);
+                mOperationStatusLabel->setText(tr("Time of calculation: %1 msec").arg(time));
+            }
+            else
+                QMessageBox::warning(this, tr("Adaptive threshold"), tr("Could not calculate an adaptive threshold"), QMessageBox::Ok);
+        });
+    }
+    else
+    {
+        QMessageBox::warning(this, tr("Adaptive threshold"), tr("No image selected"), QMessageBox::Ok);
+    }
+}
 
-        bool res = AImageFilter::AdaptiveThreshold(curImg, processedImg, DEFAULT_FILTER_SIZE, threshold, type);
+void MainWindow::StatisticalThreshold()
+{
+    if (ImgWasSelected())
+    {
+        const int DEFAULT_WINDOW_SIZE = 31, MIN_WINDOW_SIZE = 3, MAX_WINDOW_SIZE = 255, WINDOW_SIZE_STEP = 2;
+        const double MIN_FACTOR = -2.0, MAX_FACTOR = 2.0;
+        const int FACTOR_DECIMALS = 2;
 
-        qint64 time = timer.elapsed();
+        const QStringList methods = { tr("Sauvola"), tr("Niblack") };
+        const AThresholdMethod method = (QInputDialog::getItem(this, tr("Select the method of threshold"), tr("Method"),
+                                                               methods, 0, false) == methods[0])
+                                        ? AThresholdMethod::SAUVOLA : AThresholdMethod::NIBLACK;
 
-        if (res)
-        {
-            QString actionName = FormAdaptiveThresholdActionName(type, threshold);
-            AddProcessedImg(processedImg, actionName);
+        int windowSize = QInputDialog::getInt(this, tr("Enter the size of window (odd positive number)"), tr("Window size"),
+                                              DEFAULT_WINDOW_SIZE, MIN_WINDOW_SIZE, MAX_WINDOW_SIZE, WINDOW_SIZE_STEP);
+        double k = QInputDialog::getDouble(this, tr("Enter the factor of deviation"), tr("Factor"),
+                                           (method == AThresholdMethod::SAUVOLA) ? 0.34 : -0.2, MIN_FACTOR, MAX_FACTOR, FACTOR_DECIMALS);
 
-            QMessageBox::information(this, tr("Adaptive threshold"), tr("Time of calculation: %1 msec").arg(time), QMessageBox::Ok);
-        }
+        AThresholdType type;
+        if (QMessageBox::question(this, tr("Adaptive threshold"),
+                                  "If yes then selected pixels will be equal to MAX value. To MIN value in other case") == QMessageBox::Yes)
+            type = AThresholdType::MAX_MORE_THRESHOLD;
         else
-            QMessageBox::warning(this, tr("Adaptive threshold"), tr("Could not calculate an adaptive threshold"), QMessageBox::Ok);
+            type = AThresholdType::MIN_MORE_THRESHOLD;
+
+        const AImage curImg = GetCurImg();
+        auto processedImg = std::make_shared<AImage>(curImg.GetHeight(), curImg.GetWidth());
+        auto res = std::make_shared<bool>(false);
+        QString actionName = FormProcessedImgActionName(tr("AT_%1_%2: ")
+                                                        .arg(method == AThresholdMethod::SAUVOLA ? "SAUVOLA" : "NIBLACK")
+                                                        .arg(windowSize));
+
+        RunOperation(tr("Adaptive threshold"), false, [=](AProgress& /*progress*/)
+        {
+            *res = AImageFilter::AdaptiveThreshold(curImg, *processedImg, windowSize, static_cast<float>(k), method, type);
+        },
+        [=](qint64 time)
+        {
+            if (*res)
+            {
+                AddProcessedImg(std::move(*processedImg), actionName);
+                mOperationStatusLabel->setText(tr("Time of calculation: %1 msec").arg(time));
+            }
+            else
+                QMessageBox::warning(this, tr("Adaptive threshold"), tr("Could not calculate an adaptive threshold"), QMessageBox::Ok);
+        });
     }
     else
     {
@@ -1079,7 +1333,7 @@ void MainWindow::Scale(AScaleType scaleType)
         AImage scaleImg = curImg.Scale(scaleX, scaleY, scaleType);
 
         QString actionName = FormScaleImgActionName(scaleType, scaleX, scaleY);
-        AddProcessedImg(scaleImg, actionName);
+        AddProcessedImg(std::move(scaleImg), actionName);
     }
     else
     {
@@ -1109,6 +1363,8 @@ QString MainWindow::FormCombinationResultStr(ACombinationResult combRes)
         return tr("The combined images are not the same");
     case ACombinationResult::MANY_IMAGES:
         return tr("The number of images should be 2");
+    case ACombinationResult::CANCELLED:
+        return tr("Combining was cancelled");
     case ACombinationResult::SUCCESS:
         return tr("Success of combining");
     default:
@@ -1133,28 +1389,31 @@ void MainWindow::Combining(ACombineType combType)
                 return;
         }
 
-        AImageCombiner combiner;
-        for (const auto& img : mOpenedImgs)
-            combiner.AddImage(img);
-
-        AImage combImg(mOpenedImgs[0].GetHeight(), mOpenedImgs[0].GetWidth());
+        // The combiner refers to the added images, so the copies of opened images are kept until the end of combining
+        const std::vector<AImage> imgs = mOpenedImgs;
+        const bool needSelectBase = (answer == QMessageBox::Yes);
+        auto combImg = std::make_shared<AImage>(imgs[0].GetHeight(), imgs[0].GetWidth());
+        auto combRes = std::make_shared<ACombinationResult>(ACombinationResult::INCORRECT_COMBINER_TYPE);
+        QString actionName = FormCombineActionName(combType);
 
-        QElapsedTimer timer;
-        timer.start();
-
-        ACombinationResult combRes = combiner.Combine(combType, combImg, answer == QMessageBox::Yes);
-
-        qint64 combTime = timer.elapsed();
-
-        if (combRes == ACombinationResult::SUCCESS && combImg.IsInitialized())
+        RunOperation(tr("Images combining"), true, [=](AProgress& progress)
         {
-            QString actionName = FormCombineActionName(combType);
-            AddProcessedImg(combImg, actionName);
+            AImageCombiner combiner;
+            for (const auto& img : imgs)
+                combiner.AddImage(img);
 
-            QMessageBox::information(this, tr("Images combining"), tr("Time of combining: %1 msec").arg(combTime), QMessageBox::Ok);
-        }
-        else
-            QMessageBox::warning(this, tr("Images combining"), FormCombinationResultStr(combRes), QMessageBox::Ok);
+            *combRes = combiner.Combine(combType, *combImg, needSelectBase, &progress);
+        },
+        [=](qint64 combTime)
+        {
+            if (*combRes == ACombinationResult::SUCCESS && combImg->IsInitialized())
+            {
+                AddProcessedImg(std::move(*combImg), actionName);
+                mOperationStatusLabel->setText(tr("Time of combining: %1 msec").arg(combTime));
+            }
+            else
+                QMessageBox::warning(this, tr("Images combining"), FormCombinationResultStr(*combRes), QMessageBox::Ok);
+        });
     }
     else
     {
@@ -1227,6 +1486,38 @@ QString MainWindow::FormFilterActionName(AFilterType filterType, const int filte
     case AFilterType::SHARPEN:
         ret = tr("F_SHARP: ");
         break;
+    case AFilterType::BILATERAL:
+        ret = tr("F_BIL_%1: ").arg(filterSize);
+        break;
+    case AFilterType::UNSHARP_MASK:
+        ret = tr("F_USM_%1: ").arg(filterSize);
+        break;
+    default:
+        return QString();
+    }
+
+    ret = FormProcessedImgActionName(ret);
+    return ret;
+}
+
+QString MainWindow::FormMorphologyActionName(AMorphologyType morphType, const int seWidth, const int seHeight)
+{
+    QString ret;
+
+    switch (morphType)
+    {
+    case AMorphologyType::EROSION:
+        ret = tr("M_ER_%1x%2: ").arg(seWidth).arg(seHeight);
+        break;
+    case AMorphologyType::DILATION:
+        ret = tr("M_DIL_%1x%2: ").arg(seWidth).arg(seHeight);
+        break;
+    case AMorphologyType::OPENING:
+        ret = tr("M_OPEN_%1x%2: ").arg(seWidth).arg(seHeight);
+        break;
+    case AMorphologyType::CLOSING:
+        ret = tr("M_CLOSE_%1x%2: ").arg(seWidth).arg(seHeight);
+        break;
     default:
         return QString();
     }
@@ -1273,6 +1564,12 @@ QString MainWindow::FormCorrectorActionName(ACorrectorType corType)
     case ACorrectorType::GAMMA:
         ret = tr("CORR_GAM: ");
         break;
+    case ACorrectorType::GLOBAL_EQUALIZATION:
+        ret = tr("CORR_EQ: ");
+        break;
+    case ACorrectorType::CLAHE:
+        ret = tr("CORR_CLAHE: ");
+        break;
     default:
         return QString();
     }
@@ -1318,6 +1615,9 @@ QString MainWindow::FormBordersDetectorActionName(ADetectorType detectorType)
     case ADetectorType::CANNY:
         ret = tr("BD_C: ");
         break;
+    case ADetectorType::CANNY_BILATERAL:
+        ret = tr("BD_CB: ");
+        break;
     default:
         return QString();
     }
@@ -1362,7 +1662,7 @@ bool MainWindow::ImgsWereOpened() const
 void MainWindow::OpenImgFile()
 {
     QStringList fileNames = QFileDialog::getOpenFileNames(this, tr("Open image(-s)"), ".",
-                                                          tr("Image files (*.bmp *.jpg)"));
+                                                          tr("Image files (*.bmp *.jpg *.acvraw)"));
 
     // Loading image files and creating actions for them
     bool loaded = false;
@@ -1443,11 +1743,16 @@ void MainWindow::CloseImgFile()
 void MainWindow::SaveImgFile()
 {
     QString fileName = QFileDialog::getSaveFileName(this, tr("Save image"), ".",
-                                                    tr("Image files (*.bmp)"));
+                                                    tr("Image files (*.bmp);;Raw image files (*.acvraw)"));
     if (!fileName.isEmpty())
     {
-        QImage img = ImageTransormer::AImage2QImage(GetCurImg());
-        if (!img.save(fileName))
+        bool saved = false;
+        if (fileName.endsWith(".acvraw", Qt::CaseInsensitive))
+            saved = ARawImageFile::Save(fileName.toStdString(), GetCurImg());
+        else
+            saved = ImageTransormer::AImage2QImage(GetCurImg()).save(fileName);
+
+        if (!saved)
             QMessageBox::warning(this, tr("Save image"), tr("Could not save image"), QMessageBox::Ok);
         else
         {
@@ -1465,6 +1770,73 @@ bool MainWindow::HaveNotSavedImages() const
     return false;
 }
 
+void MainWindow::RunOperation(const QString& title, bool reportsProgress, const Operation& operation, const OperationHandler& handler)
+{
+    if (mOperationWatcher.isRunning())
+    {
+        QMessageBox::warning(this, title, tr("Other operation is running. Wait for its finish or cancel it"), QMessageBox::Ok);
+        return;
+    }
+
+    const int PROGRESS_DIALOG_DELAY = 300; // The dialog is not shown for short operations (msec)
+
+    mOperationTitle = title;
+    mOperationHandler = handler;
+    mOperationProgress.Reset();
+
+    // The range of dialog without progress is empty, so the busy indicator is shown
+    mProgressDialog = new QProgressDialog(title, tr("Cancel"), 0, reportsProgress ? 100 : 0, this);
+    mProgressDialog->setWindowModality(Qt::NonModal);
+    mProgressDialog->setMinimumDuration(PROGRESS_DIALOG_DELAY);
+    mProgressDialog->setAutoClose(false);
+    mProgressDialog->setAutoReset(false);
+    mProgressDialog->setValue(0);
+    connect(mProgressDialog, SIGNAL(canceled()), this, SLOT(CancelOperation()));
+
+    mOperationStatusLabel->setText(tr("%1 is running...").arg(title));
+    mOperationTimer.start();
+
+    // The copy of progress shares its state with the progress of window
+    AProgress progress = mOperationProgress;
+    mOperationWatcher.setFuture(QtConcurrent::run([operation, progress]() mutable { operation(progress); }));
+}
+
+void MainWindow::UpdateOperationProgress(int percent)
+{
+    // The percents from different threads can come out of order
+    if (mProgressDialog && mProgressDialog->maximum() > 0 && percent > mProgressDialog->value())
+        mProgressDialog->setValue(percent);
+}
+
+void MainWindow::CancelOperation()
+{
+    mOperationProgress.Cancel();
+    mOperationStatusLabel->setText(tr("%1 is cancelling...").arg(mOperationTitle));
+}
+
+void MainWindow::FinishOperation()
+{
+    qint64 time = mOperationTimer.elapsed();
+
+    if (mProgressDialog)
+    {
+        mProgressDialog->deleteLater();
+        mProgressDialog = nullptr;
+    }
+
+    OperationHandler handler = std::move(mOperationHandler);
+    mOperationHandler = nullptr;
+
+    // The result of cancelled operation is dropped even if the operation could not be stopped
+    if (mOperationProgress.IsCancelled())
+        mOperationStatusLabel->setText(tr("%1 was cancelled").arg(mOperationTitle));
+    else
+    {
+        mOperationStatusLabel->clear();
+        handler(time);
+    }
+}
+
 void MainWindow::Exit()
 {
     if (HaveNotSavedImages())
@@ -36,6 +36,9 @@ CONFIG -= qt
 
 DEFINES += ACV_LIBRARY
 
+# Built-in profiling of engine stages is enabled by "qmake CONFIG+=acv_profiling"
+acv_profiling: DEFINES += ACV_PROFILING
+
 INCLUDEPATH += \
         include \
         src\include\engine \
@@ -51,6 +54,29 @@ SOURCES += \
         src/engine/ImageFilter.cpp \
         src/engine/ImageParametersCalculator.cpp \
         src/engine/MatrixFilter.cpp \
+        src/engine/MomentsCalculator.cpp \
+        src/engine/LabelImage.cpp \
+        src/engine/BinaryImage.cpp \
+        src/engine/Parallel.cpp \
+        src/engine/TaskGraph.cpp \
+        src/engine/TaskScheduler.cpp \
+        src/engine/MorphologyFilter.cpp \
+        src/engine/Pipeline.cpp \
+        src/engine/PixelConverter.cpp \
+        src/engine/MultiChannelImage.cpp \
+        src/engine/TypedImageFilter.cpp \
+        src/engine/TypedBordersDetector.cpp \
+        src/engine/TypedImageCorrector.cpp \
+        src/engine/RawImageFile.cpp \
+        src/engine/TiledProcessor.cpp \
+        src/engine/FilterProcessor.cpp \
+        src/engine/BordersProcessor.cpp \
+        src/engine/BackgroundModel.cpp \
+        src/engine/Progress.cpp \
+        src/engine/Profiler.cpp \
+        src/engine/CpuFeatures.cpp \
+        src/engine/SimdKernels.cpp \
+        src/engine/Histogram.cpp \
         src/engine/Point.cpp \
         # Service level cpp-files
         src/service/AImage.cpp \
@@ -61,7 +87,19 @@ SOURCES += \
         src/service/AImageCombiner.cpp \
         src/service/ABordersDetector.cpp \
         src/service/AImageFilter.cpp \
-        src/service/AImageUtils.cpp
+        src/service/AMorphologyFilter.cpp \
+        src/service/APipeline.cpp \
+        src/service/AImageUtils.cpp \
+        src/service/AMultiChannelImage.cpp \
+        src/service/ABinaryImage.cpp \
+        src/service/AImageBatch.cpp \
+        src/service/ARawImageFile.cpp \
+        src/service/ATiledProcessor.cpp \
+        src/service/AFilterProcessor.cpp \
+        src/service/ABordersProcessor.cpp \
+        src/service/ABackgroundModel.cpp \
+        src/service/AProgress.cpp \
+        src/service/AProfiler.cpp
 
 HEADERS += \
         # Engine level h-files (private for external applications)
@@ -74,9 +112,34 @@ HEADERS += \
         src/include/engine/Point.h \
         src/include/engine/ImageCorrector.h \
         src/include/engine/HuMomentsCalculator.h \
+        src/include/engine/MomentsCalculator.h \
+        src/include/engine/LabelImage.h \
+        src/include/engine/BinaryImage.h \
+        src/include/engine/Parallel.h \
+        src/include/engine/TaskGraph.h \
+        src/include/engine/TaskScheduler.h \
+        src/include/engine/MorphologyFilter.h \
+        src/include/engine/Pipeline.h \
+        src/include/engine/PixelConverter.h \
+        src/include/engine/MultiChannelImage.h \
+        src/include/engine/TypedImage.h \
+        src/include/engine/TypedImageFilter.h \
+        src/include/engine/TypedBordersDetector.h \
+        src/include/engine/TypedImageCorrector.h \
+        src/include/engine/RawImageFile.h \
+        src/include/engine/TiledProcessor.h \
+        src/include/engine/FilterProcessor.h \
+        src/include/engine/BordersProcessor.h \
+        src/include/engine/BackgroundModel.h \
+        src/include/engine/Progress.h \
+        src/include/engine/Profiler.h \
+        src/include/engine/CpuFeatures.h \
+        src/include/engine/SimdKernels.h \
+        src/include/engine/Histogram.h \
         # Service level h-files (private for external applications)
         src/include/service/AImageManager.h \
         src/include/service/AImageUtils.h \
+        src/include/service/ATypesConverter.h \
         # Service level h-files (public for external applications)
         include/AImage.h \
         include/AImageParametersCalculator.h \
@@ -84,4 +147,16 @@ HEADERS += \
         include/AHuMomentsCalculator.h \
         include/AImageCombiner.h \
         include/ABordersDetector.h \
-        include/AImageFilter.h
+        include/AImageFilter.h \
+        include/AMorphologyFilter.h \
+        include/APipeline.h \
+        include/AMultiChannelImage.h \
+        include/ABinaryImage.h \
+        include/AImageBatch.h \
+        include/ARawImageFile.h \
+        include/ATiledProcessor.h \
+        include/AFilterProcessor.h \
+        include/ABordersProcessor.h \
+        include/ABackgroundModel.h \
+        include/AProgress.h \
+        include/AProfiler.h
@@ -0,0 +1,91 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a wrapper for class BackgroundModel from engine level
+
+#ifndef ABACKGROUND_MODEL_H
+#define ABACKGROUND_MODEL_H
+
+#include <memory>
+
+class AImage;
+class ABinaryImage;
+namespace acv {
+class BackgroundModel;
+}
+
+// Types of background model
+enum class ABackgroundModelType
+{
+    RUNNING_AVERAGE, // Exponential running average of frames
+    GAUSSIAN, // Running mean and variance of each pixel (threshold is specified in standard deviations)
+    MEDIAN // Approximate running median
+};
+
+// Wrapper for class BackgroundModel from engine level
+// Model of static scene of the sequence of frames of the same size (video stream) which separates the moving objects.
+// The memory of model is allocated once at configuration, the mask of foreground should be created once and reused
+// (its pixels should not be shared with other images).
+// The model is not thread-safe: each thread should use its own model (the copies of model share the state)
+class ABackgroundModel
+{
+
+public:
+
+    // Constructor of not configured model
+    ABackgroundModel();
+
+public:
+
+    // Configure the model for frames of specified sizes
+    // Learning rate is the weight of new frame (0 < learningRate <= 0.5), it is not used by median model.
+    // Negative threshold means the default threshold of model
+    bool Configure(int height, int width, ABackgroundModelType type, float learningRate = 0.05f, float threshold = -1.0f);
+
+    // Check that the model was successfully configured
+    bool IsConfigured() const;
+
+    // Add the frame to model and calculate the mask of foreground (sizes of images should be equal to configured sizes)
+    bool Apply(const AImage& frame, AImage& foregroundMask);
+
+    // Add the frame to model and calculate the binary mask of foreground (sizes of images should be equal to configured sizes)
+    bool Apply(const AImage& frame, ABinaryImage& foregroundMask);
+
+    // Get the current background (sizes of image should be equal to configured sizes)
+    bool GetBackground(AImage& backgroundImg) const;
+
+    // Forget all frames (the next frame will initialize the model)
+    void Reset();
+
+    // Get the number of frames which were added after configuration or reset
+    int GetNumFrames() const;
+
+private:
+
+    // Low level representation of model
+    std::shared_ptr<acv::BackgroundModel> mModel;
+
+};
+
+#endif // ABACKGROUND_MODEL_H
@@ -0,0 +1,119 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a wrapper for class BinaryImage from engine level
+
+#ifndef ABINARY_IMAGE_H
+#define ABINARY_IMAGE_H
+
+#include <memory>
+#include <cstddef>
+
+#include "AImage.h"
+
+namespace acv {
+class BinaryImage;
+}
+
+// A wrapper of class BinaryImage from engine level
+// Each pixel is one bit, so the masks (results of threshold, borders and foreground) take 8 times less memory
+class ABinaryImage
+{
+
+public:
+
+    friend class AImageManager;
+
+public:
+
+    // Constructor with dimensions (all pixels are cleared)
+    ABinaryImage(int height, int width);
+
+    // Constructor from image (the pixels which are not minimum brightness are set)
+    explicit ABinaryImage(const AImage& img);
+
+    // Copy-constructor
+    // Images share the pixels until one of them is changed (copy-on-write)
+    ABinaryImage(const ABinaryImage&) = default;
+
+    // Move-constructor
+    ABinaryImage(ABinaryImage&&) = default;
+
+    // Destructor
+    virtual ~ABinaryImage() = default;
+
+    // Assignment operator
+    ABinaryImage& operator = (const ABinaryImage&) = default;
+
+    // Move assignment operator
+    ABinaryImage& operator = (ABinaryImage&&) = default;
+
+public:
+
+    // Get the width of image
+    int GetWidth() const;
+
+    // Get the height of image
+    int GetHeight() const;
+
+    // Check the initialization of image
+    bool IsInitialized() const;
+
+    // Get the pixel value by coordinates
+    bool GetPixel(int row, int col) const;
+
+    // Set the pixel value by coordinates
+    void SetPixel(int row, int col, bool val);
+
+    // Count the set pixels (area of mask)
+    size_t CountPixels() const;
+
+    // Count the connected components (8-connectivity) of set pixels
+    // Returns -1 if image is not initialized
+    int CountConnectedComponents() const;
+
+    // Convert to image (set pixels are maximum brightness)
+    AImage ConvertToImage() const;
+
+    // Logical operations of pixels, all images should have the same sizes (destination image can be one of source images)
+    static bool And(const ABinaryImage& lhs, const ABinaryImage& rhs, ABinaryImage& dstImg);
+    static bool Or(const ABinaryImage& lhs, const ABinaryImage& rhs, ABinaryImage& dstImg);
+    static bool Xor(const ABinaryImage& lhs, const ABinaryImage& rhs, ABinaryImage& dstImg);
+
+    // Logical negation of pixels (images should have the same sizes)
+    static bool Invert(const ABinaryImage& srcImg, ABinaryImage& dstImg);
+
+private:
+
+    // Make own copy of pixels if they are shared with other images
+    void Detach();
+
+private:
+
+    // Low level representation of image
+    std::shared_ptr<acv::BinaryImage> mImage;
+
+};
+
+#endif // ABINARY_IMAGE_H
@@ -28,13 +28,16 @@
 #define ABORDERS_DETECTOR_H
 
 class AImage;
+class ABinaryImage;
+class AProgress;
 
 // Types of border detectors
 enum class ADetectorType
 {
     SOBEL, // Sobel detector
     SCHARR, // Scharr detector
-    CANNY // Canny detector
+    CANNY, // Canny detector
+    CANNY_BILATERAL // Canny detector with edge-preserving bilateral blur instead of Gaussian blur
 };
 
 // Types of border detection operators
@@ -51,11 +54,25 @@ class ABordersDetector
 public:
 
     // Detect the borders of image
-    static bool DetectBorders(const AImage& srcImg, AImage& dstImg, ADetectorType detectorType);
+    // Progress (if it is specified) reports the done stages and can cancel the detection
+    static bool DetectBorders(const AImage& srcImg, AImage& dstImg, ADetectorType detectorType, AProgress* progress = nullptr);
+
+    // Detect the borders of image
+    // Source image is moved to destination image and is processed in place (its pixels are not copied if they are not shared)
+    // Progress (if it is specified) reports the done stages and can cancel the detection
+    static bool DetectBorders(AImage&& srcImg, AImage& dstImg, ADetectorType detectorType, AProgress* progress = nullptr);
+
+    // Detect the borders of image to binary map of the same sizes (only Canny detectors form the binary map)
+    // Progress (if it is specified) reports the done stages and can cancel the detection
+    static bool DetectBorders(const AImage& srcImg, ABinaryImage& dstImg, ADetectorType detectorType, AProgress* progress = nullptr);
 
     // Convolution of image with specified operator
     static bool OperatorConvolution(const AImage& srcImg, AImage& dstImg, ADetectorType detectorType, AOperatorType operatorType);
 
+    // Convolution of image with specified operator
+    // Source image is moved to destination image and is processed in place (its pixels are not copied if they are not shared)
+    static bool OperatorConvolution(AImage&& srcImg, AImage& dstImg, ADetectorType detectorType, AOperatorType operatorType);
+
 };
 
 #endif // ABORDERS_DETECTOR_H
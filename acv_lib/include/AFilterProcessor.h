@@ -0,0 +1,73 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a wrapper for class FilterProcessor from engine level
+
+#ifndef AFILTER_PROCESSOR_H
+#define AFILTER_PROCESSOR_H
+
+#include <memory>
+
+#include "AImageFilter.h"
+
+class AImage;
+namespace acv {
+class FilterProcessor;
+}
+
+// Wrapper for class FilterProcessor from engine level
+// Stateful filter of the sequence of frames of the same size (video stream).
+// The processor is configured once, then the frames are filtered without allocations of memory
+// (destination image should be created once and reused, its pixels should not be shared with other images).
+// The processor is not thread-safe: each thread should use its own processor (the copies of processor share the state)
+class AFilterProcessor
+{
+
+public:
+
+    // Constructor of not configured processor
+    AFilterProcessor();
+
+public:
+
+    // Configure the processor for frames of specified sizes and for specified filter
+    AFiltrationResult Configure(int height, int width, AFilterType type, int filterSize = -1);
+
+    // Check that the processor was successfully configured
+    bool IsConfigured() const;
+
+    // Filter the frame (sizes of images should be equal to configured sizes)
+    AFiltrationResult Process(const AImage& srcImg, AImage& dstImg);
+
+    // Filter the frame in place
+    AFiltrationResult Process(AImage& img);
+
+private:
+
+    // Low level representation of processor
+    std::shared_ptr<acv::FilterProcessor> mProcessor;
+
+};
+
+#endif // AFILTER_PROCESSOR_H
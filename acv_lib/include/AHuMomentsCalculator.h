@@ -29,9 +29,23 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 typedef std::array<double, 8> AHuMoments; // Array of Hu's moments values
 
+// Rectangular region of interest (boundaries are included)
+struct ARoi
+{
+    int xStart, yStart, xEnd, yEnd;
+};
+
+// Weight of pixel during calculation of moments
+enum class AMomentsWeightType
+{
+    BINARY, // Each pixel with non-zero brightness has weight 1
+    INTENSITY // Weight of pixel is equal to his brightness
+};
+
 class AImage;
 namespace acv {
 class HuMomentsCalculator;
@@ -44,14 +58,35 @@ class AHuMomentsCalculator
 public:
 
     // The constructor to calculate a Hu's moments of image part
-    // The user should provide: xStart < xEnd and yStart < yEnd
+    // The user should provide: xStart <= xEnd and yStart <= yEnd
     AHuMomentsCalculator(const AImage& img, int xStart, int yStart, int xEnd, int yEnd);
 
 public:
 
-    // Get Hu's moments array
+    // Get Hu's moments array. Returns false if the image part is incorrect
     bool GetHuMoments(AHuMoments& moments) const;
 
+    // Calculate the Hu's moments of the each region of interest in parallel
+    // The element [i] of result contains the moments of rois[i]
+    static bool CalcHuMoments(const AImage& img, const std::vector<ARoi>& rois, std::vector<AHuMoments>& moments,
+                              AMomentsWeightType weightType = AMomentsWeightType::BINARY);
+
+    // Calculate the Hu's moments for every position of window with size winWidth x winHeight (template scanning)
+    // The result is a row-major matrix with (height - winHeight + 1) rows and (width - winWidth + 1) columns,
+    // the element [row][col] contains the moments of window with top-left corner in (col, row).
+    // Each window costs O(1) due to integral images of moments (they take 80 bytes per pixel of image)
+    static bool CalcDenseHuMoments(const AImage& img, int winWidth, int winHeight, std::vector<AHuMoments>& moments,
+                                   AMomentsWeightType weightType = AMomentsWeightType::BINARY);
+
+    // Calculate the Hu's moments of all labeled objects in a single raster pass
+    // Labels is a row-major matrix with sizes of image (0 is background, objects are numbered from 1 to numLabels)
+    // The element [label - 1] of result contains the moments of object with this label
+    static bool CalcHuMoments(const AImage& img, const std::vector<int>& labels, int numLabels,
+                              std::vector<AHuMoments>& moments, AMomentsWeightType weightType = AMomentsWeightType::BINARY);
+
+    // Label the connected components (8-connectivity) of non-zero pixels of image (for example, result of borders detection)
+    static bool LabelConnectedComponents(const AImage& img, std::vector<int>& labels, int& numLabels);
+
 private:
 
     // Low level representation of Hu's moments calculator
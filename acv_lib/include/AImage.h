@@ -41,6 +41,17 @@ enum class AScaleType
     DOWNSCALE // downscaling
 };
 
+// Formats of pixels in external buffers which are used to bulk import and export
+enum class APixelFormat
+{
+    GRAY8, // One byte of brightness
+    RGB888, // Bytes R, G, B (QImage::Format_RGB888)
+    BGR888, // Bytes B, G, R
+    RGBA8888, // Bytes R, G, B, A (QImage::Format_RGBA8888)
+    BGRA8888, // Bytes B, G, R, A (QImage::Format_RGB32 and Format_ARGB32 on little-endian machines)
+    ARGB8888 // Bytes A, R, G, B (QImage::Format_RGB32 and Format_ARGB32 on big-endian machines)
+};
+
 // A wrapper of class Image from engine level
 class AImage
 {
@@ -63,7 +74,9 @@ public:
     AImage(int height, int width);
 
     // Copy-constructor
-    AImage(const AImage&) = default;
+    // Images share the pixels until one of them is changed (copy-on-write)
+    // The pixels of image which gave the pointer to change them are copied at once (see GetRowPointer)
+    AImage(const AImage& other);
 
     // Move-constructor
     AImage(AImage&&) = default;
@@ -72,7 +85,7 @@ public:
     virtual ~AImage() = default;
 
     // Assignment operator
-    AImage& operator = (const AImage&) = default;
+    AImage& operator = (const AImage& other);
 
     // Move assignment operator
     AImage& operator = (AImage&&) = default;
@@ -91,6 +104,24 @@ public:
     // Set the pixel value by coordinates
     void SetPixel(int row, int col, AByte val);
 
+    // Get the pointer to the first pixel of row
+    // Rows are placed one after another without gaps, each row contains GetWidth() pixels
+    const AByte* GetRowPointer(int row) const;
+
+    // Get the pointer to the first pixel of row to change the pixels
+    // After this call the pixels of image are never shared: copies of image get own pixels at once,
+    // so changes through the pointer are visible in this image only.
+    // The pointer is valid until the image is destroyed, assigned or used as destination of processing
+    AByte* GetRowPointer(int row);
+
+    // Fill the pixels of image from buffer, color pixels are converted to brightness
+    // Buffer should contain GetHeight() rows, each row starts at bytesPerLine bytes after previous
+    bool Import(const void* buf, int bytesPerLine, APixelFormat format);
+
+    // Write the pixels of image to buffer (color components are equal to brightness, alpha is opaque)
+    // Buffer should contain GetHeight() rows, each row starts at bytesPerLine bytes after previous
+    bool Export(void* buf, int bytesPerLine, APixelFormat format) const;
+
     // Check the initialization of image
     bool IsInitialized() const;
 
@@ -100,11 +131,19 @@ public:
     // Check pixel coordinates for image boundaries
     bool IsValidCoordinates(int row, int col) const;
 
+private:
+
+    // Make own copy of pixels if they are shared with other images
+    void Detach();
+
 private:
 
     // Low level representation of image
     std::shared_ptr<acv::Image> mImage;
 
+    // Flag of giving the pointer to change the pixels (such pixels can't be shared)
+    bool mIsRawAccessed;
+
 };
 
 #endif // AIMAGE_H
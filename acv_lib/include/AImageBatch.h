@@ -0,0 +1,83 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class to process the batches of images
+
+#ifndef AIMAGE_BATCH_H
+#define AIMAGE_BATCH_H
+
+#include <vector>
+
+#include "AImage.h"
+#include "AImageFilter.h"
+#include "AImageCorrector.h"
+#include "ABordersDetector.h"
+#include "AImageParametersCalculator.h"
+
+class AProgress;
+
+// Class is used to process many images by one call
+// The small images are processed in parallel (each image is processed by one thread), the large images are
+// processed one by one and the engine algorithms divide each of them to bands of rows which are processed in parallel
+// (the filters, correctors and detectors of borders give the same results as for the whole image).
+// So the threads of library are loaded by the batches of thumbnails and by the batches of large images.
+// The results are written to the vector of destination images which is resized to the number of source images
+// (the destination vector can be the same as the source vector).
+// Progress (if it is specified) is advanced by images, the cancelled batch stops before the next images
+// Class contains only static methods
+class AImageBatch
+{
+
+public:
+
+    enum
+    {
+        MAX_IMAGE_PARALLEL_PIXELS = 512 * 512 // Maximum number of pixels of image which is processed by one thread
+    };
+
+public:
+
+    // Run a filtration of each image
+    // Returns SUCCESS if all images were processed, otherwise the result of the first failed image (or CANCELLED)
+    static AFiltrationResult FilterBatch(const std::vector<AImage>& srcImages, std::vector<AImage>& dstImages,
+                                         AFilterType type, int filterSize, AProgress* progress = nullptr);
+
+    // Run a correction of each image
+    // Returns true if all images were processed
+    static bool CorrectBatch(const std::vector<AImage>& srcImages, std::vector<AImage>& dstImages,
+                             ACorrectorType corType, AProgress* progress = nullptr);
+
+    // Detect the borders of each image
+    // Returns true if all images were processed
+    static bool DetectBordersBatch(const std::vector<AImage>& srcImages, std::vector<AImage>& dstImages,
+                                   ADetectorType detectorType, AProgress* progress = nullptr);
+
+    // Calculate the parameters of each image (vector of parameters is resized to the number of images)
+    // Returns true if the parameters of all images were calculated
+    static bool CalcParametersBatch(const std::vector<AImage>& images, std::vector<AImageParameters>& parameters,
+                                    AProgress* progress = nullptr);
+
+};
+
+#endif // AIMAGE_BATCH_H
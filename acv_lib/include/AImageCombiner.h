@@ -28,8 +28,11 @@
 #define AIMAGE_COMBINER_H
 
 #include <memory>
+#include <vector>
 
-class AImage;
+#include "AImage.h"
+
+class AProgress;
 namespace acv {
 class ImageCombiner;
 }
@@ -52,7 +55,8 @@ enum class ACombinationResult
     FEW_IMAGES, // The number of images should be more than 1
     NOT_SAME_IMAGES, // The images should have the same sizes
     MANY_IMAGES, // Combining based on adding the differences use only two images
-    OTHER_ERROR // Error during combining
+    OTHER_ERROR, // Error during combining
+    CANCELLED // Combining was cancelled by the progress of operation
 };
 
 // Wrapper for class ImageCombiner from engine level
@@ -65,20 +69,26 @@ public:
     AImageCombiner();
 
     // Add image to combine
+    // The combiner keeps own copy of image (the pixels are shared while the images aren't changed)
     void AddImage(const AImage& img);
+    void AddImage(AImage&& img);
 
     // Clear the container with images to combine
     void ClearImages();
 
     // Run of combining with specified type
     // Flag needSort is used to sort container of image by entropy
-    ACombinationResult Combine(ACombineType combineType, AImage& combImg, bool needSort = true);
+    // Progress (if it is specified) reports the done work and can cancel the combining
+    ACombinationResult Combine(ACombineType combineType, AImage& combImg, bool needSort = true, AProgress* progress = nullptr);
 
 private:
 
     // Low level representation of combiner
     std::shared_ptr<acv::ImageCombiner> mCombiner;
 
+    // Images to combine (the engine combiner refers to their pixels)
+    std::vector<AImage> mImages;
+
 };
 
 #endif // AIMAGE_COMBINER_H
@@ -33,10 +33,14 @@ enum class ACorrectorType
     SSRETINEX, // Single-scale Retinex
     AUTO_LEVELS, // Contrast correction using the auto-levels algorithm
     NORM_AUTO_LEVELS, // Algorithm of auto-levels with pixels correction in three sigma range
-    GAMMA // Gamma-correction
+    GAMMA, // Gamma-correction
+    GLOBAL_EQUALIZATION, // Equalization of histogram of the whole image
+    CLAHE // Contrast limited adaptive histogram equalization
 };
 
 class AImage;
+class AMultiChannelImage;
+class AProgress;
 
 // Wrapper for class ImageCorrector from engine level
 class AImageCorrector
@@ -45,7 +49,16 @@ class AImageCorrector
 public:
 
     // Correct image using a special method
-    static bool Correct(const AImage& srcImg, AImage& dstImg, ACorrectorType corType);
+    // Progress (if it is specified) reports the done work and can cancel the correction
+    static bool Correct(const AImage& srcImg, AImage& dstImg, ACorrectorType corType, AProgress* progress = nullptr);
+
+    // Correct image using a special method
+    // Source image is moved to destination image and is processed in place (its pixels are not copied if they are not shared)
+    // Progress (if it is specified) reports the done work and can cancel the correction
+    static bool Correct(AImage&& srcImg, AImage& dstImg, ACorrectorType corType, AProgress* progress = nullptr);
+
+    // Correct each channel of image using a special method (the channels are processed in parallel)
+    static bool Correct(const AMultiChannelImage& srcImg, AMultiChannelImage& dstImg, ACorrectorType corType);
 
 };
 
@@ -28,6 +28,9 @@
 #define AIMAGE_FILTER_H
 
 class AImage;
+class ABinaryImage;
+class AMultiChannelImage;
+class AProgress;
 
 // This enum is used to represent the result of image filtering
 enum class AFiltrationResult
@@ -36,7 +39,8 @@ enum class AFiltrationResult
     INTERNAL_ERROR, // Error during filtration
     INCORRECT_FILTER_TYPE, // Incorrect type of filter
     INCORRECT_FILTER_SIZE, // Incorrect filter size (he should be odd)
-    SMALL_FILTER_SIZE // Filter size is small (this code is used for IIR Gaussian filtration)
+    SMALL_FILTER_SIZE, // Filter size is small (this code is used for IIR Gaussian filtration)
+    CANCELLED // Filtration was cancelled by the progress of operation
 };
 
 // Used types of filtration
@@ -46,7 +50,9 @@ enum class AFilterType
     GAUSSIAN, // Gaissian filtration
     SEP_GAUSSIAN, // Separated gaussian filtration
     IIR_GAUSSIAN, // IIR-imitated gaussian filtration
-    SHARPEN // Increase the sharpness of the image
+    SHARPEN, // Increase the sharpness of the image
+    BILATERAL, // Edge-preserving bilateral filtration (spatial sigma is filterSize / 6 as for IIR-gaussian)
+    UNSHARP_MASK // Unsharp masking with radius filterSize / 2, amount 100% and zero threshold
 };
 
 // Used types of threshold
@@ -56,6 +62,13 @@ enum class AThresholdType
     MIN_MORE_THRESHOLD  // All pixels more than threshold will be Image::MIN_VALUE
 };
 
+// Used methods of threshold by the local mean and standard deviation of window
+enum class AThresholdMethod
+{
+    NIBLACK, // Level is mean + k * deviation (k is usually about -0.2)
+    SAUVOLA  // Level is mean * (1 + k * (deviation / 128 - 1)) (k is usually in range [0.2, 0.5])
+};
+
 // Wrapper for class ImageFilter from engine level
 class AImageFilter
 {
@@ -63,11 +76,49 @@ class AImageFilter
 public:
 
     // Run a filtration by the specified method
-    static AFiltrationResult Filter(const AImage& srcImg, AImage& dstImg, AFilterType type, int filterSize);
+    // Progress (if it is specified) reports the done rows and can cancel the filtration
+    static AFiltrationResult Filter(const AImage& srcImg, AImage& dstImg, AFilterType type, int filterSize,
+                                    AProgress* progress = nullptr);
+
+    // Run a filtration by the specified method
+    // Source image is moved to destination image and is processed in place (its pixels are not copied if they are not shared)
+    // Progress (if it is specified) reports the done rows and can cancel the filtration
+    static AFiltrationResult Filter(AImage&& srcImg, AImage& dstImg, AFilterType type, int filterSize,
+                                    AProgress* progress = nullptr);
+
+    // Run a filtration of each channel by the specified method (the channels are processed in parallel)
+    static AFiltrationResult Filter(const AMultiChannelImage& srcImg, AMultiChannelImage& dstImg, AFilterType type, int filterSize);
+
+    // Run an unsharp masking: the difference between image and its Gaussian blur with specified radius multiplied by
+    // amount (in percents) is added to the image where the absolute difference is not smaller than threshold
+    // Progress (if it is specified) reports the done rows and can cancel the filtration
+    static AFiltrationResult UnsharpMask(const AImage& srcImg, AImage& dstImg, int radius, int amount, int threshold,
+                                         AProgress* progress = nullptr);
 
     // Run an adaptive threshold processing
     static bool AdaptiveThreshold(const AImage& srcImg, AImage& dstImg, int filterSize, int threshold, AThresholdType thresholdType);
 
+    // Run an adaptive threshold processing
+    // Source image is moved to destination image and is processed in place (its pixels are not copied if they are not shared)
+    static bool AdaptiveThreshold(AImage&& srcImg, AImage& dstImg, int filterSize, int threshold, AThresholdType thresholdType);
+
+    // Run an adaptive threshold processing by the level of specified method in window filterSize x filterSize
+    // The cost doesn't depend on the size of window
+    static bool AdaptiveThreshold(const AImage& srcImg, AImage& dstImg, int filterSize, float k,
+                                  AThresholdMethod method, AThresholdType thresholdType);
+
+    // Run an adaptive threshold processing by the level of specified method in window filterSize x filterSize
+    // Source image is moved to destination image and is processed in place (its pixels are not copied if they are not shared)
+    static bool AdaptiveThreshold(AImage&& srcImg, AImage& dstImg, int filterSize, float k,
+                                  AThresholdMethod method, AThresholdType thresholdType);
+
+    // Run an adaptive threshold processing to binary image of the same sizes
+    static bool AdaptiveThreshold(const AImage& srcImg, ABinaryImage& dstImg, int filterSize, int threshold, AThresholdType thresholdType);
+
+    // Run an adaptive threshold processing by the level of specified method to binary image of the same sizes
+    static bool AdaptiveThreshold(const AImage& srcImg, ABinaryImage& dstImg, int filterSize, float k,
+                                  AThresholdMethod method, AThresholdType thresholdType);
+
 };
 
 #endif // AIMAGEFILTER_H
@@ -36,6 +36,17 @@ namespace acv {
 class ImageParametersCalculator;
 }
 
+// Parameters of image which are calculated together
+struct AImageParameters
+{
+    double entropy; // Entropy
+    double averageBrightness; // Average brightness
+    double standardDeviation; // Standard deviation of brightness
+    AByte minBrightness; // Minimum brightness
+    AByte maxBrightness; // Maximum brightness
+    double integralQualityIndicator; // Integral quality indicator
+};
+
 // Wrapper for class ImageParametersCalculator from engine level
 class AImageParametersCalculator
 {
@@ -94,6 +105,9 @@ public:
     // Create array for brightness histogram of image
     bool CreateBrightnessHistogram(std::vector<double>& brightnessHistogram);
 
+    // Calculate all parameters by one pass over the pixels
+    bool CalcParameters(AImageParameters& params);
+
 private:
 
     // Low level representation of image parameters calculator
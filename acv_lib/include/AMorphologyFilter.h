@@ -0,0 +1,70 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a wrapper for class MorphologyFilter from engine level
+
+#ifndef AMORPHOLOGY_FILTER_H
+#define AMORPHOLOGY_FILTER_H
+
+#include "AImageFilter.h"
+
+class AImage;
+class ABinaryImage;
+class AProgress;
+
+// Used types of morphological operations
+enum class AMorphologyType
+{
+    EROSION, // Minimum in the window of structuring element
+    DILATION, // Maximum in the window of structuring element
+    OPENING, // Erosion and then dilation (removes small bright details)
+    CLOSING // Dilation and then erosion (removes small dark details)
+};
+
+// Wrapper for class MorphologyFilter from engine level
+class AMorphologyFilter
+{
+
+public:
+
+    // Run a morphological operation with rectangular structuring element of size seWidth x seHeight (sizes should be odd)
+    // Progress (if it is specified) reports the done passes and can cancel the operation
+    static AFiltrationResult Filter(const AImage& srcImg, AImage& dstImg, AMorphologyType type, int seWidth, int seHeight,
+                                    AProgress* progress = nullptr);
+
+    // Run a morphological operation with rectangular structuring element of size seWidth x seHeight (sizes should be odd)
+    // Source image is moved to destination image and is processed in place (its pixels are not copied if they are not shared)
+    // Progress (if it is specified) reports the done passes and can cancel the operation
+    static AFiltrationResult Filter(AImage&& srcImg, AImage& dstImg, AMorphologyType type, int seWidth, int seHeight,
+                                    AProgress* progress = nullptr);
+
+    // Run a morphological operation of binary image with rectangular structuring element of size seWidth x seHeight
+    // (sizes should be odd). Destination image can be the same as source image
+    // Progress (if it is specified) reports the done passes and can cancel the operation
+    static AFiltrationResult Filter(const ABinaryImage& srcImg, ABinaryImage& dstImg, AMorphologyType type, int seWidth, int seHeight,
+                                    AProgress* progress = nullptr);
+
+};
+
+#endif // AMORPHOLOGY_FILTER_H
@@ -0,0 +1,120 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a wrapper for class MultiChannelImage from engine level
+
+#ifndef AMULTI_CHANNEL_IMAGE_H
+#define AMULTI_CHANNEL_IMAGE_H
+
+#include <memory>
+
+#include "AImage.h"
+
+namespace acv {
+class MultiChannelImage;
+}
+
+// A wrapper of class MultiChannelImage from engine level
+// The channels are stored separately (planar layout), interleaved buffers are converted at import and export
+class AMultiChannelImage
+{
+
+public:
+
+    enum
+    {
+        MAX_NUM_CHANNELS = 4 // Maximum number of channels
+    };
+
+public:
+
+    friend class AImageManager;
+
+public:
+
+    // Constructor with dimensions and number of channels
+    AMultiChannelImage(int height, int width, int numChannels);
+
+    // Constructor with dimensions from interleaved buffer
+    // Each pixel of buffer contains numChannels bytes, each row starts at bytesPerLine bytes after previous
+    AMultiChannelImage(int height, int width, int numChannels, const void* buf, int bytesPerLine);
+
+    // Copy-constructor
+    // Images share the pixels until one of them is changed (copy-on-write)
+    AMultiChannelImage(const AMultiChannelImage&) = default;
+
+    // Move-constructor
+    AMultiChannelImage(AMultiChannelImage&&) = default;
+
+    // Destructor
+    virtual ~AMultiChannelImage() = default;
+
+    // Assignment operator
+    AMultiChannelImage& operator = (const AMultiChannelImage&) = default;
+
+    // Move assignment operator
+    AMultiChannelImage& operator = (AMultiChannelImage&&) = default;
+
+public:
+
+    // Get the width of image
+    int GetWidth() const;
+
+    // Get the height of image
+    int GetHeight() const;
+
+    // Get the number of channels
+    int GetNumChannels() const;
+
+    // Check the initialization of image
+    bool IsInitialized() const;
+
+    // Get the channel as one-channel image
+    AImage GetChannel(int channelNum) const;
+
+    // Set the pixels of channel from one-channel image of the same sizes
+    bool SetChannel(int channelNum, const AImage& channel);
+
+    // Fill the channels from interleaved buffer (each pixel of buffer contains GetNumChannels() bytes)
+    bool Import(const void* buf, int bytesPerLine);
+
+    // Write the channels to interleaved buffer (each pixel of buffer contains GetNumChannels() bytes)
+    bool Export(void* buf, int bytesPerLine) const;
+
+    // Image scaling (upscaling and downscaling) of each channel
+    AMultiChannelImage Scale(short kScaleX, short kScaleY, AScaleType scaleType) const;
+
+private:
+
+    // Make own copy of pixels if they are shared with other images
+    void Detach();
+
+private:
+
+    // Low level representation of image
+    std::shared_ptr<acv::MultiChannelImage> mImage;
+
+};
+
+#endif // AMULTI_CHANNEL_IMAGE_H
@@ -0,0 +1,93 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a wrapper for class Pipeline from engine level
+
+#ifndef APIPELINE_H
+#define APIPELINE_H
+
+#include <memory>
+
+#include "AImageFilter.h"
+#include "AImageCorrector.h"
+#include "ABordersDetector.h"
+#include "AMorphologyFilter.h"
+
+class AImage;
+namespace acv {
+class Pipeline;
+}
+
+// Wrapper for class Pipeline from engine level
+// Builder of sequence of operations which is run without full intermediate images (where it is possible)
+// Example: APipeline().AddFilter(AFilterType::GAUSSIAN, 5).AddCorrector(ACorrectorType::GAMMA).Run(src, dst)
+class APipeline
+{
+
+public:
+
+    // Constructor of empty pipeline
+    APipeline();
+
+public:
+
+    // Add the filtration by the specified method
+    APipeline& AddFilter(AFilterType type, int filterSize = -1);
+
+    // Add the adaptive threshold processing
+    APipeline& AddAdaptiveThreshold(int filterSize, int threshold, AThresholdType thresholdType);
+
+    // Add the adaptive threshold processing by local statistics
+    APipeline& AddAdaptiveThreshold(int filterSize, float k, AThresholdMethod method, AThresholdType thresholdType);
+
+    // Add the correction by the specified method
+    APipeline& AddCorrector(ACorrectorType corType);
+
+    // Add the detection of borders
+    APipeline& AddBordersDetector(ADetectorType detectorType);
+
+    // Add the convolution with specified operator
+    APipeline& AddOperator(ADetectorType detectorType, AOperatorType operatorType);
+
+    // Add the morphological operation
+    APipeline& AddMorphology(AMorphologyType type, int seWidth, int seHeight);
+
+    // Remove all operations
+    void Clear();
+
+    // Run all operations
+    bool Run(const AImage& srcImg, AImage& dstImg) const;
+
+    // Run all operations
+    // Source image is moved to destination image and is processed in place (its pixels are not copied if they are not shared)
+    bool Run(AImage&& srcImg, AImage& dstImg) const;
+
+private:
+
+    // Low level representation of pipeline
+    std::shared_ptr<acv::Pipeline> mPipeline;
+
+};
+
+#endif // APIPELINE_H
@@ -0,0 +1,81 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a wrapper for class Profiler from engine level
+
+#ifndef APROFILER_H
+#define APROFILER_H
+
+#include <string>
+#include <vector>
+
+// Aggregated timings of one stage of engine
+struct AProfileStageStats
+{
+    std::string name; // Name of stage
+    long long calls; // Number of runs of stage
+    double totalMs; // Total time of stage
+    double minMs; // Minimum time of one run
+    double maxMs; // Maximum time of one run
+    long long bytes; // Number of bytes processed by all runs
+};
+
+// Aggregated values of one counter of engine
+struct AProfileCounterStats
+{
+    std::string name; // Name of counter
+    long long events; // Number of updates of counter
+    long long total; // Sum of all values
+};
+
+// Wrapper for class Profiler from engine level
+// Statistics of stages (Canny, SSR, morphological combining, ...) and counters (allocations of images)
+// which are collected by the engine built with ACV_PROFILING (qmake CONFIG+=acv_profiling).
+// In the usual build the instrumentation is removed and the statistics are empty
+class AProfiler
+{
+
+public:
+
+    // Check that the profiling was compiled in the engine
+    static bool IsEnabled();
+
+    // Get the statistics of stages (sorted by total time in descending order)
+    static std::vector<AProfileStageStats> GetStageStats();
+
+    // Get the statistics of counters (sorted by name)
+    static std::vector<AProfileCounterStats> GetCounterStats();
+
+    // Enable or disable the recording of timeline of stages (it is disabled by default)
+    static void SetTraceEnabled(bool isEnabled);
+
+    // Write the recorded timeline to file in format of Chrome trace (chrome://tracing, Perfetto)
+    static bool WriteChromeTrace(const std::string& fileName);
+
+    // Clear all statistics and recorded timeline
+    static void Reset();
+
+};
+
+#endif // APROFILER_H
@@ -0,0 +1,86 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a wrapper for class Progress from engine level
+
+#ifndef APROGRESS_H
+#define APROGRESS_H
+
+#include <memory>
+#include <functional>
+
+namespace acv {
+class Progress;
+}
+
+// Wrapper for class Progress from engine level
+// Context of long operation which reports the percent of done work and allows to cancel the operation.
+// The operation is advanced at the granularity of row bands, so the cancelled operation stops quickly
+// and returns the cancelled result. The copies of progress share the state, so one copy can be passed
+// to the operation in worker thread and the other copy can be used to cancel it from the user interface
+class AProgress
+{
+
+public:
+
+    // Callback about the change of percent of done work
+    // It is called from the thread of operation, so it should be short and thread-safe
+    // (the percents which are reported by different threads can come out of order)
+    typedef std::function<void(int percent)> Callback;
+
+public:
+
+    // Constructor of progress without callback
+    AProgress();
+
+public:
+
+    // Set the callback about the change of percent (it should be set before the start of operation)
+    // The callback is kept in the shared state, so it must not own a copy of the progress (the state would
+    // never be released): a pointer or reference to the progress should be captured to cancel from the callback
+    void SetCallback(const Callback& callback);
+
+    // Request the cancellation of operation (it can be called from any thread)
+    void Cancel();
+
+    // Check that the cancellation was requested
+    bool IsCancelled() const;
+
+    // Get the percent of done work of current operation
+    int GetPercent() const;
+
+    // Prepare the progress for the next operation (reset the done work and the cancellation)
+    void Reset();
+
+private:
+
+    // Access to low level representation for other wrappers
+    friend acv::Progress* ConvertToEngineProgress(AProgress* progress);
+
+    // Low level representation of progress
+    std::shared_ptr<acv::Progress> mProgress;
+
+};
+
+#endif // APROGRESS_H
@@ -0,0 +1,55 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a wrapper for class RawImageFile from engine level
+
+#ifndef ARAW_IMAGE_FILE_H
+#define ARAW_IMAGE_FILE_H
+
+#include <string>
+
+class AImage;
+
+// Wrapper for class RawImageFile from engine level
+// Raw image files are memory-mapped and tiled, so the regions of large images are read without reading of whole file
+class ARawImageFile
+{
+
+public:
+
+    // Write the image to new raw file
+    static bool Save(const std::string& fileName, const AImage& img);
+
+    // Read the whole image from raw file
+    static bool Load(const std::string& fileName, AImage& img);
+
+    // Read the region of image from raw file (the region should be inside the image)
+    static bool LoadRegion(const std::string& fileName, int x, int y, int width, int height, AImage& img);
+
+    // Get the dimensions of image in raw file without reading of pixels
+    static bool GetImageSizes(const std::string& fileName, int& height, int& width);
+
+};
+
+#endif // ARAW_IMAGE_FILE_H
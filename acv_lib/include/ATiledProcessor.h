@@ -0,0 +1,93 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a wrapper for class TiledProcessor from engine level
+
+#ifndef ATILED_PROCESSOR_H
+#define ATILED_PROCESSOR_H
+
+#include <string>
+
+#include "AImageFilter.h"
+#include "AImageCorrector.h"
+#include "ABordersDetector.h"
+#include "AMorphologyFilter.h"
+
+// Wrapper for class TiledProcessor from engine level
+// The operations are run from source raw image file to destination raw image file (it is created or overwritten)
+// tile by tile, so the memory which is used for processing does not exceed the limit.
+// The results are the same as for the whole image except the operations which aren't limited by a window:
+// - IIR Gaussian, bilateral and unsharp masking filters and adaptive threshold by mean with filter size from 6
+//   differ by at most one level of brightness at a small part of pixels;
+// - Canny detector traces the borders only in the limits of 64 pixels around the tile
+class ATiledProcessor
+{
+
+public:
+
+    enum
+    {
+        DEFAULT_MEMORY_LIMIT_MB = 256 // Default limit of memory for processing
+    };
+
+public:
+
+    // Constructor with limit of memory in megabytes
+    explicit ATiledProcessor(int memoryLimitMB = DEFAULT_MEMORY_LIMIT_MB);
+
+    // Set the limit of memory in megabytes
+    void SetMemoryLimit(int memoryLimitMB) { mMemoryLimitMB = memoryLimitMB; }
+
+    // Get the limit of memory in megabytes
+    int GetMemoryLimit() const { return mMemoryLimitMB; }
+
+    // Run a filtration by the specified method
+    AFiltrationResult Filter(const std::string& srcFileName, const std::string& dstFileName, AFilterType type, int filterSize) const;
+
+    // Run an adaptive threshold processing
+    bool AdaptiveThreshold(const std::string& srcFileName, const std::string& dstFileName,
+                           int filterSize, int threshold, AThresholdType thresholdType) const;
+
+    // Run an adaptive threshold processing by local statistics
+    bool AdaptiveThreshold(const std::string& srcFileName, const std::string& dstFileName,
+                           int filterSize, float k, AThresholdMethod method, AThresholdType thresholdType) const;
+
+    // Correct image using a special method (Retinex and CLAHE are not supported, false is returned for them)
+    bool Correct(const std::string& srcFileName, const std::string& dstFileName, ACorrectorType corType) const;
+
+    // Detect the borders of image
+    bool DetectBorders(const std::string& srcFileName, const std::string& dstFileName, ADetectorType detectorType) const;
+
+    // Run a morphological operation
+    AFiltrationResult Morphology(const std::string& srcFileName, const std::string& dstFileName,
+                                 AMorphologyType type, int seWidth, int seHeight) const;
+
+private:
+
+    // Limit of memory in megabytes
+    int mMemoryLimitMB;
+
+};
+
+#endif // ATILED_PROCESSOR_H
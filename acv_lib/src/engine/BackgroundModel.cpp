@@ -0,0 +1,389 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods of class BackgroundModel
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BACKGROUND_MODEL_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "BackgroundModel.h"
+#include "BinaryImage.h"
+#include "Parallel.h"
+
+namespace acv {
+
+BackgroundModel::BackgroundModel()
+    : mIsConfigured(false),
+      mHeight(0),
+      mWidth(0),
+      mType(ModelType::RUNNING_AVERAGE),
+      mRateFixed(0),
+      mRate(0.0f),
+      mDiffThreshold(DEFAULT_DIFF_THRESHOLD),
+      mSigmaThreshold2(0.0f),
+      mNumFrames(0)
+{
+}
+
+bool BackgroundModel::Configure(const int height, const int width, ModelType type,
+                                const float learningRate/* = 0.05f*/, const float threshold/* = -1.0f*/)
+{
+    mIsConfigured = false;
+
+    if (height <= 0 || width <= 0)
+        return false;
+
+    if (type != ModelType::MEDIAN && (learningRate <= 0.0f || learningRate > 0.5f))
+        return false;
+
+    const int numPixels = height * width;
+
+    // Only the buffers of current model are kept
+    mAverage = std::vector<short>();
+    mMean = std::vector<float>();
+    mVariance = std::vector<float>();
+    mMedian = Image();
+
+    switch (type)
+    {
+    case ModelType::RUNNING_AVERAGE:
+        mAverage.resize(numPixels);
+        mRateFixed = static_cast<short>(std::min(std::max(static_cast<int>(learningRate * 65536.0f + 0.5f), 1), 32767));
+        break;
+    case ModelType::GAUSSIAN:
+        mMean.resize(numPixels);
+        mVariance.resize(numPixels);
+        mRate = learningRate;
+        break;
+    case ModelType::MEDIAN:
+        mMedian = Image(height, width);
+        break;
+    default:
+        return false;
+    }
+
+    if (type == ModelType::GAUSSIAN)
+    {
+        const float sigmaThreshold = (threshold < 0.0f) ? DEFAULT_SIGMA_THRESHOLD_X10 / 10.0f : threshold;
+        mSigmaThreshold2 = sigmaThreshold * sigmaThreshold;
+    }
+    else
+    {
+        const float diffThreshold = (threshold < 0.0f) ? static_cast<float>(DEFAULT_DIFF_THRESHOLD) : threshold;
+        mDiffThreshold = static_cast<Image::Byte>(std::min(diffThreshold, static_cast<float>(Image::MAX_PIXEL_VALUE)));
+    }
+
+    mHeight = height;
+    mWidth = width;
+    mType = type;
+    mNumFrames = 0;
+
+    mIsConfigured = true;
+    return true;
+}
+
+bool BackgroundModel::Apply(const Image& frame, Image& foregroundMask)
+{
+    if (!mIsConfigured ||
+        frame.GetHeight() != mHeight || frame.GetWidth() != mWidth ||
+        foregroundMask.GetHeight() != mHeight || foregroundMask.GetWidth() != mWidth)
+        return false;
+
+    if (mNumFrames == 0)
+    {
+        Initialize(frame);
+        memset(foregroundMask.GetRawPointer(), Image::MIN_PIXEL_VALUE, mHeight * mWidth);
+    }
+    else
+    {
+        const Image::Byte* pFrame = frame.GetRawPointer();
+        Image::Byte* pMask = foregroundMask.GetRawPointer();
+
+        Parallel::For(0, mHeight, [&](const int rowBegin, const int rowEnd)
+        {
+            const int begin = rowBegin * mWidth, end = rowEnd * mWidth;
+            Update(pFrame, pMask + begin, begin, end);
+        }, std::max(1, MIN_PIXELS_PER_TASK / mWidth));
+    }
+
+    if (mNumFrames < INT_MAX)
+        ++mNumFrames;
+
+    return true;
+}
+
+bool BackgroundModel::Apply(const Image& frame, BinaryImage& foregroundMask)
+{
+    if (!mIsConfigured ||
+        frame.GetHeight() != mHeight || frame.GetWidth() != mWidth ||
+        foregroundMask.GetHeight() != mHeight || foregroundMask.GetWidth() != mWidth)
+        return false;
+
+    if (mNumFrames == 0)
+    {
+        Initialize(frame);
+        foregroundMask.Clear();
+    }
+    else
+    {
+        const Image::Byte* pFrame = frame.GetRawPointer();
+
+        // The mask of each row is formed in the buffer of bytes and is packed to bits
+        Parallel::For(0, mHeight, [&](const int rowBegin, const int rowEnd)
+        {
+            std::vector<Image::Byte> rowMask(mWidth);
+            for (int row = rowBegin; row < rowEnd; ++row)
+            {
+                Update(pFrame, rowMask.data(), row * mWidth, (row + 1) * mWidth);
+                foregroundMask.PackRow(row, rowMask.data());
+            }
+        }, std::max(1, MIN_PIXELS_PER_TASK / mWidth));
+    }
+
+    if (mNumFrames < INT_MAX)
+        ++mNumFrames;
+
+    return true;
+}
+
+bool BackgroundModel::GetBackground(Image& backgroundImg) const
+{
+    if (!mIsConfigured || backgroundImg.GetHeight() != mHeight || backgroundImg.GetWidth() != mWidth)
+        return false;
+
+    const int numPixels = mHeight * mWidth;
+    Image::Byte* pDst = backgroundImg.GetRawPointer();
+
+    switch (mType)
+    {
+    case ModelType::RUNNING_AVERAGE:
+        for (int i = 0; i < numPixels; ++i)
+            pDst[i] = static_cast<Image::Byte>((mAverage[i] + (1 << (AVERAGE_FRACTION_BITS - 1))) >> AVERAGE_FRACTION_BITS);
+        break;
+    case ModelType::GAUSSIAN:
+        for (int i = 0; i < numPixels; ++i)
+        {
+            int value = static_cast<int>(mMean[i] + 0.5f);
+            Image::CheckPixelValue(value);
+            pDst[i] = static_cast<Image::Byte>(value);
+        }
+        break;
+    case ModelType::MEDIAN:
+        memcpy(pDst, mMedian.GetRawPointer(), numPixels);
+        break;
+    }
+
+    return true;
+}
+
+void BackgroundModel::Initialize(const Image& frame)
+{
+    const int numPixels = mHeight * mWidth;
+    const Image::Byte* pFrame = frame.GetRawPointer();
+
+    switch (mType)
+    {
+    case ModelType::RUNNING_AVERAGE:
+        for (int i = 0; i < numPixels; ++i)
+            mAverage[i] = static_cast<short>(pFrame[i] << AVERAGE_FRACTION_BITS);
+        break;
+    case ModelType::GAUSSIAN:
+        for (int i = 0; i < numPixels; ++i)
+            mMean[i] = pFrame[i];
+        std::fill(mVariance.begin(), mVariance.end(), static_cast<float>(INITIAL_STD_DEVIATION * INITIAL_STD_DEVIATION));
+        break;
+    case ModelType::MEDIAN:
+        memcpy(mMedian.GetRawPointer(), pFrame, numPixels);
+        break;
+    }
+}
+
+void BackgroundModel::Update(const Image::Byte* pFrame, Image::Byte* pMask, const int begin, const int end)
+{
+    switch (mType)
+    {
+    case ModelType::RUNNING_AVERAGE:
+        UpdateRunningAverage(pFrame, pMask, begin, end);
+        break;
+    case ModelType::GAUSSIAN:
+        UpdateGaussian(pFrame, pMask, begin, end);
+        break;
+    case ModelType::MEDIAN:
+        UpdateMedian(pFrame, pMask, begin, end);
+        break;
+    }
+}
+
+void BackgroundModel::UpdateRunningAverage(const Image::Byte* pFrame, Image::Byte* pMask, const int begin, const int end)
+{
+    const int ROUNDING = 1 << (AVERAGE_FRACTION_BITS - 1);
+    short* pAverage = mAverage.data();
+    int i = begin;
+
+#ifdef BACKGROUND_MODEL_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m128i rounding = _mm_set1_epi16(ROUNDING);
+    const __m128i rate = _mm_set1_epi16(mRateFixed);
+    const __m128i threshold = _mm_set1_epi8(static_cast<char>(mDiffThreshold));
+
+    for ( ; i + 16 <= end; i += 16)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pFrame + i));
+        __m128i averageLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pAverage + i));
+        __m128i averageHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pAverage + i + 8));
+
+        // Mask of pixels which differ from background more than threshold
+        const __m128i background = _mm_packus_epi16(_mm_srli_epi16(_mm_add_epi16(averageLo, rounding), AVERAGE_FRACTION_BITS),
+                                                    _mm_srli_epi16(_mm_add_epi16(averageHi, rounding), AVERAGE_FRACTION_BITS));
+        const __m128i diff = _mm_or_si128(_mm_subs_epu8(pixels, background), _mm_subs_epu8(background, pixels));
+        const __m128i mask = _mm_xor_si128(_mm_cmpeq_epi8(_mm_subs_epu8(diff, threshold), zero), ones);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pMask + i - begin), mask);
+
+        // average += (pixel - average) * rate
+        const __m128i pixelsLo = _mm_slli_epi16(_mm_unpacklo_epi8(pixels, zero), AVERAGE_FRACTION_BITS);
+        const __m128i pixelsHi = _mm_slli_epi16(_mm_unpackhi_epi8(pixels, zero), AVERAGE_FRACTION_BITS);
+        averageLo = _mm_add_epi16(averageLo, _mm_mulhi_epi16(_mm_sub_epi16(pixelsLo, averageLo), rate));
+        averageHi = _mm_add_epi16(averageHi, _mm_mulhi_epi16(_mm_sub_epi16(pixelsHi, averageHi), rate));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pAverage + i), averageLo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pAverage + i + 8), averageHi);
+    }
+#endif
+
+    for ( ; i < end; ++i)
+    {
+        const int background = (pAverage[i] + ROUNDING) >> AVERAGE_FRACTION_BITS;
+        const int diff = (pFrame[i] >= background) ? pFrame[i] - background : background - pFrame[i];
+        pMask[i - begin] = (diff > mDiffThreshold) ? Image::MAX_PIXEL_VALUE : Image::MIN_PIXEL_VALUE;
+
+        // The arithmetic shift of product is the same as the high half of product in SIMD version
+        const int delta = (pFrame[i] << AVERAGE_FRACTION_BITS) - pAverage[i];
+        pAverage[i] = static_cast<short>(pAverage[i] + ((delta * mRateFixed) >> 16));
+    }
+}
+
+void BackgroundModel::UpdateGaussian(const Image::Byte* pFrame, Image::Byte* pMask, const int begin, const int end)
+{
+    const float MIN_VARIANCE = MIN_STD_DEVIATION * MIN_STD_DEVIATION;
+    float* pMean = mMean.data();
+    float* pVariance = mVariance.data();
+    int i = begin;
+
+#ifdef BACKGROUND_MODEL_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 rate = _mm_set1_ps(mRate);
+    const __m128 sigmaThreshold2 = _mm_set1_ps(mSigmaThreshold2);
+    const __m128 minVariance = _mm_set1_ps(MIN_VARIANCE);
+
+    for ( ; i + 16 <= end; i += 16)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pFrame + i));
+        const __m128i pixelsLo = _mm_unpacklo_epi8(pixels, zero);
+        const __m128i pixelsHi = _mm_unpackhi_epi8(pixels, zero);
+        const __m128i pixels32[4] = { _mm_unpacklo_epi16(pixelsLo, zero), _mm_unpackhi_epi16(pixelsLo, zero),
+                                      _mm_unpacklo_epi16(pixelsHi, zero), _mm_unpackhi_epi16(pixelsHi, zero) };
+        __m128i masks[4];
+
+        for (int k = 0; k < 4; ++k)
+        {
+            float* pCurMean = pMean + i + 4 * k;
+            float* pCurVariance = pVariance + i + 4 * k;
+
+            const __m128 mean = _mm_loadu_ps(pCurMean);
+            const __m128 variance = _mm_loadu_ps(pCurVariance);
+            const __m128 diff = _mm_sub_ps(_mm_cvtepi32_ps(pixels32[k]), mean);
+            const __m128 diff2 = _mm_mul_ps(diff, diff);
+
+            masks[k] = _mm_castps_si128(_mm_cmpgt_ps(diff2, _mm_mul_ps(sigmaThreshold2, variance)));
+
+            _mm_storeu_ps(pCurMean, _mm_add_ps(mean, _mm_mul_ps(rate, diff)));
+            _mm_storeu_ps(pCurVariance, _mm_max_ps(_mm_add_ps(variance, _mm_mul_ps(rate, _mm_sub_ps(diff2, variance))), minVariance));
+        }
+
+        const __m128i mask = _mm_packs_epi16(_mm_packs_epi32(masks[0], masks[1]), _mm_packs_epi32(masks[2], masks[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pMask + i - begin), mask);
+    }
+#endif
+
+    for ( ; i < end; ++i)
+    {
+        const float diff = pFrame[i] - pMean[i];
+        const float diff2 = diff * diff;
+
+        pMask[i - begin] = (diff2 > mSigmaThreshold2 * pVariance[i]) ? Image::MAX_PIXEL_VALUE : Image::MIN_PIXEL_VALUE;
+
+        pMean[i] = pMean[i] + mRate * diff;
+        pVariance[i] = std::max(pVariance[i] + mRate * (diff2 - pVariance[i]), MIN_VARIANCE);
+    }
+}
+
+void BackgroundModel::UpdateMedian(const Image::Byte* pFrame, Image::Byte* pMask, const int begin, const int end)
+{
+    Image::Byte* pMedian = mMedian.GetRawPointer();
+    int i = begin;
+
+#ifdef BACKGROUND_MODEL_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i threshold = _mm_set1_epi8(static_cast<char>(mDiffThreshold));
+
+    for ( ; i + 16 <= end; i += 16)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pFrame + i));
+        const __m128i median = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pMedian + i));
+
+        const __m128i more = _mm_subs_epu8(pixels, median);
+        const __m128i less = _mm_subs_epu8(median, pixels);
+
+        const __m128i diff = _mm_or_si128(more, less);
+        const __m128i mask = _mm_xor_si128(_mm_cmpeq_epi8(_mm_subs_epu8(diff, threshold), zero), ones);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pMask + i - begin), mask);
+
+        // Move the median by one level to pixel
+        const __m128i inc = _mm_andnot_si128(_mm_cmpeq_epi8(more, zero), one);
+        const __m128i dec = _mm_andnot_si128(_mm_cmpeq_epi8(less, zero), one);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pMedian + i), _mm_sub_epi8(_mm_add_epi8(median, inc), dec));
+    }
+#endif
+
+    for ( ; i < end; ++i)
+    {
+        const int diff = (pFrame[i] >= pMedian[i]) ? pFrame[i] - pMedian[i] : pMedian[i] - pFrame[i];
+        pMask[i - begin] = (diff > mDiffThreshold) ? Image::MAX_PIXEL_VALUE : Image::MIN_PIXEL_VALUE;
+
+        if (pFrame[i] > pMedian[i])
+            ++pMedian[i];
+        else if (pFrame[i] < pMedian[i])
+            --pMedian[i];
+    }
+}
+
+}
@@ -0,0 +1,291 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of binary image
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BINARY_IMAGE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#include "BinaryImage.h"
+#include "Parallel.h"
+
+namespace acv {
+
+// Count the set bits of word
+static int CountBits(BinaryImage::Word word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Count the cleared bits before the first set bit (word should not be zero)
+static int CountTrailingZeros(BinaryImage::Word word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    int count = 0;
+    for ( ; (word & 1) == 0; word >>= 1)
+        ++count;
+    return count;
+#endif
+}
+
+BinaryImage::BinaryImage()
+    : mWords(),
+      mWidth(0),
+      mHeight(0),
+      mWordsPerRow(0)
+{ }
+
+BinaryImage::BinaryImage(const int height, const int width)
+    : mWords(),
+      mWidth(width),
+      mHeight(height),
+      mWordsPerRow((width + BITS_PER_WORD - 1) / BITS_PER_WORD)
+{
+    if (IsInitialized())
+        mWords.assign(static_cast<size_t>(mWordsPerRow) * mHeight, 0);
+}
+
+BinaryImage::BinaryImage(const Image& img)
+    : BinaryImage(img.GetHeight(), img.GetWidth())
+{
+    if (!IsInitialized())
+        return;
+
+    Parallel::For(0, mHeight, [&](const int rowBegin, const int rowEnd)
+    {
+        for (int row = rowBegin; row < rowEnd; ++row)
+            PackRow(row, img.GetRawPointer(row * mWidth));
+    }, 64);
+}
+
+BinaryImage::Word BinaryImage::GetLastWordMask() const
+{
+    const int usedBits = mWidth % BITS_PER_WORD;
+    return (usedBits == 0) ? ~Word(0) : (Word(1) << usedBits) - 1;
+}
+
+void BinaryImage::Clear()
+{
+    std::fill(mWords.begin(), mWords.end(), 0);
+}
+
+void BinaryImage::PackRow(const int rowNum, const Image::Byte* pSrc)
+{
+    Word* pRow = GetRow(rowNum);
+    std::fill(pRow, pRow + mWordsPerRow, 0);
+
+    int colNum = 0;
+
+#ifdef BINARY_IMAGE_USE_SSE2
+    // Each 16 pixels are packed to 16 bits by the mask of bytes (the words are filled by quarters)
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; colNum + 16 <= mWidth; colNum += 16)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + colNum));
+        const Word bits = static_cast<Word>(~_mm_movemask_epi8(_mm_cmpeq_epi8(pixels, zero)) & 0xFFFF);
+        pRow[colNum / BITS_PER_WORD] |= bits << (colNum % BITS_PER_WORD);
+    }
+#endif
+
+    for ( ; colNum < mWidth; ++colNum)
+    {
+        if (pSrc[colNum] != Image::MIN_PIXEL_VALUE)
+            pRow[colNum / BITS_PER_WORD] |= Word(1) << (colNum % BITS_PER_WORD);
+    }
+}
+
+void BinaryImage::UnpackRow(const int rowNum, Image::Byte* pDst,
+                            const Image::Byte setVal/* = Image::MAX_PIXEL_VALUE*/, const Image::Byte clearVal/* = Image::MIN_PIXEL_VALUE*/) const
+{
+    const Word* pRow = GetRow(rowNum);
+    int colNum = 0;
+
+#ifdef BINARY_IMAGE_USE_SSE2
+    // Each 16 bits are spread to the bytes and are compared with the bit of byte position
+    const __m128i bitMasks = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i setVals = _mm_set1_epi8(static_cast<char>(setVal));
+    const __m128i clearVals = _mm_set1_epi8(static_cast<char>(clearVal));
+    for ( ; colNum + 16 <= mWidth; colNum += 16)
+    {
+        const int bits = static_cast<int>(pRow[colNum / BITS_PER_WORD] >> (colNum % BITS_PER_WORD));
+        const __m128i spread = _mm_unpacklo_epi64(_mm_set1_epi8(static_cast<char>(bits & 0xFF)),
+                                                  _mm_set1_epi8(static_cast<char>((bits >> 8) & 0xFF)));
+        const __m128i mask = _mm_cmpeq_epi8(_mm_and_si128(spread, bitMasks), bitMasks);
+        const __m128i pixels = _mm_or_si128(_mm_and_si128(mask, setVals), _mm_andnot_si128(mask, clearVals));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + colNum), pixels);
+    }
+#endif
+
+    for ( ; colNum < mWidth; ++colNum)
+        pDst[colNum] = ((pRow[colNum / BITS_PER_WORD] >> (colNum % BITS_PER_WORD)) & 1) ? setVal : clearVal;
+}
+
+bool BinaryImage::ConvertToImage(Image& img) const
+{
+    if (!IsInitialized() || img.GetWidth() != mWidth || img.GetHeight() != mHeight)
+        return false;
+
+    Parallel::For(0, mHeight, [&](const int rowBegin, const int rowEnd)
+    {
+        for (int row = rowBegin; row < rowEnd; ++row)
+            UnpackRow(row, img.GetRawPointer(row * mWidth));
+    }, 64);
+
+    return true;
+}
+
+size_t BinaryImage::CountPixels() const
+{
+    size_t count = 0;
+    for (const Word word : mWords)
+        count += CountBits(word);
+    return count;
+}
+
+void BinaryImage::FindRuns(const int rowNum, std::vector<Run>& runs) const
+{
+    runs.clear();
+
+    const Word* pRow = GetRow(rowNum);
+    int startX = -1; // The first column of current run (-1 if the run is not started)
+
+    for (int wordNum = 0; wordNum < mWordsPerRow; ++wordNum)
+    {
+        const int firstCol = wordNum * BITS_PER_WORD;
+        int bitNum = 0;
+
+        // The start of run is the first set bit, the end of run is the first cleared bit after it
+        while (bitNum < BITS_PER_WORD)
+        {
+            const Word rest = ((startX < 0) ? pRow[wordNum] : ~pRow[wordNum]) >> bitNum;
+            if (rest == 0)
+                break;
+
+            bitNum += CountTrailingZeros(rest);
+            if (startX < 0)
+            {
+                startX = firstCol + bitNum;
+            }
+            else
+            {
+                runs.push_back({ startX, firstCol + bitNum - 1 });
+                startX = -1;
+            }
+        }
+    }
+
+    // The run can be finished by the end of row only if the width is multiple of word size
+    if (startX >= 0)
+        runs.push_back({ startX, mWidth - 1 });
+}
+
+// Combine the words of two images by operation (destination image can be one of source images)
+template <typename Operation>
+static bool CombineImages(const BinaryImage& lhs, const BinaryImage& rhs, BinaryImage& dstImg, const Operation& op)
+{
+    if (!lhs.IsInitialized() ||
+        lhs.GetWidth() != rhs.GetWidth() || lhs.GetHeight() != rhs.GetHeight() ||
+        lhs.GetWidth() != dstImg.GetWidth() || lhs.GetHeight() != dstImg.GetHeight())
+        return false;
+
+    const BinaryImage::Word* pLhs = lhs.GetData().data();
+    const BinaryImage::Word* pRhs = rhs.GetData().data();
+    BinaryImage::Word* pDst = dstImg.GetData().data();
+    const size_t numWords = dstImg.GetData().size();
+
+    for (size_t i = 0; i < numWords; ++i)
+        pDst[i] = op(pLhs[i], pRhs[i]);
+
+    return true;
+}
+
+bool BinaryImage::And(const BinaryImage& lhs, const BinaryImage& rhs, BinaryImage& dstImg)
+{
+    return CombineImages(lhs, rhs, dstImg, [](const Word lhsWord, const Word rhsWord) { return lhsWord & rhsWord; });
+}
+
+bool BinaryImage::Or(const BinaryImage& lhs, const BinaryImage& rhs, BinaryImage& dstImg)
+{
+    return CombineImages(lhs, rhs, dstImg, [](const Word lhsWord, const Word rhsWord) { return lhsWord | rhsWord; });
+}
+
+bool BinaryImage::Xor(const BinaryImage& lhs, const BinaryImage& rhs, BinaryImage& dstImg)
+{
+    return CombineImages(lhs, rhs, dstImg, [](const Word lhsWord, const Word rhsWord) { return lhsWord ^ rhsWord; });
+}
+
+bool BinaryImage::Invert(const BinaryImage& srcImg, BinaryImage& dstImg)
+{
+    if (!srcImg.IsInitialized() || srcImg.GetWidth() != dstImg.GetWidth() || srcImg.GetHeight() != dstImg.GetHeight())
+        return false;
+
+    // The unused bits of the last word of row are kept cleared
+    const Word lastWordMask = srcImg.GetLastWordMask();
+    const int wordsPerRow = srcImg.GetWordsPerRow();
+
+    for (int row = 0; row < srcImg.GetHeight(); ++row)
+    {
+        const Word* pSrc = srcImg.GetRow(row);
+        Word* pDst = dstImg.GetRow(row);
+
+        for (int wordNum = 0; wordNum < wordsPerRow; ++wordNum)
+            pDst[wordNum] = ~pSrc[wordNum];
+        pDst[wordsPerRow - 1] &= lastWordMask;
+    }
+
+    return true;
+}
+
+bool BinaryImage::operator == (const BinaryImage& rhs) const
+{
+    return mWidth == rhs.mWidth && mHeight == rhs.mHeight && mWords == rhs.mWords;
+}
+
+bool BinaryImage::operator != (const BinaryImage& rhs) const
+{
+    return !(*this == rhs);
+}
+
+}
@@ -28,110 +28,273 @@
 #include <cstring>
 #include <vector>
 #include <cmath>
-#include <list>
+#include <atomic>
+#include <functional>
 
 #include "BordersDetector.h"
+#include "BinaryImage.h"
 #include "MatrixFilter.h"
 #include "ImageFilter.h"
+#include "Parallel.h"
+#include "Progress.h"
+#include "Profiler.h"
+#include "SimdKernels.h"
+#include "TaskGraph.h"
 
 namespace acv {
 
-bool BordersDetector::Canny(Image& img, const Image::Byte thresholdMin, const Image::Byte thresholdMax)
+// Mirror the coordinate of neighbour if it is out of range [0, size)
+// (the diagonal neighbours of corner pixels are out of image)
+static inline int MirrorNeighbourCoordinate(const int coord, const int size)
 {
-    // Gaussian blur
-    MatrixFilter<int> filter(5, 159);
-    filter[0][0] = 2; filter[0][1] =  4; filter[0][2] =  5; filter[0][3] =  4; filter[0][4] = 2;
-    filter[1][0] = 4; filter[1][1] =  9; filter[1][2] = 12; filter[1][3] =  9; filter[1][4] = 4;
-    filter[2][0] = 5; filter[2][1] = 12; filter[2][2] = 15; filter[2][3] = 12; filter[2][4] = 5;
-    filter[3][0] = 4; filter[3][1] =  9; filter[3][2] = 12; filter[3][3] =  9; filter[3][4] = 4;
-    filter[4][0] = 2; filter[4][1] =  4; filter[4][2] =  5; filter[4][3] =  4; filter[4][4] = 2;
+    const int mirrored = (coord < 0) ? -coord : (coord >= size) ? 2 * size - 2 - coord : coord;
+    return std::min(std::max(mirrored, 0), size - 1);
+}
+
+// Run the horizontal and vertical operators as the independent stages of graph of tasks,
+// the combination of their results is started after the finish of both operators
+// Returns false if any stage was not done (the combination is not run in this case)
+static bool RunOperatorStages(const std::function<bool()>& horizOperator, const std::function<bool()>& vertOperator,
+                              const std::function<bool()>& combination)
+{
+    std::atomic<bool> isDone(true);
 
-    if (!MatrixFilterOperations::FastConvolutionImage<int>(img, filter))
+    TaskGraph graph;
+    const int horizTask = graph.AddTask([&]() { if (!horizOperator()) isDone.store(false); });
+    const int vertTask = graph.AddTask([&]() { if (!vertOperator()) isDone.store(false); });
+    const int combinationTask = graph.AddTask([&]() { if (isDone.load() && !combination()) isDone.store(false); });
+    graph.AddDependency(horizTask, combinationTask);
+    graph.AddDependency(vertTask, combinationTask);
+
+    return graph.Run() && isDone.load();
+}
+
+bool BordersDetector::Canny(Image& img, const Image::Byte thresholdMin, const Image::Byte thresholdMax, const bool bilateralBlur,
+                            Progress* progress)
+{
+    ACV_PROFILE_SCOPE_BYTES("BordersDetector::Canny", static_cast<long long>(img.GetHeight()) * img.GetWidth());
+
+    std::vector<std::vector<Gradient>> gradients;
+    if (!CannyGradients(img, thresholdMin, thresholdMax, bilateralBlur, gradients, progress))
+        return false;
+
+    WriteGradients(gradients, img);
+
+    return Progress::Step(progress);
+}
+
+bool BordersDetector::Canny(const Image& srcImg, BinaryImage& dstImg, const Image::Byte thresholdMin, const Image::Byte thresholdMax,
+                            const bool bilateralBlur, Progress* progress)
+{
+    if (!srcImg.IsInitialized() || srcImg.GetWidth() != dstImg.GetWidth() || srcImg.GetHeight() != dstImg.GetHeight())
+        return false;
+
+    ACV_PROFILE_SCOPE_BYTES("BordersDetector::Canny", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
+    // The blur is run in place, so the source is copied
+    Image img = srcImg;
+    std::vector<std::vector<Gradient>> gradients;
+    if (!CannyGradients(img, thresholdMin, thresholdMax, bilateralBlur, gradients, progress))
+        return false;
+
+    WriteGradients(gradients, dstImg);
+
+    return Progress::Step(progress);
+}
+
+bool BordersDetector::CannyGradients(Image& img, const Image::Byte thresholdMin, const Image::Byte thresholdMax, const bool bilateralBlur,
+                                     std::vector<std::vector<Gradient>>& gradients, Progress* progress)
+{
+    // Blur, two operators, gradients, suppression, threshold and writing are the steps of progress
+    const int NUM_STAGES = 7;
+    Progress::Begin(progress, NUM_STAGES);
+
+    // Gaussian blur or bilateral blur (it smooths the noise, but keeps the weak borders sharp)
+    if (bilateralBlur)
+    {
+        if (ImageFilter::Bilateral(img, img, CANNY_BILATERAL_SPATIAL_SIGMA, CANNY_BILATERAL_RANGE_SIGMA) != FiltrationResult::SUCCESS)
+            return false;
+    }
+    else
+    {
+        MatrixFilter<int> filter(5, 159);
+        FormCannyBlurFilter(filter);
+
+        if (!MatrixFilterOperations::FastConvolutionImage<int>(img, filter))
+            return false;
+    }
+
+    if (!Progress::Step(progress))
         return false;
 
     // Calculation the gradients for each pixel
     Image tmpImg1(img.GetHeight(), img.GetWidth());
     Image tmpImg2(img.GetHeight(), img.GetWidth());
 
-    bool ret = NonConvSobelH(img, tmpImg1);
-    ret = ret && NonConvSobelV(img, tmpImg2);
+    gradients.assign(img.GetHeight(), std::vector<Gradient>(img.GetWidth()));
 
+    const bool ret = RunOperatorStages([&]() { return NonConvSobelH(img, tmpImg1) && Progress::Step(progress); },
+                                       [&]() { return NonConvSobelV(img, tmpImg2) && Progress::Step(progress); },
+                                       [&]() { FormGradients(tmpImg1, tmpImg2, gradients); return Progress::Step(progress); });
     if (!ret)
         return false;
 
-    std::vector<std::vector<Gradient>> gradients(img.GetHeight(), std::vector<Gradient>(img.GetWidth()));
-
-    Image::Matrix::const_iterator it1 = tmpImg1.GetData().begin();
-    Image::Matrix::const_iterator it2 = tmpImg2.GetData().begin();
-    for (int row = 0; row < img.GetHeight(); ++row)
-        for (int col = 0; col < img.GetWidth(); ++col)
-            gradients[row][col] = Gradient(*it1++, *it2++);
-
     // Maximum suppression
-    if (!BordersDetector::MaximumSuppression(gradients))
+    if (!BordersDetector::MaximumSuppression(gradients) || !Progress::Step(progress))
         return false;
 
+    // Double threshold and tracing ambiguity area
+    std::vector<Point> pixelGroup;
+    HysteresisThreshold(gradients, thresholdMin, thresholdMax, pixelGroup);
+
+    return Progress::Step(progress);
+}
+
+void BordersDetector::FormCannyBlurFilter(MatrixFilter<int>& filter)
+{
+    filter[0][0] = 2; filter[0][1] =  4; filter[0][2] =  5; filter[0][3] =  4; filter[0][4] = 2;
+    filter[1][0] = 4; filter[1][1] =  9; filter[1][2] = 12; filter[1][3] =  9; filter[1][4] = 4;
+    filter[2][0] = 5; filter[2][1] = 12; filter[2][2] = 15; filter[2][3] = 12; filter[2][4] = 5;
+    filter[3][0] = 4; filter[3][1] =  9; filter[3][2] = 12; filter[3][3] =  9; filter[3][4] = 4;
+    filter[4][0] = 2; filter[4][1] =  4; filter[4][2] =  5; filter[4][3] =  4; filter[4][4] = 2;
+    filter.SetDivider(159);
+}
+
+void BordersDetector::FormGradients(const Image& horizImg, const Image& vertImg, std::vector<std::vector<Gradient>>& gradients)
+{
+    ACV_PROFILE_SCOPE("BordersDetector::FormGradients");
+
+    const std::vector<Gradient>& table = GetGradientsTable();
+
+    const int width = horizImg.GetWidth();
+    Parallel::For(0, horizImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
+    {
+        for (int row = rowBegin; row < rowEnd; ++row)
+        {
+            const Image::Byte* pHoriz = horizImg.GetRawPointer(row * width);
+            const Image::Byte* pVert = vertImg.GetRawPointer(row * width);
+            for (int col = 0; col < width; ++col)
+                gradients[row][col] = table[(*pHoriz++ << 8) + *pVert++];
+        }
+    }, 16);
+}
+
+const std::vector<BordersDetector::Gradient>& BordersDetector::GetGradientsTable()
+{
+    static const std::vector<Gradient> table = []()
+    {
+        std::vector<Gradient> gradients((Image::MAX_PIXEL_VALUE + 1) * (Image::MAX_PIXEL_VALUE + 1));
+        for (int horiz = 0; horiz <= Image::MAX_PIXEL_VALUE; ++horiz)
+            for (int vert = 0; vert <= Image::MAX_PIXEL_VALUE; ++vert)
+                gradients[(horiz << 8) + vert] = Gradient(horiz, vert);
+        return gradients;
+    }();
+
+    return table;
+}
+
+void BordersDetector::HysteresisThreshold(std::vector<std::vector<Gradient>>& gradients, const Image::Byte thresholdMin,
+                                          const Image::Byte thresholdMax, std::vector<Point>& pixelGroup)
+{
+    ACV_PROFILE_SCOPE("BordersDetector::HysteresisThreshold");
+
+    const int height = gradients.size();
+    const int width = gradients[0].size();
+
     // Double threshold
-    for (int row = 0; row < img.GetHeight(); ++row)
+    Parallel::For(0, height, [&](const int rowBegin, const int rowEnd)
     {
-        for (int col = 0; col < img.GetWidth(); ++col)
+        for (int row = rowBegin; row < rowEnd; ++row)
         {
-            Gradient& gr = gradients[row][col];
-            if (gr.abs > thresholdMax)
-                gr.abs = Image::MAX_PIXEL_VALUE;
-            else if (gr.abs < thresholdMin)
-                gr.abs = Image::MIN_PIXEL_VALUE;
+            for (int col = 0; col < width; ++col)
+            {
+                Gradient& gr = gradients[row][col];
+                if (gr.abs > thresholdMax)
+                    gr.abs = Image::MAX_PIXEL_VALUE;
+                else if (gr.abs < thresholdMin)
+                    gr.abs = Image::MIN_PIXEL_VALUE;
+            }
         }
-    }
+    }, 16);
 
-    // Tracing ambiguity area
+    // Tracing ambiguity area (it is sequential, because the groups are traced in order of raster scan)
     const int MAX_CLOSER_SIZE = 50;
-    for (int row = 0; row < img.GetHeight(); ++row)
+    for (int row = 0; row < height; ++row)
     {
-        for (int col = 0; col < img.GetWidth(); ++col)
+        for (int col = 0; col < width; ++col)
         {
             if (gradients[row][col].abs > Image::MIN_PIXEL_VALUE && gradients[row][col].abs < Image::MAX_PIXEL_VALUE)
             {
-                std::list<Point> pixelGroup;
                 int closer = 0; // Number of closing to found boundary
 
+                pixelGroup.clear();
                 pixelGroup.push_back(Point(col, row));
                 gradients[row][col].abs = 0;
 
-                for(std::list<Point>::iterator it = pixelGroup.begin(); it != pixelGroup.end(); ++it)
-                    BordersDetector::AmbiguityTrace(it->GetY(), it->GetX(), img.GetHeight(), img.GetWidth(), gradients, pixelGroup, closer);
+                // The group is extended during the tracing, so the points are accessed by index
+                for (size_t i = 0; i < pixelGroup.size(); ++i)
+                {
+                    const Point pnt = pixelGroup[i];
+                    BordersDetector::AmbiguityTrace(pnt.GetY(), pnt.GetX(), height, width, gradients, pixelGroup, closer);
+                }
 
                 if (closer > 0 && closer < MAX_CLOSER_SIZE)
-                    for(std::list<Point>::iterator it = pixelGroup.begin(); it != pixelGroup.end(); ++it)
-                        gradients[it->GetY()][it->GetX()].abs = Image::MAX_PIXEL_VALUE;
+                    for (const Point& pnt : pixelGroup)
+                        gradients[pnt.GetY()][pnt.GetX()].abs = Image::MAX_PIXEL_VALUE;
             }
         }
     }
+}
 
-    auto pixIt = img.GetData().begin();
-    for (int row = 0; row < img.GetHeight(); ++row)
+void BordersDetector::WriteGradients(const std::vector<std::vector<Gradient>>& gradients, Image& img)
+{
+    ACV_PROFILE_SCOPE("BordersDetector::WriteGradients");
+
+    const int width = img.GetWidth();
+    Parallel::For(0, img.GetHeight(), [&](const int rowBegin, const int rowEnd)
     {
-        for (int col = 0; col < img.GetWidth(); ++col)
+        for (int row = rowBegin; row < rowEnd; ++row)
         {
-            *pixIt = gradients[row][col].abs;
-            ++pixIt;
+            Image::Byte* pDst = img.GetRawPointer(row * width);
+            for (int col = 0; col < width; ++col)
+                pDst[col] = gradients[row][col].abs;
         }
-    }
+    }, 16);
+}
 
-    return true;
+void BordersDetector::WriteGradients(const std::vector<std::vector<Gradient>>& gradients, BinaryImage& img)
+{
+    ACV_PROFILE_SCOPE("BordersDetector::WriteGradients");
+
+    // The modules of gradients are Image::MIN_PIXEL_VALUE or Image::MAX_PIXEL_VALUE after the hysteresis threshold
+    Parallel::For(0, img.GetHeight(), [&](const int rowBegin, const int rowEnd)
+    {
+        for (int row = rowBegin; row < rowEnd; ++row)
+        {
+            BinaryImage::Word* pDst = img.GetRow(row);
+            std::fill(pDst, pDst + img.GetWordsPerRow(), 0);
+
+            for (int col = 0; col < img.GetWidth(); ++col)
+            {
+                if (gradients[row][col].abs != Image::MIN_PIXEL_VALUE)
+                    pDst[col / BinaryImage::BITS_PER_WORD] |= BinaryImage::Word(1) << (col % BinaryImage::BITS_PER_WORD);
+            }
+        }
+    }, 16);
 }
 
-bool BordersDetector::Canny(const Image& srcImg, Image& dstImg, const Image::Byte thresholdMin, const Image::Byte thresholdMax)
+bool BordersDetector::Canny(const Image& srcImg, Image& dstImg, const Image::Byte thresholdMin, const Image::Byte thresholdMax,
+                            const bool bilateralBlur, Progress* progress)
 {
     dstImg = srcImg;
-    return Canny(dstImg, thresholdMin, thresholdMax);
+    return Canny(dstImg, thresholdMin, thresholdMax, bilateralBlur, progress);
 }
 
-bool BordersDetector::Sobel(Image& img)
+bool BordersDetector::Sobel(Image& img, Progress* progress)
 {
     Image tmpImg(img.GetHeight(), img.GetWidth());
 
-    bool ret = Sobel(img, tmpImg);
+    bool ret = Sobel(img, tmpImg, progress);
     if (ret)
         img = std::move(tmpImg);
 
@@ -140,67 +303,88 @@ bool BordersDetector::Sobel(Image& img)
 
 void BordersDetector::FormGradientModules(const Image& horizImg, const Image& vertImg, Image& modImg)
 {
-    Image::Matrix::const_iterator it1 = horizImg.GetData().begin();
-    Image::Matrix::const_iterator it2 = vertImg.GetData().begin();
-    Image::Matrix::iterator itDst = modImg.GetData().begin();
-    Image::Matrix::iterator itDstEnd = modImg.GetData().end();
+    ACV_PROFILE_SCOPE("BordersDetector::FormGradientModules");
 
-    int prodBuf[Image::MAX_PIXEL_VALUE + 1][Image::MAX_PIXEL_VALUE + 1];
-    for (size_t i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
-        for (size_t j = 0; j <= Image::MAX_PIXEL_VALUE; ++j)
-            prodBuf[i][j] = hypot(i, j);
+    const std::vector<Image::Byte>& prodBuf = GetGradientModulesTable();
 
-    while (itDst != itDstEnd)
+    const int width = modImg.GetWidth();
+    Parallel::For(0, modImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
     {
-        *itDst = prodBuf[*it1][*it2];
+        const Image::Byte* it1 = horizImg.GetRawPointer(rowBegin * width);
+        const Image::Byte* it2 = vertImg.GetRawPointer(rowBegin * width);
+        Image::Byte* itDst = modImg.GetRawPointer(rowBegin * width);
+        Image::Byte* itDstEnd = modImg.GetRawPointer() + static_cast<size_t>(rowEnd) * width;
 
-        ++itDst;
-        ++it1;
-        ++it2;
-    }
+        while (itDst != itDstEnd)
+        {
+            *itDst = prodBuf[(*it1 << 8) + *it2];
+
+            ++itDst;
+            ++it1;
+            ++it2;
+        }
+    }, 16);
 }
 
-bool BordersDetector::Sobel(const Image& srcImg, Image& dstImg)
+const std::vector<Image::Byte>& BordersDetector::GetGradientModulesTable()
 {
-    Image tmpImg1(srcImg.GetHeight(), srcImg.GetWidth());
-    Image tmpImg2(srcImg.GetHeight(), srcImg.GetWidth());
+    static const std::vector<Image::Byte> table = []()
+    {
+        std::vector<Image::Byte> modules((Image::MAX_PIXEL_VALUE + 1) * (Image::MAX_PIXEL_VALUE + 1));
+        for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+            for (int j = 0; j <= Image::MAX_PIXEL_VALUE; ++j)
+                modules[(i << 8) + j] = static_cast<Image::Byte>(static_cast<int>(hypot(i, j)));
+        return modules;
+    }();
+
+    return table;
+}
 
-    bool ret = NonConvSobelH(srcImg, tmpImg1);
-    ret = ret && NonConvSobelV(srcImg, tmpImg2);
+bool BordersDetector::Sobel(const Image& srcImg, Image& dstImg, Progress* progress)
+{
+    ACV_PROFILE_SCOPE_BYTES("BordersDetector::Sobel", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
 
-    if (ret)
-        BordersDetector::FormGradientModules(tmpImg1, tmpImg2, dstImg);
+    // Two operators and the modules of gradients are the steps of progress
+    Progress::Begin(progress, 3);
 
-    return ret;
+    Image tmpImg1(srcImg.GetHeight(), srcImg.GetWidth());
+    Image tmpImg2(srcImg.GetHeight(), srcImg.GetWidth());
+
+    return RunOperatorStages([&]() { return NonConvSobelH(srcImg, tmpImg1) && Progress::Step(progress); },
+                             [&]() { return NonConvSobelV(srcImg, tmpImg2) && Progress::Step(progress); },
+                             [&]() { FormGradientModules(tmpImg1, tmpImg2, dstImg); return Progress::Step(progress); });
 }
 
-bool BordersDetector::Scharr(Image& img)
+bool BordersDetector::Scharr(Image& img, Progress* progress)
 {
     Image tmpImg(img.GetHeight(), img.GetWidth());
 
-    bool ret = Sobel(img, tmpImg);
+    bool ret = Scharr(img, tmpImg, progress);
     if (ret)
         img = std::move(tmpImg);
 
     return ret;
 }
 
-bool BordersDetector::Scharr(const Image& srcImg, Image& dstImg)
+bool BordersDetector::Scharr(const Image& srcImg, Image& dstImg, Progress* progress)
 {
-    Image tmpImg1(srcImg.GetHeight(), srcImg.GetWidth());
-    Image tmpImg2(srcImg.GetHeight(), srcImg.GetWidth());
+    ACV_PROFILE_SCOPE_BYTES("BordersDetector::Scharr", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
 
-    bool ret = ConvScharr(srcImg, tmpImg1, OperatorType::HORIZONTAL);
-    ret = ret && ConvScharr(srcImg, tmpImg2, OperatorType::VERTICAL);
+    // Two operators and the modules of gradients are the steps of progress
+    Progress::Begin(progress, 3);
 
-    if (ret)
-        BordersDetector::FormGradientModules(tmpImg1, tmpImg2, dstImg);
+    Image tmpImg1(srcImg.GetHeight(), srcImg.GetWidth());
+    Image tmpImg2(srcImg.GetHeight(), srcImg.GetWidth());
 
-    return ret;
+    return RunOperatorStages([&]() { return ConvScharr(srcImg, tmpImg1, OperatorType::HORIZONTAL) && Progress::Step(progress); },
+                             [&]() { return ConvScharr(srcImg, tmpImg2, OperatorType::VERTICAL) && Progress::Step(progress); },
+                             [&]() { FormGradientModules(tmpImg1, tmpImg2, dstImg); return Progress::Step(progress); });
 }
 
 bool BordersDetector::MaximumSuppression(std::vector<std::vector<BordersDetector::Gradient>>& gradients)
 {
+    ACV_PROFILE_SCOPE("BordersDetector::MaximumSuppression");
+
     int leftCol, leftRow, rightCol, rightRow;
     int leftLeftCol, leftLeftRow, rightRightCol, rightRightRow;
 
@@ -317,6 +501,15 @@ bool BordersDetector::MaximumSuppression(std::vector<std::vector<BordersDetector
                 return false;
             }
 
+            leftRow = MirrorNeighbourCoordinate(leftRow, height);
+            rightRow = MirrorNeighbourCoordinate(rightRow, height);
+            leftLeftRow = MirrorNeighbourCoordinate(leftLeftRow, height);
+            rightRightRow = MirrorNeighbourCoordinate(rightRightRow, height);
+            leftCol = MirrorNeighbourCoordinate(leftCol, width);
+            rightCol = MirrorNeighbourCoordinate(rightCol, width);
+            leftLeftCol = MirrorNeighbourCoordinate(leftLeftCol, width);
+            rightRightCol = MirrorNeighbourCoordinate(rightRightCol, width);
+
             if ((gradients[row][col].abs < gradients[leftRow][leftCol].abs) ||
                 (gradients[row][col].abs < gradients[rightRow][rightCol].abs) ||
                 (gradients[row][col].abs < gradients[leftLeftRow][leftLeftCol].abs) ||
@@ -333,7 +526,7 @@ bool BordersDetector::MaximumSuppression(std::vector<std::vector<BordersDetector
 // Вспомагательная функция для трассировки областей неоднозначности в алгоритме Канни
 void BordersDetector::AmbiguityTrace(const int row, const int col, const int height, const int width,
                                      std::vector<std::vector<BordersDetector::Gradient>>& gradients,
-                                     std::list<Point>& pixelGroup, int& closer)
+                                     std::vector<Point>& pixelGroup, int& closer)
 {
     const int NEIGHBOR_SHIFT_X[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
     const int NEIGHBOR_SHIFT_Y[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
@@ -379,37 +572,58 @@ BordersDetector::Gradient::Gradient(int horiz, int vert)
 }
 
 bool BordersDetector::DetectBorders(Image& img, DetectorType detectorType,
-                                    const Image::Byte thresholdMin /*= DEFAULT_MIN_THRESHOLD*/, const Image::Byte thresholdMax /*= DEFAULT_MAX_THRESHOLD*/)
+                                    const Image::Byte thresholdMin /*= DEFAULT_MIN_THRESHOLD*/, const Image::Byte thresholdMax /*= DEFAULT_MAX_THRESHOLD*/,
+                                    Progress* progress /*= nullptr*/)
 {
     switch (detectorType)
     {
     case DetectorType::CANNY:
-        return Canny(img, thresholdMin, thresholdMax);
+        return Canny(img, thresholdMin, thresholdMax, false, progress);
+    case DetectorType::CANNY_BILATERAL:
+        return Canny(img, thresholdMin, thresholdMax, true, progress);
     case DetectorType::SOBEL:
-        return Sobel(img);
+        return Sobel(img, progress);
     case DetectorType::SCHARR:
-        return Scharr(img);
+        return Scharr(img, progress);
     default:
         return false;
     }
 }
 
 bool BordersDetector::DetectBorders(const Image& srcImg, Image& dstImg, DetectorType detectorType,
-                                    const Image::Byte thresholdMin /*= DEFAULT_MIN_THRESHOLD*/, const Image::Byte thresholdMax /*= DEFAULT_MAX_THRESHOLD*/)
+                                    const Image::Byte thresholdMin /*= DEFAULT_MIN_THRESHOLD*/, const Image::Byte thresholdMax /*= DEFAULT_MAX_THRESHOLD*/,
+                                    Progress* progress /*= nullptr*/)
 {
     switch (detectorType)
     {
     case DetectorType::CANNY:
-        return Canny(srcImg, dstImg, thresholdMin, thresholdMax);
+        return Canny(srcImg, dstImg, thresholdMin, thresholdMax, false, progress);
+    case DetectorType::CANNY_BILATERAL:
+        return Canny(srcImg, dstImg, thresholdMin, thresholdMax, true, progress);
     case DetectorType::SOBEL:
-        return Sobel(srcImg, dstImg);
+        return Sobel(srcImg, dstImg, progress);
     case DetectorType::SCHARR:
-        return Scharr(srcImg, dstImg);
+        return Scharr(srcImg, dstImg, progress);
     default:
         return false;
     }
 }
 
+bool BordersDetector::DetectBorders(const Image& srcImg, BinaryImage& dstImg, DetectorType detectorType,
+                                    const Image::Byte thresholdMin /*= DEFAULT_MIN_THRESHOLD*/, const Image::Byte thresholdMax /*= DEFAULT_MAX_THRESHOLD*/,
+                                    Progress* progress /*= nullptr*/)
+{
+    switch (detectorType)
+    {
+    case DetectorType::CANNY:
+        return Canny(srcImg, dstImg, thresholdMin, thresholdMax, false, progress);
+    case DetectorType::CANNY_BILATERAL:
+        return Canny(srcImg, dstImg, thresholdMin, thresholdMax, true, progress);
+    default: // Sobel and Scharr detectors form the modules of gradients, but not the binary map
+        return false;
+    }
+}
+
 bool BordersDetector::OperatorConvolution(Image& img, DetectorType detectorType, OperatorType operatorType)
 {
     switch (detectorType)
@@ -462,48 +676,48 @@ bool BordersDetector::NonConvSobelH(Image& img)
 // Non-convolutional horizontal Sobel operator
 bool BordersDetector::NonConvSobelH(const Image& srcImg, Image& dstImg)
 {
+    ACV_PROFILE_SCOPE_BYTES("BordersDetector::NonConvSobelH", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
     auto width = srcImg.GetWidth();
     auto height = srcImg.GetHeight();
 
-    Image::Byte* ptrInput = const_cast<Image::Byte*>(srcImg.GetRawPointer());
-    Image::Byte* ptrOutput = dstImg.GetRawPointer();
+    const SimdKernels& kernels = SimdKernels::Get();
 
     // 1st row loop
-    for (int colNum = 0; colNum < width; ++colNum, ++ptrInput, ++ptrOutput)
-        *ptrOutput = 0;
+    std::fill(dstImg.GetRawPointer(), dstImg.GetRawPointer() + width, 0);
 
-    // Main loop
-    for (int rowNum = 1; rowNum < height - 1; ++rowNum)
+    // Main loop (the rows are independent, so they are divided to bands)
+    Parallel::For(1, height - 1, [&](const int rowBegin, const int rowEnd)
     {
-         // 1-st element in row
-        int res = (*(ptrInput - width) << 1) + (*(ptrInput - width + 1) << 1) -
-                  (*(ptrInput + width) << 1) - (*(ptrInput + width + 1) << 1);
+        for (int rowNum = rowBegin; rowNum < rowEnd; ++rowNum)
+        {
+            const Image::Byte* ptrInput = srcImg.GetRawPointer(rowNum * width);
+            Image::Byte* ptrOutput = dstImg.GetRawPointer(rowNum * width);
 
-        Image::CheckPixelValue(res);
-        *ptrOutput++ = static_cast<Image::Byte>(res);
-        ++ptrInput;
+             // 1-st element in row
+            int res = (*(ptrInput - width) << 1) + (*(ptrInput - width + 1) << 1) -
+                      (*(ptrInput + width) << 1) - (*(ptrInput + width + 1) << 1);
 
-        for (int colNum = 1; colNum < width - 1; ++colNum, ++ptrInput, ++ptrOutput)
-        {
-            res = *(ptrInput - width - 1) + (*(ptrInput - width) << 1) + *(ptrInput - width + 1) -
-                  *(ptrInput + width - 1) - (*(ptrInput + width) << 1) - *(ptrInput + width + 1);
+            Image::CheckPixelValue(res);
+            *ptrOutput++ = static_cast<Image::Byte>(res);
+            ++ptrInput;
+
+            // Inner elements of row
+            kernels.SobelHRow(ptrInput - width, ptrInput + width, ptrOutput, width - 2);
+            ptrInput += width - 2;
+            ptrOutput += width - 2;
+
+            // last element in row
+            res = (*(ptrInput - width - 1) << 1) + (*(ptrInput - width) << 1) -
+                  (*(ptrInput + width - 1) << 1) - (*(ptrInput + width) << 1);
 
             Image::CheckPixelValue(res);
             *ptrOutput = static_cast<Image::Byte>(res);
         }
-
-        // last element in row
-        res = (*(ptrInput - width - 1) << 1) + (*(ptrInput - width) << 1) -
-              (*(ptrInput + width - 1) << 1) - (*(ptrInput + width) << 1);
-
-        Image::CheckPixelValue(res);
-        *ptrOutput++ = static_cast<Image::Byte>(res);
-         ++ptrInput;
-    }
+    }, 16);
 
     // last row loop
-    for (int colNum = 0; colNum < width; ++colNum, ++ptrInput, ++ptrOutput)
-        *ptrOutput = 0;
+    std::fill(dstImg.GetRawPointer((height - 1) * width), dstImg.GetRawPointer((height - 1) * width) + width, 0);
 
     return true;
 }
@@ -522,11 +736,14 @@ bool BordersDetector::NonConvSobelV(Image& img)
 // Non-convolutional vertical Sobel operator
 bool BordersDetector::NonConvSobelV(const Image& srcImg, Image& dstImg)
 {
+    ACV_PROFILE_SCOPE_BYTES("BordersDetector::NonConvSobelV", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
     auto width = srcImg.GetWidth();
     auto height = srcImg.GetHeight();
 
     Image::Byte* ptrInput = const_cast<Image::Byte*>(srcImg.GetRawPointer());
     Image::Byte* ptrOutput = dstImg.GetRawPointer();
+    const SimdKernels& kernels = SimdKernels::Get();
 
     // 1st row loop
     *ptrOutput++ = 0;
@@ -542,27 +759,27 @@ bool BordersDetector::NonConvSobelV(const Image& srcImg, Image& dstImg)
     *ptrOutput++ = 0;
      ++ptrInput;
 
-    // Main loop
-    for (int rowNum = 1; rowNum < height - 1; ++rowNum)
+    // Main loop (the rows are independent, so they are divided to bands)
+    Parallel::For(1, height - 1, [&](const int rowBegin, const int rowEnd)
     {
-         // 1-st element in row
-        *ptrOutput++= 0;
-        ++ptrInput;
-
-        for (int colNum = 1; colNum < width - 1; ++colNum, ++ptrInput, ++ptrOutput)
+        for (int rowNum = rowBegin; rowNum < rowEnd; ++rowNum)
         {
-            int res = *(ptrInput - width - 1)   - *(ptrInput - width + 1) +
-                      (*(ptrInput - 1) << 1) - (*(ptrInput + 1) << 1) +
-                      *(ptrInput + width - 1)  - *(ptrInput + width + 1);
+            const Image::Byte* ptrRowInput = srcImg.GetRawPointer(rowNum * width + 1);
+            Image::Byte* ptrRowOutput = dstImg.GetRawPointer(rowNum * width);
 
-            Image::CheckPixelValue(res);
-            *ptrOutput = static_cast<Image::Byte>(res);
+             // 1-st element in row
+            *ptrRowOutput++ = 0;
+
+            // Inner elements of row
+            kernels.SobelVRow(ptrRowInput - width, ptrRowInput, ptrRowInput + width, ptrRowOutput, width - 2);
+
+            // last element in row
+            ptrRowOutput[width - 2] = 0;
         }
+    }, 16);
 
-        // last element in row
-        *ptrOutput++ = 0;
-         ++ptrInput;
-    }
+    ptrInput += (height - 2) * width;
+    ptrOutput += (height - 2) * width;
 
     // last row loop
     *ptrOutput++ = 0;
@@ -585,6 +802,16 @@ bool BordersDetector::ConvScharr(Image& img, OperatorType type)
 {
     MatrixFilter<int> filter(3, 1);
 
+    if (!FormScharrFilter(type, filter))
+        return false;
+
+    return MatrixFilterOperations::FastConvolutionImage<int>(img, filter);
+}
+
+bool BordersDetector::FormScharrFilter(OperatorType type, MatrixFilter<int>& filter)
+{
+    filter.SetDivider(1);
+
     if (type == OperatorType::HORIZONTAL)
     {
         filter[0][0] =  3;  filter[0][1] =  10;  filter[0][2] =  3;
@@ -600,11 +827,13 @@ bool BordersDetector::ConvScharr(Image& img, OperatorType type)
     else
         return false;
 
-    return MatrixFilterOperations::FastConvolutionImage<int>(img, filter);
+    return true;
 }
 
 bool BordersDetector::ConvScharr(const Image& srcImg, Image& dstImg, BordersDetector::OperatorType type)
 {
+    ACV_PROFILE_SCOPE_BYTES("BordersDetector::ConvScharr", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
     memcpy(dstImg.GetRawPointer(), srcImg.GetRawPointer(), srcImg.GetHeight() * srcImg.GetWidth());
     bool ret = ConvScharr(dstImg, type);
     return ret;
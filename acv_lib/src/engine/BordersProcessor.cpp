@@ -0,0 +1,170 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods of class BordersProcessor
+
+#include "BordersProcessor.h"
+
+namespace acv {
+
+BordersProcessor::BordersProcessor()
+    : mIsConfigured(false),
+      mHeight(0),
+      mWidth(0),
+      mDetectorType(BordersDetector::DetectorType::SOBEL),
+      mThresholdMin(BordersDetector::DEFAULT_MIN_THRESHOLD),
+      mThresholdMax(BordersDetector::DEFAULT_MAX_THRESHOLD),
+      mHorizFilter(1),
+      mVertFilter(1)
+{
+}
+
+bool BordersProcessor::Configure(const int height, const int width, BordersDetector::DetectorType detectorType,
+                                 const Image::Byte thresholdMin/* = BordersDetector::DEFAULT_MIN_THRESHOLD*/,
+                                 const Image::Byte thresholdMax/* = BordersDetector::DEFAULT_MAX_THRESHOLD*/)
+{
+    mIsConfigured = false;
+
+    if (height < MIN_FRAME_SIZE || width < MIN_FRAME_SIZE)
+        return false;
+
+    // Only the buffers of current detector are kept
+    mExpandedImg = Image();
+    mBlurredImg = Image();
+    mGradients.clear();
+    mPixelGroup = std::vector<Point>();
+    mBilateralBuffers = ImageFilter::BilateralBuffers();
+
+    switch (detectorType)
+    {
+    case BordersDetector::DetectorType::SOBEL:
+        break;
+    case BordersDetector::DetectorType::SCHARR:
+        mHorizFilter = MatrixFilter<int>(3, 1);
+        mVertFilter = MatrixFilter<int>(3, 1);
+        BordersDetector::FormScharrFilter(BordersDetector::OperatorType::HORIZONTAL, mHorizFilter);
+        BordersDetector::FormScharrFilter(BordersDetector::OperatorType::VERTICAL, mVertFilter);
+        mExpandedImg = Image(height + 2, width + 2);
+        break;
+    case BordersDetector::DetectorType::CANNY:
+        mHorizFilter = MatrixFilter<int>(CANNY_BLUR_SIZE);
+        BordersDetector::FormCannyBlurFilter(mHorizFilter);
+        mExpandedImg = Image(height + CANNY_BLUR_SIZE - 1, width + CANNY_BLUR_SIZE - 1);
+        mBlurredImg = Image(height, width);
+        mGradients.assign(height, std::vector<BordersDetector::Gradient>(width));
+        mPixelGroup.reserve(height * width);
+        break;
+    case BordersDetector::DetectorType::CANNY_BILATERAL:
+        ImageFilter::PrepareBilateralBuffers(height, width, mBilateralBuffers);
+        mBlurredImg = Image(height, width);
+        mGradients.assign(height, std::vector<BordersDetector::Gradient>(width));
+        mPixelGroup.reserve(height * width);
+        break;
+    default:
+        return false;
+    }
+
+    mHorizImg = Image(height, width);
+    mVertImg = Image(height, width);
+
+    mHeight = height;
+    mWidth = width;
+    mDetectorType = detectorType;
+    mThresholdMin = thresholdMin;
+    mThresholdMax = thresholdMax;
+
+    // The tables of gradients are calculated once for all detectors, so they are prepared before the first frame
+    BordersDetector::GetGradientModulesTable();
+    if (detectorType == BordersDetector::DetectorType::CANNY || detectorType == BordersDetector::DetectorType::CANNY_BILATERAL)
+        BordersDetector::GetGradientsTable();
+
+    mIsConfigured = true;
+    return true;
+}
+
+bool BordersProcessor::Process(const Image& srcImg, Image& dstImg)
+{
+    if (!mIsConfigured || !HasFrameSizes(srcImg) || !HasFrameSizes(dstImg))
+        return false;
+
+    switch (mDetectorType)
+    {
+    case BordersDetector::DetectorType::SOBEL:
+        BordersDetector::NonConvSobelH(srcImg, mHorizImg);
+        BordersDetector::NonConvSobelV(srcImg, mVertImg);
+        BordersDetector::FormGradientModules(mHorizImg, mVertImg, dstImg);
+        break;
+    case BordersDetector::DetectorType::SCHARR:
+        srcImg.Resize(-1, -1, mWidth, mHeight, mExpandedImg);
+        MatrixFilterOperations::FastConvolutionExpandedImage(mExpandedImg, mHorizImg, mHorizFilter);
+        MatrixFilterOperations::FastConvolutionExpandedImage(mExpandedImg, mVertImg, mVertFilter);
+        BordersDetector::FormGradientModules(mHorizImg, mVertImg, dstImg);
+        break;
+    case BordersDetector::DetectorType::CANNY:
+    case BordersDetector::DetectorType::CANNY_BILATERAL:
+        Canny(srcImg, dstImg);
+        break;
+    }
+
+    return true;
+}
+
+bool BordersProcessor::Process(Image& img)
+{
+    return Process(img, img);
+}
+
+bool BordersProcessor::HasFrameSizes(const Image& img) const
+{
+    return img.GetHeight() == mHeight && img.GetWidth() == mWidth;
+}
+
+void BordersProcessor::Canny(const Image& srcImg, Image& dstImg)
+{
+    // Gaussian blur or bilateral blur (the source isn't changed, so bilateral filter doesn't copy it)
+    if (mDetectorType == BordersDetector::DetectorType::CANNY_BILATERAL)
+    {
+        ImageFilter::Bilateral(srcImg, mBlurredImg, BordersDetector::CANNY_BILATERAL_SPATIAL_SIGMA,
+                               BordersDetector::CANNY_BILATERAL_RANGE_SIGMA, mBilateralBuffers);
+    }
+    else
+    {
+        const int aperture = CANNY_BLUR_SIZE / 2;
+        srcImg.Resize(-aperture, -aperture, mWidth + aperture - 1, mHeight + aperture - 1, mExpandedImg);
+        MatrixFilterOperations::FastConvolutionExpandedImage(mExpandedImg, mBlurredImg, mHorizFilter);
+    }
+
+    // Calculation the gradients for each pixel
+    BordersDetector::NonConvSobelH(mBlurredImg, mHorizImg);
+    BordersDetector::NonConvSobelV(mBlurredImg, mVertImg);
+    BordersDetector::FormGradients(mHorizImg, mVertImg, mGradients);
+
+    // Maximum suppression, double threshold and tracing ambiguity area
+    BordersDetector::MaximumSuppression(mGradients);
+    BordersDetector::HysteresisThreshold(mGradients, mThresholdMin, mThresholdMax, mPixelGroup);
+
+    BordersDetector::WriteGradients(mGradients, dstImg);
+}
+
+}
@@ -0,0 +1,202 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of detection of instruction sets
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_FEATURES_GCC_X86
+#include <cpuid.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define CPU_FEATURES_MSVC_X86
+#include <intrin.h>
+#endif
+
+#include "CpuFeatures.h"
+
+namespace acv {
+
+// Instruction sets which are supported by processor and operating system
+struct DetectedFeatures
+{
+    bool hasSSE2;
+    bool hasAVX2;
+    bool hasAVX512;
+    bool hasAVX512VBMI;
+};
+
+#if defined(CPU_FEATURES_GCC_X86) || defined(CPU_FEATURES_MSVC_X86)
+
+// Get the registers eax, ebx, ecx, edx of cpuid with specified leaf and subleaf
+static void CpuId(const unsigned leaf, const unsigned subleaf, unsigned regs[4])
+{
+#ifdef CPU_FEATURES_GCC_X86
+    if (__get_cpuid_max(leaf & 0x80000000u, nullptr) < leaf)
+    {
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+        return;
+    }
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#else
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<unsigned>(info[i]);
+#endif
+}
+
+// Get the register XCR0 with the states which are saved by operating system
+static unsigned long long GetEnabledStates()
+{
+#ifdef CPU_FEATURES_GCC_X86
+    unsigned eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#else
+    return _xgetbv(0);
+#endif
+}
+
+static DetectedFeatures DetectFeatures()
+{
+    DetectedFeatures features = { false, false, false, false };
+
+    unsigned regs[4];
+    CpuId(0, 0, regs);
+    const unsigned maxLeaf = regs[0];
+
+    CpuId(1, 0, regs);
+    features.hasSSE2 = (regs[3] & (1u << 26)) != 0;
+
+    // AVX registers should be enabled by operating system (OSXSAVE and the states of XMM and YMM in XCR0)
+    const bool hasOsxSave = (regs[2] & (1u << 27)) != 0;
+    const bool hasAVX = (regs[2] & (1u << 28)) != 0;
+    if (!hasOsxSave || !hasAVX || maxLeaf < 7)
+        return features;
+
+    const unsigned long long states = GetEnabledStates();
+    const bool hasYmmStates = (states & 0x6) == 0x6;
+    const bool hasZmmStates = (states & 0xE6) == 0xE6; // XMM, YMM, opmask and both halves of ZMM
+
+    CpuId(7, 0, regs);
+    features.hasAVX2 = hasYmmStates && (regs[1] & (1u << 5)) != 0;
+    features.hasAVX512 = features.hasAVX2 && hasZmmStates &&
+                         (regs[1] & (1u << 16)) != 0 && // AVX512F
+                         (regs[1] & (1u << 30)) != 0; // AVX512BW
+    features.hasAVX512VBMI = features.hasAVX512 && (regs[2] & (1u << 1)) != 0;
+
+    return features;
+}
+
+#else
+
+static DetectedFeatures DetectFeatures()
+{
+    DetectedFeatures features = { false, false, false, false };
+    return features;
+}
+
+#endif
+
+static const DetectedFeatures& GetDetectedFeatures()
+{
+    static const DetectedFeatures features = DetectFeatures();
+    return features;
+}
+
+// Read the initial limit of instruction set from environment
+static CpuFeatures::InstructionSet ReadLimitFromEnvironment()
+{
+    const char* value = getenv("ACV_CPU_ISA");
+    if (value != nullptr)
+    {
+        const CpuFeatures::InstructionSet sets[] = { CpuFeatures::InstructionSet::SCALAR, CpuFeatures::InstructionSet::SSE2,
+                                                     CpuFeatures::InstructionSet::AVX2, CpuFeatures::InstructionSet::AVX512 };
+        for (auto set : sets)
+            if (strcmp(value, CpuFeatures::GetInstructionSetName(set)) == 0)
+                return set;
+    }
+
+    return CpuFeatures::InstructionSet::AVX512;
+}
+
+static std::atomic<int>& GetLimit()
+{
+    static std::atomic<int> limit(static_cast<int>(ReadLimitFromEnvironment()));
+    return limit;
+}
+
+CpuFeatures::InstructionSet CpuFeatures::GetBestInstructionSet()
+{
+    const DetectedFeatures& features = GetDetectedFeatures();
+
+    if (features.hasAVX512)
+        return InstructionSet::AVX512;
+    if (features.hasAVX2)
+        return InstructionSet::AVX2;
+    if (features.hasSSE2)
+        return InstructionSet::SSE2;
+
+    return InstructionSet::SCALAR;
+}
+
+CpuFeatures::InstructionSet CpuFeatures::GetInstructionSet()
+{
+    const int best = static_cast<int>(GetBestInstructionSet());
+    const int limit = GetLimit().load(std::memory_order_relaxed);
+
+    return static_cast<InstructionSet>(best < limit ? best : limit);
+}
+
+void CpuFeatures::SetInstructionSetLimit(const InstructionSet limit)
+{
+    GetLimit().store(static_cast<int>(limit));
+}
+
+bool CpuFeatures::HasAVX512VBMI()
+{
+    return GetDetectedFeatures().hasAVX512VBMI;
+}
+
+const char* CpuFeatures::GetInstructionSetName(const InstructionSet set)
+{
+    switch (set)
+    {
+    case InstructionSet::SCALAR:
+        return "scalar";
+    case InstructionSet::SSE2:
+        return "sse2";
+    case InstructionSet::AVX2:
+        return "avx2";
+    case InstructionSet::AVX512:
+        return "avx512";
+    }
+
+    return "unknown";
+}
+
+}
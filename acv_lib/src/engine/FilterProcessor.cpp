@@ -0,0 +1,234 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods of class FilterProcessor
+
+#include "FilterProcessor.h"
+
+#include <cstring>
+
+namespace acv {
+
+FilterProcessor::FilterProcessor()
+    : mIsConfigured(false),
+      mHeight(0),
+      mWidth(0),
+      mType(ImageFilter::FilterType::MEDIAN),
+      mFilterSize(0),
+      mAperture(0),
+      mMatrixFilter(1),
+      mSeparateDivider(1),
+      mIIRFilter(1.0f)
+{
+}
+
+FiltrationResult FilterProcessor::Configure(const int height, const int width, ImageFilter::FilterType type, const int filterSize/* = -1*/)
+{
+    mIsConfigured = false;
+
+    if (height <= 0 || width <= 0)
+        return FiltrationResult::INTERNAL_ERROR;
+
+    int aperture = 0;
+
+    switch (type)
+    {
+    case ImageFilter::FilterType::MEDIAN:
+    case ImageFilter::FilterType::GAUSSIAN:
+    case ImageFilter::FilterType::SEP_GAUSSIAN:
+        if (filterSize <= 0 || filterSize % 2 == 0) // The filter size should be odd
+            return FiltrationResult::INCORRECT_FILTER_SIZE;
+        aperture = filterSize / 2;
+        break;
+    case ImageFilter::FilterType::IIR_GAUSSIAN:
+    case ImageFilter::FilterType::BILATERAL:
+        if (filterSize / 6.0 < 1.0)
+            return FiltrationResult::SMALL_FILTER_SIZE;
+        break;
+    case ImageFilter::FilterType::UNSHARP_MASK:
+        if (filterSize / 2 < 1)
+            return FiltrationResult::SMALL_FILTER_SIZE;
+        break;
+    case ImageFilter::FilterType::SHARPEN:
+        aperture = 1;
+        break;
+    default:
+        return FiltrationResult::INCORRECT_FILTER_TYPE;
+    }
+
+    // The borders are mirrored, so the aperture should be smaller than the sizes of frame
+    // (separate filter mirrors the window about the filtered pixel, so the frame should contain two apertures)
+    const int minFrameSize = (type == ImageFilter::FilterType::SEP_GAUSSIAN) ? 2 * aperture : aperture + 1;
+    if (height < minFrameSize || width < minFrameSize)
+        return FiltrationResult::INCORRECT_FILTER_SIZE;
+
+    mHeight = height;
+    mWidth = width;
+    mType = type;
+    mFilterSize = filterSize;
+    mAperture = aperture;
+
+    // Only the buffers of current filter are kept
+    mExpandedImg = Image();
+    mTmpImg = Image();
+    mSeparateFilter.clear();
+    mBilateralBuffers = ImageFilter::BilateralBuffers();
+    mUnsharpMaskBuffers = ImageFilter::UnsharpMaskBuffers();
+
+    switch (type)
+    {
+    case ImageFilter::FilterType::MEDIAN:
+        mExpandedImg = Image(height + 2 * aperture, width + 2 * aperture);
+        break;
+    case ImageFilter::FilterType::GAUSSIAN:
+        mMatrixFilter = MatrixFilter<int>(filterSize);
+        ImageFilter::FormGaussianFilter(filterSize, mMatrixFilter);
+        mExpandedImg = Image(height + 2 * aperture, width + 2 * aperture);
+        break;
+    case ImageFilter::FilterType::SEP_GAUSSIAN:
+        ImageFilter::FormSeparateGaussianFilter(filterSize, mSeparateFilter, mSeparateDivider);
+        if (mSeparateDivider == 0) // Kernel of too small filter is rounded to zeros
+            return FiltrationResult::INCORRECT_FILTER_SIZE;
+        mTmpImg = Image(height, width);
+        break;
+    case ImageFilter::FilterType::IIR_GAUSSIAN:
+        mIIRFilter = ImageFilter::IIRfilter<float>(static_cast<float>(filterSize / 6.0));
+        break;
+    case ImageFilter::FilterType::SHARPEN:
+        mMatrixFilter = MatrixFilter<int>(3, 1);
+        ImageFilter::FormSharpenFilter(mMatrixFilter);
+        mExpandedImg = Image(height + 2 * aperture, width + 2 * aperture);
+        break;
+    case ImageFilter::FilterType::BILATERAL:
+        ImageFilter::PrepareBilateralBuffers(height, width, mBilateralBuffers);
+        mBilateralBuffers.srcCopy = Image(height, width);
+        break;
+    case ImageFilter::FilterType::UNSHARP_MASK:
+        ImageFilter::PrepareUnsharpMaskBuffers(height, width, filterSize / 2, mUnsharpMaskBuffers);
+        mUnsharpMaskBuffers.srcCopy = Image(height, width);
+        break;
+    }
+
+    mIsConfigured = true;
+    return FiltrationResult::SUCCESS;
+}
+
+FiltrationResult FilterProcessor::Process(const Image& srcImg, Image& dstImg)
+{
+    if (!mIsConfigured || !HasFrameSizes(srcImg) || !HasFrameSizes(dstImg))
+        return FiltrationResult::INTERNAL_ERROR;
+
+    const int aperture = mAperture;
+
+    switch (mType)
+    {
+    case ImageFilter::FilterType::MEDIAN:
+        srcImg.Resize(-aperture, -aperture, mWidth + aperture - 1, mHeight + aperture - 1, mExpandedImg);
+        Median(dstImg);
+        break;
+    case ImageFilter::FilterType::GAUSSIAN:
+    case ImageFilter::FilterType::SHARPEN:
+        srcImg.Resize(-aperture, -aperture, mWidth + aperture - 1, mHeight + aperture - 1, mExpandedImg);
+        MatrixFilterOperations::FastConvolutionExpandedImage(mExpandedImg, dstImg, mMatrixFilter);
+        break;
+    case ImageFilter::FilterType::SEP_GAUSSIAN:
+        ImageFilter::SeparateGaussianPasses(srcImg, mTmpImg, dstImg, mSeparateFilter, mSeparateDivider);
+        break;
+    case ImageFilter::FilterType::IIR_GAUSSIAN:
+        if (&srcImg != &dstImg)
+            memcpy(dstImg.GetRawPointer(), srcImg.GetRawPointer(), mHeight * mWidth);
+        ImageFilter::GaussianIIRPasses(dstImg, mIIRFilter);
+        break;
+    case ImageFilter::FilterType::BILATERAL:
+        return ImageFilter::Bilateral(srcImg, dstImg, static_cast<float>(mFilterSize / 6.0),
+                                      ImageFilter::DEFAULT_BILATERAL_RANGE_SIGMA, mBilateralBuffers);
+    case ImageFilter::FilterType::UNSHARP_MASK:
+        return ImageFilter::UnsharpMask(srcImg, dstImg, mFilterSize / 2, ImageFilter::DEFAULT_UNSHARP_AMOUNT,
+                                        ImageFilter::DEFAULT_UNSHARP_THRESHOLD, mUnsharpMaskBuffers);
+    }
+
+    return FiltrationResult::SUCCESS;
+}
+
+FiltrationResult FilterProcessor::Process(Image& img)
+{
+    return Process(img, img);
+}
+
+bool FilterProcessor::HasFrameSizes(const Image& img) const
+{
+    return img.GetHeight() == mHeight && img.GetWidth() == mWidth;
+}
+
+void FilterProcessor::Median(Image& dstImg)
+{
+    const int expandedWidth = mExpandedImg.GetWidth();
+    const int MEDIAN = mFilterSize * mFilterSize / 2; // Median index (the index of element that will be a new value)
+
+    Image::Byte* pDst = dstImg.GetRawPointer();
+
+    for (int row = 0; row < mHeight; ++row)
+    {
+        const Image::Byte* pWindow = mExpandedImg.GetRawPointer(row * expandedWidth);
+
+        // Histogram of the first window of row
+        memset(mHistogram, 0, sizeof(mHistogram));
+        for (int relRow = 0; relRow < mFilterSize; ++relRow)
+            for (int relCol = 0; relCol < mFilterSize; ++relCol)
+                ++mHistogram[pWindow[relRow * expandedWidth + relCol]];
+
+        // The median is the smallest value for which the number of not greater values is more than MEDIAN
+        int median = 0, numLess = 0;
+        while (numLess + mHistogram[median] <= MEDIAN)
+            numLess += mHistogram[median++];
+
+        *pDst++ = static_cast<Image::Byte>(median);
+
+        for (int col = 1; col < mWidth; ++col, ++pWindow)
+        {
+            // Move the window: remove the left column and add the right column
+            const Image::Byte* pOut = pWindow;
+            const Image::Byte* pIn = pWindow + mFilterSize;
+            for (int relRow = 0; relRow < mFilterSize; ++relRow, pOut += expandedWidth, pIn += expandedWidth)
+            {
+                --mHistogram[*pOut];
+                if (*pOut < median)
+                    --numLess;
+
+                ++mHistogram[*pIn];
+                if (*pIn < median)
+                    ++numLess;
+            }
+
+            while (numLess > MEDIAN)
+                numLess -= mHistogram[--median];
+            while (numLess + mHistogram[median] <= MEDIAN)
+                numLess += mHistogram[median++];
+
+            *pDst++ = static_cast<Image::Byte>(median);
+        }
+    }
+}
+
+}
@@ -0,0 +1,244 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of brightness histogram of image
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#include "Histogram.h"
+#include "Parallel.h"
+#include "Profiler.h"
+
+namespace acv {
+
+namespace {
+
+// Minimum number of pixels in one stripe of parallel counting
+const long long MIN_PIXELS_PER_STRIPE = 1 << 16;
+
+// Interleaved banks of counters. The 32-bit counters can't overflow because the number of pixels of image is int
+typedef std::array<std::array<uint32_t, Histogram::NUM_BINS>, Histogram::NUM_BANKS> Banks;
+
+// Count the run of pixels into banks. Eight pixels are loaded at once and the neighbour pixels
+// are counted to different banks, so the increments of the same bin are independent
+void CountRun(const Image::Byte* pPix, const size_t size, Banks& banks)
+{
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t pix;
+        std::memcpy(&pix, pPix + i, sizeof(pix));
+
+        ++banks[0][pix & 0xFF];
+        ++banks[1][(pix >> 8) & 0xFF];
+        ++banks[2][(pix >> 16) & 0xFF];
+        ++banks[3][(pix >> 24) & 0xFF];
+        ++banks[0][(pix >> 32) & 0xFF];
+        ++banks[1][(pix >> 40) & 0xFF];
+        ++banks[2][(pix >> 48) & 0xFF];
+        ++banks[3][pix >> 56];
+    }
+
+    for (; i < size; ++i)
+        ++banks[i % Histogram::NUM_BANKS][pPix[i]];
+}
+
+// Count the run of pixels for which the pixel of mask is not zero (without branches on mask)
+void CountMaskedRun(const Image::Byte* pPix, const Image::Byte* pMask, const size_t size, Banks& banks)
+{
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        banks[0][pPix[i]] += pMask[i] != 0;
+        banks[1][pPix[i + 1]] += pMask[i + 1] != 0;
+        banks[2][pPix[i + 2]] += pMask[i + 2] != 0;
+        banks[3][pPix[i + 3]] += pMask[i + 3] != 0;
+    }
+
+    for (; i < size; ++i)
+        banks[i % Histogram::NUM_BANKS][pPix[i]] += pMask[i] != 0;
+}
+
+}
+
+Histogram::Histogram()
+    : mBins(),
+      mTotal(0)
+{
+}
+
+Histogram::Histogram(const Image& img)
+    : Histogram()
+{
+    Add(img);
+}
+
+Histogram& Histogram::operator += (const Histogram& other)
+{
+    for (int i = 0; i < NUM_BINS; ++i)
+        mBins[i] += other.mBins[i];
+    mTotal += other.mTotal;
+
+    return *this;
+}
+
+bool Histogram::Add(const Image& img)
+{
+    if (!img.IsInitialized())
+        return false;
+
+    AddRegion(img, { 0, 0, img.GetWidth() - 1, img.GetHeight() - 1 }, nullptr);
+    return true;
+}
+
+bool Histogram::Add(const Image& img, const Roi& roi)
+{
+    if (!IsValidRoi(img, roi))
+        return false;
+
+    AddRegion(img, roi, nullptr);
+    return true;
+}
+
+bool Histogram::Add(const Image& img, const Image& mask)
+{
+    if (!img.IsInitialized())
+        return false;
+
+    return Add(img, { 0, 0, img.GetWidth() - 1, img.GetHeight() - 1 }, mask);
+}
+
+bool Histogram::Add(const Image& img, const Roi& roi, const Image& mask)
+{
+    if (!IsValidRoi(img, roi) || mask.GetWidth() != img.GetWidth() || mask.GetHeight() != img.GetHeight())
+        return false;
+
+    AddRegion(img, roi, &mask);
+    return true;
+}
+
+void Histogram::Clear()
+{
+    mBins.fill(0);
+    mTotal = 0;
+}
+
+size_t Histogram::GetNumLevels() const
+{
+    return static_cast<size_t>(std::count_if(mBins.begin(), mBins.end(), [](const size_t count) { return count > 0; }));
+}
+
+bool Histogram::GetMinMax(Image::Byte& minBrig, Image::Byte& maxBrig) const
+{
+    if (mTotal == 0)
+        return false;
+
+    int minVal = 0;
+    while (mBins[minVal] == 0)
+        ++minVal;
+
+    int maxVal = NUM_BINS - 1;
+    while (mBins[maxVal] == 0)
+        --maxVal;
+
+    minBrig = static_cast<Image::Byte>(minVal);
+    maxBrig = static_cast<Image::Byte>(maxVal);
+
+    return true;
+}
+
+bool Histogram::IsValidRoi(const Image& img, const Roi& roi)
+{
+    return img.IsInitialized() &&
+           roi.xStart >= 0 && roi.xStart <= roi.xEnd && roi.xEnd < img.GetWidth() &&
+           roi.yStart >= 0 && roi.yStart <= roi.yEnd && roi.yEnd < img.GetHeight();
+}
+
+void Histogram::AddRegion(const Image& img, const Roi& roi, const Image* mask)
+{
+    const int width = img.GetWidth();
+    const int roiWidth = roi.xEnd - roi.xStart + 1;
+    const int roiHeight = roi.yEnd - roi.yStart + 1;
+    const long long numPixels = static_cast<long long>(roiWidth) * roiHeight;
+
+    ACV_PROFILE_SCOPE_BYTES("Histogram::Add", numPixels);
+
+    // The rows of region are contiguous in memory if region has the full width of image
+    const bool isContiguous = roiWidth == width;
+
+    // Each stripe of rows has own banks, they are summed after the pass
+    const long long maxStripes = std::max(numPixels / MIN_PIXELS_PER_STRIPE, 1LL);
+    const int numStripes = static_cast<int>(std::min<long long>(std::min(Parallel::GetNumThreads(), roiHeight), maxStripes));
+    std::vector<Banks> stripeBanks(numStripes);
+
+    Parallel::For(0, numStripes, [&](const int begin, const int end)
+    {
+        for (int stripe = begin; stripe < end; ++stripe)
+        {
+            Banks& banks = stripeBanks[stripe];
+            for (auto& bank : banks)
+                bank.fill(0);
+
+            const int rowBegin = roi.yStart + static_cast<int>(static_cast<long long>(roiHeight) * stripe / numStripes);
+            const int rowEnd = roi.yStart + static_cast<int>(static_cast<long long>(roiHeight) * (stripe + 1) / numStripes);
+
+            if (isContiguous)
+            {
+                const int offset = rowBegin * width;
+                const size_t size = static_cast<size_t>(rowEnd - rowBegin) * width;
+                if (mask)
+                    CountMaskedRun(img.GetRawPointer(offset), mask->GetRawPointer(offset), size, banks);
+                else
+                    CountRun(img.GetRawPointer(offset), size, banks);
+                continue;
+            }
+
+            for (int row = rowBegin; row < rowEnd; ++row)
+            {
+                const int offset = row * width + roi.xStart;
+                if (mask)
+                    CountMaskedRun(img.GetRawPointer(offset), mask->GetRawPointer(offset), roiWidth, banks);
+                else
+                    CountRun(img.GetRawPointer(offset), roiWidth, banks);
+            }
+        }
+    });
+
+    for (const auto& banks : stripeBanks)
+    {
+        for (const auto& bank : banks)
+        {
+            for (int i = 0; i < NUM_BINS; ++i)
+            {
+                mBins[i] += bank[i];
+                mTotal += bank[i];
+            }
+        }
+    }
+}
+
+}
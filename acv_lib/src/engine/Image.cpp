@@ -25,8 +25,17 @@
 // This file contains implementations of image class methods
 
 #include <cstring>
+#include <vector>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_USE_SSE2
+#include <emmintrin.h>
+#endif
 
 #include "Image.h"
+#include "Profiler.h"
+#include "SimdKernels.h"
 
 namespace acv {
 
@@ -43,6 +52,9 @@ Image::Image(const int height, const int width)
       mWidth(width),
       mHeight(height)
 {
+    // Events of counter are the allocations, its total is the allocated bytes
+    ACV_PROFILE_COUNT("Image::Allocation", static_cast<long long>(height) * width * sizeof(Byte));
+
     CalcAuxParameters();
 }
 
@@ -79,9 +91,17 @@ Image Image::Resize(const int xMin, const int yMin, const int xMax, const int yM
     if (xMin >= xMax || yMin >= yMax)
         return Image();
 
-    int newWidth = xMax - xMin + 1;
-    int newHeight = yMax - yMin + 1;
-    Image newImg(newHeight, newWidth);
+    Image newImg(yMax - yMin + 1, xMax - xMin + 1);
+    Resize(xMin, yMin, xMax, yMax, newImg);
+
+    return newImg;
+}
+
+bool Image::Resize(const int xMin, const int yMin, const int xMax, const int yMax, Image& newImg) const
+{
+    if (xMin >= xMax || yMin >= yMax || newImg.GetWidth() != xMax - xMin + 1 || newImg.GetHeight() != yMax - yMin + 1)
+        return false;
+
     Byte* pDst = &newImg.mPixels[0];
 
     int row, col;
@@ -144,22 +164,44 @@ Image Image::Resize(const int xMin, const int yMin, const int xMax, const int yM
         }
     }
 
-    return newImg;
+    return true;
 }
 
 Image Image::operator - (const Image &rhs) const
 {
-    Matrix::const_iterator it1, it2;
-    Matrix::iterator itDst;
     Image resImg(rhs.GetHeight(), rhs.GetWidth());
-    for (it1 = this->GetData().cbegin(), it2 = rhs.GetData().cbegin(), itDst = resImg.GetData().begin();
-         it1 != this->GetData().cend();
-         ++it1, ++it2, ++itDst)
+    AbsDiff(*this, rhs, resImg);
+
+    return resImg;
+}
+
+bool Image::AbsDiff(const Image& lhs, const Image& rhs, Image& dstImg)
+{
+    if (lhs.mWidth != rhs.mWidth || lhs.mHeight != rhs.mHeight ||
+        lhs.mWidth != dstImg.mWidth || lhs.mHeight != dstImg.mHeight)
+        return false;
+
+    const Byte* pLhs = lhs.mPixels.data();
+    const Byte* pRhs = rhs.mPixels.data();
+    Byte* pDst = dstImg.mPixels.data();
+    const size_t numPixels = lhs.mPixels.size();
+
+    size_t i = 0;
+
+#ifdef IMAGE_USE_SSE2
+    // |a - b| = (a -sat b) | (b -sat a)
+    for ( ; i + 16 <= numPixels; i += 16)
     {
-        Byte brightnessOfPixel = (*it1 >= *it2) ? (*it1 - *it2) : (*it2 - *it1);
-        *itDst = brightnessOfPixel;
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLhs + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRhs + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a)));
     }
-    return resImg;
+#endif
+
+    for ( ; i < numPixels; ++i)
+        pDst[i] = (pLhs[i] >= pRhs[i]) ? (pLhs[i] - pRhs[i]) : (pRhs[i] - pLhs[i]);
+
+    return true;
 }
 
 bool Image::operator == (const Image& rhs) const
@@ -284,19 +326,28 @@ Image Image::AverageDownscale(const short kScaleX, const short kScaleY) const
 {
     Image img(GetHeight() / kScaleY, GetWidth() / kScaleX);
 
-    int kXY = kScaleX * kScaleY;
+    const int kXY = kScaleX * kScaleY;
+    const int newWidth = img.GetWidth();
+    const SimdKernels& kernels = SimdKernels::Get();
 
+    // The rows of each block are summed by vectorized kernel, then the sums of columns are summed inside of blocks
+    std::vector<uint32_t> sums(newWidth * kScaleX);
     for (int newRow = 0; newRow < img.GetHeight(); ++newRow)
-        for (int newCol = 0; newCol < img.GetWidth(); ++newCol)
-        {
-            int newVal = 0;
+    {
+        std::fill(sums.begin(), sums.end(), 0);
+        for (int shiftRow = 0, row = newRow * kScaleY; shiftRow < kScaleY; ++shiftRow, ++row)
+            kernels.AccumulateRow(GetRawPointer(row * mWidth), sums.data(), newWidth * kScaleX);
 
-            for (int shiftRow = 0, row = newRow * kScaleY; shiftRow < kScaleY; ++shiftRow, ++row)
-                 for (int shiftCol = 0, col = newCol * kScaleX; shiftCol < kScaleX; ++shiftCol, ++col)
-                     newVal += GetPixel(row, col);
+        Byte* pDst = img.GetRawPointer(newRow * newWidth);
+        for (int newCol = 0, col = 0; newCol < newWidth; ++newCol)
+        {
+            uint32_t newVal = 0;
+            for (int shiftCol = 0; shiftCol < kScaleX; ++shiftCol, ++col)
+                newVal += sums[col];
 
-            img.SetPixel(newRow, newCol, static_cast<Byte>(newVal / kXY));
+            pDst[newCol] = static_cast<Byte>(newVal / kXY);
         }
+    }
 
     return img;
 }
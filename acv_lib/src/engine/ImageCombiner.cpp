@@ -26,12 +26,17 @@
 
 #include <vector>
 #include <cstring>
+#include <cmath>
 #include <algorithm>
 
 #include "ImageParametersCalculator.h"
 #include "ImageCombiner.h"
 #include "Image.h"
 #include "Point.h"
+#include "Histogram.h"
+#include "Progress.h"
+#include "Profiler.h"
+#include "SimdKernels.h"
 
 namespace acv {
 
@@ -99,22 +104,25 @@ Image ImageCombiner::Combine(CombineType combineType, CombinationResult& combRes
     }
 }
 
-CombinationResult ImageCombiner::Combine(CombineType combineType, Image& combImg, const bool needSort/* = true*/)
+CombinationResult ImageCombiner::Combine(CombineType combineType, Image& combImg, const bool needSort/* = true*/,
+                                         Progress* progress/* = nullptr*/)
 {
+    ACV_PROFILE_SCOPE("ImageCombiner::Combine");
+
     CombinationResult combRes = CombinationResult::INCORRECT_COMBINER_TYPE;
 
     switch (combineType)
     {
     case ImageCombiner::CombineType::INFORM_PRIORITY:
-        return InformativePriority(combImg, needSort);
+        return InformativePriority(combImg, needSort, progress);
     case ImageCombiner::CombineType::MORPHOLOGICAL:
-        return Morphological(DEFAULT_NUM_MODS, combImg, needSort);
+        return Morphological(DEFAULT_NUM_MODS, combImg, needSort, progress);
     case ImageCombiner::CombineType::LOCAL_ENTROPY:
-        return LocalEntropy(combImg);
+        return LocalEntropy(combImg, progress);
     case ImageCombiner::CombineType::DIFFERENCES_ADDING:
-        return DifferencesAdding(combImg, needSort);
+        return DifferencesAdding(combImg, needSort, progress);
     case ImageCombiner::CombineType::CALC_DIFF:
-        return CalcDiff(combImg);
+        return CalcDiff(combImg, progress);
 
     }
 
@@ -129,7 +137,8 @@ Image ImageCombiner::InformativePriority(CombinationResult& combRes, const bool
     return (combRes == CombinationResult::SUCCESS) ? combImg : Image();
 }
 
-CombinationResult ImageCombiner::InformativePriority(Image& combImg, const bool needSort/* = true*/)
+CombinationResult ImageCombiner::InformativePriority(Image& combImg, const bool needSort/* = true*/,
+                                                     Progress* progress/* = nullptr*/)
 {
     CombinationResult combRes;
 
@@ -144,6 +153,9 @@ CombinationResult ImageCombiner::InformativePriority(Image& combImg, const bool
         // Basic image. To this image will be projected other images
         memcpy(combImg.GetRawPointer(), sortedImages[0]->GetRawPointer(), sortedImages[0]->GetHeight() * sortedImages[0]->GetWidth());
 
+        // Each projected image is the step of progress
+        Progress::Begin(progress, static_cast<int>(sortedImages.size()) - 1);
+
         // Projection images to basic image
         for (size_t i = 1; i < sortedImages.size(); ++i)
         {
@@ -172,6 +184,9 @@ CombinationResult ImageCombiner::InformativePriority(Image& combImg, const bool
 
                 *baseIt++ = px;
             }
+
+            if (!Progress::Step(progress))
+                return CombinationResult::CANCELLED;
         }
 
         combRes = CombinationResult::SUCCESS;
@@ -188,7 +203,8 @@ Image ImageCombiner::Morphological(const size_t numMods, CombinationResult& comb
     return (combRes == CombinationResult::SUCCESS) ? combImg : Image();
 }
 
-CombinationResult ImageCombiner::Morphological(const size_t numMods, Image& combImg, const bool needSort/* = true*/)
+CombinationResult ImageCombiner::Morphological(const size_t numMods, Image& combImg, const bool needSort/* = true*/,
+                                               Progress* progress/* = nullptr*/)
 {
     CombinationResult combRes;
 
@@ -202,16 +218,27 @@ CombinationResult ImageCombiner::Morphological(const size_t numMods, Image& comb
 
         memcpy(combImg.GetRawPointer(), sortedImages[0]->GetRawPointer(), sortedImages[0]->GetHeight() * sortedImages[0]->GetWidth());
 
-        std::vector<AMorphologicalForm> forms = CalcForms(combImg, numMods);
+        // The steps of progress are the rows of search of forms for each mod,
+        // the projection of each image and the merging are counted as the rows of image
+        const int height = combImg.GetHeight();
+        Progress::Begin(progress, static_cast<int>(numMods + sortedImages.size()) * height);
+
+        std::vector<AMorphologicalForm> forms = CalcForms(combImg, numMods, progress);
+        if (Progress::Cancelled(progress))
+            return CombinationResult::CANCELLED;
 
         std::vector<Image> projections(sortedImages.size() - 1, Image(combImg.GetHeight(), combImg.GetWidth()));
         for (size_t imgIdx = 1; imgIdx < sortedImages.size(); ++imgIdx) // First image is basic
         {
             Image& projection = projections[imgIdx - 1];
             CalcProjectionToForms(forms, *sortedImages[imgIdx], projection);
+
+            if (!Progress::Step(progress, height))
+                return CombinationResult::CANCELLED;
         }
 
         MergeImages(combImg, projections);
+        Progress::Step(progress, height);
 
         combRes = CombinationResult::SUCCESS;
     }
@@ -227,8 +254,10 @@ Image ImageCombiner::LocalEntropy(CombinationResult& combRes)
     return (combRes == CombinationResult::SUCCESS) ? combImg : Image();
 }
 
-CombinationResult ImageCombiner::LocalEntropy(Image& combImg)
+CombinationResult ImageCombiner::LocalEntropy(Image& combImg, Progress* progress/* = nullptr*/)
 {
+    ACV_PROFILE_SCOPE("ImageCombiner::LocalEntropy");
+
     const int APERTURE = 2;
 
     CombinationResult combRes;
@@ -239,6 +268,8 @@ CombinationResult ImageCombiner::LocalEntropy(Image& combImg)
 
     if (CanCombine(combRes))
     {
+        Progress::Begin(progress, combImg.GetHeight());
+
         for (int row = 0; row < combImg.GetHeight(); ++row)
         {
             for (int col = 0; col < combImg.GetWidth(); ++col)
@@ -258,6 +289,9 @@ CombinationResult ImageCombiner::LocalEntropy(Image& combImg)
 
                 combImg(row, col) = mCombinedImages[iMax]->GetPixel(row, col);
             }
+
+            if (!Progress::Step(progress))
+                return CombinationResult::CANCELLED;
         }
 
         combRes = CombinationResult::SUCCESS;
@@ -274,7 +308,8 @@ Image ImageCombiner::DifferencesAdding(CombinationResult& combRes, const bool ne
     return (combRes == CombinationResult::SUCCESS) ? combImg : Image();
 }
 
-CombinationResult ImageCombiner::DifferencesAdding(Image& combImg, const bool needSort/* = true*/)
+CombinationResult ImageCombiner::DifferencesAdding(Image& combImg, const bool needSort/* = true*/,
+                                                   Progress* progress/* = nullptr*/)
 {
     CombinationResult combRes;
 
@@ -288,6 +323,9 @@ CombinationResult ImageCombiner::DifferencesAdding(Image& combImg, const bool ne
 
         memcpy(combImg.GetRawPointer(), sortedImages[0]->GetRawPointer(), sortedImages[0]->GetHeight() * sortedImages[0]->GetWidth());
 
+        // Each projected image is the step of progress
+        Progress::Begin(progress, static_cast<int>(sortedImages.size()) - 1);
+
         // Projection images to basic image
         for (size_t i = 1; i < sortedImages.size(); ++i)
         {
@@ -326,6 +364,9 @@ CombinationResult ImageCombiner::DifferencesAdding(Image& combImg, const bool ne
                 if (D > b1)
                     *it1 = (D >= b2) ? *it2 : *it1 + (b1 - D) * (*it1 - *it2) / db;
             }
+
+            if (!Progress::Step(progress))
+                return CombinationResult::CANCELLED;
         }
 
         combRes = CombinationResult::SUCCESS;
@@ -342,7 +383,7 @@ Image ImageCombiner::CalcDiff(CombinationResult &combRes)
     return (combRes == CombinationResult::SUCCESS) ? combImg : Image();
 }
 
-CombinationResult ImageCombiner::CalcDiff(Image& combImg)
+CombinationResult ImageCombiner::CalcDiff(Image& combImg, Progress* progress/* = nullptr*/)
 {
     CombinationResult combRes;
 
@@ -351,8 +392,13 @@ CombinationResult ImageCombiner::CalcDiff(Image& combImg)
 
     if (CanCombine(combRes))
     {
-        combImg = (*mCombinedImages[0] - *mCombinedImages[1]);
-        combRes = CombinationResult::SUCCESS;
+        // The difference is not divided, so it is the single step of progress
+        Progress::Begin(progress, 1);
+
+        // The existing pixels of resulting image are reused if it has the sizes of combined images
+        if (!Image::AbsDiff(*mCombinedImages[0], *mCombinedImages[1], combImg))
+            combImg = (*mCombinedImages[0] - *mCombinedImages[1]);
+        combRes = Progress::Step(progress) ? CombinationResult::SUCCESS : CombinationResult::CANCELLED;
     }
 
     return combRes;
@@ -385,6 +431,8 @@ bool ImageCombiner::CanCombine(CombinationResult& combRes) const
 
 void ImageCombiner::FormSortedImagesArray(std::vector<const Image*>& sortedVec)
 {
+    ACV_PROFILE_SCOPE("ImageCombiner::SortImages");
+
     // Image and his entropy
     struct SImageAndEntropy
     {
@@ -415,6 +463,8 @@ void ImageCombiner::FormSortedImagesArray(std::vector<const Image*>& sortedVec)
 
 void ImageCombiner::MergeImages(Image& baseImg, const std::vector<Image>& projections)
 {
+    ACV_PROFILE_SCOPE("ImageCombiner::MergeImages");
+
     std::vector<Image::Matrix::const_iterator> projectionsIts(projections.size());
     for (size_t i = 0; i < projections.size(); ++i)
         projectionsIts[i] = projections[i].GetData().begin();
@@ -434,10 +484,12 @@ void ImageCombiner::MergeImages(Image& baseImg, const std::vector<Image>& projec
     }
 }
 
-std::vector<AMorphologicalForm> ImageCombiner::CalcForms(const Image& baseImg, const int numMods)
+std::vector<AMorphologicalForm> ImageCombiner::CalcForms(const Image& baseImg, const int numMods, Progress* progress/* = nullptr*/)
 {
+    ACV_PROFILE_SCOPE("ImageCombiner::CalcForms");
+
     Image histogramm = Segmentation(baseImg, numMods);
-    std::vector<AMorphologicalForm> forms = FindForms(histogramm, numMods);
+    std::vector<AMorphologicalForm> forms = FindForms(histogramm, numMods, progress);
     return forms;
 }
 
@@ -450,14 +502,17 @@ Image ImageCombiner::Segmentation(const Image& baseImg, const int numMods)
     while (static_cast<Image::Byte>(Image::MAX_PIXEL_VALUE / dBrig) >= numMods)
         ++dBrig;
 
-    Image::Byte* pDstPix = histSeg.GetRawPointer();
-    for (auto srcPix : baseImg.GetData())
-        *pDstPix++ = static_cast<Image::Byte>(srcPix / dBrig);
+    // Number of mod of each brightness value
+    Image::Byte modTable[Histogram::NUM_BINS];
+    for (int i = 0; i < Histogram::NUM_BINS; ++i)
+        modTable[i] = static_cast<Image::Byte>(i / dBrig);
+
+    SimdKernels::Get().ApplyLookUpTable(baseImg.GetRawPointer(), histSeg.GetRawPointer(), baseImg.GetData().size(), modTable);
 
     return histSeg;
 }
 
-std::vector<AMorphologicalForm> ImageCombiner::FindForms(const Image& histogramm, const int numMods)
+std::vector<AMorphologicalForm> ImageCombiner::FindForms(const Image& histogramm, const int numMods, Progress* progress/* = nullptr*/)
 {
     std::vector<AMorphologicalForm> forms;
 
@@ -480,8 +535,18 @@ std::vector<AMorphologicalForm> ImageCombiner::FindForms(const Image& histogramm
         }
     };
 
+    // The image is scanned only for the mods which have pixels
+    const Histogram modsHistogram(histogramm);
+
     for (int mod = 0; mod < numMods; ++mod)
     {
+        if (mod >= Histogram::NUM_BINS || modsHistogram[static_cast<Image::Byte>(mod)] == 0)
+        {
+            if (!Progress::Step(progress, histogramm.GetHeight()))
+                return std::vector<AMorphologicalForm>();
+            continue;
+        }
+
         std::vector<RowElement> prevStr, curStr;
 
         auto histPixIt = histogramm.GetData().begin();
@@ -577,6 +642,9 @@ std::vector<AMorphologicalForm> ImageCombiner::FindForms(const Image& histogramm
             }
 
             prevStr = curStr;
+
+            if (!Progress::Step(progress))
+                return std::vector<AMorphologicalForm>();
         }
     }
 
@@ -594,6 +662,8 @@ std::vector<AMorphologicalForm> ImageCombiner::FindForms(const Image& histogramm
 
 void ImageCombiner::CalcProjectionToForms(const std::vector<AMorphologicalForm>& morphForm, const Image& projImg, Image& projection)
 {
+    ACV_PROFILE_SCOPE_BYTES("ImageCombiner::CalcProjectionToForms", static_cast<long long>(projImg.GetHeight()) * projImg.GetWidth());
+
     for (size_t i = 0; i < morphForm.size(); ++i)
     {
         const auto& form = morphForm[i];
@@ -27,81 +27,170 @@
 #include <vector>
 #include <cmath>
 #include <cstring>
+#include <algorithm>
 
 #include "ImageParametersCalculator.h"
 #include "ImageCorrector.h"
 #include "ImageFilter.h"
+#include "MultiChannelImage.h"
+#include "Histogram.h"
+#include "Parallel.h"
+#include "Progress.h"
+#include "Profiler.h"
+#include "SimdKernels.h"
 
 namespace acv {
 
-bool ImageCorrector::Correct(const Image& srcImg, Image& dstImg, CorrectorType corType)
+// Replace the pixels of source image by the look-up table, the bands of rows are processed in parallel
+static void ApplyLookUpTable(const Image& srcImg, const ImageCorrector::LookUpTable& table, Image& dstImg)
 {
+    const SimdKernels& kernels = SimdKernels::Get();
+    const int width = srcImg.GetWidth();
+    Parallel::For(0, srcImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
+    {
+        kernels.ApplyLookUpTable(srcImg.GetRawPointer(rowBegin * width), dstImg.GetRawPointer(rowBegin * width),
+                                 static_cast<size_t>(rowEnd - rowBegin) * width, table.data());
+    }, 64);
+}
+
+// Copy the pixels of source image, the bands of rows are copied in parallel
+static void CopyPixels(const Image& srcImg, Image& dstImg)
+{
+    const int width = srcImg.GetWidth();
+    Parallel::For(0, srcImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
+    {
+        memcpy(dstImg.GetRawPointer(rowBegin * width), srcImg.GetRawPointer(rowBegin * width),
+               static_cast<size_t>(rowEnd - rowBegin) * width);
+    }, 64);
+}
+
+bool ImageCorrector::Correct(Image& img, CorrectorType corType, Progress* progress /*= nullptr*/)
+{
+    Image tmpImg(img.GetHeight(), img.GetWidth());
+
+    bool ret = Correct(img, tmpImg, corType, progress);
+    if (ret)
+        img = std::move(tmpImg);
+
+    return ret;
+}
+
+bool ImageCorrector::Correct(const Image& srcImg, Image& dstImg, CorrectorType corType, Progress* progress /*= nullptr*/)
+{
+    // The progress of SSR is reported by its blur, other methods are the single pass over image
+    if (corType != CorrectorType::SSRETINEX)
+        Progress::Begin(progress, 1);
+
     switch (corType)
     {
     case CorrectorType::SSRETINEX:
-        return SingleScaleRetinex(srcImg, dstImg);
+        return SingleScaleRetinex(srcImg, dstImg, progress);
     case CorrectorType::AUTO_LEVELS:
-        return AutoLevels(srcImg, dstImg);
+        return AutoLevels(srcImg, dstImg) && Progress::Step(progress);
     case CorrectorType::NORM_AUTO_LEVELS:
-        return NormAutoLevels(srcImg, dstImg);
+        return NormAutoLevels(srcImg, dstImg) && Progress::Step(progress);
     case CorrectorType::GAMMA:
-        return GammaCorrection(srcImg, dstImg);
+        return GammaCorrection(srcImg, dstImg) && Progress::Step(progress);
+    case CorrectorType::GLOBAL_EQUALIZATION:
+        return GlobalEqualization(srcImg, dstImg) && Progress::Step(progress);
+    case CorrectorType::CLAHE:
+        return Clahe(srcImg, dstImg) && Progress::Step(progress);
     default:
         return false;
     }
 }
 
-bool ImageCorrector::SingleScaleRetinex(const Image& srcImg, Image& dstImg)
+bool ImageCorrector::Correct(MultiChannelImage& img, CorrectorType corType)
+{
+    return MultiChannelImage::ProcessChannels(img, [corType](const int, Image& channel)
+    {
+        return Correct(channel, corType);
+    });
+}
+
+bool ImageCorrector::Correct(const MultiChannelImage& srcImg, MultiChannelImage& dstImg, CorrectorType corType)
+{
+    return MultiChannelImage::ProcessChannels(srcImg, dstImg, [corType](const int, const Image& srcChannel, Image& dstChannel)
+    {
+        return Correct(srcChannel, dstChannel, corType);
+    });
+}
+
+bool ImageCorrector::SingleScaleRetinex(const Image& srcImg, Image& dstImg, Progress* progress)
 {
-    if (ImageFilter::Filter(srcImg, dstImg, ImageFilter::FilterType::IIR_GAUSSIAN, 72.0) != FiltrationResult::SUCCESS)
+    ACV_PROFILE_SCOPE_BYTES("ImageCorrector::SingleScaleRetinex", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
+    if (ImageFilter::Filter(srcImg, dstImg, ImageFilter::FilterType::IIR_GAUSSIAN, 72.0, progress) != FiltrationResult::SUCCESS)
         return false;
 
     size_t size = dstImg.GetWidth() * dstImg.GetHeight();
     std::vector<float> Ret(size);
 
-    auto srcIt= const_cast<Image&>(srcImg).GetData().cbegin();
-    auto dstIt= dstImg.GetData().begin();
-    auto retIt= Ret.begin();
-    float retAvg=0.;
-
-    for (size_t i = 0; i < size; ++i, ++srcIt, ++dstIt, ++retIt)
+    const int width = dstImg.GetWidth();
+    Parallel::For(0, dstImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
     {
-         *retIt = (!*srcIt || !*dstIt) ? 0. : (static_cast<float>(*srcIt) / *dstIt) * log(*srcIt);
-         retAvg += *retIt;
-    }
+        const size_t last = static_cast<size_t>(rowEnd) * width;
+        for (size_t i = static_cast<size_t>(rowBegin) * width; i < last; ++i)
+        {
+            const Image::Byte src = srcImg.GetData()[i], dst = dstImg.GetData()[i];
+            Ret[i] = (!src || !dst) ? 0. : (static_cast<float>(src) / dst) * log(src);
+        }
+    }, 64);
+
+    // The average is summed in order of pixels, so the result doesn't depend on the number of threads
+    float retAvg=0.;
+    for (const float ret : Ret)
+        retAvg += ret;
     retAvg /= size;
 
     float Pmin = 0., Pmax = 2.5 * retAvg, DP = Pmax - Pmin;
-    dstIt = dstImg.GetData().begin();
-    retIt = Ret.begin();
 
-    for (size_t i = 0; i < size; ++i, ++dstIt, ++retIt)
+    Parallel::For(0, dstImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
     {
-       int px = Image::MAX_PIXEL_VALUE * (*retIt - Pmin) / DP;
-       Image::CheckPixelValue(px);
-       *dstIt = px;
-    }
+        const size_t last = static_cast<size_t>(rowEnd) * width;
+        for (size_t i = static_cast<size_t>(rowBegin) * width; i < last; ++i)
+        {
+           int px = Image::MAX_PIXEL_VALUE * (Ret[i] - Pmin) / DP;
+           Image::CheckPixelValue(px);
+           dstImg.GetData()[i] = px;
+        }
+    }, 64);
 
     return true;
 }
 
-void ImageCorrector::ExpandBrightnessRange(const Image& srcImg, const Image::Byte minBr, const Image::Byte maxBr, Image& dstImg)
+void ImageCorrector::FormExpandRangeTable(const Image::Byte minBr, const Image::Byte maxBr, LookUpTable& table)
 {
+    if (maxBr <= minBr) // Degenerate range (for example, image of one brightness)
+    {
+        for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+            table[i] = (i > minBr) ? Image::MAX_PIXEL_VALUE : Image::MIN_PIXEL_VALUE;
+        return;
+    }
+
     double coef = static_cast<double>(Image::MAX_PIXEL_VALUE) / (maxBr - minBr);
 
-    auto srcEnd = srcImg.GetData().end();
-    auto dstIt = dstImg.GetData().begin();
-    for (auto srcIt = srcImg.GetData().begin(); srcIt != srcEnd; ++srcIt)
+    for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
     {
-        int newVal = (*srcIt - minBr) * coef;
+        int newVal = (i - minBr) * coef;
         Image::CheckPixelValue(newVal);
 
-        *dstIt++ = newVal;
+        table[i] = newVal;
     }
 }
 
+void ImageCorrector::ExpandBrightnessRange(const Image& srcImg, const Image::Byte minBr, const Image::Byte maxBr, Image& dstImg)
+{
+    LookUpTable newValues;
+    FormExpandRangeTable(minBr, maxBr, newValues);
+
+    ApplyLookUpTable(srcImg, newValues, dstImg);
+}
+
 bool ImageCorrector::AutoLevels(const Image& srcImg, Image& dstImg)
 {
+    ACV_PROFILE_SCOPE_BYTES("ImageCorrector::AutoLevels", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
     Image::Byte minBr, maxBr;
     ImageParametersCalculator calcer(srcImg);
     calcer.CalcMinMaxBrightness(minBr, maxBr);
@@ -109,13 +198,15 @@ bool ImageCorrector::AutoLevels(const Image& srcImg, Image& dstImg)
     if (minBr > Image::MIN_PIXEL_VALUE || maxBr < Image::MAX_PIXEL_VALUE)
         ExpandBrightnessRange(srcImg, minBr, maxBr, dstImg);
     else
-        memcpy(dstImg.GetRawPointer(), srcImg.GetRawPointer(), srcImg.GetHeight() * srcImg.GetWidth());
+        CopyPixels(srcImg, dstImg);
 
     return true;
 }
 
 bool ImageCorrector::NormAutoLevels(const Image& srcImg, Image& dstImg)
 {
+    ACV_PROFILE_SCOPE_BYTES("ImageCorrector::NormAutoLevels", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
     ImageParametersCalculator calcer(srcImg);
     double aver = calcer.CalcAverageBrightness();
     double sd = calcer.CalcStandardDeviation(aver);
@@ -131,28 +222,245 @@ bool ImageCorrector::NormAutoLevels(const Image& srcImg, Image& dstImg)
     if (minBr > Image::MIN_PIXEL_VALUE || maxBr < Image::MAX_PIXEL_VALUE)
         ExpandBrightnessRange(srcImg, minBr, maxBr, dstImg);
     else
-        memcpy(dstImg.GetRawPointer(), srcImg.GetRawPointer(), srcImg.GetHeight() * srcImg.GetWidth());
+        CopyPixels(srcImg, dstImg);
 
     return true;
 }
 
-bool ImageCorrector::GammaCorrection(const Image& srcImg, Image& dstImg)
+void ImageCorrector::FormGammaTable(LookUpTable& table)
 {
     const double Y = 1.0 / 2.2; // Gamma-correction factor
 
-    Image::Byte gammaValues[Image::MAX_PIXEL_VALUE + 1];
     for (size_t i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
     {
         int newVal = Image::MAX_PIXEL_VALUE * pow(static_cast<double>(i) / Image::MAX_PIXEL_VALUE, Y);
         Image::CheckPixelValue(newVal);
 
-        gammaValues[i] = newVal;
+        table[i] = newVal;
+    }
+}
+
+bool ImageCorrector::GammaCorrection(const Image& srcImg, Image& dstImg)
+{
+    ACV_PROFILE_SCOPE_BYTES("ImageCorrector::GammaCorrection", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
+    LookUpTable gammaValues;
+    FormGammaTable(gammaValues);
+
+    ApplyLookUpTable(srcImg, gammaValues, dstImg);
+
+    return true;
+}
+
+void ImageCorrector::FormEqualizationTable(const std::vector<size_t>& histogram, LookUpTable& table)
+{
+    size_t numPixels = 0, minCdf = 0;
+    for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+    {
+        if (minCdf == 0)
+            minCdf = histogram[i];
+        numPixels += histogram[i];
+    }
+
+    if (numPixels == minCdf) // Degenerate histogram (for example, image of one brightness)
+    {
+        for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+            table[i] = i;
+        return;
     }
 
-    auto srcEnd = srcImg.GetData().end();
-    auto dstIt = dstImg.GetData().begin();
-    for (auto srcIt = srcImg.GetData().begin(); srcIt != srcEnd; ++srcIt)
-        *dstIt++ = gammaValues[*srcIt];
+    // The first present brightness value is mapped to zero, the cumulative distribution is stretched to all range
+    double coef = static_cast<double>(Image::MAX_PIXEL_VALUE) / (numPixels - minCdf);
+
+    size_t cdf = 0;
+    for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+    {
+        cdf += histogram[i];
+
+        int newVal = (cdf > minCdf) ? static_cast<int>((cdf - minCdf) * coef + 0.5) : Image::MIN_PIXEL_VALUE;
+        Image::CheckPixelValue(newVal);
+
+        table[i] = newVal;
+    }
+}
+
+bool ImageCorrector::GlobalEqualization(const Image& srcImg, Image& dstImg)
+{
+    ACV_PROFILE_SCOPE_BYTES("ImageCorrector::GlobalEqualization", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
+    const Histogram histogram(srcImg);
+
+    LookUpTable newValues;
+    FormEqualizationTable(std::vector<size_t>(histogram.GetBins().begin(), histogram.GetBins().end()), newValues);
+
+    ApplyLookUpTable(srcImg, newValues, dstImg);
+
+    return true;
+}
+
+// Form the table of equalization of tile of CLAHE. The bins are clipped by limit and the excess of pixels
+// is redistributed evenly among all bins, then the cumulative distribution is scaled to all range
+static void FormClippedEqualizationTable(const Histogram& histogram, const double clipLimit, ImageCorrector::LookUpTable& table)
+{
+    Histogram::Bins bins = histogram.GetBins();
+    const size_t numPixels = histogram.GetTotal();
+
+    if (clipLimit > 0.0)
+    {
+        const size_t limit = std::max(static_cast<size_t>(clipLimit * numPixels / Histogram::NUM_BINS), static_cast<size_t>(1));
+
+        size_t excess = 0;
+        for (auto& count : bins)
+        {
+            if (count > limit)
+            {
+                excess += count - limit;
+                count = limit;
+            }
+        }
+
+        const size_t batch = excess / Histogram::NUM_BINS;
+        const size_t residual = excess % Histogram::NUM_BINS;
+        for (auto& count : bins)
+            count += batch;
+
+        // The residual pixels are spread uniformly through the range
+        if (residual > 0)
+        {
+            const size_t step = Histogram::NUM_BINS / residual;
+            for (size_t i = 0, j = 0; j < residual; i += step, ++j)
+                ++bins[i];
+        }
+    }
+
+    double coef = static_cast<double>(Image::MAX_PIXEL_VALUE) / numPixels;
+
+    size_t cdf = 0;
+    for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+    {
+        cdf += bins[i];
+
+        int newVal = static_cast<int>(cdf * coef + 0.5);
+        Image::CheckPixelValue(newVal);
+
+        table[i] = newVal;
+    }
+}
+
+// Get the first coordinate of tile
+static int GetTileStart(const int size, const int numTiles, const int tile)
+{
+    return static_cast<int>(static_cast<long long>(size) * tile / numTiles);
+}
+
+// Calculate for each position along the axis the index of the nearest tile whose center is not after the position
+// and the weight of the next tile. The positions before the first center and after the last one use a single tile
+static void CalcInterpolationWeights(const int size, const int numTiles, std::vector<int>& firstTiles, std::vector<Image::Byte>& weights)
+{
+    firstTiles.resize(size);
+    weights.resize(size);
+
+    auto center = [size, numTiles](const int tile)
+    {
+        return (GetTileStart(size, numTiles, tile) + GetTileStart(size, numTiles, tile + 1) - 1) / 2.0;
+    };
+
+    int tile = 0;
+    for (int pos = 0; pos < size; ++pos)
+    {
+        while (tile + 1 < numTiles && center(tile + 1) <= pos)
+            ++tile;
+
+        firstTiles[pos] = tile;
+        weights[pos] = 0;
+        if (tile + 1 < numTiles && center(tile) < pos)
+        {
+            const double weight = (pos - center(tile)) / (center(tile + 1) - center(tile));
+            weights[pos] = static_cast<Image::Byte>(weight * SimdKernels::BLEND_WEIGHT_ONE + 0.5);
+        }
+    }
+}
+
+bool ImageCorrector::Clahe(const Image& srcImg, Image& dstImg, const double clipLimit/* = 2.0*/, const int numTiles/* = 8*/)
+{
+    if (!srcImg.IsInitialized() || numTiles < 1 || clipLimit < 0.0 ||
+        srcImg.GetWidth() != dstImg.GetWidth() || srcImg.GetHeight() != dstImg.GetHeight())
+        return false;
+
+    ACV_PROFILE_SCOPE_BYTES("ImageCorrector::Clahe", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
+    const int width = srcImg.GetWidth();
+    const int height = srcImg.GetHeight();
+    const int numTilesX = std::min(numTiles, width);
+    const int numTilesY = std::min(numTiles, height);
+
+    // Look-up tables of tiles (row-major), the clipped histograms of tiles are calculated in parallel
+    std::vector<LookUpTable> tileTables(numTilesX * numTilesY);
+    Parallel::For(0, numTilesX * numTilesY, [&](const int begin, const int end)
+    {
+        for (int tile = begin; tile < end; ++tile)
+        {
+            const int tileX = tile % numTilesX;
+            const int tileY = tile / numTilesX;
+            const Histogram::Roi roi = { GetTileStart(width, numTilesX, tileX), GetTileStart(height, numTilesY, tileY),
+                                         GetTileStart(width, numTilesX, tileX + 1) - 1, GetTileStart(height, numTilesY, tileY + 1) - 1 };
+
+            Histogram histogram;
+            histogram.Add(srcImg, roi);
+            FormClippedEqualizationTable(histogram, clipLimit, tileTables[tile]);
+        }
+    });
+
+    std::vector<int> firstTilesX, firstTilesY;
+    std::vector<Image::Byte> weightsX, weightsY;
+    CalcInterpolationWeights(width, numTilesX, firstTilesX, weightsX);
+    CalcInterpolationWeights(height, numTilesY, firstTilesY, weightsY);
+
+    // Runs of columns which are interpolated between the same tiles
+    struct ColumnsRun
+    {
+        int start, end, tileX;
+    };
+    std::vector<ColumnsRun> runs;
+    for (int x = 0; x < width; ++x)
+    {
+        if (runs.empty() || runs.back().tileX != firstTilesX[x])
+            runs.push_back({ x, x + 1, firstTilesX[x] });
+        else
+            runs.back().end = x + 1;
+    }
+
+    // Each row is replaced by the tables of four nearest tiles and the results are interpolated in one pass
+    const SimdKernels& kernels = SimdKernels::Get();
+    Parallel::For(0, height, [&](const int begin, const int end)
+    {
+        std::vector<Image::Byte> rows(4 * width);
+        Image::Byte* pTopLeft = rows.data();
+        Image::Byte* pTopRight = pTopLeft + width;
+        Image::Byte* pBottomLeft = pTopRight + width;
+        Image::Byte* pBottomRight = pBottomLeft + width;
+
+        for (int y = begin; y < end; ++y)
+        {
+            const Image::Byte* pSrc = srcImg.GetRawPointer(y * width);
+            const int topTile = firstTilesY[y] * numTilesX;
+            const int bottomTile = std::min(firstTilesY[y] + 1, numTilesY - 1) * numTilesX;
+
+            for (const auto& run : runs)
+            {
+                const int rightTileX = std::min(run.tileX + 1, numTilesX - 1);
+                const size_t count = run.end - run.start;
+
+                kernels.ApplyLookUpTable(pSrc + run.start, pTopLeft + run.start, count, tileTables[topTile + run.tileX].data());
+                kernels.ApplyLookUpTable(pSrc + run.start, pTopRight + run.start, count, tileTables[topTile + rightTileX].data());
+                kernels.ApplyLookUpTable(pSrc + run.start, pBottomLeft + run.start, count, tileTables[bottomTile + run.tileX].data());
+                kernels.ApplyLookUpTable(pSrc + run.start, pBottomRight + run.start, count, tileTables[bottomTile + rightTileX].data());
+            }
+
+            kernels.BlendBilinearRow(pTopLeft, pTopRight, pBottomLeft, pBottomRight, weightsX.data(), weightsY[y],
+                                     dstImg.GetRawPointer(y * width), width);
+        }
+    }, 16);
 
     return true;
 }
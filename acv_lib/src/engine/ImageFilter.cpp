@@ -26,50 +26,112 @@
 
 #include <vector>
 #include <cstring>
+#include <cmath>
 #include <algorithm>
+#include <cstdint>
 
 #include "MatrixFilter.h"
 #include "ImageFilter.h"
 #include "Image.h"
+#include "BinaryImage.h"
+#include "MultiChannelImage.h"
+#include "Parallel.h"
+#include "Progress.h"
+#include "Profiler.h"
+#include "SimdKernels.h"
 
 namespace acv {
 
-FiltrationResult ImageFilter::Filter(Image& img, ImageFilter::FilterType type, const int filterSize/* = -1*/)
+FiltrationResult ImageFilter::Filter(Image& img, ImageFilter::FilterType type, const int filterSize/* = -1*/,
+                                     Progress* progress/* = nullptr*/)
 {
     switch (type)
     {
     case FilterType::MEDIAN:
-        return Median(img, filterSize);
+        return Median(img, filterSize, progress);
     case FilterType::GAUSSIAN:
-        return Gaussian(img, filterSize);
+        return Gaussian(img, filterSize, progress);
+    case FilterType::SEP_GAUSSIAN:
+        return SeparateGaussian(img, filterSize, progress);
     case FilterType::IIR_GAUSSIAN:
-        return GaussianIIR(img, static_cast<float>(filterSize/6.0));
+        return GaussianIIR(img, static_cast<float>(filterSize/6.0), progress);
     case FilterType::SHARPEN:
-        return Sharpen(img);
+        return Sharpen(img, progress);
+    case FilterType::BILATERAL:
+        return Bilateral(img, img, static_cast<float>(filterSize / 6.0), DEFAULT_BILATERAL_RANGE_SIGMA, progress);
+    case FilterType::UNSHARP_MASK:
+        return UnsharpMask(img, img, filterSize / 2, DEFAULT_UNSHARP_AMOUNT, DEFAULT_UNSHARP_THRESHOLD, progress);
     default:
         return FiltrationResult::INCORRECT_FILTER_TYPE;
     }
 }
 
-FiltrationResult ImageFilter::Filter(const Image& srcImg, Image& dstImg, ImageFilter::FilterType type, const int filterSize/* = -1*/)
+FiltrationResult ImageFilter::Filter(const Image& srcImg, Image& dstImg, ImageFilter::FilterType type, const int filterSize/* = -1*/,
+                                     Progress* progress/* = nullptr*/)
 {
     switch (type)
     {
     case FilterType::MEDIAN:
-        return Median(srcImg, dstImg, filterSize);
+        return Median(srcImg, dstImg, filterSize, progress);
     case FilterType::GAUSSIAN:
-        return Gaussian(srcImg, dstImg, filterSize);
+        return Gaussian(srcImg, dstImg, filterSize, progress);
     case FilterType::SEP_GAUSSIAN:
-        return SeparateGaussian(srcImg, dstImg, filterSize);
+        return SeparateGaussian(srcImg, dstImg, filterSize, progress);
     case FilterType::IIR_GAUSSIAN:
-        return GaussianIIR(srcImg, dstImg, static_cast<float>(filterSize / 6.0));
+        return GaussianIIR(srcImg, dstImg, static_cast<float>(filterSize / 6.0), progress);
    case FilterType::SHARPEN:
-        return Sharpen(srcImg, dstImg);
+        return Sharpen(srcImg, dstImg, progress);
+    case FilterType::BILATERAL:
+        return Bilateral(srcImg, dstImg, static_cast<float>(filterSize / 6.0), DEFAULT_BILATERAL_RANGE_SIGMA, progress);
+    case FilterType::UNSHARP_MASK:
+        return UnsharpMask(srcImg, dstImg, filterSize / 2, DEFAULT_UNSHARP_AMOUNT, DEFAULT_UNSHARP_THRESHOLD, progress);
     default:
         return FiltrationResult::INCORRECT_FILTER_TYPE;
     }
 }
 
+// Get the result of multi-channel filtration (the first error of channels or success)
+static FiltrationResult CombineChannelResults(const FiltrationResult* results, const int numChannels)
+{
+    for (int channel = 0; channel < numChannels; ++channel)
+        if (results[channel] != FiltrationResult::SUCCESS)
+            return results[channel];
+
+    return FiltrationResult::SUCCESS;
+}
+
+FiltrationResult ImageFilter::Filter(MultiChannelImage& img, ImageFilter::FilterType type, const int filterSize/* = -1*/)
+{
+    if (!img.IsInitialized())
+        return FiltrationResult::INTERNAL_ERROR;
+
+    FiltrationResult results[MultiChannelImage::MAX_NUM_CHANNELS];
+
+    MultiChannelImage::ProcessChannels(img, [&](const int channelNum, Image& channel)
+    {
+        results[channelNum] = Filter(channel, type, filterSize);
+        return results[channelNum] == FiltrationResult::SUCCESS;
+    });
+
+    return CombineChannelResults(results, img.GetNumChannels());
+}
+
+FiltrationResult ImageFilter::Filter(const MultiChannelImage& srcImg, MultiChannelImage& dstImg, ImageFilter::FilterType type, const int filterSize/* = -1*/)
+{
+    if (!srcImg.IsInitialized() || !srcImg.HasSameFormat(dstImg))
+        return FiltrationResult::INTERNAL_ERROR;
+
+    FiltrationResult results[MultiChannelImage::MAX_NUM_CHANNELS];
+
+    MultiChannelImage::ProcessChannels(srcImg, dstImg, [&](const int channelNum, const Image& srcChannel, Image& dstChannel)
+    {
+        results[channelNum] = Filter(srcChannel, dstChannel, type, filterSize);
+        return results[channelNum] == FiltrationResult::SUCCESS;
+    });
+
+    return CombineChannelResults(results, srcImg.GetNumChannels());
+}
+
 bool ImageFilter::AdaptiveThreshold(Image& img, const int filterSize, const int threshold, ImageFilter::ThresholdType thresholdType)
 {
     Image tmpImg = Image(img.GetHeight(), img.GetWidth());
@@ -81,11 +143,13 @@ bool ImageFilter::AdaptiveThreshold(Image& img, const int filterSize, const int
 
 bool ImageFilter::AdaptiveThreshold(const Image& srcImg, Image& dstImg, const int filterSize, const int threshold, ThresholdType thresholdType)
 {
+    ACV_PROFILE_SCOPE_BYTES("ImageFilter::AdaptiveThreshold", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
     FiltrationResult filterRes;
     if (filterSize >= 6)
-        filterRes = GaussianIIR(srcImg, dstImg, static_cast<float>(filterSize / 6.0));
+        filterRes = GaussianIIR(srcImg, dstImg, static_cast<float>(filterSize / 6.0), nullptr);
     else
-        filterRes = SeparateGaussian(srcImg, dstImg, filterSize);
+        filterRes = SeparateGaussian(srcImg, dstImg, filterSize, nullptr);
 
     if (filterRes != FiltrationResult::SUCCESS)
         return false;
@@ -103,34 +167,235 @@ bool ImageFilter::AdaptiveThreshold(const Image& srcImg, Image& dstImg, const in
     }
 
 
-    Image::Matrix::iterator itDst = dstImg.GetData().begin();
-    for (auto it = srcImg.GetData().begin(); it != srcImg.GetData().end(); ++it)
+    // The blurred image in destination is the level of threshold, it is replaced by the result
+    SimdKernels::Get().ThresholdRow(srcImg.GetRawPointer(), dstImg.GetRawPointer(), dstImg.GetRawPointer(),
+                                    srcImg.GetData().size(), threshold, moreTh, lessTh);
+
+    return true;
+}
+
+bool ImageFilter::AdaptiveThreshold(const Image& srcImg, BinaryImage& dstImg, const int filterSize, const int threshold,
+                                    ImageFilter::ThresholdType thresholdType)
+{
+    if (!srcImg.IsInitialized() || srcImg.GetWidth() != dstImg.GetWidth() || srcImg.GetHeight() != dstImg.GetHeight())
+        return false;
+
+    // The level of threshold is the blurred image, the rows of result are packed after the threshold of blurred rows
+    Image levelsImg(srcImg.GetHeight(), srcImg.GetWidth());
+    if (!AdaptiveThreshold(srcImg, levelsImg, filterSize, threshold, thresholdType))
+        return false;
+
+    const int width = srcImg.GetWidth();
+    Parallel::For(0, srcImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
+    {
+        for (int rowNum = rowBegin; rowNum < rowEnd; ++rowNum)
+            dstImg.PackRow(rowNum, levelsImg.GetRawPointer(rowNum * width));
+    }, 64);
+
+    return true;
+}
+
+// Calculate the levels of threshold by the local statistics for rows of image and pass each row of levels with the row
+// of source pixels to the writer of result (writeRow(rowNum, pSrc, pLevels)). The image is divided to strips which are
+// processed in parallel. Each strip keeps the ring of integral rows (sums of pixels and squares from the first row of its
+// windows), so the memory doesn't depend on the height of image. The sums of pixels are modular 32-bit integers
+// (their differences are exact), the sums of squares need 64 bits for large windows.
+// If the source is overwritten by the writer, the rows of neighbour strips are read from the copies of strip borders
+template <typename RowWriter>
+static void ThresholdByLocalStatistics(const Image& srcImg, const int filterSize, const float k, ImageFilter::ThresholdMethod method,
+                                       const bool srcIsOverwritten, const RowWriter& writeRow)
+{
+    const int APERTURE = filterSize / 2;
+    const int STRIP_HEIGHT = std::max(64, 2 * filterSize); // The first windows of strip are not longer than a half of strip
+    const int width = srcImg.GetWidth();
+    const int height = srcImg.GetHeight();
+    const int numStrips = (height + STRIP_HEIGHT - 1) / STRIP_HEIGHT;
+    const int ringSize = filterSize + 1;
+    const int integralWidth = width + 1;
+
+    // Copies of rows [border - APERTURE, border + APERTURE) for each border between strips
+    std::vector<Image::Byte> borderRows;
+    if (srcIsOverwritten && numStrips > 1)
     {
-        int p = *itDst - threshold;
-        *itDst++ = (*it > p) ? moreTh : lessTh;
+        borderRows.resize(static_cast<size_t>(numStrips - 1) * 2 * APERTURE * width);
+        for (int border = 1; border < numStrips; ++border)
+        {
+            const int firstRow = border * STRIP_HEIGHT - APERTURE;
+            const int lastRow = std::min(height, border * STRIP_HEIGHT + APERTURE);
+            memcpy(&borderRows[static_cast<size_t>(border - 1) * 2 * APERTURE * width], srcImg.GetRawPointer(firstRow * width),
+                   static_cast<size_t>(lastRow - firstRow) * width);
+        }
     }
 
+    Parallel::For(0, numStrips, [&](const int begin, const int end)
+    {
+        std::vector<uint32_t> sums(static_cast<size_t>(ringSize) * integralWidth);
+        std::vector<uint64_t> squares(static_cast<size_t>(ringSize) * integralWidth);
+        std::vector<float> levels(width);
+
+        for (int strip = begin; strip < end; ++strip)
+        {
+            const int rowBegin = strip * STRIP_HEIGHT;
+            const int rowEnd = std::min(rowBegin + STRIP_HEIGHT, height);
+
+            auto getSrcRow = [&](const int rowNum) -> const Image::Byte*
+            {
+                if (borderRows.empty() || (rowNum >= rowBegin && rowNum < rowEnd))
+                    return srcImg.GetRawPointer(rowNum * width);
+
+                const int border = (rowNum < rowBegin) ? strip : strip + 1;
+                const int copyRow = rowNum - (border * STRIP_HEIGHT - APERTURE);
+                return &borderRows[(static_cast<size_t>(border - 1) * 2 * APERTURE + copyRow) * width];
+            };
+
+            // Integral row with index i contains the sums over rows [firstRow, i) and columns [0, x)
+            const int firstRow = std::max(0, rowBegin - APERTURE);
+            int lastIntegralRow = firstRow;
+            std::fill(sums.begin() + static_cast<size_t>(firstRow % ringSize) * integralWidth,
+                      sums.begin() + static_cast<size_t>(firstRow % ringSize + 1) * integralWidth, 0);
+            std::fill(squares.begin() + static_cast<size_t>(firstRow % ringSize) * integralWidth,
+                      squares.begin() + static_cast<size_t>(firstRow % ringSize + 1) * integralWidth, 0);
+
+            for (int rowNum = rowBegin; rowNum < rowEnd; ++rowNum)
+            {
+                const int windowTop = std::max(0, rowNum - APERTURE);
+                const int windowBottom = std::min(height, rowNum + APERTURE + 1);
+
+                for (; lastIntegralRow < windowBottom; ++lastIntegralRow)
+                {
+                    const Image::Byte* pSrc = getSrcRow(lastIntegralRow);
+                    const uint32_t* pPrevSums = &sums[static_cast<size_t>(lastIntegralRow % ringSize) * integralWidth];
+                    const uint64_t* pPrevSquares = &squares[static_cast<size_t>(lastIntegralRow % ringSize) * integralWidth];
+                    uint32_t* pSums = &sums[static_cast<size_t>((lastIntegralRow + 1) % ringSize) * integralWidth];
+                    uint64_t* pSquares = &squares[static_cast<size_t>((lastIntegralRow + 1) % ringSize) * integralWidth];
+
+                    uint32_t rowSum = 0;
+                    uint64_t rowSquares = 0;
+                    pSums[0] = 0;
+                    pSquares[0] = 0;
+                    for (int colNum = 0; colNum < width; ++colNum)
+                    {
+                        rowSum += pSrc[colNum];
+                        rowSquares += pSrc[colNum] * pSrc[colNum];
+                        pSums[colNum + 1] = pPrevSums[colNum + 1] + rowSum;
+                        pSquares[colNum + 1] = pPrevSquares[colNum + 1] + rowSquares;
+                    }
+                }
+
+                const uint32_t* pTopSums = &sums[static_cast<size_t>(windowTop % ringSize) * integralWidth];
+                const uint64_t* pTopSquares = &squares[static_cast<size_t>(windowTop % ringSize) * integralWidth];
+                const uint32_t* pBottomSums = &sums[static_cast<size_t>(windowBottom % ringSize) * integralWidth];
+                const uint64_t* pBottomSquares = &squares[static_cast<size_t>(windowBottom % ringSize) * integralWidth];
+                const int windowHeight = windowBottom - windowTop;
+
+                for (int colNum = 0; colNum < width; ++colNum)
+                {
+                    const int windowLeft = std::max(0, colNum - APERTURE);
+                    const int windowRight = std::min(width, colNum + APERTURE + 1);
+
+                    const uint32_t sum = (pBottomSums[windowRight] - pBottomSums[windowLeft]) - (pTopSums[windowRight] - pTopSums[windowLeft]);
+                    const uint64_t sumSquares = (pBottomSquares[windowRight] - pBottomSquares[windowLeft]) -
+                                                (pTopSquares[windowRight] - pTopSquares[windowLeft]);
+                    const double numPixels = static_cast<double>(windowRight - windowLeft) * windowHeight;
+
+                    const double mean = sum / numPixels;
+                    const double deviation = std::sqrt(std::max(0.0, sumSquares / numPixels - mean * mean));
+
+                    levels[colNum] = static_cast<float>((method == ImageFilter::ThresholdMethod::NIBLACK)
+                        ? mean + k * deviation
+                        : mean * (1.0 + k * (deviation / ImageFilter::SAUVOLA_DYNAMIC_RANGE - 1.0)));
+                }
+
+                writeRow(rowNum, getSrcRow(rowNum), levels.data());
+            }
+        }
+    });
+}
+
+bool ImageFilter::AdaptiveThreshold(Image& img, const int filterSize, const float k, ImageFilter::ThresholdMethod method,
+                                    ImageFilter::ThresholdType thresholdType)
+{
+    return AdaptiveThreshold(img, img, filterSize, k, method, thresholdType);
+}
+
+bool ImageFilter::AdaptiveThreshold(const Image& srcImg, Image& dstImg, const int filterSize, const float k,
+                                    ImageFilter::ThresholdMethod method, ImageFilter::ThresholdType thresholdType)
+{
+    if (filterSize <= 0 || filterSize % 2 == 0 || !srcImg.IsInitialized() ||
+        srcImg.GetWidth() != dstImg.GetWidth() || srcImg.GetHeight() != dstImg.GetHeight())
+        return false;
+
+    ACV_PROFILE_SCOPE_BYTES("ImageFilter::AdaptiveThreshold", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
+    const Image::Byte moreTh = (thresholdType == ThresholdType::MAX_MORE_THRESHOLD) ? Image::MAX_PIXEL_VALUE : Image::MIN_PIXEL_VALUE;
+    const Image::Byte lessTh = (thresholdType == ThresholdType::MAX_MORE_THRESHOLD) ? Image::MIN_PIXEL_VALUE : Image::MAX_PIXEL_VALUE;
+    const int width = srcImg.GetWidth();
+
+    ThresholdByLocalStatistics(srcImg, filterSize, k, method, &srcImg == &dstImg,
+                               [&](const int rowNum, const Image::Byte* pSrc, const float* pLevels)
+    {
+        Image::Byte* pDst = dstImg.GetRawPointer(rowNum * width);
+        for (int colNum = 0; colNum < width; ++colNum)
+            pDst[colNum] = (pSrc[colNum] > pLevels[colNum]) ? moreTh : lessTh;
+    });
+
+    return true;
+}
+
+bool ImageFilter::AdaptiveThreshold(const Image& srcImg, BinaryImage& dstImg, const int filterSize, const float k,
+                                    ImageFilter::ThresholdMethod method, ImageFilter::ThresholdType thresholdType)
+{
+    if (filterSize <= 0 || filterSize % 2 == 0 || !srcImg.IsInitialized() ||
+        srcImg.GetWidth() != dstImg.GetWidth() || srcImg.GetHeight() != dstImg.GetHeight())
+        return false;
+
+    ACV_PROFILE_SCOPE_BYTES("ImageFilter::AdaptiveThreshold", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
+    // The bits of pixels more than level are inverted for MIN_MORE_THRESHOLD
+    const BinaryImage::Word inversion = (thresholdType == ThresholdType::MAX_MORE_THRESHOLD) ? 0 : 1;
+    const int width = srcImg.GetWidth();
+    const int wordsPerRow = dstImg.GetWordsPerRow();
+
+    ThresholdByLocalStatistics(srcImg, filterSize, k, method, false,
+                               [&](const int rowNum, const Image::Byte* pSrc, const float* pLevels)
+    {
+        BinaryImage::Word* pDst = dstImg.GetRow(rowNum);
+        for (int wordNum = 0; wordNum < wordsPerRow; ++wordNum)
+        {
+            const int colBegin = wordNum * BinaryImage::BITS_PER_WORD;
+            const int colEnd = std::min(colBegin + static_cast<int>(BinaryImage::BITS_PER_WORD), width);
+
+            BinaryImage::Word word = 0;
+            for (int colNum = colBegin; colNum < colEnd; ++colNum)
+                word |= (static_cast<BinaryImage::Word>(pSrc[colNum] > pLevels[colNum]) ^ inversion) << (colNum - colBegin);
+            pDst[wordNum] = word;
+        }
+    });
+
     return true;
 }
 
-FiltrationResult ImageFilter::Median(Image& img, const int filterSize)
+FiltrationResult ImageFilter::Median(Image& img, const int filterSize, Progress* progress)
 {
     if (filterSize % 2 != 0) // The filter size should be odd
     {
         // We use temporary image because of the value of pixels are changed in process of filtration
         Image tmpImg = Image(img);
 
-        Median(img, tmpImg, filterSize);
+        FiltrationResult ret = Median(img, tmpImg, filterSize, progress);
+        if (ret == FiltrationResult::SUCCESS)
+            img = std::move(tmpImg);
 
-        img = std::move(tmpImg);
-        return FiltrationResult::SUCCESS;
+        return ret;
     }
 
     return FiltrationResult::INCORRECT_FILTER_SIZE;
 }
 
-FiltrationResult ImageFilter::Median(const Image& srcImg, Image& dstImg, const int filterSize)
+FiltrationResult ImageFilter::Median(const Image& srcImg, Image& dstImg, const int filterSize, Progress* progress)
 {
+    ACV_PROFILE_SCOPE_BYTES("ImageFilter::Median", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
     if (filterSize % 2 != 0) // The filter size should be odd
     {
         const int APERTURE = filterSize / 2; // Aparture size
@@ -139,6 +404,8 @@ FiltrationResult ImageFilter::Median(const Image& srcImg, Image& dstImg, const i
         // We collect all pixels from the window of size filterSize*filterSize to vector for each pixel
         std::vector<Image::Byte> pixelsWindow(filterSize * filterSize);
 
+        Progress::Begin(progress, dstImg.GetHeight());
+
         for (int row = 0; row < dstImg.GetHeight(); ++row)
         {
             for (int col = 0; col < dstImg.GetWidth(); ++col)
@@ -160,6 +427,9 @@ FiltrationResult ImageFilter::Median(const Image& srcImg, Image& dstImg, const i
                 std::nth_element(pixelsWindow.begin(), pixelsWindow.begin() + MEDIAN, pixelsWindow.end());
                 dstImg(row, col) = pixelsWindow[MEDIAN];
             }
+
+            if (!Progress::Step(progress))
+                return FiltrationResult::CANCELLED;
         }
 
         return FiltrationResult::SUCCESS;
@@ -168,236 +438,730 @@ FiltrationResult ImageFilter::Median(const Image& srcImg, Image& dstImg, const i
     return FiltrationResult::INCORRECT_FILTER_SIZE;
 }
 
-FiltrationResult ImageFilter::Gaussian(Image& img, const int filterSize)
+FiltrationResult ImageFilter::Gaussian(Image& img, const int filterSize, Progress* progress)
 {
+    ACV_PROFILE_SCOPE_BYTES("ImageFilter::Gaussian", static_cast<long long>(img.GetHeight()) * img.GetWidth());
+
     if (filterSize % 2 != 0) // The filter size should be odd
     {
         // Creation of the Gaussian filter
         MatrixFilter<int> filter(filterSize);
+        FormGaussianFilter(filterSize, filter);
 
-        const float SIGMA = (filterSize / 2.0 - 1.0) * 0.3 + 0.8, SIGMA2 = SIGMA * SIGMA;
-        const int APERTURE = filterSize / 2, APERTURE2 = APERTURE * APERTURE;
-        const float MIN = exp(-(2.0 * APERTURE2) / (2.0 * SIGMA2)) / (2.0 * M_PI * SIGMA2);
-
-        int divider = 0.0;
-        for (int filterRow = -APERTURE; filterRow <= APERTURE; ++filterRow)
-        {
-            for (int filterCol = -APERTURE; filterCol <= APERTURE; ++filterCol)
-            {
-                int filterVal = exp(-(filterRow * filterRow + filterCol * filterCol) / (2.0 * SIGMA2)) / (2.0 * M_PI * SIGMA2 * MIN);
-                divider += filterVal;
-
-                filter.SetElement(filterRow + APERTURE, filterCol + APERTURE, filterVal);
-            }
-        }
-        filter.SetDivider(divider);
+        // The convolution is not divided, so it is the single step of progress
+        Progress::Begin(progress, 1);
 
         bool ret = MatrixFilterOperations::FastConvolutionImage<int>(img, filter);
+        if (ret && !Progress::Step(progress))
+            return FiltrationResult::CANCELLED;
+
         return (ret) ? FiltrationResult::SUCCESS : FiltrationResult::INTERNAL_ERROR;
     }
 
     return FiltrationResult::INCORRECT_FILTER_SIZE;
 }
 
-FiltrationResult ImageFilter::SeparateGaussian(const Image& srcImg, Image& dstImg, const int filterSize)
+void ImageFilter::FormGaussianFilter(const int filterSize, MatrixFilter<int>& filter)
+{
+    const float SIGMA = (filterSize / 2.0 - 1.0) * 0.3 + 0.8, SIGMA2 = SIGMA * SIGMA;
+    const int APERTURE = filterSize / 2, APERTURE2 = APERTURE * APERTURE;
+    const float MIN = exp(-(2.0 * APERTURE2) / (2.0 * SIGMA2)) / (2.0 * M_PI * SIGMA2);
+
+    int divider = 0.0;
+    for (int filterRow = -APERTURE; filterRow <= APERTURE; ++filterRow)
+    {
+        for (int filterCol = -APERTURE; filterCol <= APERTURE; ++filterCol)
+        {
+            int filterVal = exp(-(filterRow * filterRow + filterCol * filterCol) / (2.0 * SIGMA2)) / (2.0 * M_PI * SIGMA2 * MIN);
+            divider += filterVal;
+
+            filter.SetElement(filterRow + APERTURE, filterCol + APERTURE, filterVal);
+        }
+    }
+    filter.SetDivider(divider);
+}
+
+FiltrationResult ImageFilter::SeparateGaussian(Image& img, const int filterSize, Progress* progress)
+{
+    Image tmpImg(img.GetHeight(), img.GetWidth());
+
+    FiltrationResult ret = SeparateGaussian(img, tmpImg, filterSize, progress);
+    if (ret == FiltrationResult::SUCCESS)
+        img = std::move(tmpImg);
+
+    return ret;
+}
+
+FiltrationResult ImageFilter::SeparateGaussian(const Image& srcImg, Image& dstImg, const int filterSize, Progress* progress)
 {
     if (filterSize % 2 != 0) // The filter size should be odd
     {
-        auto width = srcImg.GetWidth();
-        auto height = srcImg.GetHeight();
-        auto size = width * height;
-        Image tmpImg(height, width);
+        Image tmpImg(srcImg.GetHeight(), srcImg.GetWidth());
 
         // Creation of the Gaussian 1D filter
         std::vector<int> filter(filterSize);
+        int divider = 0;
+        FormSeparateGaussianFilter(filterSize, filter, divider);
 
-        const float SIGMA = (filterSize / 2.0 - 1.0) * 0.3 + 0.8, SIGMA2 = SIGMA * SIGMA;
-        const int APERTURE = filterSize / 2, APERTURE2 = APERTURE * APERTURE;
-        const float MIN = exp(-(2.0 * APERTURE2) / (2.0 * SIGMA2)) / (2.0 * M_PI * SIGMA2);
+        if (!SeparateGaussianPasses(srcImg, tmpImg, dstImg, filter, divider, progress))
+            return FiltrationResult::CANCELLED;
 
-        int divider = 0;
-        for (int i = -APERTURE; i <= APERTURE; ++i)
+        return FiltrationResult::SUCCESS;
+    }
+
+    return FiltrationResult::INCORRECT_FILTER_SIZE;
+}
+
+void ImageFilter::FormSeparateGaussianFilter(const int filterSize, std::vector<int>& filter, int& divider)
+{
+    const float SIGMA = (filterSize / 2.0 - 1.0) * 0.3 + 0.8, SIGMA2 = SIGMA * SIGMA;
+    const int APERTURE = filterSize / 2, APERTURE2 = APERTURE * APERTURE;
+    const float MIN = exp(-(2.0 * APERTURE2) / (2.0 * SIGMA2)) / (2.0 * M_PI * SIGMA2);
+
+    filter.resize(filterSize);
+    divider = 0;
+    for (int i = -APERTURE; i <= APERTURE; ++i)
+    {
+            int filterVal = exp(-(i * i) / (2.0 * SIGMA2)) / (2.0 * M_PI * SIGMA2 * MIN);
+            divider += filterVal;
+            filter[i + APERTURE] = filterVal;
+    }
+}
+
+bool ImageFilter::SeparateGaussianPasses(const Image& srcImg, Image& tmpImg, Image& dstImg,
+                                         const std::vector<int>& filter, const int divider, Progress* progress/* = nullptr*/)
+{
+    ACV_PROFILE_SCOPE_BYTES("ImageFilter::SeparateGaussian", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
+    const int APERTURE = static_cast<int>(filter.size()) / 2;
+    auto width = srcImg.GetWidth();
+    auto height = srcImg.GetHeight();
+    auto size = width * height;
+
+    const Image::Byte* ptrSrc = srcImg.GetRawPointer(0);
+    Image::Byte* ptrDst = tmpImg.GetRawPointer(0);
+
+    // Each row of horizontal pass and each column of vertical pass are the steps of progress
+    Progress::Begin(progress, height + width);
+
+    for (int rowNum = 0; rowNum < height; ++rowNum)    // Horizontal filter movement
+    {
+        for (int colNum = 0; colNum < APERTURE; ++colNum, ++ptrSrc, ++ptrDst)
+        {
+            int acc = 0;
+            for (int i = -APERTURE; i <= APERTURE; ++i)
+                   acc += (colNum + i < 0)
+                           ? *(ptrSrc - i) * filter[i + APERTURE]
+                           : *(ptrSrc + i) * filter[i + APERTURE];
+            int ycurr = acc / divider;
+            *ptrDst = static_cast<Image::Byte>(ycurr);
+        }
+
+        for (int colNum = APERTURE; colNum < width - APERTURE; ++colNum, ++ptrSrc, ++ptrDst)
+        {
+            int acc = 0;
+            for (int i = -APERTURE; i <= APERTURE; ++i)
+                   acc += *(ptrSrc + i) * filter[i + APERTURE];
+            int ycurr = acc / divider;
+            *ptrDst = static_cast<Image::Byte>(ycurr);
+        }
+
+        for (int colNum = width - APERTURE; colNum < width; ++colNum, ++ptrSrc, ++ptrDst)
+        {
+            int acc = 0;
+            for (int i = -APERTURE; i <= APERTURE; ++i)
+                   acc += (colNum + i >= width)
+                           ? *(ptrSrc - i) * filter[i + APERTURE]
+                           : *(ptrSrc + i) * filter[i + APERTURE];
+            int ycurr = acc / divider;
+            *ptrDst = static_cast<Image::Byte>(ycurr);
+        }
+
+        if (!Progress::Step(progress))
+            return false;
+    }
+
+    ptrSrc = tmpImg.GetRawPointer(0);
+    ptrDst = dstImg.GetRawPointer(0);
+
+    for (int colNum = 0; colNum < width; ++colNum, ptrSrc -= size - 1, ptrDst -= size - 1)    // Vertical filter movement
+    {
+        for (int rowNum = 0; rowNum < APERTURE; ++rowNum, ptrSrc += width, ptrDst += width)
         {
-                int filterVal = exp(-(i * i) / (2.0 * SIGMA2)) / (2.0 * M_PI * SIGMA2 * MIN);
-                divider += filterVal;
-                filter[i + APERTURE] = filterVal;
+            int acc = 0;
+            for (int i = -APERTURE; i <= APERTURE; ++i)
+                   acc += (rowNum + i < 0)
+                           ? *(ptrSrc - i * width) * filter[i + APERTURE]
+                           : *(ptrSrc + i * width) * filter[i + APERTURE];
+            int ycurr = acc / divider;
+            *ptrDst = static_cast<Image::Byte>(ycurr);
         }
 
-        const Image::Byte* ptrSrc = srcImg.GetRawPointer(0);
-        Image::Byte* ptrDst = tmpImg.GetRawPointer(0);
+        for (int rowNum = APERTURE; rowNum < height - APERTURE; ++rowNum, ptrSrc += width, ptrDst += width)
+        {
+            int acc = 0;
+            for (int i = -APERTURE; i <= APERTURE; ++i)
+                   acc += *(ptrSrc + i * width) * filter[i + APERTURE];
+            int ycurr = acc / divider;
+            *ptrDst = static_cast<Image::Byte>(ycurr);
+        }
 
-        for (int rowNum = 0; rowNum < height; ++rowNum)    // Horizontal filter movement
+        for (int rowNum = height - APERTURE; rowNum < height; ++rowNum, ptrSrc += width, ptrDst += width)
         {
-            for (int colNum = 0; colNum < APERTURE; ++colNum, ++ptrSrc, ++ptrDst)
+            int acc = 0;
+            for (int i = -APERTURE; i <= APERTURE; ++i)
+                   acc += (rowNum + i >= height)
+                           ? *(ptrSrc - i * width) * filter[i + APERTURE]
+                           : *(ptrSrc + i * width) * filter[i + APERTURE];
+            int ycurr = acc / divider;
+            *ptrDst = static_cast<Image::Byte>(ycurr);
+        }
+
+        if (!Progress::Step(progress))
+            return false;
+    }
+
+    return true;
+}
+
+FiltrationResult ImageFilter::GaussianIIR(Image& img, float sigma, Progress* progress)
+{
+    if (sigma >= 1.)
+    {
+        IIRfilter<float> Filter(sigma);
+        if (!GaussianIIRPasses(img, Filter, progress))
+            return FiltrationResult::CANCELLED;
+
+        return FiltrationResult::SUCCESS;
+    }
+
+    return FiltrationResult::SMALL_FILTER_SIZE;
+}
+
+bool ImageFilter::GaussianIIRPasses(Image& img, IIRfilter<float>& Filter, Progress* progress/* = nullptr*/)
+{
+    ACV_PROFILE_SCOPE_BYTES("ImageFilter::GaussianIIR", static_cast<long long>(img.GetHeight()) * img.GetWidth());
+
+    Image::Byte* ptr = img.GetRawPointer(0);
+
+    auto width = img.GetWidth();
+    auto height = img.GetHeight();
+
+    // Each row of horizontal pass and each column of vertical pass are the steps of progress
+    Progress::Begin(progress, height + width);
+
+    for (int rowNum = 0; rowNum < height; ++rowNum, ptr += width+1)    // Horizontal IIR-filter movement
+    {
+        Filter.Reset();
+        for (int colNum = 0; colNum < width; ++colNum, ++ptr)
+        {
+            int ycurr = static_cast<int>( Filter.Solve(*ptr) );
+            Image::CheckPixelValue(ycurr);
+            *ptr = static_cast<Image::Byte>(ycurr);
+        }
+        --ptr;
+
+        for (int colNum = width - 1; colNum >= 0; --colNum, --ptr)
+        {
+            int ycurr = static_cast<int>( Filter.Solve(*ptr) );
+            Image::CheckPixelValue(ycurr);
+            *ptr = static_cast<Image::Byte>(ycurr);
+        }
+
+        if (!Progress::Step(progress))
+            return false;
+    }
+
+    ptr = img.GetRawPointer(0);
+    for (int colNum = 0; colNum < width; ++colNum , ptr += width+1)    // Vertical IIR-filter movement
+    {
+        Filter.Reset();
+        for (int rowNum = 0; rowNum < height; ++rowNum, ptr += width)
+        {
+            int ycurr = static_cast<int>( Filter.Solve(*ptr) );
+            Image::CheckPixelValue(ycurr);
+            *ptr = static_cast<Image::Byte>(ycurr);
+         }
+        ptr -= width;
+
+        for (int rowNum = height - 1; rowNum >= 0; --rowNum, ptr -= width)
+        {
+            int ycurr = static_cast<int>( Filter.Solve(*ptr) );
+            Image::CheckPixelValue(ycurr);
+            *ptr = static_cast<Image::Byte>(ycurr);
+        }
+
+        if (!Progress::Step(progress))
+            return false;
+    }
+
+    return true;
+}
+
+// Blur two float images by IIR-filter at once. The rows of horizontal pass are processed in parallel,
+// the vertical pass runs along rows over blocks of columns (each column has own filter), the blocks are processed in parallel
+static void GaussianIIRPairPasses(std::vector<float>& values, std::vector<float>& weights, const int width, const int height,
+                              const ImageFilter::IIRfilter<float>& filter)
+{
+    Parallel::For(0, height, [&](const int begin, const int end)
+    {
+        ImageFilter::IIRfilter<float> valuesFilter(filter), weightsFilter(filter);
+        for (int rowNum = begin; rowNum < end; ++rowNum)
+        {
+            float* pValues = &values[static_cast<size_t>(rowNum) * width];
+            float* pWeights = &weights[static_cast<size_t>(rowNum) * width];
+
+            valuesFilter.Reset();
+            weightsFilter.Reset();
+            for (int colNum = 0; colNum < width; ++colNum)
             {
-                int acc = 0;
-                for (int i = -APERTURE; i <= APERTURE; ++i)
-                       acc += (colNum + i < 0)
-                               ? *(ptrSrc - i) * filter[i + APERTURE]
-                               : *(ptrSrc + i) * filter[i + APERTURE];
-                int ycurr = acc / divider;
-                *ptrDst = static_cast<Image::Byte>(ycurr);
+                pValues[colNum] = valuesFilter.Solve(pValues[colNum]);
+                pWeights[colNum] = weightsFilter.Solve(pWeights[colNum]);
             }
-
-            for (int colNum = APERTURE; colNum < width - APERTURE; ++colNum, ++ptrSrc, ++ptrDst)
+            for (int colNum = width - 1; colNum >= 0; --colNum)
             {
-                int acc = 0;
-                for (int i = -APERTURE; i <= APERTURE; ++i)
-                       acc += *(ptrSrc + i) * filter[i + APERTURE];
-                int ycurr = acc / divider;
-                *ptrDst = static_cast<Image::Byte>(ycurr);
+                pValues[colNum] = valuesFilter.Solve(pValues[colNum]);
+                pWeights[colNum] = weightsFilter.Solve(pWeights[colNum]);
             }
+        }
+    }, 16);
+
+    const int BLOCK_WIDTH = 64;
+    const int numBlocks = (width + BLOCK_WIDTH - 1) / BLOCK_WIDTH;
+    Parallel::For(0, numBlocks, [&](const int begin, const int end)
+    {
+        std::vector<ImageFilter::IIRfilter<float>> valuesFilters(BLOCK_WIDTH, filter), weightsFilters(BLOCK_WIDTH, filter);
+        for (int block = begin; block < end; ++block)
+        {
+            const int colBegin = block * BLOCK_WIDTH;
+            const int blockWidth = std::min(BLOCK_WIDTH, width - colBegin);
 
-            for (int colNum = width - APERTURE; colNum < width; ++colNum, ++ptrSrc, ++ptrDst)
+            for (int i = 0; i < blockWidth; ++i)
             {
-                int acc = 0;
-                for (int i = -APERTURE; i <= APERTURE; ++i)
-                       acc += (colNum + i >= width)
-                               ? *(ptrSrc - i) * filter[i + APERTURE]
-                               : *(ptrSrc + i) * filter[i + APERTURE];
-                int ycurr = acc / divider;
-                *ptrDst = static_cast<Image::Byte>(ycurr);
+                valuesFilters[i].Reset();
+                weightsFilters[i].Reset();
             }
+
+            auto filterRow = [&](const int rowNum)
+            {
+                float* pValues = &values[static_cast<size_t>(rowNum) * width + colBegin];
+                float* pWeights = &weights[static_cast<size_t>(rowNum) * width + colBegin];
+                for (int i = 0; i < blockWidth; ++i)
+                {
+                    pValues[i] = valuesFilters[i].Solve(pValues[i]);
+                    pWeights[i] = weightsFilters[i].Solve(pWeights[i]);
+                }
+            };
+
+            for (int rowNum = 0; rowNum < height; ++rowNum)
+                filterRow(rowNum);
+            for (int rowNum = height - 1; rowNum >= 0; --rowNum)
+                filterRow(rowNum);
         }
+    });
+}
+
+FiltrationResult ImageFilter::Bilateral(const Image& srcImg, Image& dstImg, const float spatialSigma,
+                                        const float rangeSigma/* = DEFAULT_BILATERAL_RANGE_SIGMA*/, Progress* progress/* = nullptr*/)
+{
+    BilateralBuffers buffers;
+    return Bilateral(srcImg, dstImg, spatialSigma, rangeSigma, buffers, progress);
+}
+
+void ImageFilter::PrepareBilateralBuffers(const int height, const int width, BilateralBuffers& buffers)
+{
+    const size_t size = static_cast<size_t>(width) * height;
+
+    buffers.values.resize(size);
+    buffers.weights.resize(size);
+    buffers.prevLevel.resize(size);
+}
+
+FiltrationResult ImageFilter::Bilateral(const Image& srcImg, Image& dstImg, const float spatialSigma, const float rangeSigma,
+                                        BilateralBuffers& buffers, Progress* progress/* = nullptr*/)
+{
+    if (spatialSigma < 1.0f)
+        return FiltrationResult::SMALL_FILTER_SIZE;
+    if (rangeSigma <= 0.0f)
+        return FiltrationResult::INCORRECT_FILTER_SIZE;
+    if (!srcImg.IsInitialized() || srcImg.GetWidth() != dstImg.GetWidth() || srcImg.GetHeight() != dstImg.GetHeight())
+        return FiltrationResult::INTERNAL_ERROR;
+
+    ACV_PROFILE_SCOPE_BYTES("ImageFilter::Bilateral", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
 
-        ptrSrc = tmpImg.GetRawPointer(0);
-        ptrDst = dstImg.GetRawPointer(0);
+    // The source pixels are used by all levels, so the source is copied if it is filtered in place
+    if (&srcImg == &dstImg)
+        buffers.srcCopy = srcImg;
+    const Image::Byte* pSrc = (&srcImg == &dstImg) ? buffers.srcCopy.GetRawPointer() : srcImg.GetRawPointer();
+    Image::Byte* pDst = dstImg.GetRawPointer();
 
-        for (int colNum = 0; colNum < width; ++colNum, ptrSrc -= size - 1, ptrDst -= size - 1)    // Vertical filter movement
+    const int width = srcImg.GetWidth();
+    const int height = srcImg.GetHeight();
+    PrepareBilateralBuffers(height, width, buffers);
+
+    // Levels of brightness with step which is not larger than range sigma (the first level is 0, the last one is 255)
+    const int numLevels = std::min(static_cast<int>(std::ceil(Image::MAX_PIXEL_VALUE / rangeSigma)), static_cast<int>(Image::MAX_PIXEL_VALUE)) + 1;
+    const float levelStep = static_cast<float>(Image::MAX_PIXEL_VALUE) / (numLevels - 1);
+    const float rangeCoef = -1.0f / (2.0f * rangeSigma * rangeSigma);
+
+    IIRfilter<float> filter(spatialSigma);
+    std::vector<float>& values = buffers.values;
+    std::vector<float>& weights = buffers.weights;
+    std::vector<float>& prevLevel = buffers.prevLevel;
+
+    Progress::Begin(progress, numLevels);
+
+    for (int level = 0; level < numLevels; ++level)
+    {
+        const float levelValue = level * levelStep;
+        const float prevLevelValue = levelValue - levelStep;
+
+        // Weights of brightness values by the range kernel of level
+        float rangeWeights[Image::MAX_PIXEL_VALUE + 1];
+        for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+            rangeWeights[i] = std::exp((i - levelValue) * (i - levelValue) * rangeCoef);
+
+        Parallel::For(0, height, [&](const int begin, const int end)
         {
-            for (int rowNum = 0; rowNum < APERTURE; ++rowNum, ptrSrc += width, ptrDst += width)
+            const size_t last = static_cast<size_t>(end) * width;
+            for (size_t i = static_cast<size_t>(begin) * width; i < last; ++i)
             {
-                int acc = 0;
-                for (int i = -APERTURE; i <= APERTURE; ++i)
-                       acc += (rowNum + i < 0)
-                               ? *(ptrSrc - i * width) * filter[i + APERTURE]
-                               : *(ptrSrc + i * width) * filter[i + APERTURE];
-                int ycurr = acc / divider;
-                *ptrDst = static_cast<Image::Byte>(ycurr);
+                weights[i] = rangeWeights[pSrc[i]];
+                values[i] = weights[i] * pSrc[i];
             }
+        }, 16);
 
-            for (int rowNum = APERTURE; rowNum < height - APERTURE; ++rowNum, ptrSrc += width, ptrDst += width)
-            {
-                int acc = 0;
-                for (int i = -APERTURE; i <= APERTURE; ++i)
-                       acc += *(ptrSrc + i * width) * filter[i + APERTURE];
-                int ycurr = acc / divider;
-                *ptrDst = static_cast<Image::Byte>(ycurr);
-            }
+        GaussianIIRPairPasses(values, weights, width, height, filter);
 
-            for (int rowNum = height - APERTURE; rowNum < height; ++rowNum, ptrSrc += width, ptrDst += width)
+        // Normalized result of level, the pixels with brightness between the previous and current levels are interpolated
+        Parallel::For(0, height, [&](const int begin, const int end)
+        {
+            const size_t last = static_cast<size_t>(end) * width;
+            for (size_t i = static_cast<size_t>(begin) * width; i < last; ++i)
             {
-                int acc = 0;
-                for (int i = -APERTURE; i <= APERTURE; ++i)
-                       acc += (rowNum + i >= height)
-                               ? *(ptrSrc - i * width) * filter[i + APERTURE]
-                               : *(ptrSrc + i * width) * filter[i + APERTURE];
-                int ycurr = acc / divider;
-                *ptrDst = static_cast<Image::Byte>(ycurr);
+                const float result = (weights[i] > 0.0f) ? values[i] / weights[i] : levelValue;
+                values[i] = result;
+
+                if (level > 0 && pSrc[i] >= prevLevelValue && pSrc[i] <= levelValue)
+                {
+                    const float ratio = (pSrc[i] - prevLevelValue) / levelStep;
+                    int px = static_cast<int>(prevLevel[i] + (result - prevLevel[i]) * ratio + 0.5f);
+                    Image::CheckPixelValue(px);
+                    pDst[i] = static_cast<Image::Byte>(px);
+                }
             }
-        }
+        }, 16);
 
-        return FiltrationResult::SUCCESS;
+        std::swap(values, prevLevel);
+
+        if (!Progress::Step(progress))
+            return FiltrationResult::CANCELLED;
     }
 
-    return FiltrationResult::INCORRECT_FILTER_SIZE;
+    return FiltrationResult::SUCCESS;
 }
 
-FiltrationResult ImageFilter::GaussianIIR(Image& img, float sigma)
+// Reflect the coordinate of neighbour relative to the filtered pixel as the separate Gaussian filter does
+// (the result is clamped, so the images which are smaller than filter are processed too)
+static int ReflectCoordinate(const int center, const int offset, const int size)
 {
-    if (sigma >= 1.)
-    {
-        IIRfilter<float> Filter(sigma);
-        Image::Byte* ptr = img.GetRawPointer(0);
+    const int coord = (center + offset < 0 || center + offset >= size) ? center - offset : center + offset;
+    return std::max(0, std::min(coord, size - 1));
+}
+
+// Height of strips of unsharp masking with separate filter and width of blocks of columns of unsharp masking with IIR-filter
+static const int UNSHARP_STRIP_HEIGHT = 32;
+static const int UNSHARP_BLOCK_WIDTH = 64;
+
+// The choice of blur is the same as for adaptive threshold: IIR-filter doesn't depend on the size of filter
+static bool IsUnsharpMaskIIR(const int radius)
+{
+    return 2 * radius + 1 >= 6;
+}
+
+// Unsharp masking with separate Gaussian filter. The strips of rows are processed in parallel: the rows of strip and
+// its apertures are blurred horizontally into the buffer of strip, each row of vertical pass is combined with the source
+// by the kernel of unsharp masking at once, so the blurred image isn't stored. Each strip has own part of buffers.
+// Returns false if it was cancelled
+static bool UnsharpMaskSeparate(const Image& srcImg, Image& dstImg, const std::vector<int>& filter, const int divider,
+                                const int amount, const int threshold, std::vector<Image::Byte>& stripRows,
+                                std::vector<int>& sums, std::vector<Image::Byte>& blurredRows, Progress* progress)
+{
+    const int APERTURE = static_cast<int>(filter.size()) / 2;
+    const int STRIP_HEIGHT = UNSHARP_STRIP_HEIGHT;
+    const int width = srcImg.GetWidth();
+    const int height = srcImg.GetHeight();
+    const int numStrips = (height + STRIP_HEIGHT - 1) / STRIP_HEIGHT;
+    const size_t stripSize = static_cast<size_t>(STRIP_HEIGHT + 2 * APERTURE) * width;
+    const SimdKernels& kernels = SimdKernels::Get();
 
-        auto width = img.GetWidth();
-        auto height = img.GetHeight();
+    Progress::Begin(progress, height);
 
-        for (int rowNum = 0; rowNum < height; ++rowNum, ptr += width+1)    // Horizontal IIR-filter movement
+    Parallel::For(0, numStrips, [&](const int begin, const int end)
+    {
+        for (int strip = begin; strip < end && !Progress::Cancelled(progress); ++strip)
         {
-            Filter.Reset();
-            for (int colNum = 0; colNum < width; ++colNum, ++ptr)
+            const int rowBegin = strip * STRIP_HEIGHT;
+            const int rowEnd = std::min(rowBegin + STRIP_HEIGHT, height);
+            const int bufferBegin = std::max(0, rowBegin - APERTURE);
+            const int bufferEnd = std::min(height, rowEnd + APERTURE);
+            Image::Byte* pStripRows = &stripRows[strip * stripSize];
+            int* pSums = &sums[static_cast<size_t>(strip) * width];
+            Image::Byte* pBlurredRow = &blurredRows[static_cast<size_t>(strip) * width];
+
+            // Horizontal pass over the rows of strip and its apertures
+            for (int rowNum = bufferBegin; rowNum < bufferEnd; ++rowNum)
             {
-                int ycurr = static_cast<int>( Filter.Solve(*ptr) );
-                Image::CheckPixelValue(ycurr);
-                *ptr = static_cast<Image::Byte>(ycurr);
+                const Image::Byte* pSrc = srcImg.GetRawPointer(rowNum * width);
+                Image::Byte* pDst = pStripRows + static_cast<size_t>(rowNum - bufferBegin) * width;
+                for (int colNum = 0; colNum < width; ++colNum)
+                {
+                    int acc = 0;
+                    if (colNum >= APERTURE && colNum < width - APERTURE)
+                    {
+                        for (int i = -APERTURE; i <= APERTURE; ++i)
+                            acc += pSrc[colNum + i] * filter[i + APERTURE];
+                    }
+                    else
+                    {
+                        for (int i = -APERTURE; i <= APERTURE; ++i)
+                            acc += pSrc[ReflectCoordinate(colNum, i, width)] * filter[i + APERTURE];
+                    }
+                    pDst[colNum] = static_cast<Image::Byte>(acc / divider);
+                }
             }
-            --ptr;
 
-            for (int colNum = width - 1; colNum >= 0; --colNum, --ptr)
+            // Vertical pass is fused with the difference and addition
+            for (int rowNum = rowBegin; rowNum < rowEnd; ++rowNum)
             {
-                int ycurr = static_cast<int>( Filter.Solve(*ptr) );
-                Image::CheckPixelValue(ycurr);
-                *ptr = static_cast<Image::Byte>(ycurr);
+                std::fill(pSums, pSums + width, 0);
+                for (int i = -APERTURE; i <= APERTURE; ++i)
+                {
+                    const Image::Byte* pRow = pStripRows + static_cast<size_t>(ReflectCoordinate(rowNum, i, height) - bufferBegin) * width;
+                    const int coef = filter[i + APERTURE];
+                    for (int colNum = 0; colNum < width; ++colNum)
+                        pSums[colNum] += pRow[colNum] * coef;
+                }
+                for (int colNum = 0; colNum < width; ++colNum)
+                    pBlurredRow[colNum] = static_cast<Image::Byte>(pSums[colNum] / divider);
+
+                kernels.UnsharpMaskRow(srcImg.GetRawPointer(rowNum * width), pBlurredRow,
+                                       dstImg.GetRawPointer(rowNum * width), width, amount, threshold);
             }
 
+            Progress::Step(progress, rowEnd - rowBegin);
+        }
+    });
+
+    return !Progress::Cancelled(progress);
+}
+
+// Unsharp masking with IIR-filter. The rows of horizontal pass are processed in parallel into the blurred image,
+// the vertical pass runs along rows over blocks of columns (each column has own filter) and the rows of its backward run
+// are combined with the source by the kernel of unsharp masking at once. Each run starts from the state of constant
+// signal equal to the first value, so the borders aren't darkened (it would give the false edges of mask).
+// Returns false if it was cancelled
+static bool UnsharpMaskIIR(const Image& srcImg, Image& dstImg, const ImageFilter::IIRfilter<float>& filter,
+                           const int amount, const int threshold, std::vector<float>& blurred,
+                           std::vector<ImageFilter::IIRfilter<float>>& columnFilters, std::vector<Image::Byte>& blurredRows,
+                           Progress* progress)
+{
+    const int BLOCK_WIDTH = UNSHARP_BLOCK_WIDTH;
+    const int width = srcImg.GetWidth();
+    const int height = srcImg.GetHeight();
+    const int numBlocks = (width + BLOCK_WIDTH - 1) / BLOCK_WIDTH;
+    const SimdKernels& kernels = SimdKernels::Get();
+
+    // Each row of horizontal pass and each column of vertical pass are the steps of progress
+    Progress::Begin(progress, height + width);
+
+    Parallel::For(0, height, [&](const int begin, const int end)
+    {
+        ImageFilter::IIRfilter<float> rowFilter(filter);
+        for (int rowNum = begin; rowNum < end && !Progress::Cancelled(progress); ++rowNum)
+        {
+            const Image::Byte* pSrc = srcImg.GetRawPointer(rowNum * width);
+            float* pBlurred = &blurred[static_cast<size_t>(rowNum) * width];
+
+            rowFilter.Reset(pSrc[0], pSrc[0], pSrc[0]);
+            for (int colNum = 0; colNum < width; ++colNum)
+                pBlurred[colNum] = rowFilter.Solve(pSrc[colNum]);
+
+            const float last = pBlurred[width - 1];
+            rowFilter.Reset(last, last, last);
+            for (int colNum = width - 1; colNum >= 0; --colNum)
+                pBlurred[colNum] = rowFilter.Solve(pBlurred[colNum]);
+
+            Progress::Step(progress);
         }
+    }, 16);
+
+    if (Progress::Cancelled(progress))
+        return false;
 
-        ptr = img.GetRawPointer(0);
-        for (int colNum = 0; colNum < width; ++colNum , ptr += width+1)    // Vertical IIR-filter movement
+    Parallel::For(0, numBlocks, [&](const int begin, const int end)
+    {
+        for (int block = begin; block < end && !Progress::Cancelled(progress); ++block)
         {
-            Filter.Reset();
-            for (int rowNum = 0; rowNum < height; ++rowNum, ptr += width)
+            const int colBegin = block * BLOCK_WIDTH;
+            const int blockWidth = std::min(BLOCK_WIDTH, width - colBegin);
+            ImageFilter::IIRfilter<float>* filters = &columnFilters[colBegin];
+            Image::Byte* pBlurredRow = &blurredRows[colBegin];
+
+            const float* pTop = &blurred[colBegin];
+            for (int i = 0; i < blockWidth; ++i)
+                filters[i].Reset(pTop[i], pTop[i], pTop[i]);
+            for (int rowNum = 0; rowNum < height; ++rowNum)
             {
-                int ycurr = static_cast<int>( Filter.Solve(*ptr) );
-                Image::CheckPixelValue(ycurr);
-                *ptr = static_cast<Image::Byte>(ycurr);
-             }
-            ptr -= width;
+                float* pBlurred = &blurred[static_cast<size_t>(rowNum) * width + colBegin];
+                for (int i = 0; i < blockWidth; ++i)
+                    pBlurred[i] = filters[i].Solve(pBlurred[i]);
+            }
 
-            for (int rowNum = height - 1; rowNum >= 0; --rowNum, ptr -= width)
+            const float* pBottom = &blurred[static_cast<size_t>(height - 1) * width + colBegin];
+            for (int i = 0; i < blockWidth; ++i)
+                filters[i].Reset(pBottom[i], pBottom[i], pBottom[i]);
+            for (int rowNum = height - 1; rowNum >= 0; --rowNum)
             {
-                int ycurr = static_cast<int>( Filter.Solve(*ptr) );
-                Image::CheckPixelValue(ycurr);
-                *ptr = static_cast<Image::Byte>(ycurr);
+                const float* pBlurred = &blurred[static_cast<size_t>(rowNum) * width + colBegin];
+                for (int i = 0; i < blockWidth; ++i)
+                {
+                    int px = static_cast<int>(filters[i].Solve(pBlurred[i]) + 0.5f);
+                    Image::CheckPixelValue(px);
+                    pBlurredRow[i] = static_cast<Image::Byte>(px);
+                }
+
+                kernels.UnsharpMaskRow(srcImg.GetRawPointer(rowNum * width + colBegin), pBlurredRow,
+                                       dstImg.GetRawPointer(rowNum * width + colBegin), blockWidth, amount, threshold);
             }
+
+            Progress::Step(progress, blockWidth);
         }
+    });
 
-        return FiltrationResult::SUCCESS;
+    return !Progress::Cancelled(progress);
+}
+
+void ImageFilter::PrepareUnsharpMaskBuffers(const int height, const int width, const int radius, UnsharpMaskBuffers& buffers)
+{
+    const int filterSize = 2 * radius + 1;
+
+    if (IsUnsharpMaskIIR(radius))
+    {
+        // Each column has own filter and own pixel of blurred row
+        buffers.blurred.resize(static_cast<size_t>(width) * height);
+        buffers.columnFilters.assign(width, IIRfilter<float>(static_cast<float>(filterSize / 6.0)));
+        buffers.blurredRows.resize(width);
+    }
+    else
+    {
+        // Each strip has own rows
+        const size_t numStrips = (height + UNSHARP_STRIP_HEIGHT - 1) / UNSHARP_STRIP_HEIGHT;
+        FormSeparateGaussianFilter(filterSize, buffers.filter, buffers.divider);
+        buffers.stripRows.resize(numStrips * (UNSHARP_STRIP_HEIGHT + 2 * radius) * width);
+        buffers.sums.resize(numStrips * width);
+        buffers.blurredRows.resize(numStrips * width);
     }
+}
 
-    return FiltrationResult::SMALL_FILTER_SIZE;
+FiltrationResult ImageFilter::UnsharpMask(const Image& srcImg, Image& dstImg, const int radius,
+                                          const int amount/* = DEFAULT_UNSHARP_AMOUNT*/, const int threshold/* = DEFAULT_UNSHARP_THRESHOLD*/,
+                                          Progress* progress/* = nullptr*/)
+{
+    UnsharpMaskBuffers buffers;
+    return UnsharpMask(srcImg, dstImg, radius, amount, threshold, buffers, progress);
 }
 
-FiltrationResult ImageFilter::GaussianIIR(const Image& srcImg, Image& dstImg, float sigma)
+FiltrationResult ImageFilter::UnsharpMask(const Image& srcImg, Image& dstImg, const int radius, const int amount, const int threshold,
+                                          UnsharpMaskBuffers& buffers, Progress* progress/* = nullptr*/)
+{
+    if (radius < 1)
+        return FiltrationResult::SMALL_FILTER_SIZE;
+    if (amount < 0)
+        return FiltrationResult::INCORRECT_FILTER_SIZE;
+    if (!srcImg.IsInitialized() || srcImg.GetWidth() != dstImg.GetWidth() || srcImg.GetHeight() != dstImg.GetHeight())
+        return FiltrationResult::INTERNAL_ERROR;
+
+    ACV_PROFILE_SCOPE_BYTES("ImageFilter::UnsharpMask", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
+    // Amount in percents is converted to the fixed-point factor of kernel
+    const int fixedAmount = static_cast<int>(std::min<long long>(
+        (static_cast<long long>(amount) * SimdKernels::UNSHARP_AMOUNT_ONE + 50) / 100, SimdKernels::UNSHARP_AMOUNT_MAX));
+
+    PrepareUnsharpMaskBuffers(srcImg.GetHeight(), srcImg.GetWidth(), radius, buffers);
+
+    bool ret;
+    if (IsUnsharpMaskIIR(radius))
+    {
+        // The source pixel is read just before the writing of result pixel, so the filtration in place is allowed
+        IIRfilter<float> filter(static_cast<float>((2 * radius + 1) / 6.0));
+        ret = UnsharpMaskIIR(srcImg, dstImg, filter, fixedAmount, threshold, buffers.blurred, buffers.columnFilters,
+                             buffers.blurredRows, progress);
+    }
+    else
+    {
+        // The strips read the rows of neighbour strips, so the source is copied if it is filtered in place
+        if (&srcImg == &dstImg)
+            buffers.srcCopy = srcImg;
+        ret = UnsharpMaskSeparate((&srcImg == &dstImg) ? buffers.srcCopy : srcImg, dstImg, buffers.filter, buffers.divider,
+                                  fixedAmount, threshold, buffers.stripRows, buffers.sums, buffers.blurredRows, progress);
+    }
+
+    return ret ? FiltrationResult::SUCCESS : FiltrationResult::CANCELLED;
+}
+
+FiltrationResult ImageFilter::GaussianIIR(const Image& srcImg, Image& dstImg, float sigma, Progress* progress)
 {
     if (sigma < 1.0)
         return FiltrationResult::SMALL_FILTER_SIZE;
 
     memcpy(dstImg.GetRawPointer(), srcImg.GetRawPointer(), srcImg.GetHeight() * srcImg.GetWidth());
-    FiltrationResult ret = GaussianIIR(dstImg, sigma);
+    FiltrationResult ret = GaussianIIR(dstImg, sigma, progress);
 
     return ret;
 }
 
-FiltrationResult ImageFilter::Gaussian(const Image& srcImg, Image& dstImg, const int filterSize)
+FiltrationResult ImageFilter::Gaussian(const Image& srcImg, Image& dstImg, const int filterSize, Progress* progress)
 {
     if (filterSize % 2 == 0)
         return FiltrationResult::INCORRECT_FILTER_SIZE;
 
     memcpy(dstImg.GetRawPointer(), srcImg.GetRawPointer(), srcImg.GetHeight() * srcImg.GetWidth());
-    FiltrationResult ret = Gaussian(dstImg, filterSize);
+    FiltrationResult ret = Gaussian(dstImg, filterSize, progress);
 
     return ret;
 }
 
-FiltrationResult ImageFilter::Sharpen(Image& img)
+FiltrationResult ImageFilter::Sharpen(Image& img, Progress* progress)
 {
+    ACV_PROFILE_SCOPE_BYTES("ImageFilter::Sharpen", static_cast<long long>(img.GetHeight()) * img.GetWidth());
+
     // Creation of the sharpen filter
     MatrixFilter<int> filter(3, 1);
+    FormSharpenFilter(filter);
 
-    filter[0][0] = -1; filter[0][1] = -1; filter[0][2] = -1;
-    filter[1][0] = -1; filter[1][1] =  9; filter[1][2] = -1;
-    filter[2][0] = -1; filter[2][1] = -1; filter[2][2] = -1;
+    // The convolution is not divided, so it is the single step of progress
+    Progress::Begin(progress, 1);
 
     bool ret = MatrixFilterOperations::FastConvolutionImage<int>(img, filter);
+    if (ret && !Progress::Step(progress))
+        return FiltrationResult::CANCELLED;
+
     return (ret) ? FiltrationResult::SUCCESS : FiltrationResult::INTERNAL_ERROR;
 }
 
-FiltrationResult ImageFilter::Sharpen(const Image& srcImg, Image& dstImg)
+void ImageFilter::FormSharpenFilter(MatrixFilter<int>& filter)
+{
+    filter[0][0] = -1; filter[0][1] = -1; filter[0][2] = -1;
+    filter[1][0] = -1; filter[1][1] =  9; filter[1][2] = -1;
+    filter[2][0] = -1; filter[2][1] = -1; filter[2][2] = -1;
+    filter.SetDivider(1);
+}
+
+FiltrationResult ImageFilter::Sharpen(const Image& srcImg, Image& dstImg, Progress* progress)
 {
     memcpy(dstImg.GetRawPointer(), srcImg.GetRawPointer(), srcImg.GetHeight() * srcImg.GetWidth());
-    FiltrationResult ret = Sharpen(dstImg);
+    FiltrationResult ret = Sharpen(dstImg, progress);
 
     return ret;
 }
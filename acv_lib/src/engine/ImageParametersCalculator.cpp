@@ -27,9 +27,9 @@
 #include <cmath>
 #include <vector>
 #include <map>
-#include <set>
 
 #include "ImageParametersCalculator.h"
+#include "Histogram.h"
 
 
 namespace acv {
@@ -54,26 +54,26 @@ double ImageParametersCalculator::CalcEntropy()
     if (!mImage || !mImage->IsInitialized())
         return 0.0;
 
-    // Each element of vector contains the number of image pixels
-    // with brightness value which is equal to index of vector (Lebesgue measure)
-    std::vector<size_t> mz(Image::MAX_PIXEL_VALUE + 1, 0);
+    return CalcEntropy(Histogram(*mImage));
+}
 
-    // Calculate of the volume of brightness and Lebesgue measure
-    int V = 0;
-    for (auto imgPix : mImage->GetData())
-    {
-        Image::Byte z = imgPix;
+double ImageParametersCalculator::CalcEntropy(const Histogram& histogram)
+{
+    // Each bin of histogram contains the number of image pixels
+    // with brightness value which is equal to index of bin (Lebesgue measure)
+    const Histogram::Bins& mz = histogram.GetBins();
 
-        V += z;
-        ++mz[z];
-    }
+    // Calculate of the volume of brightness
+    double V = 0.0;
+    for (int z = 0; z < Histogram::NUM_BINS; ++z)
+        V += static_cast<double>(z) * mz[z];
 
     // Calculate of entropy
     const double LOG2 = log(2.0);
     double EX = 0.0;
-    for (size_t z = 0; z < mz.size(); ++z)
+    for (int z = 0; z < Histogram::NUM_BINS; ++z)
     {
-        double px = static_cast<double>(z * mz[z])/ V;
+        double px = static_cast<double>(z) * mz[z] / V;
         if (px > 0.0)
             EX += px * log(px) / LOG2;
     }
@@ -196,8 +196,12 @@ void ImageParametersCalculator::CreateBrightnessHistogram(std::vector<double>& b
     if (!mImage || !mImage->IsInitialized())
         return;
 
-    for (auto imgPix : mImage->GetData()) // filling vector of brightness histogram
-        ++brightnessHistogram[imgPix];
+    if (brightnessHistogram.size() < Histogram::NUM_BINS)
+        brightnessHistogram.resize(Histogram::NUM_BINS, 0.0);
+
+    const Histogram histogram(*mImage);
+    for (int i = 0; i < Histogram::NUM_BINS; ++i) // filling vector of brightness histogram
+        brightnessHistogram[i] += histogram.GetBins()[i];
 }
 
 double ImageParametersCalculator::CalcStandardDeviation(const double aver)
@@ -224,12 +228,7 @@ size_t ImageParametersCalculator::CalcNumberInformationLevels()
     if (!mImage || !mImage->IsInitialized())
         return 0;
 
-    std::set<Image::Byte> levels;
-
-    for (auto imgPix : mImage->GetData())
-        levels.insert(imgPix);
-
-    return levels.size();
+    return Histogram(*mImage).GetNumLevels();
 }
 
 double ImageParametersCalculator::CalcIntegralQualityIndicator()
@@ -246,6 +245,13 @@ double ImageParametersCalculator::CalcIntegralQualityIndicator()
     double entr = CalcEntropy();
     size_t numLevels = CalcNumberInformationLevels();
 
+    iqi = CalcIntegralQualityIndicator(minBrig, maxBrig, averBrig, stdDev, entr, numLevels);
+    return iqi;
+}
+
+double ImageParametersCalculator::CalcIntegralQualityIndicator(const Image::Byte minBrig, const Image::Byte maxBrig, const double averBrig,
+                                                               const double stdDev, const double entr, const size_t numLevels)
+{
     double Ln;
     if (averBrig <= 107)
         Ln = averBrig / 128;
@@ -262,8 +268,35 @@ double ImageParametersCalculator::CalcIntegralQualityIndicator()
     double Nn = numLevels / 256;
     double En = entr / 8;
 
-    iqi = 0.33 * Ln + 0.27 * Sn + 0.20 * Kn + 0.13 * Nn + 0.07 * En;
-    return iqi;
+    return 0.33 * Ln + 0.27 * Sn + 0.20 * Kn + 0.13 * Nn + 0.07 * En;
+}
+
+bool ImageParametersCalculator::CalcParameters(Parameters& params)
+{
+    if (!mImage || !mImage->IsInitialized())
+        return false;
+
+    const Histogram histogram(*mImage);
+    const Histogram::Bins& bins = histogram.GetBins();
+    const double numPixels = static_cast<double>(histogram.GetTotal());
+
+    double sum = 0.0;
+    for (int z = 0; z < Histogram::NUM_BINS; ++z)
+        sum += static_cast<double>(z) * bins[z];
+    params.averageBrightness = sum / numPixels;
+
+    // Sample standard deviation (as in CalcStandardDeviation)
+    double sd = 0.0;
+    for (int z = 0; z < Histogram::NUM_BINS; ++z)
+        sd += (z - params.averageBrightness) * (z - params.averageBrightness) * bins[z];
+    params.standardDeviation = sqrt(sd / (numPixels - 1));
+
+    histogram.GetMinMax(params.minBrightness, params.maxBrightness);
+    params.entropy = CalcEntropy(histogram);
+    params.integralQualityIndicator = CalcIntegralQualityIndicator(params.minBrightness, params.maxBrightness, params.averageBrightness,
+                                                                   params.standardDeviation, params.entropy, histogram.GetNumLevels());
+
+    return true;
 }
 
 }
@@ -0,0 +1,192 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of labels image
+
+#include <algorithm>
+
+#include "LabelImage.h"
+#include "Image.h"
+#include "BinaryImage.h"
+
+namespace acv {
+
+LabelImage::LabelImage()
+    : mLabels(),
+      mWidth(0),
+      mHeight(0),
+      mNumLabels(0)
+{ }
+
+LabelImage::LabelImage(const int height, const int width)
+    : mLabels(height * width, 0),
+      mWidth(width),
+      mHeight(height),
+      mNumLabels(0)
+{ }
+
+// Find the root of provisional label with path compression
+static int FindRoot(std::vector<int>& parents, int label)
+{
+    while (parents[label] != label)
+    {
+        parents[label] = parents[parents[label]];
+        label = parents[label];
+    }
+    return label;
+}
+
+// Union two provisional labels (the root is the smaller label to keep the raster order)
+static void Union(std::vector<int>& parents, const int label1, const int label2)
+{
+    int root1 = FindRoot(parents, label1);
+    int root2 = FindRoot(parents, label2);
+
+    if (root1 < root2)
+        parents[root2] = root1;
+    else if (root2 < root1)
+        parents[root1] = root2;
+}
+
+// Label the connected components (8-connectivity) of runs of rows
+// getRuns(rowNum, rowRuns) finds the runs of non-zero pixels of row in order of columns
+template <typename RunsGetter>
+static void LabelRuns(const int height, const int width, const RunsGetter& getRuns, LabelImage& labels)
+{
+    // Run of non-zero pixels with its row and label
+    struct Run
+    {
+        int row;
+        int startX;
+        int finishX;
+        int label;
+    };
+
+    std::vector<Run> runs;
+    std::vector<BinaryImage::Run> rowRuns;
+    std::vector<int> parents(1, 0); // Provisional label 0 is background
+
+    // The first pass: the runs are collected and get the provisional labels
+    size_t prevRowBegin = 0, prevRowEnd = 0;
+    for (int row = 0; row < height; ++row)
+    {
+        size_t curRowBegin = runs.size();
+        size_t prevIdx = prevRowBegin;
+
+        getRuns(row, rowRuns);
+        for (const auto& rowRun : rowRuns)
+        {
+            Run run = { row, rowRun.startX, rowRun.finishX, 0 };
+
+            // Skip the runs of previous row which are to the left of current run (taking into account the diagonals)
+            while (prevIdx < prevRowEnd && runs[prevIdx].finishX < run.startX - 1)
+                ++prevIdx;
+
+            // All runs of previous row which intersect current run are belong to the same component
+            for (size_t i = prevIdx; i < prevRowEnd && runs[i].startX <= run.finishX + 1; ++i)
+            {
+                if (run.label == 0)
+                    run.label = runs[i].label;
+                else
+                    Union(parents, run.label, runs[i].label);
+            }
+
+            if (run.label == 0)
+            {
+                run.label = static_cast<int>(parents.size());
+                parents.push_back(run.label);
+            }
+
+            runs.push_back(run);
+        }
+
+        prevRowBegin = curRowBegin;
+        prevRowEnd = runs.size();
+    }
+
+    // Resolve the equivalences of provisional labels to the final sequential labels
+    std::vector<int> finalLabels(parents.size(), 0);
+    int numLabels = 0;
+    for (size_t label = 1; label < parents.size(); ++label)
+    {
+        int root = FindRoot(parents, static_cast<int>(label));
+        finalLabels[label] = (root == static_cast<int>(label)) ? ++numLabels : finalLabels[root];
+    }
+
+    // The second pass: the runs are written to the image of labels
+    labels = LabelImage(height, width);
+    labels.SetNumLabels(numLabels);
+    for (const auto& run : runs)
+    {
+        int* pDst = &labels.GetData()[run.row * width];
+        std::fill(pDst + run.startX, pDst + run.finishX + 1, finalLabels[run.label]);
+    }
+}
+
+bool LabelImage::LabelConnectedComponents(const Image& img, LabelImage& labels)
+{
+    if (!img.IsInitialized())
+        return false;
+
+    const int width = img.GetWidth();
+
+    LabelRuns(img.GetHeight(), width, [&](const int row, std::vector<BinaryImage::Run>& rowRuns)
+    {
+        const Image::Byte* pRow = img.GetRawPointer(row * width);
+        rowRuns.clear();
+
+        for (int col = 0; col < width; )
+        {
+            if (pRow[col] == Image::MIN_PIXEL_VALUE)
+            {
+                ++col;
+                continue;
+            }
+
+            BinaryImage::Run run = { col, col };
+            while (col < width && pRow[col] != Image::MIN_PIXEL_VALUE)
+                run.finishX = col++;
+
+            rowRuns.push_back(run);
+        }
+    }, labels);
+
+    return true;
+}
+
+bool LabelImage::LabelConnectedComponents(const BinaryImage& img, LabelImage& labels)
+{
+    if (!img.IsInitialized())
+        return false;
+
+    // The runs are found by words, so the background is skipped by 64 pixels at once
+    LabelRuns(img.GetHeight(), img.GetWidth(), [&img](const int row, std::vector<BinaryImage::Run>& rowRuns)
+    {
+        img.FindRuns(row, rowRuns);
+    }, labels);
+
+    return true;
+}
+
+}
@@ -25,7 +25,32 @@
 // This file is used to implementation the methods of classes that are work with matrix filter and do operations with him
 
 #include "MatrixFilter.h"
+#include "SimdKernels.h"
+#include "Parallel.h"
 
 namespace acv {
 
+void MatrixFilterOperations::ConvolutionExpandedRows(const Image& expandedImg, Image& dstImg, const MatrixFilter<int>& filter)
+{
+    const int filterSize = filter.GetSize();
+    const int expandedWidth = expandedImg.GetWidth();
+    const int width = dstImg.GetWidth();
+
+    // The kernels use the filter as continuous array
+    std::vector<int> coefs;
+    coefs.reserve(filterSize * filterSize);
+    for (int row = 0; row < filterSize; ++row)
+        coefs.insert(coefs.end(), filter[row].begin(), filter[row].end());
+
+    const SimdKernels& kernels = SimdKernels::Get();
+    Parallel::For(0, dstImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
+    {
+        for (int rowNum = rowBegin; rowNum < rowEnd; ++rowNum)
+        {
+            kernels.ConvolveRow(expandedImg.GetRawPointer(rowNum * expandedWidth), expandedWidth, coefs.data(), filterSize,
+                                filter.GetDivider(), dstImg.GetRawPointer(rowNum * width), width);
+        }
+    }, 16);
+}
+
 }
@@ -0,0 +1,395 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of one-pass moments calculator
+
+#include <cmath>
+#include <algorithm>
+
+#include "MomentsCalculator.h"
+#include "Image.h"
+#include "LabelImage.h"
+#include "Parallel.h"
+
+namespace acv {
+
+RawMoments::RawMoments()
+    : m00(0.0), m10(0.0), m01(0.0),
+      m20(0.0), m11(0.0), m02(0.0),
+      m30(0.0), m21(0.0), m12(0.0), m03(0.0)
+{ }
+
+RawMoments& RawMoments::operator += (const RawMoments& rhs)
+{
+    m00 += rhs.m00; m10 += rhs.m10; m01 += rhs.m01;
+    m20 += rhs.m20; m11 += rhs.m11; m02 += rhs.m02;
+    m30 += rhs.m30; m21 += rhs.m21; m12 += rhs.m12; m03 += rhs.m03;
+    return *this;
+}
+
+RawMoments& RawMoments::operator -= (const RawMoments& rhs)
+{
+    m00 -= rhs.m00; m10 -= rhs.m10; m01 -= rhs.m01;
+    m20 -= rhs.m20; m11 -= rhs.m11; m02 -= rhs.m02;
+    m30 -= rhs.m30; m21 -= rhs.m21; m12 -= rhs.m12; m03 -= rhs.m03;
+    return *this;
+}
+
+// Accumulate the sums of one row: s[p] = sum(w * x^p), x is counted from x0
+// The sums up to the second order are accumulated in integers, they can't overflow for width < 32768
+static void AccumulateRowSums(const Image::Byte* pRow, const int width, const int x0,
+                              MomentsCalculator::WeightType weightType, double s[4])
+{
+    long long s0 = 0, s1 = 0, s2 = 0;
+    double s3 = 0.0;
+
+    for (int col = 0, x = x0; col < width; ++col, ++x)
+    {
+        long long w = (weightType == MomentsCalculator::WeightType::BINARY)
+                      ? (pRow[col] > Image::MIN_PIXEL_VALUE)
+                      : pRow[col];
+        long long wx = w * x;
+        long long wxx = wx * x;
+
+        s0 += w;
+        s1 += wx;
+        s2 += wxx;
+        s3 += static_cast<double>(wxx) * x;
+    }
+
+    s[0] = static_cast<double>(s0);
+    s[1] = static_cast<double>(s1);
+    s[2] = static_cast<double>(s2);
+    s[3] = s3;
+}
+
+// Add the sums of row with coordinate y to the moments
+static void AddRowSums(const double s[4], const double y, RawMoments& m)
+{
+    double yy = y * y;
+
+    m.m00 += s[0];
+    m.m10 += s[1];
+    m.m20 += s[2];
+    m.m30 += s[3];
+    m.m01 += s[0] * y;
+    m.m11 += s[1] * y;
+    m.m21 += s[2] * y;
+    m.m02 += s[0] * yy;
+    m.m12 += s[1] * yy;
+    m.m03 += s[0] * yy * y;
+}
+
+// Calculate the sums of run of pixels with unit weights from x = a to x = b: s[p] = sum(x^p)
+// The closed forms of power sums are used: F1(n) = n(n+1)/2, F2(n) = n(n+1)(2n+1)/6, F3(n) = F1(n)^2
+static void CalcUnitRunSums(const double a, const double b, double s[4])
+{
+    double f1b = b * (b + 1.0) / 2.0, f1a = (a - 1.0) * a / 2.0;
+    double f2b = f1b * (2.0 * b + 1.0) / 3.0, f2a = f1a * (2.0 * a - 1.0) / 3.0;
+
+    s[0] = b - a + 1.0;
+    s[1] = f1b - f1a;
+    s[2] = f2b - f2a;
+    s[3] = f1b * f1b - f1a * f1a;
+}
+
+bool MomentsCalculator::CalcRawMoments(const Image& img, const int xStart, const int yStart, const int xEnd, const int yEnd,
+                                       RawMoments& moments, WeightType weightType/* = WeightType::BINARY*/)
+{
+    if (xStart > xEnd || yStart > yEnd)
+        return false;
+    if (img.IsInvalidCoordinates(yStart, xStart) || img.IsInvalidCoordinates(yEnd, xEnd))
+        return false;
+
+    moments = RawMoments();
+
+    const int width = xEnd - xStart + 1;
+    double s[4];
+    for (int row = yStart; row <= yEnd; ++row)
+    {
+        AccumulateRowSums(img.GetRawPointer(row * img.GetWidth() + xStart), width, 0, weightType, s);
+        AddRowSums(s, row - yStart, moments);
+    }
+
+    return true;
+}
+
+CentralMoments MomentsCalculator::CalcCentralMoments(const RawMoments& raw)
+{
+    CentralMoments mu = { raw.m00, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+    if (raw.m00 <= 0.0)
+        return mu;
+
+    // The center of gravity coordinates
+    double xc = raw.m10 / raw.m00;
+    double yc = raw.m01 / raw.m00;
+
+    mu.mu20 = raw.m20 - xc * raw.m10;
+    mu.mu02 = raw.m02 - yc * raw.m01;
+    mu.mu11 = raw.m11 - xc * raw.m01;
+    mu.mu30 = raw.m30 - 3.0 * xc * raw.m20 + 2.0 * xc * xc * raw.m10;
+    mu.mu03 = raw.m03 - 3.0 * yc * raw.m02 + 2.0 * yc * yc * raw.m01;
+    mu.mu21 = raw.m21 - 2.0 * xc * raw.m11 - yc * raw.m20 + 2.0 * xc * xc * raw.m01;
+    mu.mu12 = raw.m12 - 2.0 * yc * raw.m11 - xc * raw.m02 + 2.0 * yc * yc * raw.m10;
+
+    return mu;
+}
+
+HuMoments MomentsCalculator::CalcHuMoments(const RawMoments& raw)
+{
+    HuMoments hu;
+    hu.fill(0.0);
+
+    CentralMoments mu = CalcCentralMoments(raw);
+    if (mu.mu00 <= 0.0)
+        return hu;
+
+    // Normalized central moments: nu(p,q) = mu(p,q) / mu00^((p + q) / 2 + 1)
+    double norm2 = mu.mu00 * mu.mu00;
+    double norm3 = norm2 * sqrt(mu.mu00);
+
+    double nu20 = mu.mu20 / norm2;
+    double nu02 = mu.mu02 / norm2;
+    double nu11 = mu.mu11 / norm2;
+    double nu30 = mu.mu30 / norm3;
+    double nu03 = mu.mu03 / norm3;
+    double nu12 = mu.mu12 / norm3;
+    double nu21 = mu.mu21 / norm3;
+
+    double nu30MinusNu12_3 = nu30 - 3 * nu12;
+    double nu21_3 = 3 * nu21;
+    double nu21PlusNu03 = nu21 + nu03;
+    double nu30PlusNu12 = nu30 + nu12;
+    double sqrNu30PlusNu12 = nu30PlusNu12 * nu30PlusNu12;
+    double sqrNu21PlusNu03 = nu21PlusNu03 * nu21PlusNu03;
+    double op1 = nu21PlusNu03 * (3 * sqrNu30PlusNu12 - sqrNu21PlusNu03);
+    double op2 = nu30PlusNu12 * (sqrNu30PlusNu12 - 3 * sqrNu21PlusNu03);
+    double nu20MinusNu02 = nu20 - nu02;
+    double nu21_3MinusNu03 = nu21_3 - nu03;
+
+    hu[1] = nu20 + nu02;
+    hu[2] = nu20MinusNu02 * nu20MinusNu02 + 4 * nu11 * nu11;
+    hu[3] = nu30MinusNu12_3 * nu30MinusNu12_3 + nu21_3MinusNu03 * nu21_3MinusNu03;
+    hu[4] = sqrNu30PlusNu12 + sqrNu21PlusNu03;
+    hu[5] = nu30MinusNu12_3 * op2 + nu21_3MinusNu03 * op1;
+    hu[6] = nu20MinusNu02 * (sqrNu30PlusNu12 - sqrNu21PlusNu03) + 4 * nu11 * nu30PlusNu12 * nu21PlusNu03;
+    hu[7] = nu21_3MinusNu03 * op2 + (3 * nu12 - nu30) * op1;
+
+    return hu;
+}
+
+bool MomentsCalculator::CalcHuMoments(const Image& img, const int xStart, const int yStart, const int xEnd, const int yEnd,
+                                      HuMoments& moments, WeightType weightType/* = WeightType::BINARY*/)
+{
+    RawMoments raw;
+    if (!CalcRawMoments(img, xStart, yStart, xEnd, yEnd, raw, weightType))
+        return false;
+
+    moments = CalcHuMoments(raw);
+    return true;
+}
+
+bool MomentsCalculator::CalcDenseHuMoments(const Image& img, const int winWidth, const int winHeight,
+                                           std::vector<HuMoments>& moments, WeightType weightType/* = WeightType::BINARY*/)
+{
+    if (!img.IsInitialized() || winWidth <= 0 || winHeight <= 0 ||
+        winWidth > img.GetWidth() || winHeight > img.GetHeight())
+        return false;
+
+    const int numRows = img.GetHeight() - winHeight + 1;
+    const int numCols = img.GetWidth() - winWidth + 1;
+
+    // Hu's moments are invariant to translation, so the moments of each window
+    // can be calculated from integral images with the common origin of coordinates
+    IntegralMoments integral(img, weightType);
+
+    moments.resize(static_cast<size_t>(numRows) * numCols);
+    auto it = moments.begin();
+    for (int row = 0; row < numRows; ++row)
+        for (int col = 0; col < numCols; ++col)
+            *it++ = CalcHuMoments(integral.GetRawMoments(col, row, col + winWidth - 1, row + winHeight - 1));
+
+    return true;
+}
+
+bool MomentsCalculator::CalcHuMoments(const Image& img, const std::vector<Roi>& rois,
+                                      std::vector<HuMoments>& moments, WeightType weightType/* = WeightType::BINARY*/)
+{
+    for (const auto& roi : rois)
+    {
+        if (roi.xStart > roi.xEnd || roi.yStart > roi.yEnd)
+            return false;
+        if (img.IsInvalidCoordinates(roi.yStart, roi.xStart) || img.IsInvalidCoordinates(roi.yEnd, roi.xEnd))
+            return false;
+    }
+
+    moments.resize(rois.size());
+
+    Parallel::For(0, static_cast<int>(rois.size()), [&](const int begin, const int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            const Roi& roi = rois[i];
+            CalcHuMoments(img, roi.xStart, roi.yStart, roi.xEnd, roi.yEnd, moments[i], weightType);
+        }
+    });
+
+    return true;
+}
+
+bool MomentsCalculator::CalcRawMoments(const Image& img, const LabelImage& labels,
+                                       std::vector<RawMoments>& moments, WeightType weightType/* = WeightType::BINARY*/)
+{
+    if (!img.IsInitialized() || img.GetWidth() != labels.GetWidth() || img.GetHeight() != labels.GetHeight())
+        return false;
+
+    const int width = img.GetWidth();
+    const int height = img.GetHeight();
+    const int numLabels = labels.GetNumLabels();
+    const int x0 = -width / 2;
+    const int y0 = -height / 2;
+
+    // Each stripe of rows has own accumulators of all labels, they are summed after the pass
+    const int numStripes = std::min(Parallel::GetNumThreads(), height);
+    std::vector<std::vector<RawMoments>> stripeMoments(numStripes, std::vector<RawMoments>(numLabels));
+
+    Parallel::For(0, numStripes, [&](const int begin, const int end)
+    {
+        for (int stripe = begin; stripe < end; ++stripe)
+        {
+            std::vector<RawMoments>& accumulators = stripeMoments[stripe];
+            const int rowBegin = static_cast<int>(static_cast<long long>(height) * stripe / numStripes);
+            const int rowEnd = static_cast<int>(static_cast<long long>(height) * (stripe + 1) / numStripes);
+
+            for (int row = rowBegin; row < rowEnd; ++row)
+            {
+                const Image::Byte* pRow = img.GetRawPointer(row * width);
+                const int* pLabels = &labels.GetData()[row * width];
+                double s[4];
+
+                // The runs of pixels with the same label are accumulated at once
+                for (int col = 0; col < width; )
+                {
+                    const int label = pLabels[col];
+                    if (label <= 0 || label > numLabels ||
+                        (weightType == WeightType::BINARY && pRow[col] == Image::MIN_PIXEL_VALUE))
+                    {
+                        ++col;
+                        continue;
+                    }
+
+                    int runEnd = col + 1;
+                    if (weightType == WeightType::BINARY)
+                    {
+                        while (runEnd < width && pLabels[runEnd] == label && pRow[runEnd] != Image::MIN_PIXEL_VALUE)
+                            ++runEnd;
+                        CalcUnitRunSums(x0 + col, x0 + runEnd - 1, s);
+                    }
+                    else
+                    {
+                        while (runEnd < width && pLabels[runEnd] == label)
+                            ++runEnd;
+                        AccumulateRowSums(pRow + col, runEnd - col, x0 + col, weightType, s);
+                    }
+
+                    AddRowSums(s, y0 + row, accumulators[label - 1]);
+                    col = runEnd;
+                }
+            }
+        }
+    });
+
+    moments.assign(numLabels, RawMoments());
+    for (const auto& accumulators : stripeMoments)
+        for (int label = 0; label < numLabels; ++label)
+            moments[label] += accumulators[label];
+
+    return true;
+}
+
+bool MomentsCalculator::CalcHuMoments(const Image& img, const LabelImage& labels,
+                                      std::vector<HuMoments>& moments, WeightType weightType/* = WeightType::BINARY*/)
+{
+    std::vector<RawMoments> raw;
+    if (!CalcRawMoments(img, labels, raw, weightType))
+        return false;
+
+    moments.resize(raw.size());
+    Parallel::For(0, static_cast<int>(raw.size()), [&](const int begin, const int end)
+    {
+        for (int i = begin; i < end; ++i)
+            moments[i] = CalcHuMoments(raw[i]);
+    }, 256);
+
+    return true;
+}
+
+IntegralMoments::IntegralMoments(const Image& img, MomentsCalculator::WeightType weightType/* = MomentsCalculator::WeightType::BINARY*/)
+    : mWidth(img.GetWidth() + 1),
+      mSums()
+{
+    if (!img.IsInitialized())
+    {
+        mWidth = 0;
+        return;
+    }
+
+    const int width = img.GetWidth();
+    const int height = img.GetHeight();
+    const int x0 = -width / 2;
+    const int y0 = -height / 2;
+
+    mSums.resize(static_cast<size_t>(height + 1) * mWidth);
+
+    // Each row of integral images is the sum of previous row and the prefix sums of current image row
+    for (int row = 0; row < height; ++row)
+    {
+        const Image::Byte* pRow = img.GetRawPointer(row * width);
+        const RawMoments* pPrev = &mSums[static_cast<size_t>(row) * mWidth];
+        RawMoments* pCur = &mSums[static_cast<size_t>(row + 1) * mWidth];
+
+        RawMoments rowPrefix;
+        double s[4];
+        for (int col = 0; col < width; ++col)
+        {
+            AccumulateRowSums(pRow + col, 1, x0 + col, weightType, s);
+            AddRowSums(s, y0 + row, rowPrefix);
+
+            pCur[col + 1] = pPrev[col + 1];
+            pCur[col + 1] += rowPrefix;
+        }
+    }
+}
+
+RawMoments IntegralMoments::GetRawMoments(const int xStart, const int yStart, const int xEnd, const int yEnd) const
+{
+    RawMoments m = mSums[static_cast<size_t>(yEnd + 1) * mWidth + xEnd + 1];
+    m -= mSums[static_cast<size_t>(yStart) * mWidth + xEnd + 1];
+    m -= mSums[static_cast<size_t>(yEnd + 1) * mWidth + xStart];
+    m += mSums[static_cast<size_t>(yStart) * mWidth + xStart];
+    return m;
+}
+
+}
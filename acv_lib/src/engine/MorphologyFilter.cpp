@@ -0,0 +1,523 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of morphological filtration
+
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MORPHOLOGY_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "MorphologyFilter.h"
+#include "Image.h"
+#include "BinaryImage.h"
+#include "Parallel.h"
+#include "Progress.h"
+#include "Profiler.h"
+
+namespace acv {
+
+// Combine the lines element by element: pDst[i] = min (or max) of pLines[0][i], ..., pLines[numLines - 1][i]
+// Destination can be the same as one of lines
+static void CombineLines(const Image::Byte* const* pLines, const int numLines, Image::Byte* pDst, const int length, const bool isMin)
+{
+    int i = 0;
+
+#ifdef MORPHOLOGY_USE_SSE2
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i res = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLines[0] + i));
+        for (int line = 1; line < numLines; ++line)
+        {
+            __m128i val = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLines[line] + i));
+            res = isMin ? _mm_min_epu8(res, val) : _mm_max_epu8(res, val);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), res);
+    }
+#endif
+
+    for (; i < length; ++i)
+    {
+        Image::Byte res = pLines[0][i];
+        for (int line = 1; line < numLines; ++line)
+            res = isMin ? std::min(res, pLines[line][i]) : std::max(res, pLines[line][i]);
+        pDst[i] = res;
+    }
+}
+
+// Combine two lines element by element
+static void CombineLines(const Image::Byte* pLine1, const Image::Byte* pLine2, Image::Byte* pDst, const int length, const bool isMin)
+{
+    const Image::Byte* pLines[2] = { pLine1, pLine2 };
+    CombineLines(pLines, 2, pDst, length, isMin);
+}
+
+FiltrationResult MorphologyFilter::Filter(Image& img, MorphologyType type, const int seWidth, const int seHeight,
+                                          Progress* progress /*= nullptr*/)
+{
+    Image tmpImg(img.GetHeight(), img.GetWidth());
+
+    FiltrationResult res = Filter(img, tmpImg, type, seWidth, seHeight, progress);
+    if (res == FiltrationResult::SUCCESS)
+        img = std::move(tmpImg);
+
+    return res;
+}
+
+FiltrationResult MorphologyFilter::Filter(const Image& srcImg, Image& dstImg, MorphologyType type, const int seWidth, const int seHeight,
+                                          Progress* progress /*= nullptr*/)
+{
+    if (!srcImg.IsInitialized() || srcImg.GetWidth() != dstImg.GetWidth() || srcImg.GetHeight() != dstImg.GetHeight())
+        return FiltrationResult::INTERNAL_ERROR;
+
+    if (seWidth <= 0 || seHeight <= 0 || seWidth % 2 == 0 || seHeight % 2 == 0) // Sizes should be odd
+        return FiltrationResult::INCORRECT_FILTER_SIZE;
+
+    // Each erosion or dilation consists of two passes
+    const bool isComposite = type == MorphologyType::OPENING || type == MorphologyType::CLOSING;
+    Progress::Begin(progress, isComposite ? 4 : 2);
+
+    bool isDone = false;
+    switch (type)
+    {
+    case MorphologyType::EROSION:
+        isDone = Apply(srcImg, dstImg, Operation::MIN, seWidth, seHeight, progress);
+        break;
+    case MorphologyType::DILATION:
+        isDone = Apply(srcImg, dstImg, Operation::MAX, seWidth, seHeight, progress);
+        break;
+    case MorphologyType::OPENING:
+        isDone = Apply(srcImg, dstImg, Operation::MIN, seWidth, seHeight, progress) &&
+                 Apply(dstImg, dstImg, Operation::MAX, seWidth, seHeight, progress);
+        break;
+    case MorphologyType::CLOSING:
+        isDone = Apply(srcImg, dstImg, Operation::MAX, seWidth, seHeight, progress) &&
+                 Apply(dstImg, dstImg, Operation::MIN, seWidth, seHeight, progress);
+        break;
+    default:
+        return FiltrationResult::INCORRECT_FILTER_TYPE;
+    }
+
+    return isDone ? FiltrationResult::SUCCESS : FiltrationResult::CANCELLED;
+}
+
+bool MorphologyFilter::Apply(const Image& srcImg, Image& dstImg, Operation op, const int seWidth, const int seHeight, Progress* progress)
+{
+    // The passes are separated by temporary image, so source and destination can be the same
+    Image tmpImg(srcImg.GetHeight(), srcImg.GetWidth());
+
+    HorizontalPass(srcImg, tmpImg, op, seWidth);
+    if (!Progress::Step(progress))
+        return false;
+
+    VerticalPass(tmpImg, dstImg, op, seHeight);
+    return Progress::Step(progress);
+}
+
+void MorphologyFilter::HorizontalPass(const Image& srcImg, Image& dstImg, Operation op, const int windowSize)
+{
+    ACV_PROFILE_SCOPE_BYTES("MorphologyFilter::HorizontalPass", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
+    const int width = srcImg.GetWidth();
+    const bool isMin = op == Operation::MIN;
+
+    if (windowSize == 1)
+    {
+        if (&srcImg != &dstImg)
+            dstImg.GetData() = srcImg.GetData();
+        return;
+    }
+
+    const int aperture = windowSize / 2;
+    const int paddedWidth = width + windowSize - 1;
+    // The pixels out of image are neutral for operation, so they don't change the result
+    const Image::Byte neutral = isMin ? Image::MAX_PIXEL_VALUE : Image::MIN_PIXEL_VALUE;
+
+    Parallel::For(0, srcImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
+    {
+        std::vector<Image::Byte> line(paddedWidth, neutral);
+        std::vector<Image::Byte> prefix, suffix;
+        std::vector<const Image::Byte*> pLines(windowSize);
+
+        for (int row = rowBegin; row < rowEnd; ++row)
+        {
+            memcpy(line.data() + aperture, srcImg.GetRawPointer(row * width), width);
+            Image::Byte* pDst = dstImg.GetRawPointer(row * width);
+
+            if (windowSize <= MAX_DIRECT_WINDOW_SIZE)
+            {
+                // Window of each pixel is combined from shifted copies of line
+                for (int i = 0; i < windowSize; ++i)
+                    pLines[i] = line.data() + i;
+                CombineLines(pLines.data(), windowSize, pDst, width, isMin);
+                continue;
+            }
+
+            // van Herk/Gil-Werman: the line is divided to blocks of window size, the prefix and suffix
+            // minimums (maximums) are calculated inside each block, any window covers the suffix of one block
+            // and the prefix of the next block
+            prefix.resize(paddedWidth);
+            suffix.resize(paddedWidth);
+
+            for (int blockBegin = 0; blockBegin < paddedWidth; blockBegin += windowSize)
+            {
+                const int blockEnd = std::min(blockBegin + windowSize, paddedWidth);
+                Image::Byte* pPrefix = prefix.data();
+                Image::Byte* pSuffix = suffix.data();
+                const Image::Byte* pLine = line.data();
+
+                pPrefix[blockBegin] = pLine[blockBegin];
+                for (int i = blockBegin + 1; i < blockEnd; ++i)
+                    pPrefix[i] = isMin ? std::min(pPrefix[i - 1], pLine[i]) : std::max(pPrefix[i - 1], pLine[i]);
+
+                pSuffix[blockEnd - 1] = pLine[blockEnd - 1];
+                for (int i = blockEnd - 2; i >= blockBegin; --i)
+                    pSuffix[i] = isMin ? std::min(pSuffix[i + 1], pLine[i]) : std::max(pSuffix[i + 1], pLine[i]);
+            }
+
+            CombineLines(suffix.data(), prefix.data() + windowSize - 1, pDst, width, isMin);
+        }
+    }, 16);
+}
+
+void MorphologyFilter::VerticalPass(const Image& srcImg, Image& dstImg, Operation op, const int windowSize)
+{
+    ACV_PROFILE_SCOPE_BYTES("MorphologyFilter::VerticalPass", static_cast<long long>(srcImg.GetHeight()) * srcImg.GetWidth());
+
+    const int width = srcImg.GetWidth();
+    const int height = srcImg.GetHeight();
+    const bool isMin = op == Operation::MIN;
+
+    if (windowSize == 1)
+    {
+        if (&srcImg != &dstImg)
+            dstImg.GetData() = srcImg.GetData();
+        return;
+    }
+
+    const int aperture = windowSize / 2;
+    const int paddedHeight = height + windowSize - 1;
+    const std::vector<Image::Byte> neutralLine(width, isMin ? Image::MAX_PIXEL_VALUE : Image::MIN_PIXEL_VALUE);
+
+    // Rows of image padded by neutral rows
+    std::vector<const Image::Byte*> pRows(paddedHeight, neutralLine.data());
+    for (int row = 0; row < height; ++row)
+        pRows[row + aperture] = srcImg.GetRawPointer(row * width);
+
+    // Whole rows are combined, so this pass is vectorized along the rows and parallelized by blocks of columns
+    const int COLUMNS_BLOCK = 256;
+    const int numBlocks = (width + COLUMNS_BLOCK - 1) / COLUMNS_BLOCK;
+
+    if (windowSize <= MAX_DIRECT_WINDOW_SIZE)
+    {
+        Parallel::For(0, numBlocks, [&](const int blockBegin, const int blockEnd)
+        {
+            const int colBegin = blockBegin * COLUMNS_BLOCK;
+            const int length = std::min(blockEnd * COLUMNS_BLOCK, width) - colBegin;
+            std::vector<const Image::Byte*> pLines(windowSize);
+
+            for (int row = 0; row < height; ++row)
+            {
+                for (int i = 0; i < windowSize; ++i)
+                    pLines[i] = pRows[row + i] + colBegin;
+                CombineLines(pLines.data(), windowSize, dstImg.GetRawPointer(row * width + colBegin), length, isMin);
+            }
+        });
+        return;
+    }
+
+    // van Herk/Gil-Werman along the columns
+    std::vector<Image::Byte> prefix(static_cast<size_t>(paddedHeight) * width);
+    std::vector<Image::Byte> suffix(static_cast<size_t>(paddedHeight) * width);
+
+    Parallel::For(0, numBlocks, [&](const int blockBegin, const int blockEnd)
+    {
+        const int colBegin = blockBegin * COLUMNS_BLOCK;
+        const int length = std::min(blockEnd * COLUMNS_BLOCK, width) - colBegin;
+
+        for (int i = 0; i < paddedHeight; ++i)
+        {
+            Image::Byte* pPrefix = &prefix[static_cast<size_t>(i) * width + colBegin];
+            if (i % windowSize == 0)
+                memcpy(pPrefix, pRows[i] + colBegin, length);
+            else
+                CombineLines(pPrefix - width, pRows[i] + colBegin, pPrefix, length, isMin);
+        }
+
+        for (int i = paddedHeight - 1; i >= 0; --i)
+        {
+            Image::Byte* pSuffix = &suffix[static_cast<size_t>(i) * width + colBegin];
+            if (i % windowSize == windowSize - 1 || i == paddedHeight - 1)
+                memcpy(pSuffix, pRows[i] + colBegin, length);
+            else
+                CombineLines(pSuffix + width, pRows[i] + colBegin, pSuffix, length, isMin);
+        }
+
+        for (int row = 0; row < height; ++row)
+        {
+            CombineLines(&suffix[static_cast<size_t>(row) * width + colBegin],
+                         &prefix[static_cast<size_t>(row + windowSize - 1) * width + colBegin],
+                         dstImg.GetRawPointer(row * width + colBegin), length, isMin);
+        }
+    });
+}
+
+// Combine the row of binary image with its shifted copy: pDst[x] = pSrc[x] | pSrc[x - shift]
+// (the negative shift takes the pixels to the right). The pixels out of row are cleared,
+// lastWordMask clears the unused bits of the last word
+static void DilateRowByShift(const BinaryImage::Word* pSrc, BinaryImage::Word* pDst, const int numWords, const int shift,
+                             const BinaryImage::Word lastWordMask)
+{
+    const int BITS = BinaryImage::BITS_PER_WORD;
+    const int wordShift = std::abs(shift) / BITS;
+    const int bitShift = std::abs(shift) % BITS;
+
+    for (int i = 0; i < numWords; ++i)
+    {
+        BinaryImage::Word res = pSrc[i];
+
+        if (shift > 0)
+        {
+            // The pixels x - shift are moved to the higher bits
+            const int lowIdx = i - wordShift;
+            if (lowIdx >= 0)
+            {
+                res |= pSrc[lowIdx] << bitShift;
+                if (bitShift != 0 && lowIdx > 0)
+                    res |= pSrc[lowIdx - 1] >> (BITS - bitShift);
+            }
+        }
+        else
+        {
+            // The pixels x + shift are moved to the lower bits
+            const int highIdx = i + wordShift;
+            if (highIdx < numWords)
+            {
+                res |= pSrc[highIdx] >> bitShift;
+                if (bitShift != 0 && highIdx + 1 < numWords)
+                    res |= pSrc[highIdx + 1] << (BITS - bitShift);
+            }
+        }
+
+        pDst[i] = res;
+    }
+
+    pDst[numWords - 1] &= lastWordMask;
+}
+
+// Get the shift of the next step of one-sided dilation when the window of specified length is already combined
+// The combined windows are not clipped by the borders of image: the shifted window which begins out of image
+// is entirely out of image. So the window [x - aperture, x + aperture] is combined from two one-sided windows
+static int GetDilationShift(const int length, const int windowLength)
+{
+    return std::min(length, windowLength - length);
+}
+
+FiltrationResult MorphologyFilter::Filter(BinaryImage& img, MorphologyType type, const int seWidth, const int seHeight,
+                                          Progress* progress /*= nullptr*/)
+{
+    BinaryImage tmpImg(img.GetHeight(), img.GetWidth());
+
+    FiltrationResult res = Filter(img, tmpImg, type, seWidth, seHeight, progress);
+    if (res == FiltrationResult::SUCCESS)
+        img = std::move(tmpImg);
+
+    return res;
+}
+
+FiltrationResult MorphologyFilter::Filter(const BinaryImage& srcImg, BinaryImage& dstImg, MorphologyType type, const int seWidth, const int seHeight,
+                                          Progress* progress /*= nullptr*/)
+{
+    if (!srcImg.IsInitialized() || srcImg.GetWidth() != dstImg.GetWidth() || srcImg.GetHeight() != dstImg.GetHeight())
+        return FiltrationResult::INTERNAL_ERROR;
+
+    if (seWidth <= 0 || seHeight <= 0 || seWidth % 2 == 0 || seHeight % 2 == 0) // Sizes should be odd
+        return FiltrationResult::INCORRECT_FILTER_SIZE;
+
+    // Each erosion or dilation consists of two passes
+    const bool isComposite = type == MorphologyType::OPENING || type == MorphologyType::CLOSING;
+    Progress::Begin(progress, isComposite ? 4 : 2);
+
+    bool isDone = false;
+    switch (type)
+    {
+    case MorphologyType::EROSION:
+        isDone = Apply(srcImg, dstImg, Operation::MIN, seWidth, seHeight, progress);
+        break;
+    case MorphologyType::DILATION:
+        isDone = Apply(srcImg, dstImg, Operation::MAX, seWidth, seHeight, progress);
+        break;
+    case MorphologyType::OPENING:
+        isDone = Apply(srcImg, dstImg, Operation::MIN, seWidth, seHeight, progress) &&
+                 Apply(dstImg, dstImg, Operation::MAX, seWidth, seHeight, progress);
+        break;
+    case MorphologyType::CLOSING:
+        isDone = Apply(srcImg, dstImg, Operation::MAX, seWidth, seHeight, progress) &&
+                 Apply(dstImg, dstImg, Operation::MIN, seWidth, seHeight, progress);
+        break;
+    default:
+        return FiltrationResult::INCORRECT_FILTER_TYPE;
+    }
+
+    return isDone ? FiltrationResult::SUCCESS : FiltrationResult::CANCELLED;
+}
+
+bool MorphologyFilter::Apply(const BinaryImage& srcImg, BinaryImage& dstImg, Operation op, const int seWidth, const int seHeight, Progress* progress)
+{
+    // The erosion is the dilation of background: the pixels out of image are set for erosion and they are cleared
+    // after inversion, so they are neutral for dilation too
+    BinaryImage tmpImg(srcImg.GetHeight(), srcImg.GetWidth());
+    const bool isMin = op == Operation::MIN;
+
+    if (isMin)
+        BinaryImage::Invert(srcImg, tmpImg);
+
+    HorizontalDilation(isMin ? tmpImg : srcImg, tmpImg, seWidth);
+    if (!Progress::Step(progress))
+        return false;
+
+    VerticalDilation(tmpImg, dstImg, seHeight);
+    if (isMin)
+        BinaryImage::Invert(dstImg, dstImg);
+
+    return Progress::Step(progress);
+}
+
+void MorphologyFilter::HorizontalDilation(const BinaryImage& srcImg, BinaryImage& dstImg, const int windowSize)
+{
+    ACV_PROFILE_SCOPE_BYTES("MorphologyFilter::HorizontalDilation", static_cast<long long>(srcImg.GetData().size()) * sizeof(BinaryImage::Word));
+
+    if (windowSize == 1)
+    {
+        if (&srcImg != &dstImg)
+            dstImg.GetData() = srcImg.GetData();
+        return;
+    }
+
+    const int aperture = windowSize / 2;
+    const int wordsPerRow = srcImg.GetWordsPerRow();
+    const BinaryImage::Word lastWordMask = srcImg.GetLastWordMask();
+
+    Parallel::For(0, srcImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
+    {
+        std::vector<BinaryImage::Word> left(wordsPerRow), right(wordsPerRow), tmp(wordsPerRow);
+
+        for (int row = rowBegin; row < rowEnd; ++row)
+        {
+            const BinaryImage::Word* pSrc = srcImg.GetRow(row);
+            std::copy(pSrc, pSrc + wordsPerRow, left.begin());
+            std::copy(pSrc, pSrc + wordsPerRow, right.begin());
+
+            // The windows [x - length + 1, x] and [x, x + length - 1] are doubled until they cover the aperture
+            for (int length = 1; length < aperture + 1; )
+            {
+                const int shift = GetDilationShift(length, aperture + 1);
+                DilateRowByShift(left.data(), tmp.data(), wordsPerRow, shift, lastWordMask);
+                left.swap(tmp);
+                DilateRowByShift(right.data(), tmp.data(), wordsPerRow, -shift, lastWordMask);
+                right.swap(tmp);
+                length += shift;
+            }
+
+            BinaryImage::Word* pDst = dstImg.GetRow(row);
+            for (int i = 0; i < wordsPerRow; ++i)
+                pDst[i] = left[i] | right[i];
+        }
+    }, 16);
+}
+
+void MorphologyFilter::VerticalDilation(const BinaryImage& srcImg, BinaryImage& dstImg, const int windowSize)
+{
+    ACV_PROFILE_SCOPE_BYTES("MorphologyFilter::VerticalDilation", static_cast<long long>(srcImg.GetData().size()) * sizeof(BinaryImage::Word));
+
+    if (windowSize == 1)
+    {
+        if (&srcImg != &dstImg)
+            dstImg.GetData() = srcImg.GetData();
+        return;
+    }
+
+    const int aperture = windowSize / 2;
+    const int height = srcImg.GetHeight();
+    const size_t wordsPerRow = srcImg.GetWordsPerRow();
+
+    // Whole rows of words are combined, the rows out of image are skipped
+    BinaryImage::Matrix upper = srcImg.GetData(), lower = srcImg.GetData();
+    BinaryImage::Matrix nextUpper(upper.size()), nextLower(lower.size());
+
+    // The windows [y - length + 1, y] and [y, y + length - 1] are doubled until they cover the aperture
+    for (int length = 1; length < aperture + 1; )
+    {
+        const int shift = GetDilationShift(length, aperture + 1);
+
+        Parallel::For(0, height, [&](const int rowBegin, const int rowEnd)
+        {
+            for (int row = rowBegin; row < rowEnd; ++row)
+            {
+                const size_t offset = row * wordsPerRow;
+                const BinaryImage::Word* pUpper = &upper[offset];
+                const BinaryImage::Word* pLower = &lower[offset];
+                BinaryImage::Word* pNextUpper = &nextUpper[offset];
+                BinaryImage::Word* pNextLower = &nextLower[offset];
+
+                if (row - shift >= 0)
+                {
+                    const BinaryImage::Word* pShifted = pUpper - shift * wordsPerRow;
+                    for (size_t i = 0; i < wordsPerRow; ++i)
+                        pNextUpper[i] = pUpper[i] | pShifted[i];
+                }
+                else
+                {
+                    std::copy(pUpper, pUpper + wordsPerRow, pNextUpper);
+                }
+
+                if (row + shift < height)
+                {
+                    const BinaryImage::Word* pShifted = pLower + shift * wordsPerRow;
+                    for (size_t i = 0; i < wordsPerRow; ++i)
+                        pNextLower[i] = pLower[i] | pShifted[i];
+                }
+                else
+                {
+                    std::copy(pLower, pLower + wordsPerRow, pNextLower);
+                }
+            }
+        }, 64);
+
+        upper.swap(nextUpper);
+        lower.swap(nextLower);
+        length += shift;
+    }
+
+    BinaryImage::Word* pDst = dstImg.GetData().data();
+    for (size_t i = 0; i < upper.size(); ++i)
+        pDst[i] = upper[i] | lower[i];
+}
+
+}
@@ -0,0 +1,378 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of multi-channel image
+
+#include <cstring>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MULTI_CHANNEL_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef __SSSE3__
+#define MULTI_CHANNEL_USE_SSSE3
+#include <tmmintrin.h>
+#endif
+
+#include "MultiChannelImage.h"
+#include "Parallel.h"
+
+namespace acv {
+
+// Minimum number of pixels processed by one thread during (de)interleaving
+static const int MIN_PIXELS_PER_TASK = 1 << 16;
+
+#ifdef MULTI_CHANNEL_USE_SSSE3
+
+// Masks of byte shuffles for 3-channel pixels
+struct ShuffleMasks3
+{
+    ShuffleMasks3()
+    {
+        for (int block = 0; block < 3; ++block)
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                alignas(16) char deinterleave[16], interleave[16];
+                for (int i = 0; i < 16; ++i)
+                {
+                    // Byte i of channel vector from byte (3 * i + channel) of interleaved data
+                    const int src = 3 * i + channel;
+                    deinterleave[i] = (src / 16 == block) ? static_cast<char>(src % 16) : static_cast<char>(-1);
+
+                    // Byte i of interleaved block from byte (pos / 3) of channel vector
+                    const int pos = 16 * block + i;
+                    interleave[i] = (pos % 3 == channel) ? static_cast<char>(pos / 3) : static_cast<char>(-1);
+                }
+                mDeinterleave[block][channel] = _mm_load_si128(reinterpret_cast<const __m128i*>(deinterleave));
+                mInterleave[block][channel] = _mm_load_si128(reinterpret_cast<const __m128i*>(interleave));
+            }
+    }
+
+    __m128i mDeinterleave[3][3]; // [block of interleaved data][channel]
+    __m128i mInterleave[3][3]; // [block of interleaved data][channel]
+};
+
+static const ShuffleMasks3& GetShuffleMasks3()
+{
+    static const ShuffleMasks3 masks;
+    return masks;
+}
+
+#endif
+
+// Split one interleaved row to channels, returns the number of processed pixels
+static int DeinterleaveRowSIMD(const Image::Byte* pSrc, Image::Byte* const* pDst, const int width, const int numChannels)
+{
+    int col = 0;
+
+#ifdef MULTI_CHANNEL_USE_SSE2
+    if (numChannels == 2)
+    {
+        const __m128i lowByte = _mm_set1_epi16(0xFF);
+        for (; col + 16 <= width; col += 16, pSrc += 32)
+        {
+            const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+            const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst[0] + col),
+                             _mm_packus_epi16(_mm_and_si128(v0, lowByte), _mm_and_si128(v1, lowByte)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst[1] + col),
+                             _mm_packus_epi16(_mm_srli_epi16(v0, 8), _mm_srli_epi16(v1, 8)));
+        }
+    }
+    else if (numChannels == 4)
+    {
+        const __m128i lowByte = _mm_set1_epi32(0xFF);
+        for (; col + 16 <= width; col += 16, pSrc += 64)
+        {
+            __m128i v[4];
+            for (int i = 0; i < 4; ++i)
+                v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 16 * i));
+
+            // Channel of each pixel is moved to low byte of 32-bit value and the values are packed to bytes
+            const __m128i c0lo = _mm_packs_epi32(_mm_and_si128(v[0], lowByte), _mm_and_si128(v[1], lowByte));
+            const __m128i c0hi = _mm_packs_epi32(_mm_and_si128(v[2], lowByte), _mm_and_si128(v[3], lowByte));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst[0] + col), _mm_packus_epi16(c0lo, c0hi));
+
+            for (int channel = 1; channel < 4; ++channel)
+            {
+                const __m128i shift = _mm_cvtsi32_si128(8 * channel);
+                const __m128i lo = _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(v[0], shift), lowByte),
+                                                   _mm_and_si128(_mm_srl_epi32(v[1], shift), lowByte));
+                const __m128i hi = _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(v[2], shift), lowByte),
+                                                   _mm_and_si128(_mm_srl_epi32(v[3], shift), lowByte));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst[channel] + col), _mm_packus_epi16(lo, hi));
+            }
+        }
+    }
+#ifdef MULTI_CHANNEL_USE_SSSE3
+    else if (numChannels == 3)
+    {
+        const ShuffleMasks3& masks = GetShuffleMasks3();
+        for (; col + 16 <= width; col += 16, pSrc += 48)
+        {
+            const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+            const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 16));
+            const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 32));
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                const __m128i res = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, masks.mDeinterleave[0][channel]),
+                                                              _mm_shuffle_epi8(v1, masks.mDeinterleave[1][channel])),
+                                                 _mm_shuffle_epi8(v2, masks.mDeinterleave[2][channel]));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst[channel] + col), res);
+            }
+        }
+    }
+#endif
+#else
+    (void)pSrc;
+    (void)pDst;
+    (void)width;
+    (void)numChannels;
+#endif
+
+    return col;
+}
+
+// Merge the channels to one interleaved row, returns the number of processed pixels
+static int InterleaveRowSIMD(const Image::Byte* const* pSrc, Image::Byte* pDst, const int width, const int numChannels)
+{
+    int col = 0;
+
+#ifdef MULTI_CHANNEL_USE_SSE2
+    if (numChannels == 2)
+    {
+        for (; col + 16 <= width; col += 16, pDst += 32)
+        {
+            const __m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc[0] + col));
+            const __m128i c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc[1] + col));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_unpacklo_epi8(c0, c1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 16), _mm_unpackhi_epi8(c0, c1));
+        }
+    }
+    else if (numChannels == 4)
+    {
+        for (; col + 16 <= width; col += 16, pDst += 64)
+        {
+            const __m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc[0] + col));
+            const __m128i c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc[1] + col));
+            const __m128i c2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc[2] + col));
+            const __m128i c3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc[3] + col));
+            const __m128i c01lo = _mm_unpacklo_epi8(c0, c1), c01hi = _mm_unpackhi_epi8(c0, c1);
+            const __m128i c23lo = _mm_unpacklo_epi8(c2, c3), c23hi = _mm_unpackhi_epi8(c2, c3);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_unpacklo_epi16(c01lo, c23lo));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 16), _mm_unpackhi_epi16(c01lo, c23lo));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 32), _mm_unpacklo_epi16(c01hi, c23hi));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 48), _mm_unpackhi_epi16(c01hi, c23hi));
+        }
+    }
+#ifdef MULTI_CHANNEL_USE_SSSE3
+    else if (numChannels == 3)
+    {
+        const ShuffleMasks3& masks = GetShuffleMasks3();
+        for (; col + 16 <= width; col += 16, pDst += 48)
+        {
+            const __m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc[0] + col));
+            const __m128i c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc[1] + col));
+            const __m128i c2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc[2] + col));
+            for (int block = 0; block < 3; ++block)
+            {
+                const __m128i res = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(c0, masks.mInterleave[block][0]),
+                                                              _mm_shuffle_epi8(c1, masks.mInterleave[block][1])),
+                                                 _mm_shuffle_epi8(c2, masks.mInterleave[block][2]));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 16 * block), res);
+            }
+        }
+    }
+#endif
+#else
+    (void)pSrc;
+    (void)pDst;
+    (void)width;
+    (void)numChannels;
+#endif
+
+    return col;
+}
+
+static void DeinterleaveRow(const Image::Byte* pSrc, Image::Byte* const* pDst, const int width, const int numChannels)
+{
+    if (numChannels == 1)
+    {
+        memcpy(pDst[0], pSrc, width);
+        return;
+    }
+
+    int col = DeinterleaveRowSIMD(pSrc, pDst, width, numChannels);
+    for (pSrc += col * numChannels; col < width; ++col)
+        for (int channel = 0; channel < numChannels; ++channel)
+            pDst[channel][col] = *pSrc++;
+}
+
+static void InterleaveRow(const Image::Byte* const* pSrc, Image::Byte* pDst, const int width, const int numChannels)
+{
+    if (numChannels == 1)
+    {
+        memcpy(pDst, pSrc[0], width);
+        return;
+    }
+
+    int col = InterleaveRowSIMD(pSrc, pDst, width, numChannels);
+    for (pDst += col * numChannels; col < width; ++col)
+        for (int channel = 0; channel < numChannels; ++channel)
+            *pDst++ = pSrc[channel][col];
+}
+
+MultiChannelImage::MultiChannelImage()
+    : mChannels(),
+      mWidth(-1),
+      mHeight(-1)
+{ }
+
+MultiChannelImage::MultiChannelImage(const int height, const int width, const int numChannels)
+    : mChannels(),
+      mWidth(width),
+      mHeight(height)
+{
+    const int channels = std::min(std::max(numChannels, 1), static_cast<int>(MAX_NUM_CHANNELS));
+
+    mChannels.reserve(channels);
+    for (int channel = 0; channel < channels; ++channel)
+        mChannels.emplace_back(height, width);
+}
+
+MultiChannelImage::MultiChannelImage(const int height, const int width, const int numChannels, const void* buf, const int bytesPerLine)
+    : MultiChannelImage(height, width, numChannels)
+{
+    Deinterleave(buf, bytesPerLine);
+}
+
+bool MultiChannelImage::IsInitialized() const
+{
+    return (mWidth != -1 || mHeight != -1);
+}
+
+bool MultiChannelImage::HasSameFormat(const MultiChannelImage& other) const
+{
+    return (mWidth == other.mWidth && mHeight == other.mHeight && GetNumChannels() == other.GetNumChannels());
+}
+
+bool MultiChannelImage::Deinterleave(const void* buf, const int bytesPerLine)
+{
+    const int numChannels = GetNumChannels();
+    if (buf == nullptr || !IsInitialized() || bytesPerLine < mWidth * numChannels)
+        return false;
+
+    const Image::Byte* pBuf = static_cast<const Image::Byte*>(buf);
+
+    Parallel::For(0, mHeight, [&](const int rowBegin, const int rowEnd)
+    {
+        Image::Byte* pDst[MAX_NUM_CHANNELS];
+        for (int row = rowBegin; row < rowEnd; ++row)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                pDst[channel] = mChannels[channel].GetRawPointer(row * mWidth);
+
+            DeinterleaveRow(pBuf + static_cast<size_t>(row) * bytesPerLine, pDst, mWidth, numChannels);
+        }
+    }, std::max(1, MIN_PIXELS_PER_TASK / mWidth));
+
+    return true;
+}
+
+bool MultiChannelImage::Interleave(void* buf, const int bytesPerLine) const
+{
+    const int numChannels = GetNumChannels();
+    if (buf == nullptr || !IsInitialized() || bytesPerLine < mWidth * numChannels)
+        return false;
+
+    Image::Byte* pBuf = static_cast<Image::Byte*>(buf);
+
+    Parallel::For(0, mHeight, [&](const int rowBegin, const int rowEnd)
+    {
+        const Image::Byte* pSrc[MAX_NUM_CHANNELS];
+        for (int row = rowBegin; row < rowEnd; ++row)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                pSrc[channel] = mChannels[channel].GetRawPointer(row * mWidth);
+
+            InterleaveRow(pSrc, pBuf + static_cast<size_t>(row) * bytesPerLine, mWidth, numChannels);
+        }
+    }, std::max(1, MIN_PIXELS_PER_TASK / mWidth));
+
+    return true;
+}
+
+MultiChannelImage MultiChannelImage::Scale(const short kScaleX, const short kScaleY, Image::ScaleType scaleType) const
+{
+    MultiChannelImage img;
+    if (!IsInitialized())
+        return img;
+
+    std::vector<Image> channels(mChannels.size());
+    Parallel::For(0, GetNumChannels(), [&](const int begin, const int end)
+    {
+        for (int channel = begin; channel < end; ++channel)
+            channels[channel] = mChannels[channel].Scale(kScaleX, kScaleY, scaleType);
+    });
+
+    img.mWidth = channels[0].GetWidth();
+    img.mHeight = channels[0].GetHeight();
+    img.mChannels = std::move(channels);
+
+    return img;
+}
+
+bool MultiChannelImage::ProcessChannels(const MultiChannelImage& srcImg, MultiChannelImage& dstImg, const ChannelFunction& func)
+{
+    if (!srcImg.IsInitialized() || !srcImg.HasSameFormat(dstImg))
+        return false;
+
+    bool results[MAX_NUM_CHANNELS];
+    Parallel::For(0, srcImg.GetNumChannels(), [&](const int begin, const int end)
+    {
+        for (int channel = begin; channel < end; ++channel)
+            results[channel] = func(channel, srcImg.mChannels[channel], dstImg.mChannels[channel]);
+    });
+
+    return std::all_of(results, results + srcImg.GetNumChannels(), [](const bool res) { return res; });
+}
+
+bool MultiChannelImage::ProcessChannels(MultiChannelImage& img, const InPlaceChannelFunction& func)
+{
+    if (!img.IsInitialized())
+        return false;
+
+    bool results[MAX_NUM_CHANNELS];
+    Parallel::For(0, img.GetNumChannels(), [&](const int begin, const int end)
+    {
+        for (int channel = begin; channel < end; ++channel)
+            results[channel] = func(channel, img.mChannels[channel]);
+    });
+
+    return std::all_of(results, results + img.GetNumChannels(), [](const bool res) { return res; });
+}
+
+}
@@ -0,0 +1,77 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of parallel execution
+
+#include <algorithm>
+
+#include "Parallel.h"
+#include "TaskScheduler.h"
+
+namespace acv {
+
+// Divide the range in halves: the right half is spawned (so it can be stolen by idle thread),
+// the left half is divided further by the current thread until it is not larger than grain
+static void RunRange(int begin, int end, const int grain, const Parallel::RangeBody& body, TaskGroup& group)
+{
+    while (end - begin > grain)
+    {
+        const int middle = begin + (end - begin) / 2;
+        const int rightEnd = end;
+        group.Run([middle, rightEnd, grain, &body, &group]() { RunRange(middle, rightEnd, grain, body, group); });
+        end = middle;
+    }
+
+    body(begin, end);
+}
+
+void Parallel::For(const int begin, const int end, const RangeBody& body, const int grainSize/* = 1*/)
+{
+    if (begin >= end)
+        return;
+
+    const int numIters = end - begin;
+    const int numThreads = GetNumThreads();
+
+    // The chunks are not smaller than grain size, but there are not more than 8 chunks per thread
+    int grain = std::max(grainSize, 1);
+    grain = std::max(grain, (numIters + 8 * numThreads - 1) / (8 * numThreads));
+
+    if (numIters <= grain || numThreads == 1)
+    {
+        body(begin, end);
+        return;
+    }
+
+    TaskGroup group;
+    RunRange(begin, end, grain, body, group);
+    group.Wait();
+}
+
+int Parallel::GetNumThreads()
+{
+    return TaskScheduler::GetNumThreads();
+}
+
+}
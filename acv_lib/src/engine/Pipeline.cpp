@@ -0,0 +1,409 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of pipeline of image processing operations
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "Pipeline.h"
+#include "Image.h"
+#include "Parallel.h"
+#include "Histogram.h"
+
+namespace acv {
+
+// Apply the table to the pixels
+static void ApplyTable(const ImageCorrector::LookUpTable& table, const Image::Byte* pSrc, Image::Byte* pDst, const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = table[pSrc[i]];
+}
+
+// Compose two tables: the result is equivalent to the first table and then the second table
+static void ComposeTables(const ImageCorrector::LookUpTable& first, const ImageCorrector::LookUpTable& second,
+                          ImageCorrector::LookUpTable& result)
+{
+    for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+        result[i] = second[first[i]];
+}
+
+void Pipeline::AddStage(StageType type, const int halo, const Operation& operation,
+                        ImageCorrector::CorrectorType corType/* = ImageCorrector::CorrectorType::GAMMA*/)
+{
+    Stage stage = { type, std::max(halo, 0), operation, corType };
+    mStages.push_back(stage);
+}
+
+void Pipeline::AddFilter(ImageFilter::FilterType type, const int filterSize/* = -1*/)
+{
+    Operation operation = [type, filterSize](const Image& srcImg, Image& dstImg)
+    {
+        return ImageFilter::Filter(srcImg, dstImg, type, filterSize) == FiltrationResult::SUCCESS;
+    };
+
+    switch (type)
+    {
+    case ImageFilter::FilterType::MEDIAN:
+    case ImageFilter::FilterType::GAUSSIAN:
+    case ImageFilter::FilterType::SEP_GAUSSIAN:
+        AddStage(StageType::NEIGHBOURHOOD, filterSize / 2, operation);
+        break;
+    case ImageFilter::FilterType::SHARPEN:
+        AddStage(StageType::NEIGHBOURHOOD, 1, operation);
+        break;
+    case ImageFilter::FilterType::UNSHARP_MASK: // Small radius is blurred by the separate filter, others by the recursive one
+        if (filterSize / 2 <= 2)
+            AddStage(StageType::NEIGHBOURHOOD, filterSize / 2, operation);
+        else
+            AddStage(StageType::GLOBAL, 0, operation);
+        break;
+    default: // Recursive filtration uses the whole row and column
+        AddStage(StageType::GLOBAL, 0, operation);
+        break;
+    }
+}
+
+void Pipeline::AddAdaptiveThreshold(const int filterSize, const int threshold, ImageFilter::ThresholdType thresholdType)
+{
+    Operation operation = [filterSize, threshold, thresholdType](const Image& srcImg, Image& dstImg)
+    {
+        return ImageFilter::AdaptiveThreshold(srcImg, dstImg, filterSize, threshold, thresholdType);
+    };
+
+    // The large filters are imitated by recursive filtration
+    if (filterSize >= 6)
+        AddStage(StageType::GLOBAL, 0, operation);
+    else
+        AddStage(StageType::NEIGHBOURHOOD, filterSize / 2, operation);
+}
+
+void Pipeline::AddAdaptiveThreshold(const int filterSize, const float k, ImageFilter::ThresholdMethod method,
+                                    ImageFilter::ThresholdType thresholdType)
+{
+    Operation operation = [filterSize, k, method, thresholdType](const Image& srcImg, Image& dstImg)
+    {
+        return ImageFilter::AdaptiveThreshold(srcImg, dstImg, filterSize, k, method, thresholdType);
+    };
+
+    // The windows of local statistics are limited for any size
+    AddStage(StageType::NEIGHBOURHOOD, filterSize / 2, operation);
+}
+
+void Pipeline::AddCorrector(ImageCorrector::CorrectorType corType)
+{
+    switch (corType)
+    {
+    case ImageCorrector::CorrectorType::GAMMA:
+        AddStage(StageType::POINT, 0, nullptr, corType);
+        break;
+    case ImageCorrector::CorrectorType::AUTO_LEVELS:
+    case ImageCorrector::CorrectorType::NORM_AUTO_LEVELS:
+    case ImageCorrector::CorrectorType::GLOBAL_EQUALIZATION:
+        AddStage(StageType::STATISTICS, 0, nullptr, corType);
+        break;
+    default:
+        AddStage(StageType::GLOBAL, 0, [corType](const Image& srcImg, Image& dstImg)
+        {
+            return ImageCorrector::Correct(srcImg, dstImg, corType);
+        });
+        break;
+    }
+}
+
+void Pipeline::AddBordersDetector(BordersDetector::DetectorType detectorType)
+{
+    Operation operation = [detectorType](const Image& srcImg, Image& dstImg)
+    {
+        return BordersDetector::DetectBorders(srcImg, dstImg, detectorType);
+    };
+
+    // Canny algorithm traces the borders through the whole image
+    if (detectorType == BordersDetector::DetectorType::CANNY || detectorType == BordersDetector::DetectorType::CANNY_BILATERAL)
+        AddStage(StageType::GLOBAL, 0, operation);
+    else
+        AddStage(StageType::NEIGHBOURHOOD, 1, operation);
+}
+
+void Pipeline::AddOperator(BordersDetector::DetectorType detectorType, BordersDetector::OperatorType operatorType)
+{
+    AddStage(StageType::NEIGHBOURHOOD, 1, [detectorType, operatorType](const Image& srcImg, Image& dstImg)
+    {
+        return BordersDetector::OperatorConvolution(srcImg, dstImg, detectorType, operatorType);
+    });
+}
+
+void Pipeline::AddMorphology(MorphologyFilter::MorphologyType type, const int seWidth, const int seHeight)
+{
+    const bool isComposite = type == MorphologyFilter::MorphologyType::OPENING || type == MorphologyFilter::MorphologyType::CLOSING;
+
+    AddStage(StageType::NEIGHBOURHOOD, (isComposite ? 2 : 1) * (seHeight / 2), [type, seWidth, seHeight](const Image& srcImg, Image& dstImg)
+    {
+        return MorphologyFilter::Filter(srcImg, dstImg, type, seWidth, seHeight) == FiltrationResult::SUCCESS;
+    });
+}
+
+bool Pipeline::Run(const Image& srcImg, Image& dstImg) const
+{
+    if (!srcImg.IsInitialized())
+        return false;
+
+    const Image* pInput = &srcImg; // Input of not executed stages
+    Image intermediateImg; // Last materialized intermediate image
+
+    std::vector<FusedStage> fusedStages; // Not executed neighbourhood stages
+    ImageCorrector::LookUpTable inputTable; // Point stages before the first neighbourhood stage
+    bool hasInputTable = false;
+    std::vector<size_t> histogram; // Histogram of input (it is calculated only for statistics stages)
+
+    // Run the not executed stages and materialize the intermediate image
+    auto materialize = [&]() -> bool
+    {
+        if (fusedStages.empty() && !hasInputTable)
+            return true;
+
+        Image resImg(pInput->GetHeight(), pInput->GetWidth());
+        if (!RunStrips(*pInput, hasInputTable ? &inputTable : nullptr, fusedStages, resImg))
+            return false;
+
+        intermediateImg = std::move(resImg);
+        pInput = &intermediateImg;
+        fusedStages.clear();
+        hasInputTable = false;
+        histogram.clear();
+
+        return true;
+    };
+
+    for (const auto& stage : mStages)
+    {
+        switch (stage.type)
+        {
+        case StageType::NEIGHBOURHOOD:
+            fusedStages.push_back({ &stage, false, ImageCorrector::LookUpTable() });
+            break;
+
+        case StageType::STATISTICS:
+        case StageType::POINT:
+        {
+            // The statistics of output of neighbourhood stage are unknown until the stage is executed
+            if (stage.type == StageType::STATISTICS && !fusedStages.empty() && !materialize())
+                return false;
+
+            std::vector<size_t> stageHistogram;
+            if (stage.type == StageType::STATISTICS)
+            {
+                if (histogram.empty())
+                {
+                    const Histogram inputHistogram(*pInput);
+                    histogram.assign(inputHistogram.GetBins().begin(), inputHistogram.GetBins().end());
+                }
+
+                // The histogram of input of this stage is the histogram of image transformed by the input table
+                stageHistogram.assign(Image::MAX_PIXEL_VALUE + 1, 0);
+                for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+                    stageHistogram[hasInputTable ? inputTable[i] : i] += histogram[i];
+            }
+
+            ImageCorrector::LookUpTable table;
+            FormStageTable(stage, stageHistogram, table);
+
+            if (!fusedStages.empty())
+            {
+                FusedStage& last = fusedStages.back();
+                if (last.hasTable)
+                    ComposeTables(last.table, table, last.table);
+                else
+                    last.table = table;
+                last.hasTable = true;
+            }
+            else
+            {
+                if (hasInputTable)
+                    ComposeTables(inputTable, table, inputTable);
+                else
+                    inputTable = table;
+                hasInputTable = true;
+            }
+            break;
+        }
+
+        case StageType::GLOBAL:
+        {
+            if (!materialize())
+                return false;
+
+            Image resImg(pInput->GetHeight(), pInput->GetWidth());
+            if (!stage.operation(*pInput, resImg))
+                return false;
+
+            intermediateImg = std::move(resImg);
+            pInput = &intermediateImg;
+            histogram.clear();
+            break;
+        }
+        }
+    }
+
+    if (!materialize())
+        return false;
+
+    if (pInput == &srcImg)
+        dstImg = srcImg;
+    else
+        dstImg = std::move(intermediateImg);
+
+    return true;
+}
+
+bool Pipeline::RunStrips(const Image& srcImg, const ImageCorrector::LookUpTable* pInputTable,
+                         const std::vector<FusedStage>& stages, Image& dstImg)
+{
+    const int width = srcImg.GetWidth();
+    const int height = srcImg.GetHeight();
+
+    int totalHalo = 0;
+    for (const auto& fusedStage : stages)
+        totalHalo += fusedStage.stage->halo;
+
+    const int stripRows = std::max(static_cast<int>(MIN_STRIP_ROWS), STRIP_BYTES / width);
+    const int numStrips = (height + stripRows - 1) / stripRows;
+
+    std::atomic<bool> success(true);
+
+    Parallel::For(0, numStrips, [&](const int stripBegin, const int stripEnd)
+    {
+        for (int strip = stripBegin; strip < stripEnd && success; ++strip)
+        {
+            const int rowBegin = strip * stripRows;
+            const int rowEnd = std::min(rowBegin + stripRows, height);
+
+            // Window of rows which are needed to calculate the strip (rows of halo are included)
+            int halo = totalHalo;
+            int winBegin = std::max(rowBegin - halo, 0);
+            int winEnd = std::min(rowEnd + halo, height);
+
+            Image window(winEnd - winBegin, width);
+            const Image::Byte* pSrc = srcImg.GetRawPointer(winBegin * width);
+            const size_t winSize = static_cast<size_t>(winEnd - winBegin) * width;
+            if (pInputTable)
+                ApplyTable(*pInputTable, pSrc, window.GetRawPointer(), winSize);
+            else
+                memcpy(window.GetRawPointer(), pSrc, winSize);
+
+            // Each stage makes invalid the rows near to the inner edges of window, these rows are cut off
+            for (const auto& fusedStage : stages)
+            {
+                halo -= fusedStage.stage->halo;
+
+                Image resWindow(window.GetHeight(), width);
+                if (!fusedStage.stage->operation(window, resWindow))
+                {
+                    success = false;
+                    return;
+                }
+
+                const int newBegin = std::max(rowBegin - halo, 0);
+                const int newEnd = std::min(rowEnd + halo, height);
+                const Image::Byte* pRes = resWindow.GetRawPointer((newBegin - winBegin) * width);
+                const size_t newSize = static_cast<size_t>(newEnd - newBegin) * width;
+
+                if (newBegin != winBegin || newEnd != winEnd)
+                    window = Image(newEnd - newBegin, width);
+                else
+                    std::swap(window, resWindow);
+
+                if (fusedStage.hasTable)
+                    ApplyTable(fusedStage.table, pRes, window.GetRawPointer(), newSize);
+                else if (pRes != window.GetRawPointer())
+                    memcpy(window.GetRawPointer(), pRes, newSize);
+
+                winBegin = newBegin;
+                winEnd = newEnd;
+            }
+
+            memcpy(dstImg.GetRawPointer(rowBegin * width), window.GetRawPointer(), static_cast<size_t>(rowEnd - rowBegin) * width);
+        }
+    });
+
+    return success;
+}
+
+void Pipeline::FormStageTable(const Stage& stage, const std::vector<size_t>& histogram, ImageCorrector::LookUpTable& table)
+{
+    if (stage.corType == ImageCorrector::CorrectorType::GAMMA)
+    {
+        ImageCorrector::FormGammaTable(table);
+        return;
+    }
+
+    if (stage.corType == ImageCorrector::CorrectorType::GLOBAL_EQUALIZATION)
+    {
+        ImageCorrector::FormEqualizationTable(histogram, table);
+        return;
+    }
+
+    // Auto-levels algorithms: the range of brightness is calculated by the histogram
+    int minBr = Image::MAX_PIXEL_VALUE, maxBr = Image::MIN_PIXEL_VALUE;
+    size_t numPixels = 0;
+    double sum = 0.0;
+    for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+    {
+        if (histogram[i] > 0)
+        {
+            minBr = std::min(minBr, i);
+            maxBr = std::max(maxBr, i);
+        }
+        numPixels += histogram[i];
+        sum += static_cast<double>(histogram[i]) * i;
+    }
+
+    if (stage.corType == ImageCorrector::CorrectorType::NORM_AUTO_LEVELS)
+    {
+        double aver = sum / numPixels;
+        double sd = 0.0;
+        for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+            sd += histogram[i] * (i - aver) * (i - aver);
+        sd = sqrt(sd / (numPixels - 1));
+
+        minBr = aver - 3 * sd;
+        Image::CheckPixelValue(minBr);
+        maxBr = aver + 3 * sd;
+        Image::CheckPixelValue(maxBr);
+    }
+
+    if (minBr > Image::MIN_PIXEL_VALUE || maxBr < Image::MAX_PIXEL_VALUE)
+    {
+        ImageCorrector::FormExpandRangeTable(minBr, maxBr, table);
+    }
+    else
+    {
+        for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+            table[i] = i;
+    }
+}
+
+}
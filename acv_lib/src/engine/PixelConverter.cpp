@@ -0,0 +1,285 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of pixels conversion
+
+#include <cstring>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PIXEL_CONVERTER_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef __SSSE3__
+#define PIXEL_CONVERTER_USE_SSSE3
+#include <tmmintrin.h>
+#endif
+
+#include "PixelConverter.h"
+#include "Image.h"
+#include "Parallel.h"
+
+namespace acv {
+
+// Weights of color components in luma (sum of weights is 2^LUMA_SHIFT)
+enum
+{
+    LUMA_WEIGHT_R = 11,
+    LUMA_WEIGHT_G = 16,
+    LUMA_WEIGHT_B = 5,
+    LUMA_SHIFT = 5
+};
+
+// Minimum number of pixels processed by one thread
+static const int MIN_PIXELS_PER_TASK = 1 << 16;
+
+// Positions of components in pixel of buffer
+struct PixelLayout
+{
+    int bytesPerPixel; // Size of pixel in bytes
+    int rOffset; // Offset of red component
+    int gOffset; // Offset of green component
+    int bOffset; // Offset of blue component
+    int aOffset; // Offset of alpha component (-1 if there is no alpha)
+};
+
+static PixelLayout GetLayout(PixelConverter::PixelFormat format)
+{
+    switch (format)
+    {
+    case PixelConverter::PixelFormat::GRAY8:
+        return PixelLayout { 1, 0, 0, 0, -1 };
+    case PixelConverter::PixelFormat::RGB888:
+        return PixelLayout { 3, 0, 1, 2, -1 };
+    case PixelConverter::PixelFormat::BGR888:
+        return PixelLayout { 3, 2, 1, 0, -1 };
+    case PixelConverter::PixelFormat::RGBA8888:
+        return PixelLayout { 4, 0, 1, 2, 3 };
+    case PixelConverter::PixelFormat::BGRA8888:
+        return PixelLayout { 4, 2, 1, 0, 3 };
+    case PixelConverter::PixelFormat::ARGB8888:
+        return PixelLayout { 4, 1, 2, 3, 0 };
+    }
+
+    return PixelLayout { 1, 0, 0, 0, -1 };
+}
+
+// Calculate the luma of pixel
+static inline Image::Byte Luma(const Image::Byte* pPix, const PixelLayout& layout)
+{
+    return static_cast<Image::Byte>((pPix[layout.rOffset] * LUMA_WEIGHT_R +
+                                     pPix[layout.gOffset] * LUMA_WEIGHT_G +
+                                     pPix[layout.bOffset] * LUMA_WEIGHT_B) >> LUMA_SHIFT);
+}
+
+#ifdef PIXEL_CONVERTER_USE_SSE2
+
+// Form the weights of components for 4-bytes pixels (offsets are given in 4-bytes pixel)
+static inline __m128i FormWeights(const int rOffset, const int gOffset, const int bOffset)
+{
+    short w[4] = { 0, 0, 0, 0 };
+    w[rOffset] = LUMA_WEIGHT_R;
+    w[gOffset] = LUMA_WEIGHT_G;
+    w[bOffset] = LUMA_WEIGHT_B;
+
+    return _mm_setr_epi16(w[0], w[1], w[2], w[3], w[0], w[1], w[2], w[3]);
+}
+
+// Calculate the weighted sums of components for 4 pixels of 4 bytes (result is four 32-bit values)
+static inline __m128i WeightedSum4(const __m128i pix, const __m128i weights)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(pix, zero), weights);
+    const __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(pix, zero), weights);
+
+    // Each pixel has two partial sums, they are added by second multiplication
+    return _mm_madd_epi16(_mm_packs_epi32(lo, hi), _mm_set1_epi16(1));
+}
+
+// Calculate the luma of 16 pixels from four vectors of weighted sums
+static inline __m128i PackLuma16(const __m128i s0, const __m128i s1, const __m128i s2, const __m128i s3)
+{
+    const __m128i lo = _mm_srli_epi16(_mm_packs_epi32(s0, s1), LUMA_SHIFT);
+    const __m128i hi = _mm_srli_epi16(_mm_packs_epi32(s2, s3), LUMA_SHIFT);
+
+    return _mm_packus_epi16(lo, hi);
+}
+
+#endif
+
+// Convert one row of buffer to brightness, returns the number of processed pixels
+static int ImportRowSIMD(const Image::Byte* pSrc, Image::Byte* pDst, const int width, const PixelLayout& layout)
+{
+    int col = 0;
+
+#ifdef PIXEL_CONVERTER_USE_SSE2
+    if (layout.bytesPerPixel == 4)
+    {
+        const __m128i weights = FormWeights(layout.rOffset, layout.gOffset, layout.bOffset);
+        for (; col + 16 <= width; col += 16, pSrc += 64)
+        {
+            const __m128i s0 = WeightedSum4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc)), weights);
+            const __m128i s1 = WeightedSum4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 16)), weights);
+            const __m128i s2 = WeightedSum4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 32)), weights);
+            const __m128i s3 = WeightedSum4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 48)), weights);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + col), PackLuma16(s0, s1, s2, s3));
+        }
+    }
+#ifdef PIXEL_CONVERTER_USE_SSSE3
+    else if (layout.bytesPerPixel == 3)
+    {
+        // 4 pixels of 3 bytes are expanded to 4 pixels of 4 bytes, the 4-th byte is zero
+        const __m128i expand = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i weights = FormWeights(layout.rOffset, layout.gOffset, layout.bOffset);
+
+        // Each load reads 16 bytes, so 4 bytes after the last used pixel should be in the row
+        for (; col + 18 <= width; col += 16, pSrc += 48)
+        {
+            const __m128i p0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc)), expand);
+            const __m128i p1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 12)), expand);
+            const __m128i p2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 24)), expand);
+            const __m128i p3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 36)), expand);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + col),
+                             PackLuma16(WeightedSum4(p0, weights), WeightedSum4(p1, weights),
+                                        WeightedSum4(p2, weights), WeightedSum4(p3, weights)));
+        }
+    }
+#endif
+#else
+    (void)pSrc;
+    (void)pDst;
+    (void)width;
+    (void)layout;
+#endif
+
+    return col;
+}
+
+// Write one row of brightness to buffer, returns the number of processed pixels
+static int ExportRowSIMD(const Image::Byte* pSrc, Image::Byte* pDst, const int width, const PixelLayout& layout)
+{
+    int col = 0;
+
+#ifdef PIXEL_CONVERTER_USE_SSE2
+    if (layout.bytesPerPixel == 4)
+    {
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFFu << (8 * layout.aOffset)));
+        for (; col + 16 <= width; col += 16, pDst += 64)
+        {
+            const __m128i gray = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + col));
+            const __m128i lo = _mm_unpacklo_epi8(gray, gray);
+            const __m128i hi = _mm_unpackhi_epi8(gray, gray);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_or_si128(_mm_unpacklo_epi16(lo, lo), alpha));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 16), _mm_or_si128(_mm_unpackhi_epi16(lo, lo), alpha));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 32), _mm_or_si128(_mm_unpacklo_epi16(hi, hi), alpha));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 48), _mm_or_si128(_mm_unpackhi_epi16(hi, hi), alpha));
+        }
+    }
+#else
+    (void)pSrc;
+    (void)pDst;
+    (void)width;
+    (void)layout;
+#endif
+
+    return col;
+}
+
+static void ImportRow(const Image::Byte* pSrc, Image::Byte* pDst, const int width, const PixelLayout& layout)
+{
+    if (layout.bytesPerPixel == 1)
+    {
+        memcpy(pDst, pSrc, width);
+        return;
+    }
+
+    int col = ImportRowSIMD(pSrc, pDst, width, layout);
+    for (pSrc += col * layout.bytesPerPixel; col < width; ++col, pSrc += layout.bytesPerPixel)
+        pDst[col] = Luma(pSrc, layout);
+}
+
+static void ExportRow(const Image::Byte* pSrc, Image::Byte* pDst, const int width, const PixelLayout& layout)
+{
+    if (layout.bytesPerPixel == 1)
+    {
+        memcpy(pDst, pSrc, width);
+        return;
+    }
+
+    int col = ExportRowSIMD(pSrc, pDst, width, layout);
+    for (pDst += col * layout.bytesPerPixel; col < width; ++col, pDst += layout.bytesPerPixel)
+    {
+        pDst[layout.rOffset] = pDst[layout.gOffset] = pDst[layout.bOffset] = pSrc[col];
+        if (layout.aOffset >= 0)
+            pDst[layout.aOffset] = Image::MAX_PIXEL_VALUE;
+    }
+}
+
+bool PixelConverter::Import(const void* buf, const int bytesPerLine, PixelFormat format, Image& dstImg)
+{
+    const PixelLayout layout = GetLayout(format);
+    const int width = dstImg.GetWidth();
+
+    if (buf == nullptr || !dstImg.IsInitialized() || bytesPerLine < width * layout.bytesPerPixel)
+        return false;
+
+    const Image::Byte* pBuf = static_cast<const Image::Byte*>(buf);
+    Image::Byte* pPixels = dstImg.GetRawPointer();
+
+    Parallel::For(0, dstImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
+    {
+        for (int row = rowBegin; row < rowEnd; ++row)
+            ImportRow(pBuf + static_cast<size_t>(row) * bytesPerLine, pPixels + static_cast<size_t>(row) * width, width, layout);
+    }, std::max(1, MIN_PIXELS_PER_TASK / width));
+
+    return true;
+}
+
+bool PixelConverter::Export(const Image& srcImg, void* buf, const int bytesPerLine, PixelFormat format)
+{
+    const PixelLayout layout = GetLayout(format);
+    const int width = srcImg.GetWidth();
+
+    if (buf == nullptr || !srcImg.IsInitialized() || bytesPerLine < width * layout.bytesPerPixel)
+        return false;
+
+    Image::Byte* pBuf = static_cast<Image::Byte*>(buf);
+    const Image::Byte* pPixels = srcImg.GetRawPointer();
+
+    Parallel::For(0, srcImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
+    {
+        for (int row = rowBegin; row < rowEnd; ++row)
+            ExportRow(pPixels + static_cast<size_t>(row) * width, pBuf + static_cast<size_t>(row) * bytesPerLine, width, layout);
+    }, std::max(1, MIN_PIXELS_PER_TASK / width));
+
+    return true;
+}
+
+int PixelConverter::GetBytesPerPixel(PixelFormat format)
+{
+    return GetLayout(format).bytesPerPixel;
+}
+
+}
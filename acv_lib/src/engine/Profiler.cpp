@@ -0,0 +1,228 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of built-in profiling
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <fstream>
+#include <algorithm>
+
+#include "Profiler.h"
+
+namespace acv {
+
+// Event of timeline of stages
+struct TraceEvent
+{
+    const char* name; // Name of stage
+    int threadId; // Number of thread which has run the stage
+    long long startUs; // Start of stage from the start of profiling
+    long long durationUs; // Duration of stage
+};
+
+// Collected statistics which are shared by all threads
+struct ProfilerState
+{
+    std::mutex mutex;
+    std::map<std::string, Profiler::StageStats> stages;
+    std::map<std::string, Profiler::CounterStats> counters;
+    std::vector<TraceEvent> trace;
+    std::atomic<bool> isTraceEnabled;
+    Profiler::Clock::time_point epoch;
+
+    ProfilerState() : isTraceEnabled(false), epoch(Profiler::Clock::now()) { }
+};
+
+static ProfilerState& GetState()
+{
+    static ProfilerState state;
+    return state;
+}
+
+// Get the short number of current thread for timeline
+static int GetThreadId()
+{
+    static std::atomic<int> nextId(1);
+    thread_local int threadId = nextId.fetch_add(1);
+    return threadId;
+}
+
+// Write the string to JSON with escaping of special characters
+static void WriteJsonString(std::ofstream& file, const char* str)
+{
+    file << '"';
+    for (; *str; ++str)
+    {
+        if (*str == '"' || *str == '\\')
+            file << '\\';
+        file << *str;
+    }
+    file << '"';
+}
+
+bool Profiler::IsEnabled()
+{
+#ifdef ACV_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Profiler::AddStage(const char* name, const Clock::time_point start, const Clock::time_point finish, const long long bytes/* = 0*/)
+{
+    ProfilerState& state = GetState();
+    const double durationMs = std::chrono::duration<double, std::milli>(finish - start).count();
+    const bool isTraceEnabled = state.isTraceEnabled.load();
+    const int threadId = isTraceEnabled ? GetThreadId() : 0;
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    auto it = state.stages.find(name);
+    if (it == state.stages.end())
+    {
+        StageStats stats = { name, 0, 0.0, durationMs, durationMs, 0 };
+        it = state.stages.emplace(name, stats).first;
+    }
+
+    StageStats& stats = it->second;
+    ++stats.calls;
+    stats.totalMs += durationMs;
+    stats.minMs = std::min(stats.minMs, durationMs);
+    stats.maxMs = std::max(stats.maxMs, durationMs);
+    stats.bytes += bytes;
+
+    if (isTraceEnabled && state.trace.size() < MAX_TRACE_EVENTS)
+    {
+        TraceEvent event;
+        event.name = name;
+        event.threadId = threadId;
+        event.startUs = std::chrono::duration_cast<std::chrono::microseconds>(start - state.epoch).count();
+        event.durationUs = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+        state.trace.push_back(event);
+    }
+}
+
+void Profiler::AddCount(const char* name, const long long value)
+{
+    ProfilerState& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    auto it = state.counters.find(name);
+    if (it == state.counters.end())
+    {
+        CounterStats stats = { name, 0, 0 };
+        it = state.counters.emplace(name, stats).first;
+    }
+
+    ++it->second.events;
+    it->second.total += value;
+}
+
+std::vector<Profiler::StageStats> Profiler::GetStageStats()
+{
+    ProfilerState& state = GetState();
+    std::vector<StageStats> stages;
+
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        for (const auto& stage : state.stages)
+            stages.push_back(stage.second);
+    }
+
+    std::sort(stages.begin(), stages.end(), [](const StageStats& lhs, const StageStats& rhs)
+    {
+        return lhs.totalMs > rhs.totalMs;
+    });
+
+    return stages;
+}
+
+std::vector<Profiler::CounterStats> Profiler::GetCounterStats()
+{
+    ProfilerState& state = GetState();
+    std::vector<CounterStats> counters;
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (const auto& counter : state.counters)
+        counters.push_back(counter.second);
+
+    return counters;
+}
+
+void Profiler::SetTraceEnabled(const bool isEnabled)
+{
+    GetState().isTraceEnabled.store(isEnabled);
+}
+
+bool Profiler::IsTraceEnabled()
+{
+    return GetState().isTraceEnabled.load();
+}
+
+bool Profiler::WriteChromeTrace(const std::string& fileName)
+{
+    std::vector<TraceEvent> trace;
+
+    {
+        ProfilerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        trace = state.trace;
+    }
+
+    std::ofstream file(fileName, std::ios::trunc);
+    if (!file)
+        return false;
+
+    // Complete events ("X") with timestamps and durations in microseconds
+    file << "{\"traceEvents\":[";
+    for (size_t i = 0; i < trace.size(); ++i)
+    {
+        const TraceEvent& event = trace[i];
+
+        file << (i ? ",\n" : "\n") << "{\"name\":";
+        WriteJsonString(file, event.name);
+        file << ",\"cat\":\"acv\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+             << ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs << "}";
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return static_cast<bool>(file);
+}
+
+void Profiler::Reset()
+{
+    ProfilerState& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    state.stages.clear();
+    state.counters.clear();
+    state.trace.clear();
+    state.trace.shrink_to_fit();
+    state.epoch = Clock::now();
+}
+
+}
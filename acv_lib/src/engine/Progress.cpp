@@ -0,0 +1,80 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of progress of long operations
+
+#include <algorithm>
+
+#include "Progress.h"
+
+namespace acv {
+
+Progress::Progress()
+    : mTotalWork(0),
+      mDoneWork(0),
+      mPercent(0),
+      mIsCancelled(false)
+{
+}
+
+void Progress::Start(const int totalWork)
+{
+    mTotalWork.store(std::max(totalWork, 1));
+    mDoneWork.store(0);
+    mPercent.store(0);
+
+    if (mCallback)
+        mCallback(0);
+}
+
+bool Progress::Advance(const int work/* = 1*/)
+{
+    const int totalWork = mTotalWork.load();
+    const int doneWork = std::min(mDoneWork.fetch_add(work) + work, totalWork);
+    const int percent = static_cast<int>(100LL * doneWork / std::max(totalWork, 1));
+
+    // Each percent is reported once by the thread which has changed it
+    int lastPercent = mPercent.load();
+    while (percent > lastPercent)
+    {
+        if (mPercent.compare_exchange_weak(lastPercent, percent))
+        {
+            if (mCallback)
+                mCallback(percent);
+            break;
+        }
+    }
+
+    return !mIsCancelled.load();
+}
+
+void Progress::Reset()
+{
+    mTotalWork.store(0);
+    mDoneWork.store(0);
+    mPercent.store(0);
+    mIsCancelled.store(false);
+}
+
+}
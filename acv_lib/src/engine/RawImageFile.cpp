@@ -0,0 +1,390 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of memory-mapped file of raw image
+
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <limits>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "RawImageFile.h"
+
+namespace acv {
+
+namespace {
+
+// Header of raw image file
+struct RawFileHeader
+{
+    char magic[8]; // Signature of file
+    std::uint32_t version; // Version of format
+    std::uint32_t bitsPerPixel; // Number of bits per pixel (only 8 is supported)
+    std::int32_t width; // Width of image
+    std::int32_t height; // Height of image
+    std::int32_t tileSize; // Size of tile side
+    std::int32_t reserved; // Not used (is zero)
+    std::uint64_t tileStride; // Size of tile in file (with padding)
+    std::uint64_t payloadOffset; // Offset of first tile from beginning of file
+};
+
+const char RAW_FILE_MAGIC[8] = { 'A', 'C', 'V', 'R', 'A', 'W', '\0', '\0' };
+const std::uint32_t RAW_FILE_VERSION = 1;
+const std::intptr_t INVALID_FILE = -1;
+
+std::uint64_t AlignUp(const std::uint64_t value, const std::uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Size of file is limited by the size of mapping and by the offsets of stream
+const std::uint64_t MAX_FILE_SIZE = std::min<std::uint64_t>(std::numeric_limits<std::size_t>::max(),
+                                                            std::numeric_limits<std::int64_t>::max());
+
+std::uint64_t NumTiles(const int size, const int tileSize)
+{
+    return (static_cast<std::uint64_t>(size) + tileSize - 1) / tileSize;
+}
+
+// Calculate the size of file by header (the sizes of header should be positive)
+// Returns false if the size is larger than MAX_FILE_SIZE
+bool CalcFileSize(const RawFileHeader& header, std::uint64_t& fileSize)
+{
+    // The numbers of tiles are not larger than the sizes of image, so their product doesn't overflow
+    const std::uint64_t numTiles = NumTiles(header.width, header.tileSize) * NumTiles(header.height, header.tileSize);
+    if (header.payloadOffset > MAX_FILE_SIZE || header.tileStride > (MAX_FILE_SIZE - header.payloadOffset) / numTiles)
+        return false;
+
+    fileSize = header.payloadOffset + header.tileStride * numTiles;
+    return true;
+}
+
+bool IsValidHeader(const RawFileHeader& header)
+{
+    return memcmp(header.magic, RAW_FILE_MAGIC, sizeof(RAW_FILE_MAGIC)) == 0 &&
+           header.version == RAW_FILE_VERSION &&
+           header.bitsPerPixel == 8 &&
+           header.width > 0 && header.height > 0 && header.tileSize > 0 &&
+           header.tileStride >= static_cast<std::uint64_t>(header.tileSize) * header.tileSize &&
+           header.payloadOffset >= sizeof(RawFileHeader);
+}
+
+}
+
+RawImageFile::RawImageFile()
+    : mData(nullptr),
+      mMappedSize(0),
+      mPayloadOffset(0),
+      mTileStride(0),
+      mFile(INVALID_FILE),
+      mMapping(INVALID_FILE),
+      mMode(OpenMode::READ),
+      mWidth(-1),
+      mHeight(-1),
+      mTileSize(0),
+      mNumTilesX(0),
+      mNumTilesY(0)
+{ }
+
+RawImageFile::~RawImageFile()
+{
+    Close();
+}
+
+bool RawImageFile::Create(const std::string& fileName, const int height, const int width, const int tileSize/* = DEFAULT_TILE_SIZE*/)
+{
+    if (height <= 0 || width <= 0 || tileSize <= 0)
+        return false;
+
+    RawFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RAW_FILE_MAGIC, sizeof(RAW_FILE_MAGIC));
+    header.version = RAW_FILE_VERSION;
+    header.bitsPerPixel = 8;
+    header.width = width;
+    header.height = height;
+    header.tileSize = tileSize;
+    header.tileStride = AlignUp(static_cast<std::uint64_t>(tileSize) * tileSize, ALIGNMENT);
+    header.payloadOffset = AlignUp(sizeof(RawFileHeader), ALIGNMENT);
+
+    std::uint64_t fileSize;
+    if (!CalcFileSize(header, fileSize))
+        return false;
+
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // The file is expanded to full size by writing of the last byte (file system can keep the gap sparse)
+    file.seekp(static_cast<std::streamoff>(fileSize - 1));
+    file.put('\0');
+
+    return static_cast<bool>(file);
+}
+
+bool RawImageFile::Save(const std::string& fileName, const Image& img, const int tileSize/* = DEFAULT_TILE_SIZE*/)
+{
+    if (!img.IsInitialized() || !Create(fileName, img.GetHeight(), img.GetWidth(), tileSize))
+        return false;
+
+    RawImageFile file;
+    return file.Open(fileName, OpenMode::READ_WRITE) && file.WriteRegion(0, 0, img);
+}
+
+bool RawImageFile::Load(const std::string& fileName, Image& img)
+{
+    RawImageFile file;
+    if (!file.Open(fileName))
+        return false;
+
+    img = Image(file.GetHeight(), file.GetWidth());
+    return file.ReadRegion(0, 0, img);
+}
+
+bool RawImageFile::Open(const std::string& fileName, OpenMode mode/* = OpenMode::READ*/)
+{
+    Close();
+
+    RawFileHeader header;
+    std::uint64_t fileSize;
+    {
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            !IsValidHeader(header) || !CalcFileSize(header, fileSize))
+            return false;
+    }
+
+    const bool writable = (mode == OpenMode::READ_WRITE);
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+                              FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER realSize;
+    HANDLE mapping = nullptr;
+    void* data = nullptr;
+    if (GetFileSizeEx(file, &realSize) && static_cast<std::uint64_t>(realSize.QuadPart) >= fileSize)
+        mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    if (mapping != nullptr)
+        data = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(fileSize));
+
+    if (data == nullptr)
+    {
+        if (mapping != nullptr)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    mFile = reinterpret_cast<std::intptr_t>(file);
+    mMapping = reinterpret_cast<std::intptr_t>(mapping);
+#else
+    int file = open(fileName.c_str(), writable ? O_RDWR : O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat fileStat;
+    void* data = MAP_FAILED;
+    if (fstat(file, &fileStat) == 0 && static_cast<std::uint64_t>(fileStat.st_size) >= fileSize)
+        data = mmap(nullptr, static_cast<size_t>(fileSize), writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, file, 0);
+
+    if (data == MAP_FAILED)
+    {
+        close(file);
+        return false;
+    }
+
+    mFile = file;
+#endif
+
+    mData = static_cast<Image::Byte*>(data);
+    mMappedSize = static_cast<std::size_t>(fileSize);
+    mPayloadOffset = static_cast<std::size_t>(header.payloadOffset);
+    mTileStride = static_cast<std::size_t>(header.tileStride);
+    mMode = mode;
+    mWidth = header.width;
+    mHeight = header.height;
+    mTileSize = header.tileSize;
+    mNumTilesX = static_cast<int>(NumTiles(mWidth, mTileSize));
+    mNumTilesY = static_cast<int>(NumTiles(mHeight, mTileSize));
+
+    return true;
+}
+
+void RawImageFile::Close()
+{
+    if (!IsOpened())
+        return;
+
+#ifdef _WIN32
+    if (mMode == OpenMode::READ_WRITE)
+        FlushViewOfFile(mData, 0);
+    UnmapViewOfFile(mData);
+    CloseHandle(reinterpret_cast<HANDLE>(mMapping));
+    CloseHandle(reinterpret_cast<HANDLE>(mFile));
+#else
+    if (mMode == OpenMode::READ_WRITE)
+        msync(mData, mMappedSize, MS_SYNC);
+    munmap(mData, mMappedSize);
+    close(static_cast<int>(mFile));
+#endif
+
+    mData = nullptr;
+    mMappedSize = mPayloadOffset = mTileStride = 0;
+    mFile = mMapping = INVALID_FILE;
+    mWidth = mHeight = -1;
+    mTileSize = mNumTilesX = mNumTilesY = 0;
+}
+
+std::size_t RawImageFile::GetTileOffset(const int tileRow, const int tileCol) const
+{
+    return mPayloadOffset + (static_cast<std::size_t>(tileRow) * mNumTilesX + tileCol) * mTileStride;
+}
+
+const Image::Byte* RawImageFile::GetTilePointer(const int tileRow, const int tileCol) const
+{
+    if (!IsOpened() || tileRow < 0 || tileRow >= mNumTilesY || tileCol < 0 || tileCol >= mNumTilesX)
+        return nullptr;
+
+    return mData + GetTileOffset(tileRow, tileCol);
+}
+
+Image::Byte* RawImageFile::GetTilePointer(const int tileRow, const int tileCol)
+{
+    if (mMode != OpenMode::READ_WRITE)
+        return nullptr;
+
+    return const_cast<Image::Byte*>(static_cast<const RawImageFile*>(this)->GetTilePointer(tileRow, tileCol));
+}
+
+void RawImageFile::CopyRegion(const int x, const int y, const int width, const int height,
+                              Image::Byte* pImg, const bool toImage) const
+{
+    const int tileRowBegin = y / mTileSize, tileRowEnd = (y + height - 1) / mTileSize;
+    const int tileColBegin = x / mTileSize, tileColEnd = (x + width - 1) / mTileSize;
+
+    for (int tileRow = tileRowBegin; tileRow <= tileRowEnd; ++tileRow)
+    {
+        const int rowBegin = std::max(y, tileRow * mTileSize);
+        const int rowEnd = std::min(y + height, (tileRow + 1) * mTileSize);
+
+        for (int tileCol = tileColBegin; tileCol <= tileColEnd; ++tileCol)
+        {
+            const int colBegin = std::max(x, tileCol * mTileSize);
+            const int colEnd = std::min(x + width, (tileCol + 1) * mTileSize);
+            const int length = colEnd - colBegin;
+
+            Image::Byte* pTile = mData + GetTileOffset(tileRow, tileCol);
+            for (int row = rowBegin; row < rowEnd; ++row)
+            {
+                Image::Byte* pTileRow = pTile + (row - tileRow * mTileSize) * mTileSize + (colBegin - tileCol * mTileSize);
+                Image::Byte* pImgRow = pImg + static_cast<std::size_t>(row - y) * width + (colBegin - x);
+
+                if (toImage)
+                    memcpy(pImgRow, pTileRow, length);
+                else
+                    memcpy(pTileRow, pImgRow, length);
+            }
+        }
+    }
+}
+
+bool RawImageFile::ReadRegion(const int x, const int y, Image& dstImg) const
+{
+    if (!IsOpened() || !dstImg.IsInitialized() || x < 0 || y < 0 ||
+        x + dstImg.GetWidth() > mWidth || y + dstImg.GetHeight() > mHeight)
+        return false;
+
+    CopyRegion(x, y, dstImg.GetWidth(), dstImg.GetHeight(), dstImg.GetRawPointer(), true);
+
+    return true;
+}
+
+bool RawImageFile::WriteRegion(const int x, const int y, const Image& srcImg)
+{
+    if (!IsOpened() || mMode != OpenMode::READ_WRITE || !srcImg.IsInitialized() || x < 0 || y < 0 ||
+        x + srcImg.GetWidth() > mWidth || y + srcImg.GetHeight() > mHeight)
+        return false;
+
+    CopyRegion(x, y, srcImg.GetWidth(), srcImg.GetHeight(), const_cast<Image::Byte*>(srcImg.GetRawPointer()), false);
+
+    return true;
+}
+
+void RawImageFile::PrefetchTileRows(const int tileRowBegin, const int tileRowEnd) const
+{
+    AdviseTiles(tileRowBegin, tileRowEnd, 0, mNumTilesX, true);
+}
+
+void RawImageFile::ReleaseTileRows(const int tileRowBegin, const int tileRowEnd) const
+{
+    AdviseTiles(tileRowBegin, tileRowEnd, 0, mNumTilesX, false);
+}
+
+void RawImageFile::ReleaseTiles(const int tileRowBegin, const int tileRowEnd, const int tileColBegin, const int tileColEnd) const
+{
+    AdviseTiles(tileRowBegin, tileRowEnd, tileColBegin, tileColEnd, false);
+}
+
+void RawImageFile::AdviseTiles(const int tileRowBegin, const int tileRowEnd, const int tileColBegin, const int tileColEnd, const bool willNeed) const
+{
+    const int rowBegin = std::max(tileRowBegin, 0), rowEnd = std::min(tileRowEnd, mNumTilesY);
+    const int colBegin = std::max(tileColBegin, 0), colEnd = std::min(tileColEnd, mNumTilesX);
+    if (!IsOpened() || rowBegin >= rowEnd || colBegin >= colEnd)
+        return;
+
+#ifdef _WIN32
+    // The hints are not used in Windows, the pages are loaded and released by system
+    (void)willNeed;
+#else
+    // The tiles of one row are placed contiguously (and the rows too if all columns are used),
+    // the ranges are aligned to pages
+    const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const bool allColumns = (colBegin == 0 && colEnd == mNumTilesX);
+
+    for (int row = rowBegin; row < rowEnd; row = allColumns ? rowEnd : row + 1)
+    {
+        const std::size_t begin = GetTileOffset(row, colBegin) / pageSize * pageSize;
+        const std::size_t end = std::min(allColumns ? GetTileOffset(rowEnd, 0) : GetTileOffset(row, colEnd), mMappedSize);
+
+        madvise(mData + begin, end - begin, willNeed ? MADV_WILLNEED : MADV_DONTNEED);
+    }
+#endif
+}
+
+}
@@ -0,0 +1,609 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of vectorized kernels for several instruction sets
+
+#include <algorithm>
+#include <cstdlib>
+
+// The variants are compiled by the targets of functions, so the binary runs on any processor of platform
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNELS_X86
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx2,avx512f,avx512bw")))
+#define SIMD_TARGET_AVX512VBMI __attribute__((target("avx2,avx512f,avx512bw,avx512vbmi")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define SIMD_KERNELS_X86
+#define SIMD_TARGET_AVX2
+#define SIMD_TARGET_AVX512
+#define SIMD_TARGET_AVX512VBMI
+#include <immintrin.h>
+#endif
+
+#include "SimdKernels.h"
+
+namespace acv {
+
+typedef SimdKernels::Byte Byte;
+
+// Scalar reference kernels
+
+static void ConvolveRowScalar(const Byte* pSrc, const int srcStride, const int* pFilter, const int filterSize,
+                              const int divider, Byte* pDst, const int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        int conv = 0;
+
+        const Byte* pWindow = pSrc + i;
+        const int* pCoef = pFilter;
+        for (int row = 0; row < filterSize; ++row, pWindow += srcStride)
+            for (int col = 0; col < filterSize; ++col)
+                conv += *pCoef++ * pWindow[col];
+
+        if (divider != 0)
+            conv /= divider;
+
+        Image::CheckPixelValue(conv);
+        pDst[i] = static_cast<Byte>(conv);
+    }
+}
+
+static void SobelHRowScalar(const Byte* pTop, const Byte* pBottom, Byte* pDst, const int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        int res = pTop[i - 1] + (pTop[i] << 1) + pTop[i + 1] - pBottom[i - 1] - (pBottom[i] << 1) - pBottom[i + 1];
+
+        Image::CheckPixelValue(res);
+        pDst[i] = static_cast<Byte>(res);
+    }
+}
+
+static void SobelVRowScalar(const Byte* pTop, const Byte* pMiddle, const Byte* pBottom, Byte* pDst, const int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        int res = pTop[i - 1] - pTop[i + 1] + (pMiddle[i - 1] << 1) - (pMiddle[i + 1] << 1) + pBottom[i - 1] - pBottom[i + 1];
+
+        Image::CheckPixelValue(res);
+        pDst[i] = static_cast<Byte>(res);
+    }
+}
+
+static void ApplyLookUpTableScalar(const Byte* pSrc, Byte* pDst, const size_t count, const Byte* pTable)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = pTable[pSrc[i]];
+}
+
+static void AccumulateRowScalar(const Byte* pSrc, uint32_t* pSums, const int count)
+{
+    for (int i = 0; i < count; ++i)
+        pSums[i] += pSrc[i];
+}
+
+static void ThresholdRowScalar(const Byte* pSrc, const Byte* pLevel, Byte* pDst, const size_t count,
+                               const int threshold, const Byte moreVal, const Byte lessVal)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = (pSrc[i] > pLevel[i] - threshold) ? moreVal : lessVal;
+}
+
+static void BlendBilinearRowScalar(const Byte* pTopLeft, const Byte* pTopRight, const Byte* pBottomLeft, const Byte* pBottomRight,
+                                   const Byte* pWeightsX, const int weightY, Byte* pDst, const int count)
+{
+    const int ONE = SimdKernels::BLEND_WEIGHT_ONE;
+    for (int i = 0; i < count; ++i)
+    {
+        const int top = pTopLeft[i] * ONE + (pTopRight[i] - pTopLeft[i]) * pWeightsX[i];
+        const int bottom = pBottomLeft[i] * ONE + (pBottomRight[i] - pBottomLeft[i]) * pWeightsX[i];
+        pDst[i] = static_cast<Byte>((top * (ONE - weightY) + bottom * weightY + ONE * ONE / 2) / (ONE * ONE));
+    }
+}
+
+static void UnsharpMaskRowScalar(const Byte* pSrc, const Byte* pBlurred, Byte* pDst, const int count,
+                                 const int amount, const int threshold)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const int diff = pSrc[i] - pBlurred[i];
+        int value = pSrc[i];
+        if (std::abs(diff) >= threshold)
+            value += (diff * amount + SimdKernels::UNSHARP_AMOUNT_ONE / 2) >> 8; // Arithmetic shift rounds down
+        pDst[i] = static_cast<Byte>(std::max(0, std::min(value, 255)));
+    }
+}
+
+// The difference of pixels is in range [-255, 255], so the threshold out of range [-256, 256] gives the same result
+// as the nearest boundary, and the comparison can be done by 16-bit integers
+static int ClampThreshold(const int threshold)
+{
+    return std::max(-256, std::min(threshold, 256));
+}
+
+#ifdef SIMD_KERNELS_X86
+
+// AVX2 kernels
+
+// Pack 16 signed words to 16 bytes with unsigned saturation (clamping to the range of pixel)
+SIMD_TARGET_AVX2 static inline __m128i PackWordsAVX2(const __m256i words)
+{
+    return _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+}
+
+// Divide 8 integers with truncation (the quotient of integers is exact in double precision)
+SIMD_TARGET_AVX2 static inline __m256i DivideAVX2(const __m256i sums, const __m256d divider)
+{
+    const __m128i lo = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(sums)), divider));
+    const __m128i hi = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(sums, 1)), divider));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+SIMD_TARGET_AVX2 static void ConvolveRowAVX2(const Byte* pSrc, const int srcStride, const int* pFilter, const int filterSize,
+                                             const int divider, Byte* pDst, const int count)
+{
+    const __m256d dividerVec = _mm256_set1_pd(divider);
+
+    int i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i sum0 = _mm256_setzero_si256();
+        __m256i sum1 = _mm256_setzero_si256();
+
+        const Byte* pWindow = pSrc + i;
+        const int* pCoef = pFilter;
+        for (int row = 0; row < filterSize; ++row, pWindow += srcStride)
+        {
+            for (int col = 0; col < filterSize; ++col)
+            {
+                const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWindow + col));
+                const __m256i coef = _mm256_set1_epi32(*pCoef++);
+                sum0 = _mm256_add_epi32(sum0, _mm256_mullo_epi32(_mm256_cvtepu8_epi32(pixels), coef));
+                sum1 = _mm256_add_epi32(sum1, _mm256_mullo_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(pixels, 8)), coef));
+            }
+        }
+
+        if (divider != 0)
+        {
+            sum0 = DivideAVX2(sum0, dividerVec);
+            sum1 = DivideAVX2(sum1, dividerVec);
+        }
+
+        const __m256i words = _mm256_permute4x64_epi64(_mm256_packs_epi32(sum0, sum1), 0xD8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), PackWordsAVX2(words));
+    }
+
+    ConvolveRowScalar(pSrc + i, srcStride, pFilter, filterSize, divider, pDst + i, count - i);
+}
+
+// Load 16 pixels as words
+SIMD_TARGET_AVX2 static inline __m256i LoadWordsAVX2(const Byte* pSrc)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc)));
+}
+
+SIMD_TARGET_AVX2 static void SobelHRowAVX2(const Byte* pTop, const Byte* pBottom, Byte* pDst, const int count)
+{
+    int i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i top = _mm256_add_epi16(_mm256_add_epi16(LoadWordsAVX2(pTop + i - 1), LoadWordsAVX2(pTop + i + 1)),
+                                             _mm256_slli_epi16(LoadWordsAVX2(pTop + i), 1));
+        const __m256i bottom = _mm256_add_epi16(_mm256_add_epi16(LoadWordsAVX2(pBottom + i - 1), LoadWordsAVX2(pBottom + i + 1)),
+                                                _mm256_slli_epi16(LoadWordsAVX2(pBottom + i), 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), PackWordsAVX2(_mm256_sub_epi16(top, bottom)));
+    }
+
+    SobelHRowScalar(pTop + i, pBottom + i, pDst + i, count - i);
+}
+
+SIMD_TARGET_AVX2 static void SobelVRowAVX2(const Byte* pTop, const Byte* pMiddle, const Byte* pBottom, Byte* pDst, const int count)
+{
+    int i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i left = _mm256_add_epi16(_mm256_add_epi16(LoadWordsAVX2(pTop + i - 1), LoadWordsAVX2(pBottom + i - 1)),
+                                              _mm256_slli_epi16(LoadWordsAVX2(pMiddle + i - 1), 1));
+        const __m256i right = _mm256_add_epi16(_mm256_add_epi16(LoadWordsAVX2(pTop + i + 1), LoadWordsAVX2(pBottom + i + 1)),
+                                               _mm256_slli_epi16(LoadWordsAVX2(pMiddle + i + 1), 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), PackWordsAVX2(_mm256_sub_epi16(left, right)));
+    }
+
+    SobelVRowScalar(pTop + i, pMiddle + i, pBottom + i, pDst + i, count - i);
+}
+
+SIMD_TARGET_AVX2 static void AccumulateRowAVX2(const Byte* pSrc, uint32_t* pSums, const int count)
+{
+    int i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+        __m256i* pSums0 = reinterpret_cast<__m256i*>(pSums + i);
+        __m256i* pSums1 = reinterpret_cast<__m256i*>(pSums + i + 8);
+
+        _mm256_storeu_si256(pSums0, _mm256_add_epi32(_mm256_loadu_si256(pSums0), _mm256_cvtepu8_epi32(pixels)));
+        _mm256_storeu_si256(pSums1, _mm256_add_epi32(_mm256_loadu_si256(pSums1), _mm256_cvtepu8_epi32(_mm_srli_si128(pixels, 8))));
+    }
+
+    AccumulateRowScalar(pSrc + i, pSums + i, count - i);
+}
+
+SIMD_TARGET_AVX2 static void ThresholdRowAVX2(const Byte* pSrc, const Byte* pLevel, Byte* pDst, const size_t count,
+                                              const int threshold, const Byte moreVal, const Byte lessVal)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i thresholdVec = _mm256_set1_epi16(static_cast<short>(ClampThreshold(threshold)));
+    const __m256i moreVec = _mm256_set1_epi8(static_cast<char>(moreVal));
+    const __m256i lessVec = _mm256_set1_epi8(static_cast<char>(lessVal));
+
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + i));
+        const __m256i level = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLevel + i));
+
+        // src - level + threshold > 0 (unpacking and packing inside of lanes keep the order of pixels)
+        const __m256i diffLo = _mm256_add_epi16(_mm256_sub_epi16(_mm256_unpacklo_epi8(src, zero), _mm256_unpacklo_epi8(level, zero)), thresholdVec);
+        const __m256i diffHi = _mm256_add_epi16(_mm256_sub_epi16(_mm256_unpackhi_epi8(src, zero), _mm256_unpackhi_epi8(level, zero)), thresholdVec);
+        const __m256i mask = _mm256_packs_epi16(_mm256_cmpgt_epi16(diffLo, zero), _mm256_cmpgt_epi16(diffHi, zero));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), _mm256_blendv_epi8(lessVec, moreVec, mask));
+    }
+
+    ThresholdRowScalar(pSrc + i, pLevel + i, pDst + i, count - i, threshold, moreVal, lessVal);
+}
+
+SIMD_TARGET_AVX2 static void BlendBilinearRowAVX2(const Byte* pTopLeft, const Byte* pTopRight, const Byte* pBottomLeft, const Byte* pBottomRight,
+                                                  const Byte* pWeightsX, const int weightY, Byte* pDst, const int count)
+{
+    // The horizontal sums are not larger than 255 * 128, so they are calculated by 16-bit words (the shift by 7 is
+    // the multiplication by BLEND_WEIGHT_ONE), the vertical sums are calculated by pairs of words multiplied to 32-bit integers
+    const int ONE = SimdKernels::BLEND_WEIGHT_ONE;
+    const __m256i weightsY = _mm256_set1_epi32((weightY << 16) | (ONE - weightY));
+    const __m256i half = _mm256_set1_epi32(ONE * ONE / 2);
+
+    int i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i weightsX = LoadWordsAVX2(pWeightsX + i);
+        const __m256i topLeft = LoadWordsAVX2(pTopLeft + i);
+        const __m256i bottomLeft = LoadWordsAVX2(pBottomLeft + i);
+        const __m256i top = _mm256_add_epi16(_mm256_slli_epi16(topLeft, 7),
+                                             _mm256_mullo_epi16(_mm256_sub_epi16(LoadWordsAVX2(pTopRight + i), topLeft), weightsX));
+        const __m256i bottom = _mm256_add_epi16(_mm256_slli_epi16(bottomLeft, 7),
+                                                _mm256_mullo_epi16(_mm256_sub_epi16(LoadWordsAVX2(pBottomRight + i), bottomLeft), weightsX));
+
+        // Unpacking and packing inside of lanes keep the order of pixels
+        const __m256i sumLo = _mm256_srli_epi32(_mm256_add_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(top, bottom), weightsY), half), 14);
+        const __m256i sumHi = _mm256_srli_epi32(_mm256_add_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(top, bottom), weightsY), half), 14);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), PackWordsAVX2(_mm256_packs_epi32(sumLo, sumHi)));
+    }
+
+    BlendBilinearRowScalar(pTopLeft + i, pTopRight + i, pBottomLeft + i, pBottomRight + i, pWeightsX + i, weightY, pDst + i, count - i);
+}
+
+SIMD_TARGET_AVX2 static void UnsharpMaskRowAVX2(const Byte* pSrc, const Byte* pBlurred, Byte* pDst, const int count,
+                                                const int amount, const int threshold)
+{
+    // The product of difference and amount needs 32 bits, it is assembled from the low and high words of products
+    // (the shifted product is not larger than 255 * UNSHARP_AMOUNT_MAX / 256, so it is packed to words without saturation)
+    const __m256i amountVec = _mm256_set1_epi16(static_cast<short>(amount));
+    const __m256i thresholdVec = _mm256_set1_epi16(static_cast<short>(ClampThreshold(threshold) - 1));
+    const __m256i half = _mm256_set1_epi32(SimdKernels::UNSHARP_AMOUNT_ONE / 2);
+
+    int i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i src = LoadWordsAVX2(pSrc + i);
+        const __m256i diff = _mm256_sub_epi16(src, LoadWordsAVX2(pBlurred + i));
+        const __m256i productLo = _mm256_mullo_epi16(diff, amountVec);
+        const __m256i productHi = _mm256_mulhi_epi16(diff, amountVec);
+
+        // Unpacking and packing inside of lanes keep the order of pixels
+        const __m256i deltaLo = _mm256_srai_epi32(_mm256_add_epi32(_mm256_unpacklo_epi16(productLo, productHi), half), 8);
+        const __m256i deltaHi = _mm256_srai_epi32(_mm256_add_epi32(_mm256_unpackhi_epi16(productLo, productHi), half), 8);
+        const __m256i mask = _mm256_cmpgt_epi16(_mm256_abs_epi16(diff), thresholdVec);
+        const __m256i delta = _mm256_and_si256(_mm256_packs_epi32(deltaLo, deltaHi), mask);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), PackWordsAVX2(_mm256_add_epi16(src, delta)));
+    }
+
+    UnsharpMaskRowScalar(pSrc + i, pBlurred + i, pDst + i, count - i, amount, threshold);
+}
+
+// AVX-512 kernels
+// The intrinsics which are implemented by GCC with the undefined source vector (conversions, shifts, inserts, min/max
+// of integers) are used in the zero-masking forms with the full mask, so the build is free of uninitialized warnings
+
+// Divide 16 integers with truncation (the quotient of integers is exact in double precision)
+SIMD_TARGET_AVX512 static inline __m512i DivideAVX512(const __m512i sums, const __m512d divider)
+{
+    const __m256i lo = _mm512_maskz_cvttpd_epi32(0xFF, _mm512_div_pd(_mm512_maskz_cvtepi32_pd(0xFF, _mm512_maskz_extracti64x4_epi64(0xF, sums, 0)), divider));
+    const __m256i hi = _mm512_maskz_cvttpd_epi32(0xFF, _mm512_div_pd(_mm512_maskz_cvtepi32_pd(0xFF, _mm512_maskz_extracti64x4_epi64(0xF, sums, 1)), divider));
+    return _mm512_maskz_inserti64x4(0xFF, _mm512_maskz_inserti64x4(0xFF, _mm512_setzero_si512(), lo, 0), hi, 1);
+}
+
+// Clamp 16 integers to the range of pixel and convert them to bytes
+SIMD_TARGET_AVX512 static inline __m128i PackIntegersAVX512(const __m512i values)
+{
+    const __m512i clamped = _mm512_maskz_min_epi32(0xFFFF, _mm512_maskz_max_epi32(0xFFFF, values, _mm512_setzero_si512()),
+                                                   _mm512_set1_epi32(Image::MAX_PIXEL_VALUE));
+    return _mm512_maskz_cvtepi32_epi8(0xFFFF, clamped);
+}
+
+SIMD_TARGET_AVX512 static void ConvolveRowAVX512(const Byte* pSrc, const int srcStride, const int* pFilter, const int filterSize,
+                                                 const int divider, Byte* pDst, const int count)
+{
+    const __m512d dividerVec = _mm512_set1_pd(divider);
+
+    int i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        __m512i sum0 = _mm512_setzero_si512();
+        __m512i sum1 = _mm512_setzero_si512();
+
+        const Byte* pWindow = pSrc + i;
+        const int* pCoef = pFilter;
+        for (int row = 0; row < filterSize; ++row, pWindow += srcStride)
+        {
+            for (int col = 0; col < filterSize; ++col)
+            {
+                const __m512i coef = _mm512_set1_epi32(*pCoef++);
+                const __m512i pixels0 = _mm512_maskz_cvtepu8_epi32(0xFFFF, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWindow + col)));
+                const __m512i pixels1 = _mm512_maskz_cvtepu8_epi32(0xFFFF, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWindow + col + 16)));
+                sum0 = _mm512_add_epi32(sum0, _mm512_mullo_epi32(pixels0, coef));
+                sum1 = _mm512_add_epi32(sum1, _mm512_mullo_epi32(pixels1, coef));
+            }
+        }
+
+        if (divider != 0)
+        {
+            sum0 = DivideAVX512(sum0, dividerVec);
+            sum1 = DivideAVX512(sum1, dividerVec);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), PackIntegersAVX512(sum0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i + 16), PackIntegersAVX512(sum1));
+    }
+
+    ConvolveRowAVX2(pSrc + i, srcStride, pFilter, filterSize, divider, pDst + i, count - i);
+}
+
+// Load 32 pixels as words
+SIMD_TARGET_AVX512 static inline __m512i LoadWordsAVX512(const Byte* pSrc)
+{
+    return _mm512_maskz_cvtepu8_epi16(0xFFFFFFFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc)));
+}
+
+// Clamp 32 signed words to the range of pixel and convert them to bytes
+SIMD_TARGET_AVX512 static inline __m256i PackWordsAVX512(const __m512i words)
+{
+    return _mm512_maskz_cvtusepi16_epi8(0xFFFFFFFF, _mm512_max_epi16(words, _mm512_setzero_si512()));
+}
+
+SIMD_TARGET_AVX512 static void SobelHRowAVX512(const Byte* pTop, const Byte* pBottom, Byte* pDst, const int count)
+{
+    int i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m512i top = _mm512_add_epi16(_mm512_add_epi16(LoadWordsAVX512(pTop + i - 1), LoadWordsAVX512(pTop + i + 1)),
+                                             _mm512_slli_epi16(LoadWordsAVX512(pTop + i), 1));
+        const __m512i bottom = _mm512_add_epi16(_mm512_add_epi16(LoadWordsAVX512(pBottom + i - 1), LoadWordsAVX512(pBottom + i + 1)),
+                                                _mm512_slli_epi16(LoadWordsAVX512(pBottom + i), 1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), PackWordsAVX512(_mm512_sub_epi16(top, bottom)));
+    }
+
+    SobelHRowAVX2(pTop + i, pBottom + i, pDst + i, count - i);
+}
+
+SIMD_TARGET_AVX512 static void SobelVRowAVX512(const Byte* pTop, const Byte* pMiddle, const Byte* pBottom, Byte* pDst, const int count)
+{
+    int i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m512i left = _mm512_add_epi16(_mm512_add_epi16(LoadWordsAVX512(pTop + i - 1), LoadWordsAVX512(pBottom + i - 1)),
+                                              _mm512_slli_epi16(LoadWordsAVX512(pMiddle + i - 1), 1));
+        const __m512i right = _mm512_add_epi16(_mm512_add_epi16(LoadWordsAVX512(pTop + i + 1), LoadWordsAVX512(pBottom + i + 1)),
+                                               _mm512_slli_epi16(LoadWordsAVX512(pMiddle + i + 1), 1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), PackWordsAVX512(_mm512_sub_epi16(left, right)));
+    }
+
+    SobelVRowAVX2(pTop + i, pMiddle + i, pBottom + i, pDst + i, count - i);
+}
+
+SIMD_TARGET_AVX512VBMI static void ApplyLookUpTableAVX512VBMI(const Byte* pSrc, Byte* pDst, const size_t count, const Byte* pTable)
+{
+    // Two permutes of bytes select from the low and the high halves of table, the high bit of index selects the half
+    const __m512i table0 = _mm512_loadu_si512(pTable);
+    const __m512i table1 = _mm512_loadu_si512(pTable + 64);
+    const __m512i table2 = _mm512_loadu_si512(pTable + 128);
+    const __m512i table3 = _mm512_loadu_si512(pTable + 192);
+
+    size_t i = 0;
+    for (; i + 64 <= count; i += 64)
+    {
+        const __m512i indices = _mm512_loadu_si512(pSrc + i);
+        const __m512i lowHalf = _mm512_permutex2var_epi8(table0, indices, table1);
+        const __m512i highHalf = _mm512_permutex2var_epi8(table2, indices, table3);
+        _mm512_storeu_si512(pDst + i, _mm512_mask_blend_epi8(_mm512_movepi8_mask(indices), lowHalf, highHalf));
+    }
+
+    ApplyLookUpTableScalar(pSrc + i, pDst + i, count - i, pTable);
+}
+
+SIMD_TARGET_AVX512 static void AccumulateRowAVX512(const Byte* pSrc, uint32_t* pSums, const int count)
+{
+    int i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        uint32_t* pSums0 = pSums + i;
+        uint32_t* pSums1 = pSums + i + 16;
+
+        const __m512i pixels0 = _mm512_maskz_cvtepu8_epi32(0xFFFF, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i)));
+        const __m512i pixels1 = _mm512_maskz_cvtepu8_epi32(0xFFFF, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i + 16)));
+        _mm512_storeu_si512(pSums0, _mm512_add_epi32(_mm512_loadu_si512(pSums0), pixels0));
+        _mm512_storeu_si512(pSums1, _mm512_add_epi32(_mm512_loadu_si512(pSums1), pixels1));
+    }
+
+    AccumulateRowAVX2(pSrc + i, pSums + i, count - i);
+}
+
+SIMD_TARGET_AVX512 static void ThresholdRowAVX512(const Byte* pSrc, const Byte* pLevel, Byte* pDst, const size_t count,
+                                                  const int threshold, const Byte moreVal, const Byte lessVal)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i thresholdVec = _mm512_set1_epi16(static_cast<short>(ClampThreshold(threshold)));
+    const __m512i moreVec = _mm512_set1_epi8(static_cast<char>(moreVal));
+    const __m512i lessVec = _mm512_set1_epi8(static_cast<char>(lessVal));
+
+    size_t i = 0;
+    for (; i + 64 <= count; i += 64)
+    {
+        const __m512i diffLo = _mm512_add_epi16(_mm512_sub_epi16(LoadWordsAVX512(pSrc + i), LoadWordsAVX512(pLevel + i)), thresholdVec);
+        const __m512i diffHi = _mm512_add_epi16(_mm512_sub_epi16(LoadWordsAVX512(pSrc + i + 32), LoadWordsAVX512(pLevel + i + 32)), thresholdVec);
+
+        const __mmask64 mask = static_cast<__mmask64>(_mm512_cmpgt_epi16_mask(diffLo, zero)) |
+                               (static_cast<__mmask64>(_mm512_cmpgt_epi16_mask(diffHi, zero)) << 32);
+        _mm512_storeu_si512(pDst + i, _mm512_mask_blend_epi8(mask, lessVec, moreVec));
+    }
+
+    ThresholdRowAVX2(pSrc + i, pLevel + i, pDst + i, count - i, threshold, moreVal, lessVal);
+}
+
+SIMD_TARGET_AVX512 static void BlendBilinearRowAVX512(const Byte* pTopLeft, const Byte* pTopRight, const Byte* pBottomLeft, const Byte* pBottomRight,
+                                                      const Byte* pWeightsX, const int weightY, Byte* pDst, const int count)
+{
+    const int ONE = SimdKernels::BLEND_WEIGHT_ONE;
+    const __m512i weightsY = _mm512_set1_epi32((weightY << 16) | (ONE - weightY));
+    const __m512i half = _mm512_set1_epi32(ONE * ONE / 2);
+
+    int i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m512i weightsX = LoadWordsAVX512(pWeightsX + i);
+        const __m512i topLeft = LoadWordsAVX512(pTopLeft + i);
+        const __m512i bottomLeft = LoadWordsAVX512(pBottomLeft + i);
+        const __m512i top = _mm512_add_epi16(_mm512_slli_epi16(topLeft, 7),
+                                             _mm512_mullo_epi16(_mm512_sub_epi16(LoadWordsAVX512(pTopRight + i), topLeft), weightsX));
+        const __m512i bottom = _mm512_add_epi16(_mm512_slli_epi16(bottomLeft, 7),
+                                                _mm512_mullo_epi16(_mm512_sub_epi16(LoadWordsAVX512(pBottomRight + i), bottomLeft), weightsX));
+
+        const __m512i sumLo = _mm512_maskz_srli_epi32(0xFFFF, _mm512_add_epi32(_mm512_madd_epi16(_mm512_unpacklo_epi16(top, bottom), weightsY), half), 14);
+        const __m512i sumHi = _mm512_maskz_srli_epi32(0xFFFF, _mm512_add_epi32(_mm512_madd_epi16(_mm512_unpackhi_epi16(top, bottom), weightsY), half), 14);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), PackWordsAVX512(_mm512_packs_epi32(sumLo, sumHi)));
+    }
+
+    BlendBilinearRowAVX2(pTopLeft + i, pTopRight + i, pBottomLeft + i, pBottomRight + i, pWeightsX + i, weightY, pDst + i, count - i);
+}
+
+SIMD_TARGET_AVX512 static void UnsharpMaskRowAVX512(const Byte* pSrc, const Byte* pBlurred, Byte* pDst, const int count,
+                                                    const int amount, const int threshold)
+{
+    const __m512i amountVec = _mm512_set1_epi16(static_cast<short>(amount));
+    const __m512i thresholdVec = _mm512_set1_epi16(static_cast<short>(ClampThreshold(threshold) - 1));
+    const __m512i half = _mm512_set1_epi32(SimdKernels::UNSHARP_AMOUNT_ONE / 2);
+
+    int i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m512i src = LoadWordsAVX512(pSrc + i);
+        const __m512i diff = _mm512_sub_epi16(src, LoadWordsAVX512(pBlurred + i));
+        const __m512i productLo = _mm512_mullo_epi16(diff, amountVec);
+        const __m512i productHi = _mm512_mulhi_epi16(diff, amountVec);
+
+        const __m512i deltaLo = _mm512_maskz_srai_epi32(0xFFFF, _mm512_add_epi32(_mm512_unpacklo_epi16(productLo, productHi), half), 8);
+        const __m512i deltaHi = _mm512_maskz_srai_epi32(0xFFFF, _mm512_add_epi32(_mm512_unpackhi_epi16(productLo, productHi), half), 8);
+        const __mmask32 mask = _mm512_cmpgt_epi16_mask(_mm512_abs_epi16(diff), thresholdVec);
+        const __m512i delta = _mm512_maskz_mov_epi16(mask, _mm512_packs_epi32(deltaLo, deltaHi));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i), PackWordsAVX512(_mm512_add_epi16(src, delta)));
+    }
+
+    UnsharpMaskRowAVX2(pSrc + i, pBlurred + i, pDst + i, count - i, amount, threshold);
+}
+
+#endif
+
+// Tables of kernels
+
+static const SimdKernels& GetScalarKernels()
+{
+    static const SimdKernels kernels = { ConvolveRowScalar, SobelHRowScalar, SobelVRowScalar,
+                                         ApplyLookUpTableScalar, AccumulateRowScalar, ThresholdRowScalar,
+                                         BlendBilinearRowScalar, UnsharpMaskRowScalar };
+    return kernels;
+}
+
+#ifdef SIMD_KERNELS_X86
+
+static const SimdKernels& GetAVX2Kernels()
+{
+    // The look-up table is not vectorized without byte permutes: the shuffles of 16 parts of table
+    // are not faster than the scalar loads
+    static const SimdKernels kernels = { ConvolveRowAVX2, SobelHRowAVX2, SobelVRowAVX2,
+                                         ApplyLookUpTableScalar, AccumulateRowAVX2, ThresholdRowAVX2,
+                                         BlendBilinearRowAVX2, UnsharpMaskRowAVX2 };
+    return kernels;
+}
+
+static const SimdKernels& GetAVX512Kernels()
+{
+    // The byte permutes of look-up table need VBMI (Ice Lake, Zen 4), Skylake-SP uses the scalar table
+    static const SimdKernels kernels = { ConvolveRowAVX512, SobelHRowAVX512, SobelVRowAVX512,
+                                         CpuFeatures::HasAVX512VBMI() ? ApplyLookUpTableAVX512VBMI : ApplyLookUpTableScalar,
+                                         AccumulateRowAVX512, ThresholdRowAVX512, BlendBilinearRowAVX512,
+                                         UnsharpMaskRowAVX512 };
+    return kernels;
+}
+
+#endif
+
+const SimdKernels& SimdKernels::Get()
+{
+    return Get(CpuFeatures::GetInstructionSet());
+}
+
+const SimdKernels& SimdKernels::Get(const CpuFeatures::InstructionSet set)
+{
+#ifdef SIMD_KERNELS_X86
+    switch (set)
+    {
+    case CpuFeatures::InstructionSet::AVX512:
+        return GetAVX512Kernels();
+    case CpuFeatures::InstructionSet::AVX2:
+        return GetAVX2Kernels();
+    default:
+        break;
+    }
+#else
+    (void)set;
+#endif
+
+    // SSE2 is the baseline of compiler, so its kernels are the scalar ones vectorized by compiler
+    return GetScalarKernels();
+}
+
+}
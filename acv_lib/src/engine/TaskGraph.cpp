@@ -0,0 +1,128 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of graph of dependent tasks
+
+#include <atomic>
+#include <memory>
+
+#include "TaskGraph.h"
+
+namespace acv {
+
+int TaskGraph::AddTask(const TaskScheduler::Task& task)
+{
+    mNodes.push_back(Node{ task, std::vector<int>(), 0 });
+    return static_cast<int>(mNodes.size()) - 1;
+}
+
+bool TaskGraph::AddDependency(const int predecessor, const int successor)
+{
+    const int numTasks = GetNumTasks();
+    if (predecessor < 0 || predecessor >= numTasks || successor < 0 || successor >= numTasks)
+        return false;
+
+    mNodes[predecessor].successors.push_back(successor);
+    ++mNodes[successor].numPredecessors;
+
+    return true;
+}
+
+bool TaskGraph::IsAcyclic() const
+{
+    const int numTasks = GetNumTasks();
+
+    std::vector<int> numPredecessors(numTasks);
+    std::vector<int> readyTasks;
+    for (int i = 0; i < numTasks; ++i)
+    {
+        numPredecessors[i] = mNodes[i].numPredecessors;
+        if (numPredecessors[i] == 0)
+            readyTasks.push_back(i);
+    }
+
+    int numVisited = 0;
+    while (!readyTasks.empty())
+    {
+        const int task = readyTasks.back();
+        readyTasks.pop_back();
+        ++numVisited;
+
+        for (const int successor : mNodes[task].successors)
+        {
+            if (--numPredecessors[successor] == 0)
+                readyTasks.push_back(successor);
+        }
+    }
+
+    return numVisited == numTasks;
+}
+
+bool TaskGraph::Run() const
+{
+    if (!IsAcyclic())
+        return false;
+
+    const int numTasks = GetNumTasks();
+
+    // Number of not finished predecessors of each task in this run
+    std::unique_ptr<std::atomic<int>[]> numWaiting(new std::atomic<int>[numTasks]);
+    for (int i = 0; i < numTasks; ++i)
+        numWaiting[i].store(mNodes[i].numPredecessors);
+
+    TaskGroup group;
+
+    // The task spawns its successors which have no more predecessors to wait
+    std::function<void(int)> runTask = [&](const int task)
+    {
+        mNodes[task].task();
+
+        for (const int successor : mNodes[task].successors)
+        {
+            if (numWaiting[successor].fetch_sub(1) == 1)
+                group.Run([&runTask, successor]() { runTask(successor); });
+        }
+    };
+
+    for (int i = 0; i < numTasks; ++i)
+    {
+        if (mNodes[i].numPredecessors == 0)
+            group.Run([&runTask, i]() { runTask(i); });
+    }
+
+    group.Wait();
+    return true;
+}
+
+int TaskGraph::GetNumTasks() const
+{
+    return static_cast<int>(mNodes.size());
+}
+
+void TaskGraph::Clear()
+{
+    mNodes.clear();
+}
+
+}
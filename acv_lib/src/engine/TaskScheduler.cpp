@@ -0,0 +1,298 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for classes of scheduler of tasks with work stealing
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include "TaskScheduler.h"
+
+namespace acv {
+
+namespace {
+
+// Index of worker thread of the pool (-1 for the client threads)
+thread_local int tWorkerIndex = -1;
+
+// Deque of tasks of one worker
+// The owner works with the back of deque, the thieves take the tasks from the front
+class TaskDeque
+{
+
+public:
+
+    void PushBack(TaskScheduler::Task task)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTasks.push_back(std::move(task));
+    }
+
+    bool PopBack(TaskScheduler::Task& task)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mTasks.empty())
+            return false;
+
+        task = std::move(mTasks.back());
+        mTasks.pop_back();
+        return true;
+    }
+
+    bool PopFront(TaskScheduler::Task& task)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mTasks.empty())
+            return false;
+
+        task = std::move(mTasks.front());
+        mTasks.pop_front();
+        return true;
+    }
+
+private:
+
+    std::deque<TaskScheduler::Task> mTasks;
+    std::mutex mMutex;
+
+};
+
+// Pool of worker threads with own deques and common queue of tasks of client threads
+class WorkStealingPool
+{
+
+public:
+
+    explicit WorkStealingPool(const int numWorkers)
+        : mNumQueued(0), mStop(false)
+    {
+        for (int i = 0; i < numWorkers; ++i)
+            mDeques.emplace_back(new TaskDeque());
+
+        for (int i = 0; i < numWorkers; ++i)
+            mWorkers.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mCondition.notify_all();
+
+        for (auto& worker : mWorkers)
+            worker.join();
+    }
+
+    // The deques are created before the start of workers, so the workers can read their number during the construction
+    int GetNumWorkers() const { return static_cast<int>(mDeques.size()); }
+
+    void Push(TaskScheduler::Task task)
+    {
+        if (tWorkerIndex >= 0)
+            mDeques[tWorkerIndex]->PushBack(std::move(task));
+        else
+            mCommonQueue.PushBack(std::move(task));
+
+        // The counter is increased before the notification under mutex, so the sleeping threads don't miss the task
+        mNumQueued.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+        }
+        mCondition.notify_one();
+    }
+
+    bool TryRunOne()
+    {
+        TaskScheduler::Task task;
+        if (!TryTake(task))
+            return false;
+
+        task();
+        return true;
+    }
+
+    void WaitForZero(const std::atomic<int>& numPending)
+    {
+        while (numPending.load() > 0)
+        {
+            if (TryRunOne())
+                continue;
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this, &numPending]() { return numPending.load() == 0 || mNumQueued.load() > 0; });
+        }
+    }
+
+    void NotifyAll()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+        }
+        mCondition.notify_all();
+    }
+
+private:
+
+    // Take the task: own deque (LIFO), common queue (FIFO), then steal from other workers (FIFO)
+    bool TryTake(TaskScheduler::Task& task)
+    {
+        const int numWorkers = GetNumWorkers();
+        const int self = tWorkerIndex;
+
+        bool taken = (self >= 0 && mDeques[self]->PopBack(task)) || mCommonQueue.PopFront(task);
+        for (int i = 1; !taken && i <= numWorkers; ++i)
+        {
+            const int victim = (std::max(self, 0) + i) % numWorkers;
+            if (victim != self)
+                taken = mDeques[victim]->PopFront(task);
+        }
+
+        if (taken)
+            mNumQueued.fetch_sub(1);
+
+        return taken;
+    }
+
+    void WorkerLoop(const int index)
+    {
+        tWorkerIndex = index;
+
+        for (;;)
+        {
+            if (TryRunOne())
+                continue;
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this]() { return mStop || mNumQueued.load() > 0; });
+
+            if (mStop)
+                return;
+        }
+    }
+
+    std::vector<std::unique_ptr<TaskDeque>> mDeques;
+    TaskDeque mCommonQueue;
+    std::vector<std::thread> mWorkers;
+    std::atomic<int> mNumQueued;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStop;
+
+};
+
+WorkStealingPool& GetPool()
+{
+    static WorkStealingPool pool(std::max(static_cast<int>(std::thread::hardware_concurrency()), 1) - 1);
+    return pool;
+}
+
+}
+
+void TaskScheduler::Spawn(Task task)
+{
+    GetPool().Push(std::move(task));
+}
+
+bool TaskScheduler::RunOneTask()
+{
+    return GetPool().TryRunOne();
+}
+
+void TaskScheduler::WaitForZero(const std::atomic<int>& numPending)
+{
+    GetPool().WaitForZero(numPending);
+}
+
+void TaskScheduler::NotifyZero()
+{
+    GetPool().NotifyAll();
+}
+
+int TaskScheduler::GetNumThreads()
+{
+    return GetPool().GetNumWorkers() + 1;
+}
+
+TaskGroup::TaskGroup()
+    : mNumPending(0)
+{ }
+
+TaskGroup::~TaskGroup()
+{
+    TaskScheduler::WaitForZero(mNumPending);
+}
+
+void TaskGroup::Run(TaskScheduler::Task task)
+{
+    mNumPending.fetch_add(1);
+    TaskScheduler::Spawn([this, task]()
+    {
+        // The task is counted as finished in any case, so the waiting thread doesn't hang
+        struct FinishGuard
+        {
+            std::atomic<int>& numPending;
+
+            ~FinishGuard()
+            {
+                if (numPending.fetch_sub(1) == 1)
+                    TaskScheduler::NotifyZero();
+            }
+        } guard = { mNumPending };
+
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            // The exception is thrown by Wait() in the waiting thread
+            std::lock_guard<std::mutex> lock(mExceptionMutex);
+            if (!mException)
+                mException = std::current_exception();
+        }
+    });
+}
+
+void TaskGroup::Wait()
+{
+    TaskScheduler::WaitForZero(mNumPending);
+
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(mExceptionMutex);
+        std::swap(exception, mException);
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+}
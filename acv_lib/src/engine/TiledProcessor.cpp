@@ -0,0 +1,281 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class to process the images which are larger than memory
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "TiledProcessor.h"
+#include "RawImageFile.h"
+#include "Image.h"
+#include "Histogram.h"
+
+namespace acv {
+
+TiledProcessor::TiledProcessor(const int memoryLimitMB/* = DEFAULT_MEMORY_LIMIT_MB*/)
+    : mMemoryLimitMB(memoryLimitMB)
+{ }
+
+int TiledProcessor::CalcTileSize(const RawImageFile& dstFile, const int halo) const
+{
+    const double memoryBytes = std::max(mMemoryLimitMB, 1) * 1024.0 * 1024.0;
+    const int expandedSize = static_cast<int>(std::sqrt(memoryBytes / BYTES_PER_TILE_PIXEL));
+
+    // The tile consists of whole tiles of destination file, so the written tiles can be released at once
+    const int fileTileSize = dstFile.GetTileSize();
+    const int tileSize = (expandedSize - 2 * halo) / fileTileSize * fileTileSize;
+
+    return std::max(tileSize, fileTileSize);
+}
+
+int TiledProcessor::CalcIIRHalo(const int filterSize)
+{
+    // Sigma of IIR-filter is filterSize / 6, the filter of small sigma decays slower, so the halo has the minimum
+    return std::max(IIR_HALO_SIGMAS * filterSize / 6, static_cast<int>(MIN_IIR_HALO));
+}
+
+bool TiledProcessor::Process(const RawImageFile& srcFile, RawImageFile& dstFile, const TileOperation& operation, const int halo) const
+{
+    const int width = srcFile.GetWidth();
+    const int height = srcFile.GetHeight();
+
+    if (!srcFile.IsOpened() || !dstFile.IsOpened() || halo < 0 ||
+        dstFile.GetWidth() != width || dstFile.GetHeight() != height)
+        return false;
+
+    const int tileSize = CalcTileSize(dstFile, halo);
+
+    for (int y = 0; y < height; y += tileSize)
+    {
+        const int tileHeight = std::min(tileSize, height - y);
+        const int regionY = std::max(y - halo, 0);
+        const int regionHeight = std::min(y + tileHeight + halo, height) - regionY;
+
+        for (int x = 0; x < width; x += tileSize)
+        {
+            const int tileWidth = std::min(tileSize, width - x);
+            const int regionX = std::max(x - halo, 0);
+            const int regionWidth = std::min(x + tileWidth + halo, width) - regionX;
+
+            // Tile with halo is processed as separate image
+            Image srcImg(regionHeight, regionWidth);
+            Image dstImg(regionHeight, regionWidth);
+            if (!srcFile.ReadRegion(regionX, regionY, srcImg) || !operation(srcImg, dstImg))
+                return false;
+
+            const int innerX = x - regionX, innerY = y - regionY;
+            const Image tileImg = (innerX == 0 && innerY == 0 && tileWidth == regionWidth && tileHeight == regionHeight)
+                                  ? std::move(dstImg)
+                                  : dstImg.Resize(innerX, innerY, innerX + tileWidth - 1, innerY + tileHeight - 1);
+            if (!dstFile.WriteRegion(x, y, tileImg))
+                return false;
+
+            // The written tiles and source tiles which are not used by the next tile of row are released
+            const int nextRegionX = (x + tileSize < width) ? x + tileSize - halo : width;
+            dstFile.ReleaseTiles(dstFile.GetTileIndex(y), dstFile.GetTileIndex(y + tileHeight - 1) + 1,
+                                 dstFile.GetTileIndex(x), dstFile.GetTileIndex(x + tileWidth - 1) + 1);
+            srcFile.ReleaseTiles(srcFile.GetTileIndex(regionY), srcFile.GetTileIndex(regionY + regionHeight - 1) + 1,
+                                 srcFile.GetTileIndex(regionX), srcFile.GetTileIndex(nextRegionX));
+        }
+    }
+
+    return true;
+}
+
+FiltrationResult TiledProcessor::Filter(const RawImageFile& srcFile, RawImageFile& dstFile,
+                                        ImageFilter::FilterType type, const int filterSize/* = -1*/) const
+{
+    int halo = 0;
+    switch (type)
+    {
+    case ImageFilter::FilterType::MEDIAN:
+    case ImageFilter::FilterType::GAUSSIAN:
+    case ImageFilter::FilterType::SEP_GAUSSIAN:
+        halo = filterSize / 2;
+        break;
+    case ImageFilter::FilterType::IIR_GAUSSIAN:
+    case ImageFilter::FilterType::BILATERAL:
+    case ImageFilter::FilterType::UNSHARP_MASK: // Separate Gaussian is used for small filter, the larger halo doesn't change it
+        halo = CalcIIRHalo(filterSize);
+        break;
+    case ImageFilter::FilterType::SHARPEN:
+        halo = 1;
+        break;
+    default:
+        return FiltrationResult::INCORRECT_FILTER_TYPE;
+    }
+
+    FiltrationResult ret = FiltrationResult::SUCCESS;
+    bool processed = Process(srcFile, dstFile, [&](const Image& srcImg, Image& dstImg)
+    {
+        ret = ImageFilter::Filter(srcImg, dstImg, type, filterSize);
+        return ret == FiltrationResult::SUCCESS;
+    }, std::max(halo, 0));
+
+    return (processed || ret != FiltrationResult::SUCCESS) ? ret : FiltrationResult::INTERNAL_ERROR;
+}
+
+bool TiledProcessor::AdaptiveThreshold(const RawImageFile& srcFile, RawImageFile& dstFile,
+                                       const int filterSize, const int threshold, ImageFilter::ThresholdType thresholdType) const
+{
+    return Process(srcFile, dstFile, [&](const Image& srcImg, Image& dstImg)
+    {
+        return ImageFilter::AdaptiveThreshold(srcImg, dstImg, filterSize, threshold, thresholdType);
+    }, std::max((filterSize >= 6) ? CalcIIRHalo(filterSize) : filterSize / 2, 0)); // The level is blurred by IIR-filter for large filter
+}
+
+bool TiledProcessor::AdaptiveThreshold(const RawImageFile& srcFile, RawImageFile& dstFile, const int filterSize, const float k,
+                                       ImageFilter::ThresholdMethod method, ImageFilter::ThresholdType thresholdType) const
+{
+    return Process(srcFile, dstFile, [&](const Image& srcImg, Image& dstImg)
+    {
+        return ImageFilter::AdaptiveThreshold(srcImg, dstImg, filterSize, k, method, thresholdType);
+    }, std::max(filterSize / 2, 0));
+}
+
+bool TiledProcessor::DetectBorders(const RawImageFile& srcFile, RawImageFile& dstFile, BordersDetector::DetectorType detectorType) const
+{
+    const bool isCanny = (detectorType == BordersDetector::DetectorType::CANNY || detectorType == BordersDetector::DetectorType::CANNY_BILATERAL);
+    const int halo = isCanny ? CANNY_HALO : 1;
+
+    return Process(srcFile, dstFile, [detectorType](const Image& srcImg, Image& dstImg)
+    {
+        return BordersDetector::DetectBorders(srcImg, dstImg, detectorType);
+    }, halo);
+}
+
+FiltrationResult TiledProcessor::Morphology(const RawImageFile& srcFile, RawImageFile& dstFile,
+                                            MorphologyFilter::MorphologyType type, const int seWidth, const int seHeight) const
+{
+    // Opening and closing are two operations, so their halo is doubled
+    const bool isComposite = (type == MorphologyFilter::MorphologyType::OPENING || type == MorphologyFilter::MorphologyType::CLOSING);
+    const int halo = std::max(seWidth, seHeight) / 2 * (isComposite ? 2 : 1);
+
+    FiltrationResult ret = FiltrationResult::SUCCESS;
+    bool processed = Process(srcFile, dstFile, [&](const Image& srcImg, Image& dstImg)
+    {
+        ret = MorphologyFilter::Filter(srcImg, dstImg, type, seWidth, seHeight);
+        return ret == FiltrationResult::SUCCESS;
+    }, std::max(halo, 0));
+
+    return (processed || ret != FiltrationResult::SUCCESS) ? ret : FiltrationResult::INTERNAL_ERROR;
+}
+
+bool TiledProcessor::CalcHistogram(const RawImageFile& srcFile, std::vector<size_t>& histogram) const
+{
+    Histogram tilesHistogram;
+
+    const int width = srcFile.GetWidth();
+    const int height = srcFile.GetHeight();
+    const int tileSize = CalcTileSize(srcFile, 0);
+
+    for (int y = 0; y < height; y += tileSize)
+    {
+        const int tileHeight = std::min(tileSize, height - y);
+        for (int x = 0; x < width; x += tileSize)
+        {
+            Image tileImg(tileHeight, std::min(tileSize, width - x));
+            if (!srcFile.ReadRegion(x, y, tileImg))
+                return false;
+
+            tilesHistogram.Add(tileImg);
+        }
+        srcFile.ReleaseTileRows(srcFile.GetTileIndex(y), srcFile.GetTileIndex(y + tileHeight - 1) + 1);
+    }
+
+    histogram.assign(tilesHistogram.GetBins().begin(), tilesHistogram.GetBins().end());
+    return true;
+}
+
+bool TiledProcessor::Correct(const RawImageFile& srcFile, RawImageFile& dstFile, ImageCorrector::CorrectorType corType) const
+{
+    if (!srcFile.IsOpened())
+        return false;
+
+    ImageCorrector::LookUpTable table;
+    std::vector<size_t> histogram;
+
+    switch (corType)
+    {
+    case ImageCorrector::CorrectorType::GAMMA:
+        ImageCorrector::FormGammaTable(table);
+        break;
+    case ImageCorrector::CorrectorType::AUTO_LEVELS:
+    {
+        if (!CalcHistogram(srcFile, histogram))
+            return false;
+
+        const auto isPresent = [](const size_t count) { return count > 0; };
+        const int minBr = static_cast<int>(std::find_if(histogram.begin(), histogram.end(), isPresent) - histogram.begin());
+        const int maxBr = Image::MAX_PIXEL_VALUE - static_cast<int>(std::find_if(histogram.rbegin(), histogram.rend(), isPresent) - histogram.rbegin());
+
+        ImageCorrector::FormExpandRangeTable(static_cast<Image::Byte>(minBr), static_cast<Image::Byte>(maxBr), table);
+        break;
+    }
+    case ImageCorrector::CorrectorType::NORM_AUTO_LEVELS:
+    {
+        if (!CalcHistogram(srcFile, histogram))
+            return false;
+
+        const double numPixels = static_cast<double>(srcFile.GetWidth()) * srcFile.GetHeight();
+        double aver = 0.0, sd = 0.0;
+        for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+            aver += static_cast<double>(i) * histogram[i];
+        aver /= numPixels;
+        for (int i = 0; i <= Image::MAX_PIXEL_VALUE; ++i)
+            sd += (i - aver) * (i - aver) * histogram[i];
+        sd = std::sqrt(sd / (numPixels - 1));
+
+        int left = aver - 3 * sd;
+        Image::CheckPixelValue(left);
+        int right = aver + 3 * sd;
+        Image::CheckPixelValue(right);
+
+        ImageCorrector::FormExpandRangeTable(static_cast<Image::Byte>(left), static_cast<Image::Byte>(right), table);
+        break;
+    }
+    case ImageCorrector::CorrectorType::GLOBAL_EQUALIZATION:
+    {
+        if (!CalcHistogram(srcFile, histogram))
+            return false;
+
+        ImageCorrector::FormEqualizationTable(histogram, table);
+        break;
+    }
+    default:
+        return false;
+    }
+
+    return Process(srcFile, dstFile, [&table](const Image& srcImg, Image& dstImg)
+    {
+        auto dstIt = dstImg.GetData().begin();
+        for (const Image::Byte pixel : srcImg.GetData())
+            *dstIt++ = table[pixel];
+        return true;
+    }, 0);
+}
+
+}
@@ -0,0 +1,87 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class to detect the borders of typed images
+
+#include <cmath>
+
+#include "TypedBordersDetector.h"
+
+namespace acv {
+
+template <typename T>
+bool TypedBordersDetector::DetectBorders(const TypedImage<T>& srcImg, TypedImage<T>& dstImg, BordersDetector::DetectorType detectorType)
+{
+    if (!srcImg.IsInitialized() || !srcImg.HasSameSizes(dstImg) || &srcImg == &dstImg)
+        return false;
+
+    switch (detectorType)
+    {
+    case BordersDetector::DetectorType::SOBEL:
+        CalcGradientModules(srcImg, dstImg, 1.0f, 2.0f);
+        return true;
+    case BordersDetector::DetectorType::SCHARR:
+        CalcGradientModules(srcImg, dstImg, 3.0f, 10.0f);
+        return true;
+    default:
+        return false;
+    }
+}
+
+template <typename T>
+void TypedBordersDetector::CalcGradientModules(const TypedImage<T>& srcImg, TypedImage<T>& dstImg, const float sideWeight, const float centerWeight)
+{
+    const int width = srcImg.GetWidth();
+    const int height = srcImg.GetHeight();
+
+    for (int row = 0; row < height; ++row)
+    {
+        // The rows and columns out of image are mirrored
+        const T* pPrev = srcImg.GetRawPointer(((row > 0) ? row - 1 : (height > 1 ? 1 : 0)) * width);
+        const T* pCur = srcImg.GetRawPointer(row * width);
+        const T* pNext = srcImg.GetRawPointer(((row < height - 1) ? row + 1 : (height > 1 ? height - 2 : 0)) * width);
+        T* pDst = dstImg.GetRawPointer(row * width);
+
+        for (int col = 0; col < width; ++col)
+        {
+            const int left = (col > 0) ? col - 1 : (width > 1 ? 1 : 0);
+            const int right = (col < width - 1) ? col + 1 : (width > 1 ? width - 2 : 0);
+
+            const float gx = sideWeight * (static_cast<float>(pPrev[right]) - pPrev[left]) +
+                             centerWeight * (static_cast<float>(pCur[right]) - pCur[left]) +
+                             sideWeight * (static_cast<float>(pNext[right]) - pNext[left]);
+            const float gy = sideWeight * (static_cast<float>(pNext[left]) - pPrev[left]) +
+                             centerWeight * (static_cast<float>(pNext[col]) - pPrev[col]) +
+                             sideWeight * (static_cast<float>(pNext[right]) - pPrev[right]);
+
+            pDst[col] = PixelTraits<T>::Saturate(std::sqrt(gx * gx + gy * gy));
+        }
+    }
+}
+
+template bool TypedBordersDetector::DetectBorders<Image::Byte>(const TypedImage<Image::Byte>&, TypedImage<Image::Byte>&, BordersDetector::DetectorType);
+template bool TypedBordersDetector::DetectBorders<unsigned short>(const TypedImage<unsigned short>&, TypedImage<unsigned short>&, BordersDetector::DetectorType);
+template bool TypedBordersDetector::DetectBorders<float>(const TypedImage<float>&, TypedImage<float>&, BordersDetector::DetectorType);
+
+}
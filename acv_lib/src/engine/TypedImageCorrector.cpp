@@ -0,0 +1,174 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class to correct of typed images
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "TypedImageCorrector.h"
+#include "TypedImageFilter.h"
+
+namespace acv {
+
+template <typename T>
+bool TypedImageCorrector::Correct(const TypedImage<T>& srcImg, TypedImage<T>& dstImg, ImageCorrector::CorrectorType corType)
+{
+    if (!srcImg.IsInitialized() || !srcImg.HasSameSizes(dstImg))
+        return false;
+
+    switch (corType)
+    {
+    case ImageCorrector::CorrectorType::SSRETINEX:
+        return SingleScaleRetinex(srcImg, dstImg);
+    case ImageCorrector::CorrectorType::AUTO_LEVELS:
+        return AutoLevels(srcImg, dstImg);
+    case ImageCorrector::CorrectorType::NORM_AUTO_LEVELS:
+        return NormAutoLevels(srcImg, dstImg);
+    case ImageCorrector::CorrectorType::GAMMA:
+        return GammaCorrection(srcImg, dstImg);
+    default:
+        return false;
+    }
+}
+
+template <typename T>
+bool TypedImageCorrector::SingleScaleRetinex(const TypedImage<T>& srcImg, TypedImage<T>& dstImg)
+{
+    const float SIGMA = 12.0f; // The same sigma as for 8-bit images
+    const float MAX_VALUE = PixelTraits<T>::MaxValue();
+
+    // Logarithm is calculated for brightness in 8-bit scale, so the result does not depend on type
+    const float toByteScale = Image::MAX_PIXEL_VALUE / MAX_VALUE;
+
+    const auto& src = srcImg.GetData();
+    std::vector<float> blurred(src.begin(), src.end());
+    TypedImageFilter::GaussianIIR(blurred, srcImg.GetWidth(), srcImg.GetHeight(), SIGMA);
+
+    const size_t size = src.size();
+    float retAvg = 0.0f;
+    for (size_t i = 0; i < size; ++i)
+    {
+        const float srcVal = src[i] * toByteScale, blurVal = blurred[i] * toByteScale;
+        blurred[i] = (srcVal <= 0.0f || blurVal <= 0.0f) ? 0.0f : (srcVal / blurVal) * std::log(srcVal);
+        retAvg += blurred[i];
+    }
+    retAvg /= size;
+
+    const float Pmin = 0.0f, Pmax = 2.5f * retAvg, DP = Pmax - Pmin;
+    if (DP <= 0.0f)
+        return false;
+
+    auto dstIt = dstImg.GetData().begin();
+    for (const float ret : blurred)
+        *dstIt++ = PixelTraits<T>::Saturate(std::min(std::max(MAX_VALUE * (ret - Pmin) / DP, 0.0f), MAX_VALUE));
+
+    return true;
+}
+
+template <typename T>
+void TypedImageCorrector::ExpandBrightnessRange(const TypedImage<T>& srcImg, const float minBr, const float maxBr, TypedImage<T>& dstImg)
+{
+    const float MAX_VALUE = PixelTraits<T>::MaxValue();
+
+    auto dstIt = dstImg.GetData().begin();
+    if (maxBr <= minBr) // Degenerate range (for example, image of one brightness)
+    {
+        for (const T val : srcImg.GetData())
+            *dstIt++ = PixelTraits<T>::Saturate((val > minBr) ? MAX_VALUE : 0.0f);
+        return;
+    }
+
+    const float coef = MAX_VALUE / (maxBr - minBr);
+    for (const T val : srcImg.GetData())
+        *dstIt++ = PixelTraits<T>::Saturate(std::min(std::max((val - minBr) * coef, 0.0f), MAX_VALUE));
+}
+
+template <typename T>
+bool TypedImageCorrector::AutoLevels(const TypedImage<T>& srcImg, TypedImage<T>& dstImg)
+{
+    const auto& src = srcImg.GetData();
+    const auto minMax = std::minmax_element(src.begin(), src.end());
+
+    ExpandBrightnessRange(srcImg, static_cast<float>(*minMax.first), static_cast<float>(*minMax.second), dstImg);
+
+    return true;
+}
+
+template <typename T>
+bool TypedImageCorrector::NormAutoLevels(const TypedImage<T>& srcImg, TypedImage<T>& dstImg)
+{
+    const auto& src = srcImg.GetData();
+    const float MAX_VALUE = PixelTraits<T>::MaxValue();
+
+    double sum = 0.0, sum2 = 0.0;
+    for (const T val : src)
+    {
+        sum += val;
+        sum2 += static_cast<double>(val) * val;
+    }
+
+    const double aver = sum / src.size();
+    const double sd = std::sqrt(std::max(sum2 / src.size() - aver * aver, 0.0));
+
+    const float left = std::max(static_cast<float>(aver - 3 * sd), 0.0f);
+    const float right = std::min(static_cast<float>(aver + 3 * sd), MAX_VALUE);
+
+    ExpandBrightnessRange(srcImg, left, right, dstImg);
+
+    return true;
+}
+
+template <typename T>
+bool TypedImageCorrector::GammaCorrection(const TypedImage<T>& srcImg, TypedImage<T>& dstImg)
+{
+    const float Y = 1.0f / 2.2f; // Gamma-correction factor
+    const float MAX_VALUE = PixelTraits<T>::MaxValue();
+
+    auto dstIt = dstImg.GetData().begin();
+    if (PixelTraits<T>::IS_INTEGER)
+    {
+        // Table of new values for all values of integer type
+        std::vector<T> table(static_cast<size_t>(MAX_VALUE) + 1);
+        for (size_t i = 0; i < table.size(); ++i)
+            table[i] = PixelTraits<T>::Saturate(MAX_VALUE * std::pow(i / MAX_VALUE, Y));
+
+        for (const T val : srcImg.GetData())
+            *dstIt++ = table[static_cast<size_t>(val)];
+    }
+    else
+    {
+        for (const T val : srcImg.GetData())
+            *dstIt++ = PixelTraits<T>::Saturate((val > 0) ? MAX_VALUE * std::pow(val / MAX_VALUE, Y) : 0.0f);
+    }
+
+    return true;
+}
+
+template bool TypedImageCorrector::Correct<Image::Byte>(const TypedImage<Image::Byte>&, TypedImage<Image::Byte>&, ImageCorrector::CorrectorType);
+template bool TypedImageCorrector::Correct<unsigned short>(const TypedImage<unsigned short>&, TypedImage<unsigned short>&, ImageCorrector::CorrectorType);
+template bool TypedImageCorrector::Correct<float>(const TypedImage<float>&, TypedImage<float>&, ImageCorrector::CorrectorType);
+
+}
@@ -0,0 +1,176 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class of typed images filtration
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "TypedImageFilter.h"
+
+namespace acv {
+
+// Mirror the coordinate if it is out of range [0, size)
+// (the result is clamped, so the images which are smaller than aperture of filter are processed too)
+static inline int MirrorCoordinate(const int coord, const int size)
+{
+    const int mirrored = (coord < 0) ? -coord : (coord >= size) ? 2 * size - 2 - coord : coord;
+    return std::max(0, std::min(mirrored, size - 1));
+}
+
+void TypedImageFilter::GaussianIIR(std::vector<float>& buf, const int width, const int height, const float sigma)
+{
+    ImageFilter::IIRfilter<float> filter(sigma);
+
+    for (int rowNum = 0; rowNum < height; ++rowNum) // Horizontal IIR-filter movement
+    {
+        float* ptr = &buf[rowNum * width];
+
+        filter.Reset();
+        for (int colNum = 0; colNum < width; ++colNum)
+            ptr[colNum] = filter.Solve(ptr[colNum]);
+
+        for (int colNum = width - 1; colNum >= 0; --colNum)
+            ptr[colNum] = filter.Solve(ptr[colNum]);
+    }
+
+    for (int colNum = 0; colNum < width; ++colNum) // Vertical IIR-filter movement
+    {
+        float* ptr = &buf[colNum];
+
+        filter.Reset();
+        for (int rowNum = 0; rowNum < height; ++rowNum)
+            ptr[rowNum * width] = filter.Solve(ptr[rowNum * width]);
+
+        for (int rowNum = height - 1; rowNum >= 0; --rowNum)
+            ptr[rowNum * width] = filter.Solve(ptr[rowNum * width]);
+    }
+}
+
+template <typename T>
+FiltrationResult TypedImageFilter::GaussianIIR(TypedImage<T>& img, const float sigma)
+{
+    return GaussianIIR(img, img, sigma);
+}
+
+template <typename T>
+FiltrationResult TypedImageFilter::GaussianIIR(const TypedImage<T>& srcImg, TypedImage<T>& dstImg, const float sigma)
+{
+    if (sigma < 1.0f)
+        return FiltrationResult::SMALL_FILTER_SIZE;
+    if (!srcImg.IsInitialized() || !srcImg.HasSameSizes(dstImg))
+        return FiltrationResult::INTERNAL_ERROR;
+
+    std::vector<float> buf(srcImg.GetData().begin(), srcImg.GetData().end());
+    GaussianIIR(buf, srcImg.GetWidth(), srcImg.GetHeight(), sigma);
+
+    auto dstIt = dstImg.GetData().begin();
+    for (const float val : buf)
+        *dstIt++ = PixelTraits<T>::Saturate(val);
+
+    return FiltrationResult::SUCCESS;
+}
+
+template <typename T>
+FiltrationResult TypedImageFilter::SeparateGaussian(const TypedImage<T>& srcImg, TypedImage<T>& dstImg, const int filterSize)
+{
+    if (filterSize <= 0 || filterSize % 2 == 0) // The filter size should be positive and odd
+        return FiltrationResult::INCORRECT_FILTER_SIZE;
+    if (!srcImg.IsInitialized() || !srcImg.HasSameSizes(dstImg))
+        return FiltrationResult::INTERNAL_ERROR;
+
+    const int width = srcImg.GetWidth();
+    const int height = srcImg.GetHeight();
+
+    // Creation of the normalized Gaussian 1D filter (sigma is the same as for 8-bit images)
+    const float SIGMA = (filterSize / 2.0 - 1.0) * 0.3 + 0.8, SIGMA2 = SIGMA * SIGMA;
+    const int APERTURE = filterSize / 2;
+    std::vector<float> filter(filterSize);
+
+    float sum = 0.0f;
+    for (int i = -APERTURE; i <= APERTURE; ++i)
+    {
+        filter[i + APERTURE] = std::exp(-(i * i) / (2.0f * SIGMA2));
+        sum += filter[i + APERTURE];
+    }
+    for (float& val : filter)
+        val /= sum;
+
+    std::vector<float> tmp(width * height);
+
+    const T* ptrSrc = srcImg.GetRawPointer();
+    for (int rowNum = 0; rowNum < height; ++rowNum, ptrSrc += width) // Horizontal filter movement
+    {
+        float* ptrTmp = &tmp[rowNum * width];
+        for (int colNum = 0; colNum < width; ++colNum)
+        {
+            float acc = 0.0f;
+            if (colNum >= APERTURE && colNum < width - APERTURE)
+            {
+                for (int i = -APERTURE; i <= APERTURE; ++i)
+                    acc += ptrSrc[colNum + i] * filter[i + APERTURE];
+            }
+            else
+            {
+                for (int i = -APERTURE; i <= APERTURE; ++i)
+                    acc += ptrSrc[MirrorCoordinate(colNum + i, width)] * filter[i + APERTURE];
+            }
+            ptrTmp[colNum] = acc;
+        }
+    }
+
+    std::vector<float> acc(width);
+    for (int rowNum = 0; rowNum < height; ++rowNum) // Vertical filter movement (row by row for sequential memory access)
+    {
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        for (int i = -APERTURE; i <= APERTURE; ++i)
+        {
+            const float* ptrTmp = &tmp[MirrorCoordinate(rowNum + i, height) * width];
+            const float weight = filter[i + APERTURE];
+            for (int colNum = 0; colNum < width; ++colNum)
+                acc[colNum] += ptrTmp[colNum] * weight;
+        }
+
+        T* ptrDst = dstImg.GetRawPointer(rowNum * width);
+        for (int colNum = 0; colNum < width; ++colNum)
+            ptrDst[colNum] = PixelTraits<T>::Saturate(acc[colNum]);
+    }
+
+    return FiltrationResult::SUCCESS;
+}
+
+template FiltrationResult TypedImageFilter::GaussianIIR<Image::Byte>(TypedImage<Image::Byte>&, const float);
+template FiltrationResult TypedImageFilter::GaussianIIR<unsigned short>(TypedImage<unsigned short>&, const float);
+template FiltrationResult TypedImageFilter::GaussianIIR<float>(TypedImage<float>&, const float);
+
+template FiltrationResult TypedImageFilter::GaussianIIR<Image::Byte>(const TypedImage<Image::Byte>&, TypedImage<Image::Byte>&, const float);
+template FiltrationResult TypedImageFilter::GaussianIIR<unsigned short>(const TypedImage<unsigned short>&, TypedImage<unsigned short>&, const float);
+template FiltrationResult TypedImageFilter::GaussianIIR<float>(const TypedImage<float>&, TypedImage<float>&, const float);
+
+template FiltrationResult TypedImageFilter::SeparateGaussian<Image::Byte>(const TypedImage<Image::Byte>&, TypedImage<Image::Byte>&, const int);
+template FiltrationResult TypedImageFilter::SeparateGaussian<unsigned short>(const TypedImage<unsigned short>&, TypedImage<unsigned short>&, const int);
+template FiltrationResult TypedImageFilter::SeparateGaussian<float>(const TypedImage<float>&, TypedImage<float>&, const int);
+
+}
@@ -0,0 +1,156 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class of background model of the sequence of frames
+
+#ifndef BACKGROUND_MODEL_H
+#define BACKGROUND_MODEL_H
+
+#include <vector>
+
+#include "Image.h"
+
+namespace acv {
+
+class BinaryImage;
+
+// Class of background model which is updated by each new frame of video stream
+// The model is used to separate the moving objects (foreground) from the static scene (background).
+// The memory of model is allocated once at configuration and doesn't depend on the number of frames
+// (history of frames is not stored), the pixels are updated in parallel and by SIMD instructions
+class BackgroundModel
+{
+
+public: // Public auxiliary types
+
+    // Types of background model
+    enum class ModelType
+    {
+        RUNNING_AVERAGE, // Exponential running average of frames
+        GAUSSIAN, // Running mean and variance of each pixel (threshold is specified in standard deviations)
+        MEDIAN // Approximate running median (background pixel is moved to frame pixel by one level per frame)
+    };
+
+public: // Constants
+
+    enum
+    {
+        DEFAULT_DIFF_THRESHOLD = 25, // Default threshold of difference for running average and median models
+        DEFAULT_SIGMA_THRESHOLD_X10 = 25, // Default threshold of Gaussian model in tenths of standard deviation
+        INITIAL_STD_DEVIATION = 15, // Standard deviation of Gaussian model after the first frame
+        MIN_STD_DEVIATION = 4 // Minimum standard deviation of Gaussian model (it suppresses the noise of static scene)
+    };
+
+public: // Public methods
+
+    // Default constructor of not configured model
+    BackgroundModel();
+
+    // Configure the model for frames of specified sizes
+    // Learning rate is the weight of new frame (0 < learningRate <= 0.5), it is not used by median model.
+    // Threshold is the difference of frame and background (in brightness levels or in standard deviations for
+    // Gaussian model) which is exceeded by the pixels of foreground. Negative threshold means the default threshold
+    bool Configure(const int height, const int width, ModelType type, const float learningRate = 0.05f, const float threshold = -1.0f);
+
+    // Check that the model was successfully configured
+    bool IsConfigured() const { return mIsConfigured; }
+
+    // Add the frame to model and calculate the mask of foreground (foreground pixels are MAX_PIXEL_VALUE)
+    // The first frame initializes the model, so its mask is empty
+    // Sizes of frame and mask should be equal to configured sizes
+    bool Apply(const Image& frame, Image& foregroundMask);
+
+    // Add the frame to model and calculate the binary mask of foreground (foreground pixels are set)
+    bool Apply(const Image& frame, BinaryImage& foregroundMask);
+
+    // Get the current background (sizes of image should be equal to configured sizes)
+    bool GetBackground(Image& backgroundImg) const;
+
+    // Forget all frames (the next frame will initialize the model)
+    void Reset() { mNumFrames = 0; }
+
+    // Get the number of frames which were added after configuration or reset
+    int GetNumFrames() const { return mNumFrames; }
+
+private: // Private methods
+
+    // Initialize the model by the first frame
+    void Initialize(const Image& frame);
+
+    // Update the models of pixels [begin, end) and form their mask (pMask points to the mask of pixel begin)
+    void Update(const Image::Byte* pFrame, Image::Byte* pMask, const int begin, const int end);
+    void UpdateRunningAverage(const Image::Byte* pFrame, Image::Byte* pMask, const int begin, const int end);
+    void UpdateGaussian(const Image::Byte* pFrame, Image::Byte* pMask, const int begin, const int end);
+    void UpdateMedian(const Image::Byte* pFrame, Image::Byte* pMask, const int begin, const int end);
+
+private: // Private constants
+
+    enum
+    {
+        AVERAGE_FRACTION_BITS = 7, // Number of fraction bits of running average (values fit into short)
+        MIN_PIXELS_PER_TASK = 64 * 1024 // Minimum number of pixels processed by one parallel task
+    };
+
+private: // Private members
+
+    // Flag of successful configuration
+    bool mIsConfigured;
+
+    // Sizes of frames
+    int mHeight;
+    int mWidth;
+
+    // Type of model
+    ModelType mType;
+
+    // Weight of new frame in fixed point format (fraction of 65536) for running average model
+    short mRateFixed;
+
+    // Weight of new frame for Gaussian model
+    float mRate;
+
+    // Threshold of difference for running average and median models
+    Image::Byte mDiffThreshold;
+
+    // Square of threshold in standard deviations for Gaussian model
+    float mSigmaThreshold2;
+
+    // Number of added frames
+    int mNumFrames;
+
+    // Running average in fixed point format (brightness << AVERAGE_FRACTION_BITS)
+    std::vector<short> mAverage;
+
+    // Running mean and variance of Gaussian model
+    std::vector<float> mMean;
+    std::vector<float> mVariance;
+
+    // Running median
+    Image mMedian;
+
+};
+
+}
+
+#endif // BACKGROUND_MODEL_H
@@ -0,0 +1,168 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class of binary image which keeps one bit per pixel
+
+#ifndef BINARY_IMAGE_H
+#define BINARY_IMAGE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Image.h"
+
+namespace acv {
+
+// Class of binary image (mask). Each pixel is represented by one bit.
+// The pixels of row are packed to 64-bit words (pixel colNum is the bit colNum % 64 of word colNum / 64,
+// the least significant bit is the first), each row starts from the new word and the unused bits of the last word
+// of row are always cleared. So the logical operations, area and morphology process 64 pixels by one instruction
+class BinaryImage
+{
+
+public: // Constants
+
+    enum
+    {
+        BITS_PER_WORD = 64 // Number of pixels in one word
+    };
+
+public: // Auxiliary types
+
+    typedef uint64_t Word; // This type is used to representation of packed pixels
+
+    typedef std::vector<Word> Matrix; // This type is used to representation of words matrix
+
+    // Run of set pixels on the row
+    struct Run
+    {
+        int startX; // The first column of run
+        int finishX; // The last column of run
+    };
+
+public: // Constructors
+
+    // Default constructor
+    BinaryImage();
+
+    // Constructor of image with specified dimensions (all pixels are cleared)
+    BinaryImage(const int height, const int width);
+
+    // Constructor from one-channel image (the pixels which are not Image::MIN_PIXEL_VALUE are set)
+    explicit BinaryImage(const Image& img);
+
+public: // Public methods
+
+    // Get the width of image
+    int GetWidth() const { return mWidth; }
+
+    // Get the height of image
+    int GetHeight() const { return mHeight; }
+
+    // Get the number of words of each row
+    int GetWordsPerRow() const { return mWordsPerRow; }
+
+    // Check the initialization of image
+    // Image is not initialized if was created by default constructor
+    bool IsInitialized() const { return mWidth > 0 && mHeight > 0; }
+
+    // Get the pixel value by coordinates
+    bool GetPixel(const int rowNum, const int colNum) const
+    {
+        return ((mWords[static_cast<size_t>(mWordsPerRow) * rowNum + colNum / BITS_PER_WORD] >> (colNum % BITS_PER_WORD)) & 1) != 0;
+    }
+
+    // Set the pixel value by coordinates
+    void SetPixel(const int rowNum, const int colNum, const bool val)
+    {
+        Word& word = mWords[static_cast<size_t>(mWordsPerRow) * rowNum + colNum / BITS_PER_WORD];
+        const Word bit = Word(1) << (colNum % BITS_PER_WORD);
+        word = val ? (word | bit) : (word & ~bit);
+    }
+
+    // Get the raw pointer to the first word of row
+    Word* GetRow(const int rowNum) { return &mWords[static_cast<size_t>(mWordsPerRow) * rowNum]; }
+    const Word* GetRow(const int rowNum) const { return &mWords[static_cast<size_t>(mWordsPerRow) * rowNum]; }
+
+    // Get the reference to the words vector
+    // The unused bits of the last word of each row should stay cleared
+    Matrix& GetData() { return mWords; }
+    const Matrix& GetData() const { return mWords; }
+
+    // Get the mask of used bits of the last word of row
+    Word GetLastWordMask() const;
+
+    // Clear all pixels
+    void Clear();
+
+    // Pack the row of bytes to the row of image (the bytes which are not Image::MIN_PIXEL_VALUE are set)
+    void PackRow(const int rowNum, const Image::Byte* pSrc);
+
+    // Unpack the row of image to the row of bytes (set pixels are setVal, cleared pixels are clearVal)
+    void UnpackRow(const int rowNum, Image::Byte* pDst,
+                   const Image::Byte setVal = Image::MAX_PIXEL_VALUE, const Image::Byte clearVal = Image::MIN_PIXEL_VALUE) const;
+
+    // Convert to one-channel image of the same sizes (set pixels are Image::MAX_PIXEL_VALUE)
+    bool ConvertToImage(Image& img) const;
+
+    // Count the set pixels (area of mask)
+    size_t CountPixels() const;
+
+    // Find the runs of set pixels on the row (previous content of vector is removed)
+    void FindRuns(const int rowNum, std::vector<Run>& runs) const;
+
+    // Logical operations of pixels, all images should have the same sizes (destination image can be one of source images)
+    static bool And(const BinaryImage& lhs, const BinaryImage& rhs, BinaryImage& dstImg);
+    static bool Or(const BinaryImage& lhs, const BinaryImage& rhs, BinaryImage& dstImg);
+    static bool Xor(const BinaryImage& lhs, const BinaryImage& rhs, BinaryImage& dstImg);
+
+    // Logical negation of pixels (images should have the same sizes and can be the same image)
+    static bool Invert(const BinaryImage& srcImg, BinaryImage& dstImg);
+
+    // Equality operator
+    bool operator == (const BinaryImage& rhs) const;
+
+    // Inequality operator
+    bool operator != (const BinaryImage& rhs) const;
+
+private: // Private members
+
+    // Matrix of words
+    Matrix mWords;
+
+    // Image width
+    int mWidth;
+
+    // Image height
+    int mHeight;
+
+    // Number of words of each row
+    int mWordsPerRow;
+
+};
+
+}
+
+#endif // BINARY_IMAGE_H
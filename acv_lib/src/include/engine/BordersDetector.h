@@ -29,10 +29,14 @@
 
 #include "Image.h"
 #include "Point.h"
-#include <list>
+#include <vector>
 
 namespace acv {
 
+class BinaryImage;
+template<typename T> class MatrixFilter;
+class Progress;
+
 // This class is used to detect the borders of image by several methods
 // The class contains only static methods
 class BordersDetector
@@ -40,6 +44,9 @@ class BordersDetector
 
     struct Gradient;
 
+    // Processor of frames reuses the operators and tables of detectors
+    friend class BordersProcessor;
+
 public: // Public auxiliary types
 
     // Types of border detectors
@@ -47,7 +54,8 @@ public: // Public auxiliary types
     {
         SOBEL, // Sobel detector
         SCHARR, // Scharr detector
-        CANNY // Canny detector
+        CANNY, // Canny detector
+        CANNY_BILATERAL // Canny detector with edge-preserving bilateral blur instead of Gaussian blur
     };
 
     // Types of border detection operators
@@ -57,21 +65,33 @@ public: // Public auxiliary types
         HORIZONTAL // Horizontal operator
     };
 
-private: // Constants
+public: // Public constants
 
     enum
     {
         DEFAULT_MIN_THRESHOLD = 20, // Default minimum threshold for Canny algorithm
-        DEFAULT_MAX_THRESHOLD = 90 // Default maximum threshold for Canny algorithm
+        DEFAULT_MAX_THRESHOLD = 90, // Default maximum threshold for Canny algorithm
+        CANNY_BILATERAL_SPATIAL_SIGMA = 2, // Spatial sigma of bilateral blur of Canny algorithm
+        CANNY_BILATERAL_RANGE_SIGMA = 20 // Range sigma of bilateral blur of Canny algorithm
     };
 
 public: // Public methods
 
     // Detect the borders of image
+    // Progress (if it is specified) is advanced by stages of detector (the passes over image),
+    // the cancelled detection returns false
     static bool DetectBorders(Image& img, DetectorType detectorType,
-                              const Image::Byte thresholdMin = DEFAULT_MIN_THRESHOLD, const Image::Byte thresholdMax = DEFAULT_MAX_THRESHOLD);
+                              const Image::Byte thresholdMin = DEFAULT_MIN_THRESHOLD, const Image::Byte thresholdMax = DEFAULT_MAX_THRESHOLD,
+                              Progress* progress = nullptr);
     static bool DetectBorders(const Image& srcImg, Image& dstImg, DetectorType detectorType,
-                              const Image::Byte thresholdMin = DEFAULT_MIN_THRESHOLD, const Image::Byte thresholdMax = DEFAULT_MAX_THRESHOLD);
+                              const Image::Byte thresholdMin = DEFAULT_MIN_THRESHOLD, const Image::Byte thresholdMax = DEFAULT_MAX_THRESHOLD,
+                              Progress* progress = nullptr);
+
+    // Detect the borders of image to binary map (only Canny detectors form the binary map of borders)
+    // The sizes of images should be equal
+    static bool DetectBorders(const Image& srcImg, BinaryImage& dstImg, DetectorType detectorType,
+                              const Image::Byte thresholdMin = DEFAULT_MIN_THRESHOLD, const Image::Byte thresholdMax = DEFAULT_MAX_THRESHOLD,
+                              Progress* progress = nullptr);
 
     // Convolution of image with specified operator
     static bool OperatorConvolution(Image& img, DetectorType detectorType, OperatorType operatorType);
@@ -79,17 +99,21 @@ public: // Public methods
 
 private: // Private methods
 
-    // Detect borders by using the Canny algorithm
-    static bool Canny(Image& img, const Image::Byte thresholdMin, const Image::Byte thresholdMax);
-    static bool Canny(const Image& srcImg, Image& dstImg, const Image::Byte thresholdMin, const Image::Byte thresholdMax);
+    // Detect borders by using the Canny algorithm (with Gaussian or bilateral blur)
+    static bool Canny(Image& img, const Image::Byte thresholdMin, const Image::Byte thresholdMax, const bool bilateralBlur,
+                      Progress* progress);
+    static bool Canny(const Image& srcImg, Image& dstImg, const Image::Byte thresholdMin, const Image::Byte thresholdMax,
+                      const bool bilateralBlur, Progress* progress);
+    static bool Canny(const Image& srcImg, BinaryImage& dstImg, const Image::Byte thresholdMin, const Image::Byte thresholdMax,
+                      const bool bilateralBlur, Progress* progress);
 
     // Detect the borders by using Sobel algorithm
-    static bool Sobel(Image& img);
-    static bool Sobel(const Image& srcImg, Image& dstImg);
+    static bool Sobel(Image& img, Progress* progress);
+    static bool Sobel(const Image& srcImg, Image& dstImg, Progress* progress);
 
     // Detect the borders by using Scharr algorithm
-    static bool Scharr(Image& img);
-    static bool Scharr(const Image& srcImg, Image& dstImg);
+    static bool Scharr(Image& img, Progress* progress);
+    static bool Scharr(const Image& srcImg, Image& dstImg, Progress* progress);
 
     // Non-convolutional of image with Sobel operator
     static bool NonConvSobel(Image& img, OperatorType type);
@@ -107,18 +131,47 @@ private: // Private methods
     static bool ConvScharr(Image& img, OperatorType type);
     static bool ConvScharr(const Image& srcImg, Image& dstImg, OperatorType type);
 
+    // Form the kernel of Scharr operator
+    static bool FormScharrFilter(OperatorType type, MatrixFilter<int>& filter);
+
     // Calculate the modules of two image to third image
     static void FormGradientModules(const Image& horizImg, const Image& vertImg, Image& modImg);
 
+    // Get the table of gradient modules for all pairs of operator values (the table is calculated once)
+    static const std::vector<Image::Byte>& GetGradientModulesTable();
+
 private: // Private methods for Canny algorithm
 
+    // All stages of Canny algorithm except the writing of result (the image is blurred in place)
+    static bool CannyGradients(Image& img, const Image::Byte thresholdMin, const Image::Byte thresholdMax, const bool bilateralBlur,
+                               std::vector<std::vector<Gradient>>& gradients, Progress* progress);
+
+    // Form the kernel of Gaussian blur which is run before the calculation of gradients
+    static void FormCannyBlurFilter(MatrixFilter<int>& filter);
+
+    // Calculate the gradients from results of horizontal and vertical operators
+    static void FormGradients(const Image& horizImg, const Image& vertImg, std::vector<std::vector<Gradient>>& gradients);
+
+    // Get the table of gradients for all pairs of operator values (the table is calculated once)
+    static const std::vector<Gradient>& GetGradientsTable();
+
     // An edge thinning technique by using maximum suppression
     static bool MaximumSuppression(std::vector<std::vector<Gradient>>& gradients);
 
+    // Double threshold and tracing of ambiguity areas (pixelGroup is used as buffer of traced pixels)
+    static void HysteresisThreshold(std::vector<std::vector<Gradient>>& gradients, const Image::Byte thresholdMin,
+                                    const Image::Byte thresholdMax, std::vector<Point>& pixelGroup);
+
     // An auxiliary method to tracing the ambiguity area
     static void AmbiguityTrace(const int row, const int col, const int height, const int width,
                                std::vector<std::vector<BordersDetector::Gradient>>& gradients,
-                               std::list<Point>& pixelGroup, int& closer);
+                               std::vector<Point>& pixelGroup, int& closer);
+
+    // Write the modules of gradients to image
+    static void WriteGradients(const std::vector<std::vector<Gradient>>& gradients, Image& img);
+
+    // Write the borders to binary map (the pixels with non-zero modules of gradients are set)
+    static void WriteGradients(const std::vector<std::vector<Gradient>>& gradients, BinaryImage& img);
 
 private: // Private types
 
@@ -0,0 +1,133 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class to detect the borders of the sequence of frames of the same size
+
+#ifndef BORDERS_PROCESSOR_H
+#define BORDERS_PROCESSOR_H
+
+#include <vector>
+
+#include "Image.h"
+#include "Point.h"
+#include "BordersDetector.h"
+#include "ImageFilter.h"
+#include "MatrixFilter.h"
+
+namespace acv {
+
+// Class of stateful detector of borders of the sequence of frames (video stream)
+// The processor is configured once for the sizes of frames and the detector: the kernels of operators
+// and the auxiliary images are prepared at configuration, so the processing of frame doesn't allocate memory.
+// Results are the same as the results of BordersDetector::DetectBorders.
+// The processor is not thread-safe: each thread should use its own processor
+class BordersProcessor
+{
+
+public: // Public methods
+
+    // Default constructor of not configured processor
+    BordersProcessor();
+
+    // Configure the processor for frames of specified sizes and for specified detector
+    // Thresholds are used only by Canny detector
+    bool Configure(const int height, const int width, BordersDetector::DetectorType detectorType,
+                   const Image::Byte thresholdMin = BordersDetector::DEFAULT_MIN_THRESHOLD,
+                   const Image::Byte thresholdMax = BordersDetector::DEFAULT_MAX_THRESHOLD);
+
+    // Check that the processor was successfully configured
+    bool IsConfigured() const { return mIsConfigured; }
+
+    // Get the height of frames
+    int GetHeight() const { return mHeight; }
+
+    // Get the width of frames
+    int GetWidth() const { return mWidth; }
+
+    // Detect the borders of frame (sizes of images should be equal to configured sizes, source and destination can be the same image)
+    bool Process(const Image& srcImg, Image& dstImg);
+
+    // Detect the borders of frame in place
+    bool Process(Image& img);
+
+private: // Private methods
+
+    // Check that the image has the configured sizes
+    bool HasFrameSizes(const Image& img) const;
+
+    // Detect the borders by using Canny algorithm (with Gaussian or bilateral blur)
+    void Canny(const Image& srcImg, Image& dstImg);
+
+private: // Private constants
+
+    enum
+    {
+        MIN_FRAME_SIZE = 3, // Minimum sizes of frame which are supported by operators
+        CANNY_BLUR_SIZE = 5 // Size of Gaussian blur of Canny algorithm
+    };
+
+private: // Private members
+
+    // Flag of successful configuration
+    bool mIsConfigured;
+
+    // Sizes of frames
+    int mHeight;
+    int mWidth;
+
+    // Type of detector
+    BordersDetector::DetectorType mDetectorType;
+
+    // Thresholds of Canny algorithm
+    Image::Byte mThresholdMin;
+    Image::Byte mThresholdMax;
+
+    // Kernels of horizontal and vertical Scharr operators or kernel of Canny blur
+    MatrixFilter<int> mHorizFilter;
+    MatrixFilter<int> mVertFilter;
+
+    // Source frame expanded by aperture of kernels
+    Image mExpandedImg;
+
+    // Blurred frame of Canny algorithm
+    Image mBlurredImg;
+
+    // Buffers of levels of bilateral blur of Canny algorithm
+    ImageFilter::BilateralBuffers mBilateralBuffers;
+
+    // Results of horizontal and vertical operators
+    Image mHorizImg;
+    Image mVertImg;
+
+    // Gradients of Canny algorithm
+    std::vector<std::vector<BordersDetector::Gradient>> mGradients;
+
+    // Buffer of traced pixels of Canny algorithm
+    std::vector<Point> mPixelGroup;
+
+};
+
+}
+
+#endif // BORDERS_PROCESSOR_H
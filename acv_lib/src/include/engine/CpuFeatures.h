@@ -0,0 +1,73 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class of detection of instruction sets of processor
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+namespace acv {
+
+// Class of runtime detection of instruction sets which are used by the vectorized kernels
+// The instruction sets are detected once by cpuid (with check of their support by operating system),
+// so one binary uses the best instruction set of each machine.
+// The used instruction set can be limited to verify the vectorized kernels against the scalar ones,
+// the initial limit is read from environment variable ACV_CPU_ISA (scalar, sse2, avx2 or avx512)
+// Contains only static methods
+class CpuFeatures
+{
+
+public: // Public auxiliary types
+
+    // Instruction sets in order of increasing of capabilities
+    enum class InstructionSet
+    {
+        SCALAR, // Scalar reference code
+        SSE2, // SSE2 (baseline of x86-64)
+        AVX2, // AVX2 (Haswell, Zen and later)
+        AVX512 // AVX-512 F and BW (Skylake-SP, Zen 4 and later)
+    };
+
+public: // Public methods
+
+    // Get the best instruction set which is supported by processor and by compiler of library
+    static InstructionSet GetBestInstructionSet();
+
+    // Get the instruction set which is used by kernels (the best one within the limit)
+    static InstructionSet GetInstructionSet();
+
+    // Limit the instruction set which is used by kernels (it can be called from any thread)
+    static void SetInstructionSetLimit(const InstructionSet limit);
+
+    // Check that the processor supports AVX-512 VBMI (byte permutes which are used by look-up tables)
+    static bool HasAVX512VBMI();
+
+    // Get the name of instruction set
+    static const char* GetInstructionSetName(const InstructionSet set);
+
+};
+
+}
+
+#endif // CPU_FEATURES_H
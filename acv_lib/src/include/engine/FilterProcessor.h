@@ -0,0 +1,124 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class to filter the sequence of frames of the same size
+
+#ifndef FILTER_PROCESSOR_H
+#define FILTER_PROCESSOR_H
+
+#include <vector>
+
+#include "Image.h"
+#include "ImageFilter.h"
+#include "MatrixFilter.h"
+
+namespace acv {
+
+// Class of stateful filter of the sequence of frames (video stream)
+// The processor is configured once for the sizes of frames and the filter: the kernels, the ratios of IIR-filter
+// and the auxiliary buffers are prepared at configuration, so the processing of frame doesn't allocate memory.
+// Results are the same as the results of ImageFilter::Filter.
+// The processor is not thread-safe: each thread should use its own processor
+class FilterProcessor
+{
+
+public: // Public methods
+
+    // Default constructor of not configured processor
+    FilterProcessor();
+
+    // Configure the processor for frames of specified sizes and for specified filter
+    FiltrationResult Configure(const int height, const int width, ImageFilter::FilterType type, const int filterSize = -1);
+
+    // Check that the processor was successfully configured
+    bool IsConfigured() const { return mIsConfigured; }
+
+    // Get the height of frames
+    int GetHeight() const { return mHeight; }
+
+    // Get the width of frames
+    int GetWidth() const { return mWidth; }
+
+    // Filter the frame (sizes of images should be equal to configured sizes, source and destination can be the same image)
+    FiltrationResult Process(const Image& srcImg, Image& dstImg);
+
+    // Filter the frame in place
+    FiltrationResult Process(Image& img);
+
+private: // Private methods
+
+    // Check that the image has the configured sizes
+    bool HasFrameSizes(const Image& img) const;
+
+    // Median filtration of expanded frame by using the sliding histogram of window
+    void Median(Image& dstImg);
+
+private: // Private members
+
+    // Flag of successful configuration
+    bool mIsConfigured;
+
+    // Sizes of frames
+    int mHeight;
+    int mWidth;
+
+    // Type of filter
+    ImageFilter::FilterType mType;
+
+    // Size of filter
+    int mFilterSize;
+
+    // Number of pixels by which the frame is expanded at each side
+    int mAperture;
+
+    // Kernel of Gaussian or sharpen filter
+    MatrixFilter<int> mMatrixFilter;
+
+    // Kernel of separate Gaussian filter and its divider
+    std::vector<int> mSeparateFilter;
+    int mSeparateDivider;
+
+    // IIR-filter with calculated ratios
+    ImageFilter::IIRfilter<float> mIIRFilter;
+
+    // Source frame expanded by aperture of filter
+    Image mExpandedImg;
+
+    // Intermediate frame of separate filter
+    Image mTmpImg;
+
+    // Buffers of levels of bilateral filter
+    ImageFilter::BilateralBuffers mBilateralBuffers;
+
+    // Buffers of blur of unsharp masking
+    ImageFilter::UnsharpMaskBuffers mUnsharpMaskBuffers;
+
+    // Histogram of window of median filter
+    int mHistogram[Image::MAX_PIXEL_VALUE + 1];
+
+};
+
+}
+
+#endif // FILTER_PROCESSOR_H
@@ -0,0 +1,144 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class of brightness histogram of image
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <array>
+#include <cstddef>
+
+#include "Image.h"
+
+namespace acv {
+
+// Class of brightness histogram of image (one bin per brightness value)
+// The pixels are counted into several interleaved banks of 32-bit counters, so neighbour pixels
+// with the same brightness don't wait for each other. Stripes of large images are counted in parallel
+class Histogram
+{
+
+public: // Public constants
+
+    enum
+    {
+        NUM_BINS = Image::MAX_PIXEL_VALUE + 1, // Number of bins of histogram
+        NUM_BANKS = 4 // Number of interleaved banks of counters which are used during counting
+    };
+
+public: // Public auxiliary types
+
+    // Array of bins of histogram
+    typedef std::array<size_t, NUM_BINS> Bins;
+
+    // Rectangular region of interest (boundaries are included)
+    struct Roi
+    {
+        int xStart, yStart, xEnd, yEnd;
+    };
+
+public: // Constructors
+
+    // Default constructor (histogram is empty)
+    Histogram();
+
+    // Constructor with an image to count all his pixels
+    explicit Histogram(const Image& img);
+
+    // Copy-constructor
+    Histogram(const Histogram&) = default;
+
+    // Move-constructor
+    Histogram(Histogram&&) = default;
+
+    // Destructor
+    ~Histogram() = default;
+
+public: // Operators
+
+    // Assignment operator
+    Histogram& operator = (const Histogram&) = default;
+
+    // Move assignment operator
+    Histogram& operator = (Histogram&&) = default;
+
+    // Add the counts of other histogram
+    Histogram& operator += (const Histogram& other);
+
+    // Get the number of pixels with brightness value
+    size_t operator [] (const Image::Byte value) const { return mBins[value]; }
+
+public: // Public methods
+
+    // Add all pixels of image
+    bool Add(const Image& img);
+
+    // Add the pixels of region of interest of image
+    // The user should provide: 0 <= xStart <= xEnd < width, 0 <= yStart <= yEnd < height
+    bool Add(const Image& img, const Roi& roi);
+
+    // Add the pixels of image for which the pixel of mask is not zero (mask should have the same size as image)
+    bool Add(const Image& img, const Image& mask);
+
+    // Add the pixels of region of interest of image for which the pixel of mask is not zero
+    bool Add(const Image& img, const Roi& roi, const Image& mask);
+
+    // Reset all bins to zero
+    void Clear();
+
+    // Get the bins of histogram
+    const Bins& GetBins() const { return mBins; }
+
+    // Get the number of counted pixels
+    size_t GetTotal() const { return mTotal; }
+
+    // Get the number of brightness values which are present in histogram (number of information levels)
+    size_t GetNumLevels() const;
+
+    // Get the minimum and maximum brightness values which are present in histogram
+    // Returns false if the histogram is empty
+    bool GetMinMax(Image::Byte& minBrig, Image::Byte& maxBrig) const;
+
+private: // Private methods
+
+    // Check that the region of interest is located inside of image
+    static bool IsValidRoi(const Image& img, const Roi& roi);
+
+    // Count the pixels of region of interest (with mask if it is not null)
+    void AddRegion(const Image& img, const Roi& roi, const Image* mask);
+
+private: // Private members
+
+    // Bins of histogram
+    Bins mBins;
+
+    // Number of counted pixels
+    size_t mTotal;
+
+};
+
+}
+
+#endif // HISTOGRAM_H
@@ -37,60 +37,30 @@ class Image;
 typedef std::array<double, 8> HuMoments;
 
 // The class is used to calculate of Hu's moments
+// The moments are accumulated in one pass by MomentsCalculator (the pixels with non-zero brightness have weight 1)
 class HuMomentsCalculator
 {
 
 public: // Public constructors
 
     // The constructor to calculate a Hu's moments of image part
-    // The user should provide: xStart < xEnd, yStart < yEnd
+    // The user should provide: xStart <= xEnd, yStart <= yEnd
     HuMomentsCalculator(const Image& img, const int xStart, const int yStart, const int xEnd, const int yEnd);
 
 public: // Public methods
 
     const HuMoments& GetHuMoments() const { return mMoments; }
 
-private: // Private members
-
-    // Calculate the regular moment
-    int CalcRegularMoment(const int p, const int q);
-
-    // Calculate the central moment
-    int CalcCentralMoment(const int p, const int q);
-
-    // Calculate the normalized central moment
-    double CalcNormCentralMoment(const int p, const int q);
-
-    // Calculate the constants
-    void GetConstants();
-
-    // Calculate the normalized central moments
-    void CalcNormCentralMoments();
-
-    void CalcHuMoment();
+    // Check that the moments were calculated (the image part is correct)
+    bool IsCalculated() const { return mIsCalculated; }
 
 private: // Private members
 
-    // The image to calculate his moments
-    const Image& mImg;
-
-    // The boundary coordinates of image part
-    int mXStart;
-    int mYStart;
-    int mXEnd;
-    int mYEnd;
-
     // Hu's moments
     HuMoments mMoments;
 
-    // Regular moments
-    int mM00, mM01, mM10, mMu00;
-
-    // The center of gravity coordinates
-    double mXz, mYz;
-
-    // The normalized central moments
-    double mNu20, mNu02, mNu11, mNu30, mNu03, mNu12, mNu21;
+    // Flag of successful calculation
+    bool mIsCalculated;
 
 };
 
@@ -123,6 +123,10 @@ public: // Public methods
     // Can combining of this cases
     Image Resize(const int xMin, const int yMin, const int xMax, const int yMax) const;
 
+    // Same as previous method but the resulting image is written to existing image without allocation of memory
+    // The sizes of resulting image should be (yMax - yMin + 1) x (xMax - xMin + 1)
+    bool Resize(const int xMin, const int yMin, const int xMax, const int yMax, Image& newImg) const;
+
     // Get the raw pointer to i-th element of the pixels vector
     Byte* GetRawPointer(const int elementNum = 0) { return &mPixels[elementNum]; }
     const Byte* GetRawPointer(const int elementNum = 0) const { return &mPixels[elementNum]; }
@@ -136,9 +140,13 @@ public: // Public methods
             value = MAX_PIXEL_VALUE;
     }
 
-    // Overloading subtraction operator
+    // Overloading subtraction operator (absolute difference of pixels)
     Image operator - (const Image& rhs) const;
 
+    // Calculate the absolute difference of pixels of two images to existing image without allocation of memory
+    // All images should have the same sizes (destination image can be one of source images)
+    static bool AbsDiff(const Image& lhs, const Image& rhs, Image& dstImg);
+
     // Equality operator
     bool operator == (const Image& rhs) const;
 
@@ -34,6 +34,7 @@ namespace acv {
 
 class Image;
 class AMorphologicalForm;
+class Progress;
 
 // This enum is used to represent the result of images combining
 enum class CombinationResult
@@ -42,7 +43,8 @@ enum class CombinationResult
     INCORRECT_COMBINER_TYPE, // Incorrect type of combiner
     FEW_IMAGES, // The number of images should be more than 1
     NOT_SAME_IMAGES, // The images should have the same sizes
-    MANY_IMAGES // Combining based on adding the differences use only two images
+    MANY_IMAGES, // Combining based on adding the differences use only two images
+    CANCELLED // Combining was cancelled by the progress of operation
 };
 
 // Class to combine of images by several methods
@@ -71,33 +73,34 @@ public: // Public methods
 
     // Run of combining with specified type
     // Flag needSort is used to sort container of image by entropy
+    // Progress (if it is specified) is advanced by rows (or by combined images) and can cancel the combining
     Image Combine(CombineType combineType, CombinationResult& combRes, const bool needSort = true);    
-    CombinationResult Combine(CombineType combineType, Image& combImg, const bool needSort = true);
+    CombinationResult Combine(CombineType combineType, Image& combImg, const bool needSort = true, Progress* progress = nullptr);
 
 private: // Private methods
 
     // Combining with priority of image with the biggest entropy
     // Flag needSort is used to sort container of image by entropy. If flag value is "false" first image in container is basic
     Image InformativePriority(CombinationResult& combRes, const bool needSort = true);
-    CombinationResult InformativePriority(Image& combImg, const bool needSort = true);
+    CombinationResult InformativePriority(Image& combImg, const bool needSort = true, Progress* progress = nullptr);
 
     // Morphological combining
     // Flag needSort is used to sort container of image by entropy. If flag value is "false" first image in container is basic
     Image Morphological(const size_t numMods, CombinationResult& combRes, const bool needSort = true);
-    CombinationResult Morphological(const size_t numMods, Image& combImg, const bool needSort = true);
+    CombinationResult Morphological(const size_t numMods, Image& combImg, const bool needSort = true, Progress* progress = nullptr);
 
     // Local-entropy combining
     // Each pixel is pixel from image with the biggest local entropy in this pixel
     Image LocalEntropy(CombinationResult& combRes);
-    CombinationResult LocalEntropy(Image& combImg);
+    CombinationResult LocalEntropy(Image& combImg, Progress* progress = nullptr);
 
     // Adding the differences
     Image DifferencesAdding(CombinationResult& combRes, const bool needSort = true);
-    CombinationResult DifferencesAdding(Image& combImg, const bool needSort = true);
+    CombinationResult DifferencesAdding(Image& combImg, const bool needSort = true, Progress* progress = nullptr);
 
     // Calculating the difference of two open images
     Image CalcDiff(CombinationResult& combRes);
-    CombinationResult CalcDiff(Image& combImg);
+    CombinationResult CalcDiff(Image& combImg, Progress* progress = nullptr);
 
     // Check the possibility of combining images in container
     // All images should have same dimensions
@@ -111,14 +114,15 @@ private: // Private methods to morphological combining
     // Calculation the morphological forms
     // The first stage is the criterion histogram segmentation with specified number of histogram mod's
     // At the second stage we make search of forms by using the calculated histogram
-    std::vector<AMorphologicalForm> CalcForms(const Image& baseImg, const int numMods);
+    // Progress is advanced by rows for each mod (the forms are empty if the search was cancelled)
+    std::vector<AMorphologicalForm> CalcForms(const Image& baseImg, const int numMods, Progress* progress = nullptr);
 
     // Run the criterion histogram segmentation
     // The result is the matrix each pixel of which is histogram mod number
     Image Segmentation(const Image& baseImg, const int numMods);
 
     // Search of the image forms by using scanning algorithm
-    std::vector<AMorphologicalForm> FindForms(const Image& histogramm, const int numMods);
+    std::vector<AMorphologicalForm> FindForms(const Image& histogramm, const int numMods, Progress* progress = nullptr);
 
     // Calculation the average brightness of projected image in the form
     void CalcProjectionToForms(const std::vector<AMorphologicalForm>& morphForm, const Image& projImg, Image& projection);
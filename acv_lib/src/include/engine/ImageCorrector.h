@@ -27,10 +27,17 @@
 #ifndef IMAGE_CORRECTOR_H
 #define IMAGE_CORRECTOR_H
 
+#include <array>
+#include <vector>
+#include <cstddef>
+
 #include "Image.h"
 
 namespace acv {
 
+class MultiChannelImage;
+class Progress;
+
 // Class is used to correct image by several methods
 // Class contains only static methods
 class ImageCorrector
@@ -44,17 +51,53 @@ public: // Public auxiliary types
         SSRETINEX, // Single-scale Retinex
         AUTO_LEVELS, // Contrast correction using the auto-levels algorithm
         NORM_AUTO_LEVELS, // Algorithm of auto-levels with pixels correction in three sigma range
-        GAMMA // Gamma-correction
+        GAMMA, // Gamma-correction
+        GLOBAL_EQUALIZATION, // Equalization of histogram of the whole image
+        CLAHE // Contrast limited adaptive histogram equalization (with default parameters)
     };
 
+    // Table of new values of pixels brightness (index is the old value)
+    typedef std::array<Image::Byte, Image::MAX_PIXEL_VALUE + 1> LookUpTable;
+
 public: // Public methods
 
-    static bool Correct(const Image& srcImg, Image& dstImg, CorrectorType corType);
+    // Correct image using a special method
+    // Progress (if it is specified) is advanced by the blur of SSR or by the whole correction for other methods,
+    // the cancelled correction returns false
+    // Source image WILL BE CHANGED!!!
+    static bool Correct(Image& img, CorrectorType corType, Progress* progress = nullptr);
+
+    // Correct image using a special method
+    // Progress (if it is specified) is advanced by the blur of SSR or by the whole correction for other methods,
+    // the cancelled correction returns false
+    static bool Correct(const Image& srcImg, Image& dstImg, CorrectorType corType, Progress* progress = nullptr);
+
+    // Correct each channel of image using a special method (the channels are processed in parallel)
+    // Source image WILL BE CHANGED!!!
+    static bool Correct(MultiChannelImage& img, CorrectorType corType);
+
+    // Correct each channel of image using a special method (the channels are processed in parallel)
+    static bool Correct(const MultiChannelImage& srcImg, MultiChannelImage& dstImg, CorrectorType corType);
+
+    // Form the table of gamma-correction
+    static void FormGammaTable(LookUpTable& table);
+
+    // Form the table to expand the specified range of brightness to all range
+    static void FormExpandRangeTable(const Image::Byte minBr, const Image::Byte maxBr, LookUpTable& table);
+
+    // Form the table of equalization of histogram (the histogram has a bin for each brightness value)
+    static void FormEqualizationTable(const std::vector<size_t>& histogram, LookUpTable& table);
+
+    // Contrast limited adaptive histogram equalization
+    // The image is divided to numTiles x numTiles tiles, the histogram of each tile is clipped by clipLimit
+    // (relative to the average number of pixels in bin, zero disables clipping) and the look-up tables of tiles
+    // are interpolated bilinearly between the centers of tiles
+    static bool Clahe(const Image& srcImg, Image& dstImg, const double clipLimit = 2.0, const int numTiles = 8);
 
 private: // Private methods
 
     // SSR algorith
-    static bool SingleScaleRetinex(const Image& srcImg, Image& dstImg);
+    static bool SingleScaleRetinex(const Image& srcImg, Image& dstImg, Progress* progress);
 
     // Auto-levels algorithm
     static bool AutoLevels(const Image& srcImg, Image& dstImg);
@@ -65,6 +108,9 @@ private: // Private methods
     // Gamma-correction
     static bool GammaCorrection(const Image& srcImg, Image& dstImg);
 
+    // Equalization of histogram of the whole image
+    static bool GlobalEqualization(const Image& srcImg, Image& dstImg);
+
     // The method is used to expand the specified range of brightness to all range
     static void ExpandBrightnessRange(const Image& srcImg, const Image::Byte minBr, const Image::Byte maxBr, Image& dstImg);
 
@@ -27,9 +27,17 @@
 #ifndef IMAGE_FILTER_H
 #define IMAGE_FILTER_H
 
+#include <vector>
+#include <cmath>
+
+#include "Image.h"
+
 namespace acv {
 
-class Image;
+class BinaryImage;
+class MultiChannelImage;
+class Progress;
+template<typename T> class MatrixFilter;
 
 // This enum is used to represent the result of image filtering
 enum class FiltrationResult
@@ -38,7 +46,8 @@ enum class FiltrationResult
     INTERNAL_ERROR, // Error during filtration
     INCORRECT_FILTER_TYPE, // Incorrect type of filter
     INCORRECT_FILTER_SIZE, // Incorrect filter size (he should be odd)
-    SMALL_FILTER_SIZE // Filter size is small (this code is used for IIR Gaussian filtration)
+    SMALL_FILTER_SIZE, // Filter size is small (this code is used for IIR Gaussian filtration)
+    CANCELLED // Filtration was cancelled by the progress of operation
 };
 
 // Class is used to filter images by several methods
@@ -46,6 +55,20 @@ enum class FiltrationResult
 class ImageFilter
 {
 
+    // Processors of frames reuse the kernels, passes and buffers of filters
+    friend class FilterProcessor;
+    friend class BordersProcessor;
+
+public: // Public constants
+
+    enum
+    {
+        DEFAULT_BILATERAL_RANGE_SIGMA = 30, // Default sigma of brightness differences for bilateral filtration
+        DEFAULT_UNSHARP_AMOUNT = 100, // Default amount of unsharp masking (percent of added difference)
+        DEFAULT_UNSHARP_THRESHOLD = 0, // Default threshold of unsharp masking (all differences are added)
+        SAUVOLA_DYNAMIC_RANGE = 128 // Dynamic range of standard deviation for Sauvola threshold
+    };
+
 public: // Public auxiliary types
 
     // Used types of filtration
@@ -55,7 +78,9 @@ public: // Public auxiliary types
         GAUSSIAN, // Gaissian filtration
         SEP_GAUSSIAN, // Separated gaussian filtration
         IIR_GAUSSIAN, // IIR-imitated gaussian filtration
-        SHARPEN // Increase the sharpness of the image
+        SHARPEN, // Increase the sharpness of the image
+        BILATERAL, // Edge-preserving bilateral filtration (spatial sigma is filterSize / 6 as for IIR-gaussian)
+        UNSHARP_MASK // Unsharp masking with radius filterSize / 2 and default amount and threshold
     };
 
     // Used types of threshold
@@ -65,6 +90,13 @@ public: // Public auxiliary types
         MIN_MORE_THRESHOLD  // All pixels more than threshold will be Image::MIN_VALUE
     };
 
+    // Used methods of threshold by the local mean and standard deviation of window
+    enum class ThresholdMethod
+    {
+        NIBLACK, // Level is mean + k * deviation (k is usually about -0.2)
+        SAUVOLA  // Level is mean * (1 + k * (deviation / SAUVOLA_DYNAMIC_RANGE - 1)) (k is usually in range [0.2, 0.5])
+    };
+
     template <typename T>
     class IIRfilter{
         public:
@@ -80,41 +112,142 @@ public: // Public methods
 
     // Run a filtration by the specified method
     // Source image WILL BE CHANGED!!!
-    static FiltrationResult Filter(Image& img, FilterType type, const int filterSize = -1);
+    // Progress (if it is specified) is advanced by rows of image and can cancel the filtration
+    static FiltrationResult Filter(Image& img, FilterType type, const int filterSize = -1, Progress* progress = nullptr);
 
     // Run a filtration by the specified method
-    static FiltrationResult Filter(const Image& srcImg, Image& dstImg, FilterType type, const int filterSize = -1);
+    // Progress (if it is specified) is advanced by rows of image and can cancel the filtration
+    static FiltrationResult Filter(const Image& srcImg, Image& dstImg, FilterType type, const int filterSize = -1,
+                                   Progress* progress = nullptr);
+
+    // Run a filtration of each channel by the specified method (the channels are processed in parallel)
+    // Source image WILL BE CHANGED!!!
+    static FiltrationResult Filter(MultiChannelImage& img, FilterType type, const int filterSize = -1);
+
+    // Run a filtration of each channel by the specified method (the channels are processed in parallel)
+    static FiltrationResult Filter(const MultiChannelImage& srcImg, MultiChannelImage& dstImg, FilterType type, const int filterSize = -1);
 
     // Run an adaptive threshold processing
     static bool AdaptiveThreshold(Image& img, const int filterSize, const int threshold, ThresholdType thresholdType);
     static bool AdaptiveThreshold(const Image& srcImg, Image& dstImg, const int filterSize, const int threshold, ThresholdType thresholdType);
 
+    // Run an adaptive threshold processing by the level of specified method in window filterSize x filterSize
+    // (the window is clamped by the borders of image). The sums of window are taken from the integral rows of pixels
+    // and their squares, so the cost doesn't depend on the size of window. The levels are compared with pixels
+    // at once without intermediate images (the threshold in place doesn't use a temporary image)
+    static bool AdaptiveThreshold(Image& img, const int filterSize, const float k, ThresholdMethod method, ThresholdType thresholdType);
+    static bool AdaptiveThreshold(const Image& srcImg, Image& dstImg, const int filterSize, const float k,
+                                  ThresholdMethod method, ThresholdType thresholdType);
+
+    // Run an adaptive threshold processing to binary image (the set pixels are the pixels which have value
+    // Image::MAX_PIXEL_VALUE in the result of threshold of one-channel image). The sizes of images should be equal
+    static bool AdaptiveThreshold(const Image& srcImg, BinaryImage& dstImg, const int filterSize, const int threshold, ThresholdType thresholdType);
+    static bool AdaptiveThreshold(const Image& srcImg, BinaryImage& dstImg, const int filterSize, const float k,
+                                  ThresholdMethod method, ThresholdType thresholdType);
+
+    // Edge-preserving bilateral filtration (source and destination can be the same image)
+    // The cost doesn't depend on spatial sigma: the range of brightness is divided to levels with step not larger than
+    // range sigma, the image weighted by range kernel of each level is blurred by IIR-filter and the normalized results
+    // of two nearest levels are interpolated for each pixel. Progress (if it is specified) is advanced by levels
+    static FiltrationResult Bilateral(const Image& srcImg, Image& dstImg, const float spatialSigma,
+                                      const float rangeSigma = DEFAULT_BILATERAL_RANGE_SIGMA, Progress* progress = nullptr);
+
+    // Unsharp masking (source and destination can be the same image): the difference between the source and its
+    // Gaussian blur with specified radius multiplied by amount (in percents) is added to the source if the absolute
+    // difference is not smaller than threshold. The blur, difference and addition are done in one pass by strips
+    // of rows (separate Gaussian for small radius, IIR-gaussian with sigma (2 * radius + 1) / 6 for others),
+    // so the cost is close to the cost of blur. Progress (if it is specified) is advanced by rows
+    static FiltrationResult UnsharpMask(const Image& srcImg, Image& dstImg, const int radius,
+                                        const int amount = DEFAULT_UNSHARP_AMOUNT, const int threshold = DEFAULT_UNSHARP_THRESHOLD,
+                                        Progress* progress = nullptr);
+
+private: // Private auxiliary types
+
+    // Buffers of levels of bilateral filtration (the processors of frames keep them between frames)
+    struct BilateralBuffers
+    {
+        std::vector<float> values; // Weighted values of current level
+        std::vector<float> weights; // Range weights of current level
+        std::vector<float> prevLevel; // Normalized result of previous level
+        Image srcCopy; // Copy of source which is filtered in place
+    };
+
+    // Buffers of unsharp masking (the processors of frames keep them between frames)
+    struct UnsharpMaskBuffers
+    {
+        std::vector<float> blurred; // Image blurred by IIR-filter
+        std::vector<IIRfilter<float>> columnFilters; // Filters of columns of the vertical pass of IIR-filter
+        std::vector<int> filter; // Kernel of separate filter
+        int divider = 0; // Divider of kernel of separate filter
+        std::vector<Image::Byte> stripRows; // Horizontally blurred rows of each strip of separate filter
+        std::vector<int> sums; // Sums of vertical pass of each strip of separate filter
+        std::vector<Image::Byte> blurredRows; // Blurred row of each strip of separate filter or of each block of columns
+        Image srcCopy; // Copy of source which is filtered in place by separate filter
+    };
+
 private: // Private methods
 
     // Median filtration (filter size must be odd)
     // Source image WILL BE CHANGED!!!
-    static FiltrationResult Median(Image& img, const int filterSize);
+    static FiltrationResult Median(Image& img, const int filterSize, Progress* progress);
 
     // Median filtration (filter size must be odd)
-    static FiltrationResult Median(const Image& srcImg, Image& dstImg, const int filterSize);
+    static FiltrationResult Median(const Image& srcImg, Image& dstImg, const int filterSize, Progress* progress);
 
     // Gaussian filtration (filter size must be odd)
     // Source image WILL BE CHANGED!!!
-    static FiltrationResult Gaussian(Image& img, const int filterSize);
+    static FiltrationResult Gaussian(Image& img, const int filterSize, Progress* progress);
 
     // Gaussian filtration (filter size must be odd)
-    static FiltrationResult Gaussian(const Image& srcImg, Image& dstImg, const int filterSize);
+    static FiltrationResult Gaussian(const Image& srcImg, Image& dstImg, const int filterSize, Progress* progress);
 
     // Separate Gaussian filtration
-    static FiltrationResult SeparateGaussian(const Image& srcImg, Image& dstImg, const int filterSize);
+    static FiltrationResult SeparateGaussian(Image& img, const int filterSize, Progress* progress);
+    static FiltrationResult SeparateGaussian(const Image& srcImg, Image& dstImg, const int filterSize, Progress* progress);
 
     // Gaussian imitation by IIR-filter
-    static FiltrationResult GaussianIIR(Image& img, float sigma);
-    static FiltrationResult GaussianIIR(const Image& srcImg, Image& dstImg, float sigma);
+    static FiltrationResult GaussianIIR(Image& img, float sigma, Progress* progress);
+    static FiltrationResult GaussianIIR(const Image& srcImg, Image& dstImg, float sigma, Progress* progress);
 
     // Increase the sharpness of the image
-    static FiltrationResult Sharpen(Image& img);
-    static FiltrationResult Sharpen(const Image& srcImg, Image& dstImg);
+    static FiltrationResult Sharpen(Image& img, Progress* progress);
+    static FiltrationResult Sharpen(const Image& srcImg, Image& dstImg, Progress* progress);
+
+private: // Private methods used by filters and by the processor of frames
+
+    // Form the kernel of Gaussian filter (filter size must be odd)
+    static void FormGaussianFilter(const int filterSize, MatrixFilter<int>& filter);
+
+    // Form the 1D kernel of separate Gaussian filter (filter size must be odd)
+    static void FormSeparateGaussianFilter(const int filterSize, std::vector<int>& filter, int& divider);
+
+    // Form the kernel of sharpen filter
+    static void FormSharpenFilter(MatrixFilter<int>& filter);
+
+    // Run the horizontal and vertical passes of separate Gaussian filter (temporary image has sizes of source image)
+    // Returns false if the passes were cancelled by the progress
+    static bool SeparateGaussianPasses(const Image& srcImg, Image& tmpImg, Image& dstImg,
+                                       const std::vector<int>& filter, const int divider, Progress* progress = nullptr);
+
+    // Run the IIR-filter with calculated ratios over image in place
+    // Returns false if the passes were cancelled by the progress
+    static bool GaussianIIRPasses(Image& img, IIRfilter<float>& filter, Progress* progress = nullptr);
+
+    // Allocate the buffers of levels of bilateral filtration for image of specified sizes
+    // (the copy of source is allocated by the filtration in place)
+    static void PrepareBilateralBuffers(const int height, const int width, BilateralBuffers& buffers);
+
+    // Bilateral filtration with specified buffers of levels (they don't allocate memory if they were prepared for sizes of image)
+    static FiltrationResult Bilateral(const Image& srcImg, Image& dstImg, const float spatialSigma, const float rangeSigma,
+                                      BilateralBuffers& buffers, Progress* progress = nullptr);
+
+    // Allocate the buffers of unsharp masking with specified radius for image of specified sizes
+    // (the copy of source is allocated by the filtration in place)
+    static void PrepareUnsharpMaskBuffers(const int height, const int width, const int radius, UnsharpMaskBuffers& buffers);
+
+    // Unsharp masking with specified buffers (they don't allocate memory if they were prepared for sizes of image and radius)
+    static FiltrationResult UnsharpMask(const Image& srcImg, Image& dstImg, const int radius, const int amount, const int threshold,
+                                        UnsharpMaskBuffers& buffers, Progress* progress = nullptr);
 };
 
 
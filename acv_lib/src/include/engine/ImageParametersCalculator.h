@@ -27,14 +27,31 @@
 #ifndef IMAGE_PARAMETERS_CALCULATOR_H
 #define IMAGE_PARAMETERS_CALCULATOR_H
 
+#include <cstddef>
+
 #include "Image.h"
 
 namespace acv {
 
+class Histogram;
+
 // Class is used to calculate parameters of image
 class ImageParametersCalculator
 {
 
+public: // Public auxiliary types
+
+    // Parameters of image which are calculated together
+    struct Parameters
+    {
+        double entropy; // Entropy
+        double averageBrightness; // Average brightness
+        double standardDeviation; // Standard deviation of brightness
+        Image::Byte minBrightness; // Minimum brightness
+        Image::Byte maxBrightness; // Maximum brightness
+        double integralQualityIndicator; // Integral quality indicator
+    };
+
 public: // Constructors
 
     // Default constructor
@@ -92,8 +109,19 @@ public: // Public methods
     // Create array for brightness histogram of image
     void CreateBrightnessHistogram(std::vector<double>& brightnessHistogram);
 
+    // Calculate all parameters by one pass over the pixels (the parameters are taken from the histogram of image)
+    // Returns false if image is not initialized
+    bool CalcParameters(Parameters& params);
+
 private: // Private methods
 
+    // Calculate the entropy by the histogram of image
+    static double CalcEntropy(const Histogram& histogram);
+
+    // Calculate the integral quality indicator by other parameters
+    static double CalcIntegralQualityIndicator(const Image::Byte minBrig, const Image::Byte maxBrig, const double averBrig,
+                                               const double stdDev, const double entr, const size_t numLevels);
+
     // Calculate the numer of information levels of image
     size_t CalcNumberInformationLevels();
 
@@ -0,0 +1,100 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class of image of labels (for example, labels of connected components)
+
+#ifndef LABEL_IMAGE_H
+#define LABEL_IMAGE_H
+
+#include <vector>
+
+namespace acv {
+
+class Image;
+class BinaryImage;
+
+// Class of image each pixel of which is a label of object (0 is background)
+class LabelImage
+{
+
+public: // Auxiliary types
+
+    typedef std::vector<int> Matrix; // This type is used to representation of labels matrix
+
+public: // Constructors
+
+    // Default constructor
+    LabelImage();
+
+    // Constructor of image with specified dimensions (all pixels are background)
+    LabelImage(const int height, const int width);
+
+public: // Public methods
+
+    // Get the width of image
+    int GetWidth() const { return mWidth; }
+
+    // Get the height of image
+    int GetHeight() const { return mHeight; }
+
+    // Get the number of labels (labels are numbered from 1)
+    int GetNumLabels() const { return mNumLabels; }
+
+    // Set the number of labels
+    void SetNumLabels(const int numLabels) { mNumLabels = numLabels; }
+
+    // Get the label by coordinates
+    int GetLabel(const int rowNum, const int colNum) const { return mLabels[mWidth * rowNum + colNum]; }
+
+    // Get the reference to the labels vector
+    Matrix& GetData() { return mLabels; }
+    const Matrix& GetData() const { return mLabels; }
+
+    // Label the connected components (8-connectivity) of non-zero pixels of image
+    // The labels are numbered in order of raster scan
+    static bool LabelConnectedComponents(const Image& img, LabelImage& labels);
+
+    // Label the connected components (8-connectivity) of set pixels of binary image
+    // The labels are numbered in order of raster scan (the same labels as for the image of bytes)
+    static bool LabelConnectedComponents(const BinaryImage& img, LabelImage& labels);
+
+private: // Private members
+
+    // Matrix of labels
+    Matrix mLabels;
+
+    // Image width
+    int mWidth;
+
+    // Image height
+    int mHeight;
+
+    // Number of labels
+    int mNumLabels;
+
+};
+
+}
+
+#endif // LABEL_IMAGE_H
@@ -30,6 +30,7 @@
 #include <vector>
 
 #include "Image.h"
+#include "Parallel.h"
 
 namespace acv {
 
@@ -133,6 +134,11 @@ public: // Public methods
     template<typename FilterElementT>
     static bool FastConvolutionImage(Image& img, const MatrixFilter<FilterElementT>& filter);
 
+    // Fast convolution of image which is already expanded by the filter aperture (see Image::Resize)
+    // Resulting image has the sizes of source image, memory is not allocated
+    template<typename FilterElementT>
+    static bool FastConvolutionExpandedImage(const Image& expandedImg, Image& dstImg, const MatrixFilter<FilterElementT>& filter);
+
     // Convolution of pixel with filter
     template<typename FilterElementT>
     static FilterElementT ConvolutionPixel(const Image& img, const int rowNum, const int colNum,
@@ -140,9 +146,12 @@ public: // Public methods
 
 private: // Private methods
 
-    // Convolution of pixel with filter (used in fast convolution)
+    // Convolution of rows of expanded image with filter (sizes are already checked)
     template<typename FilterElementT>
-    inline static FilterElementT ConvolutionPixel(std::vector<Image::Byte*>& rowsStarts, const MatrixFilter<FilterElementT>& filter);
+    static void ConvolutionExpandedRows(const Image& expandedImg, Image& dstImg, const MatrixFilter<FilterElementT>& filter);
+
+    // Convolution of rows of expanded image with integer filter by the vectorized kernels (see SimdKernels)
+    static void ConvolutionExpandedRows(const Image& expandedImg, Image& dstImg, const MatrixFilter<int>& filter);
 
 };
 
@@ -182,30 +191,57 @@ bool MatrixFilterOperations::FastConvolutionImage(Image& img, const MatrixFilter
 
     int aperture = filter.GetAperture();
     Image tmpImg = img.Resize(-aperture, -aperture, img.GetWidth() + aperture - 1, img.GetHeight() + aperture - 1);
-    Image::Byte* pTmpPix = tmpImg.GetRawPointer();
 
-    std::vector<Image::Byte*> rowsStarts(filter.GetSize());
-    for (int i = 0; i < filter.GetSize(); ++i)
-    {
-        rowsStarts[i] = pTmpPix;
-        pTmpPix += tmpImg.GetWidth();
-    }
+    return FastConvolutionExpandedImage(tmpImg, img, filter);
+}
 
-    Image::Byte* pDst = img.GetRawPointer();
-    for (int rowNum = 0; rowNum < img.GetHeight(); ++rowNum)
+template<typename FilterElementT>
+bool MatrixFilterOperations::FastConvolutionExpandedImage(const Image& expandedImg, Image& dstImg, const MatrixFilter<FilterElementT>& filter)
+{
+    const int filterSize = filter.GetSize();
+    if (!filter.IsCorrectFilter() ||
+        expandedImg.GetWidth() != dstImg.GetWidth() + filterSize - 1 ||
+        expandedImg.GetHeight() != dstImg.GetHeight() + filterSize - 1)
+        return false;
+
+    ConvolutionExpandedRows(expandedImg, dstImg, filter);
+    return true;
+}
+
+template<typename FilterElementT>
+void MatrixFilterOperations::ConvolutionExpandedRows(const Image& expandedImg, Image& dstImg, const MatrixFilter<FilterElementT>& filter)
+{
+    const int filterSize = filter.GetSize();
+    const int expandedWidth = expandedImg.GetWidth();
+    const FilterElementT div = filter.GetDivider();
+
+    Parallel::For(0, dstImg.GetHeight(), [&](const int rowBegin, const int rowEnd)
     {
-        for (int colNum = 0; colNum < img.GetWidth(); ++colNum)
+        Image::Byte* pDst = dstImg.GetRawPointer(rowBegin * dstImg.GetWidth());
+        for (int rowNum = rowBegin; rowNum < rowEnd; ++rowNum)
         {
-            FilterElementT conv = MatrixFilterOperations::ConvolutionPixel<FilterElementT>(rowsStarts, filter);
-            Image::CheckPixelValue(conv);
-            *pDst++ = static_cast<Image::Byte>(conv);
+            const Image::Byte* pRowStart = expandedImg.GetRawPointer(rowNum * expandedWidth);
+
+            for (int colNum = 0; colNum < dstImg.GetWidth(); ++colNum, ++pRowStart)
+            {
+                FilterElementT conv = 0;
+
+                const Image::Byte* pSrc = pRowStart;
+                for (int row = 0; row < filterSize; ++row, pSrc += expandedWidth)
+                {
+                    const std::vector<FilterElementT>& filterRow = filter[row];
+                    for (int col = 0; col < filterSize; ++col)
+                        conv += filterRow[col] * pSrc[col];
+                }
+
+                if (div != 0)
+                    conv /= div;
+
+                Image::CheckPixelValue(conv);
+                *pDst++ = static_cast<Image::Byte>(conv);
+            }
         }
-
-        for (int i = 0; i < filter.GetSize(); ++i)
-            rowsStarts[i] += filter.GetSize() - 1;
-    }
-
-    return true;
+    }, 16);
 }
 
 template<typename FilterElementT>
@@ -232,29 +268,6 @@ FilterElementT MatrixFilterOperations::ConvolutionPixel(const Image& img, const
     return res;
 }
 
-template<typename FilterElementT>
-inline FilterElementT MatrixFilterOperations::ConvolutionPixel(std::vector<Image::Byte*>& rowsStarts, const MatrixFilter<FilterElementT>& filter)
-{
-    FilterElementT res = 0;
-
-    for (int row = 0; row < filter.GetSize(); ++row)
-    {
-        for (int col = 0; col < filter.GetSize(); ++col)
-        {
-            Image::Byte rowPix = *rowsStarts[row];
-            res += filter.GetElement(row, col) * rowPix;
-            ++rowsStarts[row];
-        }
-        rowsStarts[row] -= filter.GetSize() - 1;
-    }
-
-    FilterElementT div = filter.GetDivider();
-    if (div != 0)
-        res /= div;
-
-    return res;
-}
-
 }
 
 #endif // MATRIX_FILTER_H
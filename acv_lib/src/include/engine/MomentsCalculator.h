@@ -0,0 +1,145 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class to calculate the image moments in one pass
+// and the Hu's moments for every position of sliding window
+
+#ifndef MOMENTS_CALCULATOR_H
+#define MOMENTS_CALCULATOR_H
+
+#include <vector>
+
+#include "HuMomentsCalculator.h"
+
+namespace acv {
+
+class Image;
+class LabelImage;
+
+// Raw (regular) moments of image up to the third order
+struct RawMoments
+{
+    double m00, m10, m01, m20, m11, m02, m30, m21, m12, m03;
+
+    // All moments are zero
+    RawMoments();
+
+    // Sum of moments of two non-intersecting image parts (coordinates should have same origin)
+    RawMoments& operator += (const RawMoments& rhs);
+    RawMoments& operator -= (const RawMoments& rhs);
+};
+
+// Central moments of image up to the third order
+struct CentralMoments
+{
+    double mu00, mu20, mu11, mu02, mu30, mu21, mu12, mu03;
+};
+
+class MomentsCalculator
+{
+
+public: // Public auxiliary types
+
+    // Weight of pixel during accumulation of moments
+    enum class WeightType
+    {
+        BINARY, // Each pixel with non-zero brightness has weight 1 (as in HuMomentsCalculator)
+        INTENSITY // Weight of pixel is equal to his brightness
+    };
+
+    // Rectangular region of interest (boundaries are included)
+    struct Roi
+    {
+        int xStart, yStart, xEnd, yEnd;
+    };
+
+public: // Public methods
+
+    // Calculate the raw moments of image part in one pass
+    // Coordinates of pixels are counted from (xStart, yStart). The user should provide: xStart <= xEnd, yStart <= yEnd
+    static bool CalcRawMoments(const Image& img, const int xStart, const int yStart, const int xEnd, const int yEnd,
+                               RawMoments& moments, WeightType weightType = WeightType::BINARY);
+
+    // Derive the central moments from the raw moments
+    static CentralMoments CalcCentralMoments(const RawMoments& raw);
+
+    // Derive the Hu's moments from the raw moments (layout of array is the same as in HuMomentsCalculator)
+    static HuMoments CalcHuMoments(const RawMoments& raw);
+
+    // Calculate the Hu's moments of image part
+    static bool CalcHuMoments(const Image& img, const int xStart, const int yStart, const int xEnd, const int yEnd,
+                              HuMoments& moments, WeightType weightType = WeightType::BINARY);
+
+    // Calculate the Hu's moments for every position of window with size winWidth x winHeight (template scanning)
+    // The result is a row-major matrix with (height - winHeight + 1) rows and (width - winWidth + 1) columns,
+    // the element [row][col] contains the moments of window with top-left corner in (col, row)
+    static bool CalcDenseHuMoments(const Image& img, const int winWidth, const int winHeight,
+                                   std::vector<HuMoments>& moments, WeightType weightType = WeightType::BINARY);
+
+    // Calculate the Hu's moments of the each region of interest (regions are processed in parallel)
+    // The element [i] of result contains the moments of rois[i]. Method fails if any region is invalid
+    static bool CalcHuMoments(const Image& img, const std::vector<Roi>& rois,
+                              std::vector<HuMoments>& moments, WeightType weightType = WeightType::BINARY);
+
+    // Calculate the raw moments of all labeled objects in a single raster pass (stripes of image are processed in parallel)
+    // The element [label - 1] of result contains the moments of object with this label
+    // Coordinates of the moments are counted from the center of image
+    static bool CalcRawMoments(const Image& img, const LabelImage& labels,
+                               std::vector<RawMoments>& moments, WeightType weightType = WeightType::BINARY);
+
+    // Calculate the Hu's moments of all labeled objects (layout of result is the same as for the raw moments)
+    static bool CalcHuMoments(const Image& img, const LabelImage& labels,
+                              std::vector<HuMoments>& moments, WeightType weightType = WeightType::BINARY);
+
+};
+
+// Integral images of the raw moments
+// Each element contains the moments of image part from (0, 0) to current pixel
+// Coordinates are counted from the center of image to decrease the values of third order sums
+class IntegralMoments
+{
+
+public: // Public constructors
+
+    // Build the integral images for the whole image
+    IntegralMoments(const Image& img, MomentsCalculator::WeightType weightType = MomentsCalculator::WeightType::BINARY);
+
+public: // Public methods
+
+    // Get the raw moments of image part in O(1) (coordinates of the moments are counted from the center of image)
+    RawMoments GetRawMoments(const int xStart, const int yStart, const int xEnd, const int yEnd) const;
+
+private: // Private members
+
+    // Width of integral images (width of image + 1)
+    int mWidth;
+
+    // Integral images (row-major, the first row and column are zero)
+    std::vector<RawMoments> mSums;
+
+};
+
+}
+
+#endif // MOMENTS_CALCULATOR_H
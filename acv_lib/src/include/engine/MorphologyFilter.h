@@ -0,0 +1,120 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class of morphological filtration of images
+
+#ifndef MORPHOLOGY_FILTER_H
+#define MORPHOLOGY_FILTER_H
+
+#include "ImageFilter.h"
+
+namespace acv {
+
+class Image;
+class BinaryImage;
+class Progress;
+
+// Class is used to run the grayscale morphological operations with rectangular structuring element
+// The erosion and dilation are separated to horizontal and vertical passes, each pass is calculated
+// by van Herk/Gil-Werman algorithm (3 comparisons per pixel regardless of size of structuring element)
+// or directly with SIMD minimum/maximum for small structuring elements
+// Class contains only static methods
+class MorphologyFilter
+{
+
+public: // Public auxiliary types
+
+    // Used types of morphological operations
+    enum class MorphologyType
+    {
+        EROSION, // Minimum in the window of structuring element
+        DILATION, // Maximum in the window of structuring element
+        OPENING, // Erosion and then dilation (removes small bright details)
+        CLOSING // Dilation and then erosion (removes small dark details)
+    };
+
+public: // Public methods
+
+    // Run a morphological operation with structuring element of size seWidth x seHeight (sizes should be odd)
+    // Progress (if it is specified) is advanced by passes, the cancelled operation returns CANCELLED
+    // Source image WILL BE CHANGED!!!
+    static FiltrationResult Filter(Image& img, MorphologyType type, const int seWidth, const int seHeight,
+                                   Progress* progress = nullptr);
+
+    // Run a morphological operation with structuring element of size seWidth x seHeight (sizes should be odd)
+    // Progress (if it is specified) is advanced by passes, the cancelled operation returns CANCELLED
+    static FiltrationResult Filter(const Image& srcImg, Image& dstImg, MorphologyType type, const int seWidth, const int seHeight,
+                                   Progress* progress = nullptr);
+
+    // Run a morphological operation of binary image with structuring element of size seWidth x seHeight (sizes should be odd)
+    // The dilation combines the shifted copies of words, the window is doubled on each step, so the number of steps is
+    // logarithm of size of structuring element. The erosion is the dilation of inverted image.
+    // The pixels out of image don't change the result (as in the operations of grayscale images)
+    // Progress (if it is specified) is advanced by passes, the cancelled operation returns CANCELLED
+    static FiltrationResult Filter(BinaryImage& img, MorphologyType type, const int seWidth, const int seHeight,
+                                   Progress* progress = nullptr);
+    static FiltrationResult Filter(const BinaryImage& srcImg, BinaryImage& dstImg, MorphologyType type, const int seWidth, const int seHeight,
+                                   Progress* progress = nullptr);
+
+private: // Private auxiliary types
+
+    // Operation of one pass
+    enum class Operation
+    {
+        MIN, // Erosion
+        MAX // Dilation
+    };
+
+private: // Private methods
+
+    // Erosion or dilation (source and destination images can be the same)
+    // Returns false if the operation was cancelled
+    static bool Apply(const Image& srcImg, Image& dstImg, Operation op, const int seWidth, const int seHeight, Progress* progress);
+
+    // Pass along the rows with window of size windowSize
+    static void HorizontalPass(const Image& srcImg, Image& dstImg, Operation op, const int windowSize);
+
+    // Pass along the columns with window of size windowSize
+    static void VerticalPass(const Image& srcImg, Image& dstImg, Operation op, const int windowSize);
+
+    // Erosion or dilation of binary image (source and destination images can be the same)
+    // Returns false if the operation was cancelled
+    static bool Apply(const BinaryImage& srcImg, BinaryImage& dstImg, Operation op, const int seWidth, const int seHeight, Progress* progress);
+
+    // Dilation of binary image along the rows with window of size windowSize
+    static void HorizontalDilation(const BinaryImage& srcImg, BinaryImage& dstImg, const int windowSize);
+
+    // Dilation of binary image along the columns with window of size windowSize
+    static void VerticalDilation(const BinaryImage& srcImg, BinaryImage& dstImg, const int windowSize);
+
+private: // Private constants
+
+    // Maximum size of window which is processed directly (without van Herk/Gil-Werman algorithm)
+    static const int MAX_DIRECT_WINDOW_SIZE = 7;
+
+};
+
+}
+
+#endif // MORPHOLOGY_FILTER_H
@@ -0,0 +1,139 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class of multi-channel image and his methods
+
+#ifndef MULTI_CHANNEL_IMAGE_H
+#define MULTI_CHANNEL_IMAGE_H
+
+#include <vector>
+#include <functional>
+
+#include "Image.h"
+
+namespace acv {
+
+// Class of multi-channel image (for example, RGB)
+// The channels are stored in planar layout: each channel is a separate one-channel image,
+// so the algorithms for one-channel images are applied to the channels directly.
+// Interleaved buffers (pixel by pixel) are converted to planar layout and back by SIMD kernels
+class MultiChannelImage
+{
+
+public: // Constants
+
+    enum
+    {
+        MAX_NUM_CHANNELS = 4 // Maximum number of channels
+    };
+
+public: // Auxiliary types
+
+    // Function to process one channel from source image to destination image
+    typedef std::function<bool(const int channelNum, const Image& srcChannel, Image& dstChannel)> ChannelFunction;
+
+    // Function to process one channel in place
+    typedef std::function<bool(const int channelNum, Image& channel)> InPlaceChannelFunction;
+
+public: // Constructors
+
+    // Default constructor
+    MultiChannelImage();
+
+    // Constructor of image with specified dimensions and number of channels
+    MultiChannelImage(const int height, const int width, const int numChannels);
+
+    // Constructor of image with specified dimensions from interleaved buffer
+    // Each pixel of buffer contains numChannels bytes, each row starts at bytesPerLine bytes after previous
+    MultiChannelImage(const int height, const int width, const int numChannels, const void* buf, const int bytesPerLine);
+
+    // Copy-constructor
+    MultiChannelImage(const MultiChannelImage&) = default;
+
+    // Move-constructor
+    MultiChannelImage(MultiChannelImage&&) = default;
+
+    // Destructor
+    virtual ~MultiChannelImage() = default;
+
+public: // Public methods
+
+    // Get the width of image
+    int GetWidth() const { return mWidth; }
+
+    // Get the height of image
+    int GetHeight() const { return mHeight; }
+
+    // Get the number of channels
+    int GetNumChannels() const { return static_cast<int>(mChannels.size()); }
+
+    // Get the reference to channel by number
+    Image& GetChannel(const int channelNum) { return mChannels[channelNum]; }
+    const Image& GetChannel(const int channelNum) const { return mChannels[channelNum]; }
+
+    // Check the initialization of image
+    // Image is not initialized if was created by default constructor
+    bool IsInitialized() const;
+
+    // Check that images have the same dimensions and number of channels
+    bool HasSameFormat(const MultiChannelImage& other) const;
+
+    // Fill the channels from interleaved buffer (each pixel of buffer contains GetNumChannels() bytes)
+    bool Deinterleave(const void* buf, const int bytesPerLine);
+
+    // Write the channels to interleaved buffer (each pixel of buffer contains GetNumChannels() bytes)
+    bool Interleave(void* buf, const int bytesPerLine) const;
+
+    // Image scaling (upscaling and downscaling) of each channel
+    MultiChannelImage Scale(const short kScaleX, const short kScaleY, Image::ScaleType scaleType) const;
+
+    // Run the function for each channel, the channels are processed in parallel
+    // Images should have the same format, returns false if function fails for any channel
+    static bool ProcessChannels(const MultiChannelImage& srcImg, MultiChannelImage& dstImg, const ChannelFunction& func);
+
+    // Run the function for each channel in place, the channels are processed in parallel
+    static bool ProcessChannels(MultiChannelImage& img, const InPlaceChannelFunction& func);
+
+    // Assignment operator
+    MultiChannelImage& operator = (const MultiChannelImage&) = default;
+
+    // Move assignment operator
+    MultiChannelImage& operator = (MultiChannelImage&&) = default;
+
+private: // Private members
+
+    // Channels of image
+    std::vector<Image> mChannels;
+
+    // Image width (value -1 if image was not initialized)
+    int mWidth;
+
+    // Image height (value -1 if image was not initialized)
+    int mHeight;
+
+};
+
+}
+
+#endif // MULTI_CHANNEL_IMAGE_H
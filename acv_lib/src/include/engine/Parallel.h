@@ -0,0 +1,59 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class to run the engine algorithms in parallel
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <functional>
+
+namespace acv {
+
+// Class of parallel execution over the shared pool of worker threads (see TaskScheduler)
+// Contains only static methods
+class Parallel
+{
+
+public: // Public auxiliary types
+
+    // Body of parallel loop. It gets the half-open range [begin, end) of iterations
+    typedef std::function<void(const int begin, const int end)> RangeBody;
+
+public: // Public methods
+
+    // Run the body for range [begin, end) splitted to chunks which are not smaller than grainSize (fork-join)
+    // The range is divided in halves recursively, so the idle threads steal the largest parts of range.
+    // The calling thread takes part in execution and returns after all chunks will be processed.
+    // The nested loops (calls from the body) are divided between the same threads
+    static void For(const int begin, const int end, const RangeBody& body, const int grainSize = 1);
+
+    // Get the number of threads used to parallel execution (including the calling thread)
+    static int GetNumThreads();
+
+};
+
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,143 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class of pipeline of image processing operations
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <vector>
+#include <functional>
+
+#include "ImageFilter.h"
+#include "ImageCorrector.h"
+#include "BordersDetector.h"
+#include "MorphologyFilter.h"
+
+namespace acv {
+
+// Class of pipeline which runs the sequence of operations without full intermediate images
+// The operations with limited neighbourhood are run in row strips (each strip is expanded by the halo of all operations),
+// the point operations are fused into the table which is applied to the output of previous operation in strip.
+// Full intermediate image is produced only before the operation which needs global data (IIR filtration,
+// Retinex, Canny, auto-levels after neighbourhood operation)
+class Pipeline
+{
+
+public: // Public methods
+
+    // Add the filtration by the specified method
+    void AddFilter(ImageFilter::FilterType type, const int filterSize = -1);
+
+    // Add the adaptive threshold processing
+    void AddAdaptiveThreshold(const int filterSize, const int threshold, ImageFilter::ThresholdType thresholdType);
+
+    // Add the adaptive threshold processing by local statistics
+    void AddAdaptiveThreshold(const int filterSize, const float k, ImageFilter::ThresholdMethod method,
+                              ImageFilter::ThresholdType thresholdType);
+
+    // Add the correction by the specified method
+    void AddCorrector(ImageCorrector::CorrectorType corType);
+
+    // Add the detection of borders
+    void AddBordersDetector(BordersDetector::DetectorType detectorType);
+
+    // Add the convolution with specified operator
+    void AddOperator(BordersDetector::DetectorType detectorType, BordersDetector::OperatorType operatorType);
+
+    // Add the morphological operation
+    void AddMorphology(MorphologyFilter::MorphologyType type, const int seWidth, const int seHeight);
+
+    // Remove all operations
+    void Clear() { mStages.clear(); }
+
+    // Check the absence of operations
+    bool IsEmpty() const { return mStages.empty(); }
+
+    // Run all operations (source and destination images can be the same)
+    bool Run(const Image& srcImg, Image& dstImg) const;
+
+private: // Private auxiliary types
+
+    // Type of operation by the data which it needs
+    enum class StageType
+    {
+        POINT, // New value of pixel depends only on his old value (table is known before run)
+        STATISTICS, // Point operation which table depends on statistics of the whole input image
+        NEIGHBOURHOOD, // New value of pixel depends on the pixels in rows [row - halo, row + halo]
+        GLOBAL // New value of pixel can depend on the whole image
+    };
+
+    // Operation which runs an algorithm from source image to destination image
+    typedef std::function<bool(const Image& srcImg, Image& dstImg)> Operation;
+
+    // Stage of pipeline
+    struct Stage
+    {
+        StageType type; // Type of operation
+        int halo; // Number of rows above and below pixel which are used by neighbourhood operation
+        Operation operation; // Neighbourhood or global operation
+        ImageCorrector::CorrectorType corType; // Point or statistics corrector
+    };
+
+    // Neighbourhood stage fused with subsequent point stages
+    struct FusedStage
+    {
+        const Stage* stage; // Neighbourhood stage
+        bool hasTable; // Flag of presence of point stages after neighbourhood stage
+        ImageCorrector::LookUpTable table; // Composition of point stages
+    };
+
+private: // Private methods
+
+    // Add the stage to the end of pipeline
+    void AddStage(StageType type, const int halo, const Operation& operation,
+                  ImageCorrector::CorrectorType corType = ImageCorrector::CorrectorType::GAMMA);
+
+    // Run the neighbourhood stages in row strips
+    // The input table is applied to the source image before the first stage
+    static bool RunStrips(const Image& srcImg, const ImageCorrector::LookUpTable* pInputTable,
+                          const std::vector<FusedStage>& stages, Image& dstImg);
+
+    // Form the table of point or statistics stage for image with specified histogram
+    static void FormStageTable(const Stage& stage, const std::vector<size_t>& histogram, ImageCorrector::LookUpTable& table);
+
+private: // Private constants
+
+    enum
+    {
+        STRIP_BYTES = 256 * 1024, // Desired size of strip of output rows (strip should be placed in cache)
+        MIN_STRIP_ROWS = 16 // Minimum number of rows in strip
+    };
+
+private: // Private members
+
+    // Stages of pipeline in order of execution
+    std::vector<Stage> mStages;
+
+};
+
+}
+
+#endif // PIPELINE_H
@@ -0,0 +1,70 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class to convert the pixels between image and external buffers
+
+#ifndef PIXEL_CONVERTER_H
+#define PIXEL_CONVERTER_H
+
+namespace acv {
+
+class Image;
+
+// Class is used to bulk import and export of image pixels from (to) external buffers with rows stride
+// Color pixels are converted to brightness by luma weights (11 * R + 16 * G + 5 * B) / 32
+// Class contains only static methods
+class PixelConverter
+{
+
+public: // Public auxiliary types
+
+    // Formats of pixels in external buffers
+    enum class PixelFormat
+    {
+        GRAY8, // One byte of brightness
+        RGB888, // Bytes R, G, B
+        BGR888, // Bytes B, G, R
+        RGBA8888, // Bytes R, G, B, A
+        BGRA8888, // Bytes B, G, R, A (32-bit ARGB value on little-endian machines)
+        ARGB8888 // Bytes A, R, G, B (32-bit ARGB value on big-endian machines)
+    };
+
+public: // Public methods
+
+    // Fill the pixels of initialized image from buffer
+    // Buffer should contain GetHeight() rows, each row starts at bytesPerLine bytes after previous
+    static bool Import(const void* buf, const int bytesPerLine, PixelFormat format, Image& dstImg);
+
+    // Write the pixels of image to buffer (color components are equal to brightness, alpha is opaque)
+    // Buffer should contain GetHeight() rows, each row starts at bytesPerLine bytes after previous
+    static bool Export(const Image& srcImg, void* buf, const int bytesPerLine, PixelFormat format);
+
+    // Get the number of bytes per one pixel in buffer of specified format
+    static int GetBytesPerPixel(PixelFormat format);
+
+};
+
+}
+
+#endif // PIXEL_CONVERTER_H
@@ -0,0 +1,154 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class of built-in profiling of engine stages
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace acv {
+
+// Class of aggregated timings of engine stages and of counters (processed bytes, allocations)
+// The stages are measured by scoped timers which are placed by macros ACV_PROFILE_*.
+// The macros are removed at compile time if ACV_PROFILING is not defined, so the profiling costs nothing
+// in the usual build and the statistics stay empty.
+// The statistics are collected from all threads; the timeline of stages can be exported to Chrome trace JSON
+// Contains only static methods
+class Profiler
+{
+
+public: // Public auxiliary types
+
+    // Used clock
+    typedef std::chrono::steady_clock Clock;
+
+    // Aggregated timings of one stage
+    struct StageStats
+    {
+        std::string name; // Name of stage
+        long long calls; // Number of runs of stage
+        double totalMs; // Total time of stage
+        double minMs; // Minimum time of one run
+        double maxMs; // Maximum time of one run
+        long long bytes; // Number of bytes processed by all runs
+    };
+
+    // Aggregated values of one counter
+    struct CounterStats
+    {
+        std::string name; // Name of counter
+        long long events; // Number of updates of counter
+        long long total; // Sum of all values
+    };
+
+    // Timer which measures the stage from its creation to its destruction
+    class ScopedTimer
+    {
+
+    public: // Public methods
+
+        // Start the measurement of stage with specified name (the name should live until the end of program)
+        explicit ScopedTimer(const char* name, const long long bytes = 0)
+            : mName(name), mBytes(bytes), mStart(Clock::now()) { }
+
+        // Finish the measurement and add it to statistics
+        ~ScopedTimer() { AddStage(mName, mStart, Clock::now(), mBytes); }
+
+        // Timer can't be copied
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private: // Private members
+
+        const char* mName;
+        const long long mBytes;
+        const Clock::time_point mStart;
+
+    };
+
+public: // Public methods
+
+    // Check that the profiling was compiled in (ACV_PROFILING is defined for engine)
+    static bool IsEnabled();
+
+    // Add the measured run of stage
+    static void AddStage(const char* name, const Clock::time_point start, const Clock::time_point finish, const long long bytes = 0);
+
+    // Add the value to counter
+    static void AddCount(const char* name, const long long value);
+
+    // Get the statistics of stages (sorted by total time in descending order)
+    static std::vector<StageStats> GetStageStats();
+
+    // Get the statistics of counters (sorted by name)
+    static std::vector<CounterStats> GetCounterStats();
+
+    // Enable or disable the recording of timeline of stages (it is disabled by default)
+    static void SetTraceEnabled(const bool isEnabled);
+
+    // Check that the recording of timeline is enabled
+    static bool IsTraceEnabled();
+
+    // Write the recorded timeline to file in format of Chrome trace (chrome://tracing, Perfetto)
+    static bool WriteChromeTrace(const std::string& fileName);
+
+    // Clear all statistics and recorded timeline
+    static void Reset();
+
+private: // Private constants
+
+    // Maximum number of events of timeline (the later events are dropped to limit the memory)
+    static const size_t MAX_TRACE_EVENTS = 1 << 20;
+
+};
+
+}
+
+#ifdef ACV_PROFILING
+
+#define ACV_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ACV_PROFILE_CONCAT(a, b) ACV_PROFILE_CONCAT_IMPL(a, b)
+
+// Measure the rest of current scope as stage with specified name (string literal)
+#define ACV_PROFILE_SCOPE(name) acv::Profiler::ScopedTimer ACV_PROFILE_CONCAT(profileTimer, __LINE__)(name)
+
+// Measure the rest of current scope as stage which processes the specified number of bytes
+#define ACV_PROFILE_SCOPE_BYTES(name, bytes) acv::Profiler::ScopedTimer ACV_PROFILE_CONCAT(profileTimer, __LINE__)(name, bytes)
+
+// Add the value to counter with specified name (string literal)
+#define ACV_PROFILE_COUNT(name, value) acv::Profiler::AddCount(name, value)
+
+#else
+
+#define ACV_PROFILE_SCOPE(name) ((void)0)
+#define ACV_PROFILE_SCOPE_BYTES(name, bytes) ((void)0)
+#define ACV_PROFILE_COUNT(name, value) ((void)0)
+
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,105 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class of progress and cancellation of long operations
+
+#ifndef PROGRESS_H
+#define PROGRESS_H
+
+#include <atomic>
+#include <functional>
+
+namespace acv {
+
+// Class of context of long operation which is shared between the operation and its caller
+// The operation declares the amount of work and advances it at the granularity of row bands,
+// the caller observes the percent of done work and can cancel the operation from any thread.
+// Cancellation is cooperative: the operation stops at the next check and reports the cancelled result
+class Progress
+{
+
+public: // Public auxiliary types
+
+    // Callback about the change of percent of done work
+    // It is called from the thread which advanced the work, so it should be short and thread-safe
+    // (the percents which are reported by different threads can come out of order)
+    typedef std::function<void(const int percent)> Callback;
+
+public: // Public methods
+
+    // Default constructor of progress without callback
+    Progress();
+
+    // Set the callback about the change of percent (it should be set before the start of operation)
+    void SetCallback(const Callback& callback) { mCallback = callback; }
+
+    // Start the operation with specified amount of work (it is called by the operation)
+    // Cancellation which was requested before the start is kept
+    void Start(const int totalWork);
+
+    // Advance the done work (it is called by the operation from any thread)
+    // Returns false if the operation was cancelled and should be stopped
+    bool Advance(const int work = 1);
+
+    // Request the cancellation of operation (it can be called from any thread)
+    void Cancel() { mIsCancelled.store(true); }
+
+    // Check that the cancellation was requested
+    bool IsCancelled() const { return mIsCancelled.load(); }
+
+    // Get the percent of done work
+    int GetPercent() const { return mPercent.load(); }
+
+    // Prepare the progress for the next operation (reset the done work and the cancellation)
+    void Reset();
+
+    // Start the specified progress (the operations allow the null progress)
+    static void Begin(Progress* progress, const int totalWork) { if (progress) progress->Start(totalWork); }
+
+    // Advance the specified progress, returns false if the operation was cancelled (the null progress is allowed)
+    static bool Step(Progress* progress, const int work = 1) { return progress == nullptr || progress->Advance(work); }
+
+    // Check that the operation with specified progress was cancelled (the null progress is allowed)
+    static bool Cancelled(const Progress* progress) { return progress != nullptr && progress->IsCancelled(); }
+
+private: // Private members
+
+    // Callback about the change of percent
+    Callback mCallback;
+
+    // Total and done amount of work
+    std::atomic<int> mTotalWork;
+    std::atomic<int> mDoneWork;
+
+    // Last reported percent of done work
+    std::atomic<int> mPercent;
+
+    // Flag of requested cancellation
+    std::atomic<bool> mIsCancelled;
+
+};
+
+}
+
+#endif // PROGRESS_H
@@ -0,0 +1,187 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class of memory-mapped file of raw image
+
+#ifndef RAW_IMAGE_FILE_H
+#define RAW_IMAGE_FILE_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#include "Image.h"
+
+namespace acv {
+
+// Class of file which contains the raw one-channel image divided to square tiles
+// File consists of header and payload of tiles. The payload starts at aligned offset and each tile
+// is stored contiguously and aligned (tiles are placed row by row, edge tiles are padded).
+// The file is mapped to memory at opening, so the opening does not depend on the size of image
+// and the tiles are paged in by operating system only when they are accessed.
+// Therefore the images which are larger than memory can be processed by tiles or regions
+class RawImageFile
+{
+
+public: // Constants
+
+    enum
+    {
+        DEFAULT_TILE_SIZE = 256, // Default size of tile side in pixels
+        ALIGNMENT = 4096 // Alignment of payload and tiles in bytes
+    };
+
+public: // Auxiliary enums
+
+    // Modes of file opening
+    enum class OpenMode
+    {
+        READ, // Pixels can be only read
+        READ_WRITE // Pixels can be read and changed
+    };
+
+public: // Constructors
+
+    // Default constructor (file is not opened)
+    RawImageFile();
+
+    // Copying is forbidden because the object owns the mapping of file
+    RawImageFile(const RawImageFile&) = delete;
+    RawImageFile& operator = (const RawImageFile&) = delete;
+
+    // Destructor (file is closed)
+    virtual ~RawImageFile();
+
+public: // Public methods
+
+    // Create new file for image with specified dimensions (pixels are zero)
+    // Tile size should be positive, the size of file should not be larger than the address space
+    static bool Create(const std::string& fileName, const int height, const int width, const int tileSize = DEFAULT_TILE_SIZE);
+
+    // Create new file and write the image to it
+    static bool Save(const std::string& fileName, const Image& img, const int tileSize = DEFAULT_TILE_SIZE);
+
+    // Read the whole image from file
+    static bool Load(const std::string& fileName, Image& img);
+
+    // Open the file and map it to memory (only header is read)
+    // Returns false if the header is invalid or the size of file is larger than the address space
+    bool Open(const std::string& fileName, OpenMode mode = OpenMode::READ);
+
+    // Close the file (changed pixels are written to file)
+    void Close();
+
+    // Check the opening of file
+    bool IsOpened() const { return mData != nullptr; }
+
+    // Get the width of image
+    int GetWidth() const { return mWidth; }
+
+    // Get the height of image
+    int GetHeight() const { return mHeight; }
+
+    // Get the size of tile side
+    int GetTileSize() const { return mTileSize; }
+
+    // Get the number of tiles in row and in column
+    int GetNumTilesX() const { return mNumTilesX; }
+    int GetNumTilesY() const { return mNumTilesY; }
+
+    // Get the pointer to first pixel of tile (rows of tile are placed with stride GetTileSize())
+    // Pixels of tile are not read from disk until they are accessed
+    const Image::Byte* GetTilePointer(const int tileRow, const int tileCol) const;
+
+    // Get the pointer to first pixel of tile to change the pixels (file should be opened for writing)
+    Image::Byte* GetTilePointer(const int tileRow, const int tileCol);
+
+    // Read the region of image with left-top corner (x, y) to image (sizes of region are the sizes of image)
+    // The region should be inside the image
+    bool ReadRegion(const int x, const int y, Image& dstImg) const;
+
+    // Write the image to region with left-top corner (x, y), the region should be inside the image
+    bool WriteRegion(const int x, const int y, const Image& srcImg);
+
+    // Hint to operating system that the tiles of rows [tileRowBegin, tileRowEnd) will be needed soon
+    void PrefetchTileRows(const int tileRowBegin, const int tileRowEnd) const;
+
+    // Hint to operating system that the tiles of rows [tileRowBegin, tileRowEnd) are not needed
+    // The memory of not changed tiles can be released at once
+    void ReleaseTileRows(const int tileRowBegin, const int tileRowEnd) const;
+
+    // Hint to operating system that the tiles of rows [tileRowBegin, tileRowEnd)
+    // and columns [tileColBegin, tileColEnd) are not needed
+    void ReleaseTiles(const int tileRowBegin, const int tileRowEnd, const int tileColBegin, const int tileColEnd) const;
+
+    // Get the number of tile which contains the pixel coordinate
+    int GetTileIndex(const int coord) const { return coord / mTileSize; }
+
+private: // Private methods
+
+    // Get the offset of tile from beginning of payload
+    std::size_t GetTileOffset(const int tileRow, const int tileCol) const;
+
+    // Copy pixels between region of file and image (direction is set by flag)
+    void CopyRegion(const int x, const int y, const int width, const int height,
+                    Image::Byte* pImg, const bool toImage) const;
+
+    // Run the hint to operating system for the tiles of rows [tileRowBegin, tileRowEnd) and columns [tileColBegin, tileColEnd)
+    void AdviseTiles(const int tileRowBegin, const int tileRowEnd, const int tileColBegin, const int tileColEnd, const bool willNeed) const;
+
+private: // Private members
+
+    // Pointer to mapped memory (nullptr if the file is not opened)
+    Image::Byte* mData;
+
+    // Size of mapped memory
+    std::size_t mMappedSize;
+
+    // Offset of payload from beginning of file
+    std::size_t mPayloadOffset;
+
+    // Size of tile in file (with padding)
+    std::size_t mTileStride;
+
+    // Descriptor (handle) of file
+    std::intptr_t mFile;
+
+    // Handle of mapping object (is used only in Windows)
+    std::intptr_t mMapping;
+
+    // Mode of opened file
+    OpenMode mMode;
+
+    // Dimensions of image (value -1 if file is not opened)
+    int mWidth;
+    int mHeight;
+
+    // Parameters of tiles
+    int mTileSize;
+    int mNumTilesX;
+    int mNumTilesY;
+
+};
+
+}
+
+#endif // RAW_IMAGE_FILE_H
@@ -0,0 +1,115 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a table of vectorized kernels which is selected at runtime
+
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Image.h"
+#include "CpuFeatures.h"
+
+namespace acv {
+
+// Table of row kernels which are compiled for several instruction sets in one binary
+// (each variant is compiled with its own target of compiler, so no global compiler flags are needed).
+// The table of the best instruction set of processor is selected by cpuid, the scalar table is the reference
+// for verification of vectorized ones: all variants produce the same results
+class SimdKernels
+{
+
+public: // Public auxiliary types
+
+    typedef Image::Byte Byte;
+
+    // Convolution of count pixels with integer filter of size filterSize x filterSize (row-major)
+    // pSrc points to the top-left pixel of window of the first pixel, srcStride is the width of source image
+    // The sum is divided by divider (if it isn't zero) with truncation and clamped to the range of pixel
+    typedef void (*ConvolveRowFunc)(const Byte* pSrc, const int srcStride, const int* pFilter, const int filterSize,
+                                    const int divider, Byte* pDst, const int count);
+
+    // Horizontal Sobel operator: top[-1] + 2 * top[0] + top[1] - bottom[-1] - 2 * bottom[0] - bottom[1] (clamped)
+    typedef void (*SobelHRowFunc)(const Byte* pTop, const Byte* pBottom, Byte* pDst, const int count);
+
+    // Vertical Sobel operator: top[-1] - top[1] + 2 * (middle[-1] - middle[1]) + bottom[-1] - bottom[1] (clamped)
+    typedef void (*SobelVRowFunc)(const Byte* pTop, const Byte* pMiddle, const Byte* pBottom, Byte* pDst, const int count);
+
+    // Replacement of pixels by the look-up table of 256 values (source and destination can be the same)
+    typedef void (*ApplyLookUpTableFunc)(const Byte* pSrc, Byte* pDst, const size_t count, const Byte* pTable);
+
+    // Addition of row of pixels to row of sums
+    typedef void (*AccumulateRowFunc)(const Byte* pSrc, uint32_t* pSums, const int count);
+
+    // Threshold by level: pSrc[i] > pLevel[i] - threshold ? moreVal : lessVal (destination can be the same as level)
+    typedef void (*ThresholdRowFunc)(const Byte* pSrc, const Byte* pLevel, Byte* pDst, const size_t count,
+                                     const int threshold, const Byte moreVal, const Byte lessVal);
+
+    // Bilinear interpolation of four rows by weights in range [0, BLEND_WEIGHT_ONE]:
+    // top = topLeft * (ONE - weightX) + topRight * weightX, bottom is the same,
+    // result = (top * (ONE - weightY) + bottom * weightY) / ONE^2 (rounded)
+    typedef void (*BlendBilinearRowFunc)(const Byte* pTopLeft, const Byte* pTopRight, const Byte* pBottomLeft, const Byte* pBottomRight,
+                                         const Byte* pWeightsX, const int weightY, Byte* pDst, const int count);
+
+    // Unsharp masking: the difference pSrc[i] - pBlurred[i] is multiplied by amount (in units of UNSHARP_AMOUNT_ONE,
+    // the product is rounded down) and added to the source if its absolute value is not smaller than threshold (clamped)
+    // Amount should be in range [0, UNSHARP_AMOUNT_MAX], destination can be the same as source or blurred row
+    typedef void (*UnsharpMaskRowFunc)(const Byte* pSrc, const Byte* pBlurred, Byte* pDst, const int count,
+                                       const int amount, const int threshold);
+
+public: // Public constants
+
+    enum
+    {
+        BLEND_WEIGHT_ONE = 128, // Weight of interpolation which selects the right (bottom) value only
+        UNSHARP_AMOUNT_ONE = 256, // Amount of unsharp masking which adds the difference without scaling
+        UNSHARP_AMOUNT_MAX = 32767 // Maximal amount of unsharp masking (the amount is a 16-bit factor)
+    };
+
+public: // Public members
+
+    ConvolveRowFunc ConvolveRow;
+    SobelHRowFunc SobelHRow;
+    SobelVRowFunc SobelVRow;
+    ApplyLookUpTableFunc ApplyLookUpTable;
+    AccumulateRowFunc AccumulateRow;
+    ThresholdRowFunc ThresholdRow;
+    BlendBilinearRowFunc BlendBilinearRow;
+    UnsharpMaskRowFunc UnsharpMaskRow;
+
+public: // Public methods
+
+    // Get the table of kernels for instruction set which is used now (see CpuFeatures)
+    static const SimdKernels& Get();
+
+    // Get the table of kernels for specified instruction set (it should be supported by processor)
+    static const SimdKernels& Get(const CpuFeatures::InstructionSet set);
+
+};
+
+}
+
+#endif // SIMD_KERNELS_H
@@ -0,0 +1,85 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class of graph of dependent tasks
+
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include <vector>
+
+#include "TaskScheduler.h"
+
+namespace acv {
+
+// Class of graph of tasks with dependencies between them
+// The task is started by the scheduler after the finish of all its predecessors,
+// the independent tasks (stages of algorithm) are executed in parallel
+class TaskGraph
+{
+
+public: // Public methods
+
+    // Add the task to graph. Returns the identifier of task
+    int AddTask(const TaskScheduler::Task& task);
+
+    // Add the dependency: successor is started after the finish of predecessor
+    // Returns false if any identifier is incorrect
+    bool AddDependency(const int predecessor, const int successor);
+
+    // Execute all tasks of graph and wait for their finish (the calling thread takes part in execution)
+    // Returns false if the graph contains a cycle (the tasks are not executed in this case)
+    // If any task has thrown an exception, its successors are not started and the first exception is thrown
+    // after the finish of the started tasks. The graph can be executed many times
+    bool Run() const;
+
+    // Get the number of tasks of graph
+    int GetNumTasks() const;
+
+    // Remove all tasks of graph
+    void Clear();
+
+private: // Private auxiliary types
+
+    struct Node
+    {
+        TaskScheduler::Task task;
+        std::vector<int> successors;
+        int numPredecessors;
+    };
+
+private: // Private methods
+
+    // Check that graph doesn't contain cycles (Kahn's algorithm)
+    bool IsAcyclic() const;
+
+private: // Private members
+
+    std::vector<Node> mNodes;
+
+};
+
+}
+
+#endif // TASK_GRAPH_H
@@ -0,0 +1,107 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a scheduler of tasks with work stealing
+
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <mutex>
+
+namespace acv {
+
+// Class of scheduler of tasks over the shared pool of worker threads
+// Each worker has own deque of tasks: the worker takes the last spawned task (the hottest in cache),
+// the idle workers steal the first spawned tasks (the largest parts of recursively divided work).
+// The tasks spawned by the client threads are placed to the common queue, so the library can be called
+// from many client threads at once and the number of working threads is not increased.
+// Contains only static methods
+class TaskScheduler
+{
+
+public: // Public auxiliary types
+
+    typedef std::function<void()> Task;
+
+public: // Public methods
+
+    // Put the task to the deque of current worker (or to the common queue if it is called from the client thread)
+    static void Spawn(Task task);
+
+    // Run one of the waiting tasks. Returns false if there are no tasks
+    static bool RunOneTask();
+
+    // Run the waiting tasks until the number of pending tasks will be equal to zero
+    // If there are no tasks for the run, the thread sleeps until the new tasks or the zero of counter
+    static void WaitForZero(const std::atomic<int>& numPending);
+
+    // Wake up the threads waiting for the zero of counter
+    static void NotifyZero();
+
+    // Get the number of threads used to execute tasks (including the calling thread)
+    static int GetNumThreads();
+
+};
+
+// Class of group of tasks which are waited together (fork-join)
+// Group must be waited before destruction (the destructor waits for the tasks, but doesn't throw their exceptions)
+class TaskGroup
+{
+
+public: // Public methods
+
+    TaskGroup();
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    // Spawn the task of group
+    // It can be called from the tasks of this group
+    void Run(TaskScheduler::Task task);
+
+    // Wait for the finish of all tasks of group
+    // The waiting thread executes the tasks (of this or other groups) during the wait
+    // If any task has thrown an exception, the first exception is thrown after the finish of all tasks
+    void Wait();
+
+private: // Private members
+
+    // Number of spawned and not finished tasks
+    std::atomic<int> mNumPending;
+
+    // The first exception thrown by the tasks
+    std::exception_ptr mException;
+
+    // Mutex of exception
+    std::mutex mExceptionMutex;
+
+};
+
+}
+
+#endif // TASK_SCHEDULER_H
@@ -0,0 +1,139 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class to process the images which are larger than memory
+
+#ifndef TILED_PROCESSOR_H
+#define TILED_PROCESSOR_H
+
+#include <functional>
+
+#include "ImageFilter.h"
+#include "ImageCorrector.h"
+#include "BordersDetector.h"
+#include "MorphologyFilter.h"
+
+namespace acv {
+
+class RawImageFile;
+
+// Class is used to run the operations over raw image files tile by tile
+// Each tile is expanded by the halo of operation (within image boundaries), processed as separate image
+// and the central part is written to destination file. So the result is the same as for the whole image
+// if the operation uses only the pixels in halo. The size of tile is chosen by the memory limit and
+// the pages of processed tiles are released, so the peak memory does not depend on the image size.
+// The operations which aren't limited by a window give approximate results:
+// - IIR-filter (IIR Gaussian, bilateral and unsharp masking, adaptive threshold by mean with filter size from 6)
+//   depends on all pixels of row and column. The halo is ten sigma, so the difference from the whole image
+//   is at most one level of brightness at a small part of pixels (the rounding of decayed tail of filter);
+// - Canny detector traces the borders in the limits of CANNY_HALO only.
+// CLAHE and Retinex are not supported (Correct returns false)
+class TiledProcessor
+{
+
+public: // Public auxiliary types
+
+    // Operation which processes the expanded tile
+    typedef std::function<bool(const Image& srcImg, Image& dstImg)> TileOperation;
+
+public: // Constants
+
+    enum
+    {
+        DEFAULT_MEMORY_LIMIT_MB = 256, // Default limit of memory for processing of one tile
+        CANNY_HALO = 64 // Halo of Canny detector (tracing of borders is limited by this distance)
+    };
+
+public: // Constructors
+
+    // Constructor with limit of memory in megabytes
+    explicit TiledProcessor(const int memoryLimitMB = DEFAULT_MEMORY_LIMIT_MB);
+
+public: // Public methods
+
+    // Set the limit of memory in megabytes
+    void SetMemoryLimit(const int memoryLimitMB) { mMemoryLimitMB = memoryLimitMB; }
+
+    // Get the limit of memory in megabytes
+    int GetMemoryLimit() const { return mMemoryLimitMB; }
+
+    // Run the operation with specified halo (number of pixels around pixel which are used to calculate it)
+    // Files should have the same dimensions, destination file should be opened for writing
+    bool Process(const RawImageFile& srcFile, RawImageFile& dstFile, const TileOperation& operation, const int halo) const;
+
+    // Run a filtration by the specified method
+    // IIR Gaussian, bilateral and unsharp masking are approximated by the halo of ten sigma
+    FiltrationResult Filter(const RawImageFile& srcFile, RawImageFile& dstFile, ImageFilter::FilterType type, const int filterSize = -1) const;
+
+    // Run an adaptive threshold processing
+    // The level of large filter (from 6) is blurred by IIR-filter, it is approximated by the halo of ten sigma
+    bool AdaptiveThreshold(const RawImageFile& srcFile, RawImageFile& dstFile,
+                           const int filterSize, const int threshold, ImageFilter::ThresholdType thresholdType) const;
+
+    // Run an adaptive threshold processing by local statistics
+    bool AdaptiveThreshold(const RawImageFile& srcFile, RawImageFile& dstFile, const int filterSize, const float k,
+                           ImageFilter::ThresholdMethod method, ImageFilter::ThresholdType thresholdType) const;
+
+    // Detect the borders of image (the borders of Canny detector are traced in the limits of CANNY_HALO)
+    bool DetectBorders(const RawImageFile& srcFile, RawImageFile& dstFile, BordersDetector::DetectorType detectorType) const;
+
+    // Run a morphological operation
+    FiltrationResult Morphology(const RawImageFile& srcFile, RawImageFile& dstFile,
+                                MorphologyFilter::MorphologyType type, const int seWidth, const int seHeight) const;
+
+    // Correct image by the point corrector (the statistics of auto-levels are collected by the first pass over the file)
+    // Retinex is not supported because it needs the global average of reflectance,
+    // CLAHE is not supported because its tiles are defined by the sizes of the whole image
+    bool Correct(const RawImageFile& srcFile, RawImageFile& dstFile, ImageCorrector::CorrectorType corType) const;
+
+private: // Private methods
+
+    // Calculate the halo of operations with IIR-filter of specified size
+    static int CalcIIRHalo(const int filterSize);
+
+    // Calculate the size of tile side (without halo) for the memory limit
+    int CalcTileSize(const RawImageFile& dstFile, const int halo) const;
+
+    // Calculate the histogram of image in file
+    bool CalcHistogram(const RawImageFile& srcFile, std::vector<size_t>& histogram) const;
+
+private: // Private constants
+
+    enum
+    {
+        BYTES_PER_TILE_PIXEL = 16, // Estimation of memory for one pixel of expanded tile (images and temporary data of algorithms)
+        IIR_HALO_SIGMAS = 10, // Halo of IIR-filter in sigmas (the tail of filter beyond it changes the rounding of few pixels only)
+        MIN_IIR_HALO = 16 // Minimal halo of IIR-filter
+    };
+
+private: // Private members
+
+    // Limit of memory in megabytes
+    int mMemoryLimitMB;
+
+};
+
+}
+
+#endif // TILED_PROCESSOR_H
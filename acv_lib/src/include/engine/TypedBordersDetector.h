@@ -0,0 +1,58 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class to detect the borders of images with pixels of any supported type
+
+#ifndef TYPED_BORDERS_DETECTOR_H
+#define TYPED_BORDERS_DETECTOR_H
+
+#include "BordersDetector.h"
+#include "TypedImage.h"
+
+namespace acv {
+
+// This class is used to calculate the gradient modules of typed images (8-bit, 16-bit and float)
+// Unlike 8-bit detector the directional gradients are not clipped before calculation of module
+// The methods are instantiated for types Image::Byte, unsigned short and float
+// The class contains only static methods
+class TypedBordersDetector
+{
+
+public: // Public methods
+
+    // Calculate the module of gradient by Sobel or Scharr operators (Canny is not supported)
+    template <typename T>
+    static bool DetectBorders(const TypedImage<T>& srcImg, TypedImage<T>& dstImg, BordersDetector::DetectorType detectorType);
+
+private: // Private methods
+
+    // Calculate the module of gradient with operator which has weights (side, center, side)
+    template <typename T>
+    static void CalcGradientModules(const TypedImage<T>& srcImg, TypedImage<T>& dstImg, const float sideWeight, const float centerWeight);
+
+};
+
+}
+
+#endif // TYPED_BORDERS_DETECTOR_H
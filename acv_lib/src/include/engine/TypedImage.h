@@ -0,0 +1,205 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a template class of one-channel image with pixels of specified type
+
+#ifndef TYPED_IMAGE_H
+#define TYPED_IMAGE_H
+
+#include <vector>
+
+#include "Image.h"
+
+namespace acv {
+
+// Properties of pixel types of typed images
+// Supported types are Image::Byte (8 bits), unsigned short (16 bits) and float
+template <typename T>
+struct PixelTraits;
+
+template <>
+struct PixelTraits<Image::Byte>
+{
+    enum { IS_INTEGER = 1 };
+
+    static float MinValue() { return Image::MIN_PIXEL_VALUE; }
+    static float MaxValue() { return Image::MAX_PIXEL_VALUE; }
+
+    // Round the value and saturate it to the range of type
+    static Image::Byte Saturate(const float value)
+    {
+        return (value <= MinValue()) ? static_cast<Image::Byte>(Image::MIN_PIXEL_VALUE)
+                                     : (value >= MaxValue()) ? static_cast<Image::Byte>(Image::MAX_PIXEL_VALUE)
+                                                             : static_cast<Image::Byte>(value + 0.5f);
+    }
+};
+
+template <>
+struct PixelTraits<unsigned short>
+{
+    enum { IS_INTEGER = 1 };
+
+    static float MinValue() { return 0.0f; }
+    static float MaxValue() { return 65535.0f; }
+
+    // Round the value and saturate it to the range of type
+    static unsigned short Saturate(const float value)
+    {
+        return (value <= MinValue()) ? 0 : (value >= MaxValue()) ? 65535 : static_cast<unsigned short>(value + 0.5f);
+    }
+};
+
+// Float pixels have the nominal range of 8-bit brightness, so the results of algorithms are comparable
+// with 8-bit images, but the values are not rounded and can be out of the range between the stages
+template <>
+struct PixelTraits<float>
+{
+    enum { IS_INTEGER = 0 };
+
+    static float MinValue() { return Image::MIN_PIXEL_VALUE; }
+    static float MaxValue() { return Image::MAX_PIXEL_VALUE; }
+
+    // Float values are not saturated
+    static float Saturate(const float value) { return value; }
+};
+
+// Class of one-channel image with pixels of type T
+template <typename T>
+class TypedImage
+{
+
+public: // Auxiliary types
+
+    typedef T PixelType; // This type is used to representation of pixel brightness
+
+    typedef std::vector<T> Matrix; // This type is used to representation of pixels matrix
+
+public: // Constructors
+
+    // Default constructor
+    TypedImage()
+        : mPixels(), mWidth(-1), mHeight(-1)
+    { }
+
+    // Constructor of image with specified dimensions
+    TypedImage(const int height, const int width)
+        : mPixels(height * width), mWidth(width), mHeight(height)
+    { }
+
+public: // Public methods
+
+    // Get the width of image
+    int GetWidth() const { return mWidth; }
+
+    // Get the height of image
+    int GetHeight() const { return mHeight; }
+
+    // Get the pixel value by coordinates
+    T GetPixel(const int rowNum, const int colNum) const { return mPixels[mWidth * rowNum + colNum]; }
+
+    // Set the pixel value by coordinates
+    void SetPixel(const int rowNum, const int colNum, const T val) { mPixels[mWidth * rowNum + colNum] = val; }
+
+    // Get the reference to pixel by coordinates
+    T& operator()(const int rowNum, const int colNum) { return mPixels[mWidth * rowNum + colNum]; }
+    const T& operator()(const int rowNum, const int colNum) const { return mPixels[mWidth * rowNum + colNum]; }
+
+    // Get the reference to the pixels vector
+    Matrix& GetData() { return mPixels; }
+    const Matrix& GetData() const { return mPixels; }
+
+    // Get the raw pointer to i-th element of the pixels vector
+    T* GetRawPointer(const int elementNum = 0) { return &mPixels[elementNum]; }
+    const T* GetRawPointer(const int elementNum = 0) const { return &mPixels[elementNum]; }
+
+    // Check the initialization of image
+    bool IsInitialized() const { return (mWidth != -1 || mHeight != -1); }
+
+    // Check that images have the same dimensions
+    template <typename U>
+    bool HasSameSizes(const TypedImage<U>& other) const { return mWidth == other.GetWidth() && mHeight == other.GetHeight(); }
+
+    // Creation of typed image from 8-bit image (brightness is scaled to the range of type T)
+    static TypedImage FromImage(const Image& img)
+    {
+        TypedImage typedImg(img.GetHeight(), img.GetWidth());
+        ConvertPixels<Image::Byte>(img.GetData(), typedImg.mPixels);
+
+        return typedImg;
+    }
+
+    // Creation of typed image from image of other type (brightness is scaled to the range of type T)
+    template <typename U>
+    static TypedImage FromImage(const TypedImage<U>& img)
+    {
+        TypedImage typedImg(img.GetHeight(), img.GetWidth());
+        ConvertPixels<U>(img.GetData(), typedImg.mPixels);
+
+        return typedImg;
+    }
+
+    // Creation of 8-bit image (brightness is scaled, rounded and saturated)
+    Image ToImage() const
+    {
+        Image img(mHeight, mWidth);
+
+        const float scale = PixelTraits<Image::Byte>::MaxValue() / PixelTraits<T>::MaxValue();
+        auto dstIt = img.GetData().begin();
+        for (const T val : mPixels)
+            *dstIt++ = PixelTraits<Image::Byte>::Saturate(val * scale);
+
+        return img;
+    }
+
+private: // Private methods
+
+    // Scale the pixels of type U to the range of type T
+    template <typename U>
+    static void ConvertPixels(const std::vector<U>& src, Matrix& dst)
+    {
+        const float scale = PixelTraits<T>::MaxValue() / PixelTraits<U>::MaxValue();
+        auto dstIt = dst.begin();
+        for (const U val : src)
+            *dstIt++ = PixelTraits<T>::Saturate(val * scale);
+    }
+
+private: // Private members (representation of image)
+
+    // Matrix of pixels
+    Matrix mPixels;
+
+    // Image width (value -1 if image was not initialized)
+    int mWidth;
+
+    // Image height (value -1 if image was not initialized)
+    int mHeight;
+
+};
+
+typedef TypedImage<unsigned short> Image16; // Image with 16-bit pixels
+typedef TypedImage<float> ImageF; // Image with float pixels
+
+}
+
+#endif // TYPED_IMAGE_H
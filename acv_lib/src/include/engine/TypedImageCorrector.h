@@ -0,0 +1,74 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to define a class to correct of images with pixels of any supported type
+
+#ifndef TYPED_IMAGE_CORRECTOR_H
+#define TYPED_IMAGE_CORRECTOR_H
+
+#include "ImageCorrector.h"
+#include "TypedImage.h"
+
+namespace acv {
+
+// Class is used to correct typed images (8-bit, 16-bit and float) by the same methods as 8-bit images
+// The calculations are done in float, the result is rounded only once at the end of correction
+// The methods are instantiated for types Image::Byte, unsigned short and float
+// Class contains only static methods
+class TypedImageCorrector
+{
+
+public: // Public methods
+
+    // Correct image using a special method
+    template <typename T>
+    static bool Correct(const TypedImage<T>& srcImg, TypedImage<T>& dstImg, ImageCorrector::CorrectorType corType);
+
+private: // Private methods
+
+    // SSR algorithm (the blurred image is not rounded)
+    template <typename T>
+    static bool SingleScaleRetinex(const TypedImage<T>& srcImg, TypedImage<T>& dstImg);
+
+    // Auto-levels algorithm
+    template <typename T>
+    static bool AutoLevels(const TypedImage<T>& srcImg, TypedImage<T>& dstImg);
+
+    // Algorithm of auto-levels with pixels correction in three sigma range
+    template <typename T>
+    static bool NormAutoLevels(const TypedImage<T>& srcImg, TypedImage<T>& dstImg);
+
+    // Gamma-correction
+    template <typename T>
+    static bool GammaCorrection(const TypedImage<T>& srcImg, TypedImage<T>& dstImg);
+
+    // The method is used to expand the specified range of brightness to all range
+    template <typename T>
+    static void ExpandBrightnessRange(const TypedImage<T>& srcImg, const float minBr, const float maxBr, TypedImage<T>& dstImg);
+
+};
+
+}
+
+#endif // TYPED_IMAGE_CORRECTOR_H
@@ -0,0 +1,65 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header is used to define a class that filters images with pixels of any supported type
+
+#ifndef TYPED_IMAGE_FILTER_H
+#define TYPED_IMAGE_FILTER_H
+
+#include "ImageFilter.h"
+#include "TypedImage.h"
+
+namespace acv {
+
+// Class is used to filter typed images (8-bit, 16-bit and float)
+// The calculations are done in float, the result is rounded only once at the end of filtration
+// The methods are instantiated for types Image::Byte, unsigned short and float
+// Class contains only static methods
+class TypedImageFilter
+{
+
+public: // Public methods
+
+    // Gaussian imitation by IIR-filter (all four passes are done without intermediate rounding)
+    // Source image WILL BE CHANGED!!!
+    template <typename T>
+    static FiltrationResult GaussianIIR(TypedImage<T>& img, const float sigma);
+
+    // Gaussian imitation by IIR-filter (all four passes are done without intermediate rounding)
+    template <typename T>
+    static FiltrationResult GaussianIIR(const TypedImage<T>& srcImg, TypedImage<T>& dstImg, const float sigma);
+
+    // Separate Gaussian filtration (filter size must be positive and odd, the borders are mirrored and clamped,
+    // so the images which are smaller than filter are processed too)
+    template <typename T>
+    static FiltrationResult SeparateGaussian(const TypedImage<T>& srcImg, TypedImage<T>& dstImg, const int filterSize);
+
+    // Run the IIR-filter over the buffer of float values (sizes of buffer are width x height)
+    static void GaussianIIR(std::vector<float>& buf, const int width, const int height, const float sigma);
+
+};
+
+}
+
+#endif // TYPED_IMAGE_FILTER_H
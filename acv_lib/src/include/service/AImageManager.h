@@ -30,8 +30,12 @@
 #include <memory>
 
 class AImage;
+class AMultiChannelImage;
+class ABinaryImage;
 namespace acv {
     class Image;
+    class MultiChannelImage;
+    class BinaryImage;
 }
 
 // Class of manager to access of image details
@@ -43,8 +47,33 @@ public:
     // Get inner representation of class AImage
     static const std::shared_ptr<acv::Image>& GetEngineImage(const AImage& image);
 
+    // Get inner representation of class AImage to change the pixels
+    // The pixels are copied if they are shared with other images
+    static const std::shared_ptr<acv::Image>& GetMutableEngineImage(AImage& image);
+
+    // Get inner representation of class AImage which will be completely overwritten
+    // If the pixels are shared with other images then the new image of same sizes is created (the pixels are not copied)
+    // The caller should hold the source image by own copy of pointer, then the source and destination
+    // are separated even if they are the same image
+    static const std::shared_ptr<acv::Image>& GetDestinationEngineImage(AImage& image);
+
+    // Get inner representation of class AMultiChannelImage
+    static const std::shared_ptr<acv::MultiChannelImage>& GetEngineImage(const AMultiChannelImage& image);
+
+    // Get inner representation of class AMultiChannelImage which will be completely overwritten
+    // If the pixels are shared with other images then the new image of same format is created (the pixels are not copied)
+    static const std::shared_ptr<acv::MultiChannelImage>& GetDestinationEngineImage(AMultiChannelImage& image);
+
+    // Get inner representation of class ABinaryImage
+    static const std::shared_ptr<acv::BinaryImage>& GetEngineImage(const ABinaryImage& image);
+
+    // Get inner representation of class ABinaryImage which will be completely overwritten
+    // If the pixels are shared with other images then the new image of same sizes is created (the pixels are not copied)
+    static const std::shared_ptr<acv::BinaryImage>& GetDestinationEngineImage(ABinaryImage& image);
+
     // Make image of service type from engine image
     static AImage MakeServiceImage(const acv::Image& img);
+    static AImage MakeServiceImage(acv::Image&& img);
 
 };
 
@@ -28,8 +28,10 @@
 #define AIMAGE_UTILS_H
 
 class AImage;
+enum class AFiltrationResult;
 namespace acv {
 class Image;
+enum class FiltrationResult;
 }
 
 namespace AImageUtils {
@@ -37,6 +39,8 @@ namespace AImageUtils {
 bool ImagesHaveSameSizes(const AImage& lhs, const AImage& rhs);
 bool ImagesHaveSameSizes(const acv::Image& lhs, const acv::Image& rhs);
 
+AFiltrationResult ConvertToAFiltrationResult(acv::FiltrationResult res);
+
 }
 
 #endif // AIMAGEUTILS_H
@@ -0,0 +1,63 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This header file is used to declare the functions to convert the types from service level to engine level
+// The functions are implemented in files of corresponding wrappers
+
+#ifndef ATYPES_CONVERTER_H
+#define ATYPES_CONVERTER_H
+
+#include "AImage.h"
+#include "AImageFilter.h"
+#include "AImageCorrector.h"
+#include "ABordersDetector.h"
+#include "AMorphologyFilter.h"
+#include "AProgress.h"
+
+#include "Image.h"
+#include "ImageFilter.h"
+#include "ImageCorrector.h"
+#include "BordersDetector.h"
+#include "MorphologyFilter.h"
+#include "Progress.h"
+
+acv::Image::ScaleType ConvertToEngineScaleType(AScaleType scaleType);
+
+acv::ImageFilter::FilterType ConvertToEngineFilterType(AFilterType type);
+
+acv::ImageFilter::ThresholdType ConvertToEngineThresholdType(AThresholdType thresholdType);
+
+acv::ImageFilter::ThresholdMethod ConvertToEngineThresholdMethod(AThresholdMethod method);
+
+acv::ImageCorrector::CorrectorType ConvertToEngineCorrectorType(ACorrectorType corType);
+
+acv::BordersDetector::DetectorType ConvertToEngineDetectorType(ADetectorType detectorType);
+
+acv::BordersDetector::OperatorType ConvertToEngineOperatorType(AOperatorType operatorType);
+
+acv::MorphologyFilter::MorphologyType ConvertToEngineMorphologyType(AMorphologyType type);
+
+acv::Progress* ConvertToEngineProgress(AProgress* progress);
+
+#endif // ATYPES_CONVERTER_H
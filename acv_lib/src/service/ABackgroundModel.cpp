@@ -0,0 +1,113 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class ABackgroundModel
+
+#include <cassert>
+
+#include "ABackgroundModel.h"
+#include "BackgroundModel.h"
+#include "AImageManager.h"
+#include "AImageUtils.h"
+#include "AImage.h"
+#include "ABinaryImage.h"
+#include "BinaryImage.h"
+
+static acv::BackgroundModel::ModelType ConvertToEngineModelType(ABackgroundModelType type)
+{
+    switch (type)
+    {
+    case ABackgroundModelType::RUNNING_AVERAGE:
+        return acv::BackgroundModel::ModelType::RUNNING_AVERAGE;
+    case ABackgroundModelType::GAUSSIAN:
+        return acv::BackgroundModel::ModelType::GAUSSIAN;
+    case ABackgroundModelType::MEDIAN:
+        return acv::BackgroundModel::ModelType::MEDIAN;
+    }
+
+    assert(false);
+    return acv::BackgroundModel::ModelType::RUNNING_AVERAGE;
+}
+
+ABackgroundModel::ABackgroundModel()
+    : mModel(std::make_shared<acv::BackgroundModel>())
+{
+}
+
+bool ABackgroundModel::Configure(int height, int width, ABackgroundModelType type, float learningRate, float threshold)
+{
+    return mModel->Configure(height, width, ConvertToEngineModelType(type), learningRate, threshold);
+}
+
+bool ABackgroundModel::IsConfigured() const
+{
+    return mModel->IsConfigured();
+}
+
+bool ABackgroundModel::Apply(const AImage& frame, AImage& foregroundMask)
+{
+    bool ret = AImageUtils::ImagesHaveSameSizes(frame, foregroundMask);
+
+    if (ret)
+    {
+        const auto& framePtr = AImageManager::GetEngineImage(frame);
+        auto& maskPtr = AImageManager::GetDestinationEngineImage(foregroundMask);
+
+        ret = framePtr != nullptr && maskPtr != nullptr;
+        ret = ret && mModel->Apply(*framePtr, *maskPtr);
+    }
+
+    return ret;
+}
+
+bool ABackgroundModel::Apply(const AImage& frame, ABinaryImage& foregroundMask)
+{
+    const auto& framePtr = AImageManager::GetEngineImage(frame);
+    auto& maskPtr = AImageManager::GetDestinationEngineImage(foregroundMask);
+
+    return framePtr != nullptr && maskPtr != nullptr && mModel->Apply(*framePtr, *maskPtr);
+}
+
+bool ABackgroundModel::GetBackground(AImage& backgroundImg) const
+{
+    bool ret = backgroundImg.IsInitialized();
+
+    if (ret)
+    {
+        auto& imgPtr = AImageManager::GetDestinationEngineImage(backgroundImg);
+        ret = imgPtr != nullptr && mModel->GetBackground(*imgPtr);
+    }
+
+    return ret;
+}
+
+void ABackgroundModel::Reset()
+{
+    mModel->Reset();
+}
+
+int ABackgroundModel::GetNumFrames() const
+{
+    return mModel->GetNumFrames();
+}
@@ -0,0 +1,134 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class ABinaryImage
+
+#include "ABinaryImage.h"
+#include "BinaryImage.h"
+#include "LabelImage.h"
+#include "AImageManager.h"
+
+ABinaryImage::ABinaryImage(int height, int width)
+    : mImage(nullptr)
+{
+    if (height > 0 && width > 0)
+        mImage = std::make_shared<acv::BinaryImage>(height, width);
+}
+
+ABinaryImage::ABinaryImage(const AImage& img)
+    : mImage(nullptr)
+{
+    const auto& imgPtr = AImageManager::GetEngineImage(img);
+
+    if (imgPtr && imgPtr->IsInitialized())
+        mImage = std::make_shared<acv::BinaryImage>(*imgPtr);
+}
+
+int ABinaryImage::GetWidth() const
+{
+    return (mImage) ? mImage->GetWidth() : -1;
+}
+
+int ABinaryImage::GetHeight() const
+{
+    return (mImage) ? mImage->GetHeight() : -1;
+}
+
+bool ABinaryImage::IsInitialized() const
+{
+    return (mImage && mImage->IsInitialized());
+}
+
+bool ABinaryImage::GetPixel(int row, int col) const
+{
+    return mImage->GetPixel(row, col);
+}
+
+void ABinaryImage::SetPixel(int row, int col, bool val)
+{
+    Detach();
+    mImage->SetPixel(row, col, val);
+}
+
+size_t ABinaryImage::CountPixels() const
+{
+    return IsInitialized() ? mImage->CountPixels() : 0;
+}
+
+int ABinaryImage::CountConnectedComponents() const
+{
+    acv::LabelImage labels;
+    return (IsInitialized() && acv::LabelImage::LabelConnectedComponents(*mImage, labels)) ? labels.GetNumLabels() : -1;
+}
+
+AImage ABinaryImage::ConvertToImage() const
+{
+    if (!IsInitialized())
+        return AImage(-1, -1);
+
+    acv::Image img(mImage->GetHeight(), mImage->GetWidth());
+    mImage->ConvertToImage(img);
+
+    return AImageManager::MakeServiceImage(std::move(img));
+}
+
+// Run the logical operation of engine level for wrappers of images
+template <typename Operation>
+static bool CombineImages(const ABinaryImage& lhs, const ABinaryImage& rhs, ABinaryImage& dstImg, const Operation& op)
+{
+    const auto lhsPtr = AImageManager::GetEngineImage(lhs);
+    const auto rhsPtr = AImageManager::GetEngineImage(rhs);
+    auto& dstPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+    return lhsPtr != nullptr && rhsPtr != nullptr && dstPtr != nullptr && op(*lhsPtr, *rhsPtr, *dstPtr);
+}
+
+bool ABinaryImage::And(const ABinaryImage& lhs, const ABinaryImage& rhs, ABinaryImage& dstImg)
+{
+    return CombineImages(lhs, rhs, dstImg, acv::BinaryImage::And);
+}
+
+bool ABinaryImage::Or(const ABinaryImage& lhs, const ABinaryImage& rhs, ABinaryImage& dstImg)
+{
+    return CombineImages(lhs, rhs, dstImg, acv::BinaryImage::Or);
+}
+
+bool ABinaryImage::Xor(const ABinaryImage& lhs, const ABinaryImage& rhs, ABinaryImage& dstImg)
+{
+    return CombineImages(lhs, rhs, dstImg, acv::BinaryImage::Xor);
+}
+
+bool ABinaryImage::Invert(const ABinaryImage& srcImg, ABinaryImage& dstImg)
+{
+    const auto srcPtr = AImageManager::GetEngineImage(srcImg);
+    auto& dstPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+    return srcPtr != nullptr && dstPtr != nullptr && acv::BinaryImage::Invert(*srcPtr, *dstPtr);
+}
+
+void ABinaryImage::Detach()
+{
+    if (mImage && mImage.use_count() > 1)
+        mImage = std::make_shared<acv::BinaryImage>(*mImage);
+}
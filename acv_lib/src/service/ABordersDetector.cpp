@@ -28,7 +28,10 @@
 #include "BordersDetector.h"
 #include "AImageManager.h"
 #include "AImageUtils.h"
+#include "ATypesConverter.h"
 #include "AImage.h"
+#include "ABinaryImage.h"
+#include "BinaryImage.h"
 
 #include <cassert>
 
@@ -42,28 +45,45 @@ acv::BordersDetector::DetectorType ConvertToEngineDetectorType(ADetectorType det
         return acv::BordersDetector::DetectorType::SCHARR;
     case ADetectorType::SOBEL:
         return acv::BordersDetector::DetectorType::SOBEL;
+    case ADetectorType::CANNY_BILATERAL:
+        return acv::BordersDetector::DetectorType::CANNY_BILATERAL;
     }
 
     assert(false);
     return acv::BordersDetector::DetectorType::CANNY;
 }
 
-bool ABordersDetector::DetectBorders(const AImage& srcImg, AImage& dstImg, ADetectorType detectorType)
+bool ABordersDetector::DetectBorders(const AImage& srcImg, AImage& dstImg, ADetectorType detectorType, AProgress* progress)
 {
     bool ret = AImageUtils::ImagesHaveSameSizes(srcImg, dstImg);
 
     if (ret)
     {
-        const auto& srcImgPtr = AImageManager::GetEngineImage(srcImg);
-        auto& dstImgPtr = AImageManager::GetEngineImage(dstImg);
+        const auto srcImgPtr = AImageManager::GetEngineImage(srcImg);
+        auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
 
         ret = ret && srcImgPtr != nullptr && dstImgPtr != nullptr;
-        ret = ret && acv::BordersDetector::DetectBorders(*srcImgPtr, *dstImgPtr, ConvertToEngineDetectorType(detectorType));
+        ret = ret && acv::BordersDetector::DetectBorders(*srcImgPtr, *dstImgPtr, ConvertToEngineDetectorType(detectorType),
+                                                         acv::BordersDetector::DEFAULT_MIN_THRESHOLD,
+                                                         acv::BordersDetector::DEFAULT_MAX_THRESHOLD,
+                                                         ConvertToEngineProgress(progress));
     }
 
     return ret;
 }
 
+bool ABordersDetector::DetectBorders(const AImage& srcImg, ABinaryImage& dstImg, ADetectorType detectorType, AProgress* progress)
+{
+    const auto& srcImgPtr = AImageManager::GetEngineImage(srcImg);
+    auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+    return srcImgPtr != nullptr && dstImgPtr != nullptr &&
+           acv::BordersDetector::DetectBorders(*srcImgPtr, *dstImgPtr, ConvertToEngineDetectorType(detectorType),
+                                               acv::BordersDetector::DEFAULT_MIN_THRESHOLD,
+                                               acv::BordersDetector::DEFAULT_MAX_THRESHOLD,
+                                               ConvertToEngineProgress(progress));
+}
+
 acv::BordersDetector::OperatorType ConvertToEngineOperatorType(AOperatorType operatorType)
 {
     switch (operatorType)
@@ -84,8 +104,8 @@ bool ABordersDetector::OperatorConvolution(const AImage& srcImg, AImage& dstImg,
 
     if (ret)
     {
-        const auto& srcImgPtr = AImageManager::GetEngineImage(srcImg);
-        auto& dstImgPtr = AImageManager::GetEngineImage(dstImg);
+        const auto srcImgPtr = AImageManager::GetEngineImage(srcImg);
+        auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
 
         ret = ret && srcImgPtr != nullptr && dstImgPtr != nullptr;
         ret = ret && acv::BordersDetector::OperatorConvolution(*srcImgPtr, *dstImgPtr,
@@ -95,3 +115,39 @@ bool ABordersDetector::OperatorConvolution(const AImage& srcImg, AImage& dstImg,
 
     return ret;
 }
+
+bool ABordersDetector::DetectBorders(AImage&& srcImg, AImage& dstImg, ADetectorType detectorType, AProgress* progress)
+{
+    bool ret = srcImg.IsInitialized();
+
+    if (ret)
+    {
+        const auto& imgPtr = AImageManager::GetMutableEngineImage(srcImg);
+
+        ret = acv::BordersDetector::DetectBorders(*imgPtr, ConvertToEngineDetectorType(detectorType),
+                                                  acv::BordersDetector::DEFAULT_MIN_THRESHOLD,
+                                                  acv::BordersDetector::DEFAULT_MAX_THRESHOLD,
+                                                  ConvertToEngineProgress(progress));
+        if (ret)
+            dstImg = std::move(srcImg);
+    }
+
+    return ret;
+}
+
+bool ABordersDetector::OperatorConvolution(AImage&& srcImg, AImage& dstImg, ADetectorType detectorType, AOperatorType operatorType)
+{
+    bool ret = srcImg.IsInitialized();
+
+    if (ret)
+    {
+        const auto& imgPtr = AImageManager::GetMutableEngineImage(srcImg);
+
+        ret = acv::BordersDetector::OperatorConvolution(*imgPtr, ConvertToEngineDetectorType(detectorType),
+                                                        ConvertToEngineOperatorType(operatorType));
+        if (ret)
+            dstImg = std::move(srcImg);
+    }
+
+    return ret;
+}
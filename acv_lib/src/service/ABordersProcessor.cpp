@@ -0,0 +1,76 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class ABordersProcessor
+
+#include "ABordersProcessor.h"
+#include "BordersProcessor.h"
+#include "AImageManager.h"
+#include "AImageUtils.h"
+#include "ATypesConverter.h"
+#include "AImage.h"
+
+ABordersProcessor::ABordersProcessor()
+    : mProcessor(std::make_shared<acv::BordersProcessor>())
+{
+}
+
+bool ABordersProcessor::Configure(int height, int width, ADetectorType detectorType)
+{
+    return mProcessor->Configure(height, width, ConvertToEngineDetectorType(detectorType));
+}
+
+bool ABordersProcessor::IsConfigured() const
+{
+    return mProcessor->IsConfigured();
+}
+
+bool ABordersProcessor::Process(const AImage& srcImg, AImage& dstImg)
+{
+    bool ret = AImageUtils::ImagesHaveSameSizes(srcImg, dstImg);
+
+    if (ret)
+    {
+        const auto& srcImgPtr = AImageManager::GetEngineImage(srcImg);
+        auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+        ret = srcImgPtr != nullptr && dstImgPtr != nullptr;
+        ret = ret && mProcessor->Process(*srcImgPtr, *dstImgPtr);
+    }
+
+    return ret;
+}
+
+bool ABordersProcessor::Process(AImage& img)
+{
+    bool ret = img.IsInitialized();
+
+    if (ret)
+    {
+        const auto& imgPtr = AImageManager::GetMutableEngineImage(img);
+        ret = mProcessor->Process(*imgPtr);
+    }
+
+    return ret;
+}
@@ -0,0 +1,77 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class AFilterProcessor
+
+#include "AFilterProcessor.h"
+#include "FilterProcessor.h"
+#include "AImageManager.h"
+#include "AImageUtils.h"
+#include "ATypesConverter.h"
+#include "AImage.h"
+
+AFilterProcessor::AFilterProcessor()
+    : mProcessor(std::make_shared<acv::FilterProcessor>())
+{
+}
+
+AFiltrationResult AFilterProcessor::Configure(int height, int width, AFilterType type, int filterSize/* = -1*/)
+{
+    acv::FiltrationResult engRes = mProcessor->Configure(height, width, ConvertToEngineFilterType(type), filterSize);
+    return AImageUtils::ConvertToAFiltrationResult(engRes);
+}
+
+bool AFilterProcessor::IsConfigured() const
+{
+    return mProcessor->IsConfigured();
+}
+
+AFiltrationResult AFilterProcessor::Process(const AImage& srcImg, AImage& dstImg)
+{
+    AFiltrationResult ret = AFiltrationResult::INTERNAL_ERROR;
+
+    if (AImageUtils::ImagesHaveSameSizes(srcImg, dstImg))
+    {
+        const auto& srcImgPtr = AImageManager::GetEngineImage(srcImg);
+        auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+        if (srcImgPtr && dstImgPtr)
+            ret = AImageUtils::ConvertToAFiltrationResult(mProcessor->Process(*srcImgPtr, *dstImgPtr));
+    }
+
+    return ret;
+}
+
+AFiltrationResult AFilterProcessor::Process(AImage& img)
+{
+    AFiltrationResult ret = AFiltrationResult::INTERNAL_ERROR;
+
+    if (img.IsInitialized())
+    {
+        const auto& imgPtr = AImageManager::GetMutableEngineImage(img);
+        ret = AImageUtils::ConvertToAFiltrationResult(mProcessor->Process(*imgPtr));
+    }
+
+    return ret;
+}
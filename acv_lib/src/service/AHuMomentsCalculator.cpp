@@ -24,8 +24,13 @@
 
 // This file contains implementations of methods for class HuMomentsCalculator
 
+#include <cassert>
+
 #include "AHuMomentsCalculator.h"
 #include "HuMomentsCalculator.h"
+#include "MomentsCalculator.h"
+#include "LabelImage.h"
+#include "Image.h"
 #include "AImageManager.h"
 #include "AImage.h"
 
@@ -39,10 +44,79 @@ AHuMomentsCalculator::AHuMomentsCalculator(const AImage& img, int xStart, int yS
 
 bool AHuMomentsCalculator::GetHuMoments(AHuMoments& moments) const
 {
-    bool ret = mHuMomentsCalculator != nullptr;
+    bool ret = mHuMomentsCalculator != nullptr && mHuMomentsCalculator->IsCalculated();
 
     if (ret)
         moments = mHuMomentsCalculator->GetHuMoments();
 
     return ret;
 }
+
+static acv::MomentsCalculator::WeightType ConvertToEngineWeightType(AMomentsWeightType weightType)
+{
+    switch (weightType)
+    {
+    case AMomentsWeightType::BINARY:
+        return acv::MomentsCalculator::WeightType::BINARY;
+    case AMomentsWeightType::INTENSITY:
+        return acv::MomentsCalculator::WeightType::INTENSITY;
+    default:
+        assert(false);
+        return acv::MomentsCalculator::WeightType::BINARY;
+    }
+}
+
+bool AHuMomentsCalculator::CalcHuMoments(const AImage& img, const std::vector<ARoi>& rois, std::vector<AHuMoments>& moments,
+                                         AMomentsWeightType weightType/* = AMomentsWeightType::BINARY*/)
+{
+    const auto& srcImg = AImageManager::GetEngineImage(img);
+    if (!srcImg)
+        return false;
+
+    std::vector<acv::MomentsCalculator::Roi> engineRois;
+    engineRois.reserve(rois.size());
+    for (const auto& roi : rois)
+        engineRois.push_back({ roi.xStart, roi.yStart, roi.xEnd, roi.yEnd });
+
+    return acv::MomentsCalculator::CalcHuMoments(*srcImg, engineRois, moments, ConvertToEngineWeightType(weightType));
+}
+
+bool AHuMomentsCalculator::CalcDenseHuMoments(const AImage& img, int winWidth, int winHeight, std::vector<AHuMoments>& moments,
+                                              AMomentsWeightType weightType/* = AMomentsWeightType::BINARY*/)
+{
+    const auto& srcImg = AImageManager::GetEngineImage(img);
+    if (!srcImg)
+        return false;
+
+    return acv::MomentsCalculator::CalcDenseHuMoments(*srcImg, winWidth, winHeight, moments, ConvertToEngineWeightType(weightType));
+}
+
+bool AHuMomentsCalculator::CalcHuMoments(const AImage& img, const std::vector<int>& labels, int numLabels,
+                                         std::vector<AHuMoments>& moments, AMomentsWeightType weightType/* = AMomentsWeightType::BINARY*/)
+{
+    const auto& srcImg = AImageManager::GetEngineImage(img);
+    if (!srcImg || numLabels < 0 || labels.size() != static_cast<size_t>(srcImg->GetWidth()) * srcImg->GetHeight())
+        return false;
+
+    acv::LabelImage labelImg(srcImg->GetHeight(), srcImg->GetWidth());
+    labelImg.GetData() = labels;
+    labelImg.SetNumLabels(numLabels);
+
+    return acv::MomentsCalculator::CalcHuMoments(*srcImg, labelImg, moments, ConvertToEngineWeightType(weightType));
+}
+
+bool AHuMomentsCalculator::LabelConnectedComponents(const AImage& img, std::vector<int>& labels, int& numLabels)
+{
+    const auto& srcImg = AImageManager::GetEngineImage(img);
+    if (!srcImg)
+        return false;
+
+    acv::LabelImage labelImg;
+    if (!acv::LabelImage::LabelConnectedComponents(*srcImg, labelImg))
+        return false;
+
+    labels.swap(labelImg.GetData());
+    numLabels = labelImg.GetNumLabels();
+
+    return true;
+}
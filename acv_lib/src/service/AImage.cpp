@@ -26,16 +26,43 @@
 
 #include "AImage.h"
 #include "Image.h"
+#include "PixelConverter.h"
+#include "AImageManager.h"
+#include "ATypesConverter.h"
 
 #include <cassert>
 
 AImage::AImage(int height, int width)
-    : mImage(nullptr)
+    : mImage(nullptr),
+      mIsRawAccessed(false)
 {
     if (height > 0 && width > 0)
         mImage = std::make_shared<acv::Image>(height, width);
 }
 
+AImage::AImage(const AImage& other)
+    : mImage(other.mImage),
+      mIsRawAccessed(false)
+{
+    if (other.mIsRawAccessed && mImage)
+        mImage = std::make_shared<acv::Image>(*other.mImage);
+}
+
+AImage& AImage::operator = (const AImage& other)
+{
+    if (this != &other)
+    {
+        if (other.mIsRawAccessed && other.mImage)
+            mImage = std::make_shared<acv::Image>(*other.mImage);
+        else
+            mImage = other.mImage;
+
+        mIsRawAccessed = false;
+    }
+
+    return *this;
+}
+
 int AImage::GetWidth() const
 {
     return (mImage) ? mImage->GetWidth() : -1;
@@ -53,9 +80,68 @@ AByte AImage::GetPixel(int row, int col) const
 
 void AImage::SetPixel(int row, int col, AByte val)
 {
+    Detach();
     mImage->SetPixel(row, col, val);
 }
 
+const AByte* AImage::GetRowPointer(int row) const
+{
+    return mImage->GetRawPointer(row * mImage->GetWidth());
+}
+
+AByte* AImage::GetRowPointer(int row)
+{
+    Detach();
+    mIsRawAccessed = true;
+    return mImage->GetRawPointer(row * mImage->GetWidth());
+}
+
+static acv::PixelConverter::PixelFormat ConvertToEnginePixelFormat(APixelFormat format)
+{
+    switch (format)
+    {
+    case APixelFormat::GRAY8:
+        return acv::PixelConverter::PixelFormat::GRAY8;
+    case APixelFormat::RGB888:
+        return acv::PixelConverter::PixelFormat::RGB888;
+    case APixelFormat::BGR888:
+        return acv::PixelConverter::PixelFormat::BGR888;
+    case APixelFormat::RGBA8888:
+        return acv::PixelConverter::PixelFormat::RGBA8888;
+    case APixelFormat::BGRA8888:
+        return acv::PixelConverter::PixelFormat::BGRA8888;
+    case APixelFormat::ARGB8888:
+        return acv::PixelConverter::PixelFormat::ARGB8888;
+    }
+
+    assert(false);
+    return acv::PixelConverter::PixelFormat::GRAY8;
+}
+
+bool AImage::Import(const void* buf, int bytesPerLine, APixelFormat format)
+{
+    if (!IsInitialized())
+        return false;
+
+    const auto& imgPtr = AImageManager::GetDestinationEngineImage(*this);
+
+    return acv::PixelConverter::Import(buf, bytesPerLine, ConvertToEnginePixelFormat(format), *imgPtr);
+}
+
+bool AImage::Export(void* buf, int bytesPerLine, APixelFormat format) const
+{
+    if (!IsInitialized())
+        return false;
+
+    return acv::PixelConverter::Export(*mImage, buf, bytesPerLine, ConvertToEnginePixelFormat(format));
+}
+
+void AImage::Detach()
+{
+    if (mImage && mImage.use_count() > 1)
+        mImage = std::make_shared<acv::Image>(*mImage);
+}
+
 bool AImage::IsInitialized() const
 {
     return (mImage && mImage->IsInitialized());
@@ -86,9 +172,9 @@ AImage AImage::Scale(short kScaleX, short kScaleY, AScaleType scaleType) const
         AImage retImg(-1, -1);
 
         if (mImage && kScaleX > 1 && kScaleY > 1)
-            retImg.mImage = std::make_shared<acv::Image>(std::move(mImage->Scale(kScaleX, kScaleY, ConvertToEngineScaleType(scaleType))));
+            retImg.mImage = std::make_shared<acv::Image>(mImage->Scale(kScaleX, kScaleY, ConvertToEngineScaleType(scaleType)));
 
-        return std::move(retImg);
+        return retImg;
     }
 }
 
@@ -0,0 +1,149 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class AImageBatch
+
+#include "AImageBatch.h"
+#include "ATypesConverter.h"
+#include "AProgress.h"
+#include "Parallel.h"
+#include "Progress.h"
+
+#include <atomic>
+
+// Process each image of batch (processImage(imageNum) returns false if the image was not processed)
+// The small images are distributed between the threads, the engine loops inside of them are divided between
+// the same threads of scheduler, so the threads are not oversubscribed. The large images are processed one by one
+// with parallel loops inside of engine algorithms
+// Returns false if any image was not processed or the batch was cancelled
+template <typename ImageProcessor>
+static bool ProcessBatch(const std::vector<AImage>& images, const ImageProcessor& processImage, AProgress* progress)
+{
+    acv::Progress* engProgress = ConvertToEngineProgress(progress);
+    acv::Progress::Begin(engProgress, static_cast<int>(images.size()));
+
+    std::vector<int> smallImages, largeImages;
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+        const long long numPixels = static_cast<long long>(images[i].GetHeight()) * images[i].GetWidth();
+        (numPixels <= AImageBatch::MAX_IMAGE_PARALLEL_PIXELS ? smallImages : largeImages).push_back(static_cast<int>(i));
+    }
+
+    std::atomic<bool> isDone(true);
+
+    acv::Parallel::For(0, static_cast<int>(smallImages.size()), [&](const int begin, const int end)
+    {
+        for (int i = begin; i < end && !acv::Progress::Cancelled(engProgress); ++i)
+        {
+            if (!processImage(smallImages[i]))
+                isDone.store(false);
+            acv::Progress::Step(engProgress);
+        }
+    });
+
+    for (size_t i = 0; i < largeImages.size() && !acv::Progress::Cancelled(engProgress); ++i)
+    {
+        if (!processImage(largeImages[i]))
+            isDone.store(false);
+        acv::Progress::Step(engProgress);
+    }
+
+    return isDone.load() && !acv::Progress::Cancelled(engProgress);
+}
+
+AFiltrationResult AImageBatch::FilterBatch(const std::vector<AImage>& srcImages, std::vector<AImage>& dstImages,
+                                           AFilterType type, int filterSize, AProgress* progress)
+{
+    // The results are collected separately, so the destination vector can be the same as the source vector
+    std::vector<AImage> results(srcImages.size(), AImage(-1, -1));
+    std::vector<AFiltrationResult> filtrationResults(srcImages.size(), AFiltrationResult::SUCCESS);
+
+    const bool isDone = ProcessBatch(srcImages, [&](const int imageNum)
+    {
+        const AImage& srcImg = srcImages[imageNum];
+        results[imageNum] = AImage(srcImg.GetHeight(), srcImg.GetWidth());
+        filtrationResults[imageNum] = AImageFilter::Filter(srcImg, results[imageNum], type, filterSize);
+
+        return filtrationResults[imageNum] == AFiltrationResult::SUCCESS;
+    }, progress);
+
+    dstImages = std::move(results);
+
+    if (isDone)
+        return AFiltrationResult::SUCCESS;
+
+    for (const AFiltrationResult res : filtrationResults)
+    {
+        if (res != AFiltrationResult::SUCCESS)
+            return res;
+    }
+
+    return AFiltrationResult::CANCELLED;
+}
+
+bool AImageBatch::CorrectBatch(const std::vector<AImage>& srcImages, std::vector<AImage>& dstImages,
+                               ACorrectorType corType, AProgress* progress)
+{
+    std::vector<AImage> results(srcImages.size(), AImage(-1, -1));
+
+    const bool isDone = ProcessBatch(srcImages, [&](const int imageNum)
+    {
+        const AImage& srcImg = srcImages[imageNum];
+        results[imageNum] = AImage(srcImg.GetHeight(), srcImg.GetWidth());
+
+        return AImageCorrector::Correct(srcImg, results[imageNum], corType);
+    }, progress);
+
+    dstImages = std::move(results);
+    return isDone;
+}
+
+bool AImageBatch::DetectBordersBatch(const std::vector<AImage>& srcImages, std::vector<AImage>& dstImages,
+                                     ADetectorType detectorType, AProgress* progress)
+{
+    std::vector<AImage> results(srcImages.size(), AImage(-1, -1));
+
+    const bool isDone = ProcessBatch(srcImages, [&](const int imageNum)
+    {
+        const AImage& srcImg = srcImages[imageNum];
+        results[imageNum] = AImage(srcImg.GetHeight(), srcImg.GetWidth());
+
+        return ABordersDetector::DetectBorders(srcImg, results[imageNum], detectorType);
+    }, progress);
+
+    dstImages = std::move(results);
+    return isDone;
+}
+
+bool AImageBatch::CalcParametersBatch(const std::vector<AImage>& images, std::vector<AImageParameters>& parameters,
+                                      AProgress* progress)
+{
+    parameters.assign(images.size(), AImageParameters());
+
+    return ProcessBatch(images, [&](const int imageNum)
+    {
+        AImageParametersCalculator calculator(images[imageNum]);
+        return calculator.CalcParameters(parameters[imageNum]);
+    }, progress);
+}
@@ -27,7 +27,7 @@
 #include "AImageCombiner.h"
 #include "ImageCombiner.h"
 #include "AImageManager.h"
-#include "AImage.h"
+#include "ATypesConverter.h"
 
 #include <cassert>
 
@@ -37,15 +37,25 @@ AImageCombiner::AImageCombiner()
 }
 
 void AImageCombiner::AddImage(const AImage& img)
+{
+    AddImage(AImage(img));
+}
+
+void AImageCombiner::AddImage(AImage&& img)
 {
     if (mCombiner && img.IsInitialized())
-        mCombiner->AddImage(*AImageManager::GetEngineImage(img));
+    {
+        mImages.push_back(std::move(img));
+        mCombiner->AddImage(*AImageManager::GetEngineImage(mImages.back()));
+    }
 }
 
 void AImageCombiner::ClearImages()
 {
     if (mCombiner)
         mCombiner->ClearImages();
+
+    mImages.clear();
 }
 
 acv::ImageCombiner::CombineType ConvertToEngineCombineType(ACombineType combineType)
@@ -82,19 +92,22 @@ ACombinationResult ConvertToServiseCombinationResult(acv::CombinationResult res)
         return ACombinationResult::NOT_SAME_IMAGES;
     case acv::CombinationResult::SUCCESS:
         return ACombinationResult::SUCCESS;
+    case acv::CombinationResult::CANCELLED:
+        return ACombinationResult::CANCELLED;
     }
 
     assert(false);
     return ACombinationResult::OTHER_ERROR;
 }
 
-ACombinationResult AImageCombiner::Combine(ACombineType combineType, AImage& combImg, bool needSort)
+ACombinationResult AImageCombiner::Combine(ACombineType combineType, AImage& combImg, bool needSort, AProgress* progress)
 {
-    auto& dstImg = AImageManager::GetEngineImage(combImg);
+    auto& dstImg = AImageManager::GetDestinationEngineImage(combImg);
 
     if (mCombiner && dstImg)
     {
-        acv::CombinationResult res = mCombiner->Combine(ConvertToEngineCombineType(combineType), *dstImg, needSort);
+        acv::CombinationResult res = mCombiner->Combine(ConvertToEngineCombineType(combineType), *dstImg, needSort,
+                                                        ConvertToEngineProgress(progress));
         return ConvertToServiseCombinationResult(res);
     }
 
@@ -28,7 +28,11 @@
 #include "ImageCorrector.h"
 #include "AImageManager.h"
 #include "AImageUtils.h"
+#include "ATypesConverter.h"
+#include "AImage.h"
 #include "Image.h"
+#include "AMultiChannelImage.h"
+#include "MultiChannelImage.h"
 
 #include <memory>
 #include <cassert>
@@ -45,23 +49,59 @@ acv::ImageCorrector::CorrectorType ConvertToEngineCorrectorType(ACorrectorType c
         return acv::ImageCorrector::CorrectorType::NORM_AUTO_LEVELS;
     case ACorrectorType::GAMMA:
         return acv::ImageCorrector::CorrectorType::GAMMA;
+    case ACorrectorType::GLOBAL_EQUALIZATION:
+        return acv::ImageCorrector::CorrectorType::GLOBAL_EQUALIZATION;
+    case ACorrectorType::CLAHE:
+        return acv::ImageCorrector::CorrectorType::CLAHE;
     }
 
     assert(false);
     return acv::ImageCorrector::CorrectorType::AUTO_LEVELS;
 }
 
-bool AImageCorrector::Correct(const AImage& srcImg, AImage& dstImg, ACorrectorType corType)
+bool AImageCorrector::Correct(const AImage& srcImg, AImage& dstImg, ACorrectorType corType, AProgress* progress)
 {
     bool ret = AImageUtils::ImagesHaveSameSizes(srcImg, dstImg);
 
     if (ret)
     {
-        const auto& sourceImage = AImageManager::GetEngineImage(srcImg);
-        auto& destinationImage = AImageManager::GetEngineImage(dstImg);
+        const auto sourceImage = AImageManager::GetEngineImage(srcImg);
+        auto& destinationImage = AImageManager::GetDestinationEngineImage(dstImg);
 
         ret = ret && sourceImage != nullptr && destinationImage != nullptr;
-        ret = ret && acv::ImageCorrector::Correct(*sourceImage, *destinationImage, ConvertToEngineCorrectorType(corType));
+        ret = ret && acv::ImageCorrector::Correct(*sourceImage, *destinationImage, ConvertToEngineCorrectorType(corType),
+                                                  ConvertToEngineProgress(progress));
+    }
+
+    return ret;
+}
+
+bool AImageCorrector::Correct(AImage&& srcImg, AImage& dstImg, ACorrectorType corType, AProgress* progress)
+{
+    bool ret = srcImg.IsInitialized();
+
+    if (ret)
+    {
+        const auto& image = AImageManager::GetMutableEngineImage(srcImg);
+
+        ret = acv::ImageCorrector::Correct(*image, ConvertToEngineCorrectorType(corType), ConvertToEngineProgress(progress));
+        if (ret)
+            dstImg = std::move(srcImg);
+    }
+
+    return ret;
+}
+
+bool AImageCorrector::Correct(const AMultiChannelImage& srcImg, AMultiChannelImage& dstImg, ACorrectorType corType)
+{
+    const auto sourceImage = AImageManager::GetEngineImage(srcImg);
+    bool ret = sourceImage != nullptr && dstImg.IsInitialized() &&
+               sourceImage->HasSameFormat(*AImageManager::GetEngineImage(dstImg));
+
+    if (ret)
+    {
+        auto& destinationImage = AImageManager::GetDestinationEngineImage(dstImg);
+        ret = acv::ImageCorrector::Correct(*sourceImage, *destinationImage, ConvertToEngineCorrectorType(corType));
     }
 
     return ret;
@@ -28,7 +28,12 @@
 #include "ImageFilter.h"
 #include "AImageManager.h"
 #include "AImageUtils.h"
+#include "ATypesConverter.h"
 #include "AImage.h"
+#include "AMultiChannelImage.h"
+#include "MultiChannelImage.h"
+#include "ABinaryImage.h"
+#include "BinaryImage.h"
 
 #include <cassert>
 
@@ -46,46 +51,69 @@ acv::ImageFilter::FilterType ConvertToEngineFilterType(AFilterType type)
         return acv::ImageFilter::FilterType::IIR_GAUSSIAN;
     case AFilterType::SHARPEN:
         return acv::ImageFilter::FilterType::SHARPEN;
+    case AFilterType::BILATERAL:
+        return acv::ImageFilter::FilterType::BILATERAL;
+    case AFilterType::UNSHARP_MASK:
+        return acv::ImageFilter::FilterType::UNSHARP_MASK;
     }
 
     assert(false);
     return acv::ImageFilter::FilterType::MEDIAN;
 }
 
-AFiltrationResult ConvertToAFiltrationResult(acv::FiltrationResult res)
+AFiltrationResult AImageFilter::Filter(const AImage& srcImg, AImage& dstImg, AFilterType type, int filterSize,
+                                       AProgress* progress)
 {
-    switch (res)
+    AFiltrationResult ret = AFiltrationResult::INTERNAL_ERROR;
+
+    if (AImageUtils::ImagesHaveSameSizes(srcImg, dstImg))
     {
-    case acv::FiltrationResult::SUCCESS:
-        return AFiltrationResult::SUCCESS;
-    case acv::FiltrationResult::INTERNAL_ERROR:
-        return AFiltrationResult::INTERNAL_ERROR;
-    case acv::FiltrationResult::INCORRECT_FILTER_TYPE:
-        return AFiltrationResult::INCORRECT_FILTER_TYPE;
-    case acv::FiltrationResult::INCORRECT_FILTER_SIZE:
-        return AFiltrationResult::INCORRECT_FILTER_SIZE;
-    case acv::FiltrationResult::SMALL_FILTER_SIZE:
-        return AFiltrationResult::SMALL_FILTER_SIZE;
+        const auto srcImgPtr = AImageManager::GetEngineImage(srcImg);
+        auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+        if (srcImgPtr && dstImgPtr)
+        {
+            acv::FiltrationResult engRes = acv::ImageFilter::Filter(*srcImgPtr, *dstImgPtr, ConvertToEngineFilterType(type),
+                                                                    filterSize, ConvertToEngineProgress(progress));
+            ret = AImageUtils::ConvertToAFiltrationResult(engRes);
+        }
     }
 
-    assert(false);
-    return AFiltrationResult::INTERNAL_ERROR;
+    return ret;
+}
+
+AFiltrationResult AImageFilter::Filter(const AMultiChannelImage& srcImg, AMultiChannelImage& dstImg, AFilterType type, int filterSize)
+{
+    AFiltrationResult ret = AFiltrationResult::INTERNAL_ERROR;
+
+    const auto srcImgPtr = AImageManager::GetEngineImage(srcImg);
+    if (srcImgPtr && dstImg.IsInitialized() && srcImgPtr->HasSameFormat(*AImageManager::GetEngineImage(dstImg)))
+    {
+        auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+        acv::FiltrationResult engRes = acv::ImageFilter::Filter(*srcImgPtr, *dstImgPtr,
+                                                                ConvertToEngineFilterType(type), filterSize);
+        ret = AImageUtils::ConvertToAFiltrationResult(engRes);
+    }
+
+    return ret;
 }
 
-AFiltrationResult AImageFilter::Filter(const AImage& srcImg, AImage& dstImg, AFilterType type, int filterSize)
+AFiltrationResult AImageFilter::UnsharpMask(const AImage& srcImg, AImage& dstImg, int radius, int amount, int threshold,
+                                            AProgress* progress)
 {
     AFiltrationResult ret = AFiltrationResult::INTERNAL_ERROR;
 
     if (AImageUtils::ImagesHaveSameSizes(srcImg, dstImg))
     {
-        const auto& srcImgPtr = AImageManager::GetEngineImage(srcImg);
-        auto& dstImgPtr = AImageManager::GetEngineImage(dstImg);
+        const auto srcImgPtr = AImageManager::GetEngineImage(srcImg);
+        auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
 
         if (srcImgPtr && dstImgPtr)
         {
-            acv::FiltrationResult engRes = acv::ImageFilter::Filter(*srcImgPtr, *dstImgPtr,
-                                                                    ConvertToEngineFilterType(type), filterSize);
-            ret = ConvertToAFiltrationResult(engRes);
+            acv::FiltrationResult engRes = acv::ImageFilter::UnsharpMask(*srcImgPtr, *dstImgPtr, radius, amount, threshold,
+                                                                         ConvertToEngineProgress(progress));
+            ret = AImageUtils::ConvertToAFiltrationResult(engRes);
         }
     }
 
@@ -106,6 +134,20 @@ acv::ImageFilter::ThresholdType ConvertToEngineThresholdType(AThresholdType thre
     return acv::ImageFilter::ThresholdType::MAX_MORE_THRESHOLD;
 }
 
+acv::ImageFilter::ThresholdMethod ConvertToEngineThresholdMethod(AThresholdMethod method)
+{
+    switch (method)
+    {
+    case AThresholdMethod::NIBLACK:
+        return acv::ImageFilter::ThresholdMethod::NIBLACK;
+    case AThresholdMethod::SAUVOLA:
+        return acv::ImageFilter::ThresholdMethod::SAUVOLA;
+    }
+
+    assert(false);
+    return acv::ImageFilter::ThresholdMethod::SAUVOLA;
+}
+
 bool AImageFilter::AdaptiveThreshold(const AImage& srcImg, AImage& dstImg,
                                      int filterSize, int threshold, AThresholdType thresholdType)
 {
@@ -113,8 +155,8 @@ bool AImageFilter::AdaptiveThreshold(const AImage& srcImg, AImage& dstImg,
 
     if (ret)
     {
-        const auto& srcImgPtr = AImageManager::GetEngineImage(srcImg);
-        auto& dstImgPtr = AImageManager::GetEngineImage(dstImg);
+        const auto srcImgPtr = AImageManager::GetEngineImage(srcImg);
+        auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
 
         ret = ret && srcImgPtr != nullptr && dstImgPtr != nullptr;
         ret = ret && acv::ImageFilter::AdaptiveThreshold(*srcImgPtr, *dstImgPtr,
@@ -123,3 +165,98 @@ bool AImageFilter::AdaptiveThreshold(const AImage& srcImg, AImage& dstImg,
 
     return ret;
 }
+
+AFiltrationResult AImageFilter::Filter(AImage&& srcImg, AImage& dstImg, AFilterType type, int filterSize,
+                                       AProgress* progress)
+{
+    AFiltrationResult ret = AFiltrationResult::INTERNAL_ERROR;
+
+    if (srcImg.IsInitialized())
+    {
+        const auto& imgPtr = AImageManager::GetMutableEngineImage(srcImg);
+
+        acv::FiltrationResult engRes = acv::ImageFilter::Filter(*imgPtr, ConvertToEngineFilterType(type), filterSize,
+                                                                ConvertToEngineProgress(progress));
+        ret = AImageUtils::ConvertToAFiltrationResult(engRes);
+
+        if (ret == AFiltrationResult::SUCCESS)
+            dstImg = std::move(srcImg);
+    }
+
+    return ret;
+}
+
+bool AImageFilter::AdaptiveThreshold(AImage&& srcImg, AImage& dstImg,
+                                     int filterSize, int threshold, AThresholdType thresholdType)
+{
+    bool ret = srcImg.IsInitialized();
+
+    if (ret)
+    {
+        const auto& imgPtr = AImageManager::GetMutableEngineImage(srcImg);
+
+        ret = acv::ImageFilter::AdaptiveThreshold(*imgPtr, filterSize, threshold, ConvertToEngineThresholdType(thresholdType));
+        if (ret)
+            dstImg = std::move(srcImg);
+    }
+
+    return ret;
+}
+
+bool AImageFilter::AdaptiveThreshold(const AImage& srcImg, AImage& dstImg, int filterSize, float k,
+                                     AThresholdMethod method, AThresholdType thresholdType)
+{
+    bool ret = AImageUtils::ImagesHaveSameSizes(srcImg, dstImg);
+
+    if (ret)
+    {
+        const auto srcImgPtr = AImageManager::GetEngineImage(srcImg);
+        auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+        ret = ret && srcImgPtr != nullptr && dstImgPtr != nullptr;
+        ret = ret && acv::ImageFilter::AdaptiveThreshold(*srcImgPtr, *dstImgPtr, filterSize, k,
+                                                         ConvertToEngineThresholdMethod(method),
+                                                         ConvertToEngineThresholdType(thresholdType));
+    }
+
+    return ret;
+}
+
+bool AImageFilter::AdaptiveThreshold(AImage&& srcImg, AImage& dstImg, int filterSize, float k,
+                                     AThresholdMethod method, AThresholdType thresholdType)
+{
+    bool ret = srcImg.IsInitialized();
+
+    if (ret)
+    {
+        const auto& imgPtr = AImageManager::GetMutableEngineImage(srcImg);
+
+        ret = acv::ImageFilter::AdaptiveThreshold(*imgPtr, filterSize, k, ConvertToEngineThresholdMethod(method),
+                                                  ConvertToEngineThresholdType(thresholdType));
+        if (ret)
+            dstImg = std::move(srcImg);
+    }
+
+    return ret;
+}
+
+bool AImageFilter::AdaptiveThreshold(const AImage& srcImg, ABinaryImage& dstImg, int filterSize, int threshold, AThresholdType thresholdType)
+{
+    const auto& srcImgPtr = AImageManager::GetEngineImage(srcImg);
+    auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+    return srcImgPtr != nullptr && dstImgPtr != nullptr &&
+           acv::ImageFilter::AdaptiveThreshold(*srcImgPtr, *dstImgPtr, filterSize, threshold, ConvertToEngineThresholdType(thresholdType));
+}
+
+bool AImageFilter::AdaptiveThreshold(const AImage& srcImg, ABinaryImage& dstImg, int filterSize, float k,
+                                     AThresholdMethod method, AThresholdType thresholdType)
+{
+    const auto& srcImgPtr = AImageManager::GetEngineImage(srcImg);
+    auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+    return srcImgPtr != nullptr && dstImgPtr != nullptr &&
+           acv::ImageFilter::AdaptiveThreshold(*srcImgPtr, *dstImgPtr, filterSize, k,
+                                               ConvertToEngineThresholdMethod(method),
+                                               ConvertToEngineThresholdType(thresholdType));
+}
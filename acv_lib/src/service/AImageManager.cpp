@@ -27,16 +27,69 @@
 #include "AImageManager.h"
 #include "Image.h"
 #include "AImage.h"
+#include "MultiChannelImage.h"
+#include "AMultiChannelImage.h"
+#include "BinaryImage.h"
+#include "ABinaryImage.h"
 
 const std::shared_ptr<acv::Image>& AImageManager::GetEngineImage(const AImage& image)
 {
     return image.mImage;
 }
 
+const std::shared_ptr<acv::Image>& AImageManager::GetMutableEngineImage(AImage& image)
+{
+    image.Detach();
+    return image.mImage;
+}
+
+const std::shared_ptr<acv::Image>& AImageManager::GetDestinationEngineImage(AImage& image)
+{
+    if (image.mImage && image.mImage.use_count() > 1)
+        image.mImage = std::make_shared<acv::Image>(image.mImage->GetHeight(), image.mImage->GetWidth());
+
+    return image.mImage;
+}
+
+const std::shared_ptr<acv::MultiChannelImage>& AImageManager::GetEngineImage(const AMultiChannelImage& image)
+{
+    return image.mImage;
+}
+
+const std::shared_ptr<acv::MultiChannelImage>& AImageManager::GetDestinationEngineImage(AMultiChannelImage& image)
+{
+    if (image.mImage && image.mImage.use_count() > 1)
+        image.mImage = std::make_shared<acv::MultiChannelImage>(image.mImage->GetHeight(), image.mImage->GetWidth(),
+                                                                image.mImage->GetNumChannels());
+
+    return image.mImage;
+}
+
+const std::shared_ptr<acv::BinaryImage>& AImageManager::GetEngineImage(const ABinaryImage& image)
+{
+    return image.mImage;
+}
+
+const std::shared_ptr<acv::BinaryImage>& AImageManager::GetDestinationEngineImage(ABinaryImage& image)
+{
+    if (image.mImage && image.mImage.use_count() > 1)
+        image.mImage = std::make_shared<acv::BinaryImage>(image.mImage->GetHeight(), image.mImage->GetWidth());
+
+    return image.mImage;
+}
+
 AImage AImageManager::MakeServiceImage(const acv::Image& img)
 {
     AImage ret(-1, -1);
     ret.mImage = std::make_shared<acv::Image>(img);
 
-    return std::move(ret);
+    return ret;
+}
+
+AImage AImageManager::MakeServiceImage(acv::Image&& img)
+{
+    AImage ret(-1, -1);
+    ret.mImage = std::make_shared<acv::Image>(std::move(img));
+
+    return ret;
 }
@@ -31,6 +31,21 @@
 
 #include <memory>
 
+// Convert the parameters from engine level
+static AImageParameters ConvertToAImageParameters(const acv::ImageParametersCalculator::Parameters& params)
+{
+    AImageParameters ret;
+
+    ret.entropy = params.entropy;
+    ret.averageBrightness = params.averageBrightness;
+    ret.standardDeviation = params.standardDeviation;
+    ret.minBrightness = params.minBrightness;
+    ret.maxBrightness = params.maxBrightness;
+    ret.integralQualityIndicator = params.integralQualityIndicator;
+
+    return ret;
+}
+
 AImageParametersCalculator::AImageParametersCalculator()
     : mCalculator(std::make_shared<acv::ImageParametersCalculator>())
 {
@@ -142,3 +157,14 @@ bool AImageParametersCalculator::CreateBrightnessHistogram(std::vector<double>&
 
     return ret;
 }
+
+bool AImageParametersCalculator::CalcParameters(AImageParameters& params)
+{
+    acv::ImageParametersCalculator::Parameters engParams;
+
+    bool ret = mCalculator != nullptr && mCalculator->CalcParameters(engParams);
+    if (ret)
+        params = ConvertToAImageParameters(engParams);
+
+    return ret;
+}
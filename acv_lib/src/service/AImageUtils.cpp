@@ -28,6 +28,10 @@
 #include "AImageManager.h"
 #include "AImage.h"
 #include "Image.h"
+#include "AImageFilter.h"
+#include "ImageFilter.h"
+
+#include <cassert>
 
 bool AImageUtils::ImagesHaveSameSizes(const AImage& lhs, const AImage& rhs)
 {
@@ -42,3 +46,25 @@ bool AImageUtils::ImagesHaveSameSizes(const acv::Image& lhs, const acv::Image& r
                 lhs.GetHeight() == rhs.GetHeight();
     return same;
 }
+
+AFiltrationResult AImageUtils::ConvertToAFiltrationResult(acv::FiltrationResult res)
+{
+    switch (res)
+    {
+    case acv::FiltrationResult::SUCCESS:
+        return AFiltrationResult::SUCCESS;
+    case acv::FiltrationResult::INTERNAL_ERROR:
+        return AFiltrationResult::INTERNAL_ERROR;
+    case acv::FiltrationResult::INCORRECT_FILTER_TYPE:
+        return AFiltrationResult::INCORRECT_FILTER_TYPE;
+    case acv::FiltrationResult::INCORRECT_FILTER_SIZE:
+        return AFiltrationResult::INCORRECT_FILTER_SIZE;
+    case acv::FiltrationResult::SMALL_FILTER_SIZE:
+        return AFiltrationResult::SMALL_FILTER_SIZE;
+    case acv::FiltrationResult::CANCELLED:
+        return AFiltrationResult::CANCELLED;
+    }
+
+    assert(false);
+    return AFiltrationResult::INTERNAL_ERROR;
+}
@@ -0,0 +1,115 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class AMorphologyFilter
+
+#include "AMorphologyFilter.h"
+#include "MorphologyFilter.h"
+#include "AImageManager.h"
+#include "AImageUtils.h"
+#include "ATypesConverter.h"
+#include "AImage.h"
+#include "ABinaryImage.h"
+#include "BinaryImage.h"
+
+#include <cassert>
+
+acv::MorphologyFilter::MorphologyType ConvertToEngineMorphologyType(AMorphologyType type)
+{
+    switch (type)
+    {
+    case AMorphologyType::EROSION:
+        return acv::MorphologyFilter::MorphologyType::EROSION;
+    case AMorphologyType::DILATION:
+        return acv::MorphologyFilter::MorphologyType::DILATION;
+    case AMorphologyType::OPENING:
+        return acv::MorphologyFilter::MorphologyType::OPENING;
+    case AMorphologyType::CLOSING:
+        return acv::MorphologyFilter::MorphologyType::CLOSING;
+    }
+
+    assert(false);
+    return acv::MorphologyFilter::MorphologyType::EROSION;
+}
+
+AFiltrationResult AMorphologyFilter::Filter(const AImage& srcImg, AImage& dstImg, AMorphologyType type, int seWidth, int seHeight,
+                                            AProgress* progress)
+{
+    AFiltrationResult ret = AFiltrationResult::INTERNAL_ERROR;
+
+    if (AImageUtils::ImagesHaveSameSizes(srcImg, dstImg))
+    {
+        const auto srcImgPtr = AImageManager::GetEngineImage(srcImg);
+        auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+        if (srcImgPtr && dstImgPtr)
+        {
+            acv::FiltrationResult engRes = acv::MorphologyFilter::Filter(*srcImgPtr, *dstImgPtr,
+                                                                         ConvertToEngineMorphologyType(type), seWidth, seHeight,
+                                                                         ConvertToEngineProgress(progress));
+            ret = AImageUtils::ConvertToAFiltrationResult(engRes);
+        }
+    }
+
+    return ret;
+}
+
+AFiltrationResult AMorphologyFilter::Filter(AImage&& srcImg, AImage& dstImg, AMorphologyType type, int seWidth, int seHeight,
+                                            AProgress* progress)
+{
+    AFiltrationResult ret = AFiltrationResult::INTERNAL_ERROR;
+
+    if (srcImg.IsInitialized())
+    {
+        const auto& imgPtr = AImageManager::GetMutableEngineImage(srcImg);
+
+        acv::FiltrationResult engRes = acv::MorphologyFilter::Filter(*imgPtr, ConvertToEngineMorphologyType(type), seWidth, seHeight,
+                                                                     ConvertToEngineProgress(progress));
+        ret = AImageUtils::ConvertToAFiltrationResult(engRes);
+
+        if (ret == AFiltrationResult::SUCCESS)
+            dstImg = std::move(srcImg);
+    }
+
+    return ret;
+}
+
+AFiltrationResult AMorphologyFilter::Filter(const ABinaryImage& srcImg, ABinaryImage& dstImg, AMorphologyType type, int seWidth, int seHeight,
+                                            AProgress* progress)
+{
+    AFiltrationResult ret = AFiltrationResult::INTERNAL_ERROR;
+
+    const auto srcImgPtr = AImageManager::GetEngineImage(srcImg);
+    auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+    if (srcImgPtr && dstImgPtr)
+    {
+        acv::FiltrationResult engRes = acv::MorphologyFilter::Filter(*srcImgPtr, *dstImgPtr,
+                                                                     ConvertToEngineMorphologyType(type), seWidth, seHeight,
+                                                                     ConvertToEngineProgress(progress));
+        ret = AImageUtils::ConvertToAFiltrationResult(engRes);
+    }
+
+    return ret;
+}
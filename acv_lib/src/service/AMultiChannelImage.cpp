@@ -0,0 +1,129 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class AMultiChannelImage
+
+#include "AMultiChannelImage.h"
+#include "MultiChannelImage.h"
+#include "AImageManager.h"
+#include "AImageUtils.h"
+#include "ATypesConverter.h"
+
+AMultiChannelImage::AMultiChannelImage(int height, int width, int numChannels)
+    : mImage(nullptr)
+{
+    if (height > 0 && width > 0 && numChannels > 0 && numChannels <= MAX_NUM_CHANNELS)
+        mImage = std::make_shared<acv::MultiChannelImage>(height, width, numChannels);
+}
+
+AMultiChannelImage::AMultiChannelImage(int height, int width, int numChannels, const void* buf, int bytesPerLine)
+    : AMultiChannelImage(height, width, numChannels)
+{
+    Import(buf, bytesPerLine);
+}
+
+int AMultiChannelImage::GetWidth() const
+{
+    return (mImage) ? mImage->GetWidth() : -1;
+}
+
+int AMultiChannelImage::GetHeight() const
+{
+    return (mImage) ? mImage->GetHeight() : -1;
+}
+
+int AMultiChannelImage::GetNumChannels() const
+{
+    return (mImage) ? mImage->GetNumChannels() : 0;
+}
+
+bool AMultiChannelImage::IsInitialized() const
+{
+    return (mImage && mImage->IsInitialized());
+}
+
+AImage AMultiChannelImage::GetChannel(int channelNum) const
+{
+    if (!IsInitialized() || channelNum < 0 || channelNum >= GetNumChannels())
+        return AImage(-1, -1);
+
+    return AImageManager::MakeServiceImage(mImage->GetChannel(channelNum));
+}
+
+bool AMultiChannelImage::SetChannel(int channelNum, const AImage& channel)
+{
+    bool ret = IsInitialized() && channelNum >= 0 && channelNum < GetNumChannels();
+
+    if (ret)
+    {
+        const auto& channelPtr = AImageManager::GetEngineImage(channel);
+
+        ret = channelPtr != nullptr && AImageUtils::ImagesHaveSameSizes(*channelPtr, mImage->GetChannel(channelNum));
+        if (ret)
+        {
+            Detach();
+            mImage->GetChannel(channelNum) = *channelPtr;
+        }
+    }
+
+    return ret;
+}
+
+bool AMultiChannelImage::Import(const void* buf, int bytesPerLine)
+{
+    if (!IsInitialized())
+        return false;
+
+    const auto& imgPtr = AImageManager::GetDestinationEngineImage(*this);
+
+    return imgPtr->Deinterleave(buf, bytesPerLine);
+}
+
+bool AMultiChannelImage::Export(void* buf, int bytesPerLine) const
+{
+    return IsInitialized() && mImage->Interleave(buf, bytesPerLine);
+}
+
+AMultiChannelImage AMultiChannelImage::Scale(short kScaleX, short kScaleY, AScaleType scaleType) const
+{
+    if (kScaleX == 1 && kScaleY == 1)
+    {
+        return *this;
+    }
+    else
+    {
+        AMultiChannelImage retImg(-1, -1, 0);
+
+        if (IsInitialized() && kScaleX > 1 && kScaleY > 1)
+            retImg.mImage = std::make_shared<acv::MultiChannelImage>(mImage->Scale(kScaleX, kScaleY, ConvertToEngineScaleType(scaleType)));
+
+        return retImg;
+    }
+}
+
+void AMultiChannelImage::Detach()
+{
+    if (mImage && mImage.use_count() > 1)
+        mImage = std::make_shared<acv::MultiChannelImage>(*mImage);
+}
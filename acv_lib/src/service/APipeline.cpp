@@ -0,0 +1,115 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class APipeline
+
+#include "APipeline.h"
+#include "Pipeline.h"
+#include "AImageManager.h"
+#include "AImageUtils.h"
+#include "ATypesConverter.h"
+#include "AImage.h"
+
+APipeline::APipeline()
+    : mPipeline(std::make_shared<acv::Pipeline>())
+{ }
+
+APipeline& APipeline::AddFilter(AFilterType type, int filterSize/* = -1*/)
+{
+    mPipeline->AddFilter(ConvertToEngineFilterType(type), filterSize);
+    return *this;
+}
+
+APipeline& APipeline::AddAdaptiveThreshold(int filterSize, int threshold, AThresholdType thresholdType)
+{
+    mPipeline->AddAdaptiveThreshold(filterSize, threshold, ConvertToEngineThresholdType(thresholdType));
+    return *this;
+}
+
+APipeline& APipeline::AddAdaptiveThreshold(int filterSize, float k, AThresholdMethod method, AThresholdType thresholdType)
+{
+    mPipeline->AddAdaptiveThreshold(filterSize, k, ConvertToEngineThresholdMethod(method), ConvertToEngineThresholdType(thresholdType));
+    return *this;
+}
+
+APipeline& APipeline::AddCorrector(ACorrectorType corType)
+{
+    mPipeline->AddCorrector(ConvertToEngineCorrectorType(corType));
+    return *this;
+}
+
+APipeline& APipeline::AddBordersDetector(ADetectorType detectorType)
+{
+    mPipeline->AddBordersDetector(ConvertToEngineDetectorType(detectorType));
+    return *this;
+}
+
+APipeline& APipeline::AddOperator(ADetectorType detectorType, AOperatorType operatorType)
+{
+    mPipeline->AddOperator(ConvertToEngineDetectorType(detectorType), ConvertToEngineOperatorType(operatorType));
+    return *this;
+}
+
+APipeline& APipeline::AddMorphology(AMorphologyType type, int seWidth, int seHeight)
+{
+    mPipeline->AddMorphology(ConvertToEngineMorphologyType(type), seWidth, seHeight);
+    return *this;
+}
+
+void APipeline::Clear()
+{
+    mPipeline->Clear();
+}
+
+bool APipeline::Run(const AImage& srcImg, AImage& dstImg) const
+{
+    bool ret = AImageUtils::ImagesHaveSameSizes(srcImg, dstImg);
+
+    if (ret)
+    {
+        const auto srcImgPtr = AImageManager::GetEngineImage(srcImg);
+        auto& dstImgPtr = AImageManager::GetDestinationEngineImage(dstImg);
+
+        ret = ret && srcImgPtr != nullptr && dstImgPtr != nullptr;
+        ret = ret && mPipeline->Run(*srcImgPtr, *dstImgPtr);
+    }
+
+    return ret;
+}
+
+bool APipeline::Run(AImage&& srcImg, AImage& dstImg) const
+{
+    bool ret = srcImg.IsInitialized();
+
+    if (ret)
+    {
+        const auto& imgPtr = AImageManager::GetMutableEngineImage(srcImg);
+
+        ret = mPipeline->Run(*imgPtr, *imgPtr);
+        if (ret)
+            dstImg = std::move(srcImg);
+    }
+
+    return ret;
+}
@@ -0,0 +1,74 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class AProfiler
+
+#include "AProfiler.h"
+#include "Profiler.h"
+
+bool AProfiler::IsEnabled()
+{
+    return acv::Profiler::IsEnabled();
+}
+
+std::vector<AProfileStageStats> AProfiler::GetStageStats()
+{
+    std::vector<AProfileStageStats> stages;
+
+    for (const auto& engStats : acv::Profiler::GetStageStats())
+    {
+        AProfileStageStats stats = { engStats.name, engStats.calls, engStats.totalMs, engStats.minMs, engStats.maxMs, engStats.bytes };
+        stages.push_back(stats);
+    }
+
+    return stages;
+}
+
+std::vector<AProfileCounterStats> AProfiler::GetCounterStats()
+{
+    std::vector<AProfileCounterStats> counters;
+
+    for (const auto& engStats : acv::Profiler::GetCounterStats())
+    {
+        AProfileCounterStats stats = { engStats.name, engStats.events, engStats.total };
+        counters.push_back(stats);
+    }
+
+    return counters;
+}
+
+void AProfiler::SetTraceEnabled(bool isEnabled)
+{
+    acv::Profiler::SetTraceEnabled(isEnabled);
+}
+
+bool AProfiler::WriteChromeTrace(const std::string& fileName)
+{
+    return acv::Profiler::WriteChromeTrace(fileName);
+}
+
+void AProfiler::Reset()
+{
+    acv::Profiler::Reset();
+}
@@ -0,0 +1,77 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class ARawImageFile
+
+#include "ARawImageFile.h"
+#include "RawImageFile.h"
+#include "AImageManager.h"
+#include "AImage.h"
+
+bool ARawImageFile::Save(const std::string& fileName, const AImage& img)
+{
+    const auto& imgPtr = AImageManager::GetEngineImage(img);
+
+    return imgPtr != nullptr && acv::RawImageFile::Save(fileName, *imgPtr);
+}
+
+bool ARawImageFile::Load(const std::string& fileName, AImage& img)
+{
+    acv::Image engineImg;
+
+    bool ret = acv::RawImageFile::Load(fileName, engineImg);
+    if (ret)
+        img = AImageManager::MakeServiceImage(std::move(engineImg));
+
+    return ret;
+}
+
+bool ARawImageFile::LoadRegion(const std::string& fileName, int x, int y, int width, int height, AImage& img)
+{
+    if (width <= 0 || height <= 0)
+        return false;
+
+    acv::RawImageFile file;
+    acv::Image engineImg(height, width);
+
+    bool ret = file.Open(fileName) && file.ReadRegion(x, y, engineImg);
+    if (ret)
+        img = AImageManager::MakeServiceImage(std::move(engineImg));
+
+    return ret;
+}
+
+bool ARawImageFile::GetImageSizes(const std::string& fileName, int& height, int& width)
+{
+    acv::RawImageFile file;
+
+    bool ret = file.Open(fileName);
+    if (ret)
+    {
+        height = file.GetHeight();
+        width = file.GetWidth();
+    }
+
+    return ret;
+}
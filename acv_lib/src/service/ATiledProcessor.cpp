@@ -0,0 +1,109 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains implementations of methods for class ATiledProcessor
+
+#include "ATiledProcessor.h"
+#include "TiledProcessor.h"
+#include "RawImageFile.h"
+#include "AImageUtils.h"
+#include "ATypesConverter.h"
+
+// Open the source file and create the destination file of the same sizes
+static bool OpenFiles(const std::string& srcFileName, const std::string& dstFileName,
+                      acv::RawImageFile& srcFile, acv::RawImageFile& dstFile)
+{
+    return srcFile.Open(srcFileName) &&
+           acv::RawImageFile::Create(dstFileName, srcFile.GetHeight(), srcFile.GetWidth(), srcFile.GetTileSize()) &&
+           dstFile.Open(dstFileName, acv::RawImageFile::OpenMode::READ_WRITE);
+}
+
+ATiledProcessor::ATiledProcessor(int memoryLimitMB/* = DEFAULT_MEMORY_LIMIT_MB*/)
+    : mMemoryLimitMB(memoryLimitMB)
+{ }
+
+AFiltrationResult ATiledProcessor::Filter(const std::string& srcFileName, const std::string& dstFileName,
+                                          AFilterType type, int filterSize) const
+{
+    acv::RawImageFile srcFile, dstFile;
+    if (!OpenFiles(srcFileName, dstFileName, srcFile, dstFile))
+        return AFiltrationResult::INTERNAL_ERROR;
+
+    acv::TiledProcessor processor(mMemoryLimitMB);
+    acv::FiltrationResult engRes = processor.Filter(srcFile, dstFile, ConvertToEngineFilterType(type), filterSize);
+
+    return AImageUtils::ConvertToAFiltrationResult(engRes);
+}
+
+bool ATiledProcessor::AdaptiveThreshold(const std::string& srcFileName, const std::string& dstFileName,
+                                        int filterSize, int threshold, AThresholdType thresholdType) const
+{
+    acv::RawImageFile srcFile, dstFile;
+    acv::TiledProcessor processor(mMemoryLimitMB);
+
+    return OpenFiles(srcFileName, dstFileName, srcFile, dstFile) &&
+           processor.AdaptiveThreshold(srcFile, dstFile, filterSize, threshold, ConvertToEngineThresholdType(thresholdType));
+}
+
+bool ATiledProcessor::AdaptiveThreshold(const std::string& srcFileName, const std::string& dstFileName,
+                                        int filterSize, float k, AThresholdMethod method, AThresholdType thresholdType) const
+{
+    acv::RawImageFile srcFile, dstFile;
+    acv::TiledProcessor processor(mMemoryLimitMB);
+
+    return OpenFiles(srcFileName, dstFileName, srcFile, dstFile) &&
+           processor.AdaptiveThreshold(srcFile, dstFile, filterSize, k, ConvertToEngineThresholdMethod(method),
+                                       ConvertToEngineThresholdType(thresholdType));
+}
+
+bool ATiledProcessor::Correct(const std::string& srcFileName, const std::string& dstFileName, ACorrectorType corType) const
+{
+    acv::RawImageFile srcFile, dstFile;
+    acv::TiledProcessor processor(mMemoryLimitMB);
+
+    return OpenFiles(srcFileName, dstFileName, srcFile, dstFile) &&
+           processor.Correct(srcFile, dstFile, ConvertToEngineCorrectorType(corType));
+}
+
+bool ATiledProcessor::DetectBorders(const std::string& srcFileName, const std::string& dstFileName, ADetectorType detectorType) const
+{
+    acv::RawImageFile srcFile, dstFile;
+    acv::TiledProcessor processor(mMemoryLimitMB);
+
+    return OpenFiles(srcFileName, dstFileName, srcFile, dstFile) &&
+           processor.DetectBorders(srcFile, dstFile, ConvertToEngineDetectorType(detectorType));
+}
+
+AFiltrationResult ATiledProcessor::Morphology(const std::string& srcFileName, const std::string& dstFileName,
+                                              AMorphologyType type, int seWidth, int seHeight) const
+{
+    acv::RawImageFile srcFile, dstFile;
+    if (!OpenFiles(srcFileName, dstFileName, srcFile, dstFile))
+        return AFiltrationResult::INTERNAL_ERROR;
+
+    acv::TiledProcessor processor(mMemoryLimitMB);
+    acv::FiltrationResult engRes = processor.Morphology(srcFile, dstFile, ConvertToEngineMorphologyType(type), seWidth, seHeight);
+
+    return AImageUtils::ConvertToAFiltrationResult(engRes);
+}
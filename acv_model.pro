@@ -30,4 +30,5 @@ SUBDIRS += \
         acv_lib \
         thirdparty \
         tests \
-        acv_gui
+        acv_gui \
+        acv_cli
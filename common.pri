@@ -48,3 +48,5 @@ LIBS += -L$${LIBS_PATH}/
 INCLUDEPATH += $${IMPORT_PATH}/
 
 linux-g++: QMAKE_CXXFLAGS += -std=c++11
+linux-g++: QMAKE_CXXFLAGS += -pthread
+linux-g++: QMAKE_LFLAGS += -pthread
@@ -0,0 +1,235 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "AImageTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+
+#include "AImage.h"
+#include "AImageFilter.h"
+#include "AImageCorrector.h"
+#include "AImageCombiner.h"
+
+// This class is used for testing of service image: sharing of pixels by copies and access to the pixels
+class AImageTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    AImageTests();
+
+private Q_SLOTS:
+
+    // Test of independence of copies which are changed by pixels
+    void CopyOnWrite();
+
+    // Test of independence of copies which are changed by the pointer to row
+    void RowPointerWrite();
+
+    // Test of processing where source and destination share the pixels
+    void SharedProcessing();
+
+    // Test of processing of moved source
+    void MovedSourceProcessing();
+
+    // Test of combining of copies and moved images
+    void Combining();
+
+private:
+
+    // Form the image with random pixels
+    AImage FormRandomImage(const int height, const int width);
+
+    // Make the image with own copy of pixels
+    static AImage CopyPixels(const AImage& img);
+
+    // Check the equality of pixels of two images
+    static bool IsEqual(const AImage& img1, const AImage& img2);
+
+    std::default_random_engine mEngine;
+
+};
+
+AImageTests::AImageTests()
+{
+}
+
+AImage AImageTests::FormRandomImage(const int height, const int width)
+{
+    std::uniform_int_distribution<int> di(AImage::MIN_PIXEL_VALUE, AImage::MAX_PIXEL_VALUE);
+
+    AImage img(height, width);
+    for (int row = 0; row < height; ++row)
+        for (int col = 0; col < width; ++col)
+            img.SetPixel(row, col, static_cast<AByte>(di(mEngine)));
+
+    return img;
+}
+
+AImage AImageTests::CopyPixels(const AImage& img)
+{
+    AImage copy(img.GetHeight(), img.GetWidth());
+    for (int row = 0; row < img.GetHeight(); ++row)
+        for (int col = 0; col < img.GetWidth(); ++col)
+            copy.SetPixel(row, col, img.GetPixel(row, col));
+
+    return copy;
+}
+
+bool AImageTests::IsEqual(const AImage& img1, const AImage& img2)
+{
+    if (img1.GetHeight() != img2.GetHeight() || img1.GetWidth() != img2.GetWidth())
+        return false;
+
+    for (int row = 0; row < img1.GetHeight(); ++row)
+        for (int col = 0; col < img1.GetWidth(); ++col)
+            if (img1.GetPixel(row, col) != img2.GetPixel(row, col))
+                return false;
+
+    return true;
+}
+
+void AImageTests::CopyOnWrite()
+{
+    AImage img = FormRandomImage(40, 30);
+    const AByte pixel = img.GetPixel(5, 7);
+
+    AImage copy(img);
+    const AImage& constImg = img;
+    const AImage& constCopy = copy;
+    QCOMPARE(constCopy.GetRowPointer(0) == constImg.GetRowPointer(0), true); // Pixels are shared
+
+    copy.SetPixel(5, 7, pixel ^ 0xFF);
+    QCOMPARE(img.GetPixel(5, 7), pixel);
+    QCOMPARE(copy.GetPixel(5, 7), static_cast<AByte>(pixel ^ 0xFF));
+
+    AImage assigned(1, 1);
+    assigned = img;
+    img.SetPixel(5, 7, 0);
+    QCOMPARE(assigned.GetPixel(5, 7), pixel);
+    QCOMPARE(img.GetPixel(5, 7), static_cast<AByte>(0));
+}
+
+void AImageTests::RowPointerWrite()
+{
+    AImage img = FormRandomImage(40, 30);
+    const AImage original(img);
+
+    AByte* pRow = img.GetRowPointer(3);
+    QCOMPARE(IsEqual(img, original), true);
+
+    AImage copy = img; // Pixels aren't shared with copy because the pointer was given
+    AImage assigned(1, 1);
+    assigned = img;
+
+    pRow[2] = original.GetPixel(3, 2) ^ 0xFF;
+    QCOMPARE(img.GetPixel(3, 2), static_cast<AByte>(original.GetPixel(3, 2) ^ 0xFF));
+    QCOMPARE(IsEqual(copy, original), true);
+    QCOMPARE(IsEqual(assigned, original), true);
+
+    // Copies are the ordinary images
+    AImage copyOfCopy = copy;
+    copyOfCopy.SetPixel(0, 0, original.GetPixel(0, 0) ^ 0xFF);
+    QCOMPARE(copy.GetPixel(0, 0), original.GetPixel(0, 0));
+}
+
+void AImageTests::SharedProcessing()
+{
+    const AImage img = FormRandomImage(60, 50);
+
+    AImage expected(img.GetHeight(), img.GetWidth());
+    QCOMPARE(AImageFilter::Filter(img, expected, AFilterType::MEDIAN, 3) == AFiltrationResult::SUCCESS, true);
+
+    // Destination shares the pixels with source
+    AImage dst(img);
+    QCOMPARE(AImageFilter::Filter(dst, dst, AFilterType::MEDIAN, 3) == AFiltrationResult::SUCCESS, true);
+    QCOMPARE(IsEqual(dst, expected), true);
+
+    AImage copy(img);
+    AImage copyDst(img);
+    QCOMPARE(AImageFilter::Filter(copy, copyDst, AFilterType::MEDIAN, 3) == AFiltrationResult::SUCCESS, true);
+    QCOMPARE(IsEqual(copyDst, expected), true);
+    QCOMPARE(IsEqual(copy, img), true);
+}
+
+void AImageTests::MovedSourceProcessing()
+{
+    const AImage img = FormRandomImage(60, 50);
+
+    AImage expected(img.GetHeight(), img.GetWidth());
+    QCOMPARE(AImageFilter::Filter(img, expected, AFilterType::SEP_GAUSSIAN, 5) == AFiltrationResult::SUCCESS, true);
+    QCOMPARE(AImageCorrector::Correct(expected, expected, ACorrectorType::GAMMA), true);
+
+    // Moved source shares the pixels with other image, so they must be kept
+    const AImage original = CopyPixels(img);
+    AImage src(img);
+    AImage dst(1, 1);
+    QCOMPARE(AImageFilter::Filter(std::move(src), dst, AFilterType::SEP_GAUSSIAN, 5) == AFiltrationResult::SUCCESS, true);
+    QCOMPARE(AImageCorrector::Correct(std::move(dst), dst, ACorrectorType::GAMMA), true);
+    QCOMPARE(IsEqual(dst, expected), true);
+    QCOMPARE(IsEqual(img, original), true);
+
+    AImage unique = FormRandomImage(60, 50);
+    AImage uniqueExpected(unique.GetHeight(), unique.GetWidth());
+    QCOMPARE(AImageFilter::Filter(unique, uniqueExpected, AFilterType::SEP_GAUSSIAN, 5) == AFiltrationResult::SUCCESS, true);
+    AImage uniqueDst(1, 1);
+    QCOMPARE(AImageFilter::Filter(std::move(unique), uniqueDst, AFilterType::SEP_GAUSSIAN, 5) == AFiltrationResult::SUCCESS, true);
+    QCOMPARE(IsEqual(uniqueDst, uniqueExpected), true);
+}
+
+void AImageTests::Combining()
+{
+    const AImage img1 = FormRandomImage(30, 30);
+    const AImage img2 = FormRandomImage(30, 30);
+
+    AImage expected(img1.GetHeight(), img1.GetWidth());
+    AImageCombiner combiner;
+    combiner.AddImage(img1);
+    combiner.AddImage(img2);
+    QCOMPARE(combiner.Combine(ACombineType::CALC_DIFF, expected) == ACombinationResult::SUCCESS, true);
+
+    // Changes of added images and destruction of moved images don't affect the combiner
+    AImage changed(img1);
+    AImage result(img1.GetHeight(), img1.GetWidth());
+    {
+        AImageCombiner otherCombiner;
+        otherCombiner.AddImage(changed);
+        otherCombiner.AddImage(AImage(img2));
+        changed.GetRowPointer(0)[0] ^= 0xFF;
+        changed.SetPixel(1, 1, changed.GetPixel(1, 1) ^ 0xFF);
+        QCOMPARE(otherCombiner.Combine(ACombineType::CALC_DIFF, result) == ACombinationResult::SUCCESS, true);
+    }
+    QCOMPARE(IsEqual(result, expected), true);
+
+    combiner.ClearImages();
+    combiner.AddImage(img1);
+    QCOMPARE(combiner.Combine(ACombineType::CALC_DIFF, result) == ACombinationResult::MANY_IMAGES, true);
+}
+
+QTEST_APPLESS_MAIN(AImageTests)
+
+#include "AImageTests.moc"
@@ -0,0 +1,348 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "BackgroundModelTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include "Image.h"
+#include "BinaryImage.h"
+#include "BackgroundModel.h"
+
+// This class is used for testing of background model: the masks and backgrounds are compared with the direct calculations
+class BackgroundModelTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    BackgroundModelTests();
+
+private Q_SLOTS:
+
+    // Test of running average model
+    void RunningAverage();
+
+    // Test of Gaussian model
+    void Gaussian();
+
+    // Test of median model
+    void Median();
+
+    // Test of binary masks of foreground
+    void BinaryMask();
+
+    // Test of detection of moving object
+    void MovingObject();
+
+    // Test of reset of model
+    void Reset();
+
+    // Test of absolute difference of images
+    void AbsDiff();
+
+    // Test of incorrect arguments
+    void IncorrectArguments();
+
+private:
+
+    // Frames of sequence
+    std::vector<acv::Image> mFrames;
+
+};
+
+// Sizes of frames (width isn't multiple of vectors) and their number
+static const int HEIGHT = 67, WIDTH = 133, NUM_FRAMES = 12;
+
+// Learning rate and thresholds of tested models
+static const float LEARNING_RATE = 0.1f, DIFF_THRESHOLD = 20.0f, SIGMA_THRESHOLD = 2.5f;
+
+// Number of fraction bits of running average of model
+static const int AVERAGE_FRACTION_BITS = 7;
+
+BackgroundModelTests::BackgroundModelTests()
+{
+    // Static scene with noise and the square which is moved from frame to frame
+    std::default_random_engine engine;
+    std::uniform_int_distribution<int> di(-20, 20);
+    for (int frame = 0; frame < NUM_FRAMES; ++frame)
+    {
+        acv::Image img(HEIGHT, WIDTH);
+        for (int row = 0; row < HEIGHT; ++row)
+            for (int col = 0; col < WIDTH; ++col)
+            {
+                const bool isObject = row >= 20 && row < 40 && col >= 5 + 8 * frame && col < 25 + 8 * frame;
+                int pixel = (isObject ? 245 : 40 + (col / 10) * 10) + di(engine);
+                acv::Image::CheckPixelValue(pixel);
+                img.SetPixel(row, col, static_cast<acv::Image::Byte>(pixel));
+            }
+        mFrames.push_back(img);
+    }
+}
+
+void BackgroundModelTests::RunningAverage()
+{
+    acv::BackgroundModel model;
+    QVERIFY(model.Configure(HEIGHT, WIDTH, acv::BackgroundModel::ModelType::RUNNING_AVERAGE, LEARNING_RATE, DIFF_THRESHOLD));
+
+    // Running average in fixed point format
+    const int rate = static_cast<int>(LEARNING_RATE * 65536.0f + 0.5f);
+    const int rounding = 1 << (AVERAGE_FRACTION_BITS - 1);
+    std::vector<int> average(HEIGHT * WIDTH);
+
+    acv::Image mask(HEIGHT, WIDTH), background(HEIGHT, WIDTH);
+    for (int frame = 0; frame < NUM_FRAMES; ++frame)
+    {
+        const acv::Image& img = mFrames[frame];
+        QVERIFY(model.Apply(img, mask));
+
+        for (int row = 0; row < HEIGHT; ++row)
+            for (int col = 0; col < WIDTH; ++col)
+            {
+                const int i = row * WIDTH + col;
+                const int pixel = img.GetPixel(row, col);
+                if (frame == 0)
+                {
+                    average[i] = pixel << AVERAGE_FRACTION_BITS;
+                    QCOMPARE(mask.GetPixel(row, col), acv::Image::MIN_PIXEL_VALUE);
+                    continue;
+                }
+
+                const int diff = std::abs(pixel - ((average[i] + rounding) >> AVERAGE_FRACTION_BITS));
+                QCOMPARE(mask.GetPixel(row, col), diff > DIFF_THRESHOLD ? acv::Image::MAX_PIXEL_VALUE : acv::Image::MIN_PIXEL_VALUE);
+
+                // The product is shifted arithmetically (it is rounded down)
+                average[i] += ((pixel << AVERAGE_FRACTION_BITS) - average[i]) * rate >> 16;
+            }
+
+        QVERIFY(model.GetBackground(background));
+        for (int row = 0; row < HEIGHT; ++row)
+            for (int col = 0; col < WIDTH; ++col)
+                QCOMPARE(static_cast<int>(background.GetPixel(row, col)),
+                         (average[row * WIDTH + col] + rounding) >> AVERAGE_FRACTION_BITS);
+    }
+
+    QCOMPARE(model.GetNumFrames(), NUM_FRAMES);
+}
+
+void BackgroundModelTests::Gaussian()
+{
+    acv::BackgroundModel model;
+    QVERIFY(model.Configure(HEIGHT, WIDTH, acv::BackgroundModel::ModelType::GAUSSIAN, LEARNING_RATE, SIGMA_THRESHOLD));
+
+    const float initialVariance = acv::BackgroundModel::INITIAL_STD_DEVIATION * acv::BackgroundModel::INITIAL_STD_DEVIATION;
+    const float minVariance = acv::BackgroundModel::MIN_STD_DEVIATION * acv::BackgroundModel::MIN_STD_DEVIATION;
+    const float sigmaThreshold2 = SIGMA_THRESHOLD * SIGMA_THRESHOLD;
+    std::vector<float> mean(HEIGHT * WIDTH), variance(HEIGHT * WIDTH, initialVariance);
+
+    acv::Image mask(HEIGHT, WIDTH), background(HEIGHT, WIDTH);
+    for (int frame = 0; frame < NUM_FRAMES; ++frame)
+    {
+        const acv::Image& img = mFrames[frame];
+        QVERIFY(model.Apply(img, mask));
+
+        for (int row = 0; row < HEIGHT; ++row)
+            for (int col = 0; col < WIDTH; ++col)
+            {
+                const int i = row * WIDTH + col;
+                const float pixel = img.GetPixel(row, col);
+                if (frame == 0)
+                {
+                    mean[i] = pixel;
+                    QCOMPARE(mask.GetPixel(row, col), acv::Image::MIN_PIXEL_VALUE);
+                    continue;
+                }
+
+                const float diff = pixel - mean[i];
+                const float diff2 = diff * diff;
+                QCOMPARE(mask.GetPixel(row, col),
+                         diff2 > sigmaThreshold2 * variance[i] ? acv::Image::MAX_PIXEL_VALUE : acv::Image::MIN_PIXEL_VALUE);
+
+                mean[i] += LEARNING_RATE * diff;
+                variance[i] = std::max(variance[i] + LEARNING_RATE * (diff2 - variance[i]), minVariance);
+            }
+
+        QVERIFY(model.GetBackground(background));
+        for (int row = 0; row < HEIGHT; ++row)
+            for (int col = 0; col < WIDTH; ++col)
+                QCOMPARE(static_cast<int>(background.GetPixel(row, col)), static_cast<int>(mean[row * WIDTH + col] + 0.5f));
+    }
+}
+
+void BackgroundModelTests::Median()
+{
+    acv::BackgroundModel model;
+    QVERIFY(model.Configure(HEIGHT, WIDTH, acv::BackgroundModel::ModelType::MEDIAN, LEARNING_RATE, DIFF_THRESHOLD));
+
+    acv::Image median = mFrames.front();
+    acv::Image mask(HEIGHT, WIDTH), background(HEIGHT, WIDTH);
+    for (int frame = 0; frame < NUM_FRAMES; ++frame)
+    {
+        const acv::Image& img = mFrames[frame];
+        QVERIFY(model.Apply(img, mask));
+
+        for (int row = 0; row < HEIGHT; ++row)
+            for (int col = 0; col < WIDTH; ++col)
+            {
+                const int pixel = img.GetPixel(row, col);
+                const int value = median.GetPixel(row, col);
+                const bool isForeground = frame > 0 && std::abs(pixel - value) > DIFF_THRESHOLD;
+                QCOMPARE(mask.GetPixel(row, col), isForeground ? acv::Image::MAX_PIXEL_VALUE : acv::Image::MIN_PIXEL_VALUE);
+
+                // The median is moved to pixel by one level
+                median.SetPixel(row, col, static_cast<acv::Image::Byte>(value + (pixel > value) - (pixel < value)));
+            }
+
+        QVERIFY(model.GetBackground(background));
+        QVERIFY(background == median);
+    }
+}
+
+void BackgroundModelTests::BinaryMask()
+{
+    const acv::BackgroundModel::ModelType types[] =
+    {
+        acv::BackgroundModel::ModelType::RUNNING_AVERAGE,
+        acv::BackgroundModel::ModelType::GAUSSIAN,
+        acv::BackgroundModel::ModelType::MEDIAN
+    };
+
+    for (const auto type : types)
+    {
+        // The same sequence is added to two models with masks of both types
+        acv::BackgroundModel model, binaryModel;
+        QVERIFY(model.Configure(HEIGHT, WIDTH, type, LEARNING_RATE));
+        QVERIFY(binaryModel.Configure(HEIGHT, WIDTH, type, LEARNING_RATE));
+
+        acv::Image mask(HEIGHT, WIDTH), converted(HEIGHT, WIDTH);
+        acv::BinaryImage binaryMask(HEIGHT, WIDTH);
+        for (const acv::Image& img : mFrames)
+        {
+            QVERIFY(model.Apply(img, mask));
+            QVERIFY(binaryModel.Apply(img, binaryMask));
+            QVERIFY(binaryMask.ConvertToImage(converted));
+            QVERIFY(converted == mask);
+        }
+    }
+}
+
+void BackgroundModelTests::MovingObject()
+{
+    acv::BackgroundModel model;
+    QVERIFY(model.Configure(HEIGHT, WIDTH, acv::BackgroundModel::ModelType::RUNNING_AVERAGE, LEARNING_RATE, 80.0f));
+
+    // The difference of bright object and scene exceeds the threshold, the noise doesn't exceed it
+    acv::Image mask(HEIGHT, WIDTH);
+    QVERIFY(model.Apply(mFrames[0], mask));
+    QVERIFY(model.Apply(mFrames[4], mask));
+
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+        {
+            const bool isObject = row >= 20 && row < 40 && col >= 5 + 8 * 4 && col < 25 + 8 * 4;
+            const bool isPreviousObject = row >= 20 && row < 40 && col >= 5 && col < 25;
+            QCOMPARE(mask.GetPixel(row, col) == acv::Image::MAX_PIXEL_VALUE, isObject || isPreviousObject);
+        }
+}
+
+void BackgroundModelTests::Reset()
+{
+    acv::BackgroundModel model;
+    QVERIFY(model.Configure(HEIGHT, WIDTH, acv::BackgroundModel::ModelType::MEDIAN));
+
+    acv::Image mask(HEIGHT, WIDTH), background(HEIGHT, WIDTH);
+    QVERIFY(model.Apply(mFrames[0], mask));
+    QVERIFY(model.Apply(mFrames[1], mask));
+    QCOMPARE(model.GetNumFrames(), 2);
+
+    // The next frame after reset initializes the model
+    model.Reset();
+    QCOMPARE(model.GetNumFrames(), 0);
+    QVERIFY(model.Apply(mFrames[5], mask));
+    QCOMPARE(model.GetNumFrames(), 1);
+    QVERIFY(model.GetBackground(background));
+    QVERIFY(background == mFrames[5]);
+
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+            QCOMPARE(mask.GetPixel(row, col), acv::Image::MIN_PIXEL_VALUE);
+}
+
+void BackgroundModelTests::AbsDiff()
+{
+    const acv::Image& lhs = mFrames[0];
+    const acv::Image& rhs = mFrames[3];
+
+    acv::Image diff(HEIGHT, WIDTH);
+    QVERIFY(acv::Image::AbsDiff(lhs, rhs, diff));
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+            QCOMPARE(static_cast<int>(diff.GetPixel(row, col)), std::abs(lhs.GetPixel(row, col) - rhs.GetPixel(row, col)));
+
+    // Destination is one of sources
+    acv::Image inPlace = lhs;
+    QVERIFY(acv::Image::AbsDiff(inPlace, rhs, inPlace));
+    QVERIFY(inPlace == diff);
+
+    // Different sizes
+    acv::Image small(HEIGHT, WIDTH - 1);
+    QVERIFY(!acv::Image::AbsDiff(lhs, small, diff));
+    QVERIFY(!acv::Image::AbsDiff(lhs, rhs, small));
+}
+
+void BackgroundModelTests::IncorrectArguments()
+{
+    acv::BackgroundModel model;
+    acv::Image mask(HEIGHT, WIDTH), background(HEIGHT, WIDTH);
+
+    // Not configured model
+    QVERIFY(!model.IsConfigured());
+    QVERIFY(!model.Apply(mFrames[0], mask));
+    QVERIFY(!model.GetBackground(background));
+
+    // Incorrect sizes and learning rates
+    QVERIFY(!model.Configure(0, WIDTH, acv::BackgroundModel::ModelType::MEDIAN));
+    QVERIFY(!model.Configure(HEIGHT, WIDTH, acv::BackgroundModel::ModelType::GAUSSIAN, 0.0f));
+    QVERIFY(!model.Configure(HEIGHT, WIDTH, acv::BackgroundModel::ModelType::RUNNING_AVERAGE, 0.7f));
+    QVERIFY(!model.IsConfigured());
+
+    // Frames and masks of other sizes
+    QVERIFY(model.Configure(HEIGHT, WIDTH, acv::BackgroundModel::ModelType::RUNNING_AVERAGE));
+    acv::Image small(HEIGHT - 1, WIDTH);
+    acv::BinaryImage smallBinary(HEIGHT, WIDTH - 1);
+    QVERIFY(!model.Apply(small, mask));
+    QVERIFY(!model.Apply(mFrames[0], small));
+    QVERIFY(!model.Apply(mFrames[0], smallBinary));
+    QVERIFY(!model.GetBackground(small));
+    QCOMPARE(model.GetNumFrames(), 0);
+}
+
+QTEST_APPLESS_MAIN(BackgroundModelTests)
+
+#include "BackgroundModelTests.moc"
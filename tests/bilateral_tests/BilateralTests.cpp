@@ -0,0 +1,207 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "BilateralTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#include "Image.h"
+#include "ImageFilter.h"
+
+// This class is used for testing of bilateral filter: the results are compared with the brute-force bilateral filtration
+class BilateralTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    BilateralTests();
+
+private Q_SLOTS:
+
+    // Test of filtration against the brute-force filtration
+    void BruteForce();
+
+    // Test of filtration in place and by type of filter
+    void InPlaceAndFilterType();
+
+    // Test of filtration of image of one brightness
+    void ConstantImage();
+
+    // Test of preservation of edges and smoothing of noise
+    void EdgePreservation();
+
+    // Test of incorrect arguments
+    void IncorrectArguments();
+
+private:
+
+    // Calculate the bilateral filtration of pixel by the window of three spatial sigmas
+    static int FilterPixel(const acv::Image& img, const int row, const int col, const float spatialSigma, const float rangeSigma);
+
+    acv::Image mImage;
+
+};
+
+// Sizes of image and height of rows of blocks
+static const int HEIGHT = 120, WIDTH = 150, BLOCK_HEIGHT = 30;
+
+// Brightness of blocks and amplitude of noise
+static const int DARK = 70, BRIGHT = 180, NOISE = 15;
+
+BilateralTests::BilateralTests()
+    : mImage(HEIGHT, WIDTH)
+{
+    // Blocks with noise
+    std::default_random_engine engine;
+    std::uniform_int_distribution<int> di(-NOISE, NOISE);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+        {
+            const int pixel = ((row / BLOCK_HEIGHT + col / 40) % 2 ? BRIGHT : DARK) + di(engine);
+            mImage.SetPixel(row, col, static_cast<acv::Image::Byte>(pixel));
+        }
+}
+
+int BilateralTests::FilterPixel(const acv::Image& img, const int row, const int col, const float spatialSigma, const float rangeSigma)
+{
+    const int radius = static_cast<int>(std::ceil(3 * spatialSigma));
+    const int pixel = img.GetPixel(row, col);
+
+    double sum = 0.0, sumWeights = 0.0;
+    for (int relRow = -radius; relRow <= radius; ++relRow)
+        for (int relCol = -radius; relCol <= radius; ++relCol)
+        {
+            const int curRow = row + relRow, curCol = col + relCol;
+            if (curRow < 0 || curCol < 0 || curRow >= img.GetHeight() || curCol >= img.GetWidth())
+                continue;
+
+            const int value = img.GetPixel(curRow, curCol);
+            const double weight = std::exp(-(relRow * relRow + relCol * relCol) / (2.0 * spatialSigma * spatialSigma)) *
+                                  std::exp(-(value - pixel) * (value - pixel) / (2.0 * rangeSigma * rangeSigma));
+            sum += weight * value;
+            sumWeights += weight;
+        }
+
+    return static_cast<int>(sum / sumWeights + 0.5);
+}
+
+void BilateralTests::BruteForce()
+{
+    const struct
+    {
+        float spatialSigma;
+        float rangeSigma;
+    } sigmas[] = { { 1.5f, 20.0f }, { 1.5f, 40.0f }, { 3.0f, 20.0f }, { 3.0f, 40.0f } };
+
+    for (const auto& sigma : sigmas)
+    {
+        acv::Image result(HEIGHT, WIDTH);
+        QCOMPARE(acv::ImageFilter::Bilateral(mImage, result, sigma.spatialSigma, sigma.rangeSigma), acv::FiltrationResult::SUCCESS);
+
+        // The levels of brightness and IIR-filter approximate the filtration, the pixels of borders of image are not compared
+        // (IIR-filter and the brute-force filtration process them differently)
+        const int margin = static_cast<int>(std::ceil(3 * sigma.spatialSigma));
+        int maxDiff = 0;
+        double sumDiffs = 0.0;
+        for (int row = margin; row < HEIGHT - margin; ++row)
+            for (int col = margin; col < WIDTH - margin; ++col)
+            {
+                const int diff = std::abs(result.GetPixel(row, col) - FilterPixel(mImage, row, col, sigma.spatialSigma, sigma.rangeSigma));
+                maxDiff = std::max(maxDiff, diff);
+                sumDiffs += diff;
+            }
+
+        QVERIFY(maxDiff <= 6);
+        QVERIFY(sumDiffs / ((HEIGHT - 2 * margin) * (WIDTH - 2 * margin)) <= 0.5);
+    }
+}
+
+void BilateralTests::InPlaceAndFilterType()
+{
+    const int filterSize = 13;
+    const float spatialSigma = static_cast<float>(filterSize / 6.0);
+
+    acv::Image expected(HEIGHT, WIDTH);
+    QCOMPARE(acv::ImageFilter::Bilateral(mImage, expected, spatialSigma), acv::FiltrationResult::SUCCESS);
+
+    acv::Image inPlace = mImage;
+    QCOMPARE(acv::ImageFilter::Bilateral(inPlace, inPlace, spatialSigma), acv::FiltrationResult::SUCCESS);
+    QVERIFY(inPlace == expected);
+
+    // Type of filter uses the spatial sigma filterSize / 6 and default range sigma
+    acv::Image filtered(HEIGHT, WIDTH);
+    QCOMPARE(acv::ImageFilter::Filter(mImage, filtered, acv::ImageFilter::FilterType::BILATERAL, filterSize), acv::FiltrationResult::SUCCESS);
+    QVERIFY(filtered == expected);
+}
+
+void BilateralTests::ConstantImage()
+{
+    acv::Image img(HEIGHT, WIDTH);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+            img.SetPixel(row, col, 123);
+
+    acv::Image result(HEIGHT, WIDTH);
+    QCOMPARE(acv::ImageFilter::Bilateral(img, result, 2.0f, 20.0f), acv::FiltrationResult::SUCCESS);
+    QVERIFY(result == img);
+}
+
+void BilateralTests::EdgePreservation()
+{
+    acv::Image bilateral(HEIGHT, WIDTH), gaussian(HEIGHT, WIDTH);
+    QCOMPARE(acv::ImageFilter::Bilateral(mImage, bilateral, 3.0f, 20.0f), acv::FiltrationResult::SUCCESS);
+    QCOMPARE(acv::ImageFilter::Filter(mImage, gaussian, acv::ImageFilter::FilterType::SEP_GAUSSIAN, 19), acv::FiltrationResult::SUCCESS);
+
+    // Pixels of the rows near the horizontal edge between blocks keep the brightness of their blocks
+    // and the noise is smoothed
+    const int col = 20;
+    for (int row = BLOCK_HEIGHT - 3; row < BLOCK_HEIGHT + 3; ++row)
+    {
+        const int expected = (row < BLOCK_HEIGHT) ? DARK : BRIGHT;
+        QVERIFY(std::abs(bilateral.GetPixel(row, col) - expected) < NOISE / 2);
+    }
+
+    // Gaussian blur mixes the blocks near the edge
+    QVERIFY(std::abs(gaussian.GetPixel(BLOCK_HEIGHT - 1, col) - DARK) > 3 * NOISE);
+}
+
+void BilateralTests::IncorrectArguments()
+{
+    acv::Image result(HEIGHT, WIDTH), small(HEIGHT - 1, WIDTH);
+
+    QCOMPARE(acv::ImageFilter::Bilateral(mImage, result, 0.5f), acv::FiltrationResult::SMALL_FILTER_SIZE);
+    QCOMPARE(acv::ImageFilter::Bilateral(mImage, result, 2.0f, 0.0f), acv::FiltrationResult::INCORRECT_FILTER_SIZE);
+    QCOMPARE(acv::ImageFilter::Bilateral(mImage, small, 2.0f), acv::FiltrationResult::INTERNAL_ERROR);
+    QCOMPARE(acv::ImageFilter::Filter(mImage, result, acv::ImageFilter::FilterType::BILATERAL, 5), acv::FiltrationResult::SMALL_FILTER_SIZE);
+}
+
+QTEST_APPLESS_MAIN(BilateralTests)
+
+#include "BilateralTests.moc"
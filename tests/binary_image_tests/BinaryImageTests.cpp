@@ -0,0 +1,449 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "BinaryImageTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "Image.h"
+#include "BinaryImage.h"
+#include "LabelImage.h"
+#include "MorphologyFilter.h"
+#include "ImageFilter.h"
+#include "BordersDetector.h"
+
+// This class is used for testing of bit-packed binary image: the results are compared with the same operations
+// of one-channel images of bytes
+class BinaryImageTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    BinaryImageTests();
+
+private Q_SLOTS:
+
+    // Test of packing and unpacking of pixels
+    void PackUnpack();
+
+    // Test of logical operations
+    void LogicalOperations();
+
+    // Test of area and runs of set pixels
+    void AreaAndRuns();
+
+    // Test of binary morphology
+    void Morphology();
+
+    // Test of labeling of connected components
+    void ConnectedComponents();
+
+    // Test of adaptive threshold to binary image
+    void AdaptiveThreshold();
+
+    // Test of detection of borders to binary map
+    void DetectBorders();
+
+    // Test of incorrect arguments
+    void IncorrectArguments();
+
+private:
+
+    // Form the image of bytes with random set pixels (density is the probability of set pixel)
+    acv::Image FormRandomMask(const int height, const int width, const double density);
+
+    // Form the image with random pixels
+    acv::Image FormRandomImage(const int height, const int width);
+
+    std::default_random_engine mEngine;
+
+};
+
+typedef acv::MorphologyFilter::MorphologyType MorphologyType;
+
+// Widths of images which check rows of one word, the full words and the partial last word
+static const int WIDTHS[] = { 1, 13, 63, 64, 65, 128, 200 };
+
+// Sizes of structuring element which check one step of shifts and several steps
+static const int SE_SIZES[][2] = { { 1, 1 }, { 3, 3 }, { 5, 1 }, { 1, 7 }, { 9, 9 }, { 65, 3 }, { 21, 31 } };
+
+// Labeling of connected components (8-connectivity) of non-zero pixels by flood fill in raster order
+static std::vector<int> LabelByFloodFill(const acv::Image& img, int& numLabels)
+{
+    const int height = img.GetHeight(), width = img.GetWidth();
+    std::vector<int> labels(static_cast<size_t>(height) * width, 0);
+    std::vector<int> stack;
+
+    numLabels = 0;
+    for (int row = 0; row < height; ++row)
+        for (int col = 0; col < width; ++col)
+        {
+            if (img.GetPixel(row, col) == acv::Image::MIN_PIXEL_VALUE || labels[row * width + col] != 0)
+                continue;
+
+            ++numLabels;
+            labels[row * width + col] = numLabels;
+            stack.push_back(row * width + col);
+            while (!stack.empty())
+            {
+                const int y = stack.back() / width, x = stack.back() % width;
+                stack.pop_back();
+
+                for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, height - 1); ++ny)
+                    for (int nx = std::max(x - 1, 0); nx <= std::min(x + 1, width - 1); ++nx)
+                        if (img.GetPixel(ny, nx) != acv::Image::MIN_PIXEL_VALUE && labels[ny * width + nx] == 0)
+                        {
+                            labels[ny * width + nx] = numLabels;
+                            stack.push_back(ny * width + nx);
+                        }
+            }
+        }
+
+    return labels;
+}
+
+// Convert the binary image to the image of bytes pixel by pixel
+static acv::Image ConvertByPixels(const acv::BinaryImage& img)
+{
+    acv::Image result(img.GetHeight(), img.GetWidth());
+    for (int row = 0; row < img.GetHeight(); ++row)
+        for (int col = 0; col < img.GetWidth(); ++col)
+            result.SetPixel(row, col, img.GetPixel(row, col) ? acv::Image::MAX_PIXEL_VALUE : acv::Image::MIN_PIXEL_VALUE);
+
+    return result;
+}
+
+// Check that the unused bits of the last word of each row are cleared
+static bool CheckUnusedBits(const acv::BinaryImage& img)
+{
+    const acv::BinaryImage::Word lastWordMask = img.GetLastWordMask();
+    for (int row = 0; row < img.GetHeight(); ++row)
+        if ((img.GetRow(row)[img.GetWordsPerRow() - 1] & ~lastWordMask) != 0)
+            return false;
+
+    return true;
+}
+
+BinaryImageTests::BinaryImageTests()
+{
+}
+
+acv::Image BinaryImageTests::FormRandomMask(const int height, const int width, const double density)
+{
+    std::bernoulli_distribution di(density);
+
+    acv::Image img(height, width);
+    for (acv::Image::Byte& pixel : img.GetData())
+        pixel = di(mEngine) ? acv::Image::MAX_PIXEL_VALUE : acv::Image::MIN_PIXEL_VALUE;
+
+    return img;
+}
+
+acv::Image BinaryImageTests::FormRandomImage(const int height, const int width)
+{
+    std::uniform_int_distribution<int> di(acv::Image::MIN_PIXEL_VALUE, acv::Image::MAX_PIXEL_VALUE);
+
+    acv::Image img(height, width);
+    for (acv::Image::Byte& pixel : img.GetData())
+        pixel = static_cast<acv::Image::Byte>(di(mEngine));
+
+    return img;
+}
+
+void BinaryImageTests::PackUnpack()
+{
+    for (const int width : WIDTHS)
+    {
+        const acv::Image mask = FormRandomMask(7, width, 0.5);
+
+        const acv::BinaryImage img(mask);
+        QCOMPARE(img.GetWordsPerRow(), (width + acv::BinaryImage::BITS_PER_WORD - 1) / acv::BinaryImage::BITS_PER_WORD);
+        QCOMPARE(CheckUnusedBits(img), true);
+        QCOMPARE(ConvertByPixels(img) == mask, true);
+
+        acv::Image converted(mask.GetHeight(), width);
+        QCOMPARE(img.ConvertToImage(converted), true);
+        QCOMPARE(converted == mask, true);
+
+        // Any non-zero byte is a set pixel
+        acv::Image grayMask(mask);
+        for (acv::Image::Byte& pixel : grayMask.GetData())
+            if (pixel != acv::Image::MIN_PIXEL_VALUE)
+                pixel = 17;
+        QCOMPARE(acv::BinaryImage(grayMask) == img, true);
+
+        // Packing by rows and pixels
+        acv::BinaryImage packed(mask.GetHeight(), width), byPixels(mask.GetHeight(), width);
+        for (int row = 0; row < mask.GetHeight(); ++row)
+        {
+            packed.PackRow(row, mask.GetRawPointer(row * width));
+            for (int col = 0; col < width; ++col)
+                byPixels.SetPixel(row, col, mask.GetPixel(row, col) != acv::Image::MIN_PIXEL_VALUE);
+        }
+        QCOMPARE(packed == img, true);
+        QCOMPARE(byPixels == img, true);
+
+        // Unpacking with specified values
+        std::vector<acv::Image::Byte> unpacked(width);
+        for (int row = 0; row < mask.GetHeight(); ++row)
+        {
+            img.UnpackRow(row, unpacked.data(), 200, 10);
+            for (int col = 0; col < width; ++col)
+                QCOMPARE(unpacked[col], mask.GetPixel(row, col) != acv::Image::MIN_PIXEL_VALUE ? acv::Image::Byte(200) : acv::Image::Byte(10));
+        }
+
+        byPixels.Clear();
+        QCOMPARE(byPixels.CountPixels(), size_t(0));
+        QCOMPARE(byPixels == acv::BinaryImage(mask.GetHeight(), width), true);
+    }
+}
+
+void BinaryImageTests::LogicalOperations()
+{
+    for (const int width : WIDTHS)
+    {
+        const acv::Image lhsMask = FormRandomMask(9, width, 0.5);
+        const acv::Image rhsMask = FormRandomMask(9, width, 0.3);
+        const acv::BinaryImage lhs(lhsMask), rhs(rhsMask);
+
+        acv::Image andMask(lhsMask), orMask(lhsMask), xorMask(lhsMask), invMask(lhsMask);
+        for (size_t i = 0; i < lhsMask.GetData().size(); ++i)
+        {
+            const bool l = lhsMask.GetData()[i] != acv::Image::MIN_PIXEL_VALUE;
+            const bool r = rhsMask.GetData()[i] != acv::Image::MIN_PIXEL_VALUE;
+            andMask.GetData()[i] = (l && r) ? acv::Image::MAX_PIXEL_VALUE : acv::Image::MIN_PIXEL_VALUE;
+            orMask.GetData()[i] = (l || r) ? acv::Image::MAX_PIXEL_VALUE : acv::Image::MIN_PIXEL_VALUE;
+            xorMask.GetData()[i] = (l != r) ? acv::Image::MAX_PIXEL_VALUE : acv::Image::MIN_PIXEL_VALUE;
+            invMask.GetData()[i] = !l ? acv::Image::MAX_PIXEL_VALUE : acv::Image::MIN_PIXEL_VALUE;
+        }
+
+        acv::BinaryImage result(lhs.GetHeight(), width);
+        QCOMPARE(acv::BinaryImage::And(lhs, rhs, result), true);
+        QCOMPARE(ConvertByPixels(result) == andMask, true);
+        QCOMPARE(acv::BinaryImage::Or(lhs, rhs, result), true);
+        QCOMPARE(ConvertByPixels(result) == orMask, true);
+        QCOMPARE(acv::BinaryImage::Xor(lhs, rhs, result), true);
+        QCOMPARE(ConvertByPixels(result) == xorMask, true);
+
+        // Inversion shouldn't set the unused bits of the last word
+        QCOMPARE(acv::BinaryImage::Invert(lhs, result), true);
+        QCOMPARE(CheckUnusedBits(result), true);
+        QCOMPARE(ConvertByPixels(result) == invMask, true);
+
+        // Destination is one of sources
+        acv::BinaryImage inPlace(lhs);
+        QCOMPARE(acv::BinaryImage::Xor(inPlace, rhs, inPlace), true);
+        QCOMPARE(ConvertByPixels(inPlace) == xorMask, true);
+        QCOMPARE(acv::BinaryImage::Invert(inPlace, inPlace), true);
+        QCOMPARE(acv::BinaryImage::Invert(inPlace, inPlace), true);
+        QCOMPARE(ConvertByPixels(inPlace) == xorMask, true);
+    }
+}
+
+void BinaryImageTests::AreaAndRuns()
+{
+    for (const int width : WIDTHS)
+    {
+        const acv::Image mask = FormRandomMask(11, width, 0.6);
+        const acv::BinaryImage img(mask);
+
+        size_t area = 0;
+        for (const acv::Image::Byte pixel : mask.GetData())
+            if (pixel != acv::Image::MIN_PIXEL_VALUE)
+                ++area;
+        QCOMPARE(img.CountPixels(), area);
+
+        std::vector<acv::BinaryImage::Run> runs;
+        for (int row = 0; row < mask.GetHeight(); ++row)
+        {
+            // Runs of set pixels by direct scan of row
+            std::vector<std::pair<int, int>> expectedRuns;
+            for (int col = 0; col < width; ++col)
+                if (mask.GetPixel(row, col) != acv::Image::MIN_PIXEL_VALUE)
+                {
+                    if (col == 0 || mask.GetPixel(row, col - 1) == acv::Image::MIN_PIXEL_VALUE)
+                        expectedRuns.push_back(std::make_pair(col, col));
+                    else
+                        expectedRuns.back().second = col;
+                }
+
+            img.FindRuns(row, runs);
+            QCOMPARE(runs.size(), expectedRuns.size());
+            for (size_t i = 0; i < runs.size(); ++i)
+            {
+                QCOMPARE(runs[i].startX, expectedRuns[i].first);
+                QCOMPARE(runs[i].finishX, expectedRuns[i].second);
+            }
+        }
+    }
+
+    // Run through the borders of words
+    acv::BinaryImage img(1, 200);
+    for (int col = 60; col < 140; ++col)
+        img.SetPixel(0, col, true);
+
+    std::vector<acv::BinaryImage::Run> runs;
+    img.FindRuns(0, runs);
+    QCOMPARE(runs.size(), size_t(1));
+    QCOMPARE(runs[0].startX, 60);
+    QCOMPARE(runs[0].finishX, 139);
+}
+
+void BinaryImageTests::Morphology()
+{
+    const MorphologyType TYPES[] = { MorphologyType::EROSION, MorphologyType::DILATION, MorphologyType::OPENING, MorphologyType::CLOSING };
+
+    for (const int width : { 13, 64, 150 })
+    {
+        const acv::Image mask = FormRandomMask(47, width, 0.5);
+        const acv::BinaryImage img(mask);
+
+        for (const auto& size : SE_SIZES)
+            for (const MorphologyType type : TYPES)
+            {
+                acv::Image expected(mask.GetHeight(), width);
+                QCOMPARE(acv::MorphologyFilter::Filter(mask, expected, type, size[0], size[1]), acv::FiltrationResult::SUCCESS);
+
+                acv::BinaryImage result(img.GetHeight(), width);
+                QCOMPARE(acv::MorphologyFilter::Filter(img, result, type, size[0], size[1]), acv::FiltrationResult::SUCCESS);
+                QCOMPARE(CheckUnusedBits(result), true);
+                QCOMPARE(ConvertByPixels(result) == expected, true);
+
+                acv::BinaryImage inPlace(img);
+                QCOMPARE(acv::MorphologyFilter::Filter(inPlace, type, size[0], size[1]), acv::FiltrationResult::SUCCESS);
+                QCOMPARE(inPlace == result, true);
+            }
+    }
+}
+
+void BinaryImageTests::ConnectedComponents()
+{
+    for (const int width : WIDTHS)
+        for (const double density : { 0.2, 0.45, 0.7 })
+        {
+            const acv::Image mask = FormRandomMask(37, width, density);
+
+            int numLabels = 0;
+            const std::vector<int> expected = LabelByFloodFill(mask, numLabels);
+
+            acv::LabelImage labels;
+            QCOMPARE(acv::LabelImage::LabelConnectedComponents(acv::BinaryImage(mask), labels), true);
+            QCOMPARE(labels.GetNumLabels(), numLabels);
+            QCOMPARE(labels.GetData() == expected, true);
+
+            // The labels are the same as for the image of bytes
+            acv::LabelImage byteLabels;
+            QCOMPARE(acv::LabelImage::LabelConnectedComponents(mask, byteLabels), true);
+            QCOMPARE(byteLabels.GetData() == labels.GetData(), true);
+        }
+}
+
+void BinaryImageTests::AdaptiveThreshold()
+{
+    typedef acv::ImageFilter::ThresholdType ThresholdType;
+    typedef acv::ImageFilter::ThresholdMethod ThresholdMethod;
+
+    const acv::Image img = FormRandomImage(71, 130);
+
+    for (const int filterSize : { 3, 15, 41 })
+        for (const ThresholdType type : { ThresholdType::MAX_MORE_THRESHOLD, ThresholdType::MIN_MORE_THRESHOLD })
+        {
+            acv::Image expected(img.GetHeight(), img.GetWidth());
+            acv::BinaryImage result(img.GetHeight(), img.GetWidth());
+
+            QCOMPARE(acv::ImageFilter::AdaptiveThreshold(img, expected, filterSize, 5, type), true);
+            QCOMPARE(acv::ImageFilter::AdaptiveThreshold(img, result, filterSize, 5, type), true);
+            QCOMPARE(ConvertByPixels(result) == expected, true);
+
+            QCOMPARE(acv::ImageFilter::AdaptiveThreshold(img, expected, filterSize, -0.2f, ThresholdMethod::NIBLACK, type), true);
+            QCOMPARE(acv::ImageFilter::AdaptiveThreshold(img, result, filterSize, -0.2f, ThresholdMethod::NIBLACK, type), true);
+            QCOMPARE(ConvertByPixels(result) == expected, true);
+
+            QCOMPARE(acv::ImageFilter::AdaptiveThreshold(img, expected, filterSize, 0.3f, ThresholdMethod::SAUVOLA, type), true);
+            QCOMPARE(acv::ImageFilter::AdaptiveThreshold(img, result, filterSize, 0.3f, ThresholdMethod::SAUVOLA, type), true);
+            QCOMPARE(ConvertByPixels(result) == expected, true);
+        }
+}
+
+void BinaryImageTests::DetectBorders()
+{
+    typedef acv::BordersDetector::DetectorType DetectorType;
+
+    // Smooth image with bright rectangle, so the borders are not only noise
+    acv::Image img = FormRandomImage(90, 140);
+    for (int row = 0; row < img.GetHeight(); ++row)
+        for (int col = 0; col < img.GetWidth(); ++col)
+        {
+            const bool inside = row >= 20 && row < 70 && col >= 30 && col < 100;
+            img.SetPixel(row, col, static_cast<acv::Image::Byte>((inside ? 180 : 60) + img.GetPixel(row, col) / 16));
+        }
+
+    for (const DetectorType type : { DetectorType::CANNY, DetectorType::CANNY_BILATERAL })
+    {
+        acv::Image expected(img.GetHeight(), img.GetWidth());
+        acv::BinaryImage result(img.GetHeight(), img.GetWidth());
+
+        QCOMPARE(acv::BordersDetector::DetectBorders(img, expected, type), true);
+        QCOMPARE(acv::BordersDetector::DetectBorders(img, result, type), true);
+        QCOMPARE(ConvertByPixels(result) == expected, true);
+        QCOMPARE(result.CountPixels() > 0, true);
+    }
+
+    // Only Canny detectors form the binary map
+    acv::BinaryImage result(img.GetHeight(), img.GetWidth());
+    QCOMPARE(acv::BordersDetector::DetectBorders(img, result, DetectorType::SOBEL), false);
+}
+
+void BinaryImageTests::IncorrectArguments()
+{
+    const acv::BinaryImage img(10, 70);
+    acv::BinaryImage wrongSizeImg(10, 71);
+
+    QCOMPARE(acv::BinaryImage::And(img, img, wrongSizeImg), false);
+    QCOMPARE(acv::BinaryImage::Or(img, wrongSizeImg, wrongSizeImg), false);
+    QCOMPARE(acv::BinaryImage::Xor(wrongSizeImg, img, wrongSizeImg), false);
+    QCOMPARE(acv::BinaryImage::Invert(img, wrongSizeImg), false);
+
+    QCOMPARE(acv::MorphologyFilter::Filter(img, wrongSizeImg, MorphologyType::EROSION, 3, 3), acv::FiltrationResult::INTERNAL_ERROR);
+    acv::BinaryImage result(10, 70);
+    QCOMPARE(acv::MorphologyFilter::Filter(img, result, MorphologyType::EROSION, 4, 3), acv::FiltrationResult::INCORRECT_FILTER_SIZE);
+
+    acv::Image converted(10, 71);
+    QCOMPARE(img.ConvertToImage(converted), false);
+
+    QCOMPARE(acv::ImageFilter::AdaptiveThreshold(acv::Image(10, 70), wrongSizeImg, 3, 5,
+                                                 acv::ImageFilter::ThresholdType::MAX_MORE_THRESHOLD), false);
+
+    acv::LabelImage labels;
+    QCOMPARE(acv::LabelImage::LabelConnectedComponents(acv::BinaryImage(), labels), false);
+}
+
+QTEST_APPLESS_MAIN(BinaryImageTests)
+
+#include "BinaryImageTests.moc"
@@ -0,0 +1,202 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "BoundedQueueTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <thread>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+
+#include "BoundedQueue.h"
+
+// This class is used for testing of bounded queue which connects the stages of batch processing
+class BoundedQueueTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    BoundedQueueTests();
+
+private Q_SLOTS:
+
+    // Test of order of items in one thread
+    void Order();
+
+    // Test of producers and consumers in several threads
+    void ProducersConsumers();
+
+    // Test of limit of number of items
+    void Capacity();
+
+    // Test of closing of queue
+    void Close();
+
+    // Test of items which can only be moved
+    void MoveOnlyItems();
+
+};
+
+BoundedQueueTests::BoundedQueueTests()
+{
+}
+
+void BoundedQueueTests::Order()
+{
+    BoundedQueue<int> queue(10);
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(queue.Push(int(i)), true);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        int item = -1;
+        QCOMPARE(queue.Pop(item), true);
+        QCOMPARE(item, i);
+    }
+}
+
+void BoundedQueueTests::ProducersConsumers()
+{
+    const int NUM_PRODUCERS = 4, NUM_CONSUMERS = 3, NUM_ITEMS = 10000;
+
+    BoundedQueue<int> queue(8);
+    std::vector<std::atomic<int>> counts(NUM_PRODUCERS * NUM_ITEMS);
+    for (auto& count : counts)
+        count = 0;
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < NUM_CONSUMERS; ++i)
+        consumers.emplace_back([&]()
+        {
+            int item;
+            while (queue.Pop(item))
+                ++counts[item];
+        });
+
+    std::vector<std::thread> producers;
+    for (int i = 0; i < NUM_PRODUCERS; ++i)
+        producers.emplace_back([&queue, i]()
+        {
+            for (int itemNum = 0; itemNum < NUM_ITEMS; ++itemNum)
+                queue.Push(i * NUM_ITEMS + itemNum);
+        });
+
+    for (auto& producer : producers)
+        producer.join();
+
+    // The consumers get all remaining items after closing
+    queue.Close();
+    for (auto& consumer : consumers)
+        consumer.join();
+
+    bool isEachOnce = true;
+    for (const auto& count : counts)
+        isEachOnce = isEachOnce && (count == 1);
+    QCOMPARE(isEachOnce, true);
+}
+
+void BoundedQueueTests::Capacity()
+{
+    const int CAPACITY = 3;
+
+    BoundedQueue<int> queue(CAPACITY);
+    std::atomic<int> numPushed(0);
+
+    std::thread producer([&]()
+    {
+        for (int i = 0; i < 2 * CAPACITY; ++i)
+        {
+            queue.Push(int(i));
+            ++numPushed;
+        }
+    });
+
+    // The producer waits for the free place
+    while (numPushed < CAPACITY)
+        std::this_thread::yield();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    QCOMPARE(numPushed.load(), CAPACITY);
+
+    for (int i = 0; i < 2 * CAPACITY; ++i)
+    {
+        int item = -1;
+        QCOMPARE(queue.Pop(item), true);
+        QCOMPARE(item, i);
+    }
+
+    producer.join();
+    QCOMPARE(numPushed.load(), 2 * CAPACITY);
+}
+
+void BoundedQueueTests::Close()
+{
+    BoundedQueue<int> queue(2);
+    QCOMPARE(queue.Push(1), true);
+    QCOMPARE(queue.Push(2), true);
+
+    // The producer which waits for the free place is woken by closing
+    bool isPushed = true;
+    std::thread producer([&]() { isPushed = queue.Push(3); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.Close();
+    producer.join();
+    QCOMPARE(isPushed, false);
+
+    // The remaining items are taken after closing
+    int item = 0;
+    QCOMPARE(queue.Pop(item), true);
+    QCOMPARE(item, 1);
+    QCOMPARE(queue.Pop(item), true);
+    QCOMPARE(item, 2);
+    QCOMPARE(queue.Pop(item), false);
+    QCOMPARE(queue.Push(4), false);
+
+    // The consumer which waits for the item is woken by closing
+    BoundedQueue<int> emptyQueue(1);
+    bool isPopped = true;
+    std::thread consumer([&]() { isPopped = emptyQueue.Pop(item); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    emptyQueue.Close();
+    consumer.join();
+    QCOMPARE(isPopped, false);
+}
+
+void BoundedQueueTests::MoveOnlyItems()
+{
+    BoundedQueue<std::unique_ptr<int>> queue(1);
+    QCOMPARE(queue.Push(std::unique_ptr<int>(new int(7))), true);
+
+    std::unique_ptr<int> item;
+    QCOMPARE(queue.Pop(item), true);
+    QCOMPARE(item != nullptr, true);
+    QCOMPARE(*item, 7);
+}
+
+QTEST_APPLESS_MAIN(BoundedQueueTests)
+
+#include "BoundedQueueTests.moc"
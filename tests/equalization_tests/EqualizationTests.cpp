@@ -0,0 +1,312 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "EqualizationTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include "Image.h"
+#include "ImageCorrector.h"
+
+// This class is used for testing of equalization of histogram: the results are compared with the direct calculations
+class EqualizationTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    EqualizationTests();
+
+private Q_SLOTS:
+
+    // Test of global equalization
+    void GlobalEqualization();
+
+    // Test of CLAHE with one tile (look-up table of whole image)
+    void ClaheOneTile();
+
+    // Test of CLAHE with several tiles (interpolation of tables)
+    void ClaheTiles();
+
+    // Test of CLAHE of image of one brightness
+    void ClaheConstantImage();
+
+    // Test of incorrect arguments
+    void IncorrectArguments();
+
+private:
+
+    // Form the table of equalization of region with clipping of histogram (zero limit disables clipping)
+    static std::vector<double> FormTable(const acv::Image& img, const int xStart, const int yStart, const int xEnd, const int yEnd,
+                                         const double clipLimit);
+
+    // Calculate CLAHE by the direct bilinear interpolation of tables of tiles
+    static acv::Image Clahe(const acv::Image& img, const double clipLimit, const int numTiles);
+
+    acv::Image mImage;
+
+};
+
+// Sizes of image
+static const int HEIGHT = 301, WIDTH = 457;
+
+EqualizationTests::EqualizationTests()
+    : mImage(HEIGHT, WIDTH)
+{
+    // Dark image with low contrast and brighter blocks
+    std::default_random_engine engine;
+    std::uniform_int_distribution<int> di(0, 20);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+        {
+            const int pixel = 30 + ((row / 40 + col / 50) % 3) * 25 + col / 20 + di(engine);
+            mImage.SetPixel(row, col, static_cast<acv::Image::Byte>(pixel));
+        }
+}
+
+std::vector<double> EqualizationTests::FormTable(const acv::Image& img, const int xStart, const int yStart, const int xEnd, const int yEnd,
+                                                 const double clipLimit)
+{
+    const int NUM_BINS = acv::Image::MAX_PIXEL_VALUE + 1;
+
+    std::vector<size_t> bins(NUM_BINS, 0);
+    for (int row = yStart; row < yEnd; ++row)
+        for (int col = xStart; col < xEnd; ++col)
+            ++bins[img.GetPixel(row, col)];
+
+    const size_t numPixels = static_cast<size_t>(xEnd - xStart) * (yEnd - yStart);
+
+    if (clipLimit > 0.0)
+    {
+        // The excess of clipped bins is added evenly, the residual is added to bins with uniform step
+        const size_t limit = std::max(static_cast<size_t>(clipLimit * numPixels / NUM_BINS), static_cast<size_t>(1));
+        size_t excess = 0;
+        for (size_t& count : bins)
+            if (count > limit)
+            {
+                excess += count - limit;
+                count = limit;
+            }
+
+        for (size_t& count : bins)
+            count += excess / NUM_BINS;
+
+        const size_t residual = excess % NUM_BINS;
+        for (size_t j = 0; j < residual; ++j)
+            ++bins[j * (NUM_BINS / residual)];
+    }
+
+    std::vector<double> table(NUM_BINS);
+    size_t cdf = 0;
+    for (int i = 0; i < NUM_BINS; ++i)
+    {
+        cdf += bins[i];
+        table[i] = static_cast<double>(acv::Image::MAX_PIXEL_VALUE) * cdf / numPixels;
+    }
+
+    return table;
+}
+
+acv::Image EqualizationTests::Clahe(const acv::Image& img, const double clipLimit, const int numTiles)
+{
+    const int height = img.GetHeight(), width = img.GetWidth();
+
+    // Boundaries and centers of tiles
+    std::vector<int> startsX(numTiles + 1), startsY(numTiles + 1);
+    for (int tile = 0; tile <= numTiles; ++tile)
+    {
+        startsX[tile] = width * tile / numTiles;
+        startsY[tile] = height * tile / numTiles;
+    }
+
+    std::vector<double> centersX(numTiles), centersY(numTiles);
+    std::vector<std::vector<double>> tables(numTiles * numTiles);
+    for (int tileY = 0; tileY < numTiles; ++tileY)
+        for (int tileX = 0; tileX < numTiles; ++tileX)
+        {
+            centersX[tileX] = (startsX[tileX] + startsX[tileX + 1] - 1) / 2.0;
+            centersY[tileY] = (startsY[tileY] + startsY[tileY + 1] - 1) / 2.0;
+            tables[tileY * numTiles + tileX] = FormTable(img, startsX[tileX], startsY[tileY], startsX[tileX + 1], startsY[tileY + 1], clipLimit);
+        }
+
+    // Nearest tile whose center is not after the position and the weight of the next tile
+    auto locate = [numTiles](const std::vector<double>& centers, const int pos, int& tile, double& weight)
+    {
+        tile = 0;
+        while (tile + 1 < numTiles && centers[tile + 1] <= pos)
+            ++tile;
+
+        weight = (tile + 1 < numTiles && centers[tile] < pos) ? (pos - centers[tile]) / (centers[tile + 1] - centers[tile]) : 0.0;
+    };
+
+    acv::Image result(height, width);
+    for (int row = 0; row < height; ++row)
+    {
+        int tileY;
+        double weightY;
+        locate(centersY, row, tileY, weightY);
+        const int nextTileY = std::min(tileY + 1, numTiles - 1);
+
+        for (int col = 0; col < width; ++col)
+        {
+            int tileX;
+            double weightX;
+            locate(centersX, col, tileX, weightX);
+            const int nextTileX = std::min(tileX + 1, numTiles - 1);
+
+            const int pixel = img.GetPixel(row, col);
+            const double top = tables[tileY * numTiles + tileX][pixel] * (1.0 - weightX) +
+                               tables[tileY * numTiles + nextTileX][pixel] * weightX;
+            const double bottom = tables[nextTileY * numTiles + tileX][pixel] * (1.0 - weightX) +
+                                  tables[nextTileY * numTiles + nextTileX][pixel] * weightX;
+
+            result.SetPixel(row, col, static_cast<acv::Image::Byte>(top * (1.0 - weightY) + bottom * weightY + 0.5));
+        }
+    }
+
+    return result;
+}
+
+void EqualizationTests::GlobalEqualization()
+{
+    acv::Image result(HEIGHT, WIDTH);
+    QVERIFY(acv::ImageCorrector::Correct(mImage, result, acv::ImageCorrector::CorrectorType::GLOBAL_EQUALIZATION));
+
+    // The first present brightness is mapped to zero and the cumulative distribution is stretched to all range
+    std::vector<size_t> bins(acv::Image::MAX_PIXEL_VALUE + 1, 0);
+    for (const acv::Image::Byte pixel : mImage.GetData())
+        ++bins[pixel];
+
+    const size_t numPixels = static_cast<size_t>(HEIGHT) * WIDTH;
+    const size_t minCdf = *std::find_if(bins.begin(), bins.end(), [](const size_t count) { return count > 0; });
+
+    std::vector<int> table(bins.size());
+    size_t cdf = 0;
+    for (size_t i = 0; i < bins.size(); ++i)
+    {
+        cdf += bins[i];
+        table[i] = (cdf > minCdf) ? static_cast<int>(255.0 * (cdf - minCdf) / (numPixels - minCdf) + 0.5) : 0;
+    }
+
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+            QCOMPARE(static_cast<int>(result.GetPixel(row, col)), table[mImage.GetPixel(row, col)]);
+
+    // Result uses all range of brightness
+    const auto minMax = std::minmax_element(result.GetData().begin(), result.GetData().end());
+    QCOMPARE(static_cast<int>(*minMax.first), static_cast<int>(acv::Image::MIN_PIXEL_VALUE));
+    QCOMPARE(static_cast<int>(*minMax.second), static_cast<int>(acv::Image::MAX_PIXEL_VALUE));
+
+    // Correction in place
+    acv::Image inPlace = mImage;
+    QVERIFY(acv::ImageCorrector::Correct(inPlace, acv::ImageCorrector::CorrectorType::GLOBAL_EQUALIZATION));
+    QVERIFY(inPlace == result);
+}
+
+void EqualizationTests::ClaheOneTile()
+{
+    const double clipLimits[] = { 0.0, 1.5, 4.0 };
+
+    for (const double clipLimit : clipLimits)
+    {
+        acv::Image result(HEIGHT, WIDTH);
+        QVERIFY(acv::ImageCorrector::Clahe(mImage, result, clipLimit, 1));
+
+        // One table is applied without interpolation
+        const std::vector<double> table = FormTable(mImage, 0, 0, WIDTH, HEIGHT, clipLimit);
+        for (int row = 0; row < HEIGHT; ++row)
+            for (int col = 0; col < WIDTH; ++col)
+                QCOMPARE(static_cast<int>(result.GetPixel(row, col)), static_cast<int>(table[mImage.GetPixel(row, col)] + 0.5));
+    }
+}
+
+void EqualizationTests::ClaheTiles()
+{
+    const struct
+    {
+        double clipLimit;
+        int numTiles;
+    } params[] = { { 2.0, 8 }, { 0.0, 4 }, { 3.0, 5 } };
+
+    for (const auto& param : params)
+    {
+        acv::Image result(HEIGHT, WIDTH);
+        QVERIFY(acv::ImageCorrector::Clahe(mImage, result, param.clipLimit, param.numTiles));
+
+        // The weights of interpolation are quantized, so the results can differ by one level
+        const acv::Image expected = Clahe(mImage, param.clipLimit, param.numTiles);
+        for (int row = 0; row < HEIGHT; ++row)
+            for (int col = 0; col < WIDTH; ++col)
+                QVERIFY(std::abs(result.GetPixel(row, col) - expected.GetPixel(row, col)) <= 1);
+    }
+
+    // Default parameters of corrector
+    acv::Image result(HEIGHT, WIDTH), expected(HEIGHT, WIDTH);
+    QVERIFY(acv::ImageCorrector::Correct(mImage, result, acv::ImageCorrector::CorrectorType::CLAHE));
+    QVERIFY(acv::ImageCorrector::Clahe(mImage, expected));
+    QVERIFY(result == expected);
+}
+
+void EqualizationTests::ClaheConstantImage()
+{
+    acv::Image img(HEIGHT, WIDTH);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+            img.SetPixel(row, col, 100);
+
+    // The clipped histogram of each tile is spread through the range (all pixels are in the clipped bin)
+    acv::Image result(HEIGHT, WIDTH);
+    QVERIFY(acv::ImageCorrector::Clahe(img, result));
+
+    const acv::Image expected = Clahe(img, 2.0, 8);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+            QVERIFY(std::abs(result.GetPixel(row, col) - expected.GetPixel(row, col)) <= 1);
+}
+
+void EqualizationTests::IncorrectArguments()
+{
+    acv::Image result(HEIGHT, WIDTH), small(HEIGHT - 1, WIDTH);
+
+    QVERIFY(!acv::ImageCorrector::Clahe(mImage, small));
+    QVERIFY(!acv::ImageCorrector::Clahe(mImage, result, -1.0));
+    QVERIFY(!acv::ImageCorrector::Clahe(mImage, result, 2.0, 0));
+    QVERIFY(!acv::ImageCorrector::Clahe(acv::Image(), result));
+
+    // Tiles are limited by sizes of image
+    acv::Image narrow(HEIGHT, 3), narrowResult(HEIGHT, 3);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < 3; ++col)
+            narrow.SetPixel(row, col, static_cast<acv::Image::Byte>(row % 200 + col));
+    QVERIFY(acv::ImageCorrector::Clahe(narrow, narrowResult));
+}
+
+QTEST_APPLESS_MAIN(EqualizationTests)
+
+#include "EqualizationTests.moc"
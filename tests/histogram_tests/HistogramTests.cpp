@@ -0,0 +1,305 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "HistogramTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+#include "Image.h"
+#include "Histogram.h"
+#include "ImageParametersCalculator.h"
+
+// This class is used for testing of histogram of image: the bins are compared with the direct counting of pixels
+class HistogramTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    HistogramTests();
+
+private Q_SLOTS:
+
+    // Test of histogram of whole image
+    void WholeImage();
+
+    // Test of histogram of region of interest
+    void RegionOfInterest();
+
+    // Test of histogram of pixels of mask
+    void Mask();
+
+    // Test of addition and clearing of histograms
+    void AddAndClear();
+
+    // Test of levels and boundaries of brightness
+    void LevelsAndMinMax();
+
+    // Test of parameters of image which are calculated by histogram
+    void Parameters();
+
+    // Test of incorrect arguments
+    void IncorrectArguments();
+
+private:
+
+    // Count the pixels of region with not zero mask (mask can be null) directly
+    static acv::Histogram::Bins CountPixels(const acv::Image& img, const acv::Histogram::Roi& roi, const acv::Image* mask);
+
+    acv::Image mImage;
+    acv::Image mMask;
+
+};
+
+// Sizes of image (the stripes of image are counted in parallel)
+static const int HEIGHT = 1031, WIDTH = 1287;
+
+HistogramTests::HistogramTests()
+    : mImage(HEIGHT, WIDTH),
+      mMask(HEIGHT, WIDTH)
+{
+    // Image with narrow range of brightness in the left half (neighbour pixels often have the same brightness)
+    std::default_random_engine engine;
+    std::uniform_int_distribution<int> di(0, 255);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+        {
+            const int pixel = (col < WIDTH / 2) ? 100 + di(engine) % 3 : di(engine);
+            mImage.SetPixel(row, col, static_cast<acv::Image::Byte>(pixel));
+            mMask.SetPixel(row, col, static_cast<acv::Image::Byte>((row / 7 + col / 5) % 3 ? 0 : di(engine) % 2 + 1));
+        }
+}
+
+acv::Histogram::Bins HistogramTests::CountPixels(const acv::Image& img, const acv::Histogram::Roi& roi, const acv::Image* mask)
+{
+    acv::Histogram::Bins bins;
+    bins.fill(0);
+
+    for (int row = roi.yStart; row <= roi.yEnd; ++row)
+        for (int col = roi.xStart; col <= roi.xEnd; ++col)
+            if (mask == nullptr || mask->GetPixel(row, col) != 0)
+                ++bins[img.GetPixel(row, col)];
+
+    return bins;
+}
+
+void HistogramTests::WholeImage()
+{
+    const acv::Histogram::Roi roi = { 0, 0, WIDTH - 1, HEIGHT - 1 };
+    const acv::Histogram::Bins expected = CountPixels(mImage, roi, nullptr);
+
+    const acv::Histogram histogram(mImage);
+    QVERIFY(histogram.GetBins() == expected);
+    QCOMPARE(histogram.GetTotal(), static_cast<size_t>(HEIGHT) * WIDTH);
+
+    for (int value = 0; value < acv::Histogram::NUM_BINS; ++value)
+        QCOMPARE(histogram[static_cast<acv::Image::Byte>(value)], expected[value]);
+
+    // Small image is counted without stripes
+    acv::Image small(3, 5);
+    for (int row = 0; row < 3; ++row)
+        for (int col = 0; col < 5; ++col)
+            small.SetPixel(row, col, static_cast<acv::Image::Byte>(row * col));
+
+    const acv::Histogram smallHistogram(small);
+    QCOMPARE(smallHistogram[0], static_cast<size_t>(7));
+    QCOMPARE(smallHistogram[2], static_cast<size_t>(2));
+    QCOMPARE(smallHistogram[8], static_cast<size_t>(1));
+    QCOMPARE(smallHistogram.GetTotal(), static_cast<size_t>(15));
+}
+
+void HistogramTests::RegionOfInterest()
+{
+    const acv::Histogram::Roi rois[] =
+    {
+        { 0, 0, WIDTH - 1, HEIGHT - 1 },
+        { 17, 3, 900, 1000 },
+        { 5, 10, 5, 10 },
+        { 0, HEIGHT - 1, WIDTH - 1, HEIGHT - 1 },
+        { WIDTH - 3, 0, WIDTH - 1, HEIGHT - 1 }
+    };
+
+    for (const auto& roi : rois)
+    {
+        acv::Histogram histogram;
+        QVERIFY(histogram.Add(mImage, roi));
+        QVERIFY(histogram.GetBins() == CountPixels(mImage, roi, nullptr));
+        QCOMPARE(histogram.GetTotal(), static_cast<size_t>(roi.xEnd - roi.xStart + 1) * (roi.yEnd - roi.yStart + 1));
+    }
+}
+
+void HistogramTests::Mask()
+{
+    const acv::Histogram::Roi wholeRoi = { 0, 0, WIDTH - 1, HEIGHT - 1 };
+    const acv::Histogram::Bins expected = CountPixels(mImage, wholeRoi, &mMask);
+
+    acv::Histogram histogram;
+    QVERIFY(histogram.Add(mImage, mMask));
+    QVERIFY(histogram.GetBins() == expected);
+
+    size_t total = 0;
+    for (const size_t count : expected)
+        total += count;
+    QCOMPARE(histogram.GetTotal(), total);
+
+    const acv::Histogram::Roi roi = { 31, 47, 1001, 777 };
+    acv::Histogram roiHistogram;
+    QVERIFY(roiHistogram.Add(mImage, roi, mMask));
+    QVERIFY(roiHistogram.GetBins() == CountPixels(mImage, roi, &mMask));
+}
+
+void HistogramTests::AddAndClear()
+{
+    // Histogram of two halves is equal to histogram of whole image
+    const acv::Histogram::Roi top = { 0, 0, WIDTH - 1, HEIGHT / 2 - 1 };
+    const acv::Histogram::Roi bottom = { 0, HEIGHT / 2, WIDTH - 1, HEIGHT - 1 };
+
+    acv::Histogram topHistogram, bottomHistogram;
+    QVERIFY(topHistogram.Add(mImage, top));
+    QVERIFY(bottomHistogram.Add(mImage, bottom));
+    topHistogram += bottomHistogram;
+
+    const acv::Histogram histogram(mImage);
+    QVERIFY(topHistogram.GetBins() == histogram.GetBins());
+    QCOMPARE(topHistogram.GetTotal(), histogram.GetTotal());
+
+    // Adding of the same image twice doubles the bins
+    acv::Histogram twice(mImage);
+    QVERIFY(twice.Add(mImage));
+    for (int value = 0; value < acv::Histogram::NUM_BINS; ++value)
+        QCOMPARE(twice.GetBins()[value], 2 * histogram.GetBins()[value]);
+
+    twice.Clear();
+    QCOMPARE(twice.GetTotal(), static_cast<size_t>(0));
+    for (const size_t count : twice.GetBins())
+        QCOMPARE(count, static_cast<size_t>(0));
+}
+
+void HistogramTests::LevelsAndMinMax()
+{
+    acv::Histogram histogram;
+    acv::Image::Byte minBrig, maxBrig;
+
+    // Empty histogram
+    QVERIFY(!histogram.GetMinMax(minBrig, maxBrig));
+    QCOMPARE(histogram.GetNumLevels(), static_cast<size_t>(0));
+
+    // Region of the left half contains three levels
+    const acv::Histogram::Roi roi = { 0, 0, WIDTH / 2 - 1, HEIGHT - 1 };
+    QVERIFY(histogram.Add(mImage, roi));
+    QVERIFY(histogram.GetMinMax(minBrig, maxBrig));
+    QCOMPARE(minBrig, static_cast<acv::Image::Byte>(100));
+    QCOMPARE(maxBrig, static_cast<acv::Image::Byte>(102));
+    QCOMPARE(histogram.GetNumLevels(), static_cast<size_t>(3));
+}
+
+void HistogramTests::Parameters()
+{
+    const double EPS = 1e-9;
+
+    acv::ImageParametersCalculator calculator(mImage);
+    acv::ImageParametersCalculator::Parameters params;
+    QVERIFY(calculator.CalcParameters(params));
+
+    // Direct calculations by pixels
+    double sum = 0.0;
+    int minBrig = acv::Image::MAX_PIXEL_VALUE, maxBrig = acv::Image::MIN_PIXEL_VALUE;
+    for (const acv::Image::Byte pixel : mImage.GetData())
+    {
+        sum += pixel;
+        minBrig = std::min(minBrig, static_cast<int>(pixel));
+        maxBrig = std::max(maxBrig, static_cast<int>(pixel));
+    }
+    const double volume = sum;
+    const double numPixels = static_cast<double>(HEIGHT) * WIDTH;
+    const double aver = sum / numPixels;
+
+    double sd = 0.0;
+    for (const acv::Image::Byte pixel : mImage.GetData())
+        sd += (pixel - aver) * (pixel - aver);
+    sd = std::sqrt(sd / (numPixels - 1));
+
+    // Entropy of distribution of brightness volume by levels
+    const acv::Histogram::Roi roi = { 0, 0, WIDTH - 1, HEIGHT - 1 };
+    const acv::Histogram::Bins bins = CountPixels(mImage, roi, nullptr);
+    double entropy = 0.0;
+    for (int z = 0; z < acv::Histogram::NUM_BINS; ++z)
+    {
+        const double px = z * static_cast<double>(bins[z]) / volume;
+        if (px > 0.0)
+            entropy -= px * std::log2(px);
+    }
+
+    QVERIFY(std::fabs(params.averageBrightness - aver) < EPS);
+    QVERIFY(std::fabs(params.standardDeviation - sd) < EPS);
+    QVERIFY(std::fabs(params.entropy - entropy) < EPS);
+    QCOMPARE(static_cast<int>(params.minBrightness), minBrig);
+    QCOMPARE(static_cast<int>(params.maxBrightness), maxBrig);
+
+    // The parameters are the same as the parameters which are calculated separately
+    QVERIFY(std::fabs(params.entropy - calculator.CalcEntropy()) < EPS);
+    QVERIFY(std::fabs(params.averageBrightness - calculator.CalcAverageBrightness()) < EPS);
+    QVERIFY(std::fabs(params.standardDeviation - calculator.CalcStandardDeviation(aver)) < EPS);
+    QVERIFY(std::fabs(params.integralQualityIndicator - calculator.CalcIntegralQualityIndicator()) < EPS);
+}
+
+void HistogramTests::IncorrectArguments()
+{
+    acv::Histogram histogram;
+
+    // Regions outside of image and inverted regions
+    const acv::Histogram::Roi rois[] =
+    {
+        { -1, 0, 10, 10 },
+        { 0, 0, WIDTH, 10 },
+        { 0, 0, 10, HEIGHT },
+        { 10, 0, 9, 10 },
+        { 0, 10, 10, 9 }
+    };
+
+    for (const auto& roi : rois)
+    {
+        QVERIFY(!histogram.Add(mImage, roi));
+        QVERIFY(!histogram.Add(mImage, roi, mMask));
+    }
+
+    // Mask of other sizes and not initialized image
+    acv::Image smallMask(HEIGHT - 1, WIDTH);
+    QVERIFY(!histogram.Add(mImage, smallMask));
+    QVERIFY(!histogram.Add(acv::Image()));
+
+    QCOMPARE(histogram.GetTotal(), static_cast<size_t>(0));
+
+    acv::ImageParametersCalculator calculator;
+    acv::ImageParametersCalculator::Parameters params;
+    QVERIFY(!calculator.CalcParameters(params));
+}
+
+QTEST_APPLESS_MAIN(HistogramTests)
+
+#include "HistogramTests.moc"
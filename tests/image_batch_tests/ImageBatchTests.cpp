@@ -0,0 +1,240 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "ImageBatchTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+#include <vector>
+
+#include "AImage.h"
+#include "AProgress.h"
+#include "AImageBatch.h"
+
+// This class is used for testing of processing of image batches: the results are compared with the processing
+// of each image by one call
+class ImageBatchTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    ImageBatchTests();
+
+private Q_SLOTS:
+
+    // Test of filtration of batch
+    void FilterBatch();
+
+    // Test of correction of batch
+    void CorrectBatch();
+
+    // Test of detection of borders of batch
+    void DetectBordersBatch();
+
+    // Test of calculation of parameters of batch
+    void CalcParametersBatch();
+
+    // Test of batch with the same source and destination vectors
+    void SameVector();
+
+    // Test of cancelled batch and of incorrect arguments
+    void CancelAndIncorrectArguments();
+
+private:
+
+    // Form the image with smooth random regions
+    AImage FormRandomImage(const int height, const int width);
+
+    std::default_random_engine mEngine;
+
+    std::vector<AImage> mImages;
+
+};
+
+// Sizes of images of batch: thumbnails which are processed by one thread each
+// and large images (more than AImageBatch::MAX_IMAGE_PARALLEL_PIXELS) which are divided to bands of rows
+static const int SIZES[][2] = { { 31, 47 }, { 600, 500 }, { 64, 64 }, { 12, 200 }, { 513, 700 }, { 120, 90 } };
+
+// Check that two images are equal
+static bool AreEqual(const AImage& lhs, const AImage& rhs)
+{
+    if (lhs.GetHeight() != rhs.GetHeight() || lhs.GetWidth() != rhs.GetWidth())
+        return false;
+
+    for (int row = 0; row < lhs.GetHeight(); ++row)
+        for (int col = 0; col < lhs.GetWidth(); ++col)
+            if (lhs.GetPixel(row, col) != rhs.GetPixel(row, col))
+                return false;
+
+    return true;
+}
+
+ImageBatchTests::ImageBatchTests()
+{
+    for (const auto& size : SIZES)
+        mImages.push_back(FormRandomImage(size[0], size[1]));
+}
+
+AImage ImageBatchTests::FormRandomImage(const int height, const int width)
+{
+    std::uniform_int_distribution<int> di(0, 255);
+
+    AImage img(height, width);
+    for (int row = 0; row < height; ++row)
+        for (int col = 0; col < width; ++col)
+            img.SetPixel(row, col, static_cast<AByte>((row / 20 + col / 30) % 2 ? 190 - di(mEngine) / 8 : 40 + di(mEngine) / 8));
+
+    return img;
+}
+
+void ImageBatchTests::FilterBatch()
+{
+    const AFilterType TYPES[] = { AFilterType::MEDIAN, AFilterType::GAUSSIAN, AFilterType::SEP_GAUSSIAN, AFilterType::IIR_GAUSSIAN,
+                                  AFilterType::SHARPEN, AFilterType::BILATERAL, AFilterType::UNSHARP_MASK };
+
+    for (const AFilterType type : TYPES)
+    {
+        std::vector<AImage> results;
+        QCOMPARE(AImageBatch::FilterBatch(mImages, results, type, 7), AFiltrationResult::SUCCESS);
+        QCOMPARE(results.size(), mImages.size());
+
+        for (size_t i = 0; i < mImages.size(); ++i)
+        {
+            AImage expected(mImages[i].GetHeight(), mImages[i].GetWidth());
+            QCOMPARE(AImageFilter::Filter(mImages[i], expected, type, 7), AFiltrationResult::SUCCESS);
+            QCOMPARE(AreEqual(results[i], expected), true);
+        }
+    }
+}
+
+void ImageBatchTests::CorrectBatch()
+{
+    const ACorrectorType TYPES[] = { ACorrectorType::SSRETINEX, ACorrectorType::AUTO_LEVELS, ACorrectorType::NORM_AUTO_LEVELS,
+                                     ACorrectorType::GAMMA, ACorrectorType::GLOBAL_EQUALIZATION, ACorrectorType::CLAHE };
+
+    for (const ACorrectorType type : TYPES)
+    {
+        std::vector<AImage> results;
+        QCOMPARE(AImageBatch::CorrectBatch(mImages, results, type), true);
+        QCOMPARE(results.size(), mImages.size());
+
+        for (size_t i = 0; i < mImages.size(); ++i)
+        {
+            AImage expected(mImages[i].GetHeight(), mImages[i].GetWidth());
+            QCOMPARE(AImageCorrector::Correct(mImages[i], expected, type), true);
+            QCOMPARE(AreEqual(results[i], expected), true);
+        }
+    }
+}
+
+void ImageBatchTests::DetectBordersBatch()
+{
+    const ADetectorType TYPES[] = { ADetectorType::SOBEL, ADetectorType::SCHARR, ADetectorType::CANNY, ADetectorType::CANNY_BILATERAL };
+
+    for (const ADetectorType type : TYPES)
+    {
+        std::vector<AImage> results;
+        QCOMPARE(AImageBatch::DetectBordersBatch(mImages, results, type), true);
+        QCOMPARE(results.size(), mImages.size());
+
+        for (size_t i = 0; i < mImages.size(); ++i)
+        {
+            AImage expected(mImages[i].GetHeight(), mImages[i].GetWidth());
+            QCOMPARE(ABordersDetector::DetectBorders(mImages[i], expected, type), true);
+            QCOMPARE(AreEqual(results[i], expected), true);
+        }
+    }
+}
+
+void ImageBatchTests::CalcParametersBatch()
+{
+    std::vector<AImageParameters> parameters;
+    QCOMPARE(AImageBatch::CalcParametersBatch(mImages, parameters), true);
+    QCOMPARE(parameters.size(), mImages.size());
+
+    for (size_t i = 0; i < mImages.size(); ++i)
+    {
+        AImageParameters expected;
+        AImageParametersCalculator calculator(mImages[i]);
+        QCOMPARE(calculator.CalcParameters(expected), true);
+
+        QCOMPARE(parameters[i].entropy, expected.entropy);
+        QCOMPARE(parameters[i].averageBrightness, expected.averageBrightness);
+        QCOMPARE(parameters[i].standardDeviation, expected.standardDeviation);
+        QCOMPARE(parameters[i].minBrightness, expected.minBrightness);
+        QCOMPARE(parameters[i].maxBrightness, expected.maxBrightness);
+        QCOMPARE(parameters[i].integralQualityIndicator, expected.integralQualityIndicator);
+    }
+}
+
+void ImageBatchTests::SameVector()
+{
+    std::vector<AImage> images(mImages);
+    QCOMPARE(AImageBatch::FilterBatch(images, images, AFilterType::GAUSSIAN, 3), AFiltrationResult::SUCCESS);
+    QCOMPARE(images.size(), mImages.size());
+
+    for (size_t i = 0; i < mImages.size(); ++i)
+    {
+        AImage expected(mImages[i].GetHeight(), mImages[i].GetWidth());
+        QCOMPARE(AImageFilter::Filter(mImages[i], expected, AFilterType::GAUSSIAN, 3), AFiltrationResult::SUCCESS);
+        QCOMPARE(AreEqual(images[i], expected), true);
+    }
+
+    images = mImages;
+    QCOMPARE(AImageBatch::DetectBordersBatch(images, images, ADetectorType::SOBEL), true);
+    for (size_t i = 0; i < mImages.size(); ++i)
+    {
+        AImage expected(mImages[i].GetHeight(), mImages[i].GetWidth());
+        QCOMPARE(ABordersDetector::DetectBorders(mImages[i], expected, ADetectorType::SOBEL), true);
+        QCOMPARE(AreEqual(images[i], expected), true);
+    }
+}
+
+void ImageBatchTests::CancelAndIncorrectArguments()
+{
+    std::vector<AImage> results;
+
+    AProgress progress;
+    progress.Cancel();
+    QCOMPARE(AImageBatch::FilterBatch(mImages, results, AFilterType::GAUSSIAN, 3, &progress), AFiltrationResult::CANCELLED);
+    QCOMPARE(AImageBatch::CorrectBatch(mImages, results, ACorrectorType::GAMMA, &progress), false);
+    QCOMPARE(AImageBatch::DetectBordersBatch(mImages, results, ADetectorType::SOBEL, &progress), false);
+
+    std::vector<AImageParameters> parameters;
+    QCOMPARE(AImageBatch::CalcParametersBatch(mImages, parameters, &progress), false);
+
+    // The result of failed images is returned
+    QCOMPARE(AImageBatch::FilterBatch(mImages, results, AFilterType::MEDIAN, 4), AFiltrationResult::INCORRECT_FILTER_SIZE);
+
+    // The empty batch is processed
+    std::vector<AImage> emptyBatch;
+    QCOMPARE(AImageBatch::FilterBatch(emptyBatch, results, AFilterType::GAUSSIAN, 3), AFiltrationResult::SUCCESS);
+    QCOMPARE(results.empty(), true);
+}
+
+QTEST_APPLESS_MAIN(ImageBatchTests)
+
+#include "ImageBatchTests.moc"
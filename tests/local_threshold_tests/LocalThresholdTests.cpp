@@ -0,0 +1,247 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "LocalThresholdTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#include "Image.h"
+#include "BinaryImage.h"
+#include "ImageFilter.h"
+
+// This class is used for testing of Niblack and Sauvola thresholds: the results are compared with the brute-force statistics of windows
+class LocalThresholdTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    LocalThresholdTests();
+
+private Q_SLOTS:
+
+    // Test of Niblack threshold
+    void Niblack();
+
+    // Test of Sauvola threshold
+    void Sauvola();
+
+    // Test of threshold in place (the strips of image overwrite the source)
+    void InPlace();
+
+    // Test of threshold to binary image
+    void BinaryResult();
+
+    // Test of incorrect arguments
+    void IncorrectArguments();
+
+private:
+
+    // Calculate the brute-force sums of pixels and their squares in windows which are clamped by the borders of image
+    static void CalcWindowSums(const acv::Image& img, const int filterSize, std::vector<uint64_t>& sums,
+                               std::vector<uint64_t>& sumsSquares, std::vector<int>& numsPixels);
+
+    // Threshold the image by the sums of windows
+    static acv::Image Threshold(const acv::Image& img, const std::vector<uint64_t>& sums, const std::vector<uint64_t>& sumsSquares,
+                                const std::vector<int>& numsPixels, const float k,
+                                acv::ImageFilter::ThresholdMethod method, acv::ImageFilter::ThresholdType thresholdType);
+
+    // Check the threshold of method by all sizes of window, coefficients and types of threshold
+    bool CheckMethod(acv::ImageFilter::ThresholdMethod method, const float* coefs, const int numCoefs);
+
+    acv::Image mImage;
+
+};
+
+// Sizes of image (it is divided to several strips)
+static const int HEIGHT = 300, WIDTH = 211;
+
+// Tested sizes of window (the last one is larger than strip of image)
+static const int FILTER_SIZES[] = { 3, 15, 71, 151 };
+
+// Tested types of threshold
+static const acv::ImageFilter::ThresholdType THRESHOLD_TYPES[] =
+{
+    acv::ImageFilter::ThresholdType::MAX_MORE_THRESHOLD,
+    acv::ImageFilter::ThresholdType::MIN_MORE_THRESHOLD
+};
+
+LocalThresholdTests::LocalThresholdTests()
+    : mImage(HEIGHT, WIDTH)
+{
+    // Text-like dark strokes on the background with gradient of illumination and noise
+    std::default_random_engine engine;
+    std::uniform_int_distribution<int> di(-10, 10);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+        {
+            const bool isStroke = (row % 23 < 3) || (col % 17 < 2 && row % 40 < 25);
+            int pixel = 90 + col / 3 + (isStroke ? -60 : 0) + di(engine);
+            acv::Image::CheckPixelValue(pixel);
+            mImage.SetPixel(row, col, static_cast<acv::Image::Byte>(pixel));
+        }
+}
+
+void LocalThresholdTests::CalcWindowSums(const acv::Image& img, const int filterSize, std::vector<uint64_t>& sums,
+                                         std::vector<uint64_t>& sumsSquares, std::vector<int>& numsPixels)
+{
+    const int aperture = filterSize / 2;
+    const int height = img.GetHeight(), width = img.GetWidth();
+
+    sums.assign(height * width, 0);
+    sumsSquares.assign(height * width, 0);
+    numsPixels.assign(height * width, 0);
+
+    for (int row = 0; row < height; ++row)
+        for (int col = 0; col < width; ++col)
+        {
+            const int i = row * width + col;
+            const int top = std::max(0, row - aperture), bottom = std::min(height, row + aperture + 1);
+            const int left = std::max(0, col - aperture), right = std::min(width, col + aperture + 1);
+            for (int curRow = top; curRow < bottom; ++curRow)
+                for (int curCol = left; curCol < right; ++curCol)
+                {
+                    const int pixel = img.GetPixel(curRow, curCol);
+                    sums[i] += pixel;
+                    sumsSquares[i] += pixel * pixel;
+                }
+
+            numsPixels[i] = (right - left) * (bottom - top);
+        }
+}
+
+acv::Image LocalThresholdTests::Threshold(const acv::Image& img, const std::vector<uint64_t>& sums, const std::vector<uint64_t>& sumsSquares,
+                                          const std::vector<int>& numsPixels, const float k,
+                                          acv::ImageFilter::ThresholdMethod method, acv::ImageFilter::ThresholdType thresholdType)
+{
+    const int height = img.GetHeight(), width = img.GetWidth();
+    const bool isMaxMore = thresholdType == acv::ImageFilter::ThresholdType::MAX_MORE_THRESHOLD;
+
+    acv::Image result(height, width);
+    for (int row = 0; row < height; ++row)
+        for (int col = 0; col < width; ++col)
+        {
+            const int i = row * width + col;
+            const double numPixels = numsPixels[i];
+            const double mean = sums[i] / numPixels;
+            const double deviation = std::sqrt(std::max(0.0, sumsSquares[i] / numPixels - mean * mean));
+            const float level = static_cast<float>((method == acv::ImageFilter::ThresholdMethod::NIBLACK)
+                ? mean + k * deviation
+                : mean * (1.0 + k * (deviation / acv::ImageFilter::SAUVOLA_DYNAMIC_RANGE - 1.0)));
+
+            const bool isMore = img.GetPixel(row, col) > level;
+            result.SetPixel(row, col, (isMore == isMaxMore) ? acv::Image::MAX_PIXEL_VALUE : acv::Image::MIN_PIXEL_VALUE);
+        }
+
+    return result;
+}
+
+bool LocalThresholdTests::CheckMethod(acv::ImageFilter::ThresholdMethod method, const float* coefs, const int numCoefs)
+{
+    for (const int filterSize : FILTER_SIZES)
+    {
+        // The sums of windows are used by all coefficients and types of threshold
+        std::vector<uint64_t> sums, sumsSquares;
+        std::vector<int> numsPixels;
+        CalcWindowSums(mImage, filterSize, sums, sumsSquares, numsPixels);
+
+        for (int i = 0; i < numCoefs; ++i)
+            for (const auto thresholdType : THRESHOLD_TYPES)
+            {
+                acv::Image result(HEIGHT, WIDTH);
+                if (!acv::ImageFilter::AdaptiveThreshold(mImage, result, filterSize, coefs[i], method, thresholdType) ||
+                    !(result == Threshold(mImage, sums, sumsSquares, numsPixels, coefs[i], method, thresholdType)))
+                    return false;
+            }
+    }
+
+    return true;
+}
+
+void LocalThresholdTests::Niblack()
+{
+    const float coefs[] = { -0.2f, 0.0f, 0.5f };
+    QVERIFY(CheckMethod(acv::ImageFilter::ThresholdMethod::NIBLACK, coefs, 3));
+}
+
+void LocalThresholdTests::Sauvola()
+{
+    const float coefs[] = { 0.2f, 0.34f, 0.5f };
+    QVERIFY(CheckMethod(acv::ImageFilter::ThresholdMethod::SAUVOLA, coefs, 3));
+}
+
+void LocalThresholdTests::InPlace()
+{
+    for (const int filterSize : FILTER_SIZES)
+    {
+        acv::Image expected(HEIGHT, WIDTH);
+        QVERIFY(acv::ImageFilter::AdaptiveThreshold(mImage, expected, filterSize, 0.34f, acv::ImageFilter::ThresholdMethod::SAUVOLA,
+                                                    acv::ImageFilter::ThresholdType::MIN_MORE_THRESHOLD));
+
+        acv::Image inPlace = mImage;
+        QVERIFY(acv::ImageFilter::AdaptiveThreshold(inPlace, filterSize, 0.34f, acv::ImageFilter::ThresholdMethod::SAUVOLA,
+                                                    acv::ImageFilter::ThresholdType::MIN_MORE_THRESHOLD));
+        QVERIFY(inPlace == expected);
+    }
+}
+
+void LocalThresholdTests::BinaryResult()
+{
+    for (const auto thresholdType : THRESHOLD_TYPES)
+    {
+        acv::Image expected(HEIGHT, WIDTH), converted(HEIGHT, WIDTH);
+        QVERIFY(acv::ImageFilter::AdaptiveThreshold(mImage, expected, 15, -0.2f, acv::ImageFilter::ThresholdMethod::NIBLACK, thresholdType));
+
+        // The set pixels are the pixels which have maximum value in the result of one-channel threshold
+        acv::BinaryImage binary(HEIGHT, WIDTH);
+        QVERIFY(acv::ImageFilter::AdaptiveThreshold(mImage, binary, 15, -0.2f, acv::ImageFilter::ThresholdMethod::NIBLACK, thresholdType));
+        QVERIFY(binary.ConvertToImage(converted));
+        QVERIFY(converted == expected);
+    }
+}
+
+void LocalThresholdTests::IncorrectArguments()
+{
+    acv::Image result(HEIGHT, WIDTH), small(HEIGHT - 1, WIDTH);
+    acv::BinaryImage binary(HEIGHT, WIDTH - 1);
+
+    const auto method = acv::ImageFilter::ThresholdMethod::SAUVOLA;
+    const auto type = acv::ImageFilter::ThresholdType::MAX_MORE_THRESHOLD;
+
+    QVERIFY(!acv::ImageFilter::AdaptiveThreshold(mImage, result, 4, 0.3f, method, type));
+    QVERIFY(!acv::ImageFilter::AdaptiveThreshold(mImage, result, 0, 0.3f, method, type));
+    QVERIFY(!acv::ImageFilter::AdaptiveThreshold(mImage, small, 15, 0.3f, method, type));
+    QVERIFY(!acv::ImageFilter::AdaptiveThreshold(mImage, binary, 15, 0.3f, method, type));
+    QVERIFY(!acv::ImageFilter::AdaptiveThreshold(acv::Image(), result, 15, 0.3f, method, type));
+}
+
+QTEST_APPLESS_MAIN(LocalThresholdTests)
+
+#include "LocalThresholdTests.moc"
@@ -0,0 +1,416 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "MomentsTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <queue>
+
+#include "Image.h"
+#include "MomentsCalculator.h"
+#include "HuMomentsCalculator.h"
+#include "LabelImage.h"
+#include "AHuMomentsCalculator.h"
+#include "AImage.h"
+
+// This class is used for testing of calculation of image moments: the results are compared with direct sums
+class MomentsTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    MomentsTests();
+
+private Q_SLOTS:
+
+    // Test of raw moments of image part
+    void RawMoments();
+
+    // Test of Hu's moments of image part
+    void HuMoments();
+
+    // Test of Hu's moments for every position of window
+    void DenseHuMoments();
+
+    // Test of calculator of Hu's moments with the image part in constructor
+    void HuMomentsCalculator();
+
+    // Test of incorrect image parts
+    void IncorrectRoi();
+
+    // Test of Hu's moments of many regions of interest
+    void RoisHuMoments();
+
+    // Test of labeling of connected components
+    void LabelConnectedComponents();
+
+    // Test of Hu's moments of labeled objects
+    void LabeledHuMoments();
+
+private:
+
+    // Form the image with random pixels, the half of pixels are zero
+    acv::Image FormRandomImage(const int height, const int width);
+
+    std::default_random_engine mEngine;
+
+};
+
+typedef acv::MomentsCalculator::WeightType WeightType;
+
+// Compare two values of moments with relative tolerance
+static bool IsNear(const double actual, const double expected)
+{
+    return std::abs(actual - expected) <= 1e-7 * std::abs(expected) + 1e-12;
+}
+
+// Calculate the raw moment of order (p, q) by direct sum (coordinates are counted from (xStart, yStart))
+static double CalcRawMomentDirectly(const acv::Image& img, const int xStart, const int yStart, const int xEnd, const int yEnd,
+                                    const int p, const int q, const WeightType weightType)
+{
+    double m = 0.0;
+    for (int row = yStart; row <= yEnd; ++row)
+        for (int col = xStart; col <= xEnd; ++col)
+        {
+            const acv::Image::Byte pixel = img.GetPixel(row, col);
+            const double weight = (weightType == WeightType::INTENSITY) ? pixel : (pixel > 0 ? 1.0 : 0.0);
+            m += weight * std::pow(col - xStart, p) * std::pow(row - yStart, q);
+        }
+
+    return m;
+}
+
+// Calculate the Hu's moments by direct sums of central moments
+static acv::HuMoments CalcHuMomentsDirectly(const acv::Image& img, const int xStart, const int yStart, const int xEnd, const int yEnd,
+                                            const WeightType weightType)
+{
+    acv::HuMoments hu;
+    hu.fill(0.0);
+
+    const double m00 = CalcRawMomentDirectly(img, xStart, yStart, xEnd, yEnd, 0, 0, weightType);
+    if (m00 <= 0.0)
+        return hu;
+
+    const double xc = CalcRawMomentDirectly(img, xStart, yStart, xEnd, yEnd, 1, 0, weightType) / m00;
+    const double yc = CalcRawMomentDirectly(img, xStart, yStart, xEnd, yEnd, 0, 1, weightType) / m00;
+
+    // Normalized central moments nu[p][q]
+    double nu[4][4] = {};
+    for (int p = 0; p <= 3; ++p)
+        for (int q = 0; q <= 3 - p; ++q)
+        {
+            double mu = 0.0;
+            for (int row = yStart; row <= yEnd; ++row)
+                for (int col = xStart; col <= xEnd; ++col)
+                {
+                    const acv::Image::Byte pixel = img.GetPixel(row, col);
+                    const double weight = (weightType == WeightType::INTENSITY) ? pixel : (pixel > 0 ? 1.0 : 0.0);
+                    mu += weight * std::pow(col - xStart - xc, p) * std::pow(row - yStart - yc, q);
+                }
+            nu[p][q] = mu / std::pow(m00, (p + q) / 2.0 + 1.0);
+        }
+
+    const double a = nu[3][0] + nu[1][2], b = nu[2][1] + nu[0][3];
+    hu[1] = nu[2][0] + nu[0][2];
+    hu[2] = std::pow(nu[2][0] - nu[0][2], 2) + 4 * nu[1][1] * nu[1][1];
+    hu[3] = std::pow(nu[3][0] - 3 * nu[1][2], 2) + std::pow(3 * nu[2][1] - nu[0][3], 2);
+    hu[4] = a * a + b * b;
+    hu[5] = (nu[3][0] - 3 * nu[1][2]) * a * (a * a - 3 * b * b) + (3 * nu[2][1] - nu[0][3]) * b * (3 * a * a - b * b);
+    hu[6] = (nu[2][0] - nu[0][2]) * (a * a - b * b) + 4 * nu[1][1] * a * b;
+    hu[7] = (3 * nu[2][1] - nu[0][3]) * a * (a * a - 3 * b * b) - (nu[3][0] - 3 * nu[1][2]) * b * (3 * a * a - b * b);
+
+    return hu;
+}
+
+static bool IsNear(const acv::HuMoments& actual, const acv::HuMoments& expected)
+{
+    for (size_t i = 0; i < expected.size(); ++i)
+        if (!IsNear(actual[i], expected[i]))
+            return false;
+
+    return true;
+}
+
+// Label the connected components (8-connectivity) of non-zero pixels by breadth-first search in order of raster scan
+static int LabelComponentsDirectly(const acv::Image& img, std::vector<int>& labels)
+{
+    const int height = img.GetHeight(), width = img.GetWidth();
+    labels.assign(static_cast<size_t>(height) * width, 0);
+
+    int numLabels = 0;
+    for (int row = 0; row < height; ++row)
+        for (int col = 0; col < width; ++col)
+        {
+            if (img.GetPixel(row, col) == 0 || labels[row * width + col] != 0)
+                continue;
+
+            labels[row * width + col] = ++numLabels;
+            std::queue<std::pair<int, int>> pixels;
+            pixels.push(std::make_pair(row, col));
+            while (!pixels.empty())
+            {
+                const int y = pixels.front().first, x = pixels.front().second;
+                pixels.pop();
+
+                for (int dy = -1; dy <= 1; ++dy)
+                    for (int dx = -1; dx <= 1; ++dx)
+                    {
+                        const int ny = y + dy, nx = x + dx;
+                        if (img.IsInvalidCoordinates(ny, nx) || img.GetPixel(ny, nx) == 0 || labels[ny * width + nx] != 0)
+                            continue;
+
+                        labels[ny * width + nx] = numLabels;
+                        pixels.push(std::make_pair(ny, nx));
+                    }
+            }
+        }
+
+    return numLabels;
+}
+
+MomentsTests::MomentsTests()
+{
+}
+
+acv::Image MomentsTests::FormRandomImage(const int height, const int width)
+{
+    std::uniform_int_distribution<int> di(-acv::Image::MAX_PIXEL_VALUE, acv::Image::MAX_PIXEL_VALUE);
+
+    acv::Image img(height, width);
+    for (acv::Image::Byte& pixel : img.GetData())
+        pixel = static_cast<acv::Image::Byte>(std::max(di(mEngine), 0));
+
+    return img;
+}
+
+void MomentsTests::RawMoments()
+{
+    const acv::Image img = FormRandomImage(40, 50);
+
+    for (const WeightType weightType : { WeightType::BINARY, WeightType::INTENSITY })
+    {
+        acv::RawMoments m;
+        QCOMPARE(acv::MomentsCalculator::CalcRawMoments(img, 3, 5, 44, 31, m, weightType), true);
+
+        QCOMPARE(IsNear(m.m00, CalcRawMomentDirectly(img, 3, 5, 44, 31, 0, 0, weightType)), true);
+        QCOMPARE(IsNear(m.m10, CalcRawMomentDirectly(img, 3, 5, 44, 31, 1, 0, weightType)), true);
+        QCOMPARE(IsNear(m.m01, CalcRawMomentDirectly(img, 3, 5, 44, 31, 0, 1, weightType)), true);
+        QCOMPARE(IsNear(m.m20, CalcRawMomentDirectly(img, 3, 5, 44, 31, 2, 0, weightType)), true);
+        QCOMPARE(IsNear(m.m11, CalcRawMomentDirectly(img, 3, 5, 44, 31, 1, 1, weightType)), true);
+        QCOMPARE(IsNear(m.m02, CalcRawMomentDirectly(img, 3, 5, 44, 31, 0, 2, weightType)), true);
+        QCOMPARE(IsNear(m.m30, CalcRawMomentDirectly(img, 3, 5, 44, 31, 3, 0, weightType)), true);
+        QCOMPARE(IsNear(m.m21, CalcRawMomentDirectly(img, 3, 5, 44, 31, 2, 1, weightType)), true);
+        QCOMPARE(IsNear(m.m12, CalcRawMomentDirectly(img, 3, 5, 44, 31, 1, 2, weightType)), true);
+        QCOMPARE(IsNear(m.m03, CalcRawMomentDirectly(img, 3, 5, 44, 31, 0, 3, weightType)), true);
+    }
+}
+
+void MomentsTests::HuMoments()
+{
+    const acv::Image img = FormRandomImage(30, 35);
+
+    for (const WeightType weightType : { WeightType::BINARY, WeightType::INTENSITY })
+    {
+        acv::HuMoments hu;
+        QCOMPARE(acv::MomentsCalculator::CalcHuMoments(img, 0, 0, 34, 29, hu, weightType), true);
+        QCOMPARE(IsNear(hu, CalcHuMomentsDirectly(img, 0, 0, 34, 29, weightType)), true);
+
+        QCOMPARE(acv::MomentsCalculator::CalcHuMoments(img, 7, 2, 20, 25, hu, weightType), true);
+        QCOMPARE(IsNear(hu, CalcHuMomentsDirectly(img, 7, 2, 20, 25, weightType)), true);
+    }
+
+    // The moments of empty part are zero
+    const acv::Image emptyImg(10, 10);
+    acv::HuMoments hu;
+    QCOMPARE(acv::MomentsCalculator::CalcHuMoments(emptyImg, 0, 0, 9, 9, hu), true);
+    for (const double moment : hu)
+        QCOMPARE(moment, 0.0);
+}
+
+void MomentsTests::DenseHuMoments()
+{
+    const int WIN_WIDTH = 7, WIN_HEIGHT = 5;
+    const acv::Image img = FormRandomImage(24, 31);
+
+    for (const WeightType weightType : { WeightType::BINARY, WeightType::INTENSITY })
+    {
+        std::vector<acv::HuMoments> dense;
+        QCOMPARE(acv::MomentsCalculator::CalcDenseHuMoments(img, WIN_WIDTH, WIN_HEIGHT, dense, weightType), true);
+
+        const int numRows = img.GetHeight() - WIN_HEIGHT + 1;
+        const int numCols = img.GetWidth() - WIN_WIDTH + 1;
+        QCOMPARE(dense.size(), static_cast<size_t>(numRows * numCols));
+
+        for (int row = 0; row < numRows; ++row)
+            for (int col = 0; col < numCols; ++col)
+            {
+                acv::HuMoments hu;
+                acv::MomentsCalculator::CalcHuMoments(img, col, row, col + WIN_WIDTH - 1, row + WIN_HEIGHT - 1, hu, weightType);
+                QCOMPARE(IsNear(dense[row * numCols + col], hu), true);
+            }
+    }
+
+    std::vector<acv::HuMoments> dense;
+    QCOMPARE(acv::MomentsCalculator::CalcDenseHuMoments(img, img.GetWidth() + 1, WIN_HEIGHT, dense), false);
+    QCOMPARE(acv::MomentsCalculator::CalcDenseHuMoments(img, WIN_WIDTH, 0, dense), false);
+}
+
+void MomentsTests::HuMomentsCalculator()
+{
+    const acv::Image img = FormRandomImage(30, 40);
+
+    // Engine calculator gives the same moments as the one-pass engine
+    acv::HuMomentsCalculator calculator(img, 4, 3, 35, 27);
+    QCOMPARE(calculator.IsCalculated(), true);
+    QCOMPARE(IsNear(calculator.GetHuMoments(), CalcHuMomentsDirectly(img, 4, 3, 35, 27, WeightType::BINARY)), true);
+
+    // Service calculator of one part gives the same moments as calculation of many parts
+    AImage serviceImg(img.GetHeight(), img.GetWidth());
+    for (int row = 0; row < img.GetHeight(); ++row)
+        for (int col = 0; col < img.GetWidth(); ++col)
+            serviceImg.SetPixel(row, col, img.GetPixel(row, col));
+
+    AHuMomentsCalculator serviceCalculator(serviceImg, 4, 3, 35, 27);
+    AHuMoments moments;
+    QCOMPARE(serviceCalculator.GetHuMoments(moments), true);
+
+    std::vector<AHuMoments> roisMoments;
+    QCOMPARE(AHuMomentsCalculator::CalcHuMoments(serviceImg, { ARoi{ 4, 3, 35, 27 } }, roisMoments), true);
+    QCOMPARE(roisMoments.size(), static_cast<size_t>(1));
+    QCOMPARE(moments == roisMoments[0], true);
+
+    std::vector<AHuMoments> dense;
+    QCOMPARE(AHuMomentsCalculator::CalcDenseHuMoments(serviceImg, 32, 25, dense), true);
+    QCOMPARE(dense.size(), static_cast<size_t>(9 * 6));
+    QCOMPARE(IsNear(dense[3 * 9 + 4], moments), true);
+}
+
+void MomentsTests::IncorrectRoi()
+{
+    const acv::Image img = FormRandomImage(10, 10);
+
+    acv::HuMoments hu;
+    QCOMPARE(acv::MomentsCalculator::CalcHuMoments(img, 5, 0, 4, 9, hu), false);
+    QCOMPARE(acv::MomentsCalculator::CalcHuMoments(img, 0, 0, 10, 9, hu), false);
+    QCOMPARE(acv::MomentsCalculator::CalcHuMoments(img, -1, 0, 5, 5, hu), false);
+
+    acv::HuMomentsCalculator calculator(img, 0, 0, 10, 9);
+    QCOMPARE(calculator.IsCalculated(), false);
+
+    AImage serviceImg(10, 10);
+    AHuMomentsCalculator serviceCalculator(serviceImg, 0, 0, 10, 9);
+    AHuMoments moments;
+    QCOMPARE(serviceCalculator.GetHuMoments(moments), false);
+}
+
+void MomentsTests::RoisHuMoments()
+{
+    const acv::Image img = FormRandomImage(60, 70);
+
+    std::uniform_int_distribution<int> dx(0, img.GetWidth() - 1), dy(0, img.GetHeight() - 1);
+    std::vector<acv::MomentsCalculator::Roi> rois;
+    for (int i = 0; i < 100; ++i)
+    {
+        const int x1 = dx(mEngine), x2 = dx(mEngine), y1 = dy(mEngine), y2 = dy(mEngine);
+        rois.push_back({ std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2) });
+    }
+
+    for (const WeightType weightType : { WeightType::BINARY, WeightType::INTENSITY })
+    {
+        std::vector<acv::HuMoments> moments;
+        QCOMPARE(acv::MomentsCalculator::CalcHuMoments(img, rois, moments, weightType), true);
+        QCOMPARE(moments.size(), rois.size());
+
+        for (size_t i = 0; i < rois.size(); ++i)
+        {
+            acv::HuMoments hu;
+            acv::MomentsCalculator::CalcHuMoments(img, rois[i].xStart, rois[i].yStart, rois[i].xEnd, rois[i].yEnd, hu, weightType);
+            QCOMPARE(moments[i] == hu, true);
+        }
+    }
+
+    // Method fails if any region is incorrect
+    rois.push_back({ 0, 0, img.GetWidth(), 0 });
+    std::vector<acv::HuMoments> moments;
+    QCOMPARE(acv::MomentsCalculator::CalcHuMoments(img, rois, moments), false);
+}
+
+void MomentsTests::LabelConnectedComponents()
+{
+    // Sparse pixels form many components of different shapes
+    std::uniform_int_distribution<int> di(0, 99);
+    acv::Image img(80, 90);
+    for (acv::Image::Byte& pixel : img.GetData())
+        pixel = di(mEngine) < 45 ? acv::Image::MAX_PIXEL_VALUE : acv::Image::MIN_PIXEL_VALUE;
+
+    std::vector<int> expected;
+    const int expectedNumLabels = LabelComponentsDirectly(img, expected);
+
+    acv::LabelImage labels;
+    QCOMPARE(acv::LabelImage::LabelConnectedComponents(img, labels), true);
+    QCOMPARE(labels.GetNumLabels(), expectedNumLabels);
+    QCOMPARE(labels.GetData() == expected, true);
+}
+
+void MomentsTests::LabeledHuMoments()
+{
+    std::uniform_int_distribution<int> di(0, 99);
+    acv::Image img(70, 60);
+    for (acv::Image::Byte& pixel : img.GetData())
+        pixel = di(mEngine) < 40 ? static_cast<acv::Image::Byte>(1 + di(mEngine)) : static_cast<acv::Image::Byte>(acv::Image::MIN_PIXEL_VALUE);
+
+    acv::LabelImage labels;
+    QCOMPARE(acv::LabelImage::LabelConnectedComponents(img, labels), true);
+
+    for (const WeightType weightType : { WeightType::BINARY, WeightType::INTENSITY })
+    {
+        std::vector<acv::HuMoments> moments;
+        QCOMPARE(acv::MomentsCalculator::CalcHuMoments(img, labels, moments, weightType), true);
+        QCOMPARE(moments.size(), static_cast<size_t>(labels.GetNumLabels()));
+
+        // The moments of each object are equal to the moments of image which contains only this object
+        for (int label = 1; label <= labels.GetNumLabels(); label += 7)
+        {
+            acv::Image objectImg(img.GetHeight(), img.GetWidth());
+            for (size_t i = 0; i < img.GetData().size(); ++i)
+                if (labels.GetData()[i] == label)
+                    objectImg.GetData()[i] = img.GetData()[i];
+
+            QCOMPARE(IsNear(moments[label - 1], CalcHuMomentsDirectly(objectImg, 0, 0, img.GetWidth() - 1, img.GetHeight() - 1, weightType)), true);
+        }
+    }
+
+    acv::LabelImage wrongLabels(img.GetHeight() + 1, img.GetWidth());
+    std::vector<acv::HuMoments> moments;
+    QCOMPARE(acv::MomentsCalculator::CalcHuMoments(img, wrongLabels, moments), false);
+}
+
+QTEST_APPLESS_MAIN(MomentsTests)
+
+#include "MomentsTests.moc"
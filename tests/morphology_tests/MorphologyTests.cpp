@@ -0,0 +1,172 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "MorphologyTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "Image.h"
+#include "MorphologyFilter.h"
+
+// This class is used for testing of morphological filter: the results are compared with direct search in the window
+class MorphologyTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    MorphologyTests();
+
+private Q_SLOTS:
+
+    // Test of erosion
+    void Erosion();
+
+    // Test of dilation
+    void Dilation();
+
+    // Test of opening and closing
+    void OpeningClosing();
+
+    // Test of filtration of image in place
+    void InPlace();
+
+    // Test of incorrect sizes of structuring element
+    void IncorrectSize();
+
+private:
+
+    // Form the image with random pixels
+    acv::Image FormRandomImage(const int height, const int width);
+
+    std::default_random_engine mEngine;
+
+};
+
+typedef acv::MorphologyFilter::MorphologyType MorphologyType;
+
+// Sizes of structuring element which check direct passes and van Herk/Gil-Werman passes
+static const int SE_SIZES[][2] = { { 1, 1 }, { 3, 3 }, { 5, 3 }, { 1, 7 }, { 9, 9 }, { 15, 5 }, { 21, 31 }, { 71, 3 } };
+
+// Erosion (isMax is false) or dilation (isMax is true) by direct search in the window (pixels out of image are skipped)
+static acv::Image ApplyDirectly(const acv::Image& img, const bool isMax, const int seWidth, const int seHeight)
+{
+    acv::Image result(img.GetHeight(), img.GetWidth());
+    for (int row = 0; row < img.GetHeight(); ++row)
+        for (int col = 0; col < img.GetWidth(); ++col)
+        {
+            int value = isMax ? acv::Image::MIN_PIXEL_VALUE : acv::Image::MAX_PIXEL_VALUE;
+            for (int y = std::max(row - seHeight / 2, 0); y <= std::min(row + seHeight / 2, img.GetHeight() - 1); ++y)
+                for (int x = std::max(col - seWidth / 2, 0); x <= std::min(col + seWidth / 2, img.GetWidth() - 1); ++x)
+                    value = isMax ? std::max<int>(value, img.GetPixel(y, x)) : std::min<int>(value, img.GetPixel(y, x));
+
+            result.SetPixel(row, col, static_cast<acv::Image::Byte>(value));
+        }
+
+    return result;
+}
+
+MorphologyTests::MorphologyTests()
+{
+}
+
+acv::Image MorphologyTests::FormRandomImage(const int height, const int width)
+{
+    std::uniform_int_distribution<int> di(acv::Image::MIN_PIXEL_VALUE, acv::Image::MAX_PIXEL_VALUE);
+
+    acv::Image img(height, width);
+    for (acv::Image::Byte& pixel : img.GetData())
+        pixel = static_cast<acv::Image::Byte>(di(mEngine));
+
+    return img;
+}
+
+void MorphologyTests::Erosion()
+{
+    const acv::Image img = FormRandomImage(53, 67);
+
+    for (const auto& size : SE_SIZES)
+    {
+        acv::Image result(img.GetHeight(), img.GetWidth());
+        QCOMPARE(acv::MorphologyFilter::Filter(img, result, MorphologyType::EROSION, size[0], size[1]), acv::FiltrationResult::SUCCESS);
+        QCOMPARE(result == ApplyDirectly(img, false, size[0], size[1]), true);
+    }
+}
+
+void MorphologyTests::Dilation()
+{
+    const acv::Image img = FormRandomImage(61, 48);
+
+    for (const auto& size : SE_SIZES)
+    {
+        acv::Image result(img.GetHeight(), img.GetWidth());
+        QCOMPARE(acv::MorphologyFilter::Filter(img, result, MorphologyType::DILATION, size[0], size[1]), acv::FiltrationResult::SUCCESS);
+        QCOMPARE(result == ApplyDirectly(img, true, size[0], size[1]), true);
+    }
+}
+
+void MorphologyTests::OpeningClosing()
+{
+    const acv::Image img = FormRandomImage(40, 45);
+
+    for (const auto& size : SE_SIZES)
+    {
+        acv::Image result(img.GetHeight(), img.GetWidth());
+
+        QCOMPARE(acv::MorphologyFilter::Filter(img, result, MorphologyType::OPENING, size[0], size[1]), acv::FiltrationResult::SUCCESS);
+        QCOMPARE(result == ApplyDirectly(ApplyDirectly(img, false, size[0], size[1]), true, size[0], size[1]), true);
+
+        QCOMPARE(acv::MorphologyFilter::Filter(img, result, MorphologyType::CLOSING, size[0], size[1]), acv::FiltrationResult::SUCCESS);
+        QCOMPARE(result == ApplyDirectly(ApplyDirectly(img, true, size[0], size[1]), false, size[0], size[1]), true);
+    }
+}
+
+void MorphologyTests::InPlace()
+{
+    const acv::Image img = FormRandomImage(33, 35);
+
+    acv::Image result(img);
+    QCOMPARE(acv::MorphologyFilter::Filter(result, MorphologyType::CLOSING, 11, 5), acv::FiltrationResult::SUCCESS);
+    QCOMPARE(result == ApplyDirectly(ApplyDirectly(img, true, 11, 5), false, 11, 5), true);
+}
+
+void MorphologyTests::IncorrectSize()
+{
+    const acv::Image img = FormRandomImage(10, 10);
+    acv::Image result(10, 10);
+
+    QCOMPARE(acv::MorphologyFilter::Filter(img, result, MorphologyType::EROSION, 4, 3), acv::FiltrationResult::INCORRECT_FILTER_SIZE);
+    QCOMPARE(acv::MorphologyFilter::Filter(img, result, MorphologyType::EROSION, 3, 0), acv::FiltrationResult::INCORRECT_FILTER_SIZE);
+
+    acv::Image wrongSizeImg(10, 11);
+    QCOMPARE(acv::MorphologyFilter::Filter(img, wrongSizeImg, MorphologyType::EROSION, 3, 3), acv::FiltrationResult::INTERNAL_ERROR);
+}
+
+QTEST_APPLESS_MAIN(MorphologyTests)
+
+#include "MorphologyTests.moc"
@@ -0,0 +1,220 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "MultiChannelImageTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <vector>
+#include <random>
+
+#include "Image.h"
+#include "MultiChannelImage.h"
+#include "ImageFilter.h"
+#include "ImageCorrector.h"
+
+// This class is used for testing of multi-channel image: the results are compared with the processing of each channel
+class MultiChannelImageTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    MultiChannelImageTests();
+
+private Q_SLOTS:
+
+    // Test of conversion of interleaved buffer to planar channels
+    void Deinterleave();
+
+    // Test of conversion of planar channels to interleaved buffer
+    void Interleave();
+
+    // Test of filtration of channels
+    void Filter();
+
+    // Test of correction of channels
+    void Correct();
+
+    // Test of scaling of channels
+    void Scale();
+
+    // Test of incorrect arguments
+    void IncorrectArguments();
+
+private:
+
+    // Form the buffer with random bytes
+    std::vector<acv::Image::Byte> FormRandomBuffer(const size_t size);
+
+    // Form the image with random pixels
+    acv::MultiChannelImage FormRandomImage(const int height, const int width, const int numChannels);
+
+    std::default_random_engine mEngine;
+
+};
+
+// Sizes of images to check the vectorized parts and the remainders of rows
+static const int HEIGHT = 23;
+static const int WIDTHS[] = { 1, 15, 16, 33, 70 };
+
+// Padding of rows of buffer in bytes
+static const int PADDING = 3;
+
+MultiChannelImageTests::MultiChannelImageTests()
+{
+}
+
+std::vector<acv::Image::Byte> MultiChannelImageTests::FormRandomBuffer(const size_t size)
+{
+    std::uniform_int_distribution<int> di(acv::Image::MIN_PIXEL_VALUE, acv::Image::MAX_PIXEL_VALUE);
+
+    std::vector<acv::Image::Byte> buf(size);
+    for (auto& val : buf)
+        val = static_cast<acv::Image::Byte>(di(mEngine));
+
+    return buf;
+}
+
+acv::MultiChannelImage MultiChannelImageTests::FormRandomImage(const int height, const int width, const int numChannels)
+{
+    const std::vector<acv::Image::Byte> buf = FormRandomBuffer(static_cast<size_t>(height) * width * numChannels);
+    return acv::MultiChannelImage(height, width, numChannels, buf.data(), width * numChannels);
+}
+
+void MultiChannelImageTests::Deinterleave()
+{
+    for (int numChannels = 1; numChannels <= acv::MultiChannelImage::MAX_NUM_CHANNELS; ++numChannels)
+        for (const int width : WIDTHS)
+        {
+            const int bytesPerLine = width * numChannels + PADDING;
+            const std::vector<acv::Image::Byte> buf = FormRandomBuffer(static_cast<size_t>(bytesPerLine) * HEIGHT);
+
+            acv::MultiChannelImage img(HEIGHT, width, numChannels);
+            QCOMPARE(img.Deinterleave(buf.data(), bytesPerLine), true);
+            QCOMPARE(img.GetNumChannels(), numChannels);
+
+            for (int channelNum = 0; channelNum < numChannels; ++channelNum)
+                for (int row = 0; row < HEIGHT; ++row)
+                    for (int col = 0; col < width; ++col)
+                        QCOMPARE(img.GetChannel(channelNum).GetPixel(row, col),
+                                 buf[row * bytesPerLine + col * numChannels + channelNum]);
+        }
+}
+
+void MultiChannelImageTests::Interleave()
+{
+    const acv::Image::Byte PADDING_VALUE = 0xA5;
+
+    for (int numChannels = 1; numChannels <= acv::MultiChannelImage::MAX_NUM_CHANNELS; ++numChannels)
+        for (const int width : WIDTHS)
+        {
+            const acv::MultiChannelImage img = FormRandomImage(HEIGHT, width, numChannels);
+
+            const int bytesPerLine = width * numChannels + PADDING;
+            std::vector<acv::Image::Byte> buf(static_cast<size_t>(bytesPerLine) * HEIGHT, PADDING_VALUE);
+            QCOMPARE(img.Interleave(buf.data(), bytesPerLine), true);
+
+            for (int row = 0; row < HEIGHT; ++row)
+            {
+                for (int col = 0; col < width; ++col)
+                    for (int channelNum = 0; channelNum < numChannels; ++channelNum)
+                        QCOMPARE(buf[row * bytesPerLine + col * numChannels + channelNum],
+                                 img.GetChannel(channelNum).GetPixel(row, col));
+
+                for (int byteNum = width * numChannels; byteNum < bytesPerLine; ++byteNum)
+                    QCOMPARE(buf[row * bytesPerLine + byteNum], PADDING_VALUE);
+            }
+        }
+}
+
+void MultiChannelImageTests::Filter()
+{
+    const acv::MultiChannelImage img = FormRandomImage(60, 45, 3);
+
+    acv::MultiChannelImage dst(img.GetHeight(), img.GetWidth(), img.GetNumChannels());
+    QCOMPARE(acv::ImageFilter::Filter(img, dst, acv::ImageFilter::FilterType::MEDIAN, 5) == acv::FiltrationResult::SUCCESS, true);
+
+    acv::MultiChannelImage inPlace(img);
+    QCOMPARE(acv::ImageFilter::Filter(inPlace, acv::ImageFilter::FilterType::MEDIAN, 5) == acv::FiltrationResult::SUCCESS, true);
+
+    for (int channelNum = 0; channelNum < img.GetNumChannels(); ++channelNum)
+    {
+        acv::Image expected(img.GetHeight(), img.GetWidth());
+        acv::ImageFilter::Filter(img.GetChannel(channelNum), expected, acv::ImageFilter::FilterType::MEDIAN, 5);
+
+        QCOMPARE(dst.GetChannel(channelNum) == expected, true);
+        QCOMPARE(inPlace.GetChannel(channelNum) == expected, true);
+    }
+}
+
+void MultiChannelImageTests::Correct()
+{
+    const acv::MultiChannelImage img = FormRandomImage(40, 50, 4);
+
+    acv::MultiChannelImage dst(img.GetHeight(), img.GetWidth(), img.GetNumChannels());
+    QCOMPARE(acv::ImageCorrector::Correct(img, dst, acv::ImageCorrector::CorrectorType::AUTO_LEVELS), true);
+
+    for (int channelNum = 0; channelNum < img.GetNumChannels(); ++channelNum)
+    {
+        acv::Image expected(img.GetHeight(), img.GetWidth());
+        acv::ImageCorrector::Correct(img.GetChannel(channelNum), expected, acv::ImageCorrector::CorrectorType::AUTO_LEVELS);
+
+        QCOMPARE(dst.GetChannel(channelNum) == expected, true);
+    }
+}
+
+void MultiChannelImageTests::Scale()
+{
+    const acv::MultiChannelImage img = FormRandomImage(20, 30, 2);
+    const acv::MultiChannelImage scaled = img.Scale(2, 3, acv::Image::ScaleType::UPSCALE);
+
+    QCOMPARE(scaled.GetNumChannels(), img.GetNumChannels());
+    for (int channelNum = 0; channelNum < img.GetNumChannels(); ++channelNum)
+        QCOMPARE(scaled.GetChannel(channelNum) == img.GetChannel(channelNum).Scale(2, 3, acv::Image::ScaleType::UPSCALE), true);
+}
+
+void MultiChannelImageTests::IncorrectArguments()
+{
+    const int WIDTH = 10, NUM_CHANNELS = 3;
+    std::vector<acv::Image::Byte> buf(static_cast<size_t>(WIDTH) * HEIGHT * NUM_CHANNELS);
+
+    acv::MultiChannelImage img(HEIGHT, WIDTH, NUM_CHANNELS);
+    QCOMPARE(img.Deinterleave(nullptr, WIDTH * NUM_CHANNELS), false);
+    QCOMPARE(img.Deinterleave(buf.data(), WIDTH * NUM_CHANNELS - 1), false);
+    QCOMPARE(img.Interleave(buf.data(), WIDTH * NUM_CHANNELS - 1), false);
+
+    acv::MultiChannelImage empty;
+    QCOMPARE(empty.IsInitialized(), false);
+    QCOMPARE(empty.Interleave(buf.data(), WIDTH * NUM_CHANNELS), false);
+
+    // Images of different formats
+    acv::MultiChannelImage other(HEIGHT, WIDTH, NUM_CHANNELS - 1);
+    QCOMPARE(img.HasSameFormat(other), false);
+    QCOMPARE(acv::ImageCorrector::Correct(img, other, acv::ImageCorrector::CorrectorType::GAMMA), false);
+}
+
+QTEST_APPLESS_MAIN(MultiChannelImageTests)
+
+#include "MultiChannelImageTests.moc"
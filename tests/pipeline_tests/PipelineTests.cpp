@@ -0,0 +1,230 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "PipelineTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+
+#include "Image.h"
+#include "Pipeline.h"
+#include "ImageFilter.h"
+#include "ImageCorrector.h"
+#include "BordersDetector.h"
+#include "MorphologyFilter.h"
+
+// This class is used for testing of pipeline: the result must be the same as the result of sequential operations
+class PipelineTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    PipelineTests();
+
+private Q_SLOTS:
+
+    // Test of neighbourhood operations fused with point operations
+    void NeighbourhoodAndPoint();
+
+    // Test of statistics operations after neighbourhood operations
+    void Statistics();
+
+    // Test of operations which need the whole image
+    void Global();
+
+    // Test of threshold and morphology
+    void ThresholdMorphology();
+
+    // Test of run with the same source and destination images
+    void InPlace();
+
+    // Test of incorrect operations
+    void IncorrectOperations();
+
+private:
+
+    // Form the image with smooth background and random noise (it is larger than strip of pipeline)
+    acv::Image FormTestImage();
+
+    std::default_random_engine mEngine;
+
+};
+
+typedef acv::ImageFilter::FilterType FilterType;
+typedef acv::ImageCorrector::CorrectorType CorrectorType;
+typedef acv::BordersDetector::DetectorType DetectorType;
+typedef acv::MorphologyFilter::MorphologyType MorphologyType;
+
+PipelineTests::PipelineTests()
+{
+}
+
+acv::Image PipelineTests::FormTestImage()
+{
+    const int HEIGHT = 1100, WIDTH = 700;
+    std::uniform_int_distribution<int> di(-30, 30);
+
+    acv::Image img(HEIGHT, WIDTH);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+        {
+            int pixel = 60 + (row / 7 + col / 5) % 120 + di(mEngine);
+            acv::Image::CheckPixelValue(pixel);
+            img.SetPixel(row, col, static_cast<acv::Image::Byte>(pixel));
+        }
+
+    return img;
+}
+
+void PipelineTests::NeighbourhoodAndPoint()
+{
+    const acv::Image img = FormTestImage();
+
+    acv::Pipeline pipeline;
+    pipeline.AddFilter(FilterType::MEDIAN, 3);
+    pipeline.AddCorrector(CorrectorType::GAMMA);
+    pipeline.AddBordersDetector(DetectorType::SOBEL);
+    pipeline.AddFilter(FilterType::SEP_GAUSSIAN, 5);
+
+    acv::Image result(img.GetHeight(), img.GetWidth());
+    QCOMPARE(pipeline.Run(img, result), true);
+
+    acv::Image expected(img.GetHeight(), img.GetWidth());
+    acv::ImageFilter::Filter(img, expected, FilterType::MEDIAN, 3);
+    acv::ImageCorrector::Correct(expected, CorrectorType::GAMMA);
+    acv::BordersDetector::DetectBorders(expected, DetectorType::SOBEL);
+    acv::ImageFilter::Filter(expected, FilterType::SEP_GAUSSIAN, 5);
+
+    QCOMPARE(result == expected, true);
+}
+
+void PipelineTests::Statistics()
+{
+    const acv::Image img = FormTestImage();
+
+    acv::Pipeline pipeline;
+    pipeline.AddCorrector(CorrectorType::GAMMA);
+    pipeline.AddFilter(FilterType::GAUSSIAN, 5);
+    pipeline.AddCorrector(CorrectorType::AUTO_LEVELS);
+    pipeline.AddOperator(DetectorType::SCHARR, acv::BordersDetector::OperatorType::VERTICAL);
+    pipeline.AddCorrector(CorrectorType::NORM_AUTO_LEVELS);
+    pipeline.AddCorrector(CorrectorType::GLOBAL_EQUALIZATION);
+
+    acv::Image result(img.GetHeight(), img.GetWidth());
+    QCOMPARE(pipeline.Run(img, result), true);
+
+    acv::Image expected(img.GetHeight(), img.GetWidth());
+    acv::ImageCorrector::Correct(img, expected, CorrectorType::GAMMA);
+    acv::ImageFilter::Filter(expected, FilterType::GAUSSIAN, 5);
+    acv::ImageCorrector::Correct(expected, CorrectorType::AUTO_LEVELS);
+    acv::BordersDetector::OperatorConvolution(expected, DetectorType::SCHARR, acv::BordersDetector::OperatorType::VERTICAL);
+    acv::ImageCorrector::Correct(expected, CorrectorType::NORM_AUTO_LEVELS);
+    acv::ImageCorrector::Correct(expected, CorrectorType::GLOBAL_EQUALIZATION);
+
+    QCOMPARE(result == expected, true);
+}
+
+void PipelineTests::Global()
+{
+    const acv::Image img = FormTestImage();
+
+    acv::Pipeline pipeline;
+    pipeline.AddFilter(FilterType::SHARPEN);
+    pipeline.AddFilter(FilterType::IIR_GAUSSIAN, 9);
+    pipeline.AddCorrector(CorrectorType::CLAHE);
+    pipeline.AddBordersDetector(DetectorType::CANNY);
+
+    acv::Image result(img.GetHeight(), img.GetWidth());
+    QCOMPARE(pipeline.Run(img, result), true);
+
+    acv::Image expected(img.GetHeight(), img.GetWidth());
+    acv::ImageFilter::Filter(img, expected, FilterType::SHARPEN);
+    acv::ImageFilter::Filter(expected, FilterType::IIR_GAUSSIAN, 9);
+    acv::ImageCorrector::Correct(expected, CorrectorType::CLAHE);
+    acv::BordersDetector::DetectBorders(expected, DetectorType::CANNY);
+
+    QCOMPARE(result == expected, true);
+}
+
+void PipelineTests::ThresholdMorphology()
+{
+    const acv::Image img = FormTestImage();
+
+    acv::Pipeline pipeline;
+    pipeline.AddAdaptiveThreshold(5, 3, acv::ImageFilter::ThresholdType::MAX_MORE_THRESHOLD);
+    pipeline.AddMorphology(MorphologyType::OPENING, 3, 5);
+    pipeline.AddAdaptiveThreshold(15, 0.2f, acv::ImageFilter::ThresholdMethod::SAUVOLA, acv::ImageFilter::ThresholdType::MIN_MORE_THRESHOLD);
+
+    acv::Image result(img.GetHeight(), img.GetWidth());
+    QCOMPARE(pipeline.Run(img, result), true);
+
+    acv::Image expected(img.GetHeight(), img.GetWidth());
+    acv::ImageFilter::AdaptiveThreshold(img, expected, 5, 3, acv::ImageFilter::ThresholdType::MAX_MORE_THRESHOLD);
+    acv::MorphologyFilter::Filter(expected, MorphologyType::OPENING, 3, 5);
+    acv::ImageFilter::AdaptiveThreshold(expected, 15, 0.2f, acv::ImageFilter::ThresholdMethod::SAUVOLA,
+                                        acv::ImageFilter::ThresholdType::MIN_MORE_THRESHOLD);
+
+    QCOMPARE(result == expected, true);
+}
+
+void PipelineTests::InPlace()
+{
+    const acv::Image img = FormTestImage();
+
+    acv::Pipeline pipeline;
+    pipeline.AddFilter(FilterType::MEDIAN, 5);
+    pipeline.AddMorphology(MorphologyType::DILATION, 5, 5);
+
+    acv::Image result(img);
+    QCOMPARE(pipeline.Run(result, result), true);
+
+    acv::Image expected(img.GetHeight(), img.GetWidth());
+    acv::ImageFilter::Filter(img, expected, FilterType::MEDIAN, 5);
+    acv::MorphologyFilter::Filter(expected, MorphologyType::DILATION, 5, 5);
+
+    QCOMPARE(result == expected, true);
+}
+
+void PipelineTests::IncorrectOperations()
+{
+    const acv::Image img = FormTestImage();
+    acv::Image result(img.GetHeight(), img.GetWidth());
+
+    acv::Pipeline pipeline;
+    pipeline.AddFilter(FilterType::MEDIAN, 4);
+    QCOMPARE(pipeline.Run(img, result), false);
+
+    pipeline.Clear();
+    QCOMPARE(pipeline.IsEmpty(), true);
+    pipeline.AddMorphology(MorphologyType::EROSION, 3, 2);
+    QCOMPARE(pipeline.Run(img, result), false);
+
+    QCOMPARE(pipeline.Run(acv::Image(), result), false);
+}
+
+QTEST_APPLESS_MAIN(PipelineTests)
+
+#include "PipelineTests.moc"
@@ -0,0 +1,233 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "PixelConverterTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <vector>
+#include <random>
+
+#include "Image.h"
+#include "PixelConverter.h"
+
+typedef acv::PixelConverter::PixelFormat PixelFormat;
+
+// This class is used for testing of bulk import and export of pixels: the results are compared with conversion of each pixel
+class PixelConverterTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    PixelConverterTests();
+
+private Q_SLOTS:
+
+    // Test of import of pixels of all formats
+    void Import();
+
+    // Test of export of pixels of all formats
+    void Export();
+
+    // Test of export and import of brightness without changes
+    void GrayRoundTrip();
+
+    // Test of incorrect arguments
+    void IncorrectArguments();
+
+private:
+
+    // Offsets of components in pixel of format (alpha offset is -1 if there is no alpha)
+    struct Layout
+    {
+        int r, g, b, a;
+    };
+
+    // Get the offsets of components by the description of format
+    static Layout GetLayout(PixelFormat format);
+
+    // Form the buffer with random bytes
+    std::vector<acv::Image::Byte> FormRandomBuffer(const size_t size);
+
+    std::default_random_engine mEngine;
+
+};
+
+static const PixelFormat FORMATS[] =
+{
+    acv::PixelConverter::PixelFormat::GRAY8,
+    acv::PixelConverter::PixelFormat::RGB888,
+    acv::PixelConverter::PixelFormat::BGR888,
+    acv::PixelConverter::PixelFormat::RGBA8888,
+    acv::PixelConverter::PixelFormat::BGRA8888,
+    acv::PixelConverter::PixelFormat::ARGB8888
+};
+
+// Sizes of images to check the vectorized parts and the remainders of rows
+static const int HEIGHT = 29;
+static const int WIDTHS[] = { 1, 7, 16, 37, 64, 101 };
+
+// Padding of rows of buffer in bytes
+static const int PADDING = 5;
+
+PixelConverterTests::PixelConverterTests()
+{
+}
+
+PixelConverterTests::Layout PixelConverterTests::GetLayout(PixelFormat format)
+{
+    switch (format)
+    {
+    case PixelFormat::GRAY8:
+        return Layout { 0, 0, 0, -1 };
+    case PixelFormat::RGB888:
+        return Layout { 0, 1, 2, -1 };
+    case PixelFormat::BGR888:
+        return Layout { 2, 1, 0, -1 };
+    case PixelFormat::RGBA8888:
+        return Layout { 0, 1, 2, 3 };
+    case PixelFormat::BGRA8888:
+        return Layout { 2, 1, 0, 3 };
+    case PixelFormat::ARGB8888:
+        return Layout { 1, 2, 3, 0 };
+    }
+
+    return Layout { 0, 0, 0, -1 };
+}
+
+std::vector<acv::Image::Byte> PixelConverterTests::FormRandomBuffer(const size_t size)
+{
+    std::uniform_int_distribution<int> di(acv::Image::MIN_PIXEL_VALUE, acv::Image::MAX_PIXEL_VALUE);
+
+    std::vector<acv::Image::Byte> buf(size);
+    for (auto& val : buf)
+        val = static_cast<acv::Image::Byte>(di(mEngine));
+
+    return buf;
+}
+
+void PixelConverterTests::Import()
+{
+    for (const PixelFormat format : FORMATS)
+        for (const int width : WIDTHS)
+        {
+            const int bytesPerPixel = acv::PixelConverter::GetBytesPerPixel(format);
+            const int bytesPerLine = width * bytesPerPixel + PADDING;
+            const std::vector<acv::Image::Byte> buf = FormRandomBuffer(static_cast<size_t>(bytesPerLine) * HEIGHT);
+            const Layout layout = GetLayout(format);
+
+            acv::Image img(HEIGHT, width);
+            QCOMPARE(acv::PixelConverter::Import(buf.data(), bytesPerLine, format, img), true);
+
+            for (int row = 0; row < HEIGHT; ++row)
+                for (int col = 0; col < width; ++col)
+                {
+                    const acv::Image::Byte* pPix = buf.data() + row * bytesPerLine + col * bytesPerPixel;
+                    const int expected = (format == PixelFormat::GRAY8) ? pPix[0] :
+                        (11 * pPix[layout.r] + 16 * pPix[layout.g] + 5 * pPix[layout.b]) / 32;
+                    QCOMPARE(static_cast<int>(img.GetPixel(row, col)), expected);
+                }
+        }
+}
+
+void PixelConverterTests::Export()
+{
+    const acv::Image::Byte PADDING_VALUE = 0x5A;
+
+    for (const PixelFormat format : FORMATS)
+        for (const int width : WIDTHS)
+        {
+            const int bytesPerPixel = acv::PixelConverter::GetBytesPerPixel(format);
+            const int bytesPerLine = width * bytesPerPixel + PADDING;
+            const std::vector<acv::Image::Byte> pixels = FormRandomBuffer(static_cast<size_t>(width) * HEIGHT);
+            const Layout layout = GetLayout(format);
+
+            acv::Image img(HEIGHT, width);
+            for (int row = 0; row < HEIGHT; ++row)
+                for (int col = 0; col < width; ++col)
+                    img.SetPixel(row, col, pixels[row * width + col]);
+
+            std::vector<acv::Image::Byte> buf(static_cast<size_t>(bytesPerLine) * HEIGHT, PADDING_VALUE);
+            QCOMPARE(acv::PixelConverter::Export(img, buf.data(), bytesPerLine, format), true);
+
+            for (int row = 0; row < HEIGHT; ++row)
+            {
+                for (int col = 0; col < width; ++col)
+                {
+                    const acv::Image::Byte* pPix = buf.data() + row * bytesPerLine + col * bytesPerPixel;
+                    const acv::Image::Byte val = img.GetPixel(row, col);
+                    QCOMPARE(pPix[layout.r], val);
+                    QCOMPARE(pPix[layout.g], val);
+                    QCOMPARE(pPix[layout.b], val);
+                    if (layout.a >= 0)
+                        QCOMPARE(static_cast<int>(pPix[layout.a]), static_cast<int>(acv::Image::MAX_PIXEL_VALUE));
+                }
+
+                // Padding of rows must be kept
+                for (int byteNum = width * bytesPerPixel; byteNum < bytesPerLine; ++byteNum)
+                    QCOMPARE(buf[row * bytesPerLine + byteNum], PADDING_VALUE);
+            }
+        }
+}
+
+void PixelConverterTests::GrayRoundTrip()
+{
+    const int WIDTH = 77;
+    const std::vector<acv::Image::Byte> buf = FormRandomBuffer(static_cast<size_t>(WIDTH) * HEIGHT);
+
+    acv::Image img(HEIGHT, WIDTH);
+    QCOMPARE(acv::PixelConverter::Import(buf.data(), WIDTH, PixelFormat::GRAY8, img), true);
+
+    // Colors with equal components keep the brightness
+    std::vector<acv::Image::Byte> colorBuf(static_cast<size_t>(WIDTH) * HEIGHT * 4);
+    QCOMPARE(acv::PixelConverter::Export(img, colorBuf.data(), WIDTH * 4, PixelFormat::BGRA8888), true);
+
+    acv::Image result(HEIGHT, WIDTH);
+    QCOMPARE(acv::PixelConverter::Import(colorBuf.data(), WIDTH * 4, PixelFormat::BGRA8888, result), true);
+
+    std::vector<acv::Image::Byte> resultBuf(buf.size());
+    QCOMPARE(acv::PixelConverter::Export(result, resultBuf.data(), WIDTH, PixelFormat::GRAY8), true);
+    QCOMPARE(resultBuf == buf, true);
+}
+
+void PixelConverterTests::IncorrectArguments()
+{
+    const int WIDTH = 10;
+    std::vector<acv::Image::Byte> buf(static_cast<size_t>(WIDTH) * HEIGHT * 4);
+    acv::Image img(HEIGHT, WIDTH);
+    acv::Image empty;
+
+    QCOMPARE(acv::PixelConverter::Import(nullptr, WIDTH, PixelFormat::GRAY8, img), false);
+    QCOMPARE(acv::PixelConverter::Import(buf.data(), WIDTH * 3 - 1, PixelFormat::RGB888, img), false);
+    QCOMPARE(acv::PixelConverter::Import(buf.data(), WIDTH, PixelFormat::GRAY8, empty), false);
+
+    QCOMPARE(acv::PixelConverter::Export(img, nullptr, WIDTH, PixelFormat::GRAY8), false);
+    QCOMPARE(acv::PixelConverter::Export(img, buf.data(), WIDTH * 4 - 1, PixelFormat::ARGB8888), false);
+    QCOMPARE(acv::PixelConverter::Export(empty, buf.data(), WIDTH, PixelFormat::GRAY8), false);
+}
+
+QTEST_APPLESS_MAIN(PixelConverterTests)
+
+#include "PixelConverterTests.moc"
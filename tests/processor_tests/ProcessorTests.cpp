@@ -0,0 +1,231 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "ProcessorTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+#include <vector>
+
+#include "Image.h"
+#include "ImageFilter.h"
+#include "BordersDetector.h"
+#include "FilterProcessor.h"
+#include "BordersProcessor.h"
+
+// This class is used for testing of processors of frames: the results of each frame are compared with the one-shot processing
+class ProcessorTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    ProcessorTests();
+
+private Q_SLOTS:
+
+    // Test of filters
+    void Filter();
+
+    // Test of filters in place
+    void FilterInPlace();
+
+    // Test of borders detectors
+    void DetectBorders();
+
+    // Test of borders detectors in place
+    void DetectBordersInPlace();
+
+    // Test of incorrect configurations and frames
+    void IncorrectArguments();
+
+private:
+
+    // Frames of sequence
+    std::vector<acv::Image> mFrames;
+
+};
+
+// Tested filters and their sizes
+static const struct
+{
+    acv::ImageFilter::FilterType type;
+    int filterSize;
+} FILTERS[] =
+{
+    { acv::ImageFilter::FilterType::MEDIAN, 5 },
+    { acv::ImageFilter::FilterType::GAUSSIAN, 5 },
+    { acv::ImageFilter::FilterType::SEP_GAUSSIAN, 7 },
+    { acv::ImageFilter::FilterType::IIR_GAUSSIAN, 13 },
+    { acv::ImageFilter::FilterType::SHARPEN, -1 },
+    { acv::ImageFilter::FilterType::BILATERAL, 13 },
+    { acv::ImageFilter::FilterType::UNSHARP_MASK, 7 }
+};
+
+// Tested borders detectors
+static const acv::BordersDetector::DetectorType DETECTORS[] =
+{
+    acv::BordersDetector::DetectorType::SOBEL,
+    acv::BordersDetector::DetectorType::SCHARR,
+    acv::BordersDetector::DetectorType::CANNY,
+    acv::BordersDetector::DetectorType::CANNY_BILATERAL
+};
+
+// Sizes of frames and their number
+static const int HEIGHT = 97, WIDTH = 131, NUM_FRAMES = 3;
+
+ProcessorTests::ProcessorTests()
+{
+    // Frames of blocks with noise, the blocks are moved from frame to frame
+    std::default_random_engine engine;
+    std::uniform_int_distribution<int> di(-30, 30);
+    for (int frame = 0; frame < NUM_FRAMES; ++frame)
+    {
+        acv::Image img(HEIGHT, WIDTH);
+        for (int row = 0; row < HEIGHT; ++row)
+            for (int col = 0; col < WIDTH; ++col)
+            {
+                int pixel = 60 + (((row + 3 * frame) / 17 + (col + 5 * frame) / 11) % 3) * 60 + di(engine);
+                acv::Image::CheckPixelValue(pixel);
+                img.SetPixel(row, col, static_cast<acv::Image::Byte>(pixel));
+            }
+        mFrames.push_back(img);
+    }
+}
+
+void ProcessorTests::Filter()
+{
+    for (const auto& filter : FILTERS)
+    {
+        acv::FilterProcessor processor;
+        QCOMPARE(processor.Configure(HEIGHT, WIDTH, filter.type, filter.filterSize), acv::FiltrationResult::SUCCESS);
+        QVERIFY(processor.IsConfigured());
+
+        acv::Image result(HEIGHT, WIDTH), expected(HEIGHT, WIDTH);
+        for (const acv::Image& frame : mFrames)
+        {
+            QCOMPARE(processor.Process(frame, result), acv::FiltrationResult::SUCCESS);
+            QCOMPARE(acv::ImageFilter::Filter(frame, expected, filter.type, filter.filterSize), acv::FiltrationResult::SUCCESS);
+            QVERIFY(result == expected);
+        }
+    }
+}
+
+void ProcessorTests::FilterInPlace()
+{
+    for (const auto& filter : FILTERS)
+    {
+        acv::FilterProcessor processor;
+        QCOMPARE(processor.Configure(HEIGHT, WIDTH, filter.type, filter.filterSize), acv::FiltrationResult::SUCCESS);
+
+        for (const acv::Image& frame : mFrames)
+        {
+            acv::Image result = frame, expected = frame;
+            QCOMPARE(processor.Process(result), acv::FiltrationResult::SUCCESS);
+            QCOMPARE(acv::ImageFilter::Filter(expected, filter.type, filter.filterSize), acv::FiltrationResult::SUCCESS);
+            QVERIFY(result == expected);
+        }
+    }
+}
+
+void ProcessorTests::DetectBorders()
+{
+    for (const auto type : DETECTORS)
+    {
+        acv::BordersProcessor processor;
+        QVERIFY(processor.Configure(HEIGHT, WIDTH, type));
+        QVERIFY(processor.IsConfigured());
+
+        acv::Image result(HEIGHT, WIDTH), expected(HEIGHT, WIDTH);
+        for (const acv::Image& frame : mFrames)
+        {
+            QVERIFY(processor.Process(frame, result));
+            QVERIFY(acv::BordersDetector::DetectBorders(frame, expected, type));
+            QVERIFY(result == expected);
+        }
+    }
+
+    // Canny detector with not default thresholds
+    acv::BordersProcessor processor;
+    QVERIFY(processor.Configure(HEIGHT, WIDTH, acv::BordersDetector::DetectorType::CANNY, 20, 60));
+
+    acv::Image result(HEIGHT, WIDTH), expected(HEIGHT, WIDTH);
+    for (const acv::Image& frame : mFrames)
+    {
+        QVERIFY(processor.Process(frame, result));
+        QVERIFY(acv::BordersDetector::DetectBorders(frame, expected, acv::BordersDetector::DetectorType::CANNY, 20, 60));
+        QVERIFY(result == expected);
+    }
+}
+
+void ProcessorTests::DetectBordersInPlace()
+{
+    for (const auto type : DETECTORS)
+    {
+        acv::BordersProcessor processor;
+        QVERIFY(processor.Configure(HEIGHT, WIDTH, type));
+
+        for (const acv::Image& frame : mFrames)
+        {
+            acv::Image result = frame, expected = frame;
+            QVERIFY(processor.Process(result));
+            QVERIFY(acv::BordersDetector::DetectBorders(expected, type));
+            QVERIFY(result == expected);
+        }
+    }
+}
+
+void ProcessorTests::IncorrectArguments()
+{
+    acv::FilterProcessor filterProcessor;
+    acv::Image frame = mFrames.front();
+
+    // Not configured processor
+    QVERIFY(!filterProcessor.IsConfigured());
+    QCOMPARE(filterProcessor.Process(frame), acv::FiltrationResult::INTERNAL_ERROR);
+
+    // Incorrect sizes of filters and frames
+    QCOMPARE(filterProcessor.Configure(HEIGHT, WIDTH, acv::ImageFilter::FilterType::MEDIAN, 4), acv::FiltrationResult::INCORRECT_FILTER_SIZE);
+    QCOMPARE(filterProcessor.Configure(HEIGHT, WIDTH, acv::ImageFilter::FilterType::IIR_GAUSSIAN, 5), acv::FiltrationResult::SMALL_FILTER_SIZE);
+    QCOMPARE(filterProcessor.Configure(0, WIDTH, acv::ImageFilter::FilterType::GAUSSIAN, 5), acv::FiltrationResult::INTERNAL_ERROR);
+    QVERIFY(!filterProcessor.IsConfigured());
+
+    // Frame of other sizes
+    QCOMPARE(filterProcessor.Configure(HEIGHT, WIDTH, acv::ImageFilter::FilterType::GAUSSIAN, 5), acv::FiltrationResult::SUCCESS);
+    acv::Image smallFrame(HEIGHT - 1, WIDTH);
+    QCOMPARE(filterProcessor.Process(smallFrame), acv::FiltrationResult::INTERNAL_ERROR);
+
+    acv::BordersProcessor bordersProcessor;
+    QVERIFY(!bordersProcessor.IsConfigured());
+    QVERIFY(!bordersProcessor.Process(frame));
+    QVERIFY(!bordersProcessor.Configure(2, WIDTH, acv::BordersDetector::DetectorType::SOBEL));
+
+    QVERIFY(bordersProcessor.Configure(HEIGHT, WIDTH, acv::BordersDetector::DetectorType::SOBEL));
+    QVERIFY(!bordersProcessor.Process(smallFrame));
+}
+
+QTEST_APPLESS_MAIN(ProcessorTests)
+
+#include "ProcessorTests.moc"
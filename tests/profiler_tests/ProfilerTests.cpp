@@ -0,0 +1,254 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "ProfilerTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+#include "Image.h"
+#include "Profiler.h"
+#include "BordersDetector.h"
+
+// This class is used for testing of built-in profiler: the statistics are compared with the added measurements
+class ProfilerTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    ~ProfilerTests();
+
+private Q_SLOTS:
+
+    // Test of statistics of stages
+    void Stages();
+
+    // Test of statistics of counters
+    void Counters();
+
+    // Test of measurements from several threads
+    void Threads();
+
+    // Test of timeline in format of Chrome trace
+    void ChromeTrace();
+
+    // Test of instrumentation of engine
+    void EngineStages();
+
+private:
+
+    // Find the statistics of stage or counter by name (returns nullptr if it isn't found)
+    template <typename Stats>
+    static const Stats* Find(const std::vector<Stats>& stats, const std::string& name);
+
+};
+
+// Name of temporary file of timeline
+static const char* TRACE_FILE_NAME = "ProfilerTests.json";
+
+ProfilerTests::~ProfilerTests()
+{
+    std::remove(TRACE_FILE_NAME);
+    acv::Profiler::SetTraceEnabled(false);
+    acv::Profiler::Reset();
+}
+
+template <typename Stats>
+const Stats* ProfilerTests::Find(const std::vector<Stats>& stats, const std::string& name)
+{
+    for (const Stats& item : stats)
+        if (item.name == name)
+            return &item;
+
+    return nullptr;
+}
+
+void ProfilerTests::Stages()
+{
+    typedef acv::Profiler::Clock Clock;
+
+    acv::Profiler::Reset();
+
+    // Runs of stages with known durations
+    const Clock::time_point start = Clock::now();
+    acv::Profiler::AddStage("Short", start, start + std::chrono::milliseconds(2), 100);
+    acv::Profiler::AddStage("Short", start, start + std::chrono::milliseconds(4), 50);
+    acv::Profiler::AddStage("Long", start, start + std::chrono::milliseconds(10));
+
+    const std::vector<acv::Profiler::StageStats> stages = acv::Profiler::GetStageStats();
+    QCOMPARE(stages.size(), static_cast<size_t>(2));
+
+    // Stages are sorted by total time
+    QCOMPARE(stages[0].name, std::string("Long"));
+    QCOMPARE(stages[0].calls, 1LL);
+    QCOMPARE(stages[0].totalMs, 10.0);
+    QCOMPARE(stages[0].bytes, 0LL);
+
+    QCOMPARE(stages[1].name, std::string("Short"));
+    QCOMPARE(stages[1].calls, 2LL);
+    QCOMPARE(stages[1].totalMs, 6.0);
+    QCOMPARE(stages[1].minMs, 2.0);
+    QCOMPARE(stages[1].maxMs, 4.0);
+    QCOMPARE(stages[1].bytes, 150LL);
+
+    // Scoped timer adds one run
+    {
+        acv::Profiler::ScopedTimer timer("Scoped", 10);
+    }
+    const std::vector<acv::Profiler::StageStats> scopedStages = acv::Profiler::GetStageStats();
+    const acv::Profiler::StageStats* scoped = Find(scopedStages, "Scoped");
+    QVERIFY(scoped != nullptr);
+    QCOMPARE(scoped->calls, 1LL);
+    QCOMPARE(scoped->bytes, 10LL);
+    QVERIFY(scoped->totalMs >= 0.0);
+
+    acv::Profiler::Reset();
+    QVERIFY(acv::Profiler::GetStageStats().empty());
+}
+
+void ProfilerTests::Counters()
+{
+    acv::Profiler::Reset();
+
+    acv::Profiler::AddCount("Bytes", 10);
+    acv::Profiler::AddCount("Bytes", 32);
+    acv::Profiler::AddCount("Allocations", 1);
+
+    const std::vector<acv::Profiler::CounterStats> counters = acv::Profiler::GetCounterStats();
+    QCOMPARE(counters.size(), static_cast<size_t>(2));
+
+    // Counters are sorted by name
+    QCOMPARE(counters[0].name, std::string("Allocations"));
+    QCOMPARE(counters[0].events, 1LL);
+    QCOMPARE(counters[0].total, 1LL);
+
+    QCOMPARE(counters[1].name, std::string("Bytes"));
+    QCOMPARE(counters[1].events, 2LL);
+    QCOMPARE(counters[1].total, 42LL);
+
+    acv::Profiler::Reset();
+    QVERIFY(acv::Profiler::GetCounterStats().empty());
+}
+
+void ProfilerTests::Threads()
+{
+    typedef acv::Profiler::Clock Clock;
+
+    const int NUM_THREADS = 8, NUM_RUNS = 1000;
+
+    acv::Profiler::Reset();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i)
+        threads.emplace_back([]()
+        {
+            const Clock::time_point start = Clock::now();
+            for (int run = 0; run < NUM_RUNS; ++run)
+            {
+                acv::Profiler::AddStage("Stage", start, start + std::chrono::microseconds(500), 1);
+                acv::Profiler::AddCount("Counter", 2);
+            }
+        });
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // All measurements of all threads are collected
+    const std::vector<acv::Profiler::StageStats> stages = acv::Profiler::GetStageStats();
+    const acv::Profiler::StageStats* stage = Find(stages, "Stage");
+    QVERIFY(stage != nullptr);
+    QCOMPARE(stage->calls, static_cast<long long>(NUM_THREADS * NUM_RUNS));
+    QCOMPARE(stage->bytes, static_cast<long long>(NUM_THREADS * NUM_RUNS));
+    QCOMPARE(stage->minMs, 0.5);
+    QCOMPARE(stage->maxMs, 0.5);
+
+    const std::vector<acv::Profiler::CounterStats> counters = acv::Profiler::GetCounterStats();
+    const acv::Profiler::CounterStats* counter = Find(counters, "Counter");
+    QVERIFY(counter != nullptr);
+    QCOMPARE(counter->events, static_cast<long long>(NUM_THREADS * NUM_RUNS));
+    QCOMPARE(counter->total, static_cast<long long>(2 * NUM_THREADS * NUM_RUNS));
+}
+
+void ProfilerTests::ChromeTrace()
+{
+    typedef acv::Profiler::Clock Clock;
+
+    acv::Profiler::Reset();
+
+    // Runs aren't recorded while the timeline is disabled
+    QVERIFY(!acv::Profiler::IsTraceEnabled());
+    const Clock::time_point start = Clock::now();
+    acv::Profiler::AddStage("Hidden", start, start + std::chrono::milliseconds(1));
+
+    acv::Profiler::SetTraceEnabled(true);
+    QVERIFY(acv::Profiler::IsTraceEnabled());
+    acv::Profiler::AddStage("First", start, start + std::chrono::milliseconds(3));
+    acv::Profiler::AddStage("Second \"quoted\"", start, start + std::chrono::milliseconds(1));
+    acv::Profiler::SetTraceEnabled(false);
+
+    QVERIFY(acv::Profiler::WriteChromeTrace(TRACE_FILE_NAME));
+
+    std::ifstream file(TRACE_FILE_NAME);
+    std::stringstream stream;
+    stream << file.rdbuf();
+    const std::string json = stream.str();
+
+    QCOMPARE(json.find("{\"traceEvents\":["), static_cast<size_t>(0));
+    QVERIFY(json.find("\"Hidden\"") == std::string::npos);
+    QVERIFY(json.find("{\"name\":\"First\",\"cat\":\"acv\",\"ph\":\"X\"") != std::string::npos);
+    QVERIFY(json.find("\"dur\":3000}") != std::string::npos);
+    QVERIFY(json.find("\"Second \\\"quoted\\\"\"") != std::string::npos);
+    QVERIFY(json.find("\"displayTimeUnit\":\"ms\"}") != std::string::npos);
+
+    // The statistics of all stages are collected regardless of timeline
+    QCOMPARE(acv::Profiler::GetStageStats().size(), static_cast<size_t>(3));
+
+    // Incorrect name of file
+    QVERIFY(!acv::Profiler::WriteChromeTrace("not_existing_directory/ProfilerTests.json"));
+}
+
+void ProfilerTests::EngineStages()
+{
+    acv::Profiler::Reset();
+
+    acv::Image img(64, 64);
+    for (int row = 0; row < img.GetHeight(); ++row)
+        for (int col = 0; col < img.GetWidth(); ++col)
+            img.SetPixel(row, col, static_cast<acv::Image::Byte>((row / 8 + col / 8) % 2 ? 200 : 50));
+    QVERIFY(acv::BordersDetector::DetectBorders(img, acv::BordersDetector::DetectorType::CANNY));
+
+    // The stages are measured only by the engine which was built with profiling
+    QCOMPARE(acv::Profiler::GetStageStats().empty(), !acv::Profiler::IsEnabled());
+}
+
+QTEST_APPLESS_MAIN(ProfilerTests)
+
+#include "ProfilerTests.moc"
@@ -0,0 +1,210 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "ProgressTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+
+#include "AImage.h"
+#include "AProgress.h"
+#include "AImageFilter.h"
+#include "AImageCorrector.h"
+#include "ABordersDetector.h"
+#include "AMorphologyFilter.h"
+#include "AImageCombiner.h"
+
+// This class is used for testing of progress and cancellation of operations of service API
+class ProgressTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    ProgressTests();
+
+private Q_SLOTS:
+
+    // Test of reported percents of finished operation
+    void Percents();
+
+    // Test of cancellation before the start of operation
+    void CancelBeforeStart();
+
+    // Test of cancellation during the operation
+    void CancelDuringOperation();
+
+    // Test of reset of progress and of shared state of copies
+    void ResetAndCopies();
+
+    // Test of progress of several operations
+    void Operations();
+
+private:
+
+    AImage mImage;
+
+};
+
+// Sizes of image (several bands of rows are processed in parallel)
+static const int HEIGHT = 600, WIDTH = 500;
+
+ProgressTests::ProgressTests()
+    : mImage(HEIGHT, WIDTH)
+{
+    std::default_random_engine engine;
+    std::uniform_int_distribution<int> di(0, 255);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+            mImage.SetPixel(row, col, static_cast<AByte>((row / 20 + col / 30) % 2 ? 200 - di(engine) / 8 : 50 + di(engine) / 8));
+}
+
+void ProgressTests::Percents()
+{
+    std::mutex mutex;
+    std::vector<int> percents;
+
+    AProgress progress;
+    progress.SetCallback([&](int percent)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        percents.push_back(percent);
+    });
+
+    AImage result(HEIGHT, WIDTH), expected(HEIGHT, WIDTH);
+    QCOMPARE(AImageFilter::Filter(mImage, result, AFilterType::GAUSSIAN, 5, &progress), AFiltrationResult::SUCCESS);
+    QCOMPARE(AImageFilter::Filter(mImage, expected, AFilterType::GAUSSIAN, 5), AFiltrationResult::SUCCESS);
+
+    // The progress doesn't change the result
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+            QCOMPARE(result.GetPixel(row, col), expected.GetPixel(row, col));
+
+    // Each percent is reported once (the order of percents of different threads isn't defined)
+    QCOMPARE(progress.GetPercent(), 100);
+    QVERIFY(!progress.IsCancelled());
+    QVERIFY(!percents.empty());
+    QCOMPARE(percents.front(), 0);
+
+    std::sort(percents.begin(), percents.end());
+    QVERIFY(std::adjacent_find(percents.begin(), percents.end()) == percents.end());
+    QCOMPARE(percents.back(), 100);
+}
+
+void ProgressTests::CancelBeforeStart()
+{
+    // The cancellation which was requested before the start is kept by operation
+    AProgress progress;
+    progress.Cancel();
+    QVERIFY(progress.IsCancelled());
+
+    AImage result(HEIGHT, WIDTH);
+    QCOMPARE(AImageFilter::Filter(mImage, result, AFilterType::MEDIAN, 5, &progress), AFiltrationResult::CANCELLED);
+    QVERIFY(progress.IsCancelled());
+    QVERIFY(progress.GetPercent() < 100);
+}
+
+void ProgressTests::CancelDuringOperation()
+{
+    // The operation is cancelled by callback after the first reported percent
+    // (the callback doesn't own a copy of progress, otherwise the shared state would own itself)
+    AProgress progress;
+    AProgress* canceller = &progress;
+    progress.SetCallback([canceller](int percent)
+    {
+        if (percent > 0)
+            canceller->Cancel();
+    });
+
+    AImage result(HEIGHT, WIDTH);
+    QCOMPARE(AImageFilter::Filter(mImage, result, AFilterType::MEDIAN, 7, &progress), AFiltrationResult::CANCELLED);
+    QVERIFY(progress.IsCancelled());
+    QVERIFY(progress.GetPercent() < 100);
+}
+
+void ProgressTests::ResetAndCopies()
+{
+    AProgress progress;
+    AProgress copy = progress;
+
+    // The copies share the state
+    copy.Cancel();
+    QVERIFY(progress.IsCancelled());
+
+    AImage result(HEIGHT, WIDTH);
+    QCOMPARE(AImageFilter::Filter(mImage, result, AFilterType::SHARPEN, 3, &progress), AFiltrationResult::CANCELLED);
+
+    // Reset prepares the progress for the next operation
+    progress.Reset();
+    QVERIFY(!copy.IsCancelled());
+    QCOMPARE(copy.GetPercent(), 0);
+
+    QCOMPARE(AImageFilter::Filter(mImage, result, AFilterType::SHARPEN, 3, &progress), AFiltrationResult::SUCCESS);
+    QCOMPARE(copy.GetPercent(), 100);
+}
+
+void ProgressTests::Operations()
+{
+    AImage result(HEIGHT, WIDTH);
+    AProgress progress;
+
+    // Finished operations report all work
+    QVERIFY(AImageCorrector::Correct(mImage, result, ACorrectorType::AUTO_LEVELS, &progress));
+    QCOMPARE(progress.GetPercent(), 100);
+
+    progress.Reset();
+    QVERIFY(ABordersDetector::DetectBorders(mImage, result, ADetectorType::CANNY, &progress));
+    QCOMPARE(progress.GetPercent(), 100);
+
+    progress.Reset();
+    QCOMPARE(AMorphologyFilter::Filter(mImage, result, AMorphologyType::OPENING, 5, 5, &progress), AFiltrationResult::SUCCESS);
+    QCOMPARE(progress.GetPercent(), 100);
+
+    AImage other(HEIGHT, WIDTH);
+    QCOMPARE(AImageFilter::Filter(mImage, other, AFilterType::GAUSSIAN, 5), AFiltrationResult::SUCCESS);
+
+    AImageCombiner combiner;
+    combiner.AddImage(mImage);
+    combiner.AddImage(other);
+
+    progress.Reset();
+    QCOMPARE(combiner.Combine(ACombineType::INFORM_PRIORITY, result, true, &progress), ACombinationResult::SUCCESS);
+    QCOMPARE(progress.GetPercent(), 100);
+
+    // Cancelled operations report the failure
+    progress.Reset();
+    progress.Cancel();
+    QVERIFY(!AImageCorrector::Correct(mImage, result, ACorrectorType::AUTO_LEVELS, &progress));
+    QVERIFY(!ABordersDetector::DetectBorders(mImage, result, ADetectorType::CANNY, &progress));
+    QCOMPARE(AMorphologyFilter::Filter(mImage, result, AMorphologyType::OPENING, 5, 5, &progress), AFiltrationResult::CANCELLED);
+    QCOMPARE(combiner.Combine(ACombineType::INFORM_PRIORITY, result, true, &progress), ACombinationResult::CANCELLED);
+}
+
+QTEST_APPLESS_MAIN(ProgressTests)
+
+#include "ProgressTests.moc"
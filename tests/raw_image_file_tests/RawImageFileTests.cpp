@@ -0,0 +1,251 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "RawImageFileTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+
+#include "Image.h"
+#include "RawImageFile.h"
+
+// This class is used for testing of raw image file: the tiles and regions are compared with the pixels of saved image
+class RawImageFileTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    RawImageFileTests();
+
+    ~RawImageFileTests();
+
+private Q_SLOTS:
+
+    // Test of saving and loading of the whole image
+    void SaveLoad();
+
+    // Test of pixels of tiles
+    void Tiles();
+
+    // Test of reading of regions
+    void ReadRegion();
+
+    // Test of writing of regions and tiles
+    void WriteRegion();
+
+    // Test of incorrect arguments
+    void IncorrectArguments();
+
+private:
+
+    // Form the image with random pixels
+    acv::Image FormRandomImage(const int height, const int width);
+
+    std::default_random_engine mEngine;
+
+};
+
+// Name of temporary file
+static const char* FILE_NAME = "RawImageFileTests.acvraw";
+
+// Sizes of image (they are not multiple of tile size) and tile
+static const int HEIGHT = 301, WIDTH = 517, TILE_SIZE = 64;
+
+RawImageFileTests::RawImageFileTests()
+{
+}
+
+RawImageFileTests::~RawImageFileTests()
+{
+    std::remove(FILE_NAME);
+}
+
+acv::Image RawImageFileTests::FormRandomImage(const int height, const int width)
+{
+    std::uniform_int_distribution<int> di(acv::Image::MIN_PIXEL_VALUE, acv::Image::MAX_PIXEL_VALUE);
+
+    acv::Image img(height, width);
+    for (auto& pixel : img.GetData())
+        pixel = static_cast<acv::Image::Byte>(di(mEngine));
+
+    return img;
+}
+
+void RawImageFileTests::SaveLoad()
+{
+    const acv::Image img = FormRandomImage(HEIGHT, WIDTH);
+    QCOMPARE(acv::RawImageFile::Save(FILE_NAME, img, TILE_SIZE), true);
+
+    acv::Image loaded;
+    QCOMPARE(acv::RawImageFile::Load(FILE_NAME, loaded), true);
+    QCOMPARE(loaded == img, true);
+
+    // Created file contains zero pixels
+    QCOMPARE(acv::RawImageFile::Create(FILE_NAME, 70, 90, 32), true);
+    QCOMPARE(acv::RawImageFile::Load(FILE_NAME, loaded), true);
+    QCOMPARE(loaded.GetHeight(), 70);
+    QCOMPARE(loaded.GetWidth(), 90);
+    for (const auto pixel : loaded.GetData())
+        QCOMPARE(static_cast<int>(pixel), 0);
+}
+
+void RawImageFileTests::Tiles()
+{
+    const acv::Image img = FormRandomImage(HEIGHT, WIDTH);
+    QCOMPARE(acv::RawImageFile::Save(FILE_NAME, img, TILE_SIZE), true);
+
+    acv::RawImageFile file;
+    QCOMPARE(file.Open(FILE_NAME), true);
+    QCOMPARE(file.GetHeight(), HEIGHT);
+    QCOMPARE(file.GetWidth(), WIDTH);
+    QCOMPARE(file.GetTileSize(), static_cast<int>(TILE_SIZE));
+    QCOMPARE(file.GetNumTilesY(), (HEIGHT + TILE_SIZE - 1) / TILE_SIZE);
+    QCOMPARE(file.GetNumTilesX(), (WIDTH + TILE_SIZE - 1) / TILE_SIZE);
+
+    const acv::RawImageFile& constFile = file;
+    for (int tileRow = 0; tileRow < file.GetNumTilesY(); ++tileRow)
+        for (int tileCol = 0; tileCol < file.GetNumTilesX(); ++tileCol)
+        {
+            const acv::Image::Byte* pTile = constFile.GetTilePointer(tileRow, tileCol);
+            QCOMPARE(pTile != nullptr, true);
+            QCOMPARE(reinterpret_cast<std::uintptr_t>(pTile) % acv::RawImageFile::ALIGNMENT, static_cast<std::uintptr_t>(0));
+
+            for (int row = 0; row < TILE_SIZE && tileRow * TILE_SIZE + row < HEIGHT; ++row)
+                for (int col = 0; col < TILE_SIZE && tileCol * TILE_SIZE + col < WIDTH; ++col)
+                    QCOMPARE(pTile[row * TILE_SIZE + col], img.GetPixel(tileRow * TILE_SIZE + row, tileCol * TILE_SIZE + col));
+        }
+
+    QCOMPARE(file.GetTileIndex(TILE_SIZE - 1), 0);
+    QCOMPARE(file.GetTileIndex(TILE_SIZE), 1);
+
+    // Hints don't change the pixels
+    file.PrefetchTileRows(0, file.GetNumTilesY());
+    file.ReleaseTileRows(0, file.GetNumTilesY());
+    file.ReleaseTiles(1, 2, 0, file.GetNumTilesX());
+    acv::Image region(HEIGHT, WIDTH);
+    QCOMPARE(file.ReadRegion(0, 0, region), true);
+    QCOMPARE(region == img, true);
+}
+
+void RawImageFileTests::ReadRegion()
+{
+    const acv::Image img = FormRandomImage(HEIGHT, WIDTH);
+    QCOMPARE(acv::RawImageFile::Save(FILE_NAME, img, TILE_SIZE), true);
+
+    acv::RawImageFile file;
+    QCOMPARE(file.Open(FILE_NAME), true);
+
+    // Regions inside one tile, crossing the borders of tiles and touching the edges of image
+    const int REGIONS[][4] = { { 0, 0, 1, 1 }, { 5, 7, 30, 20 }, { 60, 50, 10, 100 }, { 100, 130, 200, 150 },
+                               { WIDTH - 37, HEIGHT - 45, 37, 45 }, { 0, HEIGHT - 1, WIDTH, 1 } };
+    for (const auto& reg : REGIONS)
+    {
+        acv::Image region(reg[3], reg[2]);
+        QCOMPARE(file.ReadRegion(reg[0], reg[1], region), true);
+
+        for (int row = 0; row < reg[3]; ++row)
+            for (int col = 0; col < reg[2]; ++col)
+                QCOMPARE(region.GetPixel(row, col), img.GetPixel(reg[1] + row, reg[0] + col));
+    }
+}
+
+void RawImageFileTests::WriteRegion()
+{
+    acv::Image expected = FormRandomImage(HEIGHT, WIDTH);
+    QCOMPARE(acv::RawImageFile::Save(FILE_NAME, expected, TILE_SIZE), true);
+
+    {
+        acv::RawImageFile file;
+        QCOMPARE(file.Open(FILE_NAME, acv::RawImageFile::OpenMode::READ_WRITE), true);
+
+        const int X = 50, Y = 40;
+        const acv::Image region = FormRandomImage(150, 200);
+        QCOMPARE(file.WriteRegion(X, Y, region), true);
+        for (int row = 0; row < region.GetHeight(); ++row)
+            for (int col = 0; col < region.GetWidth(); ++col)
+                expected.SetPixel(Y + row, X + col, region.GetPixel(row, col));
+
+        // Change of pixel through the tile
+        acv::Image::Byte* pTile = file.GetTilePointer(2, 3);
+        QCOMPARE(pTile != nullptr, true);
+        pTile[TILE_SIZE + 1] = static_cast<acv::Image::Byte>(expected.GetPixel(2 * TILE_SIZE + 1, 3 * TILE_SIZE + 1) ^ 0xFF);
+        expected.SetPixel(2 * TILE_SIZE + 1, 3 * TILE_SIZE + 1, pTile[TILE_SIZE + 1]);
+    }
+
+    acv::Image loaded;
+    QCOMPARE(acv::RawImageFile::Load(FILE_NAME, loaded), true);
+    QCOMPARE(loaded == expected, true);
+}
+
+void RawImageFileTests::IncorrectArguments()
+{
+    const acv::Image img = FormRandomImage(50, 60);
+    QCOMPARE(acv::RawImageFile::Save(FILE_NAME, img, TILE_SIZE), true);
+    QCOMPARE(acv::RawImageFile::Create(FILE_NAME, 10, 10, 0), false);
+
+    // Size of file is larger than the address space
+    const int MAX_SIZE = std::numeric_limits<int>::max();
+    QCOMPARE(acv::RawImageFile::Create(FILE_NAME, MAX_SIZE, MAX_SIZE, 1), false);
+
+    acv::RawImageFile file;
+    QCOMPARE(file.IsOpened(), false);
+    QCOMPARE(file.Open("RawImageFileTests.absent"), false);
+
+    QCOMPARE(file.Open(FILE_NAME), true);
+    QCOMPARE(file.IsOpened(), true);
+
+    // File is opened for reading only
+    acv::Image region(10, 10);
+    QCOMPARE(file.GetTilePointer(0, 0) == nullptr, true);
+    QCOMPARE(file.WriteRegion(0, 0, region), false);
+
+    // Regions out of image
+    QCOMPARE(file.ReadRegion(-1, 0, region), false);
+    QCOMPARE(file.ReadRegion(55, 0, region), false);
+    QCOMPARE(file.ReadRegion(0, 45, region), false);
+    QCOMPARE(static_cast<const acv::RawImageFile&>(file).GetTilePointer(1, 0) == nullptr, true);
+
+    file.Close();
+    QCOMPARE(file.IsOpened(), false);
+    QCOMPARE(file.ReadRegion(0, 0, region), false);
+
+    // Size of tile in header is so large that the size of file overflows (the size of tile follows 32 bytes of header)
+    {
+        const std::uint64_t tileStride = std::numeric_limits<std::uint64_t>::max() / 2;
+        std::fstream header(FILE_NAME, std::ios::binary | std::ios::in | std::ios::out);
+        header.seekp(32);
+        header.write(reinterpret_cast<const char*>(&tileStride), sizeof(tileStride));
+    }
+    QCOMPARE(file.Open(FILE_NAME), false);
+}
+
+QTEST_APPLESS_MAIN(RawImageFileTests)
+
+#include "RawImageFileTests.moc"
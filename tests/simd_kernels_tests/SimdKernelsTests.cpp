@@ -0,0 +1,275 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "SimdKernelsTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <algorithm>
+
+#include "SimdKernels.h"
+#include "CpuFeatures.h"
+
+// This class is used for testing of vectorized kernels: each table of kernels must produce the same results as scalar one
+class SimdKernelsTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    SimdKernelsTests();
+
+private Q_SLOTS:
+
+    // Test of convolution of rows
+    void ConvolveRow();
+
+    // Test of horizontal and vertical Sobel operators
+    void SobelRows();
+
+    // Test of replacement of pixels by look-up table
+    void ApplyLookUpTable();
+
+    // Test of accumulation of rows
+    void AccumulateRow();
+
+    // Test of threshold by level
+    void ThresholdRow();
+
+    // Test of bilinear interpolation of rows
+    void BlendBilinearRow();
+
+    // Test of unsharp masking of rows
+    void UnsharpMaskRow();
+
+private:
+
+    // Get the instruction sets which are supported by processor
+    static std::vector<acv::CpuFeatures::InstructionSet> GetSupportedSets();
+
+    // Fill the buffer by random pixels
+    void FillRandom(std::vector<acv::Image::Byte>& buffer);
+
+    std::default_random_engine mEngine;
+
+};
+
+typedef acv::SimdKernels::Byte Byte;
+
+// Numbers of pixels which check the vectorized loops and the scalar tails
+static const int COUNTS[] = { 0, 1, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 257 };
+
+SimdKernelsTests::SimdKernelsTests()
+{
+}
+
+std::vector<acv::CpuFeatures::InstructionSet> SimdKernelsTests::GetSupportedSets()
+{
+    const int best = static_cast<int>(acv::CpuFeatures::GetBestInstructionSet());
+
+    std::vector<acv::CpuFeatures::InstructionSet> sets;
+    for (int set = static_cast<int>(acv::CpuFeatures::InstructionSet::SSE2); set <= best; ++set)
+        sets.push_back(static_cast<acv::CpuFeatures::InstructionSet>(set));
+
+    return sets;
+}
+
+void SimdKernelsTests::FillRandom(std::vector<Byte>& buffer)
+{
+    std::uniform_int_distribution<int> di(acv::Image::MIN_PIXEL_VALUE, acv::Image::MAX_PIXEL_VALUE);
+    for (Byte& pixel : buffer)
+        pixel = static_cast<Byte>(di(mEngine));
+}
+
+void SimdKernelsTests::ConvolveRow()
+{
+    const acv::SimdKernels& scalar = acv::SimdKernels::Get(acv::CpuFeatures::InstructionSet::SCALAR);
+    std::uniform_int_distribution<int> dc(-8, 8);
+
+    for (const acv::CpuFeatures::InstructionSet set : GetSupportedSets())
+        for (const int filterSize : { 3, 5 })
+            for (const int divider : { 0, 1, 9, 16 })
+                for (const int count : COUNTS)
+                {
+                    const int stride = count + filterSize;
+                    std::vector<Byte> src(stride * filterSize);
+                    FillRandom(src);
+
+                    std::vector<int> filter(filterSize * filterSize);
+                    for (int& coef : filter)
+                        coef = dc(mEngine);
+
+                    std::vector<Byte> expected(count + 1), actual(count + 1);
+                    scalar.ConvolveRow(src.data(), stride, filter.data(), filterSize, divider, expected.data(), count);
+                    acv::SimdKernels::Get(set).ConvolveRow(src.data(), stride, filter.data(), filterSize, divider, actual.data(), count);
+
+                    QCOMPARE(actual == expected, true);
+                }
+}
+
+void SimdKernelsTests::SobelRows()
+{
+    const acv::SimdKernels& scalar = acv::SimdKernels::Get(acv::CpuFeatures::InstructionSet::SCALAR);
+
+    for (const acv::CpuFeatures::InstructionSet set : GetSupportedSets())
+        for (const int count : COUNTS)
+        {
+            // The operators read one pixel before and after the row
+            std::vector<Byte> top(count + 2), middle(count + 2), bottom(count + 2);
+            FillRandom(top);
+            FillRandom(middle);
+            FillRandom(bottom);
+
+            std::vector<Byte> expected(count + 1), actual(count + 1);
+            scalar.SobelHRow(&top[1], &bottom[1], expected.data(), count);
+            acv::SimdKernels::Get(set).SobelHRow(&top[1], &bottom[1], actual.data(), count);
+            QCOMPARE(actual == expected, true);
+
+            scalar.SobelVRow(&top[1], &middle[1], &bottom[1], expected.data(), count);
+            acv::SimdKernels::Get(set).SobelVRow(&top[1], &middle[1], &bottom[1], actual.data(), count);
+            QCOMPARE(actual == expected, true);
+        }
+}
+
+void SimdKernelsTests::ApplyLookUpTable()
+{
+    const acv::SimdKernels& scalar = acv::SimdKernels::Get(acv::CpuFeatures::InstructionSet::SCALAR);
+
+    std::vector<Byte> table(acv::Image::MAX_PIXEL_VALUE + 1);
+    FillRandom(table);
+
+    for (const acv::CpuFeatures::InstructionSet set : GetSupportedSets())
+        for (const int count : COUNTS)
+        {
+            std::vector<Byte> src(count + 1);
+            FillRandom(src);
+
+            std::vector<Byte> expected(count + 1), actual(count + 1);
+            scalar.ApplyLookUpTable(src.data(), expected.data(), count, table.data());
+            acv::SimdKernels::Get(set).ApplyLookUpTable(src.data(), actual.data(), count, table.data());
+            QCOMPARE(actual == expected, true);
+
+            // The destination can be the same as source
+            acv::SimdKernels::Get(set).ApplyLookUpTable(src.data(), src.data(), count, table.data());
+            QCOMPARE(std::equal(expected.begin(), expected.begin() + count, src.begin()), true);
+        }
+}
+
+void SimdKernelsTests::AccumulateRow()
+{
+    const acv::SimdKernels& scalar = acv::SimdKernels::Get(acv::CpuFeatures::InstructionSet::SCALAR);
+    std::uniform_int_distribution<uint32_t> ds(0, 1000000);
+
+    for (const acv::CpuFeatures::InstructionSet set : GetSupportedSets())
+        for (const int count : COUNTS)
+        {
+            std::vector<Byte> src(count + 1);
+            FillRandom(src);
+
+            std::vector<uint32_t> expected(count + 1);
+            for (uint32_t& sum : expected)
+                sum = ds(mEngine);
+            std::vector<uint32_t> actual(expected);
+
+            scalar.AccumulateRow(src.data(), expected.data(), count);
+            acv::SimdKernels::Get(set).AccumulateRow(src.data(), actual.data(), count);
+            QCOMPARE(actual == expected, true);
+        }
+}
+
+void SimdKernelsTests::ThresholdRow()
+{
+    const acv::SimdKernels& scalar = acv::SimdKernels::Get(acv::CpuFeatures::InstructionSet::SCALAR);
+
+    for (const acv::CpuFeatures::InstructionSet set : GetSupportedSets())
+        for (const int threshold : { -300, -20, 0, 5, 128, 300 })
+            for (const int count : COUNTS)
+            {
+                std::vector<Byte> src(count + 1), level(count + 1);
+                FillRandom(src);
+                FillRandom(level);
+
+                std::vector<Byte> expected(count + 1), actual(count + 1);
+                scalar.ThresholdRow(src.data(), level.data(), expected.data(), count, threshold, 255, 0);
+                acv::SimdKernels::Get(set).ThresholdRow(src.data(), level.data(), actual.data(), count, threshold, 255, 0);
+                QCOMPARE(actual == expected, true);
+
+                // The destination can be the same as level
+                acv::SimdKernels::Get(set).ThresholdRow(src.data(), level.data(), level.data(), count, threshold, 255, 0);
+                QCOMPARE(std::equal(expected.begin(), expected.begin() + count, level.begin()), true);
+            }
+}
+
+void SimdKernelsTests::BlendBilinearRow()
+{
+    const acv::SimdKernels& scalar = acv::SimdKernels::Get(acv::CpuFeatures::InstructionSet::SCALAR);
+    std::uniform_int_distribution<int> dw(0, acv::SimdKernels::BLEND_WEIGHT_ONE);
+
+    for (const acv::CpuFeatures::InstructionSet set : GetSupportedSets())
+        for (const int count : COUNTS)
+        {
+            std::vector<Byte> topLeft(count + 1), topRight(count + 1), bottomLeft(count + 1), bottomRight(count + 1), weightsX(count + 1);
+            FillRandom(topLeft);
+            FillRandom(topRight);
+            FillRandom(bottomLeft);
+            FillRandom(bottomRight);
+            for (Byte& weight : weightsX)
+                weight = static_cast<Byte>(dw(mEngine));
+            const int weightY = dw(mEngine);
+
+            std::vector<Byte> expected(count + 1), actual(count + 1);
+            scalar.BlendBilinearRow(topLeft.data(), topRight.data(), bottomLeft.data(), bottomRight.data(),
+                                    weightsX.data(), weightY, expected.data(), count);
+            acv::SimdKernels::Get(set).BlendBilinearRow(topLeft.data(), topRight.data(), bottomLeft.data(), bottomRight.data(),
+                                                        weightsX.data(), weightY, actual.data(), count);
+            QCOMPARE(actual == expected, true);
+        }
+}
+
+void SimdKernelsTests::UnsharpMaskRow()
+{
+    const acv::SimdKernels& scalar = acv::SimdKernels::Get(acv::CpuFeatures::InstructionSet::SCALAR);
+
+    for (const acv::CpuFeatures::InstructionSet set : GetSupportedSets())
+        for (const int amount : { 0, 1, 128, 256, 700, static_cast<int>(acv::SimdKernels::UNSHARP_AMOUNT_MAX) })
+            for (const int threshold : { 0, 1, 10, 255 })
+                for (const int count : COUNTS)
+                {
+                    std::vector<Byte> src(count + 1), blurred(count + 1);
+                    FillRandom(src);
+                    FillRandom(blurred);
+
+                    std::vector<Byte> expected(count + 1), actual(count + 1);
+                    scalar.UnsharpMaskRow(src.data(), blurred.data(), expected.data(), count, amount, threshold);
+                    acv::SimdKernels::Get(set).UnsharpMaskRow(src.data(), blurred.data(), actual.data(), count, amount, threshold);
+                    QCOMPARE(actual == expected, true);
+                }
+}
+
+QTEST_APPLESS_MAIN(SimdKernelsTests)
+
+#include "SimdKernelsTests.moc"
@@ -0,0 +1,345 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "TaskSchedulerTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <memory>
+#include <stdexcept>
+
+#include "TaskScheduler.h"
+#include "TaskGraph.h"
+#include "Parallel.h"
+
+// This class is used for testing of scheduler of tasks: the results of parallel execution are compared
+// with the results of sequential execution
+class TaskSchedulerTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    TaskSchedulerTests();
+
+private Q_SLOTS:
+
+    // Test of parallel loop
+    void ParallelFor();
+
+    // Test of nested parallel loops
+    void NestedParallelFor();
+
+    // Test of group of tasks
+    void Group();
+
+    // Test of exceptions of tasks of group and of body of parallel loop
+    void Exceptions();
+
+    // Test of graph of tasks
+    void Graph();
+
+    // Test of exceptions of tasks of graph
+    void GraphExceptions();
+
+    // Test of calls from many client threads at once
+    void ClientThreads();
+
+};
+
+// Ranges and grain sizes of parallel loops
+static const int RANGES[][3] = { { 0, 0, 1 }, { 0, 1, 1 }, { 5, 6, 16 }, { 0, 1000, 1 }, { -300, 700, 16 }, { 7, 100000, 64 } };
+
+// Run the loop and check that each iteration is executed once
+static bool CheckParallelFor(const int begin, const int end, const int grainSize)
+{
+    std::unique_ptr<std::atomic<int>[]> counters(new std::atomic<int>[end > begin ? end - begin : 1]);
+    for (int i = begin; i < end; ++i)
+        counters[i - begin].store(0);
+
+    std::atomic<bool> isCorrectRange(true);
+    acv::Parallel::For(begin, end, [&](const int rangeBegin, const int rangeEnd)
+    {
+        if (rangeBegin < begin || rangeEnd > end || rangeBegin >= rangeEnd)
+            isCorrectRange.store(false);
+
+        for (int i = rangeBegin; i < rangeEnd; ++i)
+            counters[i - begin].fetch_add(1);
+    }, grainSize);
+
+    for (int i = begin; i < end; ++i)
+        if (counters[i - begin].load() != 1)
+            return false;
+
+    return isCorrectRange.load();
+}
+
+TaskSchedulerTests::TaskSchedulerTests()
+{
+}
+
+void TaskSchedulerTests::ParallelFor()
+{
+    QVERIFY(acv::Parallel::GetNumThreads() >= 1);
+    QCOMPARE(acv::Parallel::GetNumThreads(), acv::TaskScheduler::GetNumThreads());
+
+    for (const auto& range : RANGES)
+        QCOMPARE(CheckParallelFor(range[0], range[1], range[2]), true);
+
+    // The empty and reversed ranges don't call the body
+    std::atomic<int> numCalls(0);
+    acv::Parallel::For(10, 10, [&](const int, const int) { numCalls.fetch_add(1); });
+    acv::Parallel::For(10, 5, [&](const int, const int) { numCalls.fetch_add(1); });
+    QCOMPARE(numCalls.load(), 0);
+}
+
+void TaskSchedulerTests::NestedParallelFor()
+{
+    const int NUM_ROWS = 200, NUM_COLS = 300;
+
+    std::vector<std::atomic<int>> counters(NUM_ROWS * NUM_COLS);
+    for (auto& counter : counters)
+        counter.store(0);
+
+    acv::Parallel::For(0, NUM_ROWS, [&](const int rowBegin, const int rowEnd)
+    {
+        for (int row = rowBegin; row < rowEnd; ++row)
+        {
+            acv::Parallel::For(0, NUM_COLS, [&](const int colBegin, const int colEnd)
+            {
+                for (int col = colBegin; col < colEnd; ++col)
+                    counters[row * NUM_COLS + col].fetch_add(row + col);
+            });
+        }
+    });
+
+    for (int row = 0; row < NUM_ROWS; ++row)
+        for (int col = 0; col < NUM_COLS; ++col)
+            QCOMPARE(counters[row * NUM_COLS + col].load(), row + col);
+}
+
+void TaskSchedulerTests::Group()
+{
+    const int NUM_TASKS = 100, NUM_SUBTASKS = 10;
+
+    std::atomic<long long> sum(0);
+    acv::TaskGroup group;
+    for (int i = 0; i < NUM_TASKS; ++i)
+    {
+        group.Run([&sum, &group, i]()
+        {
+            sum.fetch_add(i);
+
+            // The tasks of group can spawn the tasks of the same group
+            for (int j = 0; j < NUM_SUBTASKS; ++j)
+                group.Run([&sum, j]() { sum.fetch_add(j); });
+        });
+    }
+    group.Wait();
+
+    QCOMPARE(sum.load(), static_cast<long long>(NUM_TASKS * (NUM_TASKS - 1) / 2 + NUM_TASKS * NUM_SUBTASKS * (NUM_SUBTASKS - 1) / 2));
+
+    // The group can be used again after the wait
+    group.Run([&sum]() { sum.store(-1); });
+    group.Wait();
+    QCOMPARE(sum.load(), -1LL);
+}
+
+void TaskSchedulerTests::Exceptions()
+{
+    const int NUM_TASKS = 64;
+
+    // The exception is thrown by the wait after the finish of all tasks
+    std::atomic<int> numFinished(0);
+    acv::TaskGroup group;
+    for (int i = 0; i < NUM_TASKS; ++i)
+    {
+        group.Run([&numFinished, i]()
+        {
+            if (i % 8 == 3)
+                throw std::runtime_error("task error");
+            numFinished.fetch_add(1);
+        });
+    }
+    QVERIFY_EXCEPTION_THROWN(group.Wait(), std::runtime_error);
+    QCOMPARE(numFinished.load(), NUM_TASKS - NUM_TASKS / 8);
+
+    // The exception is thrown once, the group can be used again
+    group.Run([&numFinished]() { numFinished.store(0); });
+    group.Wait();
+    QCOMPARE(numFinished.load(), 0);
+
+    // The exception of body of parallel loop is thrown by the loop, the next loops are executed
+    QVERIFY_EXCEPTION_THROWN(acv::Parallel::For(0, 1000, [](const int begin, const int end)
+    {
+        if (begin <= 500 && 500 < end)
+            throw std::out_of_range("body error");
+    }), std::out_of_range);
+
+    for (const auto& range : RANGES)
+        QCOMPARE(CheckParallelFor(range[0], range[1], range[2]), true);
+
+    // The destructor of group waits for the tasks, but doesn't throw
+    {
+        acv::TaskGroup unwaitedGroup;
+        unwaitedGroup.Run([]() { throw std::runtime_error("ignored error"); });
+        unwaitedGroup.Run([&numFinished]() { numFinished.fetch_add(1); });
+    }
+    QCOMPARE(numFinished.load(), 1);
+}
+
+void TaskSchedulerTests::Graph()
+{
+    // Diamonds of tasks in chain: each task checks that its predecessors are finished
+    const int NUM_DIAMONDS = 20;
+
+    std::vector<std::atomic<bool>> isFinished(3 * NUM_DIAMONDS + 1);
+    std::atomic<bool> isOrdered(true);
+
+    acv::TaskGraph graph;
+    std::vector<std::vector<int>> predecessors(isFinished.size());
+
+    const int first = graph.AddTask([&]() { isFinished[0].store(true); });
+    QCOMPARE(first, 0);
+
+    int top = first;
+    for (int i = 0; i < NUM_DIAMONDS; ++i)
+    {
+        int tasks[3];
+        for (int j = 0; j < 3; ++j)
+        {
+            const int taskNum = 3 * i + j + 1;
+            tasks[j] = graph.AddTask([&, taskNum]()
+            {
+                for (const int predecessor : predecessors[taskNum])
+                    if (!isFinished[predecessor].load())
+                        isOrdered.store(false);
+                isFinished[taskNum].store(true);
+            });
+            QCOMPARE(tasks[j], taskNum);
+        }
+
+        // top -> left, top -> right, left -> bottom, right -> bottom
+        const int edges[4][2] = { { top, tasks[0] }, { top, tasks[1] }, { tasks[0], tasks[2] }, { tasks[1], tasks[2] } };
+        for (const auto& edge : edges)
+        {
+            QCOMPARE(graph.AddDependency(edge[0], edge[1]), true);
+            predecessors[edge[1]].push_back(edge[0]);
+        }
+
+        top = tasks[2];
+    }
+    QCOMPARE(graph.GetNumTasks(), static_cast<int>(isFinished.size()));
+
+    // The graph can be executed many times
+    for (int run = 0; run < 3; ++run)
+    {
+        for (auto& flag : isFinished)
+            flag.store(false);
+
+        QCOMPARE(graph.Run(), true);
+        QCOMPARE(isOrdered.load(), true);
+        for (const auto& flag : isFinished)
+            QCOMPARE(flag.load(), true);
+    }
+
+    // Incorrect identifiers of tasks
+    QCOMPARE(graph.AddDependency(-1, 0), false);
+    QCOMPARE(graph.AddDependency(0, graph.GetNumTasks()), false);
+
+    // The graph with cycle is not executed
+    std::atomic<int> numRuns(0);
+    acv::TaskGraph cyclicGraph;
+    const int task1 = cyclicGraph.AddTask([&]() { numRuns.fetch_add(1); });
+    const int task2 = cyclicGraph.AddTask([&]() { numRuns.fetch_add(1); });
+    const int task3 = cyclicGraph.AddTask([&]() { numRuns.fetch_add(1); });
+    QCOMPARE(cyclicGraph.AddDependency(task1, task2), true);
+    QCOMPARE(cyclicGraph.AddDependency(task2, task3), true);
+    QCOMPARE(cyclicGraph.AddDependency(task3, task2), true);
+    QCOMPARE(cyclicGraph.Run(), false);
+    QCOMPARE(numRuns.load(), 0);
+
+    cyclicGraph.Clear();
+    QCOMPARE(cyclicGraph.GetNumTasks(), 0);
+    QCOMPARE(cyclicGraph.Run(), true);
+}
+
+void TaskSchedulerTests::GraphExceptions()
+{
+    // Chain of tasks and independent task: the successors of failed task are not started
+    std::atomic<int> numRuns(0);
+    std::atomic<bool> isIndependentRun(false);
+
+    acv::TaskGraph graph;
+    const int first = graph.AddTask([&]() { numRuns.fetch_add(1); });
+    const int failed = graph.AddTask([&]() { numRuns.fetch_add(1); throw std::runtime_error("stage error"); });
+    const int last = graph.AddTask([&]() { numRuns.fetch_add(1); });
+    graph.AddTask([&]() { isIndependentRun.store(true); });
+    QCOMPARE(graph.AddDependency(first, failed), true);
+    QCOMPARE(graph.AddDependency(failed, last), true);
+
+    QVERIFY_EXCEPTION_THROWN(graph.Run(), std::runtime_error);
+    QCOMPARE(numRuns.load(), 2);
+    QCOMPARE(isIndependentRun.load(), true);
+}
+
+void TaskSchedulerTests::ClientThreads()
+{
+    const int NUM_CLIENTS = 8, NUM_ITERATIONS = 20000;
+
+    std::vector<long long> sums(NUM_CLIENTS, 0);
+    std::vector<std::thread> clients;
+    for (int client = 0; client < NUM_CLIENTS; ++client)
+    {
+        clients.emplace_back([&sums, client]()
+        {
+            for (int repeat = 0; repeat < 5; ++repeat)
+            {
+                std::atomic<long long> sum(0);
+                acv::Parallel::For(0, NUM_ITERATIONS, [&](const int begin, const int end)
+                {
+                    long long localSum = 0;
+                    for (int i = begin; i < end; ++i)
+                        localSum += i + client;
+                    sum.fetch_add(localSum);
+                }, 64);
+                sums[client] += sum.load();
+            }
+        });
+    }
+
+    for (auto& client : clients)
+        client.join();
+
+    for (int client = 0; client < NUM_CLIENTS; ++client)
+        QCOMPARE(sums[client], 5LL * (static_cast<long long>(NUM_ITERATIONS) * (NUM_ITERATIONS - 1) / 2 +
+                                     static_cast<long long>(NUM_ITERATIONS) * client));
+}
+
+QTEST_APPLESS_MAIN(TaskSchedulerTests)
+
+#include "TaskSchedulerTests.moc"
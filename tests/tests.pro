@@ -25,4 +25,27 @@
 TEMPLATE = subdirs
 
 SUBDIRS += \
-        image_tests
+        image_tests \
+        simd_kernels_tests \
+        moments_tests \
+        morphology_tests \
+        pipeline_tests \
+        aimage_tests \
+        pixel_converter_tests \
+        multi_channel_image_tests \
+        typed_image_tests \
+        raw_image_file_tests \
+        tiled_processor_tests \
+        bounded_queue_tests \
+        processor_tests \
+        background_model_tests \
+        progress_tests \
+        profiler_tests \
+        histogram_tests \
+        equalization_tests \
+        bilateral_tests \
+        unsharp_mask_tests \
+        local_threshold_tests \
+        binary_image_tests \
+        image_batch_tests \
+        task_scheduler_tests
@@ -0,0 +1,348 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "TiledProcessorTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+#include "Image.h"
+#include "RawImageFile.h"
+#include "TiledProcessor.h"
+
+// This class is used for testing of tiled processing of raw image files: the results are compared with the processing of the whole image
+class TiledProcessorTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    TiledProcessorTests();
+
+    ~TiledProcessorTests();
+
+private Q_SLOTS:
+
+    // Test of filters with window
+    void Filter();
+
+    // Test of filters with IIR-filter (approximate results)
+    void FilterIIR();
+
+    // Test of adaptive threshold
+    void AdaptiveThreshold();
+
+    // Test of borders detectors
+    void DetectBorders();
+
+    // Test of morphological operations
+    void Morphology();
+
+    // Test of correctors
+    void Correct();
+
+    // Test of incorrect arguments
+    void IncorrectArguments();
+
+private:
+
+    // Operation with the whole image
+    typedef std::function<bool(const acv::Image& srcImg, acv::Image& dstImg)> ImageOperation;
+
+    // Operation with files
+    typedef std::function<bool(const acv::RawImageFile& srcFile, acv::RawImageFile& dstFile)> FileOperation;
+
+    // Run the operation with files and with the whole image, count the different pixels and the maximal difference
+    bool Compare(const ImageOperation& imageOperation, const FileOperation& fileOperation, int& numDiffs, int& maxDiff);
+
+    // Compare the results and check their equality
+    bool IsEqual(const ImageOperation& imageOperation, const FileOperation& fileOperation);
+
+    acv::Image mImage;
+
+};
+
+// Names of temporary files
+static const char* SRC_FILE_NAME = "TiledProcessorTests.src.acvraw";
+static const char* DST_FILE_NAME = "TiledProcessorTests.dst.acvraw";
+
+// Sizes of image (it is larger than memory limit), sizes of tile of file and memory limit in megabytes
+static const int HEIGHT = 1100, WIDTH = 1300, FILE_TILE_SIZE = 64, MEMORY_LIMIT_MB = 1;
+
+TiledProcessorTests::TiledProcessorTests()
+    : mImage(HEIGHT, WIDTH)
+{
+    // Image of blocks with noise
+    std::default_random_engine engine;
+    std::uniform_int_distribution<int> di(-40, 40);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+        {
+            int pixel = 60 + ((row / 37 + col / 23) % 3) * 50 + di(engine);
+            acv::Image::CheckPixelValue(pixel);
+            mImage.SetPixel(row, col, static_cast<acv::Image::Byte>(pixel));
+        }
+
+    acv::RawImageFile::Save(SRC_FILE_NAME, mImage, FILE_TILE_SIZE);
+}
+
+TiledProcessorTests::~TiledProcessorTests()
+{
+    std::remove(SRC_FILE_NAME);
+    std::remove(DST_FILE_NAME);
+}
+
+bool TiledProcessorTests::Compare(const ImageOperation& imageOperation, const FileOperation& fileOperation, int& numDiffs, int& maxDiff)
+{
+    acv::Image expected(HEIGHT, WIDTH);
+    if (!imageOperation(mImage, expected))
+        return false;
+
+    acv::RawImageFile srcFile, dstFile;
+    if (!srcFile.Open(SRC_FILE_NAME) || !acv::RawImageFile::Create(DST_FILE_NAME, HEIGHT, WIDTH, FILE_TILE_SIZE) ||
+        !dstFile.Open(DST_FILE_NAME, acv::RawImageFile::OpenMode::READ_WRITE) || !fileOperation(srcFile, dstFile))
+        return false;
+
+    acv::Image result(HEIGHT, WIDTH);
+    if (!dstFile.ReadRegion(0, 0, result))
+        return false;
+
+    numDiffs = maxDiff = 0;
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+        {
+            const int diff = std::abs(result.GetPixel(row, col) - expected.GetPixel(row, col));
+            if (diff != 0)
+            {
+                ++numDiffs;
+                maxDiff = std::max(maxDiff, diff);
+            }
+        }
+
+    return true;
+}
+
+bool TiledProcessorTests::IsEqual(const ImageOperation& imageOperation, const FileOperation& fileOperation)
+{
+    int numDiffs, maxDiff;
+    return Compare(imageOperation, fileOperation, numDiffs, maxDiff) && numDiffs == 0;
+}
+
+typedef acv::ImageFilter::FilterType FilterType;
+
+void TiledProcessorTests::Filter()
+{
+    const acv::TiledProcessor processor(MEMORY_LIMIT_MB);
+
+    const std::pair<FilterType, int> FILTERS[] = { { FilterType::MEDIAN, 5 }, { FilterType::GAUSSIAN, 5 },
+                                                   { FilterType::SEP_GAUSSIAN, 9 }, { FilterType::SHARPEN, -1 },
+                                                   { FilterType::UNSHARP_MASK, 5 } };
+    for (const auto& filter : FILTERS)
+    {
+        const bool isEqual = IsEqual([&](const acv::Image& srcImg, acv::Image& dstImg)
+        {
+            return acv::ImageFilter::Filter(srcImg, dstImg, filter.first, filter.second) == acv::FiltrationResult::SUCCESS;
+        }, [&](const acv::RawImageFile& srcFile, acv::RawImageFile& dstFile)
+        {
+            return processor.Filter(srcFile, dstFile, filter.first, filter.second) == acv::FiltrationResult::SUCCESS;
+        });
+        QCOMPARE(isEqual, true);
+    }
+}
+
+void TiledProcessorTests::FilterIIR()
+{
+    const acv::TiledProcessor processor(MEMORY_LIMIT_MB);
+
+    // The difference is at most one level at small part of pixels
+    const int MAX_NUM_DIFFS = HEIGHT * WIDTH / 100;
+
+    const std::pair<FilterType, int> FILTERS[] = { { FilterType::IIR_GAUSSIAN, 7 }, { FilterType::IIR_GAUSSIAN, 31 },
+                                                   { FilterType::BILATERAL, 13 }, { FilterType::UNSHARP_MASK, 31 } };
+    for (const auto& filter : FILTERS)
+    {
+        int numDiffs, maxDiff;
+        const bool isCompared = Compare([&](const acv::Image& srcImg, acv::Image& dstImg)
+        {
+            return acv::ImageFilter::Filter(srcImg, dstImg, filter.first, filter.second) == acv::FiltrationResult::SUCCESS;
+        }, [&](const acv::RawImageFile& srcFile, acv::RawImageFile& dstFile)
+        {
+            return processor.Filter(srcFile, dstFile, filter.first, filter.second) == acv::FiltrationResult::SUCCESS;
+        }, numDiffs, maxDiff);
+
+        QCOMPARE(isCompared, true);
+        QCOMPARE(maxDiff <= 1, true);
+        QCOMPARE(numDiffs <= MAX_NUM_DIFFS, true);
+    }
+}
+
+void TiledProcessorTests::AdaptiveThreshold()
+{
+    const acv::TiledProcessor processor(MEMORY_LIMIT_MB);
+
+    // Threshold by mean with separated Gaussian
+    bool isEqual = IsEqual([](const acv::Image& srcImg, acv::Image& dstImg)
+    {
+        return acv::ImageFilter::AdaptiveThreshold(srcImg, dstImg, 5, 3, acv::ImageFilter::ThresholdType::MAX_MORE_THRESHOLD);
+    }, [&](const acv::RawImageFile& srcFile, acv::RawImageFile& dstFile)
+    {
+        return processor.AdaptiveThreshold(srcFile, dstFile, 5, 3, acv::ImageFilter::ThresholdType::MAX_MORE_THRESHOLD);
+    });
+    QCOMPARE(isEqual, true);
+
+    // Threshold by local statistics
+    const acv::ImageFilter::ThresholdMethod METHODS[] = { acv::ImageFilter::ThresholdMethod::NIBLACK,
+                                                          acv::ImageFilter::ThresholdMethod::SAUVOLA };
+    for (const auto method : METHODS)
+    {
+        const float k = (method == acv::ImageFilter::ThresholdMethod::NIBLACK) ? -0.2f : 0.3f;
+        isEqual = IsEqual([&](const acv::Image& srcImg, acv::Image& dstImg)
+        {
+            return acv::ImageFilter::AdaptiveThreshold(srcImg, dstImg, 25, k, method, acv::ImageFilter::ThresholdType::MIN_MORE_THRESHOLD);
+        }, [&](const acv::RawImageFile& srcFile, acv::RawImageFile& dstFile)
+        {
+            return processor.AdaptiveThreshold(srcFile, dstFile, 25, k, method, acv::ImageFilter::ThresholdType::MIN_MORE_THRESHOLD);
+        });
+        QCOMPARE(isEqual, true);
+    }
+
+    // Threshold by mean with IIR-filter (the pixels of level which is near to the pixel can differ)
+    int numDiffs, maxDiff;
+    const bool isCompared = Compare([](const acv::Image& srcImg, acv::Image& dstImg)
+    {
+        return acv::ImageFilter::AdaptiveThreshold(srcImg, dstImg, 19, 3, acv::ImageFilter::ThresholdType::MAX_MORE_THRESHOLD);
+    }, [&](const acv::RawImageFile& srcFile, acv::RawImageFile& dstFile)
+    {
+        return processor.AdaptiveThreshold(srcFile, dstFile, 19, 3, acv::ImageFilter::ThresholdType::MAX_MORE_THRESHOLD);
+    }, numDiffs, maxDiff);
+    QCOMPARE(isCompared, true);
+    QCOMPARE(numDiffs <= HEIGHT * WIDTH / 100, true);
+}
+
+void TiledProcessorTests::DetectBorders()
+{
+    const acv::TiledProcessor processor(MEMORY_LIMIT_MB);
+
+    const acv::BordersDetector::DetectorType DETECTORS[] = { acv::BordersDetector::DetectorType::SOBEL,
+                                                             acv::BordersDetector::DetectorType::SCHARR };
+    for (const auto detector : DETECTORS)
+    {
+        const bool isEqual = IsEqual([&](const acv::Image& srcImg, acv::Image& dstImg)
+        {
+            return acv::BordersDetector::DetectBorders(srcImg, dstImg, detector);
+        }, [&](const acv::RawImageFile& srcFile, acv::RawImageFile& dstFile)
+        {
+            return processor.DetectBorders(srcFile, dstFile, detector);
+        });
+        QCOMPARE(isEqual, true);
+    }
+
+    // Borders of Canny detector are traced in the limits of halo
+    int numDiffs, maxDiff;
+    const bool isCompared = Compare([](const acv::Image& srcImg, acv::Image& dstImg)
+    {
+        return acv::BordersDetector::DetectBorders(srcImg, dstImg, acv::BordersDetector::DetectorType::CANNY);
+    }, [&](const acv::RawImageFile& srcFile, acv::RawImageFile& dstFile)
+    {
+        return processor.DetectBorders(srcFile, dstFile, acv::BordersDetector::DetectorType::CANNY);
+    }, numDiffs, maxDiff);
+    QCOMPARE(isCompared, true);
+    QCOMPARE(numDiffs <= HEIGHT * WIDTH / 100, true);
+}
+
+void TiledProcessorTests::Morphology()
+{
+    const acv::TiledProcessor processor(MEMORY_LIMIT_MB);
+
+    const acv::MorphologyFilter::MorphologyType TYPES[] = { acv::MorphologyFilter::MorphologyType::EROSION,
+                                                            acv::MorphologyFilter::MorphologyType::DILATION,
+                                                            acv::MorphologyFilter::MorphologyType::OPENING,
+                                                            acv::MorphologyFilter::MorphologyType::CLOSING };
+    for (const auto type : TYPES)
+    {
+        const bool isEqual = IsEqual([&](const acv::Image& srcImg, acv::Image& dstImg)
+        {
+            return acv::MorphologyFilter::Filter(srcImg, dstImg, type, 7, 5) == acv::FiltrationResult::SUCCESS;
+        }, [&](const acv::RawImageFile& srcFile, acv::RawImageFile& dstFile)
+        {
+            return processor.Morphology(srcFile, dstFile, type, 7, 5) == acv::FiltrationResult::SUCCESS;
+        });
+        QCOMPARE(isEqual, true);
+    }
+}
+
+void TiledProcessorTests::Correct()
+{
+    const acv::TiledProcessor processor(MEMORY_LIMIT_MB);
+
+    const acv::ImageCorrector::CorrectorType TYPES[] = { acv::ImageCorrector::CorrectorType::GAMMA,
+                                                         acv::ImageCorrector::CorrectorType::AUTO_LEVELS,
+                                                         acv::ImageCorrector::CorrectorType::NORM_AUTO_LEVELS,
+                                                         acv::ImageCorrector::CorrectorType::GLOBAL_EQUALIZATION };
+    for (const auto type : TYPES)
+    {
+        const bool isEqual = IsEqual([&](const acv::Image& srcImg, acv::Image& dstImg)
+        {
+            return acv::ImageCorrector::Correct(srcImg, dstImg, type);
+        }, [&](const acv::RawImageFile& srcFile, acv::RawImageFile& dstFile)
+        {
+            return processor.Correct(srcFile, dstFile, type);
+        });
+        QCOMPARE(isEqual, true);
+    }
+}
+
+void TiledProcessorTests::IncorrectArguments()
+{
+    const acv::TiledProcessor processor(MEMORY_LIMIT_MB);
+
+    acv::RawImageFile srcFile, dstFile;
+    QCOMPARE(srcFile.Open(SRC_FILE_NAME), true);
+
+    // Destination file isn't opened
+    QCOMPARE(processor.Correct(srcFile, dstFile, acv::ImageCorrector::CorrectorType::GAMMA), false);
+
+    // Destination file has other sizes
+    QCOMPARE(acv::RawImageFile::Create(DST_FILE_NAME, HEIGHT, WIDTH - 1, FILE_TILE_SIZE), true);
+    QCOMPARE(dstFile.Open(DST_FILE_NAME, acv::RawImageFile::OpenMode::READ_WRITE), true);
+    QCOMPARE(processor.DetectBorders(srcFile, dstFile, acv::BordersDetector::DetectorType::SOBEL), false);
+    dstFile.Close();
+
+    // Not supported correctors and incorrect sizes of filters
+    QCOMPARE(acv::RawImageFile::Create(DST_FILE_NAME, HEIGHT, WIDTH, FILE_TILE_SIZE), true);
+    QCOMPARE(dstFile.Open(DST_FILE_NAME, acv::RawImageFile::OpenMode::READ_WRITE), true);
+    QCOMPARE(processor.Correct(srcFile, dstFile, acv::ImageCorrector::CorrectorType::CLAHE), false);
+    QCOMPARE(processor.Correct(srcFile, dstFile, acv::ImageCorrector::CorrectorType::SSRETINEX), false);
+    QCOMPARE(processor.Filter(srcFile, dstFile, FilterType::MEDIAN, 4) == acv::FiltrationResult::INCORRECT_FILTER_SIZE, true);
+    QCOMPARE(processor.Morphology(srcFile, dstFile, acv::MorphologyFilter::MorphologyType::EROSION, 4, 3) ==
+             acv::FiltrationResult::SUCCESS, false);
+}
+
+QTEST_APPLESS_MAIN(TiledProcessorTests)
+
+#include "TiledProcessorTests.moc"
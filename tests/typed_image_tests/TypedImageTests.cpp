@@ -0,0 +1,306 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "TypedImageTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+#include "Image.h"
+#include "TypedImage.h"
+#include "TypedImageFilter.h"
+#include "TypedImageCorrector.h"
+#include "TypedBordersDetector.h"
+
+// This class is used for testing of typed images (16-bit and float): the results are compared with direct calculations
+class TypedImageTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    TypedImageTests();
+
+private Q_SLOTS:
+
+    // Test of conversion between types of images
+    void Conversion();
+
+    // Test of separated Gaussian filtration
+    void SeparateGaussian();
+
+    // Test of Gaussian imitation by IIR-filter
+    void GaussianIIR();
+
+    // Test of gradient modules
+    void DetectBorders();
+
+    // Test of auto-levels and gamma-correction
+    void Correct();
+
+    // Test of incorrect arguments
+    void IncorrectArguments();
+
+private:
+
+    // Form the image with random pixels in range of type
+    template <typename T>
+    acv::TypedImage<T> FormRandomImage(const int height, const int width);
+
+    // Mirror the coordinate if it is out of range [0, size)
+    static int Mirror(const int coord, const int size);
+
+    std::default_random_engine mEngine;
+
+};
+
+TypedImageTests::TypedImageTests()
+{
+}
+
+template <typename T>
+acv::TypedImage<T> TypedImageTests::FormRandomImage(const int height, const int width)
+{
+    std::uniform_real_distribution<float> di(acv::PixelTraits<T>::MinValue(), acv::PixelTraits<T>::MaxValue());
+
+    acv::TypedImage<T> img(height, width);
+    for (T& val : img.GetData())
+        val = acv::PixelTraits<T>::Saturate(di(mEngine));
+
+    return img;
+}
+
+int TypedImageTests::Mirror(const int coord, const int size)
+{
+    const int mirrored = (coord < 0) ? -coord : (coord >= size) ? 2 * size - 2 - coord : coord;
+    return std::max(0, std::min(mirrored, size - 1));
+}
+
+void TypedImageTests::Conversion()
+{
+    const acv::Image img = FormRandomImage<acv::Image::Byte>(31, 17).ToImage();
+
+    // 8-bit brightness is kept by conversion to wider types and back
+    const auto img16 = acv::TypedImage<unsigned short>::FromImage(img);
+    const auto imgFloat = acv::TypedImage<float>::FromImage(img);
+    for (int row = 0; row < img.GetHeight(); ++row)
+        for (int col = 0; col < img.GetWidth(); ++col)
+        {
+            QCOMPARE(static_cast<int>(img16.GetPixel(row, col)), img.GetPixel(row, col) * 257);
+            QCOMPARE(imgFloat.GetPixel(row, col), static_cast<float>(img.GetPixel(row, col)));
+        }
+
+    QCOMPARE(img16.ToImage() == img, true);
+    QCOMPARE(imgFloat.ToImage() == img, true);
+    QCOMPARE(acv::TypedImage<float>::FromImage(img16).ToImage() == img, true);
+
+    // Float values out of range are saturated by conversion to integer types
+    acv::TypedImage<float> outOfRange(1, 3);
+    outOfRange(0, 0) = -20.0f;
+    outOfRange(0, 1) = 300.0f;
+    outOfRange(0, 2) = 127.4f;
+    const acv::Image saturated = outOfRange.ToImage();
+    QCOMPARE(static_cast<int>(saturated.GetPixel(0, 0)), static_cast<int>(acv::Image::MIN_PIXEL_VALUE));
+    QCOMPARE(static_cast<int>(saturated.GetPixel(0, 1)), static_cast<int>(acv::Image::MAX_PIXEL_VALUE));
+    QCOMPARE(static_cast<int>(saturated.GetPixel(0, 2)), 127);
+}
+
+void TypedImageTests::SeparateGaussian()
+{
+    const int HEIGHT = 27, WIDTH = 34;
+
+    // The image which is smaller than aperture of the largest filter is mirrored with clamping
+    const std::vector<acv::TypedImage<float>> images = { FormRandomImage<float>(HEIGHT, WIDTH), FormRandomImage<float>(4, 3) };
+
+    for (const auto& img : images)
+        for (int filterSize = 1; filterSize <= 9; filterSize += 2)
+        {
+            const int height = img.GetHeight(), width = img.GetWidth();
+            acv::TypedImage<float> dst(height, width);
+            QCOMPARE(acv::TypedImageFilter::SeparateGaussian(img, dst, filterSize) == acv::FiltrationResult::SUCCESS, true);
+
+            // Direct two-dimensional convolution
+            const double SIGMA = (filterSize / 2.0 - 1.0) * 0.3 + 0.8;
+            const int APERTURE = filterSize / 2;
+            std::vector<double> filter(filterSize);
+            double sum = 0.0;
+            for (int i = -APERTURE; i <= APERTURE; ++i)
+                sum += (filter[i + APERTURE] = std::exp(-(i * i) / (2.0 * SIGMA * SIGMA)));
+
+            for (int row = 0; row < height; ++row)
+                for (int col = 0; col < width; ++col)
+                {
+                    double expected = 0.0;
+                    for (int i = -APERTURE; i <= APERTURE; ++i)
+                        for (int j = -APERTURE; j <= APERTURE; ++j)
+                            expected += img.GetPixel(Mirror(row + i, height), Mirror(col + j, width)) *
+                                        filter[i + APERTURE] * filter[j + APERTURE];
+                    expected /= sum * sum;
+
+                    QCOMPARE(std::fabs(dst.GetPixel(row, col) - expected) < 1e-3, true);
+                }
+        }
+
+    // 16-bit result is the rounded float result
+    const auto img16 = FormRandomImage<unsigned short>(HEIGHT, WIDTH);
+    const auto img16Float = acv::TypedImage<float>::FromImage(img16);
+    acv::TypedImage<unsigned short> dst16(HEIGHT, WIDTH);
+    acv::TypedImage<float> dstFloat(HEIGHT, WIDTH);
+    QCOMPARE(acv::TypedImageFilter::SeparateGaussian(img16, dst16, 5) == acv::FiltrationResult::SUCCESS, true);
+    QCOMPARE(acv::TypedImageFilter::SeparateGaussian(img16Float, dstFloat, 5) == acv::FiltrationResult::SUCCESS, true);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+            QCOMPARE(std::abs(dst16.GetPixel(row, col) - dstFloat.GetPixel(row, col) * 257.0f) <= 1.0f, true);
+}
+
+void TypedImageTests::GaussianIIR()
+{
+    const int HEIGHT = 40, WIDTH = 50;
+    const auto img = FormRandomImage<float>(HEIGHT, WIDTH);
+
+    acv::TypedImage<float> dst(HEIGHT, WIDTH);
+    QCOMPARE(acv::TypedImageFilter::GaussianIIR(img, dst, 2.0f) == acv::FiltrationResult::SUCCESS, true);
+
+    acv::TypedImage<float> inPlace(img);
+    QCOMPARE(acv::TypedImageFilter::GaussianIIR(inPlace, 2.0f) == acv::FiltrationResult::SUCCESS, true);
+    QCOMPARE(inPlace.GetData() == dst.GetData(), true);
+
+    // Filtration smoothes the image inside the range of source pixels
+    const auto srcMinMax = std::minmax_element(img.GetData().begin(), img.GetData().end());
+    const auto dstMinMax = std::minmax_element(dst.GetData().begin(), dst.GetData().end());
+    QCOMPARE(*dstMinMax.first >= *srcMinMax.first - 1.0f, true);
+    QCOMPARE(*dstMinMax.second <= *srcMinMax.second + 1.0f, true);
+    QCOMPARE(*dstMinMax.second - *dstMinMax.first < *srcMinMax.second - *srcMinMax.first, true);
+
+    // Constant image is kept far from the borders (the filter starts from zero state at the borders)
+    const float SIGMA = 2.0f;
+    const int MARGIN = static_cast<int>(6 * SIGMA);
+    acv::TypedImage<float> constant(HEIGHT, WIDTH);
+    std::fill(constant.GetData().begin(), constant.GetData().end(), 100.0f);
+    QCOMPARE(acv::TypedImageFilter::GaussianIIR(constant, SIGMA) == acv::FiltrationResult::SUCCESS, true);
+    for (int row = MARGIN; row < HEIGHT - MARGIN; ++row)
+        for (int col = MARGIN; col < WIDTH - MARGIN; ++col)
+            QCOMPARE(std::fabs(constant.GetPixel(row, col) - 100.0f) < 0.5f, true);
+}
+
+void TypedImageTests::DetectBorders()
+{
+    const int HEIGHT = 21, WIDTH = 26;
+    const auto img = FormRandomImage<float>(HEIGHT, WIDTH);
+
+    const acv::BordersDetector::DetectorType TYPES[] = { acv::BordersDetector::DetectorType::SOBEL,
+                                                         acv::BordersDetector::DetectorType::SCHARR };
+    for (const auto type : TYPES)
+    {
+        const double side = (type == acv::BordersDetector::DetectorType::SOBEL) ? 1.0 : 3.0;
+        const double center = (type == acv::BordersDetector::DetectorType::SOBEL) ? 2.0 : 10.0;
+
+        acv::TypedImage<float> dst(HEIGHT, WIDTH);
+        QCOMPARE(acv::TypedBordersDetector::DetectBorders(img, dst, type), true);
+
+        for (int row = 0; row < HEIGHT; ++row)
+            for (int col = 0; col < WIDTH; ++col)
+            {
+                auto pix = [&](const int dRow, const int dCol)
+                {
+                    return static_cast<double>(img.GetPixel(Mirror(row + dRow, HEIGHT), Mirror(col + dCol, WIDTH)));
+                };
+                const double gx = side * (pix(-1, 1) - pix(-1, -1)) + center * (pix(0, 1) - pix(0, -1)) + side * (pix(1, 1) - pix(1, -1));
+                const double gy = side * (pix(1, -1) - pix(-1, -1)) + center * (pix(1, 0) - pix(-1, 0)) + side * (pix(1, 1) - pix(-1, 1));
+                const double expected = std::sqrt(gx * gx + gy * gy);
+
+                QCOMPARE(std::fabs(dst.GetPixel(row, col) - expected) < 1e-3 * std::max(1.0, expected), true);
+            }
+    }
+}
+
+void TypedImageTests::Correct()
+{
+    const int HEIGHT = 30, WIDTH = 20;
+    const float MAX_VALUE = acv::PixelTraits<unsigned short>::MaxValue();
+
+    // Auto-levels of 16-bit image with the narrow range of brightness
+    acv::TypedImage<unsigned short> img(HEIGHT, WIDTH);
+    std::uniform_int_distribution<int> di(1000, 3000);
+    for (auto& val : img.GetData())
+        val = static_cast<unsigned short>(di(mEngine));
+
+    acv::TypedImage<unsigned short> dst(HEIGHT, WIDTH);
+    QCOMPARE(acv::TypedImageCorrector::Correct(img, dst, acv::ImageCorrector::CorrectorType::AUTO_LEVELS), true);
+
+    const auto minMax = std::minmax_element(img.GetData().begin(), img.GetData().end());
+    const float minBr = *minMax.first, maxBr = *minMax.second;
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+        {
+            const float expected = (img.GetPixel(row, col) - minBr) * MAX_VALUE / (maxBr - minBr);
+            QCOMPARE(std::fabs(dst.GetPixel(row, col) - expected) <= 1.0f, true);
+        }
+
+    // Gamma-correction
+    QCOMPARE(acv::TypedImageCorrector::Correct(img, dst, acv::ImageCorrector::CorrectorType::GAMMA), true);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+        {
+            const double expected = MAX_VALUE * std::pow(img.GetPixel(row, col) / static_cast<double>(MAX_VALUE), 1.0 / 2.2);
+            QCOMPARE(std::fabs(dst.GetPixel(row, col) - expected) <= 1.0, true);
+        }
+
+    // Float gamma-correction is not rounded
+    const auto imgFloat = FormRandomImage<float>(HEIGHT, WIDTH);
+    acv::TypedImage<float> dstFloat(HEIGHT, WIDTH);
+    QCOMPARE(acv::TypedImageCorrector::Correct(imgFloat, dstFloat, acv::ImageCorrector::CorrectorType::GAMMA), true);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+        {
+            const double expected = 255.0 * std::pow(imgFloat.GetPixel(row, col) / 255.0, 1.0 / 2.2);
+            QCOMPARE(std::fabs(dstFloat.GetPixel(row, col) - expected) < 1e-3, true);
+        }
+}
+
+void TypedImageTests::IncorrectArguments()
+{
+    const auto img = FormRandomImage<unsigned short>(10, 12);
+    acv::TypedImage<unsigned short> dst(10, 12);
+    acv::TypedImage<unsigned short> otherSizes(12, 10);
+
+    QCOMPARE(acv::TypedImageFilter::SeparateGaussian(img, dst, 4) == acv::FiltrationResult::INCORRECT_FILTER_SIZE, true);
+    QCOMPARE(acv::TypedImageFilter::SeparateGaussian(img, dst, 0) == acv::FiltrationResult::INCORRECT_FILTER_SIZE, true);
+    QCOMPARE(acv::TypedImageFilter::SeparateGaussian(img, dst, -3) == acv::FiltrationResult::INCORRECT_FILTER_SIZE, true);
+    QCOMPARE(acv::TypedImageFilter::SeparateGaussian(img, otherSizes, 5) == acv::FiltrationResult::INTERNAL_ERROR, true);
+    QCOMPARE(acv::TypedImageFilter::GaussianIIR(img, dst, 0.5f) == acv::FiltrationResult::SMALL_FILTER_SIZE, true);
+
+    QCOMPARE(acv::TypedBordersDetector::DetectBorders(img, dst, acv::BordersDetector::DetectorType::CANNY), false);
+    QCOMPARE(acv::TypedBordersDetector::DetectBorders(img, otherSizes, acv::BordersDetector::DetectorType::SOBEL), false);
+    QCOMPARE(acv::TypedImageCorrector::Correct(img, dst, acv::ImageCorrector::CorrectorType::CLAHE), false);
+    QCOMPARE(acv::TypedImageCorrector::Correct(acv::TypedImage<unsigned short>(), dst,
+                                               acv::ImageCorrector::CorrectorType::GAMMA), false);
+}
+
+QTEST_APPLESS_MAIN(TypedImageTests)
+
+#include "TypedImageTests.moc"
@@ -0,0 +1,263 @@
+//
+// MIT License
+//
+// Copyright (c) 2018-2019 Dmitriy Korobochkin, Vitaliy Garmash.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// This file contains definition and implementation of class "UnsharpMaskTests" and his methods
+
+#include <QString>
+#include <QtTest>
+
+#include <random>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+
+#include "Image.h"
+#include "ImageFilter.h"
+#include "CpuFeatures.h"
+
+// This class is used for testing of unsharp masking: the results are compared with the separate blur and addition of differences
+class UnsharpMaskTests : public QObject
+{
+    Q_OBJECT
+
+public:
+    UnsharpMaskTests();
+
+private Q_SLOTS:
+
+    // Test of masking with blur by separate Gaussian filter (small radius)
+    void SeparateBlur();
+
+    // Test of masking with blur by IIR-filter (large radius)
+    void IIRBlur();
+
+    // Test of masking by all instruction sets of processor
+    void InstructionSets();
+
+    // Test of masking in place and by type of filter
+    void InPlaceAndFilterType();
+
+    // Test of incorrect arguments
+    void IncorrectArguments();
+
+private:
+
+    // Blur the image by IIR-filter in floating point (the borders are initialized by the nearest pixels)
+    static acv::Image BlurIIR(const acv::Image& img, const int filterSize);
+
+    // Add the multiplied differences between image and its blur which are not smaller than threshold
+    static acv::Image AddDifferences(const acv::Image& img, const acv::Image& blurred, const int amount, const int threshold);
+
+    // Check the masking with specified radius by all amounts and thresholds
+    bool CheckRadius(const int radius);
+
+    acv::Image mImage;
+
+};
+
+// Sizes of image (width isn't multiple of vectors and of blocks of columns)
+static const int HEIGHT = 120, WIDTH = 151;
+
+// Tested amounts (in percents) and thresholds
+static const int AMOUNTS[] = { 0, 50, 100, 250 };
+static const int THRESHOLDS[] = { 0, 10, 300 };
+
+UnsharpMaskTests::UnsharpMaskTests()
+    : mImage(HEIGHT, WIDTH)
+{
+    // Blocks with noise
+    std::default_random_engine engine;
+    std::uniform_int_distribution<int> di(-15, 15);
+    for (int row = 0; row < HEIGHT; ++row)
+        for (int col = 0; col < WIDTH; ++col)
+        {
+            const int pixel = ((row / 30 + col / 40) % 2 ? 180 : 70) + di(engine);
+            mImage.SetPixel(row, col, static_cast<acv::Image::Byte>(pixel));
+        }
+}
+
+acv::Image UnsharpMaskTests::BlurIIR(const acv::Image& img, const int filterSize)
+{
+    const int height = img.GetHeight(), width = img.GetWidth();
+    acv::ImageFilter::IIRfilter<float> filter(static_cast<float>(filterSize / 6.0));
+
+    std::vector<float> values(img.GetData().begin(), img.GetData().end());
+
+    // Forward and backward passes along rows and then along columns
+    for (int row = 0; row < height; ++row)
+    {
+        float* pRow = &values[row * width];
+        filter.Reset(pRow[0], pRow[0], pRow[0]);
+        for (int col = 0; col < width; ++col)
+            pRow[col] = filter.Solve(pRow[col]);
+        filter.Reset(pRow[width - 1], pRow[width - 1], pRow[width - 1]);
+        for (int col = width - 1; col >= 0; --col)
+            pRow[col] = filter.Solve(pRow[col]);
+    }
+
+    for (int col = 0; col < width; ++col)
+    {
+        const float top = values[col];
+        filter.Reset(top, top, top);
+        for (int row = 0; row < height; ++row)
+            values[row * width + col] = filter.Solve(values[row * width + col]);
+
+        const float bottom = values[(height - 1) * width + col];
+        filter.Reset(bottom, bottom, bottom);
+        for (int row = height - 1; row >= 0; --row)
+            values[row * width + col] = filter.Solve(values[row * width + col]);
+    }
+
+    acv::Image blurred(height, width);
+    for (int row = 0; row < height; ++row)
+        for (int col = 0; col < width; ++col)
+        {
+            int pixel = static_cast<int>(values[row * width + col] + 0.5f);
+            acv::Image::CheckPixelValue(pixel);
+            blurred.SetPixel(row, col, static_cast<acv::Image::Byte>(pixel));
+        }
+
+    return blurred;
+}
+
+acv::Image UnsharpMaskTests::AddDifferences(const acv::Image& img, const acv::Image& blurred, const int amount, const int threshold)
+{
+    // Amount is rounded to 1/256 and the multiplied difference is rounded to the nearest level (the halves are rounded up)
+    const int fixedAmount = (amount * 256 + 50) / 100;
+
+    acv::Image result(img.GetHeight(), img.GetWidth());
+    for (int row = 0; row < img.GetHeight(); ++row)
+        for (int col = 0; col < img.GetWidth(); ++col)
+        {
+            const int pixel = img.GetPixel(row, col);
+            const int diff = pixel - blurred.GetPixel(row, col);
+
+            int value = pixel;
+            if (std::abs(diff) >= threshold)
+                value += static_cast<int>(std::floor((diff * fixedAmount + 128) / 256.0));
+            acv::Image::CheckPixelValue(value);
+            result.SetPixel(row, col, static_cast<acv::Image::Byte>(value));
+        }
+
+    return result;
+}
+
+bool UnsharpMaskTests::CheckRadius(const int radius)
+{
+    const int filterSize = 2 * radius + 1;
+
+    // Small radius uses separate Gaussian filter, large radius uses IIR-filter
+    acv::Image blurred(HEIGHT, WIDTH);
+    if (filterSize < 6)
+    {
+        if (acv::ImageFilter::Filter(mImage, blurred, acv::ImageFilter::FilterType::SEP_GAUSSIAN, filterSize) != acv::FiltrationResult::SUCCESS)
+            return false;
+    }
+    else
+        blurred = BlurIIR(mImage, filterSize);
+
+    for (const int amount : AMOUNTS)
+        for (const int threshold : THRESHOLDS)
+        {
+            acv::Image result(HEIGHT, WIDTH);
+            if (acv::ImageFilter::UnsharpMask(mImage, result, radius, amount, threshold) != acv::FiltrationResult::SUCCESS ||
+                !(result == AddDifferences(mImage, blurred, amount, threshold)))
+                return false;
+        }
+
+    return true;
+}
+
+void UnsharpMaskTests::SeparateBlur()
+{
+    QVERIFY(CheckRadius(1));
+    QVERIFY(CheckRadius(2));
+}
+
+void UnsharpMaskTests::IIRBlur()
+{
+    QVERIFY(CheckRadius(3));
+    QVERIFY(CheckRadius(6));
+    QVERIFY(CheckRadius(20));
+}
+
+void UnsharpMaskTests::InstructionSets()
+{
+    const acv::CpuFeatures::InstructionSet sets[] =
+    {
+        acv::CpuFeatures::InstructionSet::SCALAR,
+        acv::CpuFeatures::InstructionSet::SSE2,
+        acv::CpuFeatures::InstructionSet::AVX2,
+        acv::CpuFeatures::InstructionSet::AVX512
+    };
+
+    // Each supported instruction set gives the same results
+    for (const auto set : sets)
+    {
+        if (set > acv::CpuFeatures::GetBestInstructionSet())
+            continue;
+
+        acv::CpuFeatures::SetInstructionSetLimit(set);
+        const bool isEqual = CheckRadius(2) && CheckRadius(4);
+        acv::CpuFeatures::SetInstructionSetLimit(acv::CpuFeatures::InstructionSet::AVX512);
+
+        QVERIFY(isEqual);
+    }
+}
+
+void UnsharpMaskTests::InPlaceAndFilterType()
+{
+    const int radii[] = { 2, 5 };
+
+    for (const int radius : radii)
+    {
+        acv::Image expected(HEIGHT, WIDTH);
+        QCOMPARE(acv::ImageFilter::UnsharpMask(mImage, expected, radius, 150, 5), acv::FiltrationResult::SUCCESS);
+
+        acv::Image inPlace = mImage;
+        QCOMPARE(acv::ImageFilter::UnsharpMask(inPlace, inPlace, radius, 150, 5), acv::FiltrationResult::SUCCESS);
+        QVERIFY(inPlace == expected);
+
+        // Type of filter uses radius filterSize / 2 and default amount and threshold
+        acv::Image byType(HEIGHT, WIDTH), byDefault(HEIGHT, WIDTH);
+        QCOMPARE(acv::ImageFilter::Filter(mImage, byType, acv::ImageFilter::FilterType::UNSHARP_MASK, 2 * radius + 1),
+                 acv::FiltrationResult::SUCCESS);
+        QCOMPARE(acv::ImageFilter::UnsharpMask(mImage, byDefault, radius), acv::FiltrationResult::SUCCESS);
+        QVERIFY(byType == byDefault);
+    }
+}
+
+void UnsharpMaskTests::IncorrectArguments()
+{
+    acv::Image result(HEIGHT, WIDTH), small(HEIGHT - 1, WIDTH);
+
+    QCOMPARE(acv::ImageFilter::UnsharpMask(mImage, result, 0), acv::FiltrationResult::SMALL_FILTER_SIZE);
+    QCOMPARE(acv::ImageFilter::UnsharpMask(mImage, result, 2, -1), acv::FiltrationResult::INCORRECT_FILTER_SIZE);
+    QCOMPARE(acv::ImageFilter::UnsharpMask(mImage, small, 2), acv::FiltrationResult::INTERNAL_ERROR);
+    QCOMPARE(acv::ImageFilter::Filter(mImage, result, acv::ImageFilter::FilterType::UNSHARP_MASK, 1), acv::FiltrationResult::SMALL_FILTER_SIZE);
+}
+
+QTEST_APPLESS_MAIN(UnsharpMaskTests)
+
+#include "UnsharpMaskTests.moc"